@@ -407,6 +407,16 @@ int csinn_matmul_init(struct csinn_tensor *mat0, struct csinn_tensor *mat1,
 int csinn_matmul(struct csinn_tensor *mat0, struct csinn_tensor *mat1, struct csinn_tensor *output,
                  struct csinn_matmul_params *params);
 
+int csinn_scaled_dot_product_attention_init(
+    struct csinn_tensor *query, struct csinn_tensor *key, struct csinn_tensor *value,
+    struct csinn_tensor *mask, struct csinn_tensor *output,
+    struct csinn_scaled_dot_product_attention_params *params);
+
+int csinn_scaled_dot_product_attention(struct csinn_tensor *query, struct csinn_tensor *key,
+                                       struct csinn_tensor *value, struct csinn_tensor *mask,
+                                       struct csinn_tensor *output,
+                                       struct csinn_scaled_dot_product_attention_params *params);
+
 int csinn_add_init(struct csinn_tensor *input0, struct csinn_tensor *input1,
                    struct csinn_tensor *output, struct csinn_diso_params *params);
 
@@ -931,6 +941,24 @@ int csinn_erf_init(struct csinn_tensor *input, struct csinn_tensor *output,
 int csinn_erf(struct csinn_tensor *input, struct csinn_tensor *output,
               struct csinn_siso_params *params);
 
+int csinn_gelu_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                    struct csinn_siso_params *params);
+
+int csinn_gelu(struct csinn_tensor *input, struct csinn_tensor *output,
+               struct csinn_siso_params *params);
+
+int csinn_mish_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                    struct csinn_siso_params *params);
+
+int csinn_mish(struct csinn_tensor *input, struct csinn_tensor *output,
+               struct csinn_siso_params *params);
+
+int csinn_silu_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                    struct csinn_siso_params *params);
+
+int csinn_silu(struct csinn_tensor *input, struct csinn_tensor *output,
+               struct csinn_siso_params *params);
+
 int csinn_cumsum_init(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_cumsum_params *params);
 
@@ -173,6 +173,7 @@ enum csinn_op_enum {
     CSINN_OP_FULLYCONNECTED,
     CSINN_OP_GATHER_ND,
     CSINN_OP_GATHER,
+    CSINN_OP_GELU,
     CSINN_OP_GLOBAL_AVGPOOL2D,
     CSINN_OP_GLOBAL_MAXPOOL2D,
     CSINN_OP_GREATHER_EQUAL,
@@ -205,6 +206,7 @@ enum csinn_op_enum {
     CSINN_OP_MIN,
     CSINN_OP_MIN_STRIDE,
     CSINN_OP_MINIMUM,
+    CSINN_OP_MISH,
     CSINN_OP_MOD,
     CSINN_OP_MUL,
     CSINN_OP_NDARRAY_SIZE,
@@ -238,6 +240,7 @@ enum csinn_op_enum {
     CSINN_OP_ROIPOOL,
     CSINN_OP_ROUND,
     CSINN_OP_RSQRT,
+    CSINN_OP_SCALED_DOT_PRODUCT_ATTENTION,
     CSINN_OP_SCATTER_ND,
     CSINN_OP_SEGMENT_MAX,
     CSINN_OP_UNSORTED_SEGMENT_MAX,
@@ -255,6 +258,7 @@ enum csinn_op_enum {
     CSINN_OP_SHUFFLE_CHANNEL,
     CSINN_OP_SIGMOID,
     CSINN_OP_SIGN,
+    CSINN_OP_SILU,
     CSINN_OP_SIN,
     CSINN_OP_SINH,
     CSINN_OP_SLICE,
@@ -398,6 +402,14 @@ enum csinn_status_enum {
 enum csinn_profiler_enum {
     CSI_PROFILER_LEVEL_UNSET = 0,
     CSI_PROFILER_LEVEL_TIMER,  // print time
+    CSI_PROFILER_LEVEL_LAYER,  // accumulate per layer time in the graph runtime, no print
+};
+
+/* kernel selection of ops with several algorithms, conv2d for now */
+enum csinn_tune_enum {
+    CSINN_TUNE_OFF = 0,  // built-in heuristics
+    CSINN_TUNE_CACHE,    // selections of the tuning cache, heuristics on a miss
+    CSINN_TUNE_ON,       // time the candidates on a miss and cache the fastest
 };
 
 enum csinn_debug_enum {
@@ -454,6 +466,32 @@ struct csinn_session {
     struct csinn_tensor **input;
     struct csinn_tensor **output;
     void *td;
+    void *async;  // asynchronous run context, see csinn_session_run_async
+    int32_t thread_num;  // intra-op threads of reference kernels, 0 means OpenMP default
+    bool unordered_reduce;  // let reductions sum in thread order, the last bits vary
+    int32_t tune_mode;   // enum csinn_tune_enum
+    void *tune_cache;    // kernel selections keyed by shape, dtype and core, see shl_conv2d_tune
+    void *input_image;   // input buffers filled by csinn_update_input_image
+};
+
+/* source image of csinn_tensor_preprocess */
+enum csinn_image_format_enum {
+    CSINN_IMAGE_RGB888 = 0x0,  // packed R, G, B bytes
+    CSINN_IMAGE_BGR888,        // packed B, G, R bytes
+    CSINN_IMAGE_NV12,          // Y plane, then interleaved U/V plane at half resolution
+    CSINN_IMAGE_NV21,          // Y plane, then interleaved V/U plane at half resolution
+    CSINN_IMAGE_I420,          // Y, U and V planes, chroma at half resolution
+};
+
+struct csinn_preprocess_params {
+    enum csinn_image_format_enum format;
+    int32_t width;
+    int32_t height;
+    int32_t stride;  // bytes per row of the first plane, 0 for tightly packed rows
+    enum csinn_resize_enum resize_mode;  // bilinear or nearest neighbor
+    bool bgr;                            // feed the model B, G, R instead of R, G, B
+    float mean[3];                       // subtracted per model channel
+    float scale[3];                      // multiplied after the mean, usually 1 / std
 };
 
 struct csinn_callback {
@@ -471,6 +509,7 @@ struct csinn_params_base {
     int32_t api;
     enum csinn_quant_enum quant_type;
     struct csinn_session *sess;
+    void *lut;  // lookup table of an 8-bit op, built at init, freed with params
 };
 
 struct csinn_fsmn_params {
@@ -644,6 +683,13 @@ struct csinn_matmul_params {
     bool trans_b;
 };
 
+/* softmax(Q * K^T * norm_factor + mask) * V, Q / K / V are [..., seq, head_dim] */
+struct csinn_scaled_dot_product_attention_params {
+    struct csinn_params_base base;
+    float norm_factor;  // usually 1 / sqrt(head_dim)
+    bool causal;        // query i only attends to keys j <= i
+};
+
 struct csinn_diso_params {
     struct csinn_params_base base;
 };
@@ -957,9 +1003,9 @@ struct csinn_topk_params {
 
 struct csinn_non_max_suppression_params {
     struct csinn_params_base base;
-    int32_t max_output_size;
+    int32_t max_output_size;  // per (batch, class) when the scores are [batch, class, box_num]
     float iou_threshold;
-    // float score_threshold;
+    float score_threshold;  // boxes scoring <= score_threshold are never selected
 };
 
 // modyfied to use asr model
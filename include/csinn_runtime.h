@@ -52,6 +52,8 @@ void csinn_realloc_quant_info(struct csinn_tensor *tensor, int quant_info_num);
 void csinn_tensor_copy(struct csinn_tensor *dest, struct csinn_tensor *src);
 int csinn_tensor_data_convert(struct csinn_tensor *dest, struct csinn_tensor *src);
 int csinn_tensor_layout_convert(struct csinn_tensor *dest, struct csinn_tensor *src);
+int csinn_tensor_preprocess(struct csinn_tensor *dest, uint8_t *image,
+                            struct csinn_preprocess_params *params);
 
 /* op parameters */
 void *csinn_alloc_params(int params_size, struct csinn_session *session);
@@ -64,6 +66,12 @@ void csinn_session_init(struct csinn_session *session);
 void csinn_session_deinit(struct csinn_session *session);
 int csinn_session_setup(struct csinn_session *session);
 int csinn_session_run(struct csinn_session *session);
+int csinn_session_set_slot_number(int number, struct csinn_session *session);
+int csinn_session_run_async(struct csinn_session *session,
+                            void (*callback)(struct csinn_session *, int, int, void *),
+                            void *user_data);
+int csinn_session_wait(struct csinn_session *session);
+int csinn_session_poll(struct csinn_session *session);
 int csinn_load_binary_model(struct csinn_session *session);
 struct csinn_session *__attribute__((weak)) csinn_import_binary_model(char *bm_addr);
 
@@ -78,6 +86,10 @@ int csinn_get_input(int index, struct csinn_tensor *input, struct csinn_session
 int csinn_get_output(int index, struct csinn_tensor *output, struct csinn_session *sess);
 int csinn_update_input(int index, struct csinn_tensor *input, struct csinn_session *sess);
 int csinn_update_output(int index, struct csinn_tensor *output, struct csinn_session *sess);
+int csinn_update_input_image(int index, uint8_t *image, struct csinn_preprocess_params *params,
+                             struct csinn_session *sess);
+int csinn_get_output_slot(int slot, int index, struct csinn_tensor *output,
+                          struct csinn_session *sess);
 int csinn_set_tensor_entry(struct csinn_tensor *tensor, struct csinn_session *sess);
 
 #ifdef __cplusplus
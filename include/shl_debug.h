@@ -191,6 +191,11 @@ int shl_matmul_debug_info(struct csinn_tensor *mat0, struct csinn_tensor *mat1,
                           struct csinn_tensor *output, struct csinn_matmul_params *params,
                           const char *name);
 
+int shl_scaled_dot_product_attention_debug_info(
+    struct csinn_tensor *query, struct csinn_tensor *key, struct csinn_tensor *value,
+    struct csinn_tensor *mask, struct csinn_tensor *output,
+    struct csinn_scaled_dot_product_attention_params *params, const char *name);
+
 int shl_ndarray_size_debug_info(struct csinn_tensor *input, struct csinn_tensor *output,
                                 struct csinn_ndarray_size_params *params, const char *name);
 
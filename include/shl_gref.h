@@ -265,6 +265,11 @@ int shl_gref_lrn(struct csinn_tensor *input, struct csinn_tensor *output,
 int shl_gref_matmul(struct csinn_tensor *mat0, struct csinn_tensor *mat1,
                     struct csinn_tensor *output, struct csinn_matmul_params *params);
 
+int shl_gref_scaled_dot_product_attention(
+    struct csinn_tensor *query, struct csinn_tensor *key, struct csinn_tensor *value,
+    struct csinn_tensor *mask, struct csinn_tensor *output,
+    struct csinn_scaled_dot_product_attention_params *params);
+
 int shl_gref_add(struct csinn_tensor *input0, struct csinn_tensor *input1,
                  struct csinn_tensor *output, struct csinn_diso_params *params);
 
@@ -531,6 +536,15 @@ int shl_gref_reorg(struct csinn_tensor *input, struct csinn_tensor *output,
 int shl_gref_erf(struct csinn_tensor *input, struct csinn_tensor *output,
                  struct csinn_siso_params *params);
 
+int shl_gref_gelu(struct csinn_tensor *input, struct csinn_tensor *output,
+                  struct csinn_siso_params *params);
+
+int shl_gref_mish(struct csinn_tensor *input, struct csinn_tensor *output,
+                  struct csinn_siso_params *params);
+
+int shl_gref_silu(struct csinn_tensor *input, struct csinn_tensor *output,
+                  struct csinn_siso_params *params);
+
 int shl_gref_xor(struct csinn_tensor *input0, struct csinn_tensor *input1,
                  struct csinn_tensor *output, struct csinn_diso_params *params);
 
@@ -561,8 +575,34 @@ struct shl_ref_graph {
     int layer_index;
 };
 
+#define SHL_GREF_PLAN_CACHE_SIZE 8
+#define SHL_GREF_PLAN_KEY_SIZE 32
+
+/* kernel selection of one layer for one set of input shapes */
+struct shl_gref_plan {
+    int32_t key[SHL_GREF_PLAN_KEY_SIZE];
+    int32_t key_len;
+    struct csinn_callback cb;
+    /* conv2d only, the params and the kernel as the init left them */
+    struct csinn_conv2d_params conv;
+    struct csinn_tensor kernel;
+    /* selected by a reinit, kernel.data and conv_extra.kernel_tm belong to the plan */
+    int32_t owner;
+};
+
+struct shl_gref_plan_cache {
+    struct shl_gref_plan *plan;
+    int32_t plan_num;
+    int32_t evict;
+    /* shapes at setup, reference for ops sized relative to their input */
+    struct csinn_tensor setup_input;
+    struct csinn_tensor setup_output;
+};
+
 struct shl_gref_target_data {
     struct shl_ref_graph *graph;
+    int shape_changed;
+    struct shl_gref_plan_cache *plan_cache;
 };
 
 struct shl_ref_graph *shl_gref_get_graph(struct csinn_session *sess);
@@ -574,6 +614,8 @@ struct shl_node *shl_gref_get_input_subgraph(struct shl_ref_graph *graph, struct
                                              int index);
 void shl_gref_reset_graph_visit(struct shl_ref_graph *graph);
 void shl_gref_update_input_output(struct shl_ref_graph *graph, int index);
+int shl_gref_infer_shape(struct shl_node *node, struct csinn_tensor *setup_input,
+                         struct csinn_tensor *setup_output);
 int shl_gref_siso_op(struct csinn_tensor *input, struct csinn_tensor *output, int op, void *params);
 int shl_gref_diso_op(struct csinn_tensor *input0, struct csinn_tensor *input1,
                      struct csinn_tensor *output, int op, void *params);
@@ -23,7 +23,15 @@
 #include <stdint.h>
 #include <stdlib.h>
 
+/* process wide counters of shl_mem_* calls, freeing NULL is not counted */
+struct shl_mem_stats {
+    int64_t alloc_count;
+    int64_t free_count;
+    int64_t alloc_bytes;  // requested bytes of all allocations so far
+};
+
 void shl_mem_print_map();
+void shl_mem_get_stats(struct shl_mem_stats *stats);
 void *shl_mem_alloc(int64_t size);
 void *shl_mem_alloc_aligned(int64_t size, int aligned_bytes);
 void *shl_mem_calloc(size_t nmemb, size_t size);
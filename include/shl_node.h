@@ -35,6 +35,14 @@ struct shl_node {
     int visited;
     int *restricted_map;
     int restricted_map_num;
+    /* tensor node whose buffer holds this one at view_offset bytes, planned by graph_ref */
+    struct shl_node *view_of;
+    int64_t view_offset;
+    /* number of nodes viewing into this one's buffer */
+    int view_num;
+    /* accumulated run time in ns and run count, under CSI_PROFILER_LEVEL_LAYER */
+    uint64_t run_time;
+    int32_t run_count;
 };
 
 /* node */
@@ -34,18 +34,27 @@ int shl_ref_abs_f32(struct csinn_tensor *input, struct csinn_tensor *output,
 int shl_ref_abs_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_siso_params *params);
 
+int shl_ref_abs_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_siso_params *params);
+
 int shl_ref_acos_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                      struct csinn_siso_params *params);
 
 int shl_ref_acos_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                        struct csinn_siso_params *params);
 
+int shl_ref_acos_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+
 int shl_ref_acosh_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_siso_params *params);
 
 int shl_ref_acosh_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                         struct csinn_siso_params *params);
 
+int shl_ref_acosh_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                       struct csinn_siso_params *params);
+
 int shl_ref_add_f32(struct csinn_tensor *input0, struct csinn_tensor *input1,
                     struct csinn_tensor *output, struct csinn_diso_params *params);
 
@@ -89,24 +98,36 @@ int shl_ref_asin_f32(struct csinn_tensor *input, struct csinn_tensor *output,
 int shl_ref_asin_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                        struct csinn_siso_params *params);
 
+int shl_ref_asin_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+
 int shl_ref_asinh_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_siso_params *params);
 
 int shl_ref_asinh_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                         struct csinn_siso_params *params);
 
+int shl_ref_asinh_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                       struct csinn_siso_params *params);
+
 int shl_ref_atan_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                      struct csinn_siso_params *params);
 
 int shl_ref_atan_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                        struct csinn_siso_params *params);
 
+int shl_ref_atan_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+
 int shl_ref_atanh_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_siso_params *params);
 
 int shl_ref_atanh_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                         struct csinn_siso_params *params);
 
+int shl_ref_atanh_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                       struct csinn_siso_params *params);
+
 int shl_ref_avgpool2d_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                           struct csinn_pool_params *params);
 
@@ -147,14 +168,23 @@ int shl_ref_ceil_f32(struct csinn_tensor *input, struct csinn_tensor *output,
 int shl_ref_ceil_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                        struct csinn_siso_params *params);
 
+int shl_ref_ceil_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+
 int shl_ref_clip_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                      struct csinn_clip_params *params);
 
 int shl_ref_clip_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                        struct csinn_clip_params *params);
 
+int shl_ref_clip_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_clip_params *params);
+
 int shl_ref_col2im_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                        struct csinn_tensor *kernel, struct csinn_col2im_params *params);
+void shl_ref_col2im_nchw_f32(const float *col, float *im, int channels, int im_h, int im_w,
+                             int col_h, int col_w, int kernel_h, int kernel_w,
+                             struct csinn_conv2d_params *params);
 
 int shl_ref_concat_f32(struct csinn_tensor **input, struct csinn_tensor *output,
                        struct csinn_concat_params *params);
@@ -300,12 +330,18 @@ int shl_ref_cos_f32(struct csinn_tensor *input, struct csinn_tensor *output,
 int shl_ref_cos_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_siso_params *params);
 
+int shl_ref_cos_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_siso_params *params);
+
 int shl_ref_cosh_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                      struct csinn_siso_params *params);
 
 int shl_ref_cosh_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                        struct csinn_siso_params *params);
 
+int shl_ref_cosh_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+
 int shl_ref_cumprod_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                         struct csinn_cumprod_params *params);
 
@@ -365,6 +401,9 @@ int shl_ref_elu_f32(struct csinn_tensor *input, struct csinn_tensor *output,
 int shl_ref_elu_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_relu_params *params);
 
+int shl_ref_elu_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_relu_params *params);
+
 int shl_ref_fsmn_f32(struct csinn_tensor *frame, struct csinn_tensor *l_filter,
                      struct csinn_tensor *r_filter, struct csinn_tensor *frame_sequence,
                      struct csinn_tensor *frame_counter, struct csinn_tensor *output,
@@ -387,12 +426,45 @@ int shl_ref_erf_f32(struct csinn_tensor *input, struct csinn_tensor *output,
 int shl_ref_erf_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_siso_params *params);
 
+int shl_ref_erf_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_siso_params *params);
+
+int shl_ref_gelu_f32(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_siso_params *params);
+
+int shl_ref_gelu_quant(struct csinn_tensor *input, struct csinn_tensor *output,
+                       struct csinn_siso_params *params);
+
+int shl_ref_gelu_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+
+int shl_ref_mish_f32(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_siso_params *params);
+
+int shl_ref_mish_quant(struct csinn_tensor *input, struct csinn_tensor *output,
+                       struct csinn_siso_params *params);
+
+int shl_ref_mish_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+
+int shl_ref_silu_f32(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_siso_params *params);
+
+int shl_ref_silu_quant(struct csinn_tensor *input, struct csinn_tensor *output,
+                       struct csinn_siso_params *params);
+
+int shl_ref_silu_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+
 int shl_ref_exp_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                     struct csinn_siso_params *params);
 
 int shl_ref_exp_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_siso_params *params);
 
+int shl_ref_exp_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_siso_params *params);
+
 int shl_ref_expand_dims_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                             struct csinn_expand_dims_params *params);
 
@@ -405,6 +477,9 @@ int shl_ref_expm1_f32(struct csinn_tensor *input, struct csinn_tensor *output,
 int shl_ref_expm1_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                         struct csinn_siso_params *params);
 
+int shl_ref_expm1_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                       struct csinn_siso_params *params);
+
 int shl_ref_flatten(struct csinn_tensor *input, struct csinn_tensor *output,
                     struct csinn_flatten_params *params);
 
@@ -429,6 +504,9 @@ int shl_ref_floor_f32(struct csinn_tensor *input, struct csinn_tensor *output,
 int shl_ref_floor_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                         struct csinn_siso_params *params);
 
+int shl_ref_floor_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                       struct csinn_siso_params *params);
+
 int shl_ref_fullyconnected_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                                struct csinn_tensor *weights, struct csinn_tensor *bias,
                                struct csinn_fc_params *params);
@@ -479,6 +557,9 @@ int shl_ref_hard_sigmoid_f32(struct csinn_tensor *input, struct csinn_tensor *ou
 int shl_ref_hard_sigmoid_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                                struct csinn_sigmoid_params *params);
 
+int shl_ref_hard_sigmoid_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                              struct csinn_sigmoid_params *params);
+
 int shl_ref_im2col_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                        struct csinn_im2col_params *params);
 
@@ -511,6 +592,9 @@ int shl_ref_leaky_relu_f32(struct csinn_tensor *input, struct csinn_tensor *outp
 int shl_ref_leaky_relu_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                              struct csinn_relu_params *params);
 
+int shl_ref_leaky_relu_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                            struct csinn_relu_params *params);
+
 int shl_ref_less_equal_f32(struct csinn_tensor *input0, struct csinn_tensor *input1,
                            struct csinn_tensor *output, struct csinn_diso_params *params);
 
@@ -535,12 +619,18 @@ int shl_ref_log_f32(struct csinn_tensor *input, struct csinn_tensor *output,
 int shl_ref_log_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_siso_params *params);
 
+int shl_ref_log_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_siso_params *params);
+
 int shl_ref_log1p_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_siso_params *params);
 
 int shl_ref_log1p_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                         struct csinn_siso_params *params);
 
+int shl_ref_log1p_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                       struct csinn_siso_params *params);
+
 int shl_ref_logical_and_f32(struct csinn_tensor *input0, struct csinn_tensor *input1,
                             struct csinn_tensor *output, struct csinn_diso_params *params);
 
@@ -577,6 +667,19 @@ int shl_ref_matmul_f32(struct csinn_tensor *mat0, struct csinn_tensor *mat1,
 int shl_ref_matmul_quant(struct csinn_tensor *mat0, struct csinn_tensor *mat1,
                          struct csinn_tensor *output, struct csinn_matmul_params *params);
 
+int64_t shl_ref_attention_mask_offset(struct csinn_tensor *mask, struct csinn_tensor *query,
+                                      int64_t outer, int32_t *q_stride);
+
+int shl_ref_scaled_dot_product_attention_f32(
+    struct csinn_tensor *query, struct csinn_tensor *key, struct csinn_tensor *value,
+    struct csinn_tensor *mask, struct csinn_tensor *output,
+    struct csinn_scaled_dot_product_attention_params *params);
+
+int shl_ref_scaled_dot_product_attention_quant(
+    struct csinn_tensor *query, struct csinn_tensor *key, struct csinn_tensor *value,
+    struct csinn_tensor *mask, struct csinn_tensor *output,
+    struct csinn_scaled_dot_product_attention_params *params);
+
 int shl_ref_max_stride_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                            struct csinn_reduce_params *params);
 
@@ -658,10 +761,21 @@ int shl_ref_negative_f32(struct csinn_tensor *input, struct csinn_tensor *output
 int shl_ref_negative_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                            struct csinn_siso_params *params);
 
+int shl_ref_negative_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                          struct csinn_siso_params *params);
+
 int shl_ref_non_max_suppression_std(struct csinn_tensor *input0, struct csinn_tensor *input1,
                                     struct csinn_tensor *output,
                                     struct csinn_non_max_suppression_params *params);
 
+int shl_ref_non_max_suppression_base(struct csinn_tensor *input0, struct csinn_tensor *input1,
+                                     struct csinn_tensor *output,
+                                     struct csinn_non_max_suppression_params *params,
+                                     void *overlap_cb);
+
+int shl_ref_nms_overlap_f32(const float *box, const float *selected, int cap, int selected_num,
+                            float iou_threshold);
+
 int shl_ref_not_equal_f32(struct csinn_tensor *input0, struct csinn_tensor *input1,
                           struct csinn_tensor *output, struct csinn_diso_params *params);
 
@@ -767,30 +881,51 @@ int shl_ref_relu_f32(struct csinn_tensor *input, struct csinn_tensor *output,
 int shl_ref_relu_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                        struct csinn_relu_params *params);
 
+int shl_ref_relu_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_relu_params *params);
+
 int shl_ref_relu1_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_relu_params *params);
 
 int shl_ref_relu1_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                         struct csinn_relu_params *params);
 
+int shl_ref_relu1_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                       struct csinn_relu_params *params);
+
 int shl_ref_relu6_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_relu_params *params);
 
 int shl_ref_relu6_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                         struct csinn_relu_params *params);
 
+int shl_ref_relu6_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                       struct csinn_relu_params *params);
+
 int shl_ref_relun_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_relu_params *params);
 
 int shl_ref_relun_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                         struct csinn_relu_params *params);
 
+int shl_ref_relun_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                       struct csinn_relu_params *params);
+
 int shl_ref_reshape(struct csinn_tensor *input, struct csinn_tensor *output,
                     struct csinn_reshape_params *params);
 
 int shl_ref_reshape_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                           struct csinn_reshape_params *params);
 
+void shl_ref_resize_nearest_table(int32_t in_size, int32_t out_size, bool align_corners,
+                                  int32_t *ofs);
+
+void shl_ref_resize_linear_table(int32_t in_size, int32_t out_size, bool align_corners,
+                                 int32_t *ofs, float *alpha);
+
+void shl_ref_resize_cubic_table(int32_t in_size, int32_t out_size, bool align_corners,
+                                int32_t *ofs, float *alpha);
+
 int shl_ref_resize_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                        struct csinn_resize_params *params);
 
@@ -818,12 +953,18 @@ int shl_ref_round_f32(struct csinn_tensor *input, struct csinn_tensor *output,
 int shl_ref_round_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                         struct csinn_siso_params *params);
 
+int shl_ref_round_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                       struct csinn_siso_params *params);
+
 int shl_ref_rsqrt_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_siso_params *params);
 
 int shl_ref_rsqrt_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                         struct csinn_siso_params *params);
 
+int shl_ref_rsqrt_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                       struct csinn_siso_params *params);
+
 int shl_ref_scatter_nd_f32(struct csinn_tensor *input, struct csinn_tensor *indices,
                            struct csinn_tensor *updates, struct csinn_tensor *output,
                            struct csinn_scatter_nd_params *params);
@@ -937,24 +1078,36 @@ int shl_ref_sigmoid_f32(struct csinn_tensor *input, struct csinn_tensor *output,
 int shl_ref_sigmoid_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                           struct csinn_sigmoid_params *params);
 
+int shl_ref_sigmoid_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                         struct csinn_sigmoid_params *params);
+
 int shl_ref_sign_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                      struct csinn_siso_params *params);
 
 int shl_ref_sign_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                        struct csinn_siso_params *params);
 
+int shl_ref_sign_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+
 int shl_ref_sin_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                     struct csinn_siso_params *params);
 
 int shl_ref_sin_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_siso_params *params);
 
+int shl_ref_sin_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_siso_params *params);
+
 int shl_ref_sinh_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                      struct csinn_siso_params *params);
 
 int shl_ref_sinh_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                        struct csinn_siso_params *params);
 
+int shl_ref_sinh_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+
 int shl_ref_slice_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_slice_params *params);
 
@@ -967,24 +1120,37 @@ int shl_ref_softmax_f32(struct csinn_tensor *input, struct csinn_tensor *output,
 int shl_ref_softmax_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                           struct csinn_softmax_params *params);
 
+float shl_ref_softmax_row_max(const float *in, int cnt);
+float shl_ref_softmax_row_exp_sum(const float *in, float *out, int cnt, float max);
+void shl_ref_softmax_row_affine(const float *in, float *out, int cnt, float scale, float bias);
+
 int shl_ref_softplus_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                          struct csinn_siso_params *params);
 
 int shl_ref_softplus_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                            struct csinn_siso_params *params);
 
+int shl_ref_softplus_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                          struct csinn_siso_params *params);
+
 int shl_ref_softrelu_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                          struct csinn_relu_params *params);
 
 int shl_ref_softrelu_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                            struct csinn_relu_params *params);
 
+int shl_ref_softrelu_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                          struct csinn_relu_params *params);
+
 int shl_ref_softsign_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                          struct csinn_siso_params *params);
 
 int shl_ref_softsign_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                            struct csinn_siso_params *params);
 
+int shl_ref_softsign_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                          struct csinn_siso_params *params);
+
 int shl_ref_space_to_batch_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                                struct csinn_space_to_batch_params *params);
 
@@ -1009,6 +1175,9 @@ int shl_ref_sqrt_f32(struct csinn_tensor *input, struct csinn_tensor *output,
 int shl_ref_sqrt_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                        struct csinn_siso_params *params);
 
+int shl_ref_sqrt_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+
 int shl_ref_square_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                        struct csinn_siso_params *params);
 
@@ -1045,6 +1214,9 @@ int shl_ref_tan_f32(struct csinn_tensor *input, struct csinn_tensor *output,
 int shl_ref_tan_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_siso_params *params);
 
+int shl_ref_tan_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_siso_params *params);
+
 int shl_ref_tanh_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                      struct csinn_siso_params *params);
 
@@ -1054,12 +1226,18 @@ int shl_ref_tanh_f64(struct csinn_tensor *input, struct csinn_tensor *output,
 int shl_ref_tanh_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                        struct csinn_siso_params *params);
 
+int shl_ref_tanh_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+
 int shl_ref_threshold_relu_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                                struct csinn_relu_params *params);
 
 int shl_ref_threshold_relu_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                                  struct csinn_relu_params *params);
 
+int shl_ref_threshold_relu_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                                struct csinn_relu_params *params);
+
 int shl_ref_tile_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                      struct csinn_tile_params *params);
 
@@ -1072,18 +1250,33 @@ int shl_ref_topk_f32(struct csinn_tensor *input, struct csinn_tensor *output1,
 int shl_ref_topk_quant(struct csinn_tensor *input, struct csinn_tensor *output1,
                        struct csinn_tensor *output2, struct csinn_topk_params *params);
 
+void shl_ref_topk_heap_push(float *values, int32_t *indices, int *size, int k, float value,
+                            int32_t index);
+
+void shl_ref_topk_heap_sort(float *values, int32_t *indices, int size);
+
 int shl_ref_transpose(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_transpose_params *params);
 
 int shl_ref_transpose_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                             struct csinn_transpose_params *params);
 
+int shl_ref_transpose_collapse(struct csinn_tensor *input, int32_t *permute, int permute_num,
+                               int64_t *shape, int64_t *in_stride);
+
+void shl_ref_transpose_run(const void *src, void *dst, int elem_size, int rank,
+                           const int64_t *shape, const int64_t *in_stride, const uint8_t *lut,
+                           int thread_num);
+
 int shl_ref_trunc_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_siso_params *params);
 
 int shl_ref_trunc_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                         struct csinn_siso_params *params);
 
+int shl_ref_trunc_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                       struct csinn_siso_params *params);
+
 int shl_ref_unpooling_f32(struct csinn_tensor *input, struct csinn_tensor *mask,
                           struct csinn_tensor *output, struct csinn_unpooling_params *params);
 
@@ -1118,6 +1311,8 @@ int32_t shl_ref_get_index(int32_t *dim, int32_t index0, int32_t index1, int32_t
 int32_t shl_ref_get_index_5(int32_t *dim, int32_t index0, int32_t index1, int32_t index2,
                             int32_t index3, int32_t index4);
 int32_t shl_ref_get_index_iter(int32_t *dim, int dim_count, int32_t *index);
+int shl_ref_get_thread_num(struct csinn_params_base *base);
+float shl_ref_sum_all_f32(float *data, int64_t size, bool exp_sum, struct csinn_params_base *base);
 float shl_ref_get_scale(int32_t multiplier, int32_t shift);
 float shl_ref_dequantize_u8_to_f32(uint8_t input, struct csinn_quant_info *qinfo);
 float shl_ref_dequantize_i8_to_f32(int8_t input, struct csinn_quant_info *qinfo);
@@ -1141,6 +1336,8 @@ struct csinn_tensor *shl_ref_nchw_to_nhwc_f32(struct csinn_tensor *t);
 void shl_ref_nhwc_to_nchw_f32(struct csinn_tensor *nt, struct csinn_tensor *t);
 int32_t shl_ref_get_reduction_index(int32_t k, const int32_t *strides, const int32_t *extents,
                                     int32_t n);
+int shl_ref_dtype_byte(enum csinn_dtype_enum dtype);
+bool shl_ref_same_quant(struct csinn_tensor *a, struct csinn_tensor *b);
 struct csinn_tensor *shl_ref_alloc_float_tensor(struct csinn_tensor *src);
 void shl_ref_free_float_tensor(struct csinn_tensor *src);
 struct csinn_tensor *shl_ref_convert_float_tensor(struct csinn_tensor *src);
@@ -1158,6 +1355,44 @@ struct shl_ref_diso_callback {
     int32_t *input_dim;
 };
 
+struct shl_ref_stride_iter {
+    int32_t dim_count;
+    int64_t extent[MAX_DIM];
+    int64_t stride[MAX_DIM];
+    int64_t index[MAX_DIM];
+    int64_t offset;
+};
+
+void shl_ref_stride_iter_init(struct shl_ref_stride_iter *iter, const int32_t *extents,
+                              const int32_t *strides, int32_t n);
+int64_t shl_ref_stride_iter_size(struct shl_ref_stride_iter *iter);
+void shl_ref_stride_iter_seek(struct shl_ref_stride_iter *iter, int64_t pos);
+void shl_ref_stride_iter_next(struct shl_ref_stride_iter *iter);
+int64_t shl_ref_stride_iter_pop(struct shl_ref_stride_iter *iter, int64_t *stride);
+
+enum shl_ref_reduce_type {
+    SHL_REF_REDUCE_SUM = 0,
+    SHL_REF_REDUCE_MEAN,
+    SHL_REF_REDUCE_PROD,
+    SHL_REF_REDUCE_MAX,
+    SHL_REF_REDUCE_MIN,
+    SHL_REF_REDUCE_LOGSUMEXP,
+};
+
+void shl_ref_reduce_stride_f32(const float *input, float *output, const int32_t *out_extents,
+                               const int32_t *out_strides, int32_t n,
+                               const int32_t *inner_extents, const int32_t *inner_strides,
+                               int32_t m, enum shl_ref_reduce_type type,
+                               struct csinn_params_base *base);
+void shl_ref_reduce_axis_f32(const float *input, float *output, const int32_t *dim,
+                             int32_t dim_count, int32_t axis, enum shl_ref_reduce_type type,
+                             struct csinn_params_base *base);
+void shl_ref_arg_reduce_stride_f32(const float *input, int32_t *output,
+                                   const int32_t *out_extents, const int32_t *out_strides,
+                                   int32_t n, const int32_t *inner_extents,
+                                   const int32_t *inner_strides, int32_t m, bool is_max,
+                                   struct csinn_params_base *base);
+
 int shl_ref_diso_broadcast_base(struct csinn_tensor *input0, struct csinn_tensor *input1,
                                 struct csinn_tensor *output, struct csinn_diso_params *params,
                                 struct shl_ref_diso_callback *cb);
@@ -1170,6 +1405,9 @@ int shl_ref_broadcast_to_shape_quant(struct csinn_tensor *input, struct csinn_te
 
 int shl_ref_siso_callback_base(struct csinn_tensor *input, struct csinn_tensor *output,
                                void *params, void *cb);
+int shl_ref_siso_lut_init(struct csinn_tensor *input, struct csinn_tensor *output, void *params,
+                          void *cb);
+int shl_ref_siso_lut_exec(struct csinn_tensor *input, struct csinn_tensor *output, void *params);
 int shl_ref_diso_callback_base(struct csinn_tensor *input0, struct csinn_tensor *input1,
                                struct csinn_tensor *output, void *params, void *cb);
 int shl_ref_conv_callback_base(struct csinn_tensor *input, struct csinn_tensor *output,
@@ -70,6 +70,24 @@ int shl_rvv_depthwise_conv2d_init_int8(struct csinn_tensor *input, struct csinn_
 int shl_rvv_depthwise_conv2d_init_int4(struct csinn_tensor *input, struct csinn_tensor *output,
                                        struct csinn_tensor *kernel, struct csinn_tensor *bias,
                                        struct csinn_conv2d_params *params);
+int shl_rvv_deconv2d_init_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                               struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                               struct csinn_conv2d_params *params);
+int shl_rvv_deconv2d_init_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                               struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                               struct csinn_conv2d_params *params);
+int shl_rvv_deconv2d_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                               struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                               struct csinn_conv2d_params *params);
+int shl_rvv_depthwise_deconv2d_init_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                                         struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                         struct csinn_conv2d_params *params);
+int shl_rvv_depthwise_deconv2d_init_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                                         struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                         struct csinn_conv2d_params *params);
+int shl_rvv_depthwise_deconv2d_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                         struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                         struct csinn_conv2d_params *params);
 
 int shl_rvv_avgpool2d_init_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
                                 struct csinn_pool_params *params);
@@ -93,6 +111,13 @@ int shl_rvv_maxpool2d_init_int4(struct csinn_tensor *input, struct csinn_tensor
 int shl_rvv_global_maxpool2d_init(struct csinn_tensor *input, struct csinn_tensor *output,
                                   struct csinn_pool_params *params);
 
+int shl_rvv_resize_init_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                             struct csinn_resize_params *params);
+int shl_rvv_resize_init_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                             struct csinn_resize_params *params);
+int shl_rvv_resize_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                             struct csinn_resize_params *params);
+
 int shl_rvv_fullyconnected_init(struct csinn_tensor *input, struct csinn_tensor *output,
                                 struct csinn_tensor *weights, struct csinn_tensor *bias,
                                 struct csinn_fc_params *params);
@@ -289,6 +314,31 @@ int shl_rvv_wg_b4f3s1_packn_int8(struct csinn_tensor *input, struct csinn_tensor
                                  struct csinn_tensor *kernel, struct csinn_tensor *bias,
                                  struct csinn_conv2d_params *params);
 
+bool shl_rvv_wg_int8_check(struct csinn_tensor *input, struct csinn_tensor *kernel,
+                           struct csinn_tensor *bias, int32_t scale);
+void shl_rvv_wg_b2f3s1_trans_kernel_packn_int8(struct csinn_tensor *src_kernel,
+                                               struct csinn_tensor *dst_kernel);
+void shl_rvv_wg_b3f3s2_trans_kernel_packn_int8(struct csinn_tensor *src_kernel,
+                                               struct csinn_tensor *dst_kernel);
+int shl_rvv_wg_b2f3s1_packn_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                 struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                 struct csinn_conv2d_params *params);
+int shl_rvv_wg_b3f3s2_packn_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                 struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                 struct csinn_conv2d_params *params);
+
+/******************************** structured sparse *******************************/
+int shl_rvv_conv2d_sparse_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                    struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                    struct csinn_conv2d_params *params);
+
+int shl_rvv_conv2d_sparse_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                               struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                               struct csinn_conv2d_params *params);
+int shl_rvv_conv2d_sparse_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                               struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                               struct csinn_conv2d_params *params);
+
 /******************************* depthwise convolution ****************************/
 int shl_rvv_dwconv3x3s1_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
                              struct csinn_tensor *kernel, struct csinn_tensor *bias,
@@ -340,6 +390,60 @@ int shl_rvv_dwconv3x3s1_packn_int8(struct csinn_tensor *input, struct csinn_tens
 int shl_rvv_dwconv3x3s2_packn_int8(struct csinn_tensor *input, struct csinn_tensor *output,
                                    struct csinn_tensor *kernel, struct csinn_tensor *bias,
                                    struct csinn_conv2d_params *params);
+int shl_rvv_dwconv_packn_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                              struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                              struct csinn_conv2d_params *params);
+int shl_rvv_dwconv_packn_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                              struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                              struct csinn_conv2d_params *params);
+int shl_rvv_dwconv_packn_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                              struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                              struct csinn_conv2d_params *params);
+
+/********************************* deconvolution **********************************/
+void shl_rvv_deconv2d_s2_phase(int r, int ksize, int pad, int out_size, int *ntap, int *q0,
+                               int *nq);
+void shl_rvv_deconv2d_gemm_col2im_reorder_kernel_fp32(struct csinn_tensor *kernel,
+                                                      struct csinn_conv2d_params *params);
+void shl_rvv_deconv2d_gemm_col2im_reorder_kernel_fp16(struct csinn_tensor *kernel,
+                                                      struct csinn_conv2d_params *params);
+void shl_rvv_deconv2d_gemm_col2im_reorder_kernel_int8(struct csinn_tensor *kernel, int32_t input_zp,
+                                                      struct csinn_conv2d_params *params);
+int shl_rvv_deconv2d_gemm_col2im_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                                      struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                      struct csinn_conv2d_params *params);
+int shl_rvv_deconv2d_gemm_col2im_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                                      struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                      struct csinn_conv2d_params *params);
+int shl_rvv_deconv2d_gemm_col2im_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                      struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                      struct csinn_conv2d_params *params);
+
+void shl_rvv_deconv2d_s2_reorder_kernel_fp32(struct csinn_tensor *kernel,
+                                             struct csinn_conv2d_params *params);
+void shl_rvv_deconv2d_s2_reorder_kernel_fp16(struct csinn_tensor *kernel,
+                                             struct csinn_conv2d_params *params);
+void shl_rvv_deconv2d_s2_reorder_kernel_int8(struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                             int32_t input_zp, struct csinn_conv2d_params *params);
+int shl_rvv_deconv2d_s2_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                             struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                             struct csinn_conv2d_params *params);
+int shl_rvv_deconv2d_s2_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                             struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                             struct csinn_conv2d_params *params);
+int shl_rvv_deconv2d_s2_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                             struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                             struct csinn_conv2d_params *params);
+
+int shl_rvv_depthwise_deconv2d_packn_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                                          struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                          struct csinn_conv2d_params *params);
+int shl_rvv_depthwise_deconv2d_packn_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                                          struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                          struct csinn_conv2d_params *params);
+int shl_rvv_depthwise_deconv2d_packn_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                          struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                          struct csinn_conv2d_params *params);
 
 /*************************************** gemm *************************************/
 void shl_rvv_reorder_kernel_n8_fp32(float *a, float *sa, int m, int k, int ldx);
@@ -413,6 +517,24 @@ void shl_rvv_ncxhwx_gemm_12xpackn_int4(int8_t *dst, const int8_t *sa, const int8
                                        int32_t *bias, int m, int k, int n, int ldc, int32_t out_zp,
                                        int32_t *mult, int32_t *shift);
 
+void shl_rvv_set_cache_size(int32_t l1_size, int32_t l2_size);
+int shl_rvv_gemm_tile_n(int elem_size, int k, int n);
+void shl_rvv_ncxhwx_gemm_12xpack2n_blocked_fp32(float *dst, const float *sa, const float *sb,
+                                                float *bias, int m, int k, int n, int ldc);
+void shl_rvv_ncxhwx_gemm_12xpack2n_blocked_fp16(__fp16 *dst, const __fp16 *sa, const __fp16 *sb,
+                                                __fp16 *bias, int m, int k, int n, int ldc);
+void shl_rvv_ncxhwx_gemm_12xpackn_blocked_int8(int8_t *dst, const int8_t *sa, const int8_t *sb,
+                                               int32_t *bias, int m, int k, int n, int ldc,
+                                               int32_t out_zp, int32_t *mult, int32_t *shift);
+
+void shl_rvv_sparse_gemm_fp16(__fp16 *dst, const __fp16 *values, const uint8_t *index,
+                              const __fp16 *sb, const __fp16 *bias, int m, int k, int n, int keep,
+                              int row0, int out_pack);
+void shl_rvv_sparse_gemm_int8(int8_t *dst, const int8_t *values, const uint8_t *index,
+                              const int8_t *sb, const int32_t *bias, int m, int k, int n,
+                              int keep, int row0, int out_pack, int32_t out_zp,
+                              int32_t *multiplier, int32_t *shift);
+
 void shl_rvv_reorder_input_z12_pack1ton_fp32(float *b, float *sb, int inc, int maxk, int n,
                                              int ldx);
 void shl_rvv_reorder_input_z12_pack1ton_fp16(__fp16 *b, __fp16 *sb, int inc, int maxk, int n,
@@ -515,6 +637,19 @@ int shl_rvv_avgpool3x3s2_packn_fp16(struct csinn_tensor *input, struct csinn_ten
 int shl_rvv_avgpool3x3s1_packn_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
                                     struct csinn_pool_params *params);
 
+int shl_rvv_maxpool2d_packn_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                                 struct csinn_pool_params *params);
+int shl_rvv_maxpool2d_packn_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                                 struct csinn_pool_params *params);
+int shl_rvv_maxpool2d_packn_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                 struct csinn_pool_params *params);
+int shl_rvv_avgpool2d_packn_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                                 struct csinn_pool_params *params);
+int shl_rvv_avgpool2d_packn_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                                 struct csinn_pool_params *params);
+int shl_rvv_avgpool2d_packn_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                 struct csinn_pool_params *params);
+
 int shl_rvv_global_maxpool2d_packn_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
                                         struct csinn_pool_params *params);
 int shl_rvv_global_maxpool2d_packn_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
@@ -543,6 +678,39 @@ int shl_rvv_fullyconnected_packn_int8(struct csinn_tensor *input, struct csinn_t
                                       struct csinn_tensor *weights, struct csinn_tensor *bias,
                                       struct csinn_fc_params *params);
 
+int shl_rvv_fullyconnected_sparse_init_int8(struct csinn_tensor *input,
+                                            struct csinn_tensor *output,
+                                            struct csinn_tensor *weights,
+                                            struct csinn_tensor *bias,
+                                            struct csinn_fc_params *params);
+int shl_rvv_fullyconnected_sparse_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                                       struct csinn_tensor *weights, struct csinn_tensor *bias,
+                                       struct csinn_fc_params *params);
+int shl_rvv_fullyconnected_sparse_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                       struct csinn_tensor *weights, struct csinn_tensor *bias,
+                                       struct csinn_fc_params *params);
+void shl_rvv_fc_sparse_gemv_transform_weight(struct csinn_tensor *weights, int block);
+int shl_rvv_fullyconnected_sparse_gemv_init(struct csinn_tensor *input,
+                                            struct csinn_tensor *output,
+                                            struct csinn_tensor *weights,
+                                            struct csinn_tensor *bias,
+                                            struct csinn_fc_params *params);
+int shl_rvv_fullyconnected_sparse_gemv_fp32(struct csinn_tensor *input,
+                                            struct csinn_tensor *output,
+                                            struct csinn_tensor *weights,
+                                            struct csinn_tensor *bias,
+                                            struct csinn_fc_params *params);
+int shl_rvv_fullyconnected_sparse_gemv_fp16(struct csinn_tensor *input,
+                                            struct csinn_tensor *output,
+                                            struct csinn_tensor *weights,
+                                            struct csinn_tensor *bias,
+                                            struct csinn_fc_params *params);
+int shl_rvv_fullyconnected_sparse_gemv_int8(struct csinn_tensor *input,
+                                            struct csinn_tensor *output,
+                                            struct csinn_tensor *weights,
+                                            struct csinn_tensor *bias,
+                                            struct csinn_fc_params *params);
+
 void shl_rvv_fc_gemv_transform_weight_int8_dot(struct csinn_tensor *weights);
 void shl_rvv_fc_gemv_transform_weight_int4_dot(struct csinn_tensor *weights);
 
@@ -553,6 +721,23 @@ int shl_rvv_fullyconnected_packn_int4_dot(struct csinn_tensor *input, struct csi
                                           struct csinn_tensor *weights, struct csinn_tensor *bias,
                                           struct csinn_fc_params *params);
 
+/************************************ matmul *********************************/
+void shl_rvv_transpose_int8(const int8_t *src, int8_t *dst, int rows, int cols);
+
+int shl_rvv_matmul_init(struct csinn_tensor *mat0, struct csinn_tensor *mat1,
+                        struct csinn_tensor *output, struct csinn_matmul_params *params);
+int shl_rvv_matmul_int8(struct csinn_tensor *mat0, struct csinn_tensor *mat1,
+                        struct csinn_tensor *output, struct csinn_matmul_params *params);
+
+int shl_rvv_scaled_dot_product_attention_init(
+    struct csinn_tensor *query, struct csinn_tensor *key, struct csinn_tensor *value,
+    struct csinn_tensor *mask, struct csinn_tensor *output,
+    struct csinn_scaled_dot_product_attention_params *params);
+int shl_rvv_scaled_dot_product_attention_int8(
+    struct csinn_tensor *query, struct csinn_tensor *key, struct csinn_tensor *value,
+    struct csinn_tensor *mask, struct csinn_tensor *output,
+    struct csinn_scaled_dot_product_attention_params *params);
+
 /************************************ activation *********************************/
 int shl_rvv_relu_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_relu_params *params);
@@ -578,8 +763,83 @@ int shl_rvv_leaky_relu_int8(struct csinn_tensor *input, struct csinn_tensor *out
 int shl_rvv_sigmoid_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
                          struct csinn_sigmoid_params *params);
 
+int shl_rvv_softmax_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                         struct csinn_softmax_params *params);
 int shl_rvv_softmax_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
                          struct csinn_softmax_params *params);
+int shl_rvv_softmax_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                         struct csinn_softmax_params *params);
+int shl_rvv_softmax_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                              struct csinn_softmax_params *params);
+int shl_rvv_log_softmax_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                             struct csinn_softmax_params *params);
+int shl_rvv_log_softmax_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                             struct csinn_softmax_params *params);
+int shl_rvv_log_softmax_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                             struct csinn_softmax_params *params);
+int shl_rvv_log_softmax_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                  struct csinn_softmax_params *params);
+
+int shl_rvv_elu_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_relu_params *params);
+int shl_rvv_elu_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_relu_params *params);
+int shl_rvv_elu_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                          struct csinn_relu_params *params);
+
+int shl_rvv_erf_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_siso_params *params);
+int shl_rvv_erf_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_siso_params *params);
+int shl_rvv_erf_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                          struct csinn_siso_params *params);
+
+int shl_rvv_exp_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_siso_params *params);
+int shl_rvv_exp_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_siso_params *params);
+int shl_rvv_exp_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                          struct csinn_siso_params *params);
+
+int shl_rvv_gelu_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+int shl_rvv_gelu_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+int shl_rvv_gelu_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                           struct csinn_siso_params *params);
+
+int shl_rvv_mish_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+int shl_rvv_mish_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+int shl_rvv_mish_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                           struct csinn_siso_params *params);
+
+int shl_rvv_sigmoid_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                         struct csinn_sigmoid_params *params);
+int shl_rvv_sigmoid_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                              struct csinn_sigmoid_params *params);
+
+int shl_rvv_silu_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+int shl_rvv_silu_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+int shl_rvv_silu_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                           struct csinn_siso_params *params);
+
+int shl_rvv_softplus_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                          struct csinn_siso_params *params);
+int shl_rvv_softplus_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                          struct csinn_siso_params *params);
+int shl_rvv_softplus_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                               struct csinn_siso_params *params);
+
+int shl_rvv_tanh_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+int shl_rvv_tanh_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params);
+int shl_rvv_tanh_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                           struct csinn_siso_params *params);
 
 /************************************ layout/memory transform *********************************/
 int shl_rvv_concat_fp32(struct csinn_tensor **input, struct csinn_tensor *output,
@@ -589,6 +849,27 @@ int shl_rvv_concat_fp16(struct csinn_tensor **input, struct csinn_tensor *output
 int shl_rvv_concat_int8(struct csinn_tensor **input, struct csinn_tensor *output,
                         struct csinn_concat_params *params);
 
+int shl_rvv_resize_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                        struct csinn_resize_params *params);
+int shl_rvv_resize_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                        struct csinn_resize_params *params);
+int shl_rvv_resize_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                        struct csinn_resize_params *params);
+int shl_rvv_resize_packn_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                              struct csinn_resize_params *params);
+int shl_rvv_resize_packn_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                              struct csinn_resize_params *params);
+int shl_rvv_resize_packn_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                              struct csinn_resize_params *params);
+
+int shl_rvv_non_max_suppression_fp32(struct csinn_tensor *input0, struct csinn_tensor *input1,
+                                     struct csinn_tensor *output,
+                                     struct csinn_non_max_suppression_params *params);
+int shl_rvv_topk_fp32(struct csinn_tensor *input, struct csinn_tensor *output1,
+                      struct csinn_tensor *output2, struct csinn_topk_params *params);
+int shl_rvv_transpose(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_transpose_params *params);
+
 /************************************ basic math *********************************/
 int shl_rvv_add_fp32(struct csinn_tensor *input0, struct csinn_tensor *input1,
                      struct csinn_tensor *output, struct csinn_diso_params *params);
@@ -645,6 +926,11 @@ void shl_rvv_saturated_int8(int32_t *src, int8_t *dst, int32_t out_zp, int size)
 
 void shl_rvv_requantize(int32_t *src, int32_t multiplier, int32_t shift, int channel_size);
 
+int shl_rvv_siso_lut_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                               struct csinn_params_base *base, float (*func)(float));
+int shl_rvv_siso_lut_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                          struct csinn_params_base *base);
+
 void shl_rvv_pad_input_int4_trans_int8(const int8_t *input, int8_t *input_padded, int inc, int inh,
                                        int inw, int padded_h, int padded_w, int pad_top,
                                        int pad_left, int8_t pad_value);
@@ -660,6 +946,7 @@ int shl_rvv_data_convert_int4_to_int8(struct csinn_tensor *input, struct csinn_t
 
 int csrr_vl();
 int csrr_vlenb();
+int32_t shl_rvv_tune_core(struct csinn_params_base *base);
 
 #ifdef __cplusplus
 }
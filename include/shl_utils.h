@@ -53,6 +53,69 @@ void *shl_get_p0_cb(struct csinn_params_base *base);
 void *shl_get_init_cb(struct csinn_params_base *base);
 
 enum csinn_rmode_enum shl_get_run_mode(struct csinn_params_base *base);
+void *shl_get_runtime_callback(struct csinn_session *sess, int op);
+
+int shl_async_update_input(int index, struct csinn_tensor *input, struct csinn_session *sess);
+int shl_async_update_output(int index, struct csinn_tensor *output, struct csinn_session *sess);
+void shl_async_deinit(struct csinn_session *sess);
+void *shl_async_input_image(int index, int64_t size, struct csinn_session *sess);
+
+void *shl_preprocess_buffer(void **buffers, int num, int index, int64_t size);
+void shl_preprocess_free(void *buffers, int num);
+
+int shl_get_thread_num(struct csinn_session *sess);
+
+void shl_quantize_f32_to_u8(float *src, uint8_t *dst, int64_t size, float *scale, float *zp,
+                            bool channel_last, int thread_num);
+void shl_quantize_f32_to_i8(float *src, int8_t *dst, int64_t size, float *scale, float *zp,
+                            bool channel_last, int thread_num);
+void shl_quantize_f32_to_i16(float *src, int16_t *dst, int64_t size, float *scale, float *zp,
+                             bool channel_last, int thread_num);
+void shl_dequantize_u8_to_f32(uint8_t *src, float *dst, int64_t size, float *scale, float *zp,
+                              bool channel_last, int thread_num);
+void shl_dequantize_i8_to_f32(int8_t *src, float *dst, int64_t size, float *scale, float *zp,
+                              bool channel_last, int thread_num);
+void shl_dequantize_i16_to_f32(int16_t *src, float *dst, int64_t size, float *scale, float *zp,
+                               bool channel_last, int thread_num);
+void shl_dequantize_i32_to_f32(int32_t *src, float *dst, int64_t size, float *scale, float *zp,
+                               bool channel_last, int thread_num);
+void shl_f32_to_f16(float *src, int16_t *dst, int64_t size, int thread_num);
+void shl_f16_to_f32(int16_t *src, float *dst, int64_t size, int thread_num);
+void shl_f32_to_bf16(float *src, int16_t *dst, int64_t size);
+void shl_bf16_to_f32(int16_t *src, float *dst, int64_t size);
+
+int shl_sparse_keep(enum csinn_mem_type_enum mtype);
+int32_t shl_sparse_groups(struct csinn_tensor *t);
+int64_t shl_sparse_byte_size(struct csinn_tensor *t);
+uint8_t *shl_sparse_index(struct csinn_tensor *t);
+int shl_sparse_compress(struct csinn_tensor *t, enum csinn_mem_type_enum mtype);
+void shl_sparse_decompress(struct csinn_tensor *t, void *dense);
+void *shl_sparse_to_f32(struct csinn_tensor *t);
+
+/* algorithms a conv2d init may pick, the ids stored in tuning caches */
+enum shl_conv2d_algo_enum {
+    SHL_CONV2D_ALGO_IM2COL_GEMM = 0,
+    SHL_CONV2D_ALGO_WG_B2F3S1,
+    SHL_CONV2D_ALGO_WG_B4F3S1,
+    SHL_CONV2D_ALGO_WG_B6F3S1,
+};
+
+/* prepare transforms kernel for the algorithm and sets conv_mode, kernel_tm and exec */
+struct shl_conv2d_algo {
+    int32_t id;
+    void (*prepare)(struct csinn_tensor *kernel, struct csinn_conv2d_params *params);
+};
+
+int shl_conv2d_tune(struct csinn_tensor *input, struct csinn_tensor *output,
+                    struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                    struct csinn_conv2d_params *params, const struct shl_conv2d_algo *algo,
+                    int algo_num, int heuristic, int32_t core);
+#define SHL_TUNE_KEY_SIZE 24
+int shl_tune_cache_lookup(struct csinn_session *sess, const int32_t *key);
+void shl_tune_cache_insert(struct csinn_session *sess, const int32_t *key, int32_t algo);
+char *shl_tune_cache_dump(struct csinn_session *sess, int *size);
+int shl_tune_cache_load(struct csinn_session *sess, const char *buf, int size);
+void shl_tune_cache_free(struct csinn_session *sess);
 
 struct shl_cb_op_list {
     struct shl_cb_op_list *next;
@@ -79,7 +142,10 @@ struct shl_bm_sections {
 struct shl_binary_model_section_info {
     int32_t section_num;
     int32_t section_info_size;
-    int32_t reserve[6];
+    /* pages and bytes of the tuning cache, set by shl_dump_bm_tune_section, 0 when none */
+    int32_t tune_offset;
+    int32_t tune_size;
+    int32_t reserve[4];
     struct shl_bm_sections sections[127];
 };
 
@@ -88,6 +154,9 @@ char *shl_bm_header_str();
 void shl_dump_bm_header(FILE *f);
 void shl_dump_bm_section_info(FILE *f, struct shl_binary_model_section_info *info);
 void shl_dump_bm_graph_info_section(FILE *f, struct csinn_session *sess);
+void shl_dump_bm_tune_section(FILE *f, struct csinn_session *sess,
+                              struct shl_binary_model_section_info *info);
+int shl_bm_tune_load(struct csinn_session *sess, char *bm_addr);
 void shl_bm_session_load(struct csinn_session *dest, struct csinn_session *src);
 
 #ifdef __cplusplus
@@ -20,6 +20,48 @@
 
 #include "shl_c906.h"
 
+static void winograd64_pack4(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_WINOGRAD;
+    params->conv_extra.kernel_tm = csinn_alloc_tensor(NULL);
+    shl_c906_conv3x3s1_winograd64_transform_kernel_pack4(kernel, params->conv_extra.kernel_tm);
+    params->base.cb->exec = shl_c906_conv3x3s1_winograd64_pack4;
+}
+
+static void im2col_sgemm(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_GEMM;
+    shl_c906_conv_im2col_sgemm_transform_kernel(kernel, params);
+    params->base.cb->exec = shl_c906_conv_im2col_sgemm;
+}
+
+/* 3x3s1 candidates, winograd F(6,3) is the untuned choice */
+static const struct shl_conv2d_algo conv3x3s1_pack4[] = {
+    {SHL_CONV2D_ALGO_WG_B6F3S1, winograd64_pack4},
+    {SHL_CONV2D_ALGO_IM2COL_GEMM, im2col_sgemm},
+};
+
+static void winograd64_pack8_fp16(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_WINOGRAD;
+    params->conv_extra.kernel_tm = csinn_alloc_tensor(NULL);
+    shl_c906_conv3x3s1_winograd64_transform_kernel_pack8_fp16(kernel,
+                                                              params->conv_extra.kernel_tm);
+    params->base.cb->exec = shl_c906_conv3x3s1_winograd64_pack8_fp16;
+}
+
+static void im2col_sgemm_fp16(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_GEMM;
+    shl_c906_conv_im2col_sgemm_transform_kernel_fp16(kernel, params);
+    params->base.cb->exec = shl_c906_conv_im2col_sgemm_fp16;
+}
+
+static const struct shl_conv2d_algo conv3x3s1_pack8_fp16[] = {
+    {SHL_CONV2D_ALGO_WG_B6F3S1, winograd64_pack8_fp16},
+    {SHL_CONV2D_ALGO_IM2COL_GEMM, im2col_sgemm_fp16},
+};
+
 /*
    only support layout:NCHW
    input layout:  N C H W
@@ -42,6 +84,12 @@ int shl_c906_conv2d_init(struct csinn_tensor *input, struct csinn_tensor *output
     int32_t dalition_w = params->dilation_width;
     struct csinn_callback *cb = params->base.cb;
 
+    if (shl_sparse_keep(kernel->mtype)) {
+        // the c906 kernels expect dense weights, the reference runs over the kept ones
+        cb->exec = input->dtype == CSINN_DTYPE_FLOAT32 ? shl_ref_conv2d_f32 : shl_ref_conv2d_quant;
+        return CSINN_TRUE;
+    }
+
     // check
     int out_height = (in_h + params->pad_top + params->pad_down - kernel_h) / stride_h + 1;
     int out_width  = (in_w + params->pad_left + params->pad_right - kernel_w) / stride_w + 1;
@@ -73,11 +121,9 @@ int shl_c906_conv2d_init(struct csinn_tensor *input, struct csinn_tensor *output
 
             // pack4 for winograd convolution
             if ( (out_c % 4 == 0) && (in_c % 4 ==0) ) {
-                params->conv_extra.conv_mode = CSINN_WINOGRAD;
-                struct csinn_tensor *t_kernel = csinn_alloc_tensor(NULL);
-                shl_c906_conv3x3s1_winograd64_transform_kernel_pack4(kernel, t_kernel);
-                params->conv_extra.kernel_tm = t_kernel;
-                cb->exec = shl_c906_conv3x3s1_winograd64_pack4;
+                int algo = shl_conv2d_tune(input, output, kernel, bias, params, conv3x3s1_pack4, 2,
+                                           0, shl_rvv_tune_core(&params->base));
+                conv3x3s1_pack4[algo].prepare(kernel, params);
             } else {
                 params->conv_extra.conv_mode = CSINN_GEMM;
                 shl_c906_conv_im2col_sgemm_transform_kernel(kernel, params);
@@ -95,11 +141,10 @@ int shl_c906_conv2d_init(struct csinn_tensor *input, struct csinn_tensor *output
 
             // pack8 for winograd convolution
             if ( (out_c % 8 == 0) && (in_c % 8 ==0) ) {
-                params->conv_extra.conv_mode = CSINN_WINOGRAD;
-                struct csinn_tensor *t_kernel = csinn_alloc_tensor(NULL);
-                shl_c906_conv3x3s1_winograd64_transform_kernel_pack8_fp16(kernel, t_kernel);
-                params->conv_extra.kernel_tm = t_kernel;
-                cb->exec = shl_c906_conv3x3s1_winograd64_pack8_fp16;
+                int algo = shl_conv2d_tune(input, output, kernel, bias, params,
+                                           conv3x3s1_pack8_fp16, 2, 0,
+                                           shl_rvv_tune_core(&params->base));
+                conv3x3s1_pack8_fp16[algo].prepare(kernel, params);
             } else {
                 params->conv_extra.conv_mode = CSINN_GEMM;
                 shl_c906_conv_im2col_sgemm_transform_kernel_fp16(kernel, params);
@@ -139,6 +184,13 @@ int shl_c906_depthwise_conv2d_init(struct csinn_tensor *input, struct csinn_tens
     int32_t stride_w = params->stride_width;
     struct csinn_callback *cb = params->base.cb;
 
+    if (shl_sparse_keep(kernel->mtype)) {
+        // the c906 kernels expect dense weights, the reference runs over the kept ones
+        cb->exec = input->dtype == CSINN_DTYPE_FLOAT32 ? shl_ref_depthwise_conv2d_f32
+                                                       : shl_ref_depthwise_conv2d_quant;
+        return CSINN_TRUE;
+    }
+
     if (kernel_h == 3 && kernel_w == 3 && stride_h == 1 && stride_w == 1) {
         if (input->dtype == CSINN_DTYPE_FLOAT32) {
             cb->exec = shl_c906_dwconv3x3s1;
@@ -42,6 +42,12 @@ int shl_c906_conv2d_relu_init(struct csinn_tensor *input, struct csinn_tensor *o
     int32_t dalition_w = params->dilation_width;
     struct csinn_callback *cb = params->base.cb;
 
+    if (shl_sparse_keep(kernel->mtype)) {
+        // the c906 kernels expect dense weights, the reference runs over the kept ones
+        cb->exec = shl_ref_conv2d_relu_f32;
+        return CSINN_TRUE;
+    }
+
     if (kernel_h == 1 && kernel_w == 1 && stride_h == 1 && stride_w == 1 && dalition_h == 1 &&
         dalition_w == 1) {
         shl_c906_conv1x1s1_sgemm_transform_kernel(kernel, params);
@@ -75,6 +81,12 @@ int shl_c906_depthwise_conv2d_relu_init(struct csinn_tensor *input, struct csinn
     int32_t stride_w = params->stride_width;
     struct csinn_callback *cb = params->base.cb;
 
+    if (shl_sparse_keep(kernel->mtype)) {
+        // the c906 kernels expect dense weights, the reference runs over the kept ones
+        cb->exec = shl_ref_depthwise_conv2d_relu_f32;
+        return CSINN_TRUE;
+    }
+
     if (kernel_h == 3 && kernel_w == 3 && stride_h == 1 && stride_w == 1) {
         cb->exec = shl_c906_dwconv3x3s1_fuse_relu;
 
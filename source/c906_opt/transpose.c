@@ -77,5 +77,5 @@ int shl_c906_transpose_fp16(struct csinn_tensor *input, struct csinn_tensor *out
         }
         return CSINN_TRUE;
     }
-    return shl_ref_siso_callback_base(input, output, params, shl_ref_transpose);
+    return shl_rvv_transpose(input, output, params);
 }
@@ -20,6 +20,86 @@
 
 #include "shl_c908.h"
 
+static void wg_b6f3s1_packn_fp32(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_WINOGRAD;
+    params->conv_extra.kernel_tm = csinn_alloc_tensor(NULL);
+    shl_c908_ncxhwx_wg_b6f3s1_trans_kernel_packn_fp32(kernel, params->conv_extra.kernel_tm);
+    params->base.cb->exec = shl_c908_ncxhwx_wg_b6f3s1_packn_fp32;
+}
+
+static void wg_b4f3s1_packn_fp32(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_WINOGRAD;
+    params->conv_extra.kernel_tm = csinn_alloc_tensor(NULL);
+    shl_c908_ncxhwx_wg_b4f3s1_trans_kernel_packn_fp32(kernel, params->conv_extra.kernel_tm);
+    params->base.cb->exec = shl_c908_ncxhwx_wg_b4f3s1_packn_fp32;
+}
+
+static void im2col_gemm_packn_fp32(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_GEMM;
+    shl_c908_conv_im2col_gemm_reorder_kernel_packn_fp32(kernel, params);
+    params->base.cb->exec = shl_c908_conv_im2col_gemm_packn_fp32;
+}
+
+/* candidates of 3x3s1 packn conv2d, index 1 is the small map heuristic */
+static const struct shl_conv2d_algo conv3x3s1_packn_fp32[] = {
+    {SHL_CONV2D_ALGO_WG_B6F3S1, wg_b6f3s1_packn_fp32},
+    {SHL_CONV2D_ALGO_WG_B4F3S1, wg_b4f3s1_packn_fp32},
+    {SHL_CONV2D_ALGO_IM2COL_GEMM, im2col_gemm_packn_fp32},
+};
+
+static void wg_b6f3s1_packn_fp16(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_WINOGRAD;
+    params->conv_extra.kernel_tm = csinn_alloc_tensor(NULL);
+    shl_c908_ncxhwx_wg_b6f3s1_trans_kernel_packn_fp16(kernel, params->conv_extra.kernel_tm);
+    params->base.cb->exec = shl_c908_ncxhwx_wg_b6f3s1_packn_fp16;
+}
+
+static void wg_b4f3s1_packn_fp16(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_WINOGRAD;
+    params->conv_extra.kernel_tm = csinn_alloc_tensor(NULL);
+    shl_c908_ncxhwx_wg_b4f3s1_trans_kernel_packn_fp16(kernel, params->conv_extra.kernel_tm);
+    params->base.cb->exec = shl_c908_ncxhwx_wg_b4f3s1_packn_fp16;
+}
+
+static void im2col_gemm_packn_fp16(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_GEMM;
+    shl_c908_conv_im2col_gemm_reorder_kernel_packn_fp16(kernel, params);
+    params->base.cb->exec = shl_c908_conv_im2col_gemm_packn_fp16;
+}
+
+static const struct shl_conv2d_algo conv3x3s1_packn_fp16[] = {
+    {SHL_CONV2D_ALGO_WG_B6F3S1, wg_b6f3s1_packn_fp16},
+    {SHL_CONV2D_ALGO_WG_B4F3S1, wg_b4f3s1_packn_fp16},
+    {SHL_CONV2D_ALGO_IM2COL_GEMM, im2col_gemm_packn_fp16},
+};
+
+static void wg_b4f3s1_packn_int8(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_WINOGRAD;
+    params->conv_extra.kernel_tm = csinn_alloc_tensor(NULL);
+    shl_c908_ncxhwx_wg_b4f3s1_trans_kernel_packn_int8(kernel, params->conv_extra.kernel_tm);
+    params->base.cb->exec = shl_c908_ncxhwx_wg_b4f3s1_packn_int8;
+}
+
+static void im2col_gemm_packn_int8(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_GEMM;
+    params->conv_extra.kernel_tm = csinn_alloc_tensor(NULL);
+    shl_c908_conv_im2col_gemm_reorder_kernel_packn_int8(kernel, params);
+    params->base.cb->exec = shl_c908_conv_im2col_gemm_packn_int8;
+}
+
+static const struct shl_conv2d_algo conv3x3s1_packn_int8[] = {
+    {SHL_CONV2D_ALGO_WG_B4F3S1, wg_b4f3s1_packn_int8},
+    {SHL_CONV2D_ALGO_IM2COL_GEMM, im2col_gemm_packn_int8},
+};
+
 int shl_c908_conv2d_init_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
                               struct csinn_tensor *kernel, struct csinn_tensor *bias,
                               struct csinn_conv2d_params *params)
@@ -38,6 +118,12 @@ int shl_c908_conv2d_init_fp32(struct csinn_tensor *input, struct csinn_tensor *o
 
     const int packn = csrr_vlenb() / sizeof(float);
 
+    if (shl_sparse_keep(kernel->mtype)) {
+        // no fp32 sparse kernel, the reference runs over the kept weights
+        cb->exec = shl_ref_conv2d_f32;
+        return CSINN_TRUE;
+    }
+
     // packn
     if (in_c % packn == 0 && out_c % packn == 0) {
         if (kernel_h == 1 && kernel_w == 1 && stride_h == 1 && stride_w == 1 && dalition_h == 1 &&
@@ -53,16 +139,11 @@ int shl_c908_conv2d_init_fp32(struct csinn_tensor *input, struct csinn_tensor *o
                 cb->exec = shl_c908_conv_im2col_gemm_packn_fp32;
                 return CSINN_TRUE;
             } else {
-                params->conv_extra.conv_mode = CSINN_WINOGRAD;
-                struct csinn_tensor *t_kernel = csinn_alloc_tensor(NULL);
-                if ((in_h < 13) && (in_w < 13)) {
-                    shl_c908_ncxhwx_wg_b4f3s1_trans_kernel_packn_fp32(kernel, t_kernel);
-                    cb->exec = shl_c908_ncxhwx_wg_b4f3s1_packn_fp32;
-                } else {
-                    shl_c908_ncxhwx_wg_b6f3s1_trans_kernel_packn_fp32(kernel, t_kernel);
-                    cb->exec = shl_c908_ncxhwx_wg_b6f3s1_packn_fp32;
-                }
-                params->conv_extra.kernel_tm = t_kernel;
+                /* b4f3 on small maps unless tuning measured otherwise */
+                int algo = shl_conv2d_tune(input, output, kernel, bias, params,
+                                           conv3x3s1_packn_fp32, 3, (in_h < 13) && (in_w < 13),
+                                           shl_rvv_tune_core(&params->base));
+                conv3x3s1_packn_fp32[algo].prepare(kernel, params);
             }
         } else {
             params->conv_extra.conv_mode = CSINN_GEMM;
@@ -130,6 +211,12 @@ int shl_c908_conv2d_init_fp16(struct csinn_tensor *input, struct csinn_tensor *o
 
     const int packn = csrr_vlenb() / sizeof(__fp16);
 
+    if (shl_sparse_keep(kernel->mtype)) {
+        params->conv_extra.conv_mode = CSINN_GEMM;
+        cb->exec = shl_rvv_conv2d_sparse_fp16;
+        return CSINN_TRUE;
+    }
+
     // packn
     if (in_c % packn == 0 && out_c % packn == 0) {
         if (kernel_h == 1 && kernel_w == 1 && stride_h == 1 && stride_w == 1 && dalition_h == 1 &&
@@ -145,16 +232,10 @@ int shl_c908_conv2d_init_fp16(struct csinn_tensor *input, struct csinn_tensor *o
                 cb->exec = shl_c908_conv_im2col_gemm_packn_fp16;
                 return CSINN_TRUE;
             } else {
-                params->conv_extra.conv_mode = CSINN_WINOGRAD;
-                struct csinn_tensor *t_kernel = csinn_alloc_tensor(NULL);
-                if ((in_h < 13) && (in_w < 13)) {
-                    shl_c908_ncxhwx_wg_b4f3s1_trans_kernel_packn_fp16(kernel, t_kernel);
-                    cb->exec = shl_c908_ncxhwx_wg_b4f3s1_packn_fp16;
-                } else {
-                    shl_c908_ncxhwx_wg_b6f3s1_trans_kernel_packn_fp16(kernel, t_kernel);
-                    cb->exec = shl_c908_ncxhwx_wg_b6f3s1_packn_fp16;
-                }
-                params->conv_extra.kernel_tm = t_kernel;
+                int algo = shl_conv2d_tune(input, output, kernel, bias, params,
+                                           conv3x3s1_packn_fp16, 3, (in_h < 13) && (in_w < 13),
+                                           shl_rvv_tune_core(&params->base));
+                conv3x3s1_packn_fp16[algo].prepare(kernel, params);
             }
         } else {
             params->conv_extra.conv_mode = CSINN_GEMM;
@@ -222,6 +303,10 @@ int shl_c908_conv2d_init_int8(struct csinn_tensor *input, struct csinn_tensor *o
 
     const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
 
+    if (shl_sparse_keep(kernel->mtype)) {
+        return shl_rvv_conv2d_sparse_init_int8(input, output, kernel, bias, params);
+    }
+
     // packn
     if (in_c % packn == 0 && out_c % packn == 0) {
         if (kernel_h == 1 && kernel_w == 1 && stride_h == 1 && stride_w == 1 && dalition_h == 1 &&
@@ -239,11 +324,10 @@ int shl_c908_conv2d_init_int8(struct csinn_tensor *input, struct csinn_tensor *o
                 cb->exec = shl_c908_conv_im2col_gemm_packn_int8;
                 return CSINN_TRUE;
             } else {
-                params->conv_extra.conv_mode = CSINN_WINOGRAD;
-                struct csinn_tensor *t_kernel = csinn_alloc_tensor(NULL);
-                shl_c908_ncxhwx_wg_b4f3s1_trans_kernel_packn_int8(kernel, t_kernel);
-                cb->exec = shl_c908_ncxhwx_wg_b4f3s1_packn_int8;
-                params->conv_extra.kernel_tm = t_kernel;
+                int algo = shl_conv2d_tune(input, output, kernel, bias, params,
+                                           conv3x3s1_packn_int8, 2, 0,
+                                           shl_rvv_tune_core(&params->base));
+                conv3x3s1_packn_int8[algo].prepare(kernel, params);
             }
         } else {
             params->conv_extra.conv_mode = CSINN_GEMM;
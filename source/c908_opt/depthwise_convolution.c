@@ -35,6 +35,12 @@ int shl_c908_depthwise_conv2d_init_fp32(struct csinn_tensor *input, struct csinn
 
     const int packn = csrr_vlenb() / sizeof(float);
 
+    if (shl_sparse_keep(kernel->mtype)) {
+        // no fp32 sparse kernel, the reference runs over the kept weights
+        cb->exec = shl_ref_depthwise_conv2d_f32;
+        return CSINN_TRUE;
+    }
+
     if (in_c % packn == 0 && out_c % packn == 0) {
         if (kernel_h == 3 && kernel_w == 3 && stride_h == 1 && stride_w == 1) {
             shl_rvv_dwconv_reorder_kernel_packn_fp32(kernel, params);
@@ -75,6 +81,12 @@ int shl_c908_depthwise_conv2d_init_fp16(struct csinn_tensor *input, struct csinn
 
     const int packn = csrr_vlenb() / sizeof(__fp16);
 
+    if (shl_sparse_keep(kernel->mtype)) {
+        params->conv_extra.conv_mode = CSINN_GEMM;
+        cb->exec = shl_rvv_conv2d_sparse_fp16;
+        return CSINN_TRUE;
+    }
+
     if (in_c % packn == 0 && out_c % packn == 0) {
         if (kernel_h == 3 && kernel_w == 3 && stride_h == 1 && stride_w == 1) {
             shl_rvv_dwconv_reorder_kernel_packn_fp16(kernel, params);
@@ -115,6 +127,10 @@ int shl_c908_depthwise_conv2d_init_int8(struct csinn_tensor *input, struct csinn
 
     const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
 
+    if (shl_sparse_keep(kernel->mtype)) {
+        return shl_rvv_conv2d_sparse_init_int8(input, output, kernel, bias, params);
+    }
+
     // enable fuse zeropoint to bias
     if (!params->conv_extra.fuse_zp2bias) {
         int32_t *bias_data = (int32_t *)bias->data;
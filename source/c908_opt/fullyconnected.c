@@ -28,6 +28,10 @@ int shl_c908_fullyconnected_init(struct csinn_tensor *input, struct csinn_tensor
     const int out_nodes = weights->dim[weights_dims_count - 2];
     const int in_nodes = weights->dim[weights_dims_count - 1];
     struct csinn_callback *cb = params->base.cb;
+    if (shl_sparse_keep(weights->mtype)) {
+        // structured sparse weights take the sparse gemm / gemv kernels
+        return shl_rvv_fullyconnected_init(input, output, weights, bias, params);
+    }
     if (input->dtype == CSINN_DTYPE_FLOAT32) {
         shl_rvv_fc_gemv_transform_weight_fp32(weights);
         cb->exec = shl_rvv_fullyconnected_packn_fp32;
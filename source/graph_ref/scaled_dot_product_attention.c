@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_gref.h"
+
+static struct shl_node *attention_in_node(struct csinn_tensor *t)
+{
+    if (t->is_const) {
+        return shl_node_const_var_alloc(t->name, t);
+    }
+    return (struct shl_node *)t->data;
+}
+
+/* the node has no fourth input without a mask */
+int shl_gref_scaled_dot_product_attention(
+    struct csinn_tensor *query, struct csinn_tensor *key, struct csinn_tensor *value,
+    struct csinn_tensor *mask, struct csinn_tensor *output,
+    struct csinn_scaled_dot_product_attention_params *params)
+{
+    struct csinn_params_base *ptr = (void *)params;
+    bool has_mask = mask != NULL && mask->dim_count > 0;
+    struct shl_node *layer = shl_node_alloc(CSINN_OP_SCALED_DOT_PRODUCT_ATTENTION, ptr->name,
+                                            has_mask ? 4 : 3, 1, params);
+    shl_node_add_in(layer, (struct shl_node *)query->data, 0);
+    shl_node_add_in(layer, attention_in_node(key), 1);
+    shl_node_add_in(layer, attention_in_node(value), 2);
+    if (has_mask) {
+        shl_node_add_in(layer, attention_in_node(mask), 3);
+    }
+    struct shl_node *out = shl_node_var_alloc(output->name, output);
+    shl_node_add_out(layer, out, 0);
+    output->data = out;
+    struct shl_ref_graph *graph = shl_gref_get_graph(query->sess);
+    shl_gref_graph_insert(layer, graph);
+    return CSINN_TRUE;
+}
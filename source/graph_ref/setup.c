@@ -48,11 +48,30 @@ int shl_gref_get_input(int index, struct csinn_tensor *input, struct csinn_sessi
     return CSINN_TRUE;
 }
 
+static void plan_cache_init(struct csinn_session *sess);
+
 void shl_gref_update_input(int index, struct csinn_tensor *input, struct csinn_session *sess)
 {
     struct shl_ref_graph *graph = shl_gref_get_graph(sess);
     struct csinn_tensor *t = graph->input[index]->data;
     t->data = input->data;
+
+    /* a new input shape is applied lazily by the next run */
+    if (input != t && input->dim_count > 0) {
+        int same = input->dim_count == t->dim_count;
+        for (int i = 0; same && i < input->dim_count; i++) {
+            same = input->dim[i] == t->dim[i];
+        }
+        if (!same) {
+            struct shl_gref_target_data *td = sess->td;
+            if (td->plan_cache == NULL) {
+                plan_cache_init(sess);
+            }
+            t->dim_count = input->dim_count;
+            memcpy(t->dim, input->dim, MAX_DIM * sizeof(int32_t));
+            td->shape_changed = 1;
+        }
+    }
 }
 
 void shl_gref_update_output(int index, struct csinn_tensor *output, struct csinn_session *sess)
@@ -109,6 +128,9 @@ static int call_layer_func(void *fn, struct shl_node *node)
         case CSINN_OP_DEPTH_TO_SPACE:
         case CSINN_OP_ELU:
         case CSINN_OP_ERF:
+        case CSINN_OP_GELU:
+        case CSINN_OP_MISH:
+        case CSINN_OP_SILU:
         case CSINN_OP_EXP:
         case CSINN_OP_EXPAND_DIMS:
         case CSINN_OP_EXPM1:
@@ -259,6 +281,11 @@ static int call_layer_func(void *fn, struct shl_node *node)
             ret = func(node->in[0]->data, node->in[1]->data, node->in[2]->data, node->in[3]->data,
                        node->in[4]->data, node->out[0]->data, params);
             break;
+        case CSINN_OP_SCALED_DOT_PRODUCT_ATTENTION:
+            /* the mask is optional */
+            ret = func(node->in[0]->data, node->in[1]->data, node->in[2]->data,
+                       node->in_num > 3 ? node->in[3]->data : NULL, node->out[0]->data, params);
+            break;
         case CSINN_OP_CONCAT:
             inputs = shl_mem_alloc(sizeof(struct csinn_tensor *) *
                                    ((struct csinn_concat_params *)params)->inputs_count);
@@ -454,6 +481,142 @@ static struct shl_ref_graph *convert_graph(struct shl_ref_graph *ograph)
     return sorted_graph;
 }
 
+/*
+ * Zero-copy concat and split. A concat input that only feeds the concat is produced
+ * straight into its slice of the concat output, a split output is read from its slice of
+ * the split input, and a concat/split whose slices are all views no longer runs. Only
+ * slices that are one contiguous block qualify: every axis in front of the concat/split
+ * axis has size 1, which covers channel concat of a single NCHW batch.
+ */
+static int view_same_quant(struct csinn_tensor *a, struct csinn_tensor *b)
+{
+    if (a->dtype != b->dtype || a->dtype == CSINN_DTYPE_INT4 ||
+        a->quant_channel != b->quant_channel) {
+        return 0;
+    }
+    for (int i = 0; i < a->quant_channel; i++) {
+        if (a->qinfo[i].scale != b->qinfo[i].scale ||
+            a->qinfo[i].zero_point != b->qinfo[i].zero_point) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+static int view_is_graph_io(struct shl_ref_graph *g, struct shl_node *t)
+{
+    for (int i = 0; i < g->input_num; i++) {
+        if (g->input[i] == t) return 1;
+    }
+    for (int i = 0; i < g->output_num; i++) {
+        if (g->output[i] == t) return 1;
+    }
+    return 0;
+}
+
+/* t must come out of a top-level layer, not a constant, graph input or subgraph */
+static int view_has_producer(struct shl_ref_graph *g, struct shl_node *t)
+{
+    for (int i = 0; i < g->layer_index; i++) {
+        struct shl_node *n = g->layer[i];
+        if (n->type < 0 || n->type >= CSINN_OP_SIZE) continue;
+        for (int k = 0; k < n->out_num; k++) {
+            if (n->out[k] == t) return 1;
+        }
+    }
+    return 0;
+}
+
+static int view_contiguous(struct csinn_tensor *t, int axis)
+{
+    if (axis < 0) {
+        axis += t->dim_count;
+    }
+    for (int i = 0; i < axis; i++) {
+        if (t->dim[i] != 1) return 0;
+    }
+    return 1;
+}
+
+static void view_plan_split(struct shl_ref_graph *g, struct shl_node *n)
+{
+    struct csinn_split_params *params = n->data;
+    struct shl_node *in = n->in[0];
+    struct csinn_tensor *it = in->data;
+    /* the split is the only reader of its input */
+    if (!view_contiguous(it, params->axis) || in->ref_count_init != 2 ||
+        view_is_graph_io(g, in) || !view_has_producer(g, in)) {
+        return;
+    }
+    int64_t size = 0;
+    for (int i = 0; i < n->out_num; i++) {
+        struct csinn_tensor *ot = n->out[i]->data;
+        if (view_is_graph_io(g, n->out[i]) || !view_same_quant(it, ot)) return;
+        size += csinn_tensor_byte_size(ot);
+    }
+    if (size != csinn_tensor_byte_size(it)) return;
+
+    int64_t offset = 0;
+    for (int i = 0; i < n->out_num; i++) {
+        n->out[i]->view_of = in;
+        n->out[i]->view_offset = offset;
+        offset += csinn_tensor_byte_size(n->out[i]->data);
+    }
+    in->view_num += n->out_num;
+}
+
+static void view_plan_concat(struct shl_ref_graph *g, struct shl_node *n)
+{
+    struct csinn_concat_params *params = n->data;
+    struct shl_node *out = n->out[0];
+    struct csinn_tensor *ot = out->data;
+    if (!view_contiguous(ot, params->axis)) return;
+    int64_t size = 0;
+    for (int i = 0; i < n->in_num; i++) {
+        struct shl_node *in = n->in[i];
+        struct csinn_tensor *it = in->data;
+        /* produced by a layer and read by this concat only */
+        if (in->view_of != NULL || in->ref_count_init != 2 || view_is_graph_io(g, in) ||
+            !view_has_producer(g, in) || !view_same_quant(it, ot)) {
+            return;
+        }
+        size += csinn_tensor_byte_size(it);
+    }
+    if (size != csinn_tensor_byte_size(ot)) return;
+
+    int64_t offset = 0;
+    for (int i = 0; i < n->in_num; i++) {
+        n->in[i]->view_of = out;
+        n->in[i]->view_offset = offset;
+        offset += csinn_tensor_byte_size(n->in[i]->data);
+    }
+    out->view_num += n->in_num;
+}
+
+/* plan the views for the current shapes, splits first so their outputs stay out of concats */
+static void view_plan(struct shl_ref_graph *g)
+{
+    for (int i = 0; i < g->layer_index; i++) {
+        struct shl_node *n = g->layer[i];
+        if (n->type < 0 || n->type >= CSINN_OP_SIZE) continue;
+        for (int k = 0; k < n->out_num; k++) {
+            n->out[k]->view_of = NULL;
+            n->out[k]->view_offset = 0;
+            n->out[k]->view_num = 0;
+        }
+    }
+    for (int i = 0; i < g->layer_index; i++) {
+        if (g->layer[i]->type == CSINN_OP_SPLIT) {
+            view_plan_split(g, g->layer[i]);
+        }
+    }
+    for (int i = 0; i < g->layer_index; i++) {
+        if (g->layer[i]->type == CSINN_OP_CONCAT) {
+            view_plan_concat(g, g->layer[i]);
+        }
+    }
+}
+
 void shl_gref_session_setup(struct csinn_session *sess)
 {
     struct shl_ref_graph *graph = shl_gref_get_graph(sess);
@@ -488,6 +651,7 @@ void shl_gref_session_setup(struct csinn_session *sess)
             return;
         }
     }
+    view_plan(ggraph);
     struct shl_gref_target_data *td = sess->td;
     td->graph = ggraph;
 }
@@ -501,17 +665,55 @@ static void node_ref_reset(struct csinn_session *sess)
         n = graph->layer[i];
         for (int k = 0; k < n->out_num; k++) {
             if (n->out[k] != NULL) {
-                n->out[k]->ref_count = n->out[k]->ref_count_init;
+                /* every view holds one reference on the buffer it lives in */
+                n->out[k]->ref_count = n->out[k]->ref_count_init + n->out[k]->view_num;
+                if (n->out[k]->view_num > 0 || n->out[k]->view_of != NULL) {
+                    struct csinn_tensor *t = n->out[k]->data;
+                    t->data = NULL;
+                }
             }
         }
     }
 }
 
+/* a view points into its owner, the owner is allocated by whoever needs it first */
+static void *node_view_buffer(struct shl_node *node)
+{
+    struct csinn_tensor *t = node->data;
+    if (node->view_of != NULL) {
+        t->data = (int8_t *)node_view_buffer(node->view_of) + node->view_offset;
+    } else if (t->data == NULL) {
+        t->data = shl_mem_alloc(csinn_tensor_byte_size(t));
+    }
+    return t->data;
+}
+
+/* the last reference frees the buffer, or passes the release on to the owner of a view */
+static void node_release(struct shl_node *node)
+{
+    if (node->ref_count <= 0) {
+        return;
+    }
+    node->ref_count--;
+    if (node->ref_count == 0) {
+        if (node->view_of != NULL) {
+            node_release(node->view_of);
+        } else {
+            struct csinn_tensor *t = node->data;
+            shl_mem_free(t->data);
+        }
+    }
+}
+
 static int op_run_init(struct shl_node *node)
 {
     for (int i = 0; i < node->out_num; i++) {
         struct csinn_tensor *t = node->out[i]->data;
-        t->data = shl_mem_alloc(csinn_tensor_byte_size(t));
+        if (node->out[i]->view_of != NULL || node->out[i]->view_num > 0) {
+            node_view_buffer(node->out[i]);
+        } else {
+            t->data = shl_mem_alloc(csinn_tensor_byte_size(t));
+        }
     }
     return CSINN_TRUE;
 }
@@ -519,37 +721,351 @@ static int op_run_init(struct shl_node *node)
 static int op_run_deinit(struct shl_node *node)
 {
     for (int i = 0; i < node->in_num; i++) {
-        if (node->in[i]->ref_count > 0) {
-            node->in[i]->ref_count--;
-            if (node->in[i]->ref_count == 0) {
-                struct csinn_tensor *t = node->in[i]->data;
-                shl_mem_free(t->data);
-            }
-        }
+        node_release(node->in[i]);
     }
     for (int i = 0; i < node->out_num; i++) {
-        node->out[i]->ref_count--;
+        if (node->out[i]->view_of != NULL) {
+            node_release(node->out[i]);
+        } else {
+            node->out[i]->ref_count--;
+        }
     }
     return CSINN_TRUE;
 }
 
+/* concat/split whose slices are all views have nothing left to move */
+static int op_is_view(struct shl_node *node)
+{
+    if (node->type == CSINN_OP_CONCAT) {
+        for (int i = 0; i < node->in_num; i++) {
+            if (node->in[i]->view_of != node->out[0]) return 0;
+        }
+        return 1;
+    } else if (node->type == CSINN_OP_SPLIT) {
+        for (int i = 0; i < node->out_num; i++) {
+            if (node->out[i]->view_of != node->in[0]) return 0;
+        }
+        return 1;
+    }
+    return 0;
+}
+
 static int op_run(struct shl_node *node)
 {
     /* base has same address with params */
     struct csinn_params_base *params = node->data;
     int (*func)();
     struct csinn_callback *cb = params->cb;
+    if (op_is_view(node)) {
+        return CSINN_TRUE;
+    }
     func = cb->exec;
     return call_layer_func(func, node);
 }
 
+static int is_conv2d(int type)
+{
+    switch (type) {
+        case CSINN_OP_CONV2D:
+        case CSINN_OP_CONV2D_RELU:
+        case CSINN_OP_CONV2D_RELU6:
+        case CSINN_OP_CONV2D_CHANNEL:
+        case CSINN_OP_CONV2D_CHANNEL_RELU:
+        case CSINN_OP_CONV2D_CHANNEL_RELU6:
+        case CSINN_OP_DEPTHWISE_CONV2D:
+        case CSINN_OP_DEPTHWISE_CONV2D_RELU:
+        case CSINN_OP_DEPTHWISE_CONV2D_RELU6:
+        case CSINN_OP_DEPTHWISE_CONV2D_CHANNEL:
+        case CSINN_OP_DEPTHWISE_CONV2D_CHANNEL_RELU:
+        case CSINN_OP_DEPTHWISE_CONV2D_CHANNEL_RELU6:
+        case CSINN_OP_GROUP_CONV2D:
+        case CSINN_OP_GROUP_CONV2D_RELU:
+        case CSINN_OP_GROUP_CONV2D_RELU6:
+        case CSINN_OP_GROUP_CONV2D_CHANNEL:
+        case CSINN_OP_GROUP_CONV2D_CHANNEL_RELU:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/*
+ * Whether init can run again after setup. Most inits rewrite constant weights in
+ * place, which only leaves layers without constants and float winograd convolution,
+ * whose init is then rerun on a private copy of the setup kernel. The 8-bit lookup
+ * table only depends on the quantization, so those layers keep their setup plan.
+ */
+static int plan_can_reinit(struct shl_node *node, struct shl_gref_plan_cache *cache)
+{
+    struct csinn_tensor *input = node->in[0]->data;
+    if (is_conv2d(node->type)) {
+        struct csinn_conv2d_params *setup = &cache->plan[0].conv;
+        return setup->conv_extra.conv_mode == CSINN_WINOGRAD &&
+               (input->dtype == CSINN_DTYPE_FLOAT32 || input->dtype == CSINN_DTYPE_FLOAT16);
+    }
+    struct csinn_params_base *params = node->data;
+    if (params->lut != NULL) {
+        return 0;
+    }
+    for (int i = 0; i < node->in_num; i++) {
+        if (node->in[i] == NULL) continue;
+        struct csinn_tensor *t = node->in[i]->data;
+        if (t->is_const) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* plan key is the shape of every non-const input, -1 if it does not fit */
+static int plan_key(struct shl_node *node, int32_t *key)
+{
+    int len = 0;
+    for (int i = 0; i < node->in_num; i++) {
+        if (node->in[i] == NULL) continue;
+        struct csinn_tensor *t = node->in[i]->data;
+        if (t->is_const) continue;
+        if (len + t->dim_count + 1 > SHL_GREF_PLAN_KEY_SIZE) {
+            return -1;
+        }
+        key[len++] = t->dim_count;
+        for (int j = 0; j < t->dim_count; j++) {
+            key[len++] = t->dim[j];
+        }
+    }
+    return len;
+}
+
+static void plan_save(struct shl_gref_plan *plan, struct shl_node *node, int owner)
+{
+    struct csinn_params_base *params = node->data;
+    plan->key_len = plan_key(node, plan->key);
+    memcpy(&plan->cb, params->cb, sizeof(struct csinn_callback));
+    plan->owner = owner;
+    if (is_conv2d(node->type)) {
+        plan->conv = *(struct csinn_conv2d_params *)node->data;
+        plan->kernel = *(struct csinn_tensor *)node->in[1]->data;
+    }
+}
+
+static void plan_load(struct shl_gref_plan *plan, struct shl_node *node)
+{
+    struct csinn_params_base *params = node->data;
+    memcpy(params->cb, &plan->cb, sizeof(struct csinn_callback));
+    if (is_conv2d(node->type)) {
+        *(struct csinn_conv2d_params *)node->data = plan->conv;
+        *(struct csinn_tensor *)node->in[1]->data = plan->kernel;
+    }
+}
+
+/* release what a reinit allocated for the plan, never the setup kernel or its kernel_tm */
+static void plan_free_kernel(struct shl_gref_plan *plan)
+{
+    if (!plan->owner) {
+        return;
+    }
+    struct csinn_tensor *kernel_tm = plan->conv.conv_extra.kernel_tm;
+    if (kernel_tm != NULL) {
+        shl_mem_free(kernel_tm->data);
+        csinn_free_tensor(kernel_tm);
+        plan->conv.conv_extra.kernel_tm = NULL;
+    }
+    shl_mem_free(plan->kernel.data);
+    plan->kernel.data = NULL;
+    plan->owner = 0;
+}
+
+/* snapshot the plans chosen by setup, before the first shape change */
+static void plan_cache_init(struct csinn_session *sess)
+{
+    struct shl_gref_target_data *td = sess->td;
+    struct shl_ref_graph *g = td->graph;
+    td->plan_cache = shl_mem_alloc(g->layer_index * sizeof(struct shl_gref_plan_cache));
+    for (int i = 0; i < g->layer_index; i++) {
+        struct shl_node *n = g->layer[i];
+        struct shl_gref_plan_cache *cache = &td->plan_cache[i];
+        if (n->type < 0 || n->type >= CSINN_OP_SIZE) continue;
+        cache->setup_input = *(struct csinn_tensor *)n->in[0]->data;
+        cache->setup_output = *(struct csinn_tensor *)n->out[0]->data;
+        cache->plan = shl_mem_alloc(SHL_GREF_PLAN_CACHE_SIZE * sizeof(struct shl_gref_plan));
+        plan_save(&cache->plan[0], n, 0);
+        cache->plan_num = 1;
+        cache->evict = 1;
+    }
+}
+
+/* put every layer back on its setup plan, which the node owns, and release the others */
+static void plan_cache_free(struct csinn_session *sess)
+{
+    struct shl_gref_target_data *td = sess->td;
+    struct shl_ref_graph *g = td->graph;
+    if (td->plan_cache == NULL) {
+        return;
+    }
+    for (int i = 0; i < g->layer_index; i++) {
+        struct shl_gref_plan_cache *cache = &td->plan_cache[i];
+        if (cache->plan == NULL) continue;
+        plan_load(&cache->plan[0], g->layer[i]);
+        for (int j = 1; j < cache->plan_num; j++) {
+            plan_free_kernel(&cache->plan[j]);
+        }
+        shl_mem_free(cache->plan);
+    }
+    shl_mem_free(td->plan_cache);
+    td->plan_cache = NULL;
+}
+
+/*
+ * Rerun the init of a float winograd convolution for the current shape. It starts from
+ * the setup params and a copy of the setup kernel, so an init that reorders the kernel
+ * in place, e.g. a tuned im2col pick, leaves the setup kernel and the other plans intact.
+ */
+static int plan_reinit_conv2d(struct shl_node *node, struct shl_gref_plan_cache *cache)
+{
+    struct csinn_conv2d_params *params = node->data;
+    struct csinn_tensor *kernel = node->in[1]->data;
+    struct shl_gref_plan *setup = &cache->plan[0];
+    int size = csinn_tensor_byte_size(&setup->kernel);
+
+    *params = setup->conv;
+    params->conv_extra.kernel_tm = NULL;
+    *kernel = setup->kernel;
+    kernel->data = shl_mem_alloc(size);
+    memcpy(kernel->data, setup->kernel.data, size);
+    if (init_op(node) != CSINN_TRUE) {
+        shl_mem_free(kernel->data);
+        plan_load(setup, node);
+        return CSINN_FALSE;
+    }
+    return CSINN_TRUE;
+}
+
+/* switch node to the plan of its current input shapes, selecting one if unseen */
+static int plan_select(struct shl_node *node, struct shl_gref_plan_cache *cache)
+{
+    int32_t key[SHL_GREF_PLAN_KEY_SIZE];
+    int len = plan_key(node, key);
+    for (int i = 0; len >= 0 && i < cache->plan_num; i++) {
+        struct shl_gref_plan *plan = &cache->plan[i];
+        if (plan->key_len == len && memcmp(plan->key, key, len * sizeof(int32_t)) == 0) {
+            plan_load(plan, node);
+            return CSINN_TRUE;
+        }
+    }
+
+    int owner = 0;
+    if (plan_can_reinit(node, cache)) {
+        if (is_conv2d(node->type)) {
+            if (len < 0) {
+                /* an uncached plan could not be released, stay on the setup one */
+                plan_load(&cache->plan[0], node);
+                return CSINN_TRUE;
+            }
+            if (plan_reinit_conv2d(node, cache) != CSINN_TRUE) {
+                return CSINN_FALSE;
+            }
+            owner = 1;
+        } else if (init_op(node) != CSINN_TRUE) {
+            return CSINN_FALSE;
+        }
+    }
+
+    if (len < 0) {
+        return CSINN_TRUE;
+    }
+    struct shl_gref_plan *plan;
+    if (cache->plan_num < SHL_GREF_PLAN_CACHE_SIZE) {
+        plan = &cache->plan[cache->plan_num++];
+    } else {
+        /* entry 0 keeps the setup plan, the evicted one is not in use */
+        plan = &cache->plan[cache->evict];
+        cache->evict = cache->evict + 1 < SHL_GREF_PLAN_CACHE_SIZE ? cache->evict + 1 : 1;
+        plan_free_kernel(plan);
+    }
+    plan_save(plan, node, owner);
+    return CSINN_TRUE;
+}
+
+/*
+ * Propagate new input shapes through the graph. Only layers whose input shapes
+ * changed get their output shapes inferred and their kernels re-selected.
+ */
+static int gref_reshape(struct csinn_session *sess)
+{
+    struct shl_gref_target_data *td = sess->td;
+    struct shl_ref_graph *g = td->graph;
+    int changed_size = g->input_num;
+    for (int i = 0; i < g->layer_index; i++) {
+        changed_size += g->layer[i]->out_num;
+    }
+    struct shl_node **changed = shl_mem_alloc(changed_size * sizeof(struct shl_node *));
+    int changed_num = 0;
+    int ret = CSINN_TRUE;
+
+    for (int i = 0; i < g->input_num; i++) {
+        changed[changed_num++] = g->input[i];
+    }
+
+    for (int i = 0; i < g->layer_index && ret == CSINN_TRUE; i++) {
+        struct shl_node *n = g->layer[i];
+        int in_changed = 0;
+        for (int j = 0; j < n->in_num; j++) {
+            if (shl_node_find(changed, changed_num, n->in[j]) > -1) {
+                in_changed = 1;
+                break;
+            }
+        }
+        if (!in_changed) continue;
+
+        if (n->type == CSINN_SUBGRAPH) {
+            shl_debug_error("%s: subgraph does not support dynamic input shape\n", __func__);
+            ret = CSINN_FALSE;
+            break;
+        }
+
+        struct shl_gref_plan_cache *cache = &td->plan_cache[i];
+        int32_t old_dim_count[n->out_num];
+        int32_t old_dim[n->out_num][MAX_DIM];
+        for (int k = 0; k < n->out_num; k++) {
+            struct csinn_tensor *t = n->out[k]->data;
+            old_dim_count[k] = t->dim_count;
+            memcpy(old_dim[k], t->dim, MAX_DIM * sizeof(int32_t));
+        }
+
+        ret = shl_gref_infer_shape(n, &cache->setup_input, &cache->setup_output);
+        if (ret != CSINN_TRUE) break;
+
+        for (int k = 0; k < n->out_num; k++) {
+            struct csinn_tensor *t = n->out[k]->data;
+            if (t->dim_count != old_dim_count[k] ||
+                memcmp(t->dim, old_dim[k], t->dim_count * sizeof(int32_t)) != 0) {
+                changed[changed_num++] = n->out[k];
+            }
+        }
+        ret = plan_select(n, cache);
+    }
+
+    shl_mem_free(changed);
+    td->shape_changed = 0;
+    view_plan(g);
+    return ret;
+}
+
 int shl_gref_session_run(struct csinn_session *sess)
 {
+    struct shl_gref_target_data *td = sess->td;
+    if (td->shape_changed) {
+        if (gref_reshape(sess) != CSINN_TRUE) {
+            return CSINN_FALSE;
+        }
+    }
     struct shl_ref_graph *g = shl_gref_get_graph(sess);
     uint64_t time_acc = 0;
+    bool profile = sess->profiler_level == CSI_PROFILER_LEVEL_LAYER;
     node_ref_reset(sess);
     for (int i = 0; i < g->layer_index; i++) {
         struct shl_node *n = g->layer[i];
+        uint64_t layer_start = profile ? shl_get_timespec() : 0;
         if (n->type == CSINN_SUBGRAPH) {
             shl_subgraph_run_init(n);
             shl_subgraph_run(n);
@@ -569,6 +1085,11 @@ int shl_gref_session_run(struct csinn_session *sess)
         } else {
             return CSINN_FALSE;
         }
+        /* buffer setup and release of the layer are part of its cost */
+        if (profile) {
+            n->run_time += shl_get_timespec() - layer_start;
+            n->run_count++;
+        }
     }
 #ifdef SHL_LAYER_BENCHMARK
     shl_debug_info("[layer-benchmark]: network exec time = %f\n", time_acc / 1000000.0f);
@@ -610,6 +1131,7 @@ void shl_gref_session_deinit(struct csinn_session *sess)
             shl_subgraph_deinit(n);
         }
     }
+    plan_cache_free(sess);
     struct shl_ref_graph *graph = shl_gref_get_graph(sess);
     shl_mem_free(graph->input);
     shl_mem_free(graph->output);
@@ -842,6 +1364,9 @@ static void *setup_cb_map()
     cb_map[CSINN_OP_ELU].est = shl_gref_elu;
     cb_map[CSINN_OP_EQUANL].est = shl_gref_equal;
     cb_map[CSINN_OP_ERF].est = shl_gref_erf;
+    cb_map[CSINN_OP_GELU].est = shl_gref_gelu;
+    cb_map[CSINN_OP_MISH].est = shl_gref_mish;
+    cb_map[CSINN_OP_SILU].est = shl_gref_silu;
     cb_map[CSINN_OP_EXP].est = shl_gref_exp;
     cb_map[CSINN_OP_EXPAND_DIMS].est = shl_gref_expand_dims;
     cb_map[CSINN_OP_EXPM1].est = shl_gref_expm1;
@@ -915,6 +1440,7 @@ static void *setup_cb_map()
     cb_map[CSINN_OP_ROIPOOL].est = shl_gref_roipool;
     cb_map[CSINN_OP_ROUND].est = shl_gref_round;
     cb_map[CSINN_OP_RSQRT].est = shl_gref_rsqrt;
+    cb_map[CSINN_OP_SCALED_DOT_PRODUCT_ATTENTION].est = shl_gref_scaled_dot_product_attention;
     cb_map[CSINN_OP_SCATTER_ND].est = shl_gref_scatter_nd;
     cb_map[CSINN_OP_SEGMENT_MAX].est = shl_gref_segment_max;
     cb_map[CSINN_OP_SEGMENT_MEAN].est = shl_gref_segment_mean;
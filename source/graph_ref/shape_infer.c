@@ -0,0 +1,496 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_gref.h"
+
+/*
+ * Output shape inference used when csinn_update_input brings a new input shape.
+ * Only the dimensions a new input shape can move are recomputed; channel counts
+ * tied to constant weights are kept from setup.
+ */
+
+static void copy_shape(struct csinn_tensor *dst, struct csinn_tensor *src)
+{
+    dst->dim_count = src->dim_count;
+    for (int i = 0; i < src->dim_count; i++) {
+        dst->dim[i] = src->dim[i];
+    }
+}
+
+static void get_hw_index(int32_t layout, int *h, int *w)
+{
+    if (layout == CSINN_LAYOUT_NHWC) {
+        *h = 1;
+        *w = 2;
+    } else {
+        *h = 2;
+        *w = 3;
+    }
+}
+
+static int infer_broadcast(struct csinn_tensor *in0, struct csinn_tensor *in1,
+                           struct csinn_tensor *out)
+{
+    int dim_count = in0->dim_count > in1->dim_count ? in0->dim_count : in1->dim_count;
+    for (int i = 0; i < dim_count; i++) {
+        int i0 = in0->dim_count - dim_count + i;
+        int i1 = in1->dim_count - dim_count + i;
+        int32_t d0 = i0 >= 0 ? in0->dim[i0] : 1;
+        int32_t d1 = i1 >= 0 ? in1->dim[i1] : 1;
+        if (d0 != d1 && d0 != 1 && d1 != 1) {
+            shl_debug_error("%s: cannot broadcast %d with %d\n", __func__, d0, d1);
+            return CSINN_FALSE;
+        }
+        out->dim[i] = d0 > d1 ? d0 : d1;
+    }
+    out->dim_count = dim_count;
+    return CSINN_TRUE;
+}
+
+static int infer_conv2d(struct csinn_tensor *input, struct csinn_tensor *output,
+                        struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    int h, w;
+    get_hw_index(params->base.layout, &h, &w);
+    int32_t kernel_h = kernel->dim[h];
+    int32_t kernel_w = kernel->dim[w];
+
+    output->dim[0] = input->dim[0];
+    output->dim[h] = (input->dim[h] + params->pad_top + params->pad_down -
+                      params->dilation_height * (kernel_h - 1) - 1) /
+                         params->stride_height +
+                     1;
+    output->dim[w] = (input->dim[w] + params->pad_left + params->pad_right -
+                      params->dilation_width * (kernel_w - 1) - 1) /
+                         params->stride_width +
+                     1;
+    return CSINN_TRUE;
+}
+
+static int infer_deconv2d(struct csinn_tensor *input, struct csinn_tensor *output,
+                          struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    int h, w;
+    get_hw_index(params->base.layout, &h, &w);
+    int32_t kernel_h = kernel->dim[h];
+    int32_t kernel_w = kernel->dim[w];
+
+    output->dim[0] = input->dim[0];
+    output->dim[h] = (input->dim[h] - 1) * params->stride_height - params->pad_top -
+                     params->pad_down + params->dilation_height * (kernel_h - 1) + 1 +
+                     params->out_pad_height;
+    output->dim[w] = (input->dim[w] - 1) * params->stride_width - params->pad_left -
+                     params->pad_right + params->dilation_width * (kernel_w - 1) + 1 +
+                     params->out_pad_width;
+    return CSINN_TRUE;
+}
+
+static int infer_pool2d(struct csinn_tensor *input, struct csinn_tensor *output,
+                        struct csinn_pool_params *params)
+{
+    int h, w;
+    get_hw_index(params->base.layout, &h, &w);
+    int32_t ceil_h = params->ceil_mode ? params->stride_height - 1 : 0;
+    int32_t ceil_w = params->ceil_mode ? params->stride_width - 1 : 0;
+
+    output->dim[0] = input->dim[0];
+    output->dim[h] = (input->dim[h] + params->pad_top + params->pad_down -
+                      params->filter_height + ceil_h) /
+                         params->stride_height +
+                     1;
+    output->dim[w] = (input->dim[w] + params->pad_left + params->pad_right -
+                      params->filter_width + ceil_w) /
+                         params->stride_width +
+                     1;
+    return CSINN_TRUE;
+}
+
+static int infer_global_pool2d(struct csinn_tensor *input, struct csinn_tensor *output)
+{
+    /* spatial dims stay 1x1 */
+    output->dim[0] = input->dim[0];
+    return CSINN_TRUE;
+}
+
+static int infer_fullyconnected(struct csinn_tensor *input, struct csinn_tensor *output,
+                                struct csinn_tensor *weight)
+{
+    int32_t size = csinn_tensor_size(input);
+    if (size % weight->dim[1] != 0) {
+        shl_debug_error("%s: input size %d mismatch weight\n", __func__, size);
+        return CSINN_FALSE;
+    }
+    output->dim_count = 2;
+    output->dim[0] = size / weight->dim[1];
+    output->dim[1] = weight->dim[0];
+    return CSINN_TRUE;
+}
+
+static int infer_matmul(struct csinn_tensor *mat0, struct csinn_tensor *mat1,
+                        struct csinn_tensor *output, struct csinn_matmul_params *params)
+{
+    int dims0 = mat0->dim_count;
+    int dims1 = mat1->dim_count;
+    struct csinn_tensor *batch = dims0 >= dims1 ? mat0 : mat1;
+    copy_shape(output, batch);
+    int dims = output->dim_count;
+    output->dim[dims - 2] = params->trans_a ? mat0->dim[dims0 - 1] : mat0->dim[dims0 - 2];
+    output->dim[dims - 1] = params->trans_b ? mat1->dim[dims1 - 2] : mat1->dim[dims1 - 1];
+    return CSINN_TRUE;
+}
+
+/* the query shape with the head dim of the value */
+static int infer_attention(struct csinn_tensor *query, struct csinn_tensor *value,
+                           struct csinn_tensor *output)
+{
+    copy_shape(output, query);
+    output->dim[output->dim_count - 1] = value->dim[value->dim_count - 1];
+    return CSINN_TRUE;
+}
+
+static int infer_concat(struct shl_node *node, struct csinn_concat_params *params)
+{
+    struct csinn_tensor *output = node->out[0]->data;
+    struct csinn_tensor *input = node->in[0]->data;
+    int axis = params->axis < 0 ? params->axis + input->dim_count : params->axis;
+    copy_shape(output, input);
+    output->dim[axis] = 0;
+    for (int i = 0; i < params->inputs_count; i++) {
+        struct csinn_tensor *t = node->in[i]->data;
+        output->dim[axis] += t->dim[axis];
+    }
+    return CSINN_TRUE;
+}
+
+static int infer_split(struct shl_node *node, struct csinn_split_params *params)
+{
+    struct csinn_tensor *input = node->in[0]->data;
+    int axis = params->axis < 0 ? params->axis + input->dim_count : params->axis;
+    for (int i = 0; i < params->output_num; i++) {
+        struct csinn_tensor *output = node->out[i]->data;
+        copy_shape(output, input);
+        if (params->split_index == NULL) {
+            output->dim[axis] = input->dim[axis] / params->output_num;
+            continue;
+        }
+        /* split_index holds the output_num - 1 cut points, the last part takes the rest */
+        int32_t begin = i == 0 ? 0 : params->split_index[i - 1];
+        int32_t end = i == params->output_num - 1 ? input->dim[axis] : params->split_index[i];
+        if (end < begin) {
+            shl_debug_error("%s: split_index %d is out of the new input dim %d\n", __func__,
+                            begin, input->dim[axis]);
+            return CSINN_FALSE;
+        }
+        output->dim[axis] = end - begin;
+    }
+    return CSINN_TRUE;
+}
+
+static int infer_reshape(struct csinn_tensor *input, struct csinn_tensor *output,
+                         struct csinn_reshape_params *params)
+{
+    int32_t size = csinn_tensor_size(input);
+    int32_t known = 1;
+    int unknown = -1;
+    for (int i = 0; i < params->shape_num; i++) {
+        if (params->shape[i] == -1) {
+            unknown = i;
+        } else {
+            known *= params->shape[i];
+        }
+    }
+    output->dim_count = params->shape_num;
+    for (int i = 0; i < params->shape_num; i++) {
+        output->dim[i] = params->shape[i];
+    }
+    if (unknown >= 0) {
+        output->dim[unknown] = size / known;
+    } else if (known != size) {
+        shl_debug_error("%s: static reshape cannot follow input size %d\n", __func__, size);
+        return CSINN_FALSE;
+    }
+    return CSINN_TRUE;
+}
+
+static int infer_transpose(struct csinn_tensor *input, struct csinn_tensor *output,
+                           struct csinn_transpose_params *params)
+{
+    output->dim_count = params->permute_num;
+    for (int i = 0; i < params->permute_num; i++) {
+        output->dim[i] = input->dim[params->permute[i]];
+    }
+    return CSINN_TRUE;
+}
+
+static int infer_flatten(struct csinn_tensor *input, struct csinn_tensor *output)
+{
+    output->dim_count = 2;
+    output->dim[0] = input->dim[0];
+    output->dim[1] = csinn_tensor_size(input) / input->dim[0];
+    return CSINN_TRUE;
+}
+
+static int infer_resize(struct csinn_tensor *input, struct csinn_tensor *output,
+                        struct csinn_tensor *setup_input, struct csinn_tensor *setup_output,
+                        struct csinn_resize_params *params)
+{
+    int h, w;
+    get_hw_index(params->base.layout, &h, &w);
+    /* integer upsample keeps its scale, otherwise the output size is fixed */
+    if (setup_output->dim[h] % setup_input->dim[h] == 0 &&
+        setup_output->dim[w] % setup_input->dim[w] == 0) {
+        output->dim[h] = input->dim[h] * (setup_output->dim[h] / setup_input->dim[h]);
+        output->dim[w] = input->dim[w] * (setup_output->dim[w] / setup_input->dim[w]);
+    }
+    output->dim[0] = input->dim[0];
+    return CSINN_TRUE;
+}
+
+static int infer_pad(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_pad_params *params)
+{
+    copy_shape(output, input);
+    for (int i = 0; i < params->pad_num && i < input->dim_count; i++) {
+        output->dim[i] += params->pad_before[i] + params->pad_after[i];
+    }
+    return CSINN_TRUE;
+}
+
+static int infer_squeeze(struct csinn_tensor *input, struct csinn_tensor *output,
+                         struct csinn_squeeze_params *params)
+{
+    int j = 0;
+    for (int i = 0; i < input->dim_count; i++) {
+        int squeezed = 0;
+        for (int k = 0; k < params->axis_num; k++) {
+            int axis = params->axis[k] < 0 ? params->axis[k] + input->dim_count : params->axis[k];
+            if (axis == i) {
+                squeezed = 1;
+            }
+        }
+        if (!squeezed) {
+            output->dim[j++] = input->dim[i];
+        }
+    }
+    output->dim_count = j;
+    return CSINN_TRUE;
+}
+
+static int infer_expand_dims(struct csinn_tensor *input, struct csinn_tensor *output,
+                             struct csinn_expand_dims_params *params)
+{
+    int axis = params->axis < 0 ? params->axis + input->dim_count + 1 : params->axis;
+    int j = 0;
+    for (int i = 0; i < input->dim_count + 1; i++) {
+        output->dim[i] = i == axis ? 1 : input->dim[j++];
+    }
+    output->dim_count = input->dim_count + 1;
+    return CSINN_TRUE;
+}
+
+static int infer_depth_to_space(struct csinn_tensor *input, struct csinn_tensor *output,
+                                int32_t block_size)
+{
+    int h, w;
+    get_hw_index(input->layout, &h, &w);
+    int c = input->layout == CSINN_LAYOUT_NHWC ? 3 : 1;
+    copy_shape(output, input);
+    output->dim[c] = input->dim[c] / (block_size * block_size);
+    output->dim[h] = input->dim[h] * block_size;
+    output->dim[w] = input->dim[w] * block_size;
+    return CSINN_TRUE;
+}
+
+static int infer_space_to_depth(struct csinn_tensor *input, struct csinn_tensor *output,
+                                int32_t block_size)
+{
+    int h, w;
+    get_hw_index(input->layout, &h, &w);
+    int c = input->layout == CSINN_LAYOUT_NHWC ? 3 : 1;
+    copy_shape(output, input);
+    output->dim[c] = input->dim[c] * block_size * block_size;
+    output->dim[h] = input->dim[h] / block_size;
+    output->dim[w] = input->dim[w] / block_size;
+    return CSINN_TRUE;
+}
+
+/*
+ * Recompute the output shapes of node from the current shapes of its inputs.
+ * setup_input/setup_output hold the shapes seen at session setup, needed by ops
+ * whose output size is relative to the original input.
+ */
+int shl_gref_infer_shape(struct shl_node *node, struct csinn_tensor *setup_input,
+                         struct csinn_tensor *setup_output)
+{
+    struct csinn_params_base *params = node->data;
+    struct csinn_tensor *input = node->in[0]->data;
+    struct csinn_tensor *output = node->out[0]->data;
+
+    switch (node->type) {
+        case CSINN_OP_ABS:
+        case CSINN_OP_ACOS:
+        case CSINN_OP_ACOSH:
+        case CSINN_OP_ASIN:
+        case CSINN_OP_ASINH:
+        case CSINN_OP_ATAN:
+        case CSINN_OP_ATANH:
+        case CSINN_OP_BN:
+        case CSINN_OP_CEIL:
+        case CSINN_OP_CLIP:
+        case CSINN_OP_COS:
+        case CSINN_OP_COSH:
+        case CSINN_OP_CUMPROD:
+        case CSINN_OP_CUMSUM:
+        case CSINN_OP_DATA_CONVERT:
+        case CSINN_OP_ELU:
+        case CSINN_OP_ERF:
+        case CSINN_OP_GELU:
+        case CSINN_OP_MISH:
+        case CSINN_OP_SILU:
+        case CSINN_OP_EXP:
+        case CSINN_OP_EXPM1:
+        case CSINN_OP_FLOOR:
+        case CSINN_OP_HARD_SIGMOID:
+        case CSINN_OP_ISNAN:
+        case CSINN_OP_L2N:
+        case CSINN_OP_LAYER_NORM:
+        case CSINN_OP_LEAKY_RELU:
+        case CSINN_OP_LOG_SOFTMAX:
+        case CSINN_OP_LOG:
+        case CSINN_OP_LOG1P:
+        case CSINN_OP_LOGICAL_NOT:
+        case CSINN_OP_LRN:
+        case CSINN_OP_NEGATIIVE:
+        case CSINN_OP_NOT:
+        case CSINN_OP_PRELU:
+        case CSINN_OP_RELU:
+        case CSINN_OP_RELU1:
+        case CSINN_OP_RELU6:
+        case CSINN_OP_RELUN:
+        case CSINN_OP_ROUND:
+        case CSINN_OP_RSQRT:
+        case CSINN_OP_SHUFFLE_CHANNEL:
+        case CSINN_OP_SIGMOID:
+        case CSINN_OP_SIGN:
+        case CSINN_OP_SIN:
+        case CSINN_OP_SINH:
+        case CSINN_OP_SOFTMAX:
+        case CSINN_OP_SOFTPLUS:
+        case CSINN_OP_SOFTRELU:
+        case CSINN_OP_SOFTSIGN:
+        case CSINN_OP_SQRT:
+        case CSINN_OP_SQUARE:
+        case CSINN_OP_TAN:
+        case CSINN_OP_TANH:
+        case CSINN_OP_THRESHOLD_RELU:
+        case CSINN_OP_TRUNC:
+            copy_shape(output, input);
+            return CSINN_TRUE;
+        case CSINN_OP_ADD:
+        case CSINN_OP_AND:
+        case CSINN_OP_DIV:
+        case CSINN_OP_EQUANL:
+        case CSINN_OP_FLOOR_DIVIDE:
+        case CSINN_OP_FLOOR_MOD:
+        case CSINN_OP_GREATHER_EQUAL:
+        case CSINN_OP_GREATHER:
+        case CSINN_OP_LESS_EQUAL:
+        case CSINN_OP_LESS:
+        case CSINN_OP_LOGICAL_AND:
+        case CSINN_OP_LOGICAL_OR:
+        case CSINN_OP_LOGICAL_XOR:
+        case CSINN_OP_MAXIMUM:
+        case CSINN_OP_MINIMUM:
+        case CSINN_OP_MOD:
+        case CSINN_OP_MUL:
+        case CSINN_OP_NOT_EQUAL:
+        case CSINN_OP_OR:
+        case CSINN_OP_POWER:
+        case CSINN_OP_SUB:
+        case CSINN_OP_XOR:
+            return infer_broadcast(input, node->in[1]->data, output);
+        case CSINN_OP_CONV2D:
+        case CSINN_OP_CONV2D_RELU:
+        case CSINN_OP_CONV2D_RELU6:
+        case CSINN_OP_CONV2D_CHANNEL:
+        case CSINN_OP_CONV2D_CHANNEL_RELU:
+        case CSINN_OP_CONV2D_CHANNEL_RELU6:
+        case CSINN_OP_DEPTHWISE_CONV2D:
+        case CSINN_OP_DEPTHWISE_CONV2D_RELU:
+        case CSINN_OP_DEPTHWISE_CONV2D_RELU6:
+        case CSINN_OP_DEPTHWISE_CONV2D_CHANNEL:
+        case CSINN_OP_DEPTHWISE_CONV2D_CHANNEL_RELU:
+        case CSINN_OP_DEPTHWISE_CONV2D_CHANNEL_RELU6:
+        case CSINN_OP_GROUP_CONV2D:
+        case CSINN_OP_GROUP_CONV2D_RELU:
+        case CSINN_OP_GROUP_CONV2D_RELU6:
+        case CSINN_OP_GROUP_CONV2D_CHANNEL:
+        case CSINN_OP_GROUP_CONV2D_CHANNEL_RELU:
+            return infer_conv2d(input, output, node->in[1]->data,
+                                (struct csinn_conv2d_params *)params);
+        case CSINN_OP_DECONV2D:
+        case CSINN_OP_DEPTHWISE_DECONV2D:
+            return infer_deconv2d(input, output, node->in[1]->data,
+                                  (struct csinn_conv2d_params *)params);
+        case CSINN_OP_AVGPOOL2D:
+        case CSINN_OP_L2POOL2D:
+        case CSINN_OP_MAXPOOL2D:
+            return infer_pool2d(input, output, (struct csinn_pool_params *)params);
+        case CSINN_OP_GLOBAL_AVGPOOL2D:
+        case CSINN_OP_GLOBAL_MAXPOOL2D:
+            return infer_global_pool2d(input, output);
+        case CSINN_OP_FULLYCONNECTED:
+            return infer_fullyconnected(input, output, node->in[1]->data);
+        case CSINN_OP_MATMUL:
+            return infer_matmul(input, node->in[1]->data, output,
+                                (struct csinn_matmul_params *)params);
+        case CSINN_OP_SCALED_DOT_PRODUCT_ATTENTION:
+            return infer_attention(input, node->in[2]->data, output);
+        case CSINN_OP_CONCAT:
+            return infer_concat(node, (struct csinn_concat_params *)params);
+        case CSINN_OP_SPLIT:
+            return infer_split(node, (struct csinn_split_params *)params);
+        case CSINN_OP_RESHAPE:
+            return infer_reshape(input, output, (struct csinn_reshape_params *)params);
+        case CSINN_OP_TRANSPOSE:
+            return infer_transpose(input, output, (struct csinn_transpose_params *)params);
+        case CSINN_OP_FLATTEN:
+            return infer_flatten(input, output);
+        case CSINN_OP_RESIZE:
+            return infer_resize(input, output, setup_input, setup_output,
+                                (struct csinn_resize_params *)params);
+        case CSINN_OP_PAD:
+            return infer_pad(input, output, (struct csinn_pad_params *)params);
+        case CSINN_OP_SQUEEZE:
+            return infer_squeeze(input, output, (struct csinn_squeeze_params *)params);
+        case CSINN_OP_EXPAND_DIMS:
+            return infer_expand_dims(input, output, (struct csinn_expand_dims_params *)params);
+        case CSINN_OP_DEPTH_TO_SPACE:
+            return infer_depth_to_space(
+                input, output, ((struct csinn_depth_to_space_params *)params)->block_size);
+        case CSINN_OP_SPACE_TO_DEPTH:
+            return infer_space_to_depth(
+                input, output, ((struct csinn_space_to_depth_params *)params)->block_size);
+        default:
+            shl_debug_error("%s: %s cannot infer shape, set up the session again\n", __func__,
+                            node->name);
+            return CSINN_FALSE;
+    }
+}
@@ -179,6 +179,9 @@ int shl_subgraph_setup(struct shl_node *n)
             case CSINN_OP_DEPTH_TO_SPACE:
             case CSINN_OP_ELU:
             case CSINN_OP_ERF:
+            case CSINN_OP_GELU:
+            case CSINN_OP_MISH:
+            case CSINN_OP_SILU:
             case CSINN_OP_EXP:
             case CSINN_OP_EXPAND_DIMS:
             case CSINN_OP_EXPM1:
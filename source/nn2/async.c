@@ -0,0 +1,421 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#if (!defined SHL_BUILD_RTOS)
+#include <pthread.h>
+#endif
+
+#include "csi_nn.h"
+#include "shl_utils.h"
+
+/*
+ * Asynchronous session run.
+ *
+ * The session owns a ring of slots. csinn_update_input/csinn_update_output bind data
+ * into the fill slot, csinn_session_run_async queues the fill slot and moves on to the
+ * next one, so the caller can prepare frame N+1 while frame N is in flight. A single
+ * worker thread per session executes the queued slots in order through the normal
+ * runtime callbacks, which keeps it valid for CPU graph and heterogeneous subgraph
+ * sessions alike.
+ *
+ * An output bound with csinn_update_output is written in place. Any other output is
+ * copied out of the session into storage owned by the slot, so a later run cannot
+ * overwrite it before the caller has read it.
+ */
+
+#define SHL_ASYNC_DEFAULT_SLOT_NUM 2
+
+enum shl_async_slot_state {
+    SHL_ASYNC_SLOT_IDLE = 0,
+    SHL_ASYNC_SLOT_QUEUED,
+    SHL_ASYNC_SLOT_RUNNING,
+    SHL_ASYNC_SLOT_CALLBACK,  // outputs are ready, the user callback is running
+    SHL_ASYNC_SLOT_DONE,
+};
+
+struct shl_async_slot {
+    int state;
+    int status;
+    struct csinn_tensor **input;
+    void *input_image;  // buffers of csinn_update_input_image, one set per slot
+    void **output_data;
+    struct csinn_tensor **output;
+    void **output_buf;  // slot-owned copies of the outputs not bound by the caller
+    int *output_buf_size;
+    void (*callback)(struct csinn_session *, int, int, void *);
+    void *user_data;
+};
+
+struct shl_async_context {
+    int slot_num;
+    struct shl_async_slot *slot;
+    int fill_idx;
+    int run_idx;
+    int pending;
+    int last_status;
+#if (!defined SHL_BUILD_RTOS)
+    int stop;
+    int worker_started;
+    pthread_t worker;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+#endif
+};
+
+static struct shl_async_context *async_alloc(int slot_num, struct csinn_session *sess)
+{
+    struct shl_async_context *ctx = shl_mem_alloc(sizeof(struct shl_async_context));
+    ctx->slot_num = slot_num;
+    ctx->last_status = CSINN_TRUE;
+    ctx->slot = shl_mem_alloc(slot_num * sizeof(struct shl_async_slot));
+    for (int i = 0; i < slot_num; i++) {
+        struct shl_async_slot *slot = &ctx->slot[i];
+        slot->input = shl_mem_alloc(sess->input_num * sizeof(struct csinn_tensor *));
+        for (int j = 0; j < sess->input_num; j++) {
+            slot->input[j] = csinn_alloc_tensor(NULL);
+            slot->input[j]->data = NULL;
+        }
+        slot->output_data = shl_mem_alloc(sess->output_num * sizeof(void *));
+        slot->output = shl_mem_alloc(sess->output_num * sizeof(struct csinn_tensor *));
+        slot->output_buf = shl_mem_alloc(sess->output_num * sizeof(void *));
+        slot->output_buf_size = shl_mem_alloc(sess->output_num * sizeof(int));
+        for (int j = 0; j < sess->output_num; j++) {
+            slot->output[j] = csinn_alloc_tensor(NULL);
+        }
+    }
+#if (!defined SHL_BUILD_RTOS)
+    pthread_mutex_init(&ctx->lock, NULL);
+    pthread_cond_init(&ctx->cond, NULL);
+#endif
+    return ctx;
+}
+
+static void async_free(struct shl_async_context *ctx, struct csinn_session *sess)
+{
+    for (int i = 0; i < ctx->slot_num; i++) {
+        struct shl_async_slot *slot = &ctx->slot[i];
+        for (int j = 0; j < sess->output_num; j++) {
+            csinn_free_tensor(slot->output[j]);
+            shl_mem_free(slot->output_buf[j]);
+        }
+        shl_mem_free(slot->output_buf);
+        shl_mem_free(slot->output_buf_size);
+        for (int j = 0; j < sess->input_num; j++) {
+            csinn_free_tensor(slot->input[j]);
+        }
+        shl_mem_free(slot->output);
+        shl_mem_free(slot->input);
+        shl_preprocess_free(slot->input_image, sess->input_num);
+        shl_mem_free(slot->output_data);
+    }
+    shl_mem_free(ctx->slot);
+#if (!defined SHL_BUILD_RTOS)
+    pthread_mutex_destroy(&ctx->lock);
+    pthread_cond_destroy(&ctx->cond);
+#endif
+    shl_mem_free(ctx);
+}
+
+/* bind the slot data into the session, run it and keep the outputs in the slot */
+static int async_execute_slot(struct csinn_session *sess, struct shl_async_slot *slot)
+{
+    int (*func)();
+    void *session_output[sess->output_num];
+    for (int i = 0; i < sess->input_num; i++) {
+        if (slot->input[i]->data == NULL) continue;
+        sess->input[i]->data = slot->input[i]->data;
+        func = shl_get_runtime_callback(sess, CSINN_UPDATE_INPUT);
+        if (func != NULL) {
+            /* the slot tensor carries the shape, which may differ per slot */
+            func(i, slot->input[i], sess);
+        }
+    }
+    for (int i = 0; i < sess->output_num; i++) {
+        session_output[i] = sess->output[i]->data;
+        if (slot->output_data[i] == NULL) continue;
+        sess->output[i]->data = slot->output_data[i];
+        func = shl_get_runtime_callback(sess, CSINN_UPDATE_OUTPUT);
+        if (func != NULL) {
+            func(i, sess->output[i], sess);
+        }
+    }
+
+    int ret = CSINN_FALSE;
+    func = shl_get_runtime_callback(sess, CSINN_SESSION_RUN);
+    if (func != NULL) {
+        if (sess->profiler_level == CSI_PROFILER_LEVEL_TIMER) {
+            uint64_t start = shl_get_timespec();
+            ret = func(sess);
+            uint64_t end = shl_get_timespec();
+            shl_print_time_interval(start, end, __func__);
+        } else {
+            ret = func(sess);
+        }
+    }
+
+    for (int i = 0; i < sess->output_num; i++) {
+        csinn_get_output(i, slot->output[i], sess);
+        if (slot->output_data[i] != NULL) {
+            /* give the session its own output back for the next slot */
+            sess->output[i]->data = session_output[i];
+            func = shl_get_runtime_callback(sess, CSINN_UPDATE_OUTPUT);
+            if (func != NULL) {
+                func(i, sess->output[i], sess);
+            }
+            continue;
+        }
+        int size = csinn_tensor_byte_size(slot->output[i]);
+        if (size > slot->output_buf_size[i]) {
+            shl_mem_free(slot->output_buf[i]);
+            slot->output_buf[i] = shl_mem_alloc(size);
+            slot->output_buf_size[i] = size;
+        }
+        if (slot->output[i]->data != NULL) {
+            memcpy(slot->output_buf[i], slot->output[i]->data, size);
+        }
+        slot->output[i]->data = slot->output_buf[i];
+    }
+    return ret;
+}
+
+#if (!defined SHL_BUILD_RTOS)
+static void *async_worker(void *arg)
+{
+    struct csinn_session *sess = arg;
+    struct shl_async_context *ctx = sess->async;
+
+    pthread_mutex_lock(&ctx->lock);
+    while (1) {
+        while (ctx->pending == 0 && !ctx->stop) {
+            pthread_cond_wait(&ctx->cond, &ctx->lock);
+        }
+        if (ctx->pending == 0 && ctx->stop) {
+            break;
+        }
+        int idx = ctx->run_idx;
+        struct shl_async_slot *slot = &ctx->slot[idx];
+        slot->state = SHL_ASYNC_SLOT_RUNNING;
+        pthread_mutex_unlock(&ctx->lock);
+
+        int status = async_execute_slot(sess, slot);
+
+        pthread_mutex_lock(&ctx->lock);
+        slot->status = status;
+        slot->state = SHL_ASYNC_SLOT_CALLBACK;
+        ctx->last_status = status;
+        ctx->run_idx = (idx + 1) % ctx->slot_num;
+        void (*callback)(struct csinn_session *, int, int, void *) = slot->callback;
+        void *user_data = slot->user_data;
+        pthread_mutex_unlock(&ctx->lock);
+
+        /* callback runs on the worker, outside the lock, before the slot can be refilled */
+        if (callback != NULL) {
+            callback(sess, idx, status, user_data);
+        }
+
+        pthread_mutex_lock(&ctx->lock);
+        slot->state = SHL_ASYNC_SLOT_DONE;
+        ctx->pending--;
+        pthread_cond_broadcast(&ctx->cond);
+    }
+    pthread_mutex_unlock(&ctx->lock);
+    return NULL;
+}
+#endif
+
+static struct shl_async_context *async_get_context(struct csinn_session *sess)
+{
+    if (sess->async == NULL) {
+        csinn_session_set_slot_number(SHL_ASYNC_DEFAULT_SLOT_NUM, sess);
+    }
+    return sess->async;
+}
+
+int csinn_session_set_slot_number(int number, struct csinn_session *sess)
+{
+    if (number <= 0) {
+        shl_debug_error("%s: slot number must be positive\n", __func__);
+        return CSINN_FALSE;
+    }
+    if (sess->async != NULL) {
+        shl_async_deinit(sess);
+    }
+    sess->async = async_alloc(number, sess);
+    return CSINN_TRUE;
+}
+
+int shl_async_update_input(int index, struct csinn_tensor *input, struct csinn_session *sess)
+{
+    struct shl_async_context *ctx = sess->async;
+    struct csinn_tensor *t = ctx->slot[ctx->fill_idx].input[index];
+    t->data = input->data;
+    t->dim_count = input->dim_count;
+    memcpy(t->dim, input->dim, MAX_DIM * sizeof(int32_t));
+    return CSINN_TRUE;
+}
+
+/* buffer of the fill slot for a preprocessed input, it lives as long as the slot */
+void *shl_async_input_image(int index, int64_t size, struct csinn_session *sess)
+{
+    struct shl_async_context *ctx = sess->async;
+    struct shl_async_slot *slot = &ctx->slot[ctx->fill_idx];
+    return shl_preprocess_buffer(&slot->input_image, sess->input_num, index, size);
+}
+
+int shl_async_update_output(int index, struct csinn_tensor *output, struct csinn_session *sess)
+{
+    struct shl_async_context *ctx = sess->async;
+    ctx->slot[ctx->fill_idx].output_data[index] = output->data;
+    return CSINN_TRUE;
+}
+
+/*
+ * Queue the fill slot and return its index, or -1 on failure. The callback is invoked
+ * with (sess, slot, status, user_data) once the slot is finished. Returns only when the
+ * next fill slot is free, so at most slot_number runs are in flight.
+ */
+int csinn_session_run_async(struct csinn_session *sess,
+                            void (*callback)(struct csinn_session *, int, int, void *),
+                            void *user_data)
+{
+    struct shl_async_context *ctx = async_get_context(sess);
+    if (ctx == NULL) {
+        return -1;
+    }
+    int idx = ctx->fill_idx;
+    struct shl_async_slot *slot = &ctx->slot[idx];
+
+#ifdef SHL_BUILD_RTOS
+    slot->state = SHL_ASYNC_SLOT_RUNNING;
+    slot->status = async_execute_slot(sess, slot);
+    slot->state = SHL_ASYNC_SLOT_CALLBACK;
+    ctx->last_status = slot->status;
+    ctx->fill_idx = (idx + 1) % ctx->slot_num;
+    if (callback != NULL) {
+        callback(sess, idx, slot->status, user_data);
+    }
+    slot->state = SHL_ASYNC_SLOT_DONE;
+#else
+    pthread_mutex_lock(&ctx->lock);
+    if (!ctx->worker_started) {
+        if (pthread_create(&ctx->worker, NULL, async_worker, sess) != 0) {
+            pthread_mutex_unlock(&ctx->lock);
+            shl_debug_error("%s: cannot create worker thread\n", __func__);
+            return -1;
+        }
+        ctx->worker_started = 1;
+    }
+    slot->callback = callback;
+    slot->user_data = user_data;
+    slot->state = SHL_ASYNC_SLOT_QUEUED;
+    ctx->pending++;
+    pthread_cond_broadcast(&ctx->cond);
+
+    ctx->fill_idx = (idx + 1) % ctx->slot_num;
+    struct shl_async_slot *next = &ctx->slot[ctx->fill_idx];
+    while (next->state == SHL_ASYNC_SLOT_QUEUED || next->state == SHL_ASYNC_SLOT_RUNNING ||
+           next->state == SHL_ASYNC_SLOT_CALLBACK) {
+        pthread_cond_wait(&ctx->cond, &ctx->lock);
+    }
+    pthread_mutex_unlock(&ctx->lock);
+#endif
+    return idx;
+}
+
+/* block until every queued run has finished, return the status of the last one */
+int csinn_session_wait(struct csinn_session *sess)
+{
+    struct shl_async_context *ctx = sess->async;
+    if (ctx == NULL) {
+        return CSINN_TRUE;
+    }
+    int ret;
+#if (!defined SHL_BUILD_RTOS)
+    pthread_mutex_lock(&ctx->lock);
+    while (ctx->pending != 0) {
+        pthread_cond_wait(&ctx->cond, &ctx->lock);
+    }
+    ret = ctx->last_status;
+    pthread_mutex_unlock(&ctx->lock);
+#else
+    ret = ctx->last_status;
+#endif
+    return ret;
+}
+
+/* CSINN_TRUE if the session is idle, CSINN_FALSE while runs are still in flight */
+int csinn_session_poll(struct csinn_session *sess)
+{
+    struct shl_async_context *ctx = sess->async;
+    if (ctx == NULL) {
+        return CSINN_TRUE;
+    }
+    int ret = CSINN_TRUE;
+#if (!defined SHL_BUILD_RTOS)
+    pthread_mutex_lock(&ctx->lock);
+    if (ctx->pending != 0) {
+        ret = CSINN_FALSE;
+    }
+    pthread_mutex_unlock(&ctx->lock);
+#endif
+    return ret;
+}
+
+int csinn_get_output_slot(int slot, int index, struct csinn_tensor *output,
+                          struct csinn_session *sess)
+{
+    struct shl_async_context *ctx = sess->async;
+    if (ctx == NULL || slot < 0 || slot >= ctx->slot_num || index >= sess->output_num) {
+        return CSINN_FALSE;
+    }
+    int ret = CSINN_FALSE;
+#if (!defined SHL_BUILD_RTOS)
+    pthread_mutex_lock(&ctx->lock);
+#endif
+    /* readable from the slot callback as well as after it */
+    if (ctx->slot[slot].state == SHL_ASYNC_SLOT_CALLBACK ||
+        ctx->slot[slot].state == SHL_ASYNC_SLOT_DONE) {
+        csinn_tensor_copy(output, ctx->slot[slot].output[index]);
+        ret = ctx->slot[slot].status;
+    }
+#if (!defined SHL_BUILD_RTOS)
+    pthread_mutex_unlock(&ctx->lock);
+#endif
+    return ret;
+}
+
+void shl_async_deinit(struct csinn_session *sess)
+{
+    struct shl_async_context *ctx = sess->async;
+    if (ctx == NULL) {
+        return;
+    }
+#if (!defined SHL_BUILD_RTOS)
+    pthread_mutex_lock(&ctx->lock);
+    ctx->stop = 1;
+    pthread_cond_broadcast(&ctx->cond);
+    pthread_mutex_unlock(&ctx->lock);
+    if (ctx->worker_started) {
+        pthread_join(ctx->worker, NULL);
+    }
+#endif
+    async_free(ctx, sess);
+    sess->async = NULL;
+}
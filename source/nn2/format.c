@@ -216,6 +216,48 @@ void shl_dump_bm_graph_info_section(FILE *f, struct csinn_session *sess)
     shl_mem_free(buf);
 }
 
+/*
+ * Append the tuning cache of sess page aligned after the sections already in f,
+ * record its place in info and rewrite the section info page.
+ */
+void shl_dump_bm_tune_section(FILE *f, struct csinn_session *sess,
+                              struct shl_binary_model_section_info *info)
+{
+    int size = 0;
+    char *buf = shl_tune_cache_dump(sess, &size);
+
+    fseek(f, 0, SEEK_END);
+    long end = ftell(f);
+    long offset = (end + 4095) / 4096 * 4096;
+    for (long i = end; i < offset; i++) {
+        fputc(0, f);
+    }
+    fwrite(buf, 1, size, f);
+    shl_mem_free(buf);
+
+    info->tune_offset = offset / 4096;
+    info->tune_size = size;
+    fseek(f, 4096, SEEK_SET);
+    shl_dump_bm_section_info(f, info);
+    fseek(f, 0, SEEK_END);
+}
+
+/* kernels tuned when the model was saved are picked without timing again */
+int shl_bm_tune_load(struct csinn_session *sess, char *bm_addr)
+{
+    struct shl_binary_model_section_info *sinfo =
+        (struct shl_binary_model_section_info *)(bm_addr + 4096);
+    if (sinfo->tune_size <= 0) {
+        return CSINN_FALSE;
+    }
+    char *tune = bm_addr + sinfo->tune_offset * 4096;
+    if (shl_tune_cache_load(sess, tune, sinfo->tune_size) != CSINN_TRUE) {
+        return CSINN_FALSE;
+    }
+    sess->tune_mode = CSINN_TUNE_CACHE;
+    return CSINN_TRUE;
+}
+
 struct csinn_session *__attribute__((weak)) csinn_import_binary_model(char *bm_addr)
 {
     struct shl_binary_model_section_info *sinfo =
@@ -224,6 +266,7 @@ struct csinn_session *__attribute__((weak)) csinn_import_binary_model(char *bm_a
         (struct csinn_session *)(bm_addr + sinfo->sections->info_offset * 4096);
     struct csinn_session *sess = csinn_alloc_session();
     shl_bm_session_load(sess, bm_sess);
+    shl_bm_tune_load(sess, bm_addr);
     sess->model.bm_addr = bm_addr + sinfo->sections->graph_offset * 4096;
     sess->model.bm_size = sinfo->sections->graph_size;
     csinn_load_binary_model(sess);
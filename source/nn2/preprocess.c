@@ -0,0 +1,443 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "csi_nn.h"
+#include "shl_utils.h"
+
+#ifdef SHL_AVX_OPT
+#include <immintrin.h>
+#elif __riscv_vector
+#include <riscv_vector.h>
+#endif
+
+/*
+ * Source offset pair and weight of the second one, for every output row or column. Column
+ * offsets are in bytes of the packed source row, i.e. already multiplied by the pixel step.
+ */
+struct preprocess_table {
+    int32_t *i0;
+    int32_t *i1;
+    float *w;
+};
+
+static void table_init(struct preprocess_table *t, int32_t out_size, int32_t in_size, int step,
+                       bool nearest)
+{
+    t->i0 = shl_mem_alloc(out_size * sizeof(int32_t));
+    t->i1 = shl_mem_alloc(out_size * sizeof(int32_t));
+    t->w = shl_mem_alloc(out_size * sizeof(float));
+    float ratio = (float)in_size / out_size;
+    for (int i = 0; i < out_size; i++) {
+        if (nearest) {
+            int32_t s = (int32_t)floor(i * ratio);
+            t->i0[i] = t->i1[i] = (s < in_size - 1 ? s : in_size - 1) * step;
+            t->w[i] = 0.0f;
+            continue;
+        }
+        /* half pixel centers */
+        float s = (i + 0.5f) * ratio - 0.5f;
+        s = s > 0.0f ? s : 0.0f;
+        int32_t s0 = (int32_t)s;
+        if (s0 >= in_size - 1) {
+            t->i0[i] = t->i1[i] = (in_size - 1) * step;
+            t->w[i] = 0.0f;
+        } else {
+            t->i0[i] = s0 * step;
+            t->i1[i] = (s0 + 1) * step;
+            t->w[i] = s - s0;
+        }
+    }
+}
+
+static void table_free(struct preprocess_table *t)
+{
+    shl_mem_free(t->i0);
+    shl_mem_free(t->i1);
+    shl_mem_free(t->w);
+}
+
+/*
+ * Interpolate one channel of an output row from two source rows: gather the two columns of
+ * each row, blend them horizontally, then vertically with wy. r1 is not read when wy is 0.
+ */
+static void sample_row(uint8_t *r0, uint8_t *r1, float wy, struct preprocess_table *tx,
+                       int32_t out_w, float *dst)
+{
+    int x = 0;
+#ifdef SHL_AVX_OPT
+    /* no byte gather without AVX2, the lanes are filled from scalar loads */
+    const __m256 _wy = _mm256_set1_ps(wy);
+    for (; x + 8 <= out_w; x += 8) {
+        float a0[8], b0[8], a1[8], b1[8];
+        const int32_t *i0 = tx->i0 + x;
+        const int32_t *i1 = tx->i1 + x;
+        for (int k = 0; k < 8; k++) {
+            a0[k] = r0[i0[k]];
+            b0[k] = r0[i1[k]];
+        }
+        __m256 _w = _mm256_loadu_ps(tx->w + x);
+        __m256 _a = _mm256_loadu_ps(a0);
+        __m256 _top = _mm256_fmadd_ps(_mm256_sub_ps(_mm256_loadu_ps(b0), _a), _w, _a);
+        if (wy != 0.0f) {
+            for (int k = 0; k < 8; k++) {
+                a1[k] = r1[i0[k]];
+                b1[k] = r1[i1[k]];
+            }
+            _a = _mm256_loadu_ps(a1);
+            __m256 _bottom = _mm256_fmadd_ps(_mm256_sub_ps(_mm256_loadu_ps(b1), _a), _w, _a);
+            _top = _mm256_fmadd_ps(_mm256_sub_ps(_bottom, _top), _wy, _top);
+        }
+        _mm256_storeu_ps(dst + x, _top);
+    }
+#elif (__riscv_v == 1000000)
+    while (x < out_w) {
+        int vl = vsetvl_e32m4(out_w - x);
+        vuint32m4_t _i0 = vle32_v_u32m4((uint32_t *)tx->i0 + x, vl);
+        vuint32m4_t _i1 = vle32_v_u32m4((uint32_t *)tx->i1 + x, vl);
+        vfloat32m4_t _w = vle32_v_f32m4(tx->w + x, vl);
+        vfloat32m4_t _a =
+            vfwcvt_f_xu_v_f32m4(vwcvtu_x_x_v_u16m2(vluxei32_v_u8m1(r0, _i0, vl), vl), vl);
+        vfloat32m4_t _b =
+            vfwcvt_f_xu_v_f32m4(vwcvtu_x_x_v_u16m2(vluxei32_v_u8m1(r0, _i1, vl), vl), vl);
+        vfloat32m4_t _top = vfmacc_vv_f32m4(_a, _w, vfsub_vv_f32m4(_b, _a, vl), vl);
+        if (wy != 0.0f) {
+            _a = vfwcvt_f_xu_v_f32m4(vwcvtu_x_x_v_u16m2(vluxei32_v_u8m1(r1, _i0, vl), vl), vl);
+            _b = vfwcvt_f_xu_v_f32m4(vwcvtu_x_x_v_u16m2(vluxei32_v_u8m1(r1, _i1, vl), vl), vl);
+            vfloat32m4_t _bottom = vfmacc_vv_f32m4(_a, _w, vfsub_vv_f32m4(_b, _a, vl), vl);
+            _top = vfmacc_vf_f32m4(_top, wy, vfsub_vv_f32m4(_bottom, _top, vl), vl);
+        }
+        vse32_v_f32m4(dst + x, _top, vl);
+        x += vl;
+    }
+#endif
+    for (; x < out_w; x++) {
+        int32_t a = tx->i0[x];
+        int32_t b = tx->i1[x];
+        float top = r0[a] + (r0[b] - r0[a]) * tx->w[x];
+        if (wy != 0.0f) {
+            float bottom = r1[a] + (r1[b] - r1[a]) * tx->w[x];
+            top = top + (bottom - top) * wy;
+        }
+        dst[x] = top;
+    }
+}
+
+/* BT.601 limited range */
+static void yuv_to_rgb_row(float *y, float *u, float *v, float *r, float *g, float *b,
+                           int32_t size)
+{
+    int x = 0;
+#ifdef SHL_AVX_OPT
+    const __m256 _zero = _mm256_setzero_ps();
+    const __m256 _max = _mm256_set1_ps(255.0f);
+    for (; x + 8 <= size; x += 8) {
+        __m256 _y = _mm256_mul_ps(_mm256_sub_ps(_mm256_loadu_ps(y + x), _mm256_set1_ps(16.0f)),
+                                  _mm256_set1_ps(1.164f));
+        __m256 _u = _mm256_sub_ps(_mm256_loadu_ps(u + x), _mm256_set1_ps(128.0f));
+        __m256 _v = _mm256_sub_ps(_mm256_loadu_ps(v + x), _mm256_set1_ps(128.0f));
+        __m256 _r = _mm256_fmadd_ps(_mm256_set1_ps(1.596f), _v, _y);
+        __m256 _g = _mm256_fnmadd_ps(_mm256_set1_ps(0.813f), _v, _y);
+        _g = _mm256_fnmadd_ps(_mm256_set1_ps(0.391f), _u, _g);
+        __m256 _b = _mm256_fmadd_ps(_mm256_set1_ps(2.018f), _u, _y);
+        _mm256_storeu_ps(r + x, _mm256_min_ps(_mm256_max_ps(_r, _zero), _max));
+        _mm256_storeu_ps(g + x, _mm256_min_ps(_mm256_max_ps(_g, _zero), _max));
+        _mm256_storeu_ps(b + x, _mm256_min_ps(_mm256_max_ps(_b, _zero), _max));
+    }
+#elif __riscv_vector
+    while (x < size) {
+        int vl = vsetvl_e32m4(size - x);
+        vfloat32m4_t _y = vfmul_vf_f32m4(vfsub_vf_f32m4(vle32_v_f32m4(y + x, vl), 16.0f, vl),
+                                         1.164f, vl);
+        vfloat32m4_t _u = vfsub_vf_f32m4(vle32_v_f32m4(u + x, vl), 128.0f, vl);
+        vfloat32m4_t _v = vfsub_vf_f32m4(vle32_v_f32m4(v + x, vl), 128.0f, vl);
+        vfloat32m4_t _r = vfmacc_vf_f32m4(_y, 1.596f, _v, vl);
+        vfloat32m4_t _g = vfnmsac_vf_f32m4(_y, 0.813f, _v, vl);
+        _g = vfnmsac_vf_f32m4(_g, 0.391f, _u, vl);
+        vfloat32m4_t _b = vfmacc_vf_f32m4(_y, 2.018f, _u, vl);
+        vse32_v_f32m4(r + x, vfmin_vf_f32m4(vfmax_vf_f32m4(_r, 0.0f, vl), 255.0f, vl), vl);
+        vse32_v_f32m4(g + x, vfmin_vf_f32m4(vfmax_vf_f32m4(_g, 0.0f, vl), 255.0f, vl), vl);
+        vse32_v_f32m4(b + x, vfmin_vf_f32m4(vfmax_vf_f32m4(_b, 0.0f, vl), 255.0f, vl), vl);
+        x += vl;
+    }
+#endif
+    for (; x < size; x++) {
+        float yy = 1.164f * (y[x] - 16.0f);
+        float uu = u[x] - 128.0f;
+        float vv = v[x] - 128.0f;
+        r[x] = fminf(fmaxf(yy + 1.596f * vv, 0.0f), 255.0f);
+        g[x] = fminf(fmaxf(yy - 0.813f * vv - 0.391f * uu, 0.0f), 255.0f);
+        b[x] = fminf(fmaxf(yy + 2.018f * uu, 0.0f), 255.0f);
+    }
+}
+
+/* (x - mean) * scale in place */
+static void normalize_row(float *src, float mean, float scale, int32_t size)
+{
+    int x = 0;
+#ifdef SHL_AVX_OPT
+    const __m256 _mean = _mm256_set1_ps(mean);
+    const __m256 _scale = _mm256_set1_ps(scale);
+    for (; x + 8 <= size; x += 8) {
+        __m256 _x = _mm256_sub_ps(_mm256_loadu_ps(src + x), _mean);
+        _mm256_storeu_ps(src + x, _mm256_mul_ps(_x, _scale));
+    }
+#elif __riscv_vector
+    while (x < size) {
+        int vl = vsetvl_e32m4(size - x);
+        vfloat32m4_t _x = vfsub_vf_f32m4(vle32_v_f32m4(src + x, vl), mean, vl);
+        vse32_v_f32m4(src + x, vfmul_vf_f32m4(_x, scale, vl), vl);
+        x += vl;
+    }
+#endif
+    for (; x < size; x++) {
+        src[x] = (src[x] - mean) * scale;
+    }
+}
+
+static void store_strided(void *dest, int64_t step, void *src, int32_t size, int byte)
+{
+    for (int x = 0; x < size; x++) {
+        switch (byte) {
+            case 1:
+                ((int8_t *)dest)[x * step] = ((int8_t *)src)[x];
+                break;
+            case 2:
+                ((int16_t *)dest)[x * step] = ((int16_t *)src)[x];
+                break;
+            default:
+                ((int32_t *)dest)[x * step] = ((int32_t *)src)[x];
+                break;
+        }
+    }
+}
+
+/* normalize one model channel of a row in place, then convert it into dest */
+static void store_row(struct csinn_tensor *dest, float *src, float mean, float scale,
+                      int32_t size, int channel, int64_t index, int64_t step, void *tmp)
+{
+    normalize_row(src, mean, scale, size);
+    int byte = 2;
+    if (dest->dtype == CSINN_DTYPE_FLOAT32) {
+        byte = 4;
+    } else if (dest->dtype == CSINN_DTYPE_UINT8 || dest->dtype == CSINN_DTYPE_INT8) {
+        byte = 1;
+    }
+    float qscale = 1.0f;
+    float qzp = 0.0f;
+    if (byte != 4 && dest->dtype != CSINN_DTYPE_FLOAT16) {
+        int q = dest->quant_channel > 1 ? channel : 0;
+        qscale = dest->qinfo[q].scale;
+        qzp = dest->qinfo[q].zero_point;
+    }
+    int8_t *out = (int8_t *)dest->data + index * byte;
+    void *row = step == 1 ? (void *)out : tmp;
+
+    switch (dest->dtype) {
+        case CSINN_DTYPE_FLOAT32:
+            row = src;
+            break;
+        case CSINN_DTYPE_FLOAT16:
+            shl_f32_to_f16(src, row, size, 1);
+            break;
+        case CSINN_DTYPE_UINT8:
+            shl_quantize_f32_to_u8(src, row, size, &qscale, &qzp, false, 1);
+            break;
+        case CSINN_DTYPE_INT8:
+            shl_quantize_f32_to_i8(src, row, size, &qscale, &qzp, false, 1);
+            break;
+        default:
+            shl_quantize_f32_to_i16(src, row, size, &qscale, &qzp, false, 1);
+            break;
+    }
+    if (step != 1) {
+        store_strided(out, step, row, size, byte);
+    } else if (row != out) {
+        memcpy(out, row, size * byte);
+    }
+}
+
+/*
+ * Resize, colour convert, normalize and quantize a camera frame into a model input in one
+ * pass: every output row is sampled from at most two source rows and written straight to
+ * dest. dest supplies the target shape, dtype (float32, float16, uint8, int8, int16),
+ * layout (NCHW, NHWC or NC1HWC0) and quantization info, e.g. from csinn_get_input.
+ * Model channels past the third one are padding and get the value of 0.0.
+ */
+int csinn_tensor_preprocess(struct csinn_tensor *dest, uint8_t *image,
+                            struct csinn_preprocess_params *params)
+{
+    int32_t channel, out_h, out_w;
+    int64_t row_stride;
+    int32_t c0 = 1;
+    if (dest->layout == CSINN_LAYOUT_NCHW && dest->dim_count == 4) {
+        channel = dest->dim[1];
+        out_h = dest->dim[2];
+        out_w = dest->dim[3];
+        row_stride = out_w;
+    } else if (dest->layout == CSINN_LAYOUT_NHWC && dest->dim_count == 4) {
+        out_h = dest->dim[1];
+        out_w = dest->dim[2];
+        channel = dest->dim[3];
+        c0 = channel;
+        row_stride = (int64_t)out_w * channel;
+    } else if (dest->layout == CSINN_LAYOUT_NC1HWC0 && dest->dim_count == 5) {
+        out_h = dest->dim[2];
+        out_w = dest->dim[3];
+        c0 = dest->dim[4];
+        channel = dest->dim[1] * c0;
+        row_stride = (int64_t)out_w * c0;
+    } else {
+        shl_debug_error("%s: unsupported layout %d\n", __func__, dest->layout);
+        return CSINN_FALSE;
+    }
+    if (dest->dim[0] != 1 || channel < 3) {
+        shl_debug_error("%s: expect one image of at least 3 channels\n", __func__);
+        return CSINN_FALSE;
+    }
+    if (dest->dtype != CSINN_DTYPE_FLOAT32 && dest->dtype != CSINN_DTYPE_FLOAT16 &&
+        dest->dtype != CSINN_DTYPE_UINT8 && dest->dtype != CSINN_DTYPE_INT8 &&
+        dest->dtype != CSINN_DTYPE_INT16) {
+        shl_debug_error("%s: unsupported dtype %d\n", __func__, dest->dtype);
+        return CSINN_FALSE;
+    }
+
+    int32_t in_w = params->width;
+    int32_t in_h = params->height;
+    bool yuv = params->format >= CSINN_IMAGE_NV12;
+    bool nearest = params->resize_mode == CSINN_RESIZE_NEAREST_NEIGHBOR;
+    int32_t stride = params->stride != 0 ? params->stride : (yuv ? in_w : in_w * 3);
+    int64_t plane_size = (int64_t)stride * in_h;
+
+    /* chroma planes at half resolution */
+    int32_t chroma_w = (in_w + 1) / 2;
+    int32_t chroma_h = (in_h + 1) / 2;
+    int32_t chroma_stride;
+    if (params->format == CSINN_IMAGE_I420) {
+        chroma_stride = (stride + 1) / 2;
+    } else {
+        /* chroma_w interleaved pairs, a byte more than the Y row for an odd width */
+        chroma_stride = params->stride != 0 ? stride : 2 * chroma_w;
+    }
+    uint8_t *u_plane = image + plane_size;
+    uint8_t *v_plane = image + plane_size;
+    int chroma_step = 2;
+    if (params->format == CSINN_IMAGE_NV12) {
+        v_plane += 1;
+    } else if (params->format == CSINN_IMAGE_NV21) {
+        u_plane += 1;
+    } else if (params->format == CSINN_IMAGE_I420) {
+        v_plane += (int64_t)chroma_stride * chroma_h;
+        chroma_step = 1;
+    }
+
+    struct preprocess_table tx, ty, cx, cy;
+    table_init(&tx, out_w, in_w, yuv ? 1 : 3, nearest);
+    table_init(&ty, out_h, in_h, 1, nearest);
+    if (yuv) {
+        table_init(&cx, out_w, chroma_w, chroma_step, nearest);
+        table_init(&cy, out_h, chroma_h, 1, nearest);
+    }
+
+#pragma omp parallel num_threads(shl_get_thread_num(dest->sess))
+    {
+        /* R, G, B rows, then Y, U, V rows */
+        float *buf = shl_mem_alloc(6 * out_w * sizeof(float));
+        float *rgb[3] = {buf, buf + out_w, buf + 2 * out_w};
+        float *yuv_row[3] = {buf + 3 * out_w, buf + 4 * out_w, buf + 5 * out_w};
+        void *tmp = shl_mem_alloc(out_w * sizeof(float));
+
+#pragma omp for
+        for (int y = 0; y < out_h; y++) {
+            if (yuv) {
+                sample_row(image + (int64_t)ty.i0[y] * stride, image + (int64_t)ty.i1[y] * stride,
+                           ty.w[y], &tx, out_w, yuv_row[0]);
+                int64_t c_r0 = (int64_t)cy.i0[y] * chroma_stride;
+                int64_t c_r1 = (int64_t)cy.i1[y] * chroma_stride;
+                sample_row(u_plane + c_r0, u_plane + c_r1, cy.w[y], &cx, out_w, yuv_row[1]);
+                sample_row(v_plane + c_r0, v_plane + c_r1, cy.w[y], &cx, out_w, yuv_row[2]);
+                yuv_to_rgb_row(yuv_row[0], yuv_row[1], yuv_row[2], rgb[0], rgb[1], rgb[2], out_w);
+            } else {
+                uint8_t *r0 = image + (int64_t)ty.i0[y] * stride;
+                uint8_t *r1 = image + (int64_t)ty.i1[y] * stride;
+                for (int ch = 0; ch < 3; ch++) {
+                    int offset = params->format == CSINN_IMAGE_BGR888 ? 2 - ch : ch;
+                    sample_row(r0 + offset, r1 + offset, ty.w[y], &tx, out_w, rgb[ch]);
+                }
+            }
+
+            for (int c = 0; c < channel; c++) {
+                int64_t index = (int64_t)(c / c0) * out_h * row_stride + y * row_stride + c % c0;
+                if (c < 3) {
+                    store_row(dest, rgb[params->bgr ? 2 - c : c], params->mean[c],
+                              params->scale[c], out_w, c, index, c0, tmp);
+                } else {
+                    memset(yuv_row[0], 0, out_w * sizeof(float));
+                    store_row(dest, yuv_row[0], 0.0f, 1.0f, out_w, c, index, c0, tmp);
+                }
+            }
+        }
+        shl_mem_free(buf);
+        shl_mem_free(tmp);
+    }
+
+    table_free(&tx);
+    table_free(&ty);
+    if (yuv) {
+        table_free(&cx);
+        table_free(&cy);
+    }
+    return CSINN_TRUE;
+}
+
+/* buffer of one model input filled by csinn_update_input_image */
+struct preprocess_buffer {
+    void *data;
+    int64_t size;
+};
+
+/*
+ * Return buffer index of the array in *buffers, allocating the array of num entries on first
+ * use and growing the buffer to size bytes. The array is released by shl_preprocess_free.
+ */
+void *shl_preprocess_buffer(void **buffers, int num, int index, int64_t size)
+{
+    if (*buffers == NULL) {
+        *buffers = shl_mem_alloc(num * sizeof(struct preprocess_buffer));
+    }
+    struct preprocess_buffer *buf = (struct preprocess_buffer *)*buffers + index;
+    if (buf->size < size) {
+        shl_mem_free(buf->data);
+        buf->data = shl_mem_alloc(size);
+        buf->size = size;
+    }
+    return buf->data;
+}
+
+void shl_preprocess_free(void *buffers, int num)
+{
+    if (buffers == NULL) {
+        return;
+    }
+    struct preprocess_buffer *buf = buffers;
+    for (int i = 0; i < num; i++) {
+        shl_mem_free(buf[i].data);
+    }
+    shl_mem_free(buffers);
+}
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "csi_nn.h"
+#include "shl_utils.h"
+
+/* mask is optional, NULL or an empty tensor runs the attention unmasked */
+int csinn_scaled_dot_product_attention_init(
+    struct csinn_tensor *query, struct csinn_tensor *key, struct csinn_tensor *value,
+    struct csinn_tensor *mask, struct csinn_tensor *output,
+    struct csinn_scaled_dot_product_attention_params *params)
+{
+    shl_op_callback_map(&params->base, CSINN_OP_SCALED_DOT_PRODUCT_ATTENTION, query->dtype);
+    struct csinn_callback *cb = params->base.cb;
+    int (*func)() = shl_get_init_cb(&params->base);
+    if (func != NULL) {
+        func(query, key, value, mask, output, params);
+    }
+    return CSINN_TRUE;
+}
+
+int csinn_scaled_dot_product_attention(struct csinn_tensor *query, struct csinn_tensor *key,
+                                       struct csinn_tensor *value, struct csinn_tensor *mask,
+                                       struct csinn_tensor *output,
+                                       struct csinn_scaled_dot_product_attention_params *params)
+{
+    SHL_DEBUG_CALL(shl_scaled_dot_product_attention_debug_info(query, key, value, mask, output,
+                                                               params, __func__));
+    int (*func)() = shl_get_p0_cb(&params->base);
+    if (func != NULL) {
+        func(query, key, value, mask, output, params);
+    } else {
+        return CSINN_CALLBACK_UNSET;
+    }
+    return CSINN_TRUE;
+}
@@ -81,7 +81,13 @@ struct csinn_session *csinn_alloc_session()
     return shl_mem_alloc(sizeof(struct csinn_session));
 }
 
-void csinn_free_session(struct csinn_session *sess) { shl_mem_free(sess); }
+void csinn_free_session(struct csinn_session *sess)
+{
+    shl_async_deinit(sess);
+    shl_tune_cache_free(sess);
+    shl_preprocess_free(sess->input_image, sess->input_num);
+    shl_mem_free(sess);
+}
 
 static void *shl_cb_func_table[CSINN_API_SIZE];
 void shl_register_op_callback(int api, void *cb) { shl_cb_func_table[api] = cb; }
@@ -142,6 +148,9 @@ void csinn_session_init(struct csinn_session *sess)
 
 void csinn_session_deinit(struct csinn_session *sess)
 {
+    shl_async_deinit(sess);
+    shl_preprocess_free(sess->input_image, sess->input_num);
+    sess->input_image = NULL;
     void *(*func)();
     func = shl_get_runtime_callback(sess, CSINN_SESSION_DEINIT);
     if (func != NULL) {
@@ -239,6 +248,9 @@ int csinn_get_input(int index, struct csinn_tensor *input, struct csinn_session
 
 int csinn_update_input(int index, struct csinn_tensor *input, struct csinn_session *sess)
 {
+    if (sess->async != NULL) {
+        return shl_async_update_input(index, input, sess);
+    }
     sess->input[index]->data = input->data;
     int (*func)();
     func = shl_get_runtime_callback(sess, CSINN_UPDATE_INPUT);
@@ -257,8 +269,37 @@ int csinn_update_input(int index, struct csinn_tensor *input, struct csinn_sessi
     return CSINN_TRUE;
 }
 
+/*
+ * Preprocess a camera frame with csinn_tensor_preprocess into a buffer owned by the session,
+ * or by the fill slot of an asynchronous session, and bind it as input index.
+ */
+int csinn_update_input_image(int index, uint8_t *image, struct csinn_preprocess_params *params,
+                             struct csinn_session *sess)
+{
+    struct csinn_tensor *input = csinn_alloc_tensor(NULL);
+    int ret = csinn_get_input(index, input, sess);
+    if (ret == CSINN_TRUE) {
+        int64_t size = csinn_tensor_byte_size(input);
+        if (sess->async != NULL) {
+            input->data = shl_async_input_image(index, size, sess);
+        } else {
+            input->data = shl_preprocess_buffer(&sess->input_image, sess->input_num, index, size);
+        }
+        input->sess = sess;
+        ret = csinn_tensor_preprocess(input, image, params);
+    }
+    if (ret == CSINN_TRUE) {
+        ret = csinn_update_input(index, input, sess);
+    }
+    csinn_free_tensor(input);
+    return ret;
+}
+
 int csinn_update_output(int index, struct csinn_tensor *output, struct csinn_session *sess)
 {
+    if (sess->async != NULL) {
+        return shl_async_update_output(index, output, sess);
+    }
     sess->output[index]->data = output->data;
     int (*func)();
     func = shl_get_runtime_callback(sess, CSINN_UPDATE_OUTPUT);
@@ -289,6 +330,13 @@ int csinn_session_setup(struct csinn_session *sess)
 
 int csinn_session_run(struct csinn_session *sess)
 {
+    if (sess->async != NULL) {
+        /* keep ordering with the queued slots */
+        if (csinn_session_run_async(sess, NULL, NULL) < 0) {
+            return CSINN_FALSE;
+        }
+        return csinn_session_wait(sess);
+    }
     int (*func)();
     func = shl_get_runtime_callback(sess, CSINN_SESSION_RUN);
     if (func != NULL) {
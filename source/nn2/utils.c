@@ -241,6 +241,9 @@ int csinn_tensor_size(struct csinn_tensor *tensor)
 
 int csinn_tensor_byte_size(struct csinn_tensor *tensor)
 {
+    if (shl_sparse_keep(tensor->mtype)) {
+        return shl_sparse_byte_size(tensor);
+    }
     int size = csinn_tensor_size(tensor);
     switch (tensor->dtype) {
         case CSINN_DTYPE_INT4:
@@ -323,33 +326,32 @@ void *csinn_alloc_params(int params_size, struct csinn_session *session)
     return params;
 }
 
-void csinn_free_params(void *params) { shl_mem_free(params); }
-
-static float int4_to_float_base(int8_t i, struct csinn_tensor *t, int index)
-{
-    return ((float)i - t->qinfo[index].zero_point) * t->qinfo[index].scale;
-}
-
-static float uint8_to_float_base(uint8_t i, struct csinn_tensor *t, int index)
+int shl_get_thread_num(struct csinn_session *sess)
 {
-    return ((float)i - t->qinfo[index].zero_point) * t->qinfo[index].scale;
+#ifdef _OPENMP
+    if (sess != NULL && sess->thread_num > 0) {
+        return sess->thread_num;
+    }
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
 }
 
-static float int8_to_float_base(int8_t i, struct csinn_tensor *t, int index)
+void csinn_free_params(void *params)
 {
-    return ((float)i - t->qinfo[index].zero_point) * t->qinfo[index].scale;
+    struct csinn_params_base *base = params;
+    if (base->lut != NULL) {
+        shl_mem_free(base->lut);
+    }
+    shl_mem_free(params);
 }
 
-static float int16_to_float_base(int16_t i, struct csinn_tensor *t, int index)
+static float int4_to_float_base(int8_t i, struct csinn_tensor *t, int index)
 {
     return ((float)i - t->qinfo[index].zero_point) * t->qinfo[index].scale;
 }
 
-static float int32_to_float_base(int32_t i, struct csinn_tensor *t, int index)
-{
-    return (float)i * t->qinfo[index].scale;
-}
-
 static int8_t float_to_int4_base(float i, struct csinn_tensor *t, int index)
 {
     float ret = round(i / t->qinfo[index].scale) + t->qinfo[index].zero_point;
@@ -362,93 +364,6 @@ static int8_t float_to_int4_base(float i, struct csinn_tensor *t, int index)
     }
 }
 
-static uint8_t float_to_uint8_base(float i, struct csinn_tensor *t, int index)
-{
-    float ret = round(i / t->qinfo[index].scale) + t->qinfo[index].zero_point;
-    if (ret > 255) {
-        return 255;
-    } else if (ret < 0) {
-        return 0;
-    } else {
-        return ret;
-    }
-}
-
-static int8_t float_to_int8_base(float i, struct csinn_tensor *t, int index)
-{
-    float ret = round(i / t->qinfo[index].scale) + t->qinfo[index].zero_point;
-    if (ret > 127) {
-        return 127;
-    } else if (ret < -128) {
-        return -128;
-    } else {
-        return ret;
-    }
-}
-
-static int16_t float_to_int16_base(float i, struct csinn_tensor *t, int index)
-{
-    float ret = round(i / t->qinfo[index].scale) + t->qinfo[index].zero_point;
-    if (ret > 32767) {
-        return 32767;
-    } else if (ret < -32768) {
-        return -32768;
-    } else {
-        return ret;
-    }
-}
-
-static int16_t float32_to_float16_base(float value)
-{
-    int16_t ret;
-    if (value > -6.1e-5 && value < 6.1e-5) {
-        /* to small for f16, ignore to 0 */
-        return 0;
-    }
-    if (value > 65504) {
-        shl_debug_error("too large f32 to f16\n");
-        /* saturate to f16 max value: 65504 */
-        value = 65504;
-    }
-    int32_t org_format = *(int32_t *)&value;
-    int16_t sign = (org_format & 0x80000000) >> 16;
-    int16_t frac = (org_format & 0x7fffff) >> 13;
-    int16_t exp = (((((org_format >> 23) & 0xff) - 128) + 16) & 0x1f) << 10;
-    ret = sign | frac | exp;
-    return ret;
-}
-
-static float float16_to_float32_base(int16_t value)
-{
-    float ret;
-    if (value == 0 || value == 0x8000) {
-        return 0;
-    }
-    int32_t ret_format = 0;
-    int32_t sign = (value & 0x8000) << 16;
-    int32_t frac = (value & 0x3ff) << 13;
-    int32_t exp = (((((value >> 10) & 0x1f) - 16) + 128) & 0xff) << 23;
-    ret_format = sign | frac | exp;
-    ret = *(float *)&ret_format;
-    return ret;
-}
-
-static int16_t float32_to_bfloat16_base(float value)
-{
-    int16_t ret;
-    int32_t org_format = *(int32_t *)&value;
-    ret = (org_format & 0xffff0000) >> 16;
-    return ret;
-}
-
-static float bfloat16_to_float32_base(int16_t value)
-{
-    float ret;
-    int32_t ret_format = value << 16;
-    ret = *(float *)&ret_format;
-    return ret;
-}
-
 /* Only for CSINN_LAYOUT_OHWI, HWI's size align */
 static void axis0_int4_to_float_alignHWI(struct csinn_tensor *dest, struct csinn_tensor *src,
                                          int inner_size)
@@ -591,238 +506,369 @@ static void nhwc_float_to_int4(struct csinn_tensor *dest, struct csinn_tensor *s
     }
 }
 
+/* parallelise over channels or pixels once the tensor is this large */
+#define SHL_CONVERT_OMP_SIZE 16384
+
+/* threads of the session the tensors belong to */
+static int convert_thread_num(struct csinn_tensor *dest, struct csinn_tensor *src)
+{
+    return shl_get_thread_num(src->sess != NULL ? src->sess : dest->sess);
+}
+
+/* scale and zero point of every channel as float arrays, free with shl_mem_free */
+static void quant_param_array(struct csinn_tensor *t, float **scale, float **zp)
+{
+    int32_t q_size = t->quant_channel;
+    *scale = shl_mem_alloc(q_size * sizeof(float));
+    *zp = shl_mem_alloc(q_size * sizeof(float));
+    for (int i = 0; i < q_size; i++) {
+        (*scale)[i] = t->qinfo[i].scale;
+        (*zp)[i] = t->qinfo[i].zero_point;
+    }
+}
+
 static void nchw_uint8_to_float(struct csinn_tensor *dest, struct csinn_tensor *src, int n,
                                 int inner_size)
 {
+    int thread_num = convert_thread_num(dest, src);
     uint8_t *src_data = src->data;
     float *dest_data = dest->data;
     int32_t q_size = src->quant_channel;
+#pragma omp parallel for num_threads(thread_num) \
+    if (q_size > 1 && q_size * inner_size >= SHL_CONVERT_OMP_SIZE)
     for (int i = 0; i < q_size; i++) {
-        for (int j = 0; j < inner_size; j++) {
-            int index = n * q_size * inner_size + i * inner_size + j;
-            dest_data[index] = uint8_to_float_base(src_data[index], src, i);
-        }
+        int64_t index = ((int64_t)n * q_size + i) * inner_size;
+        float scale = src->qinfo[i].scale;
+        float zp = src->qinfo[i].zero_point;
+        shl_dequantize_u8_to_f32(src_data + index, dest_data + index, inner_size, &scale, &zp,
+                                 false, thread_num);
     }
 }
 
 static void nhwc_uint8_to_float(struct csinn_tensor *dest, struct csinn_tensor *src, int n,
                                 int inner_size)
 {
+    int thread_num = convert_thread_num(dest, src);
     uint8_t *src_data = src->data;
     float *dest_data = dest->data;
     int32_t q_size = src->quant_channel;
-    for (int j = 0; j < inner_size; j++) {
-        for (int i = 0; i < q_size; i++) {
-            int index = n * q_size * inner_size + j * q_size + i;
-            dest_data[index] = uint8_to_float_base(src_data[index], src, i);
+    if (q_size <= 0) {
+        return;
+    }
+    int64_t offset = (int64_t)n * q_size * inner_size;
+    float *scale, *zp;
+    quant_param_array(src, &scale, &zp);
+    if (q_size == 1) {
+        shl_dequantize_u8_to_f32(src_data + offset, dest_data + offset, inner_size, scale, zp,
+                                 false, thread_num);
+    } else {
+#pragma omp parallel for num_threads(thread_num) if (q_size * inner_size >= SHL_CONVERT_OMP_SIZE)
+        for (int j = 0; j < inner_size; j++) {
+            int64_t index = offset + (int64_t)j * q_size;
+            shl_dequantize_u8_to_f32(src_data + index, dest_data + index, q_size, scale, zp, true,
+                                     thread_num);
         }
     }
+    shl_mem_free(scale);
+    shl_mem_free(zp);
 }
 
 static void nchw_float_to_uint8(struct csinn_tensor *dest, struct csinn_tensor *src, int n,
                                 int inner_size)
 {
+    int thread_num = convert_thread_num(dest, src);
     float *src_data = src->data;
     uint8_t *dest_data = dest->data;
     int32_t q_size = dest->quant_channel;
+#pragma omp parallel for num_threads(thread_num) \
+    if (q_size > 1 && q_size * inner_size >= SHL_CONVERT_OMP_SIZE)
     for (int i = 0; i < q_size; i++) {
-        for (int j = 0; j < inner_size; j++) {
-            int index = n * q_size * inner_size + i * inner_size + j;
-            dest_data[index] = float_to_uint8_base(src_data[index], dest, i);
-        }
+        int64_t index = ((int64_t)n * q_size + i) * inner_size;
+        float scale = dest->qinfo[i].scale;
+        float zp = dest->qinfo[i].zero_point;
+        shl_quantize_f32_to_u8(src_data + index, dest_data + index, inner_size, &scale, &zp, false,
+                               thread_num);
     }
 }
+
 static void nhwc_float_to_uint8(struct csinn_tensor *dest, struct csinn_tensor *src, int n,
                                 int inner_size)
 {
+    int thread_num = convert_thread_num(dest, src);
     float *src_data = src->data;
     uint8_t *dest_data = dest->data;
     int32_t q_size = dest->quant_channel;
-    for (int j = 0; j < inner_size; j++) {
-        for (int i = 0; i < q_size; i++) {
-            int index = n * q_size * inner_size + j * q_size + i;
-            dest_data[index] = float_to_uint8_base(src_data[index], dest, i);
+    if (q_size <= 0) {
+        return;
+    }
+    int64_t offset = (int64_t)n * q_size * inner_size;
+    float *scale, *zp;
+    quant_param_array(dest, &scale, &zp);
+    if (q_size == 1) {
+        shl_quantize_f32_to_u8(src_data + offset, dest_data + offset, inner_size, scale, zp, false,
+                               thread_num);
+    } else {
+#pragma omp parallel for num_threads(thread_num) if (q_size * inner_size >= SHL_CONVERT_OMP_SIZE)
+        for (int j = 0; j < inner_size; j++) {
+            int64_t index = offset + (int64_t)j * q_size;
+            shl_quantize_f32_to_u8(src_data + index, dest_data + index, q_size, scale, zp, true,
+                                   thread_num);
         }
     }
+    shl_mem_free(scale);
+    shl_mem_free(zp);
 }
 
 static void nchw_int8_to_float(struct csinn_tensor *dest, struct csinn_tensor *src, int n,
                                int inner_size)
 {
+    int thread_num = convert_thread_num(dest, src);
     int8_t *src_data = src->data;
     float *dest_data = dest->data;
     int32_t q_size = src->quant_channel;
+#pragma omp parallel for num_threads(thread_num) \
+    if (q_size > 1 && q_size * inner_size >= SHL_CONVERT_OMP_SIZE)
     for (int i = 0; i < q_size; i++) {
-        for (int j = 0; j < inner_size; j++) {
-            int index = n * q_size * inner_size + i * inner_size + j;
-            dest_data[index] = int8_to_float_base(src_data[index], src, i);
-        }
+        int64_t index = ((int64_t)n * q_size + i) * inner_size;
+        float scale = src->qinfo[i].scale;
+        float zp = src->qinfo[i].zero_point;
+        shl_dequantize_i8_to_f32(src_data + index, dest_data + index, inner_size, &scale, &zp,
+                                 false, thread_num);
     }
 }
+
 static void nhwc_int8_to_float(struct csinn_tensor *dest, struct csinn_tensor *src, int n,
                                int inner_size)
 {
+    int thread_num = convert_thread_num(dest, src);
     int8_t *src_data = src->data;
     float *dest_data = dest->data;
     int32_t q_size = src->quant_channel;
-    for (int j = 0; j < inner_size; j++) {
-        for (int i = 0; i < q_size; i++) {
-            int index = n * q_size * inner_size + j * q_size + i;
-            dest_data[index] = int8_to_float_base(src_data[index], src, i);
+    if (q_size <= 0) {
+        return;
+    }
+    int64_t offset = (int64_t)n * q_size * inner_size;
+    float *scale, *zp;
+    quant_param_array(src, &scale, &zp);
+    if (q_size == 1) {
+        shl_dequantize_i8_to_f32(src_data + offset, dest_data + offset, inner_size, scale, zp,
+                                 false, thread_num);
+    } else {
+#pragma omp parallel for num_threads(thread_num) if (q_size * inner_size >= SHL_CONVERT_OMP_SIZE)
+        for (int j = 0; j < inner_size; j++) {
+            int64_t index = offset + (int64_t)j * q_size;
+            shl_dequantize_i8_to_f32(src_data + index, dest_data + index, q_size, scale, zp, true,
+                                     thread_num);
         }
     }
+    shl_mem_free(scale);
+    shl_mem_free(zp);
 }
 
 static void nchw_float_to_int8(struct csinn_tensor *dest, struct csinn_tensor *src, int n,
                                int inner_size)
 {
+    int thread_num = convert_thread_num(dest, src);
     float *src_data = src->data;
     int8_t *dest_data = dest->data;
     int32_t q_size = dest->quant_channel;
+#pragma omp parallel for num_threads(thread_num) \
+    if (q_size > 1 && q_size * inner_size >= SHL_CONVERT_OMP_SIZE)
     for (int i = 0; i < q_size; i++) {
-        for (int j = 0; j < inner_size; j++) {
-            int index = n * q_size * inner_size + i * inner_size + j;
-            dest_data[index] = float_to_int8_base(src_data[index], dest, i);
-        }
+        int64_t index = ((int64_t)n * q_size + i) * inner_size;
+        float scale = dest->qinfo[i].scale;
+        float zp = dest->qinfo[i].zero_point;
+        shl_quantize_f32_to_i8(src_data + index, dest_data + index, inner_size, &scale, &zp, false,
+                               thread_num);
     }
 }
 
 static void nhwc_float_to_int8(struct csinn_tensor *dest, struct csinn_tensor *src, int n,
                                int inner_size)
 {
+    int thread_num = convert_thread_num(dest, src);
     float *src_data = src->data;
     int8_t *dest_data = dest->data;
     int32_t q_size = dest->quant_channel;
-    for (int j = 0; j < inner_size; j++) {
-        for (int i = 0; i < q_size; i++) {
-            int index = n * q_size * inner_size + j * q_size + i;
-            dest_data[index] = float_to_int8_base(src_data[index], dest, i);
+    if (q_size <= 0) {
+        return;
+    }
+    int64_t offset = (int64_t)n * q_size * inner_size;
+    float *scale, *zp;
+    quant_param_array(dest, &scale, &zp);
+    if (q_size == 1) {
+        shl_quantize_f32_to_i8(src_data + offset, dest_data + offset, inner_size, scale, zp, false,
+                               thread_num);
+    } else {
+#pragma omp parallel for num_threads(thread_num) if (q_size * inner_size >= SHL_CONVERT_OMP_SIZE)
+        for (int j = 0; j < inner_size; j++) {
+            int64_t index = offset + (int64_t)j * q_size;
+            shl_quantize_f32_to_i8(src_data + index, dest_data + index, q_size, scale, zp, true,
+                                   thread_num);
         }
     }
+    shl_mem_free(scale);
+    shl_mem_free(zp);
 }
 
 static void nchw_int16_to_float(struct csinn_tensor *dest, struct csinn_tensor *src, int n,
                                 int inner_size)
 {
+    int thread_num = convert_thread_num(dest, src);
     int16_t *src_data = src->data;
     float *dest_data = dest->data;
     int32_t q_size = src->quant_channel;
+#pragma omp parallel for num_threads(thread_num) \
+    if (q_size > 1 && q_size * inner_size >= SHL_CONVERT_OMP_SIZE)
     for (int i = 0; i < q_size; i++) {
-        for (int j = 0; j < inner_size; j++) {
-            int index = n * q_size * inner_size + i * inner_size + j;
-            dest_data[index] = int16_to_float_base(src_data[index], src, i);
-        }
+        int64_t index = ((int64_t)n * q_size + i) * inner_size;
+        float scale = src->qinfo[i].scale;
+        float zp = src->qinfo[i].zero_point;
+        shl_dequantize_i16_to_f32(src_data + index, dest_data + index, inner_size, &scale, &zp,
+                                  false, thread_num);
     }
 }
 
 static void nhwc_int16_to_float(struct csinn_tensor *dest, struct csinn_tensor *src, int n,
                                 int inner_size)
 {
+    int thread_num = convert_thread_num(dest, src);
     int16_t *src_data = src->data;
     float *dest_data = dest->data;
     int32_t q_size = src->quant_channel;
-    for (int j = 0; j < inner_size; j++) {
-        for (int i = 0; i < q_size; i++) {
-            int index = n * q_size * inner_size + j * q_size + i;
-            dest_data[index] = int16_to_float_base(src_data[index], src, i);
+    if (q_size <= 0) {
+        return;
+    }
+    int64_t offset = (int64_t)n * q_size * inner_size;
+    float *scale, *zp;
+    quant_param_array(src, &scale, &zp);
+    if (q_size == 1) {
+        shl_dequantize_i16_to_f32(src_data + offset, dest_data + offset, inner_size, scale, zp,
+                                  false, thread_num);
+    } else {
+#pragma omp parallel for num_threads(thread_num) if (q_size * inner_size >= SHL_CONVERT_OMP_SIZE)
+        for (int j = 0; j < inner_size; j++) {
+            int64_t index = offset + (int64_t)j * q_size;
+            shl_dequantize_i16_to_f32(src_data + index, dest_data + index, q_size, scale, zp, true,
+                                      thread_num);
         }
     }
+    shl_mem_free(scale);
+    shl_mem_free(zp);
 }
 
 static void nchw_float_to_int16(struct csinn_tensor *dest, struct csinn_tensor *src, int n,
                                 int inner_size)
 {
+    int thread_num = convert_thread_num(dest, src);
     float *src_data = src->data;
     int16_t *dest_data = dest->data;
     int32_t q_size = dest->quant_channel;
+#pragma omp parallel for num_threads(thread_num) \
+    if (q_size > 1 && q_size * inner_size >= SHL_CONVERT_OMP_SIZE)
     for (int i = 0; i < q_size; i++) {
-        for (int j = 0; j < inner_size; j++) {
-            int index = n * q_size * inner_size + i * inner_size + j;
-            dest_data[index] = float_to_int16_base(src_data[index], dest, i);
-        }
+        int64_t index = ((int64_t)n * q_size + i) * inner_size;
+        float scale = dest->qinfo[i].scale;
+        float zp = dest->qinfo[i].zero_point;
+        shl_quantize_f32_to_i16(src_data + index, dest_data + index, inner_size, &scale, &zp,
+                                false, thread_num);
     }
 }
 
 static void nhwc_float_to_int16(struct csinn_tensor *dest, struct csinn_tensor *src, int n,
                                 int inner_size)
 {
+    int thread_num = convert_thread_num(dest, src);
     float *src_data = src->data;
     int16_t *dest_data = dest->data;
     int32_t q_size = dest->quant_channel;
-    for (int j = 0; j < inner_size; j++) {
-        for (int i = 0; i < q_size; i++) {
-            int index = n * q_size * inner_size + j * q_size + i;
-            dest_data[index] = float_to_int16_base(src_data[index], dest, i);
+    if (q_size <= 0) {
+        return;
+    }
+    int64_t offset = (int64_t)n * q_size * inner_size;
+    float *scale, *zp;
+    quant_param_array(dest, &scale, &zp);
+    if (q_size == 1) {
+        shl_quantize_f32_to_i16(src_data + offset, dest_data + offset, inner_size, scale, zp,
+                                false, thread_num);
+    } else {
+#pragma omp parallel for num_threads(thread_num) if (q_size * inner_size >= SHL_CONVERT_OMP_SIZE)
+        for (int j = 0; j < inner_size; j++) {
+            int64_t index = offset + (int64_t)j * q_size;
+            shl_quantize_f32_to_i16(src_data + index, dest_data + index, q_size, scale, zp, true,
+                                    thread_num);
         }
     }
+    shl_mem_free(scale);
+    shl_mem_free(zp);
 }
 
 static void nchw_int32_to_float(struct csinn_tensor *dest, struct csinn_tensor *src, int n,
                                 int inner_size)
 {
+    int thread_num = convert_thread_num(dest, src);
     int32_t *src_data = src->data;
     float *dest_data = dest->data;
     int32_t q_size = src->quant_channel;
+#pragma omp parallel for num_threads(thread_num) \
+    if (q_size > 1 && q_size * inner_size >= SHL_CONVERT_OMP_SIZE)
     for (int i = 0; i < q_size; i++) {
-        for (int j = 0; j < inner_size; j++) {
-            int index = n * q_size * inner_size + i * inner_size + j;
-            dest_data[index] = int32_to_float_base(src_data[index], src, i);
-        }
+        int64_t index = ((int64_t)n * q_size + i) * inner_size;
+        float scale = src->qinfo[i].scale;
+        float zp = src->qinfo[i].zero_point;
+        shl_dequantize_i32_to_f32(src_data + index, dest_data + index, inner_size, &scale, &zp,
+                                  false, thread_num);
     }
 }
 
 static void nhwc_int32_to_float(struct csinn_tensor *dest, struct csinn_tensor *src, int n,
                                 int inner_size)
 {
+    int thread_num = convert_thread_num(dest, src);
     int32_t *src_data = src->data;
     float *dest_data = dest->data;
     int32_t q_size = src->quant_channel;
-    for (int j = 0; j < inner_size; j++) {
-        for (int i = 0; i < q_size; i++) {
-            int index = n * q_size * inner_size + j * q_size + i;
-            dest_data[index] = int32_to_float_base(src_data[index], src, i);
+    if (q_size <= 0) {
+        return;
+    }
+    int64_t offset = (int64_t)n * q_size * inner_size;
+    float *scale, *zp;
+    quant_param_array(src, &scale, &zp);
+    if (q_size == 1) {
+        shl_dequantize_i32_to_f32(src_data + offset, dest_data + offset, inner_size, scale, zp,
+                                  false, thread_num);
+    } else {
+#pragma omp parallel for num_threads(thread_num) if (q_size * inner_size >= SHL_CONVERT_OMP_SIZE)
+        for (int j = 0; j < inner_size; j++) {
+            int64_t index = offset + (int64_t)j * q_size;
+            shl_dequantize_i32_to_f32(src_data + index, dest_data + index, q_size, scale, zp, true,
+                                      thread_num);
         }
     }
+    shl_mem_free(scale);
+    shl_mem_free(zp);
 }
 
 static void csinn_f16_to_float(struct csinn_tensor *dest, struct csinn_tensor *src)
 {
-    int16_t *src_data = src->data;
-    float *dest_data = dest->data;
-    int32_t size = csinn_tensor_size(src);
-    for (int j = 0; j < size; j++) {
-        dest_data[j] = float16_to_float32_base(src_data[j]);
-    }
+    int thread_num = convert_thread_num(dest, src);
+    shl_f16_to_f32(src->data, dest->data, csinn_tensor_size(src), thread_num);
 }
 
 static void csinn_float_to_f16(struct csinn_tensor *dest, struct csinn_tensor *src)
 {
-    float *src_data = src->data;
-    int16_t *dest_data = dest->data;
-    int32_t size = csinn_tensor_size(src);
-    for (int i = 0; i < size; i++) {
-        dest_data[i] = float32_to_float16_base(src_data[i]);
-    }
+    int thread_num = convert_thread_num(dest, src);
+    shl_f32_to_f16(src->data, dest->data, csinn_tensor_size(src), thread_num);
 }
 
 static void bf16_to_float(struct csinn_tensor *dest, struct csinn_tensor *src)
 {
-    int16_t *src_data = src->data;
-    float *dest_data = dest->data;
-    int32_t size = csinn_tensor_size(src);
-    for (int j = 0; j < size; j++) {
-        dest_data[j] = bfloat16_to_float32_base(src_data[j]);
-    }
+    shl_bf16_to_f32(src->data, dest->data, csinn_tensor_size(src));
 }
 
 static void float_to_bf16(struct csinn_tensor *dest, struct csinn_tensor *src)
 {
-    float *src_data = src->data;
-    int16_t *dest_data = dest->data;
-    int32_t size = csinn_tensor_size(src);
-    for (int i = 0; i < size; i++) {
-        dest_data[i] = float32_to_bfloat16_base(src_data[i]);
-    }
+    shl_f32_to_bf16(src->data, dest->data, csinn_tensor_size(src));
 }
 
 static int tensor_data_convert_weight(struct csinn_tensor *dest, struct csinn_tensor *src)
@@ -1022,7 +1068,9 @@ static int tensor_data_convert_weight(struct csinn_tensor *dest, struct csinn_te
 int tensor_data_convert_activation(struct csinn_tensor *dest, struct csinn_tensor *src)
 {
     int size = csinn_tensor_size(src);
-    int32_t q_size = src->quant_channel != 0 ? src->quant_channel : dest->quant_channel;
+    /* the channel split follows the quantized side, the float side may keep one qinfo */
+    struct csinn_tensor *qt = src->dtype == CSINN_DTYPE_FLOAT32 ? dest : src;
+    int32_t q_size = qt->quant_channel;
     if (q_size == 0) {
         q_size = 1;
     }
@@ -1115,9 +1163,155 @@ int tensor_data_convert_activation(struct csinn_tensor *dest, struct csinn_tenso
     return CSINN_TRUE;
 }
 
+/* element size in bytes, 0 for sub-byte types */
+static int dtype_byte(enum csinn_dtype_enum dtype)
+{
+    switch (dtype) {
+        case CSINN_DTYPE_BOOL:
+        case CSINN_DTYPE_UINT8:
+        case CSINN_DTYPE_INT8:
+            return 1;
+        case CSINN_DTYPE_INT16:
+        case CSINN_DTYPE_UINT16:
+        case CSINN_DTYPE_FLOAT16:
+        case CSINN_DTYPE_BFLOAT16:
+            return 2;
+        case CSINN_DTYPE_INT32:
+        case CSINN_DTYPE_UINT32:
+        case CSINN_DTYPE_FLOAT32:
+            return 4;
+        case CSINN_DTYPE_FLOAT64:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+/* convert a run of elements of one channel, returns CSINN_FALSE for unsupported dtypes */
+static int convert_row(void *dest_data, struct csinn_tensor *dest, void *src_data,
+                       struct csinn_tensor *src, int64_t size, int channel)
+{
+    int thread_num = convert_thread_num(dest, src);
+    struct csinn_tensor *qt = src->dtype == CSINN_DTYPE_FLOAT32 ? dest : src;
+    int q_index = qt->quant_channel > 1 ? channel : 0;
+    float scale = qt->qinfo != NULL ? qt->qinfo[q_index].scale : 1.0f;
+    float zp = qt->qinfo != NULL ? qt->qinfo[q_index].zero_point : 0.0f;
+
+    if (dest->dtype == src->dtype) {
+        if (size > 0) {
+            memcpy(dest_data, src_data, size * dtype_byte(src->dtype));
+        }
+    } else if (src->dtype == CSINN_DTYPE_FLOAT32 && dest->dtype == CSINN_DTYPE_UINT8) {
+        shl_quantize_f32_to_u8(src_data, dest_data, size, &scale, &zp, false, thread_num);
+    } else if (src->dtype == CSINN_DTYPE_FLOAT32 && dest->dtype == CSINN_DTYPE_INT8) {
+        shl_quantize_f32_to_i8(src_data, dest_data, size, &scale, &zp, false, thread_num);
+    } else if (src->dtype == CSINN_DTYPE_FLOAT32 && dest->dtype == CSINN_DTYPE_INT16) {
+        shl_quantize_f32_to_i16(src_data, dest_data, size, &scale, &zp, false, thread_num);
+    } else if (src->dtype == CSINN_DTYPE_FLOAT32 && dest->dtype == CSINN_DTYPE_FLOAT16) {
+        shl_f32_to_f16(src_data, dest_data, size, thread_num);
+    } else if (src->dtype == CSINN_DTYPE_FLOAT32 && dest->dtype == CSINN_DTYPE_BFLOAT16) {
+        shl_f32_to_bf16(src_data, dest_data, size);
+    } else if (dest->dtype == CSINN_DTYPE_FLOAT32 && src->dtype == CSINN_DTYPE_UINT8) {
+        shl_dequantize_u8_to_f32(src_data, dest_data, size, &scale, &zp, false, thread_num);
+    } else if (dest->dtype == CSINN_DTYPE_FLOAT32 && src->dtype == CSINN_DTYPE_INT8) {
+        shl_dequantize_i8_to_f32(src_data, dest_data, size, &scale, &zp, false, thread_num);
+    } else if (dest->dtype == CSINN_DTYPE_FLOAT32 && src->dtype == CSINN_DTYPE_INT16) {
+        shl_dequantize_i16_to_f32(src_data, dest_data, size, &scale, &zp, false, thread_num);
+    } else if (dest->dtype == CSINN_DTYPE_FLOAT32 && src->dtype == CSINN_DTYPE_INT32) {
+        shl_dequantize_i32_to_f32(src_data, dest_data, size, &scale, &zp, false, thread_num);
+    } else if (dest->dtype == CSINN_DTYPE_FLOAT32 && src->dtype == CSINN_DTYPE_FLOAT16) {
+        shl_f16_to_f32(src_data, dest_data, size, thread_num);
+    } else if (dest->dtype == CSINN_DTYPE_FLOAT32 && src->dtype == CSINN_DTYPE_BFLOAT16) {
+        shl_bf16_to_f32(src_data, dest_data, size);
+    } else {
+        return CSINN_FALSE;
+    }
+    return CSINN_TRUE;
+}
+
+static void copy_strided(void *dest, int64_t dest_stride, void *src, int64_t src_stride,
+                         int64_t size, int byte)
+{
+    for (int64_t i = 0; i < size; i++) {
+        switch (byte) {
+            case 1:
+                ((int8_t *)dest)[i * dest_stride] = ((int8_t *)src)[i * src_stride];
+                break;
+            case 2:
+                ((int16_t *)dest)[i * dest_stride] = ((int16_t *)src)[i * src_stride];
+                break;
+            case 4:
+                ((int32_t *)dest)[i * dest_stride] = ((int32_t *)src)[i * src_stride];
+                break;
+            default:
+                ((int64_t *)dest)[i * dest_stride] = ((int64_t *)src)[i * src_stride];
+                break;
+        }
+    }
+}
+
+/* pixels converted per channel before moving to the next one in the fused transpose */
+#define SHL_CONVERT_TILE 64
+
+/*
+ * NCHW <-> NHWC with a dtype change in one pass: a tile of pixels is converted channel by
+ * channel through a small buffer and scattered (or gathered) along the channel stride.
+ */
+static int tensor_data_convert_transpose(struct csinn_tensor *dest, struct csinn_tensor *src)
+{
+    int thread_num = convert_thread_num(dest, src);
+    int src_byte = dtype_byte(src->dtype);
+    int dest_byte = dtype_byte(dest->dtype);
+    if (src->dim_count != 4 || dest->dim_count != 4 || src_byte == 0 || dest_byte == 0 ||
+        convert_row(NULL, dest, NULL, src, 0, 0) != CSINN_TRUE) {
+        return CSINN_FALSE;
+    }
+    bool to_nhwc = src->layout == CSINN_LAYOUT_NCHW;
+    int batch = src->dim[0];
+    int channel = to_nhwc ? src->dim[1] : src->dim[3];
+    int64_t inner_size = to_nhwc ? src->dim[2] * src->dim[3] : src->dim[1] * src->dim[2];
+    if (csinn_tensor_size(dest) != batch * channel * inner_size ||
+        (src->quant_channel > 1 && src->quant_channel != channel) ||
+        (dest->quant_channel > 1 && dest->quant_channel != channel)) {
+        return CSINN_FALSE;
+    }
+    int8_t *src_data = src->data;
+    int8_t *dest_data = dest->data;
+    int64_t tile_num = (inner_size + SHL_CONVERT_TILE - 1) / SHL_CONVERT_TILE;
+
+#pragma omp parallel for collapse(2) num_threads(thread_num) \
+    if (channel * inner_size >= SHL_CONVERT_OMP_SIZE)
+    for (int n = 0; n < batch; n++) {
+        for (int64_t t = 0; t < tile_num; t++) {
+            int64_t hw = t * SHL_CONVERT_TILE;
+            int64_t len =
+                inner_size - hw < SHL_CONVERT_TILE ? inner_size - hw : SHL_CONVERT_TILE;
+            int64_t buf[SHL_CONVERT_TILE];
+            for (int c = 0; c < channel; c++) {
+                int64_t planar = ((int64_t)n * channel + c) * inner_size + hw;
+                int64_t packed = ((int64_t)n * inner_size + hw) * channel + c;
+                if (to_nhwc) {
+                    convert_row(buf, dest, src_data + planar * src_byte, src, len, c);
+                    copy_strided(dest_data + packed * dest_byte, channel, buf, 1, len, dest_byte);
+                } else {
+                    copy_strided(buf, 1, src_data + packed * src_byte, channel, len, src_byte);
+                    convert_row(dest_data + planar * dest_byte, dest, buf, src, len, c);
+                }
+            }
+        }
+    }
+    return CSINN_TRUE;
+}
+
 int csinn_tensor_data_convert(struct csinn_tensor *dest, struct csinn_tensor *src)
 {
-    if (src->layout != dest->layout) return CSINN_FALSE;
+    if (src->layout != dest->layout) {
+        if ((src->layout == CSINN_LAYOUT_NCHW && dest->layout == CSINN_LAYOUT_NHWC) ||
+            (src->layout == CSINN_LAYOUT_NHWC && dest->layout == CSINN_LAYOUT_NCHW)) {
+            return tensor_data_convert_transpose(dest, src);
+        }
+        return CSINN_FALSE;
+    }
 
     switch (src->layout) {
         case CSINN_LAYOUT_NULL:
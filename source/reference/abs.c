@@ -38,3 +38,9 @@ int shl_ref_abs_quant(struct csinn_tensor *input, struct csinn_tensor *output,
 {
     return shl_ref_siso_callback_base(input, output, params, shl_ref_abs_f32);
 }
+
+int shl_ref_abs_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_siso_params *params)
+{
+    return shl_ref_siso_lut_init(input, output, params, shl_ref_abs_f32);
+}
@@ -37,4 +37,10 @@ int shl_ref_acos_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                        struct csinn_siso_params *params)
 {
     return shl_ref_siso_callback_base(input, output, params, shl_ref_acos_f32);
+}
+
+int shl_ref_acos_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params)
+{
+    return shl_ref_siso_lut_init(input, output, params, shl_ref_acos_f32);
 }
\ No newline at end of file
@@ -20,51 +20,12 @@
 
 #include "shl_ref.h"
 
-struct ArgPos {
-    float value;
-    int32_t index;
-};
-
-static struct ArgPos fargmax_stride(struct ArgPos lhs, struct ArgPos rhs)
-{
-    if (lhs.value < rhs.value) {
-        return rhs;
-    }
-    return lhs;
-}
-
 int shl_ref_argmax_stride_i32_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                                   struct csinn_reduce_params *params)
 {
-    float *input_data = input->data;
-    int32_t *output_data = output->data;
-
-    int32_t inner_size = 1;
-    int32_t out_size = 1;
-
-    for (int32_t k = 0; k < params->n; k++) {
-        out_size *= params->out_extents[k];
-    }
-
-    for (int32_t k = 0; k < params->m; k++) {
-        inner_size *= params->inner_extents[k];
-    }
-
-    for (int32_t out = 0; out < out_size; out++) {
-        struct ArgPos result = {-FLT_MAX, -1};
-        int32_t out_index =
-            shl_ref_get_reduction_index(out, params->out_strides, params->out_extents, params->n);
-        for (int32_t inner = 0; inner < inner_size; inner++) {
-            int32_t index =
-                out_index + shl_ref_get_reduction_index(inner, params->inner_strides,
-                                                        params->inner_extents, params->m);
-            float val = input_data[index];
-            struct ArgPos pos = {val, inner};
-            result = fargmax_stride(result, pos);
-        }
-
-        output_data[out] = result.index;
-    }
+    shl_ref_arg_reduce_stride_f32(input->data, output->data, params->out_extents,
+                                  params->out_strides, params->n, params->inner_extents,
+                                  params->inner_strides, params->m, true, &params->base);
     return CSINN_TRUE;
 }
 
@@ -32,6 +32,8 @@ int shl_ref_avgpool2d_nhwc_f32(struct csinn_tensor *input, struct csinn_tensor *
     const int output_height = output->dim[1];
     const int output_width = output->dim[2];
 
+    int thread_num = shl_ref_get_thread_num(&params->base);
+#pragma omp parallel for num_threads(thread_num) collapse(2)
     for (int batch = 0; batch < batches; ++batch) {
         for (int out_y = 0; out_y < output_height; ++out_y) {
             for (int out_x = 0; out_x < output_width; ++out_x) {
@@ -82,6 +84,8 @@ static int shl_ref_avgpool2d_nchw_f32(struct csinn_tensor *input, struct csinn_t
     const int output_height = output->dim[2];
     const int output_width = output->dim[3];
 
+    int thread_num = shl_ref_get_thread_num(&params->base);
+#pragma omp parallel for num_threads(thread_num) collapse(2)
     for (int batch = 0; batch < batches; ++batch) {
         for (int out_y = 0; out_y < output_height; ++out_y) {
             for (int out_x = 0; out_x < output_width; ++out_x) {
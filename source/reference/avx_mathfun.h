@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#ifndef SHL_AVX_MATHFUN_H
+#define SHL_AVX_MATHFUN_H
+
+#ifdef SHL_AVX_OPT
+#include <immintrin.h>
+#include <math.h>
+
+/*
+ * 8-lane float transcendental functions for the x86 reference build. Only AVX and FMA are
+ * assumed, the integer steps run on the two 128-bit halves.
+ * exp and log follow cephes, tanh uses the cephes tanhf polynomial below 0.625 and
+ * 1 - 2 / (exp(2x) + 1) above, erf is x * P(x^2) below 1 and 1 - exp(-x^2) * R(1 / x) above.
+ * The same constants are used by the RVV versions in rvv_mathfun.h.
+ */
+
+/*
+ * The input is clamped to the finite range of expf, lanes above it return +inf and NaN lanes
+ * return the input.
+ */
+static inline __m256 exp256_ps(__m256 x)
+{
+    const __m256 max_x = _mm256_set1_ps(88.7228390f);
+    __m256 over = _mm256_cmp_ps(x, max_x, _CMP_GT_OQ);
+    __m256 nan = _mm256_cmp_ps(x, x, _CMP_UNORD_Q);
+    __m256 src = x;
+    x = _mm256_min_ps(x, max_x);
+    x = _mm256_max_ps(x, _mm256_set1_ps(-103.972084f));
+
+    /* express exp(x) as exp(g + n * log(2)) */
+    __m256 fx = _mm256_fmadd_ps(x, _mm256_set1_ps(1.44269504088896341f), _mm256_set1_ps(0.5f));
+    fx = _mm256_floor_ps(fx);
+    x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(0.693359375f), x);
+    x = _mm256_fnmadd_ps(fx, _mm256_set1_ps(-2.12194440e-4f), x);
+
+    __m256 y = _mm256_set1_ps(1.9875691500E-4f);
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.3981999507E-3f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(8.3334519073E-3f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(4.1665795894E-2f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.6666665459E-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(5.0000001201E-1f));
+    y = _mm256_fmadd_ps(y, _mm256_mul_ps(x, x), x);
+    y = _mm256_add_ps(y, _mm256_set1_ps(1.0f));
+
+    /*
+     * build 2^n as 2^(n / 2) * 2^(n - n / 2), n runs from -150 to 128 and each half keeps a
+     * normal exponent, the second multiply rounds once into the subnormals
+     */
+    __m256i n = _mm256_cvttps_epi32(fx);
+    const __m128i bias = _mm_set1_epi32(0x7f);
+    __m128i n_lo = _mm256_castsi256_si128(n);
+    __m128i n_hi = _mm256_extractf128_si256(n, 1);
+    __m128i h_lo = _mm_srai_epi32(n_lo, 1);
+    __m128i h_hi = _mm_srai_epi32(n_hi, 1);
+    __m128i a_lo = _mm_slli_epi32(_mm_add_epi32(h_lo, bias), 23);
+    __m128i a_hi = _mm_slli_epi32(_mm_add_epi32(h_hi, bias), 23);
+    __m128i b_lo = _mm_slli_epi32(_mm_add_epi32(_mm_sub_epi32(n_lo, h_lo), bias), 23);
+    __m128i b_hi = _mm_slli_epi32(_mm_add_epi32(_mm_sub_epi32(n_hi, h_hi), bias), 23);
+    __m256i pow2a = _mm256_insertf128_si256(_mm256_castsi128_si256(a_lo), a_hi, 1);
+    __m256i pow2b = _mm256_insertf128_si256(_mm256_castsi128_si256(b_lo), b_hi, 1);
+    y = _mm256_mul_ps(_mm256_mul_ps(y, _mm256_castsi256_ps(pow2a)), _mm256_castsi256_ps(pow2b));
+
+    y = _mm256_blendv_ps(y, _mm256_set1_ps(INFINITY), over);
+    return _mm256_blendv_ps(y, src, nan);
+}
+
+/* natural log of positive x, NaN lanes return the input */
+static inline __m256 log256_ps(__m256 x)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+    __m256 nan = _mm256_cmp_ps(x, x, _CMP_UNORD_Q);
+    __m256 src = x;
+    x = _mm256_max_ps(x, _mm256_set1_ps(1.17549435e-38f));
+
+    __m256i ux = _mm256_castps_si256(x);
+    const __m128i bias = _mm_set1_epi32(0x7f);
+    __m128i e_lo = _mm_sub_epi32(_mm_srli_epi32(_mm256_castsi256_si128(ux), 23), bias);
+    __m128i e_hi = _mm_sub_epi32(_mm_srli_epi32(_mm256_extractf128_si256(ux, 1), 23), bias);
+    __m256 e = _mm256_cvtepi32_ps(_mm256_insertf128_si256(_mm256_castsi128_si256(e_lo), e_hi, 1));
+    e = _mm256_add_ps(e, one);
+
+    /* keep the mantissa in [0.5, 1) */
+    x = _mm256_and_ps(x, _mm256_castsi256_ps(_mm256_set1_epi32(~0x7f800000)));
+    x = _mm256_or_ps(x, _mm256_set1_ps(0.5f));
+
+    /* below sqrt(1/2) use 2x - 1 with the exponent one less, otherwise x - 1 */
+    __m256 mask = _mm256_cmp_ps(x, _mm256_set1_ps(0.707106781186547524f), _CMP_LT_OQ);
+    __m256 tmp = _mm256_and_ps(x, mask);
+    x = _mm256_sub_ps(x, one);
+    e = _mm256_sub_ps(e, _mm256_and_ps(one, mask));
+    x = _mm256_add_ps(x, tmp);
+
+    __m256 z = _mm256_mul_ps(x, x);
+    __m256 y = _mm256_set1_ps(7.0376836292E-2f);
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-1.1514610310E-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.1676998740E-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-1.2420140846E-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(1.4249322787E-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-1.6668057665E-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(2.0000714765E-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(-2.4999993993E-1f));
+    y = _mm256_fmadd_ps(y, x, _mm256_set1_ps(3.3333331174E-1f));
+    y = _mm256_mul_ps(_mm256_mul_ps(y, x), z);
+
+    y = _mm256_fmadd_ps(e, _mm256_set1_ps(-2.12194440e-4f), y);
+    y = _mm256_fnmadd_ps(z, _mm256_set1_ps(0.5f), y);
+    x = _mm256_add_ps(x, y);
+    x = _mm256_fmadd_ps(e, _mm256_set1_ps(0.693359375f), x);
+    return _mm256_blendv_ps(x, src, nan);
+}
+
+/* log(1 + x) for x >= 0, log(w) * x / (w - 1) with w = 1 + x keeps small x exact */
+static inline __m256 log1p256_ps(__m256 x)
+{
+    __m256 w = _mm256_add_ps(x, _mm256_set1_ps(1.0f));
+    __m256 d = _mm256_sub_ps(w, _mm256_set1_ps(1.0f));
+    __m256 y = _mm256_div_ps(_mm256_mul_ps(log256_ps(w), x), d);
+    __m256 tiny = _mm256_cmp_ps(d, _mm256_setzero_ps(), _CMP_EQ_OQ);
+    return _mm256_blendv_ps(y, x, tiny);
+}
+
+static inline __m256 sigmoid256_ps(__m256 x)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+    __m256 e = exp256_ps(_mm256_sub_ps(_mm256_setzero_ps(), x));
+    return _mm256_div_ps(one, _mm256_add_ps(one, e));
+}
+
+static inline __m256 tanh256_ps(__m256 x)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+    __m256 ax = _mm256_andnot_ps(sign_mask, x);
+
+    /* |x| >= 0.625 */
+    __m256 e = exp256_ps(_mm256_add_ps(ax, ax));
+    __m256 big = _mm256_sub_ps(one, _mm256_div_ps(_mm256_set1_ps(2.0f), _mm256_add_ps(e, one)));
+    big = _mm256_or_ps(big, _mm256_and_ps(sign_mask, x));
+
+    /* |x| < 0.625 */
+    __m256 z = _mm256_mul_ps(x, x);
+    __m256 p = _mm256_set1_ps(-5.70498872745E-3f);
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(2.06390887954E-2f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-5.37397155531E-2f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(1.33314422036E-1f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-3.33332819422E-1f));
+    __m256 small = _mm256_fmadd_ps(_mm256_mul_ps(p, z), x, x);
+
+    __m256 mask = _mm256_cmp_ps(ax, _mm256_set1_ps(0.625f), _CMP_GE_OQ);
+    return _mm256_blendv_ps(small, big, mask);
+}
+
+static inline __m256 erf256_ps(__m256 x)
+{
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const __m256 sign_mask = _mm256_set1_ps(-0.0f);
+    /* min_ps returns its second operand for NaN, so the clamp keeps NaN lanes */
+    __m256 ax = _mm256_min_ps(_mm256_set1_ps(4.0f), _mm256_andnot_ps(sign_mask, x));
+    __m256 z = _mm256_mul_ps(ax, ax);
+
+    /* |x| < 1 */
+    __m256 p = _mm256_set1_ps(7.8845382978E-5f);
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-8.0194812035E-4f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(5.1893843581E-3f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-2.6854367672E-2f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(1.1283598417E-1f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(-3.7612626990E-1f));
+    p = _mm256_fmadd_ps(p, z, _mm256_set1_ps(1.1283791659E0f));
+    __m256 small = _mm256_mul_ps(p, ax);
+
+    /* |x| >= 1 */
+    __m256 t = _mm256_div_ps(one, ax);
+    __m256 r = _mm256_set1_ps(-1.8628525988E-2f);
+    r = _mm256_fmadd_ps(r, t, _mm256_set1_ps(1.2416455309E-1f));
+    r = _mm256_fmadd_ps(r, t, _mm256_set1_ps(-3.6063112051E-1f));
+    r = _mm256_fmadd_ps(r, t, _mm256_set1_ps(5.8205887133E-1f));
+    r = _mm256_fmadd_ps(r, t, _mm256_set1_ps(-5.0941512901E-1f));
+    r = _mm256_fmadd_ps(r, t, _mm256_set1_ps(5.2119048717E-2f));
+    r = _mm256_fmadd_ps(r, t, _mm256_set1_ps(5.5755318188E-1f));
+    r = _mm256_fmadd_ps(r, t, _mm256_set1_ps(3.6270740810E-4f));
+    __m256 e = exp256_ps(_mm256_sub_ps(_mm256_setzero_ps(), z));
+    __m256 big = _mm256_fnmadd_ps(e, r, one);
+
+    __m256 mask = _mm256_cmp_ps(ax, one, _CMP_GE_OQ);
+    __m256 y = _mm256_blendv_ps(small, big, mask);
+    return _mm256_or_ps(y, _mm256_and_ps(sign_mask, x));
+}
+
+/* horizontal reductions of the 8 lanes */
+static inline float hmax256_ps(__m256 x)
+{
+    __m128 r = _mm_max_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1));
+    r = _mm_max_ps(r, _mm_movehl_ps(r, r));
+    r = _mm_max_ss(r, _mm_shuffle_ps(r, r, 1));
+    return _mm_cvtss_f32(r);
+}
+
+static inline float hsum256_ps(__m256 x)
+{
+    __m128 r = _mm_add_ps(_mm256_castps256_ps128(x), _mm256_extractf128_ps(x, 1));
+    r = _mm_add_ps(r, _mm_movehl_ps(r, r));
+    r = _mm_add_ss(r, _mm_shuffle_ps(r, r, 1));
+    return _mm_cvtss_f32(r);
+}
+
+#endif  // SHL_AVX_OPT
+
+#endif  // SHL_AVX_MATHFUN_H
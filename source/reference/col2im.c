@@ -60,3 +60,46 @@ int shl_ref_col2im_f32(struct csinn_tensor *input, struct csinn_tensor *output,
     }
     return CSINN_TRUE;
 }
+
+/*************************************************************
+ * col2im of a deconv in NCHW, im must hold the bias (or zero) already.
+ * col: [channels, kernel_h, kernel_w, col_h, col_w], the value of tap
+ * (ky, kx) at column (y, x) is added to im[c][oy][ox] with
+ * oy = y * stride_h - pad_top + ky * dilation_h (ox alike)
+ *************************************************************/
+void shl_ref_col2im_nchw_f32(const float *col, float *im, int channels, int im_h, int im_w,
+                             int col_h, int col_w, int kernel_h, int kernel_w,
+                             struct csinn_conv2d_params *params)
+{
+    const int stride_h = params->stride_height;
+    const int stride_w = params->stride_width;
+    const int dilation_h = params->dilation_height;
+    const int dilation_w = params->dilation_width;
+
+    int thread_num = shl_ref_get_thread_num(&params->base);
+#pragma omp parallel for num_threads(thread_num)
+    for (int c = 0; c < channels; c++) {
+        float *im_ptr = im + c * im_h * im_w;
+        for (int ky = 0; ky < kernel_h; ky++) {
+            for (int kx = 0; kx < kernel_w; kx++) {
+                const float *col_ptr = col + ((c * kernel_h + ky) * kernel_w + kx) * col_h * col_w;
+                int off_x = kx * dilation_w - params->pad_left;
+                /* columns whose output x lies inside [0, im_w) */
+                int x0 = off_x >= 0 ? 0 : (stride_w - 1 - off_x) / stride_w;
+                int x1 = im_w - off_x <= 0 ? 0 : (im_w - 1 - off_x) / stride_w + 1;
+                x1 = x1 < col_w ? x1 : col_w;
+                for (int y = 0; y < col_h; y++) {
+                    int oy = y * stride_h - params->pad_top + ky * dilation_h;
+                    if (oy < 0 || oy >= im_h) {
+                        continue;
+                    }
+                    float *out = im_ptr + oy * im_w + off_x;
+                    const float *src = col_ptr + y * col_w;
+                    for (int x = x0; x < x1; x++) {
+                        out[x * stride_w] += src[x];
+                    }
+                }
+            }
+        }
+    }
+}
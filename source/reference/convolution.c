@@ -48,6 +48,8 @@ static int shl_ref_conv2d_nhwc_f32(struct csinn_tensor *input, struct csinn_tens
     const int32_t output_height = output->dim[1];
     const int32_t output_width = output->dim[2];
 
+    int thread_num = shl_ref_get_thread_num(&params->base);
+#pragma omp parallel for num_threads(thread_num) collapse(2)
     for (int32_t batch = 0; batch < batches; ++batch) {
         for (int32_t out_y = 0; out_y < output_height; ++out_y) {
             for (int32_t out_x = 0; out_x < output_width; ++out_x) {
@@ -106,6 +108,7 @@ static int shl_ref_conv2d_nchw_f32(struct csinn_tensor *input, struct csinn_tens
     struct csinn_pad_params pparams;
     pparams.base.layout = CSINN_LAYOUT_NCHW;
     pparams.base.api = CSINN_REF;
+    pparams.base.sess = NULL;
     pparams.pad_before = pad_b;
     pparams.pad_after = pad_a;
     pparams.pad_num = 4;
@@ -165,6 +168,8 @@ static int shl_ref_depthwise_conv2d_nhwc_f32(struct csinn_tensor *input,
     assert(input_depth * depth_multiplier ==
            output_depth);  // The input and output channels are equal for dw convolution
 
+    int thread_num = shl_ref_get_thread_num(&params->base);
+#pragma omp parallel for num_threads(thread_num) collapse(2)
     for (int32_t b = 0; b < batches; ++b) {
         for (int32_t out_y = 0; out_y < output_height; ++out_y) {
             for (int32_t out_x = 0; out_x < output_width; ++out_x) {
@@ -230,6 +235,8 @@ static int shl_ref_depthwise_conv2d_nchw_f32(struct csinn_tensor *input,
     assert(input_depth * depth_multiplier ==
            output_depth);  // The input and output channels are equal for dw convolution
 
+    int thread_num = shl_ref_get_thread_num(&params->base);
+#pragma omp parallel for num_threads(thread_num) collapse(2)
     for (int32_t b = 0; b < batches; ++b) {
         for (int32_t ic = 0; ic < input_depth; ++ic) {
             for (int32_t out_y = 0; out_y < output_height; ++out_y) {
@@ -347,10 +354,91 @@ static int shl_ref_group_conv2d_nchw_f32(struct csinn_tensor *o_input,
     return CSINN_TRUE;
 }
 
+/*
+ * structured sparse kernel, see shl_sparse_compress
+ * NCHW kernel: [out_c, in_c / group, kh, kw]   NHWC kernel: [out_c, kh, kw, in_c / group]
+ */
+static int shl_ref_conv2d_sparse_f32(struct csinn_tensor *input, struct csinn_tensor *output,
+                                     struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                     struct csinn_conv2d_params *params)
+{
+    float *input_data = input->data;
+    float *output_data = output->data;
+    float *kernel_data = kernel->data;
+    float *bias_data = bias->data;
+    uint8_t *index = shl_sparse_index(kernel);
+    const int keep = shl_sparse_keep(kernel->mtype);
+    const int groups = shl_sparse_groups(kernel);
+    const bool nhwc = params->base.layout == CSINN_LAYOUT_NHWC;
+
+    const int32_t batches = input->dim[0];
+    const int32_t in_c = nhwc ? input->dim[3] : input->dim[1];
+    const int32_t in_h = nhwc ? input->dim[1] : input->dim[2];
+    const int32_t in_w = nhwc ? input->dim[2] : input->dim[3];
+    const int32_t out_c = nhwc ? output->dim[3] : output->dim[1];
+    const int32_t out_h = nhwc ? output->dim[1] : output->dim[2];
+    const int32_t out_w = nhwc ? output->dim[2] : output->dim[3];
+    const int32_t kernel_h = nhwc ? kernel->dim[1] : kernel->dim[2];
+    const int32_t kernel_w = nhwc ? kernel->dim[2] : kernel->dim[3];
+    const int32_t in_cp = in_c / params->group;
+    const int32_t out_cp = out_c / params->group;
+
+    int thread_num = shl_ref_get_thread_num(&params->base);
+#pragma omp parallel for num_threads(thread_num) collapse(2)
+    for (int32_t b = 0; b < batches; b++) {
+        for (int32_t oc = 0; oc < out_c; oc++) {
+            const float *w = kernel_data + oc * groups * keep;
+            const uint8_t *idx = index + oc * groups;
+            const int32_t ic_base = oc / out_cp * in_cp;
+            for (int32_t oy = 0; oy < out_h; oy++) {
+                for (int32_t ox = 0; ox < out_w; ox++) {
+                    const int32_t iy0 = oy * params->stride_height - params->pad_top;
+                    const int32_t ix0 = ox * params->stride_width - params->pad_left;
+                    float acc = 0;
+                    for (int32_t g = 0; g < groups; g++) {
+                        for (int j = 0; j < keep; j++) {
+                            int32_t d = g * 4 + ((idx[g] >> (2 * j)) & 3);
+                            int32_t ic, ky, kx;
+                            if (nhwc) {
+                                ic = d % in_cp;
+                                kx = d / in_cp % kernel_w;
+                                ky = d / in_cp / kernel_w;
+                            } else {
+                                kx = d % kernel_w;
+                                ky = d / kernel_w % kernel_h;
+                                ic = d / kernel_w / kernel_h;
+                            }
+                            int32_t iy = iy0 + ky * params->dilation_height;
+                            int32_t ix = ix0 + kx * params->dilation_width;
+                            if (iy < 0 || iy >= in_h || ix < 0 || ix >= in_w) {
+                                continue;
+                            }
+                            int32_t in_index =
+                                nhwc ? shl_ref_get_index(input->dim, b, iy, ix, ic_base + ic)
+                                     : shl_ref_get_index(input->dim, b, ic_base + ic, iy, ix);
+                            acc += input_data[in_index] * w[g * keep + j];
+                        }
+                    }
+                    if (bias_data && bias->dim_count != 0) {
+                        acc += bias_data[oc];
+                    }
+                    int32_t out_index = nhwc ? shl_ref_get_index(output->dim, b, oy, ox, oc)
+                                             : shl_ref_get_index(output->dim, b, oc, oy, ox);
+                    output_data[out_index] = acc;
+                }
+            }
+        }
+    }
+    return CSINN_TRUE;
+}
+
 int shl_ref_conv2d_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                        struct csinn_tensor *kernel, struct csinn_tensor *bias,
                        struct csinn_conv2d_params *params)
 {
+    if (shl_sparse_keep(kernel->mtype)) {
+        return shl_ref_conv2d_sparse_f32(input, output, kernel, bias, params);
+    }
     if (params->base.layout == CSINN_LAYOUT_NHWC) {
         shl_ref_conv2d_nhwc_f32(input, output, kernel, bias, params);
     } else if (params->base.layout == CSINN_LAYOUT_NCHW) {
@@ -373,6 +461,9 @@ int shl_ref_conv2d_quant(struct csinn_tensor *input, struct csinn_tensor *output
 
         int k_len = kernel->dim[0];
         int k_inner = csinn_tensor_size(kernel) / k_len;
+        if (shl_sparse_keep(kernel->mtype)) {
+            k_inner = shl_sparse_groups(kernel) * shl_sparse_keep(kernel->mtype);
+        }
         float sp = input->qinfo->scale * input->qinfo->zero_point;
         for (int i = 0; i < k_len; i++) {
             float t_k = 0;
@@ -396,6 +487,13 @@ int shl_ref_depthwise_conv2d_f32(struct csinn_tensor *input, struct csinn_tensor
                                  struct csinn_tensor *kernel, struct csinn_tensor *bias,
                                  struct csinn_conv2d_params *params)
 {
+    if (shl_sparse_keep(kernel->mtype)) {
+        /* rows of the sparse kernel are output channels, the NHWC [1, kh, kw, c] has none */
+        if (params->base.layout != CSINN_LAYOUT_NCHW) {
+            return CSINN_UNSUPPORT_LAYOUT;
+        }
+        return shl_ref_conv2d_sparse_f32(input, output, kernel, bias, params);
+    }
     if (params->base.layout == CSINN_LAYOUT_NHWC) {
         shl_ref_depthwise_conv2d_nhwc_f32(input, output, kernel, bias, params);
     } else if (params->base.layout == CSINN_LAYOUT_NCHW) {
@@ -410,6 +508,13 @@ int shl_ref_depthwise_conv2d_quant(struct csinn_tensor *input, struct csinn_tens
                                    struct csinn_conv2d_params *params)
 {
     int ret;
+    if (shl_sparse_keep(kernel->mtype)) {
+        /* a NCHW depthwise kernel is a group conv kernel of one input channel per group */
+        if (params->base.layout != CSINN_LAYOUT_NCHW) {
+            return CSINN_UNSUPPORT_LAYOUT;
+        }
+        return shl_ref_group_conv2d_quant(input, output, kernel, bias, params);
+    }
     if (params->conv_extra.fuse_zp2bias) {
         struct csinn_tensor *tmp_bias = shl_ref_tensor_transform_f32(bias);
         struct csinn_tensor *tmp_kernel = shl_ref_tensor_transform_f32(kernel);
@@ -455,6 +560,9 @@ int shl_ref_group_conv2d_f32(struct csinn_tensor *input, struct csinn_tensor *ou
                              struct csinn_tensor *kernel, struct csinn_tensor *bias,
                              struct csinn_conv2d_params *params)
 {
+    if (shl_sparse_keep(kernel->mtype)) {
+        return shl_ref_conv2d_sparse_f32(input, output, kernel, bias, params);
+    }
     if (params->base.layout == CSINN_LAYOUT_NHWC) {
         shl_ref_group_conv2d_nhwc_f32(input, output, kernel, bias, params);
     } else if (params->base.layout == CSINN_LAYOUT_NCHW) {
@@ -477,6 +585,9 @@ int shl_ref_group_conv2d_quant(struct csinn_tensor *input, struct csinn_tensor *
 
         int k_len = kernel->dim[0];
         int k_inner = csinn_tensor_size(kernel) / k_len;
+        if (shl_sparse_keep(kernel->mtype)) {
+            k_inner = shl_sparse_groups(kernel) * shl_sparse_keep(kernel->mtype);
+        }
         float sp = input->qinfo->scale * input->qinfo->zero_point;
         for (int i = 0; i < k_len; i++) {
             float t_k = 0;
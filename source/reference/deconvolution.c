@@ -42,17 +42,20 @@ static int shl_ref_deconv2d_nhwc_f32(struct csinn_tensor *input, struct csinn_te
     int num_elements = csinn_tensor_size(output);
     memset(output_data, 0, num_elements * sizeof(float));
 
-    // Loop through input elements one at a time.
-    for (int batch = 0; batch < batches; ++batch) {
-        for (int in_y = 0; in_y < input_height; ++in_y) {
-            for (int in_x = 0; in_x < input_width; ++in_x) {
-                for (int in_channel = 0; in_channel < input_depth; ++in_channel) {
-                    // Loop through the output elements it will influence.
-                    const int out_x_origin = (in_x * params->stride_width) - params->pad_left;
-                    const int out_y_origin = (in_y * params->stride_height) - params->pad_top;
-                    for (int filter_y = 0; filter_y < filter_height; ++filter_y) {
-                        for (int filter_x = 0; filter_x < filter_width; ++filter_x) {
-                            for (int out_channel = 0; out_channel < output_depth; ++out_channel) {
+    int thread_num = shl_ref_get_thread_num(&params->base);
+    /* one thread per output channel, every output keeps its serial accumulation order */
+#pragma omp parallel for num_threads(thread_num)
+    for (int out_channel = 0; out_channel < output_depth; ++out_channel) {
+        // Loop through input elements one at a time.
+        for (int batch = 0; batch < batches; ++batch) {
+            for (int in_y = 0; in_y < input_height; ++in_y) {
+                for (int in_x = 0; in_x < input_width; ++in_x) {
+                    for (int in_channel = 0; in_channel < input_depth; ++in_channel) {
+                        // Loop through the output elements it will influence.
+                        const int out_x_origin = (in_x * params->stride_width) - params->pad_left;
+                        const int out_y_origin = (in_y * params->stride_height) - params->pad_top;
+                        for (int filter_y = 0; filter_y < filter_height; ++filter_y) {
+                            for (int filter_x = 0; filter_x < filter_width; ++filter_x) {
                                 // Compute output element location.
                                 const int out_x = out_x_origin + filter_x;
                                 const int out_y = out_y_origin + filter_y;
@@ -76,6 +79,7 @@ static int shl_ref_deconv2d_nhwc_f32(struct csinn_tensor *input, struct csinn_te
     }
 
     if (bias->dim_count != 0) {
+#pragma omp parallel for num_threads(thread_num) collapse(2)
         for (int batch = 0; batch < output_batch; batch++) {
             for (int o_y = 0; o_y < output_height; o_y++) {
                 for (int o_x = 0; o_x < output_width; o_x++) {
@@ -91,20 +95,62 @@ static int shl_ref_deconv2d_nhwc_f32(struct csinn_tensor *input, struct csinn_te
     return CSINN_TRUE;
 }
 
-static int shl_ref_deconv2d_nchw_f32(struct csinn_tensor *o_input, struct csinn_tensor *o_output,
-                                     struct csinn_tensor *o_kernel, struct csinn_tensor *o_bias,
+/*
+ * gemm + col2im, without any layout transform:
+ * col[out_c * kernel_h * kernel_w, in_h * in_w] = kernel[in_c, out_c * kernel_h * kernel_w]^T *
+ * input[in_c, in_h * in_w], then every column is added to the output window it covers.
+ */
+static int shl_ref_deconv2d_nchw_f32(struct csinn_tensor *input, struct csinn_tensor *output,
+                                     struct csinn_tensor *kernel, struct csinn_tensor *bias,
                                      struct csinn_conv2d_params *params)
 {
-    struct csinn_tensor *input = shl_ref_nchw_to_nhwc_f32(o_input);
-    struct csinn_tensor *output = shl_ref_nchw_to_nhwc_f32(o_output);
-    int32_t permute[4] = {1, 2, 3, 0};
-    struct csinn_tensor *kernel = shl_ref_deconv_kernel_nchw_to_nhwc_f32(o_kernel, permute);
-    struct csinn_tensor *bias = o_bias;
+    float *input_data = input->data;
+    float *output_data = output->data;
+    float *kernel_data = kernel->data;
+    float *bias_data = bias->data;
+    const int batches = input->dim[0];
+    const int in_c = input->dim[1];
+    const int in_h = input->dim[2];
+    const int in_w = input->dim[3];
+    const int out_c = output->dim[1];
+    const int out_h = output->dim[2];
+    const int out_w = output->dim[3];
+    const int kernel_h = kernel->dim[2];
+    const int kernel_w = kernel->dim[3];
 
-    shl_ref_deconv2d_nhwc_f32(input, output, kernel, bias, params);
+    const int m = out_c * kernel_h * kernel_w;
+    const int n = in_h * in_w;
+    float *col = shl_mem_alloc(m * n * sizeof(float));
 
-    shl_ref_nhwc_to_nchw_f32(o_output, output);
-    shl_ref_free_float_tensor(input);
+    int thread_num = shl_ref_get_thread_num(&params->base);
+    for (int b = 0; b < batches; b++) {
+#pragma omp parallel for num_threads(thread_num)
+        for (int i = 0; i < m; i++) {
+            float *col_ptr = col + i * n;
+            memset(col_ptr, 0, n * sizeof(float));
+            for (int ic = 0; ic < in_c; ic++) {
+                const float a = kernel_data[ic * m + i];
+                const float *in_ptr = input_data + ic * n;
+                for (int j = 0; j < n; j++) {
+                    col_ptr[j] += a * in_ptr[j];
+                }
+            }
+        }
+
+        for (int oc = 0; oc < out_c; oc++) {
+            float *out_ptr = output_data + oc * out_h * out_w;
+            float b_val = bias->dim_count != 0 ? bias_data[oc] : 0.0f;
+            for (int i = 0; i < out_h * out_w; i++) {
+                out_ptr[i] = b_val;
+            }
+        }
+        shl_ref_col2im_nchw_f32(col, output_data, out_c, out_h, out_w, in_h, in_w, kernel_h,
+                                kernel_w, params);
+
+        input_data += in_c * n;
+        output_data += out_c * out_h * out_w;
+    }
+    shl_mem_free(col);
     return CSINN_TRUE;
 }
 
@@ -130,11 +176,14 @@ int shl_ref_depthwise_deconv2d_nhwc_f32(struct csinn_tensor *input, struct csinn
     int num_elements = csinn_tensor_size(output);
     memset(output_data, 0, num_elements * sizeof(float));
 
-    // Loop through input elements one at a time.
-    for (int batch = 0; batch < batches; ++batch) {
-        for (int in_y = 0; in_y < input_height; ++in_y) {
-            for (int in_x = 0; in_x < input_width; ++in_x) {
-                for (int in_channel = 0; in_channel < input_depth; ++in_channel) {
+    int thread_num = shl_ref_get_thread_num(&params->base);
+    /* one thread per channel, every output keeps its serial accumulation order */
+#pragma omp parallel for num_threads(thread_num)
+    for (int in_channel = 0; in_channel < input_depth; ++in_channel) {
+        // Loop through input elements one at a time.
+        for (int batch = 0; batch < batches; ++batch) {
+            for (int in_y = 0; in_y < input_height; ++in_y) {
+                for (int in_x = 0; in_x < input_width; ++in_x) {
                     // Loop through the output elements it will influence.
                     const int out_x_origin = (in_x * params->stride_width) - params->pad_left;
                     const int out_y_origin = (in_y * params->stride_height) - params->pad_top;
@@ -161,6 +210,7 @@ int shl_ref_depthwise_deconv2d_nhwc_f32(struct csinn_tensor *input, struct csinn
         }
     }
     if (bias->dim_count != 0) {
+#pragma omp parallel for num_threads(thread_num) collapse(2)
         for (int batch = 0; batch < output_batch; batch++) {
             for (int o_y = 0; o_y < output_height; o_y++) {
                 for (int o_x = 0; o_x < output_width; o_x++) {
@@ -176,19 +226,58 @@ int shl_ref_depthwise_deconv2d_nhwc_f32(struct csinn_tensor *input, struct csinn
     return CSINN_TRUE;
 }
 
-int shl_ref_depthwise_deconv2d_nchw_f32(struct csinn_tensor *o_input, struct csinn_tensor *o_output,
-                                        struct csinn_tensor *o_kernel, struct csinn_tensor *o_bias,
+int shl_ref_depthwise_deconv2d_nchw_f32(struct csinn_tensor *input, struct csinn_tensor *output,
+                                        struct csinn_tensor *kernel, struct csinn_tensor *bias,
                                         struct csinn_conv2d_params *params)
 {
-    struct csinn_tensor *input = shl_ref_nchw_to_nhwc_f32(o_input);
-    struct csinn_tensor *output = shl_ref_nchw_to_nhwc_f32(o_output);
-    int32_t permute[4] = {1, 2, 3, 0};
-    struct csinn_tensor *kernel = shl_ref_deconv_kernel_nchw_to_nhwc_f32(o_kernel, permute);
-    struct csinn_tensor *bias = o_bias;
-    shl_ref_depthwise_deconv2d_nhwc_f32(input, output, kernel, bias, params);
-
-    shl_ref_nhwc_to_nchw_f32(o_output, output);
-    shl_ref_free_float_tensor(input);
+    float *input_data = input->data;
+    float *output_data = output->data;
+    float *kernel_data = kernel->data;
+    float *bias_data = bias->data;
+    const int batches = input->dim[0];
+    const int channels = input->dim[1];
+    const int in_h = input->dim[2];
+    const int in_w = input->dim[3];
+    const int out_h = output->dim[2];
+    const int out_w = output->dim[3];
+    const int kernel_h = kernel->dim[2];
+    const int kernel_w = kernel->dim[3];
+    const int maxk = kernel_h * kernel_w;
+
+    int thread_num = shl_ref_get_thread_num(&params->base);
+    for (int b = 0; b < batches; b++) {
+        /* a depthwise deconv is a col2im of the input scaled by every tap */
+#pragma omp parallel for num_threads(thread_num)
+        for (int c = 0; c < channels; c++) {
+            float *out_ptr = output_data + c * out_h * out_w;
+            const float *in_ptr = input_data + c * in_h * in_w;
+            float b_val = bias->dim_count != 0 ? bias_data[c] : 0.0f;
+            for (int i = 0; i < out_h * out_w; i++) {
+                out_ptr[i] = b_val;
+            }
+            for (int ky = 0; ky < kernel_h; ky++) {
+                for (int kx = 0; kx < kernel_w; kx++) {
+                    const float k_val = kernel_data[c * maxk + ky * kernel_w + kx];
+                    for (int y = 0; y < in_h; y++) {
+                        int oy = y * params->stride_height - params->pad_top +
+                                 ky * params->dilation_height;
+                        if (oy < 0 || oy >= out_h) {
+                            continue;
+                        }
+                        for (int x = 0; x < in_w; x++) {
+                            int ox = x * params->stride_width - params->pad_left +
+                                     kx * params->dilation_width;
+                            if (ox >= 0 && ox < out_w) {
+                                out_ptr[oy * out_w + ox] += k_val * in_ptr[y * in_w + x];
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        input_data += channels * in_h * in_w;
+        output_data += channels * out_h * out_w;
+    }
     return CSINN_TRUE;
 }
 
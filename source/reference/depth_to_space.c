@@ -81,6 +81,7 @@ int shl_ref_depth_to_space_nhwc_f32(struct csinn_tensor *input, struct csinn_ten
     pparams.permute_num = 4;
     pparams.base.layout = CSINN_LAYOUT_NCHW;
     pparams.base.api = CSINN_REF;
+    pparams.base.sess = NULL;
     pparams.base.name = params->base.name;
     pparams.permute = malloc(pparams.permute_num * sizeof(int32_t));
     pparams.permute[0] = 0;
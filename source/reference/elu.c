@@ -18,6 +18,7 @@
 
 /* CSI-NN2 version 2.0.x */
 
+#include "avx_mathfun.h"
 #include "shl_ref.h"
 
 static float elu(float x) { return x < 0.0 ? exp(x) - 1 : x; }
@@ -32,7 +33,16 @@ int shl_ref_elu_f32(struct csinn_tensor *input, struct csinn_tensor *output,
         size = size * input->dim[i];
     }
 
-    for (int i = 0; i < size; i++) {
+    int i = 0;
+#ifdef SHL_AVX_OPT
+    for (; i + 7 < size; i += 8) {
+        __m256 _x = _mm256_loadu_ps(input_data + i);
+        __m256 _neg = _mm256_sub_ps(exp256_ps(_x), _mm256_set1_ps(1.0f));
+        __m256 _mask = _mm256_cmp_ps(_x, _mm256_setzero_ps(), _CMP_LT_OQ);
+        _mm256_storeu_ps(output_data + i, _mm256_blendv_ps(_x, _neg, _mask));
+    }
+#endif
+    for (; i < size; i++) {
         output_data[i] = elu(input_data[i]);
     }
     return CSINN_TRUE;
@@ -43,3 +53,9 @@ int shl_ref_elu_quant(struct csinn_tensor *input, struct csinn_tensor *output,
 {
     return shl_ref_siso_callback_base(input, output, params, shl_ref_elu_f32);
 }
+
+int shl_ref_elu_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_relu_params *params)
+{
+    return shl_ref_siso_lut_init(input, output, params, shl_ref_elu_f32);
+}
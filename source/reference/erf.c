@@ -18,6 +18,7 @@
 
 /* CSI-NN2 version 2.0.x */
 
+#include "avx_mathfun.h"
 #include "shl_ref.h"
 
 int shl_ref_erf_f32(struct csinn_tensor *input, struct csinn_tensor *output,
@@ -30,7 +31,14 @@ int shl_ref_erf_f32(struct csinn_tensor *input, struct csinn_tensor *output,
         size = size * input->dim[i];
     }
 
-    for (int i = 0; i < size; i++) {
+    int i = 0;
+#ifdef SHL_AVX_OPT
+    for (; i + 7 < size; i += 8) {
+        __m256 _x = _mm256_loadu_ps(input_data + i);
+        _mm256_storeu_ps(output_data + i, erf256_ps(_x));
+    }
+#endif
+    for (; i < size; i++) {
         output_data[i] = erf(input_data[i]);
     }
     return CSINN_TRUE;
@@ -41,3 +49,9 @@ int shl_ref_erf_quant(struct csinn_tensor *input, struct csinn_tensor *output,
 {
     return shl_ref_siso_callback_base(input, output, params, shl_ref_erf_f32);
 }
+
+int shl_ref_erf_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_siso_params *params)
+{
+    return shl_ref_siso_lut_init(input, output, params, shl_ref_erf_f32);
+}
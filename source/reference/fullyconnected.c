@@ -20,10 +20,58 @@
 
 #include "shl_ref.h"
 
+static int shl_ref_fullyconnected_sparse_f32(struct csinn_tensor *input,
+                                             struct csinn_tensor *output,
+                                             struct csinn_tensor *weights,
+                                             struct csinn_tensor *bias,
+                                             struct csinn_fc_params *params)
+{
+    float *input_data = input->data;
+    float *output_data = output->data;
+    float *weights_data = weights->data;
+    float *bias_data = bias->data;
+    uint8_t *index = shl_sparse_index(weights);
+    const int keep = shl_sparse_keep(weights->mtype);
+    const int groups = shl_sparse_groups(weights);
+    const int output_dims_count = output->dim_count;
+    const int weights_dims_count = weights->dim_count;
+    int batches = 1;
+    /* compute the outer size */
+    for (int i = 0; i < output_dims_count - 1; i++) {
+        batches *= output->dim[i];
+    }
+    const int output_depth = weights->dim[weights_dims_count - 2];
+    const int accum_depth = weights->dim[weights_dims_count - 1];
+    int thread_num = shl_ref_get_thread_num(&params->base);
+#pragma omp parallel for num_threads(thread_num) collapse(2)
+    for (int b = 0; b < batches; ++b) {
+        for (int out_c = 0; out_c < output_depth; ++out_c) {
+            const float *in = input_data + b * accum_depth;
+            const float *w = weights_data + out_c * groups * keep;
+            const uint8_t *idx = index + out_c * groups;
+            float total = 0.f;
+            for (int g = 0; g < groups; g++) {
+                for (int j = 0; j < keep; j++) {
+                    total += in[g * 4 + ((idx[g] >> (2 * j)) & 3)] * w[g * keep + j];
+                }
+            }
+            float bias_value = 0.0f;
+            if (bias->dim_count != 0) {
+                bias_value = bias_data[out_c];
+            }
+            output_data[out_c + output_depth * b] = total + bias_value;
+        }
+    }
+    return CSINN_TRUE;
+}
+
 int shl_ref_fullyconnected_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                                struct csinn_tensor *weights, struct csinn_tensor *bias,
                                struct csinn_fc_params *params)
 {
+    if (shl_sparse_keep(weights->mtype)) {
+        return shl_ref_fullyconnected_sparse_f32(input, output, weights, bias, params);
+    }
     float *input_data = input->data;
     float *output_data = output->data;
     float *weights_data = weights->data;
@@ -37,6 +85,8 @@ int shl_ref_fullyconnected_f32(struct csinn_tensor *input, struct csinn_tensor *
     }
     const int output_depth = weights->dim[weights_dims_count - 2];
     const int accum_depth = weights->dim[weights_dims_count - 1];
+    int thread_num = shl_ref_get_thread_num(&params->base);
+#pragma omp parallel for num_threads(thread_num) collapse(2)
     for (int b = 0; b < batches; ++b) {
         for (int out_c = 0; out_c < output_depth; ++out_c) {
             float total = 0.f;
@@ -67,6 +117,9 @@ int shl_ref_fullyconnected_quant(struct csinn_tensor *input, struct csinn_tensor
 
         int k_len = weights->dim[0];
         int k_inner = csinn_tensor_size(weights) / k_len;
+        if (shl_sparse_keep(weights->mtype)) {
+            k_inner = shl_sparse_groups(weights) * shl_sparse_keep(weights->mtype);
+        }
         float sp = input->qinfo->scale * input->qinfo->zero_point;
         for (int i = 0; i < k_len; i++) {
             float t_k = 0;
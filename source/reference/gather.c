@@ -20,44 +20,55 @@
 
 #include "shl_ref.h"
 
-int shl_ref_gather_f32(struct csinn_tensor *input, struct csinn_tensor *indices,
-                       struct csinn_tensor *output, struct csinn_gather_params *params)
+/* out-of-range indices give a zero slice */
+static void gather_base(int8_t *input_data, int32_t *indices_data, int8_t *output_data,
+                        struct csinn_tensor *input, int indices_size, int axis, int elem_size,
+                        struct csinn_params_base *base)
 {
-    float *input_data = (float *)input->data;
-    float *output_data = (float *)output->data;
-    int32_t *indices_data = (int32_t *)indices->data;
-
-    int inner_size = 1;
-    for (int i = params->axis + 1; i < input->dim_count; i++) {
+    int64_t inner_size = 1;
+    for (int i = axis + 1; i < input->dim_count; i++) {
         inner_size *= input->dim[i];
     }
-    int outer_size = 1;
-    for (int i = 0; i < params->axis; i++) {
+    int64_t outer_size = 1;
+    for (int i = 0; i < axis; i++) {
         outer_size *= input->dim[i];
     }
-    int indices_size = 1;
-    for (int i = 0; i < indices->dim_count; i++) {
-        indices_size *= indices->dim[i];
-    }
+    int axis_dim = input->dim[axis];
+    int64_t slice = inner_size * elem_size;
 
-    for (int i = 0; i < outer_size; i++) {
+    int thread_num = shl_ref_get_thread_num(base);
+#pragma omp parallel for num_threads(thread_num) collapse(2)
+    for (int64_t i = 0; i < outer_size; i++) {
         for (int j = 0; j < indices_size; j++) {
-            if (indices_data[j] < input->dim[params->axis]) {
-                memcpy(output_data, input_data + indices_data[j] * inner_size,
-                       inner_size * sizeof(float));
+            int8_t *dst = output_data + (i * indices_size + j) * slice;
+            int32_t idx = indices_data[j];
+            if (idx < axis_dim) {
+                memcpy(dst, input_data + (i * axis_dim + idx) * slice, slice);
             } else {
-                memset(output_data, 0, inner_size * sizeof(float));
+                memset(dst, 0, slice);
             }
-            output_data += inner_size;
         }
-        input_data += inner_size * input->dim[params->axis];
     }
+}
+
+int shl_ref_gather_f32(struct csinn_tensor *input, struct csinn_tensor *indices,
+                       struct csinn_tensor *output, struct csinn_gather_params *params)
+{
+    gather_base(input->data, indices->data, output->data, input, csinn_tensor_size(indices),
+                params->axis, sizeof(float), &params->base);
     return CSINN_TRUE;
 }
 
 int shl_ref_gather_quant(struct csinn_tensor *input, struct csinn_tensor *indices,
                          struct csinn_tensor *output, struct csinn_gather_params *params)
 {
+    /* a gather only moves elements, with matching quantization the bytes are copied as is */
+    int elem_size = shl_ref_dtype_byte(input->dtype);
+    if (elem_size > 0 && shl_ref_same_quant(input, output)) {
+        gather_base(input->data, indices->data, output->data, input, csinn_tensor_size(indices),
+                    params->axis, elem_size, &params->base);
+        return CSINN_TRUE;
+    }
     int ret;
     struct csinn_tensor *finput = shl_ref_tensor_transform_f32(input);
     struct csinn_tensor *foutput = shl_ref_tensor_transform_f32(output);
@@ -65,4 +76,5 @@ int shl_ref_gather_quant(struct csinn_tensor *input, struct csinn_tensor *indice
     csinn_tensor_data_convert(output, foutput);
     shl_ref_tensor_transform_free_f32(finput);
     shl_ref_tensor_transform_free_f32(foutput);
+    return ret;
 }
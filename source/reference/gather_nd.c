@@ -20,77 +20,68 @@
 
 #include "shl_ref.h"
 
-static int Multiplication(int32_t *input, int s, int e)
+/*************************************************************
+ * indices [..., k]: every k-tuple picks the slice input[i0, ..., ik-1, :, ...],
+ * copied whole, a tuple out of range gives a zero slice
+ *************************************************************/
+static void gather_nd_base(int8_t *input_data, uint32_t *indices_data, int8_t *output_data,
+                           struct csinn_tensor *input, struct csinn_tensor *indices,
+                           int elem_size, struct csinn_params_base *base)
 {
-    int res = 1;
-    for (int i = s; i <= e; i++) {
-        res = res * input[i];
-    }
-    return res;
-}
-
-int shl_ref_gather_nd_f32(struct csinn_tensor *input, struct csinn_tensor *indices,
-                          struct csinn_tensor *output, struct csinn_gather_nd_params *params)
-{
-    float *input_data = (float *)input->data;
-    float *output_data = (float *)output->data;
-    uint32_t *indices_data = (uint32_t *)indices->data;
-
-    int in_size = 1, indices_size = 1;
-    for (int i = 0; i < input->dim_count; i++) {
-        in_size *= input->dim[i];
-    }
-    for (int i = 0; i < indices->dim_count; i++) {
-        indices_size *= indices->dim[i];
-    }
-
-    // indices.shape[-1] must be <= params.rank
     int indices_last_dim = indices->dim[indices->dim_count - 1];
-    int axis = indices_last_dim - 1;
-
-    int indices_outer_size = 1;
-    indices_outer_size = indices_size / indices_last_dim;
+    int64_t indices_outer_size = csinn_tensor_size(indices) / indices_last_dim;
 
-    int input_outer_size = 1;
-    for (int i = 0; i < axis; i++) {
-        input_outer_size *= input->dim[i];
+    int64_t slice_size = 1;
+    for (int i = indices_last_dim; i < input->dim_count; i++) {
+        slice_size *= input->dim[i];
     }
-    int input_inner_size = 1;
-    for (int i = axis + 1; i < input->dim_count; i++) {
-        input_inner_size *= input->dim[i];
+    /* slice stride of every indexed axis */
+    int64_t axis_stride[MAX_DIM];
+    int64_t stride = 1;
+    for (int j = indices_last_dim - 1; j >= 0; j--) {
+        axis_stride[j] = stride;
+        stride *= input->dim[j];
     }
+    int64_t slice = slice_size * elem_size;
 
-    float *in_copy_addr = NULL;
-    int dim_over_flag = 0;
-    for (int i = 0; i < indices_outer_size; i++) {
-        int input_outer_idx = 0;
+    int thread_num = shl_ref_get_thread_num(base);
+#pragma omp parallel for num_threads(thread_num)
+    for (int64_t i = 0; i < indices_outer_size; i++) {
+        uint32_t *tuple = indices_data + i * indices_last_dim;
+        int64_t input_outer_idx = 0;
+        bool in_range = true;
         for (int j = 0; j < indices_last_dim; j++) {
-            int indices_val = indices_data[i * indices_last_dim + j];
-            if (indices_val >= input->dim[j]) {
-                dim_over_flag = 1;
+            if (tuple[j] >= input->dim[j]) {
+                in_range = false;
                 break;
-            } else {
-                input_outer_idx +=
-                    indices_val * Multiplication(input->dim, j + 1, indices_last_dim - 1);
             }
+            input_outer_idx += tuple[j] * axis_stride[j];
         }
-        if (dim_over_flag == 1) {
-            dim_over_flag = 0;
-            for (int n = 0; n < input_inner_size; n++) {
-                *(output_data + n) = 0.0f;
-            }
+        if (in_range) {
+            memcpy(output_data + i * slice, input_data + input_outer_idx * slice, slice);
         } else {
-            in_copy_addr = input_data + input_outer_idx * input_inner_size;
-            memcpy(output_data, in_copy_addr, input_inner_size * sizeof(float));
+            memset(output_data + i * slice, 0, slice);
         }
-        output_data += input_inner_size;
     }
+}
+
+int shl_ref_gather_nd_f32(struct csinn_tensor *input, struct csinn_tensor *indices,
+                          struct csinn_tensor *output, struct csinn_gather_nd_params *params)
+{
+    gather_nd_base(input->data, indices->data, output->data, input, indices, sizeof(float),
+                   &params->base);
     return CSINN_TRUE;
 }
 
 int shl_ref_gather_nd_quant(struct csinn_tensor *input, struct csinn_tensor *indices,
                             struct csinn_tensor *output, struct csinn_gather_nd_params *params)
 {
+    int elem_size = shl_ref_dtype_byte(input->dtype);
+    if (elem_size > 0 && shl_ref_same_quant(input, output)) {
+        gather_nd_base(input->data, indices->data, output->data, input, indices, elem_size,
+                       &params->base);
+        return CSINN_TRUE;
+    }
     int ret;
     struct csinn_tensor *finput = shl_ref_tensor_transform_f32(input);
     struct csinn_tensor *foutput = shl_ref_tensor_transform_f32(output);
@@ -46,3 +46,9 @@ int shl_ref_hard_sigmoid_quant(struct csinn_tensor *input, struct csinn_tensor *
 {
     return shl_ref_siso_callback_base(input, output, params, shl_ref_hard_sigmoid_f32);
 }
+
+int shl_ref_hard_sigmoid_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                              struct csinn_sigmoid_params *params)
+{
+    return shl_ref_siso_lut_init(input, output, params, shl_ref_hard_sigmoid_f32);
+}
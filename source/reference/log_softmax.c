@@ -20,46 +20,57 @@
 
 #include "shl_ref.h"
 
-/* logsoftmax = logits - log(reduce_sum(exp(logits), axis)) */
+/* logsoftmax = logits - max - log(reduce_sum(exp(logits - max), axis)) */
 int shl_ref_log_softmax_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                             struct csinn_softmax_params *params)
 {
-    // now only support 2D input
-    assert(params->axis == 1 && input->dim_count == 2);
     float *input_data = (float *)input->data;
     float *output_data = (float *)output->data;
 
-    int in_size = 1, out_size = 1;
-    for (int i = 0; i < input->dim_count; i++) {
-        in_size *= input->dim[i];
+    int axis = params->axis;
+    int64_t outer_size = 1;
+    for (int i = 0; i < axis; i++) {
+        outer_size *= input->dim[i];
     }
-    out_size = in_size;
-    int input_outer_size = 1;
-    for (int i = 0; i < params->axis; i++) {
-        input_outer_size *= input->dim[i];
+
+    int64_t inner_size = 1;
+    for (int i = axis + 1; i < input->dim_count; i++) {
+        inner_size *= input->dim[i];
     }
-    int input_inner_size = 1;
-    for (int i = params->axis + 1; i < input->dim_count; i++) {
-        input_inner_size *= input->dim[i];
+
+    int cnt = input->dim[axis];
+
+    int thread_num = shl_ref_get_thread_num(&params->base);
+    if (inner_size == 1) {
+#pragma omp parallel for num_threads(thread_num)
+        for (int i = 0; i < outer_size; i++) {
+            float *in_ptr = input_data + i * cnt;
+            float *out_ptr = output_data + i * cnt;
+            float max = shl_ref_softmax_row_max(in_ptr, cnt);
+            float acc_exp = shl_ref_softmax_row_exp_sum(in_ptr, NULL, cnt, max);
+            shl_ref_softmax_row_affine(in_ptr, out_ptr, cnt, 1.0f, -max - log(acc_exp));
+        }
+        return CSINN_TRUE;
     }
-    int axis_dim = input->dim[params->axis];
 
-    for (int i = 0; i < input_outer_size; i++) {
-        for (int k = 0; k < input_inner_size; k++) {
-            float acc = 0.0f;
-            float input_val = 0.0f;
-            for (int j = 0; j < axis_dim; j++) {
-                input_val = *(input_data + j * input_inner_size + k);
-                acc += exp(input_val);
+#pragma omp parallel for num_threads(thread_num) collapse(2)
+    for (int i = 0; i < outer_size; i++) {
+        for (int k = 0; k < inner_size; k++) {
+            float *in_ptr = input_data + i * inner_size * cnt + k;
+            float *out_ptr = output_data + i * inner_size * cnt + k;
+            float acc_exp = 0.0f;
+            float max = -FLT_MAX;
+            for (int j = 0; j < cnt; j++) {
+                max = fmax(max, *(in_ptr + j * inner_size));
+            }
+            for (int j = 0; j < cnt; j++) {
+                acc_exp += exp(*(in_ptr + j * inner_size) - max);
             }
-            acc = log(acc);
-            for (int j = 0; j < axis_dim; j++) {
-                *(output_data + j * input_inner_size + k) =
-                    *(input_data + j * input_inner_size + k) - acc;
+            float bias = -max - log(acc_exp);
+            for (int j = 0; j < cnt; j++) {
+                *(out_ptr + j * inner_size) = *(in_ptr + j * inner_size) + bias;
             }
         }
-        input_data += input_inner_size * axis_dim;
-        output_data += input_inner_size * axis_dim;
     }
     return CSINN_TRUE;
 }
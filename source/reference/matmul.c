@@ -40,8 +40,10 @@ int shl_ref_matmul_f32(struct csinn_tensor *mat0, struct csinn_tensor *mat1,
     const int mat0_offset = dim_i * dim_k;
     const int mat1_offset = dim_k * dim_j;
     const int out_offset = dim_i * dim_j;
+    int thread_num = shl_ref_get_thread_num(&params->base);
 
     if (!params->trans_a && !params->trans_b) {
+#pragma omp parallel for num_threads(thread_num) collapse(2)
         for (int b = 0; b < batches; ++b) {
             for (int i = 0; i < dim_i; ++i) {
                 for (int j = 0; j < dim_j; ++j) {
@@ -56,6 +58,7 @@ int shl_ref_matmul_f32(struct csinn_tensor *mat0, struct csinn_tensor *mat1,
             }
         }
     } else if (!params->trans_a && params->trans_b) {
+#pragma omp parallel for num_threads(thread_num) collapse(2)
         for (int b = 0; b < batches; ++b) {
             for (int i = 0; i < dim_i; ++i) {
                 for (int j = 0; j < dim_j; ++j) {
@@ -70,6 +73,7 @@ int shl_ref_matmul_f32(struct csinn_tensor *mat0, struct csinn_tensor *mat1,
             }
         }
     } else if (params->trans_a && !params->trans_b) {
+#pragma omp parallel for num_threads(thread_num) collapse(2)
         for (int b = 0; b < batches; ++b) {
             for (int i = 0; i < dim_i; ++i) {
                 for (int j = 0; j < dim_j; ++j) {
@@ -84,6 +88,7 @@ int shl_ref_matmul_f32(struct csinn_tensor *mat0, struct csinn_tensor *mat1,
             }
         }
     } else {
+#pragma omp parallel for num_threads(thread_num) collapse(2)
         for (int b = 0; b < batches; ++b) {
             for (int i = 0; i < dim_i; ++i) {
                 for (int j = 0; j < dim_j; ++j) {
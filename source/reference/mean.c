@@ -23,34 +23,10 @@
 int shl_ref_mean_stride_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                             struct csinn_reduce_params *params)
 {
-    float *input_data = input->data;
-    float *output_data = output->data;
-
-    int32_t inner_size = 1;
-    int32_t out_size = 1;
-
-    for (int32_t k = 0; k < params->n; k++) {
-        out_size *= params->out_extents[k];
-    }
-
-    for (int32_t k = 0; k < params->m; k++) {
-        inner_size *= params->inner_extents[k];
-    }
-
-    for (int32_t out = 0; out < out_size; out++) {
-        float result = 0;
-        int32_t out_index =
-            shl_ref_get_reduction_index(out, params->out_strides, params->out_extents, params->n);
-        for (int32_t inner = 0; inner < inner_size; inner++) {
-            int32_t index =
-                out_index + shl_ref_get_reduction_index(inner, params->inner_strides,
-                                                        params->inner_extents, params->m);
-            float val = input_data[index];
-            result += val;
-        }
-
-        output_data[out] = result / inner_size;
-    }
+    shl_ref_reduce_stride_f32(input->data, output->data, params->out_extents,
+                              params->out_strides, params->n, params->inner_extents,
+                              params->inner_strides, params->m, SHL_REF_REDUCE_MEAN,
+                              &params->base);
     return CSINN_TRUE;
 }
 
@@ -70,6 +46,7 @@ int shl_ref_mean_quant(struct csinn_tensor *input, struct csinn_tensor *output,
     struct csinn_pool_params pparams;
     pparams.base.layout = CSINN_LAYOUT_NCHW;
     pparams.base.api = CSINN_REF;
+    pparams.base.sess = NULL;
     csinn_global_avgpool2d_init(input, output, &pparams);
     csinn_global_avgpool2d(input, output, &pparams);
     return CSINN_TRUE;
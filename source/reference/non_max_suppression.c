@@ -19,78 +19,199 @@
 /* CSI-NN2 version 2.0.x */
 
 #include "shl_ref.h"
+#ifdef SHL_AVX_OPT
+#include <immintrin.h>
+#endif
 
-static int find_max_score_idx(const float *scores, int *flag, int len)
+struct nms_candidate {
+    float score;
+    int32_t index;
+};
+
+/* descending score, ties by ascending index */
+static int nms_candidate_cmp(const void *a, const void *b)
+{
+    const struct nms_candidate *ca = a;
+    const struct nms_candidate *cb = b;
+    if (ca->score != cb->score) {
+        return ca->score < cb->score ? 1 : -1;
+    }
+    return ca->index - cb->index;
+}
+
+/*************************************************************
+ * selected: the boxes kept so far, as five planes of stride cap,
+ * y1 | x1 | y2 | x2 | area, box = [y1, x1, y2, x2]
+ * iou > threshold is tested as inter > threshold * union, no division,
+ * and a block is reduced without early exit so the loop vectorises
+ *************************************************************/
+int shl_ref_nms_overlap_f32(const float *box, const float *selected, int cap, int selected_num,
+                            float iou_threshold)
 {
-    int res = 0;
-    float max = FLT_MIN;
-    for (int i = 0; i < len; i++) {
-        if (scores[i] > max && !flag[i]) {
-            max = scores[i];
-            res = i;
+    const float *sy1 = selected;
+    const float *sx1 = selected + cap;
+    const float *sy2 = selected + cap * 2;
+    const float *sx2 = selected + cap * 3;
+    const float *sarea = selected + cap * 4;
+    float area = (box[2] - box[0]) * (box[3] - box[1]);
+
+    int i = 0;
+#ifdef SHL_AVX_OPT
+    __m256 _by1 = _mm256_set1_ps(box[0]);
+    __m256 _bx1 = _mm256_set1_ps(box[1]);
+    __m256 _by2 = _mm256_set1_ps(box[2]);
+    __m256 _bx2 = _mm256_set1_ps(box[3]);
+    __m256 _area = _mm256_set1_ps(area);
+    __m256 _thresh = _mm256_set1_ps(iou_threshold);
+    __m256 _zero = _mm256_setzero_ps();
+    for (; i + 7 < selected_num; i += 8) {
+        __m256 _h = _mm256_sub_ps(_mm256_min_ps(_by2, _mm256_loadu_ps(sy2 + i)),
+                                  _mm256_max_ps(_by1, _mm256_loadu_ps(sy1 + i)));
+        __m256 _w = _mm256_sub_ps(_mm256_min_ps(_bx2, _mm256_loadu_ps(sx2 + i)),
+                                  _mm256_max_ps(_bx1, _mm256_loadu_ps(sx1 + i)));
+        __m256 _inter = _mm256_mul_ps(_mm256_max_ps(_h, _zero), _mm256_max_ps(_w, _zero));
+        __m256 _union = _mm256_sub_ps(_mm256_add_ps(_area, _mm256_loadu_ps(sarea + i)), _inter);
+        __m256 _hit = _mm256_cmp_ps(_inter, _mm256_mul_ps(_thresh, _union), _CMP_GT_OQ);
+        if (_mm256_movemask_ps(_hit)) {
+            return 1;
+        }
+    }
+#endif
+    for (; i < selected_num; i += 64) {
+        int end = i + 64 < selected_num ? i + 64 : selected_num;
+        int hit = 0;
+        for (int j = i; j < end; j++) {
+            float ih = fminf(box[2], sy2[j]) - fmaxf(box[0], sy1[j]);
+            float iw = fminf(box[3], sx2[j]) - fmaxf(box[1], sx1[j]);
+            float inter = fmaxf(ih, 0.0f) * fmaxf(iw, 0.0f);
+            hit |= inter > iou_threshold * (area + sarea[j] - inter);
+        }
+        if (hit) {
+            return 1;
         }
     }
-    return res;
+    return 0;
 }
 
-// box =  [y1, x1, y2, x2]
-static float get_iou(const float *box1, const float *box2)
+/*************************************************************
+ * greedy NMS of one set of boxes: candidates above score_threshold are sorted once,
+ * each is kept when it overlaps no box kept before it
+ * returns the number of indices written to indices
+ *************************************************************/
+static int nms_one_class(const float *boxes, const float *scores, int box_num,
+                         struct csinn_non_max_suppression_params *params, int32_t *indices,
+                         struct nms_candidate *cand, float *selected, void *overlap_cb)
 {
-    // determine the (x, y)-coordinates of the intersection rectangle
-    float x1 = fmax(box1[0], box2[0]);
-    float y1 = fmax(box1[1], box2[1]);
-    float x2 = fmin(box1[2], box2[2]);
-    float y2 = fmin(box1[3], box2[3]);
-    // compute the area of intersection rectangle
-    float inter_area = fmax(0, x2 - x1) * fmax(0, y2 - y1);
-    // compute the area of both the prediction and ground-truth rectangles
-    float box1_area = (box1[2] - box1[0]) * (box1[3] - box1[1]);
-    float box2_area = (box2[2] - box2[0]) * (box2[3] - box2[1]);
-    ;
-    // compute the intersection over union by taking the intersection area and
-    // dividing it by the sum of prediction + ground-truth areas - the interesection area
-    float iou = inter_area / (box1_area + box2_area - inter_area);
-    return iou;
+    int (*overlap)(const float *, const float *, int, int, float) = overlap_cb;
+    int max_output_size = params->max_output_size;
+    int cap = max_output_size > 0 && max_output_size < box_num ? max_output_size : box_num;
+
+    int cand_num = 0;
+    for (int i = 0; i < box_num; i++) {
+        if (scores[i] > params->score_threshold) {
+            cand[cand_num].score = scores[i];
+            cand[cand_num].index = i;
+            cand_num++;
+        }
+    }
+    qsort(cand, cand_num, sizeof(struct nms_candidate), nms_candidate_cmp);
+
+    int selected_num = 0;
+    for (int i = 0; i < cand_num && selected_num < cap; i++) {
+        const float *box = boxes + 4 * cand[i].index;
+        if (overlap(box, selected, cap, selected_num, params->iou_threshold)) {
+            continue;
+        }
+        selected[selected_num] = box[0];
+        selected[cap + selected_num] = box[1];
+        selected[cap * 2 + selected_num] = box[2];
+        selected[cap * 3 + selected_num] = box[3];
+        selected[cap * 4 + selected_num] = (box[2] - box[0]) * (box[3] - box[1]);
+        indices[selected_num] = cand[i].index;
+        selected_num++;
+    }
+    return selected_num;
 }
 
-int shl_ref_non_max_suppression_std(struct csinn_tensor *input0, struct csinn_tensor *input1,
-                                    struct csinn_tensor *output,
-                                    struct csinn_non_max_suppression_params *params)
+/*************************************************************
+ * boxes [box_num, 4], scores [box_num]: output the kept box indices
+ * boxes [batch, box_num, 4], scores [batch, class, box_num]: every (batch, class) is
+ * suppressed on its own, output [n, 3] rows of (batch, class, box index) packed in order,
+ * unused rows set to -1
+ * overlap_cb: shl_ref_nms_overlap_f32 or a vector version of it
+ *************************************************************/
+int shl_ref_non_max_suppression_base(struct csinn_tensor *input0, struct csinn_tensor *input1,
+                                     struct csinn_tensor *output,
+                                     struct csinn_non_max_suppression_params *params,
+                                     void *overlap_cb)
 {
     float *boxes = (float *)input0->data;
     float *scores = (float *)input1->data;
-    int *indices = (int *)output->data;
+    int32_t *indices = (int32_t *)output->data;
 
-    float iou_threshold = params->iou_threshold;
+    bool batched = input1->dim_count == 3;
+    int batch = batched ? input1->dim[0] : 1;
+    int class_num = batched ? input1->dim[1] : 1;
+    int box_num = batched ? input1->dim[2] : input1->dim[0];
     int max_output_size = params->max_output_size;
+    int cap = max_output_size > 0 && max_output_size < box_num ? max_output_size : box_num;
+    int task_num = batch * class_num;
+
+    if (!batched) {
+        struct nms_candidate *cand = shl_mem_alloc(box_num * sizeof(struct nms_candidate));
+        float *selected = shl_mem_alloc(cap * 5 * sizeof(float));
+        nms_one_class(boxes, scores, box_num, params, indices, cand, selected, overlap_cb);
+        shl_mem_free(cand);
+        shl_mem_free(selected);
+        return CSINN_TRUE;
+    }
 
-    int box_num = input1->dim[0];
-    int box_num_exist = box_num;
+    int thread_num = shl_ref_get_thread_num(&params->base);
+    struct nms_candidate *cand =
+        shl_mem_alloc((int64_t)thread_num * box_num * sizeof(struct nms_candidate));
+    float *selected = shl_mem_alloc((int64_t)thread_num * cap * 5 * sizeof(float));
+    int32_t *task_indices = shl_mem_alloc((int64_t)task_num * cap * sizeof(int32_t));
+    int32_t *task_count = shl_mem_alloc(task_num * sizeof(int32_t));
 
-    int *flag = (int *)shl_mem_alloc(box_num * sizeof(int));
+#pragma omp parallel for num_threads(thread_num)
+    for (int t = 0; t < task_num; t++) {
+        int tid = 0;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+#endif
+        int b = t / class_num;
+        task_count[t] = nms_one_class(boxes + (int64_t)b * box_num * 4,
+                                      scores + (int64_t)t * box_num, box_num, params,
+                                      task_indices + (int64_t)t * cap, cand + tid * box_num,
+                                      selected + tid * cap * 5, overlap_cb);
+    }
 
-    int box_cnt = 0;
-    while (box_num_exist) {
-        int max_box_idx = find_max_score_idx(scores, flag, box_num);
-        flag[max_box_idx] = 1;
-        box_num_exist--;
-        *indices++ = max_box_idx;
-        box_cnt++;
-        if (box_cnt == max_output_size) {
-            break;
-        }
-        for (int i = 0; i < box_num; i++) {
-            if (!flag[i]) {
-                float *box1_addr = boxes + 4 * max_box_idx;
-                float *box2_addr = boxes + 4 * i;
-                float iou = get_iou(box1_addr, box2_addr);
-                if (iou > iou_threshold) {
-                    flag[i] = 1;
-                    box_num_exist--;
-                }
-            }
+    int out_rows = csinn_tensor_size(output) / 3;
+    int row = 0;
+    for (int t = 0; t < task_num; t++) {
+        for (int i = 0; i < task_count[t] && row < out_rows; i++, row++) {
+            indices[row * 3] = t / class_num;
+            indices[row * 3 + 1] = t % class_num;
+            indices[row * 3 + 2] = task_indices[t * cap + i];
         }
     }
-    shl_mem_free(flag);
+    for (; row < out_rows; row++) {
+        indices[row * 3] = -1;
+        indices[row * 3 + 1] = -1;
+        indices[row * 3 + 2] = -1;
+    }
+
+    shl_mem_free(cand);
+    shl_mem_free(selected);
+    shl_mem_free(task_indices);
+    shl_mem_free(task_count);
     return CSINN_TRUE;
 }
+
+int shl_ref_non_max_suppression_std(struct csinn_tensor *input0, struct csinn_tensor *input1,
+                                    struct csinn_tensor *output,
+                                    struct csinn_non_max_suppression_params *params)
+{
+    return shl_ref_non_max_suppression_base(input0, input1, output, params,
+                                            shl_ref_nms_overlap_f32);
+}
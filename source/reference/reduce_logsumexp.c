@@ -32,35 +32,11 @@ int shl_ref_reduce_logsumexp_f32(struct csinn_tensor *input, struct csinn_tensor
         for (int i = 0; i < input->dim_count; i++) {
             size = size * input->dim[i];
         }
-        float res = exp(*input_data);
-        for (int j = 1; j < size; j++) {
-            res = res + exp(input_data[j]);
-        }
+        float res = shl_ref_sum_all_f32(input_data, size, true, &params->base);
         *output_data = log(res);
     } else {
-        int axis = *(params->axis);
-        int64_t outer_size = 1;
-        for (int i = 0; i < axis; i++) {
-            outer_size *= input->dim[i];
-        }
-        int64_t inner_size = 1;
-        for (int i = axis + 1; i < input->dim_count; i++) {
-            inner_size *= input->dim[i];
-        }
-        int cnt = input->dim[axis];
-
-        for (int i = 0; i < outer_size; i++) {
-            for (int k = 0; k < inner_size; k++) {
-                float temp = 0.0f;
-                for (int j = 0; j < cnt; j++) {
-                    float input_val = *(input_data + j * inner_size + k);
-                    temp += exp(input_val);
-                }
-                *(output_data + k) = log(temp);
-            }
-            input_data += inner_size * cnt;
-            output_data += inner_size;
-        }
+        shl_ref_reduce_axis_f32(input_data, output_data, input->dim, input->dim_count,
+                                *(params->axis), SHL_REF_REDUCE_LOGSUMEXP, &params->base);
     }
     return CSINN_TRUE;
 }
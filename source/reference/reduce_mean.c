@@ -32,34 +32,11 @@ int shl_ref_reduce_mean_f32(struct csinn_tensor *input, struct csinn_tensor *out
         for (int i = 0; i < input->dim_count; i++) {
             size = size * input->dim[i];
         }
-        float res = 0.0f;
-        for (int j = 0; j < size; j++) {
-            res = res + input_data[j];
-        }
+        float res = shl_ref_sum_all_f32(input_data, size, false, &params->base);
         *output_data = res / size;
     } else {
-        int axis = *(params->axis);
-        int64_t outer_size = 1;
-        for (int i = 0; i < axis; i++) {
-            outer_size *= input->dim[i];
-        }
-        int64_t inner_size = 1;
-        for (int i = axis + 1; i < input->dim_count; i++) {
-            inner_size *= input->dim[i];
-        }
-        int cnt = input->dim[axis];
-
-        for (int i = 0; i < outer_size; i++) {
-            for (int k = 0; k < inner_size; k++) {
-                float temp = 0.0f;
-                for (int j = 0; j < cnt; j++) {
-                    temp += *(input_data + j * inner_size + k);
-                }
-                *(output_data + k) = temp / cnt;
-            }
-            input_data += inner_size * cnt;
-            output_data += inner_size;
-        }
+        shl_ref_reduce_axis_f32(input_data, output_data, input->dim, input->dim_count,
+                                *(params->axis), SHL_REF_REDUCE_MEAN, &params->base);
     }
     return CSINN_TRUE;
 }
@@ -33,33 +33,16 @@ int shl_ref_reduce_min_f32(struct csinn_tensor *input, struct csinn_tensor *outp
             size = size * input->dim[i];
         }
         float res = *input_data;
+        int thread_num = shl_ref_get_thread_num(&params->base);
+        /* min is order independent, no need for the chunked sum */
+#pragma omp parallel for num_threads(thread_num) reduction(min : res)
         for (int j = 1; j < size; j++) {
             res = fmin(res, input_data[j]);
         }
         *output_data = res;
     } else {
-        int axis = *(params->axis);
-        int64_t outer_size = 1;
-        for (int i = 0; i < axis; i++) {
-            outer_size *= input->dim[i];
-        }
-        int64_t inner_size = 1;
-        for (int i = axis + 1; i < input->dim_count; i++) {
-            inner_size *= input->dim[i];
-        }
-        int cnt = input->dim[axis];
-
-        for (int i = 0; i < outer_size; i++) {
-            for (int k = 0; k < inner_size; k++) {
-                float temp = *(input_data + k);
-                for (int j = 1; j < cnt; j++) {
-                    temp = fmin(temp, *(input_data + j * inner_size + k));
-                }
-                *(output_data + k) = temp;
-            }
-            input_data += inner_size * cnt;
-            output_data += inner_size;
-        }
+        shl_ref_reduce_axis_f32(input_data, output_data, input->dim, input->dim_count,
+                                *(params->axis), SHL_REF_REDUCE_MIN, &params->base);
     }
     return CSINN_TRUE;
 }
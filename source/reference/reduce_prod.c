@@ -38,28 +38,8 @@ int shl_ref_reduce_prod_f32(struct csinn_tensor *input, struct csinn_tensor *out
         }
         *output_data = res;
     } else {
-        int axis = *(params->axis);
-        int64_t outer_size = 1;
-        for (int i = 0; i < axis; i++) {
-            outer_size *= input->dim[i];
-        }
-        int64_t inner_size = 1;
-        for (int i = axis + 1; i < input->dim_count; i++) {
-            inner_size *= input->dim[i];
-        }
-        int cnt = input->dim[axis];
-
-        for (int i = 0; i < outer_size; i++) {
-            for (int k = 0; k < inner_size; k++) {
-                float temp = 1.0f;
-                for (int j = 0; j < cnt; j++) {
-                    temp *= *(input_data + j * inner_size + k);
-                }
-                *(output_data + k) = temp;
-            }
-            input_data += inner_size * cnt;
-            output_data += inner_size;
-        }
+        shl_ref_reduce_axis_f32(input_data, output_data, input->dim, input->dim_count,
+                                *(params->axis), SHL_REF_REDUCE_PROD, &params->base);
     }
     return CSINN_TRUE;
 }
@@ -43,3 +43,9 @@ int shl_ref_relu6_quant(struct csinn_tensor *input, struct csinn_tensor *output,
 {
     return shl_ref_siso_callback_base(input, output, params, shl_ref_relu6_f32);
 }
+
+int shl_ref_relu6_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                       struct csinn_relu_params *params)
+{
+    return shl_ref_siso_lut_init(input, output, params, shl_ref_relu6_f32);
+}
@@ -19,62 +19,175 @@
 /* CSI-NN2 version 2.0.x */
 
 #include "shl_ref.h"
+#ifdef SHL_AVX_OPT
+#include <immintrin.h>
+#endif
 
-static void shl_ref_resize_bilinear_nhwc_f32(struct csinn_tensor *input,
-                                             struct csinn_tensor *output, bool align_corners)
+static float resize_scale(int32_t in_size, int32_t out_size, bool align_corners)
 {
-    float *input_data = input->data;
-    float *output_data = output->data;
-    int32_t batches = input->dim[0];
-    int32_t input_height = input->dim[1];
-    int32_t input_width = input->dim[2];
-    int32_t depth = input->dim[3];
+    if (align_corners) {
+        return out_size > 1 ? (float)(in_size - 1) / (out_size - 1) : 0.0f;
+    }
+    return (float)in_size / out_size;
+}
 
-    int32_t output_height = output->dim[1];
-    int32_t output_width = output->dim[2];
+/*reference
+ * https://github.com/tensorflow/tensorflow/blob/master/tensorflow/lite/kernels/internal/reference/resize_nearest_neighbor.h
+ */
+void shl_ref_resize_nearest_table(int32_t in_size, int32_t out_size, bool align_corners,
+                                  int32_t *ofs)
+{
+    float scale = resize_scale(in_size, out_size, align_corners);
+    for (int i = 0; i < out_size; i++) {
+        int32_t src = align_corners ? (int32_t)(round(i * scale)) : (int32_t)(floor(i * scale));
+        ofs[i] = shl_ref_min_internal_s32(src, in_size - 1);
+    }
+}
 
-    float height_scale = 0;
-    float width_scale = 0;
+/* two taps per output: ofs[2 * i + j], weights alpha[2 * i + j] */
+void shl_ref_resize_linear_table(int32_t in_size, int32_t out_size, bool align_corners,
+                                 int32_t *ofs, float *alpha)
+{
+    float scale = resize_scale(in_size, out_size, align_corners);
+    for (int i = 0; i < out_size; i++) {
+        float src = i * scale;
+        int32_t i0 = (int32_t)(floor(src));
+        float frac = src - i0;
+        ofs[2 * i] = i0;
+        ofs[2 * i + 1] = shl_ref_min_internal_s32(i0 + 1, in_size - 1);
+        alpha[2 * i] = 1.0f - frac;
+        alpha[2 * i + 1] = frac;
+    }
+}
 
-    if (align_corners) {
-        height_scale = (float)(input_height - 1) / (output_height - 1);
-        width_scale = (float)(input_width - 1) / (output_width - 1);
+/* four taps per output, cubic convolution with a = -0.75, edge taps clamped */
+void shl_ref_resize_cubic_table(int32_t in_size, int32_t out_size, bool align_corners,
+                                int32_t *ofs, float *alpha)
+{
+    const float a = -0.75f;
+    float scale = resize_scale(in_size, out_size, align_corners);
+    for (int i = 0; i < out_size; i++) {
+        float src = i * scale;
+        int32_t i0 = (int32_t)(floor(src));
+        float t = src - i0;
+        float t1 = t + 1.0f;
+        float t2 = 1.0f - t;
+        float *w = alpha + 4 * i;
+        w[0] = ((a * t1 - 5.0f * a) * t1 + 8.0f * a) * t1 - 4.0f * a;
+        w[1] = ((a + 2.0f) * t - (a + 3.0f)) * t * t + 1.0f;
+        w[2] = ((a + 2.0f) * t2 - (a + 3.0f)) * t2 * t2 + 1.0f;
+        w[3] = 1.0f - w[0] - w[1] - w[2];
+        for (int j = 0; j < 4; j++) {
+            int32_t src_idx = i0 - 1 + j;
+            src_idx = src_idx < 0 ? 0 : src_idx;
+            ofs[4 * i + j] = shl_ref_min_internal_s32(src_idx, in_size - 1);
+        }
+    }
+}
+
+/* gather one row: dst[x] = src[ofs[x]] */
+static void resize_nearest_row(const uint8_t *src, uint8_t *dst, const int32_t *ofs, int out_w,
+                               int elem_size)
+{
+    if (elem_size == 4) {
+        const uint32_t *s = (const uint32_t *)src;
+        uint32_t *d = (uint32_t *)dst;
+        for (int x = 0; x < out_w; x++) {
+            d[x] = s[ofs[x]];
+        }
+    } else if (elem_size == 2) {
+        const uint16_t *s = (const uint16_t *)src;
+        uint16_t *d = (uint16_t *)dst;
+        for (int x = 0; x < out_w; x++) {
+            d[x] = s[ofs[x]];
+        }
+    } else if (elem_size == 1) {
+        for (int x = 0; x < out_w; x++) {
+            dst[x] = src[ofs[x]];
+        }
     } else {
-        height_scale = (float)(input_height) / output_height;
-        width_scale = (float)(input_width) / output_width;
+        for (int x = 0; x < out_w; x++) {
+            memcpy(dst + x * elem_size, src + ofs[x] * elem_size, elem_size);
+        }
     }
+}
 
-    for (int b = 0; b < batches; ++b) {
-        for (int y = 0; y < output_height; ++y) {
-            float input_y = y * height_scale;
-            int32_t y0 = (int32_t)(floor(input_y));
-            int32_t y1 = shl_ref_min_internal_s32(y0 + 1, input_height - 1);
-            for (int x = 0; x < output_width; ++x) {
-                float input_x = x * width_scale;
-                int32_t x0 = (int32_t)(floor(input_x));
-                int32_t x1 = shl_ref_min_internal_s32(x0 + 1, input_width - 1);
-                for (int c = 0; c < depth; ++c) {
-                    float interpolation =
-                        (float)(input_data[shl_ref_get_index(input->dim, b, y0, x0, c)] *
-                                    (1 - (input_y - y0)) * (1 - (input_x - x0)) +
-                                input_data[shl_ref_get_index(input->dim, b, y1, x0, c)] *
-                                    (input_y - y0) * (1 - (input_x - x0)) +
-                                input_data[shl_ref_get_index(input->dim, b, y0, x1, c)] *
-                                    (1 - (input_y - y0)) * (input_x - x0) +
-                                input_data[shl_ref_get_index(input->dim, b, y1, x1, c)] *
-                                    (input_y - y0) * (input_x - x0));
-                    output_data[shl_ref_get_index(output->dim, b, y, x, c)] = interpolation;
+/*************************************************************
+ * nearest neighbor copies whole elements, so it serves every dtype
+ * NCHW: pixel_size = elem_size, planes = batch * channel
+ * NHWC: pixel_size = channel * elem_size, planes = batch
+ * output rows reading the same source row are copied from the previous one,
+ * an exact 2x upsample duplicates each pixel and then each row
+ *************************************************************/
+static void shl_ref_resize_nearest(const uint8_t *input_data, uint8_t *output_data, int planes,
+                                   int in_h, int in_w, int out_h, int out_w, int pixel_size,
+                                   bool align_corners, int thread_num)
+{
+    int32_t *yofs = shl_mem_alloc(out_h * sizeof(int32_t));
+    int32_t *xofs = shl_mem_alloc(out_w * sizeof(int32_t));
+    shl_ref_resize_nearest_table(in_h, out_h, align_corners, yofs);
+    shl_ref_resize_nearest_table(in_w, out_w, align_corners, xofs);
+
+    bool up2x = !align_corners && out_h == 2 * in_h && out_w == 2 * in_w;
+    int64_t in_row = (int64_t)in_w * pixel_size;
+    int64_t out_row = (int64_t)out_w * pixel_size;
+
+#pragma omp parallel for num_threads(thread_num)
+    for (int p = 0; p < planes; p++) {
+        const uint8_t *in_plane = input_data + p * in_h * in_row;
+        uint8_t *out_plane = output_data + p * out_h * out_row;
+        for (int y = 0; y < out_h; y++) {
+            uint8_t *out_ptr = out_plane + y * out_row;
+            if (y > 0 && yofs[y] == yofs[y - 1]) {
+                memcpy(out_ptr, out_ptr - out_row, out_row);
+                continue;
+            }
+            const uint8_t *in_ptr = in_plane + yofs[y] * in_row;
+            if (up2x && pixel_size == 4) {
+                const uint32_t *s = (const uint32_t *)in_ptr;
+                uint32_t *d = (uint32_t *)out_ptr;
+                int x = 0;
+#ifdef SHL_AVX_OPT
+                for (; x + 7 < in_w; x += 8) {
+                    __m256 _s = _mm256_loadu_ps((const float *)s + x);
+                    __m256 _lo = _mm256_unpacklo_ps(_s, _s);  // s0 s0 s1 s1 | s4 s4 s5 s5
+                    __m256 _hi = _mm256_unpackhi_ps(_s, _s);  // s2 s2 s3 s3 | s6 s6 s7 s7
+                    _mm256_storeu_ps((float *)d + 2 * x, _mm256_permute2f128_ps(_lo, _hi, 0x20));
+                    _mm256_storeu_ps((float *)d + 2 * x + 8,
+                                     _mm256_permute2f128_ps(_lo, _hi, 0x31));
+                }
+#endif
+                for (; x < in_w; x++) {
+                    d[2 * x] = s[x];
+                    d[2 * x + 1] = s[x];
+                }
+            } else if (up2x && pixel_size == 1) {
+                for (int x = 0; x < in_w; x++) {
+                    out_ptr[2 * x] = in_ptr[x];
+                    out_ptr[2 * x + 1] = in_ptr[x];
+                }
+            } else if (pixel_size <= 4) {
+                resize_nearest_row(in_ptr, out_ptr, xofs, out_w, pixel_size);
+            } else {
+                for (int x = 0; x < out_w; x++) {
+                    memcpy(out_ptr + x * pixel_size, in_ptr + xofs[x] * pixel_size, pixel_size);
                 }
             }
         }
     }
+    shl_mem_free(yofs);
+    shl_mem_free(xofs);
 }
 
-/*reference
- * https://github.com/tensorflow/tensorflow/blob/master/tensorflow/lite/kernels/internal/reference/resize_nearest_neighbor.h
- */
-static void shl_ref_resize_nearest_neighbor_f32(struct csinn_tensor *input,
-                                                struct csinn_tensor *output, bool align_corners)
+/*************************************************************
+ * separable bilinear / bicubic on NHWC, taps = 2 or 4
+ * channels are contiguous, so every tap is one axpy over depth
+ *************************************************************/
+static void shl_ref_resize_separable_nhwc_f32(struct csinn_tensor *input,
+                                              struct csinn_tensor *output, int taps,
+                                              const int32_t *yofs, const float *beta,
+                                              const int32_t *xofs, const float *alpha,
+                                              int thread_num)
 {
     float *input_data = input->data;
     float *output_data = output->data;
@@ -86,80 +199,239 @@ static void shl_ref_resize_nearest_neighbor_f32(struct csinn_tensor *input,
     int32_t output_height = output->dim[1];
     int32_t output_width = output->dim[2];
 
-    float height_scale = 0;
-    float width_scale = 0;
+#pragma omp parallel for num_threads(thread_num) collapse(2)
+    for (int b = 0; b < batches; ++b) {
+        for (int y = 0; y < output_height; ++y) {
+            const float *in_b = input_data + (int64_t)b * input_height * input_width * depth;
+            float *out_ptr =
+                output_data + ((int64_t)b * output_height + y) * output_width * depth;
+            for (int x = 0; x < output_width; ++x) {
+                for (int c = 0; c < depth; c++) {
+                    out_ptr[c] = 0.0f;
+                }
+                for (int i = 0; i < taps; i++) {
+                    const float *in_row = in_b + yofs[y * taps + i] * input_width * depth;
+                    for (int j = 0; j < taps; j++) {
+                        const float *in_ptr = in_row + xofs[x * taps + j] * depth;
+                        float w = beta[y * taps + i] * alpha[x * taps + j];
+                        int c = 0;
+#ifdef SHL_AVX_OPT
+                        __m256 _w = _mm256_set1_ps(w);
+                        for (; c + 7 < depth; c += 8) {
+                            __m256 _acc = _mm256_loadu_ps(out_ptr + c);
+                            _acc = _mm256_fmadd_ps(_w, _mm256_loadu_ps(in_ptr + c), _acc);
+                            _mm256_storeu_ps(out_ptr + c, _acc);
+                        }
+#endif
+                        for (; c < depth; c++) {
+                            out_ptr[c] += w * in_ptr[c];
+                        }
+                    }
+                }
+                out_ptr += depth;
+            }
+        }
+    }
+}
 
-    if (align_corners) {
-        height_scale = (float)(input_height - 1) / (output_height - 1);
-        width_scale = (float)(input_width - 1) / (output_width - 1);
+/*
+ * horizontal pass of one source row, it stays scalar under SHL_AVX_OPT since the column
+ * gather needs AVX2, which the x86 build does not enable
+ */
+static void resize_hrow_f32(const float *src, float *dst, int out_w, int taps,
+                            const int32_t *xofs, const float *alpha)
+{
+    if (taps == 2) {
+        for (int x = 0; x < out_w; x++) {
+            dst[x] = src[xofs[2 * x]] * alpha[2 * x] + src[xofs[2 * x + 1]] * alpha[2 * x + 1];
+        }
     } else {
-        height_scale = (float)(input_height) / output_height;
-        width_scale = (float)(input_width) / output_width;
+        for (int x = 0; x < out_w; x++) {
+            float acc = 0.0f;
+            for (int j = 0; j < taps; j++) {
+                acc += src[xofs[x * taps + j]] * alpha[x * taps + j];
+            }
+            dst[x] = acc;
+        }
     }
+}
 
-    const int col_offset = input->dim[3];
-    const int row_offset = input->dim[2] * col_offset;
-    const int batch_offset = input->dim[1] * row_offset;
+/*************************************************************
+ * separable bilinear / bicubic on one NCHW plane, taps = 2 or 4
+ * rows: taps * out_w scratch holding horizontally resampled source rows,
+ * row_id: the source row held by each slot, so each source row is
+ * resampled once however many output rows read it
+ * the horizontal then vertical order rounds differently from a direct
+ * four-corner sum, a requantized output may differ from it by one step
+ *************************************************************/
+static void resize_separable_plane_f32(const float *in, float *out, int in_w, int out_h,
+                                       int out_w, int taps, const int32_t *yofs,
+                                       const float *beta, const int32_t *xofs,
+                                       const float *alpha, float *rows, int32_t *row_id)
+{
+    const float *r[4];
+    for (int i = 0; i < taps; i++) {
+        row_id[i] = -1;
+    }
+    for (int y = 0; y < out_h; y++) {
+        const int32_t *sy = yofs + y * taps;
+        for (int i = 0; i < taps; i++) {
+            int slot = 0;
+            while (slot < taps && row_id[slot] != sy[i]) {
+                slot++;
+            }
+            if (slot == taps) {
+                // a slot no source row of this output row needs
+                for (slot = 0; slot < taps; slot++) {
+                    int k = 0;
+                    while (k < taps && row_id[slot] != sy[k]) {
+                        k++;
+                    }
+                    if (k == taps) {
+                        break;
+                    }
+                }
+                resize_hrow_f32(in + sy[i] * in_w, rows + slot * out_w, out_w, taps, xofs,
+                                alpha);
+                row_id[slot] = sy[i];
+            }
+            r[i] = rows + slot * out_w;
+        }
 
-    const float *input_ptr = input_data;
-    float *output_ptr = output_data;
-    for (int b = 0; b < batches; ++b) {
-        for (int y = 0; y < output_height; ++y) {
-            int32_t in_y =
-                shl_ref_min_internal_s32(align_corners ? (int32_t)(round(y * height_scale))
-                                                       : (int32_t)(floor(y * height_scale)),
-                                         input_height - 1);
-            const float *y_input_ptr = input_ptr + in_y * row_offset;
-            for (int x = 0; x < output_width; ++x) {
-                int32_t in_x =
-                    shl_ref_min_internal_s32(align_corners ? (int32_t)(round(x * width_scale))
-                                                           : (int32_t)(floor(x * width_scale)),
-                                             input_width - 1);
-                const float *x_input_ptr = y_input_ptr + in_x * col_offset;
-                memcpy(output_ptr, x_input_ptr, depth * sizeof(float));
-                output_ptr += depth;
+        const float *b = beta + y * taps;
+        float *out_ptr = out + y * out_w;
+        int x = 0;
+#ifdef SHL_AVX_OPT
+        /* the vertical blend reads the cached rows contiguously */
+        if (taps == 2) {
+            __m256 _b0 = _mm256_set1_ps(b[0]);
+            __m256 _b1 = _mm256_set1_ps(b[1]);
+            for (; x + 7 < out_w; x += 8) {
+                __m256 _acc = _mm256_mul_ps(_mm256_loadu_ps(r[0] + x), _b0);
+                _acc = _mm256_fmadd_ps(_mm256_loadu_ps(r[1] + x), _b1, _acc);
+                _mm256_storeu_ps(out_ptr + x, _acc);
+            }
+        } else {
+            __m256 _b0 = _mm256_set1_ps(b[0]);
+            __m256 _b1 = _mm256_set1_ps(b[1]);
+            __m256 _b2 = _mm256_set1_ps(b[2]);
+            __m256 _b3 = _mm256_set1_ps(b[3]);
+            for (; x + 7 < out_w; x += 8) {
+                __m256 _acc = _mm256_mul_ps(_mm256_loadu_ps(r[0] + x), _b0);
+                _acc = _mm256_fmadd_ps(_mm256_loadu_ps(r[1] + x), _b1, _acc);
+                _acc = _mm256_fmadd_ps(_mm256_loadu_ps(r[2] + x), _b2, _acc);
+                _acc = _mm256_fmadd_ps(_mm256_loadu_ps(r[3] + x), _b3, _acc);
+                _mm256_storeu_ps(out_ptr + x, _acc);
             }
         }
-        input_ptr += batch_offset;
+#endif
+        if (taps == 2) {
+            for (; x < out_w; x++) {
+                out_ptr[x] = r[0][x] * b[0] + r[1][x] * b[1];
+            }
+        } else {
+            for (; x < out_w; x++) {
+                out_ptr[x] = r[0][x] * b[0] + r[1][x] * b[1] + r[2][x] * b[2] + r[3][x] * b[3];
+            }
+        }
+    }
+}
+
+static void shl_ref_resize_separable_nchw_f32(struct csinn_tensor *input,
+                                              struct csinn_tensor *output, int taps,
+                                              const int32_t *yofs, const float *beta,
+                                              const int32_t *xofs, const float *alpha,
+                                              int thread_num)
+{
+    float *input_data = input->data;
+    float *output_data = output->data;
+    int32_t planes = input->dim[0] * input->dim[1];
+    int32_t in_h = input->dim[2];
+    int32_t in_w = input->dim[3];
+    int32_t out_h = output->dim[2];
+    int32_t out_w = output->dim[3];
+
+    float *rows = shl_mem_alloc((int64_t)thread_num * taps * out_w * sizeof(float));
+    int32_t *row_id = shl_mem_alloc(thread_num * taps * sizeof(int32_t));
+
+#pragma omp parallel for num_threads(thread_num)
+    for (int p = 0; p < planes; p++) {
+        int tid = 0;
+#ifdef _OPENMP
+        tid = omp_get_thread_num();
+#endif
+        resize_separable_plane_f32(input_data + (int64_t)p * in_h * in_w,
+                                   output_data + (int64_t)p * out_h * out_w, in_w, out_h, out_w,
+                                   taps, yofs, beta, xofs, alpha, rows + tid * taps * out_w,
+                                   row_id + tid * taps);
     }
+    shl_mem_free(rows);
+    shl_mem_free(row_id);
 }
 
-static void shl_ref_resize_nearest_neighbor_nchw_f32(struct csinn_tensor *o_input,
-                                                     struct csinn_tensor *o_output,
-                                                     bool align_corners)
+/* the coordinate tables are built per call, the output shape may change between runs */
+static void shl_ref_resize_separable_f32(struct csinn_tensor *input, struct csinn_tensor *output,
+                                         int taps, bool align_corners, int layout,
+                                         int thread_num)
 {
-    struct csinn_tensor *input = shl_ref_nchw_to_nhwc_f32(o_input);
-    struct csinn_tensor *output = shl_ref_nchw_to_nhwc_f32(o_output);
-    shl_ref_resize_nearest_neighbor_f32(input, output, align_corners);
-    shl_ref_nhwc_to_nchw_f32(o_output, output);
-    shl_ref_free_float_tensor(input);
+    int h_axis = layout == CSINN_LAYOUT_NCHW ? 2 : 1;
+    int32_t in_h = input->dim[h_axis];
+    int32_t in_w = input->dim[h_axis + 1];
+    int32_t out_h = output->dim[h_axis];
+    int32_t out_w = output->dim[h_axis + 1];
+
+    int32_t *yofs = shl_mem_alloc(out_h * taps * sizeof(int32_t));
+    int32_t *xofs = shl_mem_alloc(out_w * taps * sizeof(int32_t));
+    float *beta = shl_mem_alloc(out_h * taps * sizeof(float));
+    float *alpha = shl_mem_alloc(out_w * taps * sizeof(float));
+    if (taps == 2) {
+        shl_ref_resize_linear_table(in_h, out_h, align_corners, yofs, beta);
+        shl_ref_resize_linear_table(in_w, out_w, align_corners, xofs, alpha);
+    } else {
+        shl_ref_resize_cubic_table(in_h, out_h, align_corners, yofs, beta);
+        shl_ref_resize_cubic_table(in_w, out_w, align_corners, xofs, alpha);
+    }
+
+    if (layout == CSINN_LAYOUT_NCHW) {
+        shl_ref_resize_separable_nchw_f32(input, output, taps, yofs, beta, xofs, alpha,
+                                          thread_num);
+    } else {
+        shl_ref_resize_separable_nhwc_f32(input, output, taps, yofs, beta, xofs, alpha,
+                                          thread_num);
+    }
+    shl_mem_free(yofs);
+    shl_mem_free(xofs);
+    shl_mem_free(beta);
+    shl_mem_free(alpha);
 }
 
-static void shl_ref_resize_bilinear_nchw_f32(struct csinn_tensor *o_input,
-                                             struct csinn_tensor *o_output, bool align_corners)
+static void shl_ref_resize_nearest_tensor(struct csinn_tensor *input, struct csinn_tensor *output,
+                                          int elem_size, bool align_corners, int layout,
+                                          int thread_num)
 {
-    struct csinn_tensor *input = shl_ref_nchw_to_nhwc_f32(o_input);
-    struct csinn_tensor *output = shl_ref_nchw_to_nhwc_f32(o_output);
-    shl_ref_resize_bilinear_nhwc_f32(input, output, align_corners);
-    shl_ref_nhwc_to_nchw_f32(o_output, output);
-    shl_ref_free_float_tensor(input);
+    if (layout == CSINN_LAYOUT_NCHW) {
+        shl_ref_resize_nearest(input->data, output->data, input->dim[0] * input->dim[1],
+                               input->dim[2], input->dim[3], output->dim[2], output->dim[3],
+                               elem_size, align_corners, thread_num);
+    } else {
+        shl_ref_resize_nearest(input->data, output->data, input->dim[0], input->dim[1],
+                               input->dim[2], output->dim[1], output->dim[2],
+                               input->dim[3] * elem_size, align_corners, thread_num);
+    }
 }
 
 int shl_ref_resize_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                        struct csinn_resize_params *params)
 {
+    int thread_num = shl_ref_get_thread_num(&params->base);
+    int layout = params->base.layout;
     if (params->resize_mode == CSINN_RESIZE_BILINEAR) {
-        if (params->base.layout == CSINN_LAYOUT_NCHW) {
-            shl_ref_resize_bilinear_nchw_f32(input, output, params->align_corners);
-        } else {
-            shl_ref_resize_bilinear_nhwc_f32(input, output, params->align_corners);
-        }
+        shl_ref_resize_separable_f32(input, output, 2, params->align_corners, layout, thread_num);
+    } else if (params->resize_mode == CSINN_RESIZE_NEAREST_BICUBIC) {
+        shl_ref_resize_separable_f32(input, output, 4, params->align_corners, layout, thread_num);
     } else if (params->resize_mode == CSINN_RESIZE_NEAREST_NEIGHBOR) {
-        if (params->base.layout == CSINN_LAYOUT_NCHW) {
-            shl_ref_resize_nearest_neighbor_nchw_f32(input, output, params->align_corners);
-        } else {
-            shl_ref_resize_nearest_neighbor_f32(input, output, params->align_corners);
-        }
+        shl_ref_resize_nearest_tensor(input, output, sizeof(float), params->align_corners, layout,
+                                      thread_num);
     } else {
         return CSINN_FALSE;
     }
@@ -169,5 +441,16 @@ int shl_ref_resize_f32(struct csinn_tensor *input, struct csinn_tensor *output,
 int shl_ref_resize_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                          struct csinn_resize_params *params)
 {
+    // nearest only moves elements, no need to dequantize when the output keeps the quantization
+    if (params->resize_mode == CSINN_RESIZE_NEAREST_NEIGHBOR && input->dtype == output->dtype &&
+        input->dtype != CSINN_DTYPE_INT4 && input->quant_channel == 1 &&
+        output->quant_channel == 1 && input->qinfo->scale == output->qinfo->scale &&
+        input->qinfo->zero_point == output->qinfo->zero_point) {
+        int thread_num = shl_ref_get_thread_num(&params->base);
+        int elem_size = csinn_tensor_byte_size(input) / csinn_tensor_size(input);
+        shl_ref_resize_nearest_tensor(input, output, elem_size, params->align_corners,
+                                      params->base.layout, thread_num);
+        return CSINN_TRUE;
+    }
     return shl_ref_siso_callback_base(input, output, params, shl_ref_resize_f32);
 }
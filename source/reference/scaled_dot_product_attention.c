@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_ref.h"
+
+/*
+ * The mask is added to the scores [..., seq_q, seq_k]. Its last dim is seq_k, the one before
+ * is seq_q or 1, and the leading dims right-align with the outer dims of the query, each one
+ * equal or 1. Returns the offset of the mask rows of the outer index, q_stride is the step
+ * between query rows (0 when broadcast).
+ */
+int64_t shl_ref_attention_mask_offset(struct csinn_tensor *mask, struct csinn_tensor *query,
+                                      int64_t outer, int32_t *q_stride)
+{
+    int seq_q = query->dim[query->dim_count - 2];
+    int seq_k = mask->dim[mask->dim_count - 1];
+    int mask_q = mask->dim_count > 1 ? mask->dim[mask->dim_count - 2] : 1;
+    *q_stride = mask_q == seq_q ? seq_k : 0;
+
+    int64_t offset = 0;
+    int64_t stride = (int64_t)mask_q * seq_k;
+    int q_outer = query->dim_count - 2;
+    for (int i = mask->dim_count - 3, j = q_outer - 1; j >= 0; i--, j--) {
+        int idx = outer % query->dim[j];
+        outer /= query->dim[j];
+        if (i < 0) {
+            continue;
+        }
+        if (mask->dim[i] != 1) {
+            offset += idx * stride;
+        }
+        stride *= mask->dim[i];
+    }
+    return offset;
+}
+
+static inline bool attention_has_mask(struct csinn_tensor *mask)
+{
+    return mask != NULL && mask->data != NULL && mask->dim_count > 0;
+}
+
+int shl_ref_scaled_dot_product_attention_f32(
+    struct csinn_tensor *query, struct csinn_tensor *key, struct csinn_tensor *value,
+    struct csinn_tensor *mask, struct csinn_tensor *output,
+    struct csinn_scaled_dot_product_attention_params *params)
+{
+    float *q_data = query->data;
+    float *k_data = key->data;
+    float *v_data = value->data;
+    float *mask_data = attention_has_mask(mask) ? mask->data : NULL;
+    float *output_data = output->data;
+
+    const int dims_count = query->dim_count;
+    const int seq_q = query->dim[dims_count - 2];
+    const int head_dim = query->dim[dims_count - 1];
+    const int seq_k = key->dim[dims_count - 2];
+    const int head_dim_v = value->dim[dims_count - 1];
+    int64_t outer_size = 1;
+    for (int i = 0; i < dims_count - 2; i++) {
+        outer_size *= query->dim[i];
+    }
+    int thread_num = shl_ref_get_thread_num(&params->base);
+
+#pragma omp parallel for num_threads(thread_num)
+    for (int64_t o = 0; o < outer_size; o++) {
+        float *score = shl_mem_alloc(seq_k * sizeof(float));
+        const float *q_ptr = q_data + o * seq_q * head_dim;
+        const float *k_ptr = k_data + o * seq_k * head_dim;
+        const float *v_ptr = v_data + o * seq_k * head_dim_v;
+        float *out_ptr = output_data + o * seq_q * head_dim_v;
+        int32_t mask_q_stride = 0;
+        const float *mask_ptr = NULL;
+        if (mask_data != NULL) {
+            mask_ptr = mask_data + shl_ref_attention_mask_offset(mask, query, o, &mask_q_stride);
+        }
+
+        for (int i = 0; i < seq_q; i++) {
+            int valid_k = params->causal ? (i + 1 < seq_k ? i + 1 : seq_k) : seq_k;
+            float max = -INFINITY;
+            for (int j = 0; j < valid_k; j++) {
+                float acc = 0.0f;
+                for (int d = 0; d < head_dim; d++) {
+                    acc += q_ptr[i * head_dim + d] * k_ptr[j * head_dim + d];
+                }
+                acc *= params->norm_factor;
+                if (mask_ptr != NULL) {
+                    acc += mask_ptr[i * mask_q_stride + j];
+                }
+                score[j] = acc;
+                max = fmaxf(max, acc);
+            }
+
+            float sum = 0.0f;
+            for (int j = 0; j < valid_k; j++) {
+                score[j] = expf(score[j] - max);
+                sum += score[j];
+            }
+            float *out_row = out_ptr + i * head_dim_v;
+            for (int d = 0; d < head_dim_v; d++) {
+                out_row[d] = 0.0f;
+            }
+            /* a row masked out completely gives zeros */
+            if (max == -INFINITY) {
+                continue;
+            }
+            for (int j = 0; j < valid_k; j++) {
+                float p = score[j] / sum;
+                for (int d = 0; d < head_dim_v; d++) {
+                    out_row[d] += p * v_ptr[j * head_dim_v + d];
+                }
+            }
+        }
+        shl_mem_free(score);
+    }
+    return CSINN_TRUE;
+}
+
+int shl_ref_scaled_dot_product_attention_quant(
+    struct csinn_tensor *query, struct csinn_tensor *key, struct csinn_tensor *value,
+    struct csinn_tensor *mask, struct csinn_tensor *output,
+    struct csinn_scaled_dot_product_attention_params *params)
+{
+    struct csinn_tensor *float_query = shl_ref_tensor_transform_f32(query);
+    struct csinn_tensor *float_key = shl_ref_tensor_transform_f32(key);
+    struct csinn_tensor *float_value = shl_ref_tensor_transform_f32(value);
+    struct csinn_tensor *float_mask = NULL;
+    if (attention_has_mask(mask)) {
+        float_mask = shl_ref_tensor_transform_f32(mask);
+    }
+    struct csinn_tensor *float_output = shl_ref_tensor_transform_f32(output);
+
+    int ret = shl_ref_scaled_dot_product_attention_f32(float_query, float_key, float_value,
+                                                       float_mask, float_output, params);
+    csinn_tensor_data_convert(output, float_output);
+
+    shl_ref_tensor_transform_free_f32(float_query);
+    shl_ref_tensor_transform_free_f32(float_key);
+    shl_ref_tensor_transform_free_f32(float_value);
+    if (float_mask != NULL) {
+        shl_ref_tensor_transform_free_f32(float_mask);
+    }
+    shl_ref_tensor_transform_free_f32(float_output);
+    return ret;
+}
@@ -20,58 +20,74 @@
 
 #include "shl_ref.h"
 
-int shl_ref_scatter_nd_f32(struct csinn_tensor *input, struct csinn_tensor *indices,
+/*************************************************************
+ * output = input, then every k-tuple of indices [..., k] overwrites the slice
+ * output[i0, ..., ik-1, :, ...] with the matching slice of updates [..., slice],
+ * later tuples win, tuples out of range are skipped
+ *************************************************************/
+static int scatter_nd_base(struct csinn_tensor *input, struct csinn_tensor *indices,
                            struct csinn_tensor *updates, struct csinn_tensor *output,
-                           struct csinn_scatter_nd_params *params)
+                           int elem_size)
 {
-    if (input->dim_count != 5 && indices->dim[indices->dim_count - 1] != 5) {
+    int indices_last_dim = indices->dim[indices->dim_count - 1];
+    if (indices_last_dim > input->dim_count) {
         return CSINN_FALSE;
     }
-    float *input_data = (float *)input->data;
-    int32_t *indices_data = (int32_t *)indices->data;
-    float *updates_data = (float *)updates->data;
-    float *output_data = (float *)output->data;
+    int8_t *input_data = input->data;
+    int32_t *indices_data = indices->data;
+    int8_t *updates_data = updates->data;
+    int8_t *output_data = output->data;
 
-    int size = 1;
-    for (int i = 0; i < input->dim_count; i++) {
-        size = size * input->dim[i];
+    int64_t slice_size = 1;
+    for (int i = indices_last_dim; i < input->dim_count; i++) {
+        slice_size *= input->dim[i];
     }
-    for (int i = 0; i < size; i++) {
-        output_data[i] = input_data[i];
+    int64_t axis_stride[MAX_DIM];
+    int64_t stride = 1;
+    for (int j = indices_last_dim - 1; j >= 0; j--) {
+        axis_stride[j] = stride;
+        stride *= input->dim[j];
     }
+    int64_t slice = slice_size * elem_size;
+    int64_t tuple_num = csinn_tensor_size(indices) / indices_last_dim;
 
-    for (int i = 0; i < indices->dim[0]; i++) {
-        for (int j = 0; j < indices->dim[1]; j++) {
-            for (int k = 0; k < indices->dim[2]; k++) {
-                for (int l = 0; l < indices->dim[3]; l++) {
-                    for (int m = 0; m < indices->dim[4]; m++) {
-                        int indices_base =
-                            ((((i * indices->dim[1] + j) * indices->dim[2] + k) * indices->dim[3] +
-                              l) *
-                                 indices->dim[4] +
-                             m) *
-                            indices->dim[5];
-
-                        int output_index = shl_ref_get_index_5(
-                            input->dim, indices_data[indices_base], indices_data[indices_base + 1],
-                            indices_data[indices_base + 2], indices_data[indices_base + 3],
-                            indices_data[indices_base + 4]);
-
-                        int updates_index = shl_ref_get_index_5(updates->dim, i, j, k, l, m);
-                        output_data[output_index] = updates_data[updates_index];
-                    }
-                }
+    if (output_data != input_data) {
+        memcpy(output_data, input_data, csinn_tensor_size(input) * elem_size);
+    }
+    for (int64_t i = 0; i < tuple_num; i++) {
+        int32_t *tuple = indices_data + i * indices_last_dim;
+        int64_t output_idx = 0;
+        bool in_range = true;
+        for (int j = 0; j < indices_last_dim; j++) {
+            if (tuple[j] < 0 || tuple[j] >= input->dim[j]) {
+                in_range = false;
+                break;
             }
+            output_idx += tuple[j] * axis_stride[j];
+        }
+        if (in_range) {
+            memcpy(output_data + output_idx * slice, updates_data + i * slice, slice);
         }
     }
-
     return CSINN_TRUE;
 }
 
+int shl_ref_scatter_nd_f32(struct csinn_tensor *input, struct csinn_tensor *indices,
+                           struct csinn_tensor *updates, struct csinn_tensor *output,
+                           struct csinn_scatter_nd_params *params)
+{
+    return scatter_nd_base(input, indices, updates, output, sizeof(float));
+}
+
 int shl_ref_scatter_nd_quant(struct csinn_tensor *input, struct csinn_tensor *indices,
                              struct csinn_tensor *updates, struct csinn_tensor *output,
                              struct csinn_scatter_nd_params *params)
 {
+    int elem_size = shl_ref_dtype_byte(input->dtype);
+    if (elem_size > 0 && shl_ref_same_quant(input, output) &&
+        shl_ref_same_quant(updates, output)) {
+        return scatter_nd_base(input, indices, updates, output, elem_size);
+    }
     struct csinn_tensor *float_input = shl_ref_tensor_transform_f32(input);
     struct csinn_tensor *float_updates = shl_ref_tensor_transform_f32(updates);
     struct csinn_tensor *float_output = shl_ref_tensor_transform_f32(output);
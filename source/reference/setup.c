@@ -212,16 +212,23 @@ static void *setup_cb_map()
 
     for (int i = CSINN_DTYPE_INT4; i <= CSINN_DTYPE_BFLOAT16; i++) {
         cb_map[CSINN_OP_ABS][i].exec = shl_ref_abs_quant;
+        cb_map[CSINN_OP_ABS][i].init = shl_ref_abs_init;
         cb_map[CSINN_OP_ACOS][i].exec = shl_ref_acos_quant;
+        cb_map[CSINN_OP_ACOS][i].init = shl_ref_acos_init;
         cb_map[CSINN_OP_ACOSH][i].exec = shl_ref_acosh_quant;
+        cb_map[CSINN_OP_ACOSH][i].init = shl_ref_acosh_init;
         cb_map[CSINN_OP_ADD][i].exec = shl_ref_add_quant;
         cb_map[CSINN_OP_ARANGE][i].exec = shl_ref_arange_quant;
         cb_map[CSINN_OP_ARGMAX][i].exec = shl_ref_argmax_stride_quant;
         cb_map[CSINN_OP_ARGMIN][i].exec = shl_ref_argmin_stride_quant;
         cb_map[CSINN_OP_ASIN][i].exec = shl_ref_asin_quant;
+        cb_map[CSINN_OP_ASIN][i].init = shl_ref_asin_init;
         cb_map[CSINN_OP_ASINH][i].exec = shl_ref_asinh_quant;
+        cb_map[CSINN_OP_ASINH][i].init = shl_ref_asinh_init;
         cb_map[CSINN_OP_ATAN][i].exec = shl_ref_atan_quant;
+        cb_map[CSINN_OP_ATAN][i].init = shl_ref_atan_init;
         cb_map[CSINN_OP_ATANH][i].exec = shl_ref_atanh_quant;
+        cb_map[CSINN_OP_ATANH][i].init = shl_ref_atanh_init;
         cb_map[CSINN_OP_AVGPOOL2D][i].exec = shl_ref_avgpool2d_quant;
         cb_map[CSINN_OP_AVGPOOL3D][i].exec = shl_ref_avgpool3d_quant;
         cb_map[CSINN_OP_BN][i].exec = shl_ref_batch_normalization_quant;
@@ -232,26 +239,41 @@ static void *setup_cb_map()
         cb_map[CSINN_OP_CACHE_CONV1D][i].exec = shl_ref_cache_conv1d_quant;
         cb_map[CSINN_OP_CACHE_CONV1D][i].init = shl_ref_cache_conv1d_init;
         cb_map[CSINN_OP_CEIL][i].exec = shl_ref_ceil_quant;
+        cb_map[CSINN_OP_CEIL][i].init = shl_ref_ceil_init;
         cb_map[CSINN_OP_CLIP][i].exec = shl_ref_clip_quant;
+        cb_map[CSINN_OP_CLIP][i].init = shl_ref_clip_init;
         cb_map[CSINN_OP_CONCAT][i].exec = shl_ref_concat_quant;
         cb_map[CSINN_OP_COS][i].exec = shl_ref_cos_quant;
+        cb_map[CSINN_OP_COS][i].init = shl_ref_cos_init;
         cb_map[CSINN_OP_COSH][i].exec = shl_ref_cosh_quant;
+        cb_map[CSINN_OP_COSH][i].init = shl_ref_cosh_init;
         cb_map[CSINN_OP_CUMPROD][i].exec = shl_ref_cumprod_quant;
         cb_map[CSINN_OP_DATA_CONVERT][i].exec = shl_ref_data_convert_quant;
         cb_map[CSINN_OP_CUMSUM][i].exec = shl_ref_cumsum_quant;
         cb_map[CSINN_OP_DEPTH_TO_SPACE][i].exec = shl_ref_depth_to_space_quant;
         cb_map[CSINN_OP_DIV][i].exec = shl_ref_div_quant;
         cb_map[CSINN_OP_ELU][i].exec = shl_ref_elu_quant;
+        cb_map[CSINN_OP_ELU][i].init = shl_ref_elu_init;
         cb_map[CSINN_OP_EQUANL][i].exec = shl_ref_equal_quant;
         cb_map[CSINN_OP_ERF][i].exec = shl_ref_erf_quant;
+        cb_map[CSINN_OP_ERF][i].init = shl_ref_erf_init;
+        cb_map[CSINN_OP_GELU][i].exec = shl_ref_gelu_quant;
+        cb_map[CSINN_OP_GELU][i].init = shl_ref_gelu_init;
+        cb_map[CSINN_OP_MISH][i].exec = shl_ref_mish_quant;
+        cb_map[CSINN_OP_MISH][i].init = shl_ref_mish_init;
+        cb_map[CSINN_OP_SILU][i].exec = shl_ref_silu_quant;
+        cb_map[CSINN_OP_SILU][i].init = shl_ref_silu_init;
         cb_map[CSINN_OP_EXP][i].exec = shl_ref_exp_quant;
+        cb_map[CSINN_OP_EXP][i].init = shl_ref_exp_init;
         cb_map[CSINN_OP_EXPAND_DIMS][i].exec = shl_ref_expand_dims_quant;
         cb_map[CSINN_OP_EXPM1][i].exec = shl_ref_expm1_quant;
+        cb_map[CSINN_OP_EXPM1][i].init = shl_ref_expm1_init;
         cb_map[CSINN_OP_FLATTEN][i].exec = shl_ref_flatten;
         cb_map[CSINN_OP_FLATTEN][i].init = shl_ref_flatten_init;
         cb_map[CSINN_OP_FLOOR_DIVIDE][i].exec = shl_ref_floor_divide_quant;
         cb_map[CSINN_OP_FLOOR_MOD][i].exec = shl_ref_floor_mod_quant;
         cb_map[CSINN_OP_FLOOR][i].exec = shl_ref_floor_quant;
+        cb_map[CSINN_OP_FLOOR][i].init = shl_ref_floor_init;
         cb_map[CSINN_OP_FSMN][i].exec = shl_ref_fsmn_quant;
         cb_map[CSINN_OP_GATHER_ND][i].exec = shl_ref_gather_nd_quant;
         cb_map[CSINN_OP_GATHER][i].exec = shl_ref_gather_quant;
@@ -260,14 +282,18 @@ static void *setup_cb_map()
         cb_map[CSINN_OP_GREATHER_EQUAL][i].exec = shl_ref_greater_equal_quant;
         cb_map[CSINN_OP_GREATHER][i].exec = shl_ref_greater_quant;
         cb_map[CSINN_OP_HARD_SIGMOID][i].exec = shl_ref_hard_sigmoid_quant;
+        cb_map[CSINN_OP_HARD_SIGMOID][i].init = shl_ref_hard_sigmoid_init;
         cb_map[CSINN_OP_IM2COL][i].exec = shl_ref_im2col_quant;
         cb_map[CSINN_OP_L2N][i].exec = shl_ref_l2_normalization_quant;
         cb_map[CSINN_OP_LEAKY_RELU][i].exec = shl_ref_leaky_relu_quant;
+        cb_map[CSINN_OP_LEAKY_RELU][i].init = shl_ref_leaky_relu_init;
         cb_map[CSINN_OP_LESS_EQUAL][i].exec = shl_ref_less_equal_quant;
         cb_map[CSINN_OP_LESS][i].exec = shl_ref_less_quant;
         cb_map[CSINN_OP_LOG_SOFTMAX][i].exec = shl_ref_log_softmax_quant;
         cb_map[CSINN_OP_LOG][i].exec = shl_ref_log_quant;
+        cb_map[CSINN_OP_LOG][i].init = shl_ref_log_init;
         cb_map[CSINN_OP_LOG1P][i].exec = shl_ref_log1p_quant;
+        cb_map[CSINN_OP_LOG1P][i].init = shl_ref_log1p_init;
         cb_map[CSINN_OP_LOGICAL_AND][i].exec = shl_ref_logical_and_quant;
         cb_map[CSINN_OP_LOGICAL_NOT][i].exec = shl_ref_logical_not_quant;
         cb_map[CSINN_OP_LOGICAL_OR][i].exec = shl_ref_logical_or_quant;
@@ -286,6 +312,7 @@ static void *setup_cb_map()
         cb_map[CSINN_OP_MOD][i].exec = shl_ref_mod_quant;
         cb_map[CSINN_OP_MUL][i].exec = shl_ref_mul_quant;
         cb_map[CSINN_OP_NEGATIIVE][i].exec = shl_ref_negative_quant;
+        cb_map[CSINN_OP_NEGATIIVE][i].init = shl_ref_negative_init;
         cb_map[CSINN_OP_NOT_EQUAL][i].exec = shl_ref_not_equal_quant;
         cb_map[CSINN_OP_PAD][i].exec = shl_ref_pad_quant;
         cb_map[CSINN_OP_POWER][i].exec = shl_ref_power_quant;
@@ -300,16 +327,24 @@ static void *setup_cb_map()
         cb_map[CSINN_OP_REDUCE_PROD][i].exec = shl_ref_reduce_prod_quant;
         cb_map[CSINN_OP_REDUCE_SUM][i].exec = shl_ref_reduce_sum_quant;
         cb_map[CSINN_OP_RELU][i].exec = shl_ref_relu_quant;
+        cb_map[CSINN_OP_RELU][i].init = shl_ref_relu_init;
         cb_map[CSINN_OP_RELU1][i].exec = shl_ref_relu1_quant;
+        cb_map[CSINN_OP_RELU1][i].init = shl_ref_relu1_init;
         cb_map[CSINN_OP_RELU6][i].exec = shl_ref_relu6_quant;
+        cb_map[CSINN_OP_RELU6][i].init = shl_ref_relu6_init;
         cb_map[CSINN_OP_RELUN][i].exec = shl_ref_relun_quant;
+        cb_map[CSINN_OP_RELUN][i].init = shl_ref_relun_init;
         cb_map[CSINN_OP_RESHAPE][i].exec = shl_ref_reshape;
         cb_map[CSINN_OP_RESHAPE][i].init = shl_ref_reshape_init;
         cb_map[CSINN_OP_RESIZE][i].exec = shl_ref_resize_quant;
         cb_map[CSINN_OP_REVERSE][i].exec = shl_ref_reverse_quant;
         cb_map[CSINN_OP_ROIPOOL][i].exec = shl_ref_roipool_quant;
         cb_map[CSINN_OP_ROUND][i].exec = shl_ref_round_quant;
+        cb_map[CSINN_OP_ROUND][i].init = shl_ref_round_init;
         cb_map[CSINN_OP_RSQRT][i].exec = shl_ref_rsqrt_quant;
+        cb_map[CSINN_OP_RSQRT][i].init = shl_ref_rsqrt_init;
+        cb_map[CSINN_OP_SCALED_DOT_PRODUCT_ATTENTION][i].exec =
+            shl_ref_scaled_dot_product_attention_quant;
         cb_map[CSINN_OP_SEGMENT_MAX][i].exec = shl_ref_segment_max_quant;
         cb_map[CSINN_OP_UNSORTED_SEGMENT_MAX][i].exec = shl_ref_unsorted_segment_max_quant;
         cb_map[CSINN_OP_SEGMENT_MEAN][i].exec = shl_ref_segment_mean_quant;
@@ -322,29 +357,41 @@ static void *setup_cb_map()
         cb_map[CSINN_OP_UNSORTED_SEGMENT_SUM][i].exec = shl_ref_unsorted_segment_sum_quant;
         cb_map[CSINN_OP_SHUFFLE_CHANNEL][i].exec = shl_ref_shuffle_channel_quant;
         cb_map[CSINN_OP_SIGMOID][i].exec = shl_ref_sigmoid_quant;
+        cb_map[CSINN_OP_SIGMOID][i].init = shl_ref_sigmoid_init;
         cb_map[CSINN_OP_SIGN][i].exec = shl_ref_sign_quant;
+        cb_map[CSINN_OP_SIGN][i].init = shl_ref_sign_init;
         cb_map[CSINN_OP_SIN][i].exec = shl_ref_sin_quant;
+        cb_map[CSINN_OP_SIN][i].init = shl_ref_sin_init;
         cb_map[CSINN_OP_SINH][i].exec = shl_ref_sinh_quant;
+        cb_map[CSINN_OP_SINH][i].init = shl_ref_sinh_init;
         cb_map[CSINN_OP_SLICE][i].exec = shl_ref_slice_quant;
         cb_map[CSINN_OP_SOFTMAX][i].exec = shl_ref_softmax_quant;
         cb_map[CSINN_OP_SOFTPLUS][i].exec = shl_ref_softplus_quant;
+        cb_map[CSINN_OP_SOFTPLUS][i].init = shl_ref_softplus_init;
         cb_map[CSINN_OP_SOFTRELU][i].exec = shl_ref_softrelu_quant;
+        cb_map[CSINN_OP_SOFTRELU][i].init = shl_ref_softrelu_init;
         cb_map[CSINN_OP_SOFTSIGN][i].exec = shl_ref_softsign_quant;
+        cb_map[CSINN_OP_SOFTSIGN][i].init = shl_ref_softsign_init;
         cb_map[CSINN_OP_SPACE_TO_BATCH][i].exec = shl_ref_space_to_batch_quant;
         cb_map[CSINN_OP_SPACE_TO_DEPTH][i].exec = shl_ref_space_to_depth_quant;
         cb_map[CSINN_OP_SQRT][i].exec = shl_ref_sqrt_quant;
+        cb_map[CSINN_OP_SQRT][i].init = shl_ref_sqrt_init;
         cb_map[CSINN_OP_STACK][i].exec = shl_ref_stack_quant;
         cb_map[CSINN_OP_STRIDED_SLICE][i].exec = shl_ref_strided_slice_quant;
         cb_map[CSINN_OP_SUB][i].exec = shl_ref_sub_quant;
         cb_map[CSINN_OP_SUM][i].exec = shl_ref_sum_stride_quant;
         cb_map[CSINN_OP_TAN][i].exec = shl_ref_tan_quant;
+        cb_map[CSINN_OP_TAN][i].init = shl_ref_tan_init;
         cb_map[CSINN_OP_TANH][i].exec = shl_ref_tanh_quant;
+        cb_map[CSINN_OP_TANH][i].init = shl_ref_tanh_init;
         cb_map[CSINN_OP_THRESHOLD_RELU][i].exec = shl_ref_threshold_relu_quant;
+        cb_map[CSINN_OP_THRESHOLD_RELU][i].init = shl_ref_threshold_relu_init;
         cb_map[CSINN_OP_TILE][i].exec = shl_ref_tile_quant;
         cb_map[CSINN_OP_TOPK][i].exec = shl_ref_topk_quant;
         cb_map[CSINN_OP_TRANSPOSE][i].exec = shl_ref_transpose;
         cb_map[CSINN_OP_TRANSPOSE][i].init = shl_ref_transpose_init;
         cb_map[CSINN_OP_TRUNC][i].exec = shl_ref_trunc_quant;
+        cb_map[CSINN_OP_TRUNC][i].init = shl_ref_trunc_init;
         cb_map[CSINN_OP_UNPOOLING][i].exec = shl_ref_unpooling_quant;
         cb_map[CSINN_OP_YUV_RGB_SCALE][i].exec = shl_ref_yuv_rgb_scale_quant;
         cb_map[CSINN_OP_CONV2D][i].exec = shl_ref_conv2d_quant;
@@ -442,6 +489,9 @@ static void *setup_cb_map()
     cb_map[CSINN_OP_ELU][CSINN_DTYPE_FLOAT32].exec = shl_ref_elu_f32;
     cb_map[CSINN_OP_EQUANL][CSINN_DTYPE_FLOAT32].exec = shl_ref_equal_f32;
     cb_map[CSINN_OP_ERF][CSINN_DTYPE_FLOAT32].exec = shl_ref_erf_f32;
+    cb_map[CSINN_OP_GELU][CSINN_DTYPE_FLOAT32].exec = shl_ref_gelu_f32;
+    cb_map[CSINN_OP_MISH][CSINN_DTYPE_FLOAT32].exec = shl_ref_mish_f32;
+    cb_map[CSINN_OP_SILU][CSINN_DTYPE_FLOAT32].exec = shl_ref_silu_f32;
     cb_map[CSINN_OP_EXP][CSINN_DTYPE_FLOAT32].exec = shl_ref_exp_f32;
     cb_map[CSINN_OP_EXPAND_DIMS][CSINN_DTYPE_FLOAT32].exec = shl_ref_expand_dims_f32;
     cb_map[CSINN_OP_EXPM1][CSINN_DTYPE_FLOAT32].exec = shl_ref_expm1_f32;
@@ -512,6 +562,8 @@ static void *setup_cb_map()
     cb_map[CSINN_OP_ROIPOOL][CSINN_DTYPE_FLOAT32].exec = shl_ref_roipool_f32;
     cb_map[CSINN_OP_ROUND][CSINN_DTYPE_FLOAT32].exec = shl_ref_round_f32;
     cb_map[CSINN_OP_RSQRT][CSINN_DTYPE_FLOAT32].exec = shl_ref_rsqrt_f32;
+    cb_map[CSINN_OP_SCALED_DOT_PRODUCT_ATTENTION][CSINN_DTYPE_FLOAT32].exec =
+        shl_ref_scaled_dot_product_attention_f32;
     cb_map[CSINN_OP_SCATTER_ND][CSINN_DTYPE_FLOAT32].exec = shl_ref_scatter_nd_f32;
     cb_map[CSINN_OP_SEGMENT_MAX][CSINN_DTYPE_FLOAT32].exec = shl_ref_segment_max_f32;
     cb_map[CSINN_OP_UNSORTED_SEGMENT_MAX][CSINN_DTYPE_FLOAT32].exec =
@@ -596,6 +648,9 @@ static void *setup_cb_map()
         cb_map[CSINN_OP_ELU][i].est = shl_gref_elu;
         cb_map[CSINN_OP_EQUANL][i].est = shl_gref_equal;
         cb_map[CSINN_OP_ERF][i].est = shl_gref_erf;
+        cb_map[CSINN_OP_GELU][i].est = shl_gref_gelu;
+        cb_map[CSINN_OP_MISH][i].est = shl_gref_mish;
+        cb_map[CSINN_OP_SILU][i].est = shl_gref_silu;
         cb_map[CSINN_OP_EXP][i].est = shl_gref_exp;
         cb_map[CSINN_OP_EXPAND_DIMS][i].est = shl_gref_expand_dims;
         cb_map[CSINN_OP_EXPM1][i].est = shl_gref_expm1;
@@ -660,6 +715,8 @@ static void *setup_cb_map()
         cb_map[CSINN_OP_ROIPOOL][i].est = shl_gref_roipool;
         cb_map[CSINN_OP_ROUND][i].est = shl_gref_round;
         cb_map[CSINN_OP_RSQRT][i].est = shl_gref_rsqrt;
+        cb_map[CSINN_OP_SCALED_DOT_PRODUCT_ATTENTION][i].est =
+            shl_gref_scaled_dot_product_attention;
         cb_map[CSINN_OP_SEGMENT_MAX][i].est = shl_gref_segment_max;
         cb_map[CSINN_OP_UNSORTED_SEGMENT_MAX][i].est = shl_gref_segment_max;
         cb_map[CSINN_OP_SEGMENT_MEAN][i].est = shl_gref_segment_mean;
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "avx_mathfun.h"
+#include "shl_ref.h"
+
+/* x * sigmoid(x), also known as swish */
+static float silu(float x) { return x / (1.0f + expf(-x)); }
+
+int shl_ref_silu_f32(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_siso_params *params)
+{
+    float *input_data = (float *)input->data;
+    float *output_data = (float *)output->data;
+    int size = csinn_tensor_size(input);
+    int i = 0;
+#ifdef SHL_AVX_OPT
+    for (; i + 7 < size; i += 8) {
+        __m256 _x = _mm256_loadu_ps(input_data + i);
+        _mm256_storeu_ps(output_data + i, _mm256_mul_ps(_x, sigmoid256_ps(_x)));
+    }
+#endif
+    for (; i < size; i++) {
+        output_data[i] = silu(input_data[i]);
+    }
+    return CSINN_TRUE;
+}
+
+int shl_ref_silu_quant(struct csinn_tensor *input, struct csinn_tensor *output,
+                       struct csinn_siso_params *params)
+{
+    return shl_ref_siso_callback_base(input, output, params, shl_ref_silu_f32);
+}
+
+int shl_ref_silu_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params)
+{
+    return shl_ref_siso_lut_init(input, output, params, shl_ref_silu_f32);
+}
@@ -18,8 +18,76 @@
 
 /* CSI-NN2 version 2.0.x */
 
+#include "avx_mathfun.h"
 #include "shl_ref.h"
 
+/*
+ * Softmax and log_softmax over a contiguous row, when the axis is the innermost dimension.
+ * exp(x - max) is computed once, softmax stores it to the output and scales it by 1 / sum.
+ */
+float shl_ref_softmax_row_max(const float *in, int cnt)
+{
+    float max = -FLT_MAX;
+    int j = 0;
+#ifdef SHL_AVX_OPT
+    if (cnt >= 8) {
+        __m256 _max = _mm256_loadu_ps(in);
+        for (j = 8; j + 7 < cnt; j += 8) {
+            _max = _mm256_max_ps(_max, _mm256_loadu_ps(in + j));
+        }
+        max = hmax256_ps(_max);
+    }
+#endif
+    for (; j < cnt; j++) {
+        max = fmax(max, in[j]);
+    }
+    return max;
+}
+
+/* sum of exp(x - max), the exps are stored to out when it is not NULL */
+float shl_ref_softmax_row_exp_sum(const float *in, float *out, int cnt, float max)
+{
+    float sum = 0.0f;
+    int j = 0;
+#ifdef SHL_AVX_OPT
+    __m256 _sum = _mm256_setzero_ps();
+    __m256 _max = _mm256_set1_ps(max);
+    for (; j + 7 < cnt; j += 8) {
+        __m256 _e = exp256_ps(_mm256_sub_ps(_mm256_loadu_ps(in + j), _max));
+        if (out != NULL) {
+            _mm256_storeu_ps(out + j, _e);
+        }
+        _sum = _mm256_add_ps(_sum, _e);
+    }
+    sum = hsum256_ps(_sum);
+#endif
+    for (; j < cnt; j++) {
+        float e = exp(in[j] - max);
+        if (out != NULL) {
+            out[j] = e;
+        }
+        sum += e;
+    }
+    return sum;
+}
+
+/* out = in * scale + bias */
+void shl_ref_softmax_row_affine(const float *in, float *out, int cnt, float scale,
+                                 float bias)
+{
+    int j = 0;
+#ifdef SHL_AVX_OPT
+    __m256 _scale = _mm256_set1_ps(scale);
+    __m256 _bias = _mm256_set1_ps(bias);
+    for (; j + 7 < cnt; j += 8) {
+        _mm256_storeu_ps(out + j, _mm256_fmadd_ps(_mm256_loadu_ps(in + j), _scale, _bias));
+    }
+#endif
+    for (; j < cnt; j++) {
+        out[j] = in[j] * scale + bias;
+    }
+}
+
 int shl_ref_softmax_f32(struct csinn_tensor *input, struct csinn_tensor *output,
                         struct csinn_softmax_params *params)
 {
@@ -40,30 +108,46 @@ int shl_ref_softmax_f32(struct csinn_tensor *input, struct csinn_tensor *output,
 
     int cnt = input->dim[axis];
 
+    int thread_num = shl_ref_get_thread_num(&params->base);
+    if (inner_size == 1) {
+#pragma omp parallel for num_threads(thread_num)
+        for (int i = 0; i < outer_size; i++) {
+            float *in_ptr = input_data + i * cnt;
+            float *out_ptr = output_data + i * cnt;
+            float max = shl_ref_softmax_row_max(in_ptr, cnt);
+            float acc_exp = shl_ref_softmax_row_exp_sum(in_ptr, out_ptr, cnt, max);
+            shl_ref_softmax_row_affine(out_ptr, out_ptr, cnt, 1.0f / acc_exp, 0.0f);
+        }
+        return CSINN_TRUE;
+    }
+
+#pragma omp parallel for num_threads(thread_num) collapse(2)
     for (int i = 0; i < outer_size; i++) {
         for (int k = 0; k < inner_size; k++) {
+            float *in_ptr = input_data + i * inner_size * cnt + k;
+            float *out_ptr = output_data + i * inner_size * cnt + k;
             float acc_exp = 0.0f;
             float max = -FLT_MAX;
             // Find max element value which we'll use to ensure numerical stability
             // taking advantage of the following equality:
             // exp(x[i])/sum(exp(x[i])) == exp(x[i]+C)/sum(exp(x[i]+C))
             for (int j = 0; j < cnt; j++) {
-                max = fmax(max, *(input_data + j * inner_size + k));
+                max = fmax(max, *(in_ptr + j * inner_size));
             }
 
-            // compute sum
+            // compute sum, the exps are kept in the output
             for (int j = 0; j < cnt; j++) {
-                acc_exp += exp(*(input_data + j * inner_size + k) - max);
+                float e = exp(*(in_ptr + j * inner_size) - max);
+                *(out_ptr + j * inner_size) = e;
+                acc_exp += e;
             }
 
             // compute final result
+            float scale = 1.0f / acc_exp;
             for (int j = 0; j < cnt; j++) {
-                *(output_data + j * inner_size + k) =
-                    exp(*(input_data + j * inner_size + k) - max) / acc_exp;
+                *(out_ptr + j * inner_size) *= scale;
             }
         }
-        input_data += inner_size * cnt;
-        output_data += inner_size * cnt;
     }
     return CSINN_TRUE;
 }
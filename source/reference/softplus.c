@@ -18,6 +18,7 @@
 
 /* CSI-NN2 version 2.0.x */
 
+#include "avx_mathfun.h"
 #include "shl_ref.h"
 
 int shl_ref_softplus_f32(struct csinn_tensor *input, struct csinn_tensor *output,
@@ -29,7 +30,18 @@ int shl_ref_softplus_f32(struct csinn_tensor *input, struct csinn_tensor *output
     for (int i = 0; i < input->dim_count; i++) {
         size = size * input->dim[i];
     }
-    for (int i = 0; i < size; i++) {
+    int i = 0;
+#ifdef SHL_AVX_OPT
+    for (; i + 7 < size; i += 8) {
+        /* max(x, 0) + log1p(exp(-|x|)) does not overflow */
+        __m256 _x = _mm256_loadu_ps(input_data + i);
+        __m256 _ax = _mm256_andnot_ps(_mm256_set1_ps(-0.0f), _x);
+        __m256 _e = exp256_ps(_mm256_sub_ps(_mm256_setzero_ps(), _ax));
+        _mm256_storeu_ps(output_data + i,
+                         _mm256_add_ps(_mm256_max_ps(_x, _mm256_setzero_ps()), log1p256_ps(_e)));
+    }
+#endif
+    for (; i < size; i++) {
         output_data[i] = log(1 + exp(input_data[i]));
     }
     return CSINN_TRUE;
@@ -40,3 +52,9 @@ int shl_ref_softplus_quant(struct csinn_tensor *input, struct csinn_tensor *outp
 {
     return shl_ref_siso_callback_base(input, output, params, shl_ref_softplus_f32);
 }
+
+int shl_ref_softplus_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                          struct csinn_siso_params *params)
+{
+    return shl_ref_siso_lut_init(input, output, params, shl_ref_softplus_f32);
+}
@@ -18,6 +18,7 @@
 
 /* CSI-NN2 version 2.0.x */
 
+#include "avx_mathfun.h"
 #include "shl_ref.h"
 
 int shl_ref_tanh_f32(struct csinn_tensor *input, struct csinn_tensor *output,
@@ -27,7 +28,14 @@ int shl_ref_tanh_f32(struct csinn_tensor *input, struct csinn_tensor *output,
     float *output_data = output->data;
     int size = csinn_tensor_size(input);
 
-    for (int i = 0; i < size; i++) {
+    int i = 0;
+#ifdef SHL_AVX_OPT
+    for (; i + 7 < size; i += 8) {
+        __m256 _x = _mm256_loadu_ps(input_data + i);
+        _mm256_storeu_ps(output_data + i, tanh256_ps(_x));
+    }
+#endif
+    for (; i < size; i++) {
         output_data[i] = tanh(input_data[i]);
     }
     return CSINN_TRUE;
@@ -51,3 +59,9 @@ int shl_ref_tanh_quant(struct csinn_tensor *input, struct csinn_tensor *output,
 {
     return shl_ref_siso_callback_base(input, output, params, shl_ref_tanh_f32);
 }
+
+int shl_ref_tanh_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_siso_params *params)
+{
+    return shl_ref_siso_lut_init(input, output, params, shl_ref_tanh_f32);
+}
@@ -44,3 +44,9 @@ int shl_ref_threshold_relu_quant(struct csinn_tensor *input, struct csinn_tensor
 {
     return shl_ref_siso_callback_base(input, output, params, shl_ref_threshold_relu_f32);
 }
+
+int shl_ref_threshold_relu_init(struct csinn_tensor *input, struct csinn_tensor *output,
+                                struct csinn_relu_params *params)
+{
+    return shl_ref_siso_lut_init(input, output, params, shl_ref_threshold_relu_f32);
+}
@@ -19,7 +19,83 @@
 /* CSI-NN2 version 2.0.x */
 
 #include "shl_ref.h"
+#ifdef SHL_AVX_OPT
+#include <immintrin.h>
+#endif
 
+/* a ranks before b: larger value, ties by smaller index */
+static inline bool topk_before(float va, int32_t ia, float vb, int32_t ib)
+{
+    return va > vb || (va == vb && ia < ib);
+}
+
+/* min-heap of the k best so far, root = the one that ranks last */
+static void topk_sift_down(float *values, int32_t *indices, int size, int i)
+{
+    while (1) {
+        int last = i;
+        int l = 2 * i + 1;
+        int r = l + 1;
+        if (l < size && topk_before(values[last], indices[last], values[l], indices[l])) {
+            last = l;
+        }
+        if (r < size && topk_before(values[last], indices[last], values[r], indices[r])) {
+            last = r;
+        }
+        if (last == i) {
+            return;
+        }
+        float v = values[i];
+        int32_t idx = indices[i];
+        values[i] = values[last];
+        indices[i] = indices[last];
+        values[last] = v;
+        indices[last] = idx;
+        i = last;
+    }
+}
+
+void shl_ref_topk_heap_push(float *values, int32_t *indices, int *size, int k, float value,
+                            int32_t index)
+{
+    if (*size < k) {
+        int i = (*size)++;
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (!topk_before(values[parent], indices[parent], value, index)) {
+                break;
+            }
+            values[i] = values[parent];
+            indices[i] = indices[parent];
+            i = parent;
+        }
+        values[i] = value;
+        indices[i] = index;
+    } else if (topk_before(value, index, values[0], indices[0])) {
+        values[0] = value;
+        indices[0] = index;
+        topk_sift_down(values, indices, k, 0);
+    }
+}
+
+/* in place, the heap becomes best first */
+void shl_ref_topk_heap_sort(float *values, int32_t *indices, int size)
+{
+    for (int n = size - 1; n > 0; n--) {
+        float v = values[0];
+        int32_t idx = indices[0];
+        values[0] = values[n];
+        indices[0] = indices[n];
+        values[n] = v;
+        indices[n] = idx;
+        topk_sift_down(values, indices, n, 0);
+    }
+}
+
+/*************************************************************
+ * per row a heap of the k best, O(n log k) instead of k scans of the row,
+ * built directly in the outputs; ties keep the smaller index first
+ *************************************************************/
 int shl_ref_topk_f32(struct csinn_tensor *input, struct csinn_tensor *output1,
                      struct csinn_tensor *output2, struct csinn_topk_params *params)
 {
@@ -33,24 +109,34 @@ int shl_ref_topk_f32(struct csinn_tensor *input, struct csinn_tensor *output1,
     for (int i = 0; i < input->dim_count - 1; i++) {
         inner_size *= input->dim[i];
     }
-    float *input_sort_addr = input_data;
+    int thread_num = shl_ref_get_thread_num(&params->base);
+
+#pragma omp parallel for num_threads(thread_num)
     for (int n = 0; n < inner_size; n++) {
-        int *flag = (int *)shl_mem_alloc(last_dim * sizeof(int));
-        for (int i = 0; i < k; i++) {
-            values_data[i] = -FLT_MAX;
-            for (int j = 0; j < last_dim; j++) {
-                if (input_sort_addr[j] > values_data[i] && !flag[j]) {
-                    values_data[i] = input_sort_addr[j];
-                    indices_data[i] = j;
+        const float *row = input_data + (int64_t)n * last_dim;
+        float *values = values_data + (int64_t)n * k;
+        int32_t *indices = indices_data + (int64_t)n * k;
+        int size = 0;
+        int j = 0;
+        for (; j < last_dim && size < k; j++) {
+            shl_ref_topk_heap_push(values, indices, &size, k, row[j], j);
+        }
+#ifdef SHL_AVX_OPT
+        // with a full heap only values above the root can enter, skip blocks without one
+        for (; j + 7 < last_dim; j += 8) {
+            __m256 _gt =
+                _mm256_cmp_ps(_mm256_loadu_ps(row + j), _mm256_set1_ps(values[0]), _CMP_GT_OQ);
+            if (_mm256_movemask_ps(_gt)) {
+                for (int t = j; t < j + 8; t++) {
+                    shl_ref_topk_heap_push(values, indices, &size, k, row[t], t);
                 }
             }
-            flag[indices_data[i]] = 1;
         }
-        shl_mem_free(flag);
-        flag = NULL;
-        input_sort_addr += last_dim;
-        values_data += k;
-        indices_data += k;
+#endif
+        for (; j < last_dim; j++) {
+            shl_ref_topk_heap_push(values, indices, &size, k, row[j], j);
+        }
+        shl_ref_topk_heap_sort(values, indices, size);
     }
     return CSINN_TRUE;
 }
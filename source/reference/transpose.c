@@ -19,6 +19,12 @@
 /* CSI-NN2 version 2.0.x */
 
 #include "shl_ref.h"
+#ifdef SHL_AVX_OPT
+#include <immintrin.h>
+#endif
+
+/* edge of the square tile the 2-D kernel moves at a time */
+#define TRANSPOSE_TILE 8
 
 int shl_ref_transpose_init(struct csinn_tensor *input, struct csinn_tensor *output,
                            struct csinn_transpose_params *params)
@@ -36,50 +42,268 @@ int shl_ref_transpose_init(struct csinn_tensor *input, struct csinn_tensor *outp
     return CSINN_TRUE;
 }
 
-static void copy_element(struct csinn_tensor *input, struct csinn_tensor *output, int input_idx,
-                         int output_idx)
+/*************************************************************
+ * describe the permute as a walk over the output in row-major order:
+ * shape[i] is the size of output axis i, in_stride[i] its step in the input (elements)
+ * size-1 axes are dropped and output axes that stay adjacent in the input are merged,
+ * so e.g. [0, 2, 3, 1] on NCHW becomes the 2-D transpose [N][HW][C] <- [N][C][HW]
+ * returns the collapsed rank, 0 for a single element
+ *************************************************************/
+int shl_ref_transpose_collapse(struct csinn_tensor *input, int32_t *permute, int permute_num,
+                               int64_t *shape, int64_t *in_stride)
 {
-    if (input->dtype == CSINN_DTYPE_FLOAT32) {
-        float *src32 = input->data;
-        float *dest32 = output->data;
-        dest32[output_idx] = src32[input_idx];
-    } else if (input->dtype == CSINN_DTYPE_UINT8 || input->dtype == CSINN_DTYPE_INT8) {
-        int8_t *src8 = input->data;
-        int8_t *dest8 = output->data;
-        dest8[output_idx] = src8[input_idx];
-    } else if (input->dtype == CSINN_DTYPE_INT16 || input->dtype == CSINN_DTYPE_FLOAT16) {
-        int16_t *src16 = input->data;
-        int16_t *dest16 = output->data;
-        dest16[output_idx] = src16[input_idx];
+    int64_t stride[MAX_DIM];
+    int64_t s = 1;
+    for (int d = permute_num - 1; d >= 0; d--) {
+        stride[d] = s;
+        s *= input->dim[d];
+    }
+    int rank = 0;
+    for (int i = 0; i < permute_num; i++) {
+        int d = permute[i];
+        int64_t n = input->dim[d];
+        if (n == 1) {
+            continue;
+        }
+        if (rank > 0 && in_stride[rank - 1] == stride[d] * n) {
+            shape[rank - 1] *= n;
+            in_stride[rank - 1] = stride[d];
+        } else {
+            shape[rank] = n;
+            in_stride[rank] = stride[d];
+            rank++;
+        }
+    }
+    return rank;
+}
+
+/* n contiguous elements, through the requant table when there is one */
+static void transpose_copy_row(const uint8_t *src, uint8_t *dst, int64_t n, int elem_size,
+                               const uint8_t *lut)
+{
+    if (lut == NULL) {
+        memcpy(dst, src, n * elem_size);
+        return;
+    }
+    for (int64_t i = 0; i < n; i++) {
+        dst[i] = lut[src[i]];
+    }
+}
+
+#ifdef SHL_AVX_OPT
+/* dst[i][j] = src[j][i] for one full 8x8 fp32 tile */
+static void transpose_tile8x8_avx(const float *src, int64_t src_ld, float *dst, int64_t dst_ld)
+{
+    __m256 _r0 = _mm256_loadu_ps(src);
+    __m256 _r1 = _mm256_loadu_ps(src + src_ld);
+    __m256 _r2 = _mm256_loadu_ps(src + src_ld * 2);
+    __m256 _r3 = _mm256_loadu_ps(src + src_ld * 3);
+    __m256 _r4 = _mm256_loadu_ps(src + src_ld * 4);
+    __m256 _r5 = _mm256_loadu_ps(src + src_ld * 5);
+    __m256 _r6 = _mm256_loadu_ps(src + src_ld * 6);
+    __m256 _r7 = _mm256_loadu_ps(src + src_ld * 7);
+
+    __m256 _t0 = _mm256_unpacklo_ps(_r0, _r1);
+    __m256 _t1 = _mm256_unpackhi_ps(_r0, _r1);
+    __m256 _t2 = _mm256_unpacklo_ps(_r2, _r3);
+    __m256 _t3 = _mm256_unpackhi_ps(_r2, _r3);
+    __m256 _t4 = _mm256_unpacklo_ps(_r4, _r5);
+    __m256 _t5 = _mm256_unpackhi_ps(_r4, _r5);
+    __m256 _t6 = _mm256_unpacklo_ps(_r6, _r7);
+    __m256 _t7 = _mm256_unpackhi_ps(_r6, _r7);
+
+    _r0 = _mm256_shuffle_ps(_t0, _t2, _MM_SHUFFLE(1, 0, 1, 0));
+    _r1 = _mm256_shuffle_ps(_t0, _t2, _MM_SHUFFLE(3, 2, 3, 2));
+    _r2 = _mm256_shuffle_ps(_t1, _t3, _MM_SHUFFLE(1, 0, 1, 0));
+    _r3 = _mm256_shuffle_ps(_t1, _t3, _MM_SHUFFLE(3, 2, 3, 2));
+    _r4 = _mm256_shuffle_ps(_t4, _t6, _MM_SHUFFLE(1, 0, 1, 0));
+    _r5 = _mm256_shuffle_ps(_t4, _t6, _MM_SHUFFLE(3, 2, 3, 2));
+    _r6 = _mm256_shuffle_ps(_t5, _t7, _MM_SHUFFLE(1, 0, 1, 0));
+    _r7 = _mm256_shuffle_ps(_t5, _t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+    _mm256_storeu_ps(dst, _mm256_permute2f128_ps(_r0, _r4, 0x20));
+    _mm256_storeu_ps(dst + dst_ld, _mm256_permute2f128_ps(_r1, _r5, 0x20));
+    _mm256_storeu_ps(dst + dst_ld * 2, _mm256_permute2f128_ps(_r2, _r6, 0x20));
+    _mm256_storeu_ps(dst + dst_ld * 3, _mm256_permute2f128_ps(_r3, _r7, 0x20));
+    _mm256_storeu_ps(dst + dst_ld * 4, _mm256_permute2f128_ps(_r0, _r4, 0x31));
+    _mm256_storeu_ps(dst + dst_ld * 5, _mm256_permute2f128_ps(_r1, _r5, 0x31));
+    _mm256_storeu_ps(dst + dst_ld * 6, _mm256_permute2f128_ps(_r2, _r6, 0x31));
+    _mm256_storeu_ps(dst + dst_ld * 7, _mm256_permute2f128_ps(_r3, _r7, 0x31));
+}
+#endif
+
+#define TRANSPOSE_TILE_SCALAR(type)                                   \
+    {                                                                 \
+        const type *s = (const type *)src;                            \
+        type *d = (type *)dst;                                        \
+        for (int i = 0; i < rows; i++) {                              \
+            for (int j = 0; j < cols; j++) {                          \
+                d[i * dst_ld + j] = s[j * src_ld + i];                \
+            }                                                         \
+        }                                                             \
+    }
+
+/* dst[i][j] = src[j][i], i < rows, j < cols, leading dims in elements */
+static void transpose_tile(const uint8_t *src, int64_t src_ld, uint8_t *dst, int64_t dst_ld,
+                           int rows, int cols, int elem_size, const uint8_t *lut)
+{
+#ifdef SHL_AVX_OPT
+    if (elem_size == 4 && rows == 8 && cols == 8) {
+        transpose_tile8x8_avx((const float *)src, src_ld, (float *)dst, dst_ld);
+        return;
+    }
+#endif
+    if (lut != NULL) {
+        for (int i = 0; i < rows; i++) {
+            for (int j = 0; j < cols; j++) {
+                dst[i * dst_ld + j] = lut[src[j * src_ld + i]];
+            }
+        }
+    } else if (elem_size == 1) {
+        TRANSPOSE_TILE_SCALAR(uint8_t)
+    } else if (elem_size == 2) {
+        TRANSPOSE_TILE_SCALAR(uint16_t)
+    } else if (elem_size == 4) {
+        TRANSPOSE_TILE_SCALAR(uint32_t)
     } else {
-        shl_debug_error("Transpose unsupport dtype\n");
+        TRANSPOSE_TILE_SCALAR(uint64_t)
     }
 }
 
-static void swap(int32_t *out_idx, int32_t *in_idx, struct csinn_tensor *input,
-                 struct csinn_tensor *output, int32_t *perm, int iter_count)
+/* outer index -> input and output offsets over the collapsed axes [0, axes), skipping skip */
+static void transpose_outer_offset(int64_t outer, const int64_t *shape, const int64_t *in_stride,
+                                   const int64_t *out_stride, int axes, int skip,
+                                   int64_t *in_ofs, int64_t *out_ofs)
 {
-    for (out_idx[iter_count] = 0; out_idx[iter_count] < output->dim[iter_count];
-         out_idx[iter_count]++) {
-        in_idx[perm[iter_count]] = out_idx[iter_count];
-        if (iter_count == 0) {
-            int input_idx = shl_ref_get_index_iter(input->dim, input->dim_count - 1, in_idx);
-            int output_idx = shl_ref_get_index_iter(output->dim, output->dim_count - 1, out_idx);
-            copy_element(input, output, input_idx, output_idx);
-        } else {
-            swap(out_idx, in_idx, input, output, perm, iter_count - 1);
+    int64_t in = 0;
+    int64_t out = 0;
+    for (int d = axes - 1; d >= 0; d--) {
+        if (d == skip) {
+            continue;
         }
+        int64_t idx = outer % shape[d];
+        outer /= shape[d];
+        in += idx * in_stride[d];
+        out += idx * out_stride[d];
+    }
+    *in_ofs = in;
+    *out_ofs = out;
+}
+
+/*************************************************************
+ * move the collapsed permute from src to dst, lut (8-bit only) requantizes on the way
+ * innermost input-contiguous: rows are copied whole
+ * otherwise the input-contiguous axis p and the last axis form a 2-D transpose,
+ * done in TRANSPOSE_TILE strips of p so reads and writes both stay on a few cache lines
+ *************************************************************/
+void shl_ref_transpose_run(const void *src, void *dst, int elem_size, int rank,
+                           const int64_t *shape, const int64_t *in_stride, const uint8_t *lut,
+                           int thread_num)
+{
+    const uint8_t *in = src;
+    uint8_t *out = dst;
+    if (rank == 0) {
+        transpose_copy_row(in, out, 1, elem_size, lut);
+        return;
+    }
+
+    int64_t out_stride[MAX_DIM];
+    out_stride[rank - 1] = 1;
+    for (int d = rank - 2; d >= 0; d--) {
+        out_stride[d] = out_stride[d + 1] * shape[d + 1];
+    }
+
+    if (in_stride[rank - 1] == 1) {
+        int64_t row = shape[rank - 1];
+        int64_t outer = out_stride[0] * shape[0] / row;
+#pragma omp parallel for num_threads(thread_num)
+        for (int64_t o = 0; o < outer; o++) {
+            int64_t in_ofs, out_ofs;
+            transpose_outer_offset(o, shape, in_stride, out_stride, rank - 1, -1, &in_ofs,
+                                   &out_ofs);
+            transpose_copy_row(in + in_ofs * elem_size, out + out_ofs * elem_size, row, elem_size,
+                               lut);
+        }
+        return;
+    }
+
+    int p = 0;
+    while (in_stride[p] != 1) {
+        p++;
+    }
+    int64_t rows = shape[p];
+    int64_t cols = shape[rank - 1];
+    int64_t src_ld = in_stride[rank - 1];
+    int64_t dst_ld = out_stride[p];
+    int64_t strips = (rows + TRANSPOSE_TILE - 1) / TRANSPOSE_TILE;
+    int64_t outer = out_stride[0] * shape[0] / (rows * cols);
+
+#pragma omp parallel for num_threads(thread_num)
+    for (int64_t t = 0; t < outer * strips; t++) {
+        int64_t in_ofs, out_ofs;
+        transpose_outer_offset(t / strips, shape, in_stride, out_stride, rank - 1, p, &in_ofs,
+                               &out_ofs);
+        int64_t i = (t % strips) * TRANSPOSE_TILE;
+        int tile_rows = rows - i < TRANSPOSE_TILE ? rows - i : TRANSPOSE_TILE;
+        const uint8_t *s = in + (in_ofs + i) * elem_size;
+        uint8_t *d = out + (out_ofs + i * dst_ld) * elem_size;
+        for (int64_t j = 0; j < cols; j += TRANSPOSE_TILE) {
+            int tile_cols = cols - j < TRANSPOSE_TILE ? cols - j : TRANSPOSE_TILE;
+            transpose_tile(s + j * src_ld * elem_size, src_ld, d + j * elem_size, dst_ld,
+                           tile_rows, tile_cols, elem_size, lut);
+        }
+    }
+}
+
+/* q_out = quantize(dequantize(q_in)) for every 8-bit value, the same math as the float path */
+static void transpose_requant_table(struct csinn_tensor *input, struct csinn_tensor *output,
+                                    uint8_t *lut)
+{
+    float value[256];
+    float in_scale = input->qinfo->scale;
+    float in_zp = input->qinfo->zero_point;
+    float out_scale = output->qinfo->scale;
+    float out_zp = output->qinfo->zero_point;
+    if (input->dtype == CSINN_DTYPE_INT8) {
+        int8_t q[256];
+        for (int i = 0; i < 256; i++) {
+            q[i] = (int8_t)i;
+        }
+        shl_dequantize_i8_to_f32(q, value, 256, &in_scale, &in_zp, false, 1);
+        shl_quantize_f32_to_i8(value, (int8_t *)lut, 256, &out_scale, &out_zp, false, 1);
+    } else {
+        uint8_t q[256];
+        for (int i = 0; i < 256; i++) {
+            q[i] = (uint8_t)i;
+        }
+        shl_dequantize_u8_to_f32(q, value, 256, &in_scale, &in_zp, false, 1);
+        shl_quantize_f32_to_u8(value, lut, 256, &out_scale, &out_zp, false, 1);
     }
 }
 
 int shl_ref_transpose(struct csinn_tensor *input, struct csinn_tensor *output,
                       struct csinn_transpose_params *params)
 {
-    const int unextended_output_size = output->dim_count;
-    int32_t *o = shl_mem_alloc(unextended_output_size * sizeof(int32_t));
-    int32_t *i = shl_mem_alloc(unextended_output_size * sizeof(int32_t));
-    if (input->dtype != CSINN_DTYPE_FLOAT32 && input->qinfo->scale != output->qinfo->scale &&
-        input->qinfo->zero_point != output->qinfo->zero_point) {
+    int64_t shape[MAX_DIM];
+    int64_t in_stride[MAX_DIM];
+    int elem_size = shl_ref_dtype_byte(input->dtype);
+    bool requant8 = input->dtype == output->dtype &&
+                    (input->dtype == CSINN_DTYPE_INT8 || input->dtype == CSINN_DTYPE_UINT8) &&
+                    input->quant_channel <= 1 && output->quant_channel <= 1;
+
+    if (elem_size > 0 && shl_ref_same_quant(input, output)) {
+        int rank = shl_ref_transpose_collapse(input, params->permute, params->permute_num, shape,
+                                              in_stride);
+        shl_ref_transpose_run(input->data, output->data, elem_size, rank, shape, in_stride, NULL,
+                              shl_ref_get_thread_num(&params->base));
+    } else if (requant8) {
+        uint8_t lut[256];
+        transpose_requant_table(input, output, lut);
+        int rank = shl_ref_transpose_collapse(input, params->permute, params->permute_num, shape,
+                                              in_stride);
+        shl_ref_transpose_run(input->data, output->data, 1, rank, shape, in_stride, lut,
+                              shl_ref_get_thread_num(&params->base));
+    } else {
         int ret;
         struct csinn_tensor *finput = shl_ref_tensor_transform_f32(input);
         struct csinn_tensor *foutput = shl_ref_tensor_transform_f32(output);
@@ -87,16 +311,14 @@ int shl_ref_transpose(struct csinn_tensor *input, struct csinn_tensor *output,
         csinn_tensor_data_convert(output, foutput);
         shl_ref_tensor_transform_free_f32(finput);
         shl_ref_tensor_transform_free_f32(foutput);
-    } else {
-        swap(o, i, input, output, params->permute, unextended_output_size - 1);
+        return ret;
     }
-    shl_mem_free(o);
-    shl_mem_free(i);
     return CSINN_TRUE;
 }
 
 int shl_ref_transpose_quant(struct csinn_tensor *input, struct csinn_tensor *output,
                             struct csinn_transpose_params *params)
 {
-    return shl_ref_siso_callback_base(input, output, params, shl_ref_transpose);
+    /* requantization is folded into the move, see shl_ref_transpose */
+    return shl_ref_transpose(input, output, params);
 }
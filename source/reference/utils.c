@@ -19,6 +19,9 @@
 /* CSI-NN2 version 2.0.x */
 
 #include <time.h>
+#ifdef SHL_AVX_OPT
+#include <immintrin.h>
+#endif
 
 #include "shl_ref.h"
 
@@ -52,16 +55,13 @@ int32_t shl_ref_get_index_5(int32_t *dim, int32_t index0, int32_t index1, int32_
     return dim[4] * (dim[3] * (dim[2] * (dim[1] * index0 + index1) + index2) + index3) + index4;
 }
 
-/* iteration to calculate index */
+/* row-major linear index of index[0..dim_idx] */
 int32_t shl_ref_get_index_iter(int32_t *dim, int dim_idx, int32_t *index)
 {
-    int32_t ret;
-    if (dim_idx > 0) {
-        ret = shl_ref_get_index_iter(dim, dim_idx - 1, index) * dim[dim_idx] + index[dim_idx];
-    } else {
-        ret = index[dim_idx];
+    int32_t ret = index[0];
+    for (int i = 1; i <= dim_idx; i++) {
+        ret = ret * dim[i] + index[i];
     }
-
     return ret;
 }
 
@@ -129,6 +129,49 @@ int shl_ref_diso_broadcast_base(struct csinn_tensor *input0, struct csinn_tensor
     return CSINN_TRUE;
 }
 
+/* threads for the intra-op loops of a reference kernel */
+int shl_ref_get_thread_num(struct csinn_params_base *base)
+{
+    return shl_get_thread_num(base != NULL ? base->sess : NULL);
+}
+
+/* partial sums of a fixed chunk size, so the rounding does not follow the thread count */
+#define SHL_REF_SUM_CHUNK 4096
+
+/*
+ * Sum (or sum of exp) over a whole buffer. The buffer is summed in fixed chunks that are
+ * combined in order, so the result does not depend on the number of threads. With
+ * sess->unordered_reduce an OpenMP reduction is used instead and the last bits may vary.
+ */
+float shl_ref_sum_all_f32(float *data, int64_t size, bool exp_sum, struct csinn_params_base *base)
+{
+    int thread_num = shl_ref_get_thread_num(base);
+    float res = 0.0f;
+    if (base != NULL && base->sess != NULL && base->sess->unordered_reduce) {
+#pragma omp parallel for num_threads(thread_num) reduction(+ : res)
+        for (int64_t j = 0; j < size; j++) {
+            res += exp_sum ? exp(data[j]) : data[j];
+        }
+    } else {
+        int64_t chunk_num = (size + SHL_REF_SUM_CHUNK - 1) / SHL_REF_SUM_CHUNK;
+        float *partial = shl_mem_alloc(chunk_num * sizeof(float));
+#pragma omp parallel for num_threads(thread_num)
+        for (int64_t c = 0; c < chunk_num; c++) {
+            int64_t end = (c + 1) * SHL_REF_SUM_CHUNK < size ? (c + 1) * SHL_REF_SUM_CHUNK : size;
+            float acc = 0.0f;
+            for (int64_t j = c * SHL_REF_SUM_CHUNK; j < end; j++) {
+                acc += exp_sum ? exp(data[j]) : data[j];
+            }
+            partial[c] = acc;
+        }
+        for (int64_t c = 0; c < chunk_num; c++) {
+            res += partial[c];
+        }
+        shl_mem_free(partial);
+    }
+    return res;
+}
+
 float shl_ref_get_scale(int32_t multiplier, int32_t shift)
 {
     float scale = multiplier / pow(2, 31) * pow(2, shift);
@@ -236,6 +279,7 @@ struct csinn_tensor *shl_ref_deconv_kernel_nchw_to_nhwc_f32(struct csinn_tensor
     struct csinn_transpose_params tparams;
     tparams.permute = permute;
     tparams.base.api = CSINN_REF;
+    tparams.base.sess = NULL;
     tparams.base.name = "internal_transpose";
     shl_ref_transpose(t, nt, &tparams);
     t->dim_count = t_dim;
@@ -270,6 +314,7 @@ struct csinn_tensor *shl_ref_nchw_to_nhwc_8(struct csinn_tensor *t)
     struct csinn_transpose_params tparams;
     tparams.permute = permute;
     tparams.base.api = CSINN_REF;
+    tparams.base.sess = NULL;
     tparams.base.name = "internal_transpose";
     shl_ref_transpose(t, nt, &tparams);
     t->dim_count = t_dim;
@@ -290,6 +335,7 @@ void shl_ref_nhwc_to_nchw_8(struct csinn_tensor *nt, struct csinn_tensor *t)
     struct csinn_transpose_params tparams;
     tparams.permute = permute;
     tparams.base.api = CSINN_REF;
+    tparams.base.sess = NULL;
     tparams.base.name = "internal_transpose";
     shl_ref_transpose(t, nt, &tparams);
 
@@ -329,6 +375,7 @@ struct csinn_tensor *shl_ref_nchw_to_nhwc_f32(struct csinn_tensor *t)
     tparams.permute = permute;
     tparams.permute_num = 4;
     tparams.base.api = CSINN_REF;
+    tparams.base.sess = NULL;
     tparams.base.name = "internal_transpose";
     shl_ref_transpose(t, nt, &tparams);
     t->dim_count = t_dim;
@@ -350,6 +397,7 @@ void shl_ref_nhwc_to_nchw_f32(struct csinn_tensor *nt, struct csinn_tensor *t)
     tparams.permute = permute;
     tparams.permute_num = 4;
     tparams.base.api = CSINN_REF;
+    tparams.base.sess = NULL;
     tparams.base.name = "internal_transpose";
     shl_ref_transpose(t, nt, &tparams);
 
@@ -380,6 +428,454 @@ int32_t shl_ref_get_reduction_index(int32_t k, const int32_t *strides, const int
     return index;
 }
 
+/*************************************************************
+ * strided iterator: walks an n-d index space in row-major order keeping the
+ * element offset, so a step is an add instead of a div/mod per axis
+ * extent-1 axes are dropped and axes that are contiguous with the next one are
+ * merged, the walk order and the offsets stay the same
+ *************************************************************/
+void shl_ref_stride_iter_init(struct shl_ref_stride_iter *iter, const int32_t *extents,
+                              const int32_t *strides, int32_t n)
+{
+    int d = 0;
+    for (int i = 0; i < n; i++) {
+        if (extents[i] == 1) {
+            continue;
+        }
+        if (d > 0 && iter->stride[d - 1] == (int64_t)strides[i] * extents[i]) {
+            iter->extent[d - 1] *= extents[i];
+            iter->stride[d - 1] = strides[i];
+        } else {
+            iter->extent[d] = extents[i];
+            iter->stride[d] = strides[i];
+            d++;
+        }
+    }
+    iter->dim_count = d;
+    shl_ref_stride_iter_seek(iter, 0);
+}
+
+int64_t shl_ref_stride_iter_size(struct shl_ref_stride_iter *iter)
+{
+    int64_t size = 1;
+    for (int d = 0; d < iter->dim_count; d++) {
+        size *= iter->extent[d];
+    }
+    return size;
+}
+
+/* jump to the pos-th position of the walk */
+void shl_ref_stride_iter_seek(struct shl_ref_stride_iter *iter, int64_t pos)
+{
+    iter->offset = 0;
+    for (int d = iter->dim_count - 1; d >= 0; d--) {
+        iter->index[d] = pos % iter->extent[d];
+        pos /= iter->extent[d];
+        iter->offset += iter->index[d] * iter->stride[d];
+    }
+}
+
+void shl_ref_stride_iter_next(struct shl_ref_stride_iter *iter)
+{
+    for (int d = iter->dim_count - 1; d >= 0; d--) {
+        iter->offset += iter->stride[d];
+        if (++iter->index[d] < iter->extent[d]) {
+            return;
+        }
+        iter->offset -= iter->stride[d] * iter->extent[d];
+        iter->index[d] = 0;
+    }
+}
+
+/* take the innermost axis off the walk so the caller can run it as a row, returns its extent */
+int64_t shl_ref_stride_iter_pop(struct shl_ref_stride_iter *iter, int64_t *stride)
+{
+    if (iter->dim_count == 0) {
+        *stride = 0;
+        return 1;
+    }
+    iter->dim_count--;
+    *stride = iter->stride[iter->dim_count];
+    shl_ref_stride_iter_seek(iter, 0);
+    return iter->extent[iter->dim_count];
+}
+
+/* outputs per task of the reduce drivers, and row elements per task when whole rows accumulate */
+#define SHL_REF_REDUCE_BLOCK 64
+#define SHL_REF_REDUCE_COLS 1024
+
+static float reduce_init_value(enum shl_ref_reduce_type type)
+{
+    switch (type) {
+        case SHL_REF_REDUCE_PROD:
+            return 1.0f;
+        case SHL_REF_REDUCE_MAX:
+            return -INFINITY;
+        case SHL_REF_REDUCE_MIN:
+            return INFINITY;
+        default:
+            return 0.0f;
+    }
+}
+
+static float reduce_combine(float acc, float val, enum shl_ref_reduce_type type)
+{
+    switch (type) {
+        case SHL_REF_REDUCE_PROD:
+            return acc * val;
+        case SHL_REF_REDUCE_MAX:
+            return acc > val ? acc : val;
+        case SHL_REF_REDUCE_MIN:
+            return acc < val ? acc : val;
+        default:
+            return acc + val;
+    }
+}
+
+static float reduce_finish(float acc, int64_t count, enum shl_ref_reduce_type type)
+{
+    if (type == SHL_REF_REDUCE_MEAN) {
+        return acc / count;
+    } else if (type == SHL_REF_REDUCE_LOGSUMEXP) {
+        return log(acc);
+    }
+    return acc;
+}
+
+/* one contiguous row, eight independent lanes so the loop vectorises */
+static float reduce_row_f32(const float *p, int64_t len, enum shl_ref_reduce_type type)
+{
+    float lane[8];
+    float init = reduce_init_value(type);
+    for (int k = 0; k < 8; k++) {
+        lane[k] = init;
+    }
+    int64_t i = 0;
+    switch (type) {
+        case SHL_REF_REDUCE_PROD:
+            for (; i + 7 < len; i += 8) {
+                for (int k = 0; k < 8; k++) {
+                    lane[k] *= p[i + k];
+                }
+            }
+            break;
+        case SHL_REF_REDUCE_MAX:
+            for (; i + 7 < len; i += 8) {
+                for (int k = 0; k < 8; k++) {
+                    lane[k] = lane[k] > p[i + k] ? lane[k] : p[i + k];
+                }
+            }
+            break;
+        case SHL_REF_REDUCE_MIN:
+            for (; i + 7 < len; i += 8) {
+                for (int k = 0; k < 8; k++) {
+                    lane[k] = lane[k] < p[i + k] ? lane[k] : p[i + k];
+                }
+            }
+            break;
+        case SHL_REF_REDUCE_LOGSUMEXP:
+            for (; i < len; i++) {
+                lane[0] += exp(p[i]);
+            }
+            break;
+        default:
+            for (; i + 7 < len; i += 8) {
+                for (int k = 0; k < 8; k++) {
+                    lane[k] += p[i + k];
+                }
+            }
+            break;
+    }
+    float acc = lane[0];
+    for (int k = 1; k < 8; k++) {
+        acc = reduce_combine(acc, lane[k], type);
+    }
+    for (; i < len; i++) {
+        acc = reduce_combine(acc, p[i], type);
+    }
+    return acc;
+}
+
+/* acc[x] = acc[x] op p[x], element-wise over a row */
+static void reduce_accumulate_f32(float *acc, const float *p, int64_t len,
+                                  enum shl_ref_reduce_type type)
+{
+    switch (type) {
+        case SHL_REF_REDUCE_PROD:
+            for (int64_t x = 0; x < len; x++) {
+                acc[x] *= p[x];
+            }
+            break;
+        case SHL_REF_REDUCE_MAX:
+            for (int64_t x = 0; x < len; x++) {
+                acc[x] = acc[x] > p[x] ? acc[x] : p[x];
+            }
+            break;
+        case SHL_REF_REDUCE_MIN:
+            for (int64_t x = 0; x < len; x++) {
+                acc[x] = acc[x] < p[x] ? acc[x] : p[x];
+            }
+            break;
+        case SHL_REF_REDUCE_LOGSUMEXP:
+            for (int64_t x = 0; x < len; x++) {
+                acc[x] += exp(p[x]);
+            }
+            break;
+        default:
+            for (int64_t x = 0; x < len; x++) {
+                acc[x] += p[x];
+            }
+            break;
+    }
+}
+
+/*************************************************************
+ * output[k] = reduction of input over the inner index space, at the k-th position of the
+ * out index space (extents/strides as in csinn_reduce_params)
+ * inner walk contiguous at its end: each output reduces whole rows
+ * out walk contiguous at its end: whole output rows accumulate one input row per inner position
+ * otherwise element by element, both walks on strided iterators
+ *************************************************************/
+void shl_ref_reduce_stride_f32(const float *input, float *output, const int32_t *out_extents,
+                               const int32_t *out_strides, int32_t n,
+                               const int32_t *inner_extents, const int32_t *inner_strides,
+                               int32_t m, enum shl_ref_reduce_type type,
+                               struct csinn_params_base *base)
+{
+    struct shl_ref_stride_iter out_iter;
+    struct shl_ref_stride_iter inner_iter;
+    shl_ref_stride_iter_init(&out_iter, out_extents, out_strides, n);
+    shl_ref_stride_iter_init(&inner_iter, inner_extents, inner_strides, m);
+    int64_t out_size = shl_ref_stride_iter_size(&out_iter);
+    int64_t inner_size = shl_ref_stride_iter_size(&inner_iter);
+    int thread_num = shl_ref_get_thread_num(base);
+    int64_t stride;
+
+    if (inner_iter.dim_count > 0 && inner_iter.stride[inner_iter.dim_count - 1] == 1) {
+        int64_t row = shl_ref_stride_iter_pop(&inner_iter, &stride);
+        int64_t rows = inner_size / row;
+        int64_t blocks = (out_size + SHL_REF_REDUCE_BLOCK - 1) / SHL_REF_REDUCE_BLOCK;
+#pragma omp parallel for num_threads(thread_num)
+        for (int64_t b = 0; b < blocks; b++) {
+            struct shl_ref_stride_iter oit = out_iter;
+            struct shl_ref_stride_iter iit = inner_iter;
+            int64_t end = (b + 1) * SHL_REF_REDUCE_BLOCK;
+            end = end < out_size ? end : out_size;
+            shl_ref_stride_iter_seek(&oit, b * SHL_REF_REDUCE_BLOCK);
+            for (int64_t o = b * SHL_REF_REDUCE_BLOCK; o < end; o++) {
+                float acc = reduce_init_value(type);
+                shl_ref_stride_iter_seek(&iit, 0);
+                for (int64_t r = 0; r < rows; r++) {
+                    acc = reduce_combine(
+                        acc, reduce_row_f32(input + oit.offset + iit.offset, row, type), type);
+                    shl_ref_stride_iter_next(&iit);
+                }
+                output[o] = reduce_finish(acc, inner_size, type);
+                shl_ref_stride_iter_next(&oit);
+            }
+        }
+    } else if (out_iter.dim_count > 0 && out_iter.stride[out_iter.dim_count - 1] == 1) {
+        int64_t len = shl_ref_stride_iter_pop(&out_iter, &stride);
+        int64_t chunks = (len + SHL_REF_REDUCE_COLS - 1) / SHL_REF_REDUCE_COLS;
+        int64_t tasks = out_size / len * chunks;
+#pragma omp parallel for num_threads(thread_num)
+        for (int64_t t = 0; t < tasks; t++) {
+            struct shl_ref_stride_iter oit = out_iter;
+            struct shl_ref_stride_iter iit = inner_iter;
+            int64_t x0 = (t % chunks) * SHL_REF_REDUCE_COLS;
+            int64_t cols = len - x0 < SHL_REF_REDUCE_COLS ? len - x0 : SHL_REF_REDUCE_COLS;
+            float *acc = output + t / chunks * len + x0;
+            shl_ref_stride_iter_seek(&oit, t / chunks);
+            for (int64_t x = 0; x < cols; x++) {
+                acc[x] = reduce_init_value(type);
+            }
+            for (int64_t k = 0; k < inner_size; k++) {
+                reduce_accumulate_f32(acc, input + oit.offset + iit.offset + x0, cols, type);
+                shl_ref_stride_iter_next(&iit);
+            }
+            for (int64_t x = 0; x < cols; x++) {
+                acc[x] = reduce_finish(acc[x], inner_size, type);
+            }
+        }
+    } else {
+        int64_t blocks = (out_size + SHL_REF_REDUCE_BLOCK - 1) / SHL_REF_REDUCE_BLOCK;
+#pragma omp parallel for num_threads(thread_num)
+        for (int64_t b = 0; b < blocks; b++) {
+            struct shl_ref_stride_iter oit = out_iter;
+            struct shl_ref_stride_iter iit = inner_iter;
+            int64_t end = (b + 1) * SHL_REF_REDUCE_BLOCK;
+            end = end < out_size ? end : out_size;
+            shl_ref_stride_iter_seek(&oit, b * SHL_REF_REDUCE_BLOCK);
+            for (int64_t o = b * SHL_REF_REDUCE_BLOCK; o < end; o++) {
+                float acc = reduce_init_value(type);
+                shl_ref_stride_iter_seek(&iit, 0);
+                for (int64_t k = 0; k < inner_size; k++) {
+                    float val = input[oit.offset + iit.offset];
+                    acc = reduce_combine(
+                        acc, type == SHL_REF_REDUCE_LOGSUMEXP ? exp(val) : val, type);
+                    shl_ref_stride_iter_next(&iit);
+                }
+                output[o] = reduce_finish(acc, inner_size, type);
+                shl_ref_stride_iter_next(&oit);
+            }
+        }
+    }
+}
+
+/* reduce along one axis of a dense tensor: [outer, cnt, inner] -> [outer, inner] */
+void shl_ref_reduce_axis_f32(const float *input, float *output, const int32_t *dim,
+                             int32_t dim_count, int32_t axis, enum shl_ref_reduce_type type,
+                             struct csinn_params_base *base)
+{
+    int32_t outer = 1;
+    int32_t inner = 1;
+    for (int i = 0; i < axis; i++) {
+        outer *= dim[i];
+    }
+    for (int i = axis + 1; i < dim_count; i++) {
+        inner *= dim[i];
+    }
+    int32_t out_extents[2] = {outer, inner};
+    int32_t out_strides[2] = {dim[axis] * inner, 1};
+    int32_t inner_extents[1] = {dim[axis]};
+    int32_t inner_strides[1] = {inner};
+    shl_ref_reduce_stride_f32(input, output, out_extents, out_strides, 2, inner_extents,
+                              inner_strides, 1, type, base);
+}
+
+/*************************************************************
+ * output[k] = position in the inner walk of the first maximum (is_max) or minimum,
+ * -1 when nothing beats -FLT_MAX / FLT_MAX
+ * minimum is the maximum of the negated values, the same three shapes as
+ * shl_ref_reduce_stride_f32
+ *************************************************************/
+void shl_ref_arg_reduce_stride_f32(const float *input, int32_t *output,
+                                   const int32_t *out_extents, const int32_t *out_strides,
+                                   int32_t n, const int32_t *inner_extents,
+                                   const int32_t *inner_strides, int32_t m, bool is_max,
+                                   struct csinn_params_base *base)
+{
+    struct shl_ref_stride_iter out_iter;
+    struct shl_ref_stride_iter inner_iter;
+    shl_ref_stride_iter_init(&out_iter, out_extents, out_strides, n);
+    shl_ref_stride_iter_init(&inner_iter, inner_extents, inner_strides, m);
+    int64_t out_size = shl_ref_stride_iter_size(&out_iter);
+    int64_t inner_size = shl_ref_stride_iter_size(&inner_iter);
+    int thread_num = shl_ref_get_thread_num(base);
+    float sign = is_max ? 1.0f : -1.0f;
+    int64_t stride;
+
+    if (out_iter.dim_count > 0 && out_iter.stride[out_iter.dim_count - 1] == 1) {
+        int64_t len = shl_ref_stride_iter_pop(&out_iter, &stride);
+        int64_t chunks = (len + SHL_REF_REDUCE_COLS - 1) / SHL_REF_REDUCE_COLS;
+        int64_t tasks = out_size / len * chunks;
+#pragma omp parallel for num_threads(thread_num)
+        for (int64_t t = 0; t < tasks; t++) {
+            struct shl_ref_stride_iter oit = out_iter;
+            struct shl_ref_stride_iter iit = inner_iter;
+            float best[SHL_REF_REDUCE_COLS];
+            int64_t x0 = (t % chunks) * SHL_REF_REDUCE_COLS;
+            int64_t cols = len - x0 < SHL_REF_REDUCE_COLS ? len - x0 : SHL_REF_REDUCE_COLS;
+            int32_t *idx = output + t / chunks * len + x0;
+            shl_ref_stride_iter_seek(&oit, t / chunks);
+            for (int64_t x = 0; x < cols; x++) {
+                best[x] = -FLT_MAX;
+                idx[x] = -1;
+            }
+            for (int64_t k = 0; k < inner_size; k++) {
+                const float *p = input + oit.offset + iit.offset + x0;
+                for (int64_t x = 0; x < cols; x++) {
+                    float v = sign * p[x];
+                    idx[x] = v > best[x] ? k : idx[x];
+                    best[x] = v > best[x] ? v : best[x];
+                }
+                shl_ref_stride_iter_next(&iit);
+            }
+        }
+        return;
+    }
+
+    /* a contiguous inner row is just the fastest-moving part of the same scan */
+    int64_t row = 1;
+    if (inner_iter.dim_count > 0 && inner_iter.stride[inner_iter.dim_count - 1] == 1) {
+        row = shl_ref_stride_iter_pop(&inner_iter, &stride);
+    }
+    int64_t rows = inner_size / row;
+    int64_t blocks = (out_size + SHL_REF_REDUCE_BLOCK - 1) / SHL_REF_REDUCE_BLOCK;
+#pragma omp parallel for num_threads(thread_num)
+    for (int64_t b = 0; b < blocks; b++) {
+        struct shl_ref_stride_iter oit = out_iter;
+        struct shl_ref_stride_iter iit = inner_iter;
+        int64_t end = (b + 1) * SHL_REF_REDUCE_BLOCK;
+        end = end < out_size ? end : out_size;
+        shl_ref_stride_iter_seek(&oit, b * SHL_REF_REDUCE_BLOCK);
+        for (int64_t o = b * SHL_REF_REDUCE_BLOCK; o < end; o++) {
+            float best = -FLT_MAX;
+            int32_t idx = -1;
+            shl_ref_stride_iter_seek(&iit, 0);
+            for (int64_t r = 0; r < rows; r++) {
+                const float *p = input + oit.offset + iit.offset;
+                for (int64_t x = 0; x < row; x++) {
+                    if (sign * p[x] > best) {
+                        best = sign * p[x];
+                        idx = r * row + x;
+                    }
+                }
+                shl_ref_stride_iter_next(&iit);
+            }
+            output[o] = idx;
+            shl_ref_stride_iter_next(&oit);
+        }
+    }
+}
+
+/* bytes per element, 0 for sub-byte types */
+int shl_ref_dtype_byte(enum csinn_dtype_enum dtype)
+{
+    switch (dtype) {
+        case CSINN_DTYPE_BOOL:
+        case CSINN_DTYPE_UINT8:
+        case CSINN_DTYPE_INT8:
+            return 1;
+        case CSINN_DTYPE_UINT16:
+        case CSINN_DTYPE_INT16:
+        case CSINN_DTYPE_FLOAT16:
+        case CSINN_DTYPE_BFLOAT16:
+            return 2;
+        case CSINN_DTYPE_UINT32:
+        case CSINN_DTYPE_INT32:
+        case CSINN_DTYPE_FLOAT32:
+            return 4;
+        case CSINN_DTYPE_FLOAT64:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+/* true when the same bits read as the same value in both tensors, so data can move as bytes */
+bool shl_ref_same_quant(struct csinn_tensor *a, struct csinn_tensor *b)
+{
+    if (a->dtype != b->dtype) {
+        return false;
+    }
+    if (a->dtype == CSINN_DTYPE_FLOAT32 || a->dtype == CSINN_DTYPE_FLOAT16 ||
+        a->dtype == CSINN_DTYPE_BFLOAT16 || a->dtype == CSINN_DTYPE_FLOAT64 ||
+        a->dtype == CSINN_DTYPE_BOOL) {
+        return true;
+    }
+    if (a->quant_channel != b->quant_channel) {
+        return false;
+    }
+    for (int i = 0; i < a->quant_channel; i++) {
+        if (a->qinfo[i].scale != b->qinfo[i].scale ||
+            a->qinfo[i].zero_point != b->qinfo[i].zero_point) {
+            return false;
+        }
+    }
+    return true;
+}
+
 float shl_ref_uint8_to_float(uint8_t i, struct csinn_tensor *t)
 {
     return ((float)i - t->qinfo->zero_point) * t->qinfo->scale;
@@ -504,6 +1000,12 @@ struct csinn_tensor *shl_ref_tensor_transform_f32(struct csinn_tensor *input)
     if (ret->dim_count == 0) {
         return ret;
     }
+    if (shl_sparse_keep(input->mtype)) {
+        /* sparse weights stay compressed, only their values are dequantized */
+        ret->mtype = input->mtype;
+        ret->data = shl_sparse_to_f32(input);
+        return ret;
+    }
     ret->data = shl_mem_alloc(csinn_tensor_size(input) * 4);
     if (csinn_tensor_data_convert(ret, input) == CSINN_TRUE) {
         return ret;
@@ -532,6 +1034,91 @@ int shl_ref_siso_callback_base(struct csinn_tensor *input, struct csinn_tensor *
     return ret;
 }
 
+/*
+ * An 8-bit elementwise op is a function of 256 input values. The table is indexed by the input
+ * bit pattern, filled by running the fp32 kernel on every dequantized input and converting the
+ * results to the output qinfo, so it matches shl_ref_siso_callback_base exactly. Ops with
+ * per-channel qinfo or other dtypes keep their exec.
+ */
+int shl_ref_siso_lut_init(struct csinn_tensor *input, struct csinn_tensor *output, void *params,
+                          void *cb)
+{
+    int (*callback)() = cb;
+    struct csinn_params_base *base = params;
+    if ((input->dtype != CSINN_DTYPE_INT8 && input->dtype != CSINN_DTYPE_UINT8) ||
+        (output->dtype != CSINN_DTYPE_INT8 && output->dtype != CSINN_DTYPE_UINT8) ||
+        input->quant_channel != 1 || output->quant_channel != 1) {
+        return CSINN_TRUE;
+    }
+
+    uint8_t index[256];
+    for (int i = 0; i < 256; i++) {
+        index[i] = i;
+    }
+    if (base->lut == NULL) {
+        base->lut = shl_mem_alloc(256);
+    }
+
+    struct csinn_tensor *qinput = csinn_alloc_tensor(NULL);
+    struct csinn_tensor *qoutput = csinn_alloc_tensor(NULL);
+    csinn_tensor_copy(qinput, input);
+    csinn_tensor_copy(qoutput, output);
+    qinput->dim_count = qoutput->dim_count = 1;
+    qinput->dim[0] = qoutput->dim[0] = 256;
+    qinput->layout = qoutput->layout = CSINN_LAYOUT_N;
+    qinput->data = index;
+    qoutput->data = base->lut;
+
+    struct csinn_tensor *finput = shl_ref_tensor_transform_f32(qinput);
+    struct csinn_tensor *foutput = shl_ref_tensor_transform_f32(qoutput);
+    int ret = callback(finput, foutput, params);
+    csinn_tensor_data_convert(qoutput, foutput);
+    shl_ref_tensor_transform_free_f32(finput);
+    shl_ref_tensor_transform_free_f32(foutput);
+    csinn_free_tensor(qinput);
+    csinn_free_tensor(qoutput);
+
+    if (ret == CSINN_TRUE) {
+        base->cb->exec = shl_ref_siso_lut_exec;
+    }
+    return ret;
+}
+
+int shl_ref_siso_lut_exec(struct csinn_tensor *input, struct csinn_tensor *output, void *params)
+{
+    struct csinn_params_base *base = params;
+    const uint8_t *lut = base->lut;
+    const uint8_t *input_data = input->data;
+    uint8_t *output_data = output->data;
+    int size = csinn_tensor_size(input);
+    int i = 0;
+#ifdef SHL_AVX_OPT
+    /*
+     * pshufb looks up 16 entries and zeroes the lanes whose index has bit 7 set. Row k is read
+     * with index ^ (k << 4), whose high nibble is 0 only in the lanes of row k; the saturating
+     * add of 0x70 sets bit 7 in all other lanes and keeps the low nibble of the selected ones.
+     */
+    __m128i rows[16];
+    for (int k = 0; k < 16; k++) {
+        rows[k] = _mm_loadu_si128((const __m128i *)(lut + k * 16));
+    }
+    const __m128i _select = _mm_set1_epi8(0x70);
+    for (; i + 16 <= size; i += 16) {
+        __m128i _idx = _mm_loadu_si128((const __m128i *)(input_data + i));
+        __m128i _acc = _mm_setzero_si128();
+        for (int k = 0; k < 16; k++) {
+            __m128i _row = _mm_adds_epu8(_mm_xor_si128(_idx, _mm_set1_epi8(k << 4)), _select);
+            _acc = _mm_or_si128(_acc, _mm_shuffle_epi8(rows[k], _row));
+        }
+        _mm_storeu_si128((__m128i *)(output_data + i), _acc);
+    }
+#endif
+    for (; i < size; i++) {
+        output_data[i] = lut[input_data[i]];
+    }
+    return CSINN_TRUE;
+}
+
 int shl_ref_diso_callback_base(struct csinn_tensor *input0, struct csinn_tensor *input1,
                                struct csinn_tensor *output, void *params, void *cb)
 {
@@ -91,6 +91,11 @@ int shl_rvv_avgpool2d_init_fp32(struct csinn_tensor *input, struct csinn_tensor
         }
     }
 
+    // any other window / stride / padding / ceil_mode
+    if (cb->exec == NULL && in_c % packn == 0) {
+        cb->exec = shl_rvv_avgpool2d_packn_fp32;
+    }
+
     if (cb->exec == NULL) {
         shl_debug_warning(
             "avgpool is not optimized to achieve under this condition on rvv, call reference func "
@@ -171,6 +176,11 @@ int shl_rvv_avgpool2d_init_fp16(struct csinn_tensor *input, struct csinn_tensor
         }
     }
 
+    // any other window / stride / padding / ceil_mode
+    if (cb->exec == NULL && in_c % packn == 0) {
+        cb->exec = shl_rvv_avgpool2d_packn_fp16;
+    }
+
     if (cb->exec == NULL) {
         shl_debug_warning(
             "avgpool is not optimized to achieve under this condition on rvv, call reference func "
@@ -206,12 +216,19 @@ int shl_rvv_avgpool2d_init_int8(struct csinn_tensor *input, struct csinn_tensor
                                        : shl_ref_global_avgpool2d_quant;
         return CSINN_TRUE;
     }
+
+    // any other window / stride / padding / ceil_mode
+    if (cb->exec == NULL && in_c % packn == 0) {
+        cb->exec = shl_rvv_avgpool2d_packn_int8;
+    }
+
     if (cb->exec == NULL) {
         shl_debug_warning(
             "avgpool is not optimized to achieve under this condition on rvv, call reference func "
             "replaced.\n");
         cb->exec = shl_ref_avgpool2d_quant;  // fixme: consider ncxhwx
     }
+    return CSINN_TRUE;
 }
 
 int shl_rvv_avgpool2d_init_int4(struct csinn_tensor *input, struct csinn_tensor *output,
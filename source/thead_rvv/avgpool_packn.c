@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_thead_rvv.h"
+
+/* clip the window of output index o to [0, in), the clipped part is padding */
+static inline void avgpool_window(int o, int stride, int pad, int kernel, int in, int *start,
+                                  int *end)
+{
+    int s = o * stride - pad;
+    int e = s + kernel;
+    *start = s > 0 ? s : 0;
+    *end = e < in ? e : in;
+}
+
+/* the divisor of one output, the padding only counts with count_include_pad */
+static inline int avgpool_count(struct csinn_pool_params *params, int h_start, int h_end,
+                                int w_start, int w_end)
+{
+    int cnt = params->count_include_pad ? params->filter_height * params->filter_width
+                                        : (h_end - h_start) * (w_end - w_start);
+    return cnt > 0 ? cnt : 1;
+}
+
+/*************************************************************
+ * note: support flexible vlen
+ * generic kernel / stride / padding / ceil_mode in packn layout.
+ * separable sum: a row pass sums over kernel_w into a [in_h, out_w] buffer, then a column
+ * pass sums over kernel_h and scales by the divisor of the clipped window.
+ *************************************************************/
+int shl_rvv_avgpool2d_packn_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                                 struct csinn_pool_params *params)
+{
+    float *input_data = (float *)input->data;
+    float *output_data = (float *)output->data;
+
+    int batch = input->dim[0];
+    int in_c = input->dim[1];
+    int in_h = input->dim[2];
+    int in_w = input->dim[3];
+    int input_size = in_c * in_h * in_w;
+
+    int out_h = output->dim[2];
+    int out_w = output->dim[3];
+    int output_size = in_c * out_h * out_w;
+
+    const int packn = csrr_vlenb() / sizeof(float);
+    const int vl = vsetvl_e32m1(packn);
+
+    float *row_sum = (float *)shl_mem_alloc(in_h * out_w * packn * sizeof(float));
+
+    for (int b = 0; b < batch; b++) {
+        for (int c = 0; c + packn - 1 < in_c; c += packn) {
+            const float *in0 = input_data + c * in_h * in_w;
+            float *out0 = output_data + c * out_h * out_w;
+
+            // row pass: [in_h, in_w] -> [in_h, out_w]
+            float *rsum = row_sum;
+            for (int h = 0; h < in_h; h++) {
+                const float *line = in0 + h * in_w * packn;
+                for (int w = 0; w < out_w; w++) {
+                    int start, end;
+                    avgpool_window(w, params->stride_width, params->pad_left,
+                                   params->filter_width, in_w, &start, &end);
+                    vfloat32m1_t _acc = vfmv_v_f_f32m1(0.0f, vl);
+                    for (int i = start; i < end; i++) {
+                        _acc = vfadd_vv_f32m1(_acc, vle32_v_f32m1(line + i * packn, vl), vl);
+                    }
+                    vse32_v_f32m1(rsum, _acc, vl);
+                    rsum += packn;
+                }
+            }
+
+            // column pass: [in_h, out_w] -> [out_h, out_w]
+            for (int h = 0; h < out_h; h++) {
+                int h_start, h_end;
+                avgpool_window(h, params->stride_height, params->pad_top, params->filter_height,
+                               in_h, &h_start, &h_end);
+                for (int w = 0; w < out_w; w++) {
+                    int w_start, w_end;
+                    avgpool_window(w, params->stride_width, params->pad_left,
+                                   params->filter_width, in_w, &w_start, &w_end);
+                    const float *col = row_sum + w * packn;
+                    vfloat32m1_t _acc = vfmv_v_f_f32m1(0.0f, vl);
+                    for (int i = h_start; i < h_end; i++) {
+                        _acc = vfadd_vv_f32m1(_acc, vle32_v_f32m1(col + i * out_w * packn, vl), vl);
+                    }
+                    int cnt = avgpool_count(params, h_start, h_end, w_start, w_end);
+                    vse32_v_f32m1(out0, vfmul_vf_f32m1(_acc, 1.0f / cnt, vl), vl);
+                    out0 += packn;
+                }
+            }
+        }
+        input_data += input_size;
+        output_data += output_size;
+    }
+    shl_mem_free(row_sum);
+    return CSINN_TRUE;
+}
+
+/* fp16 --> fp32 acc --> fp16, a large window would lose the small terms in fp16 */
+int shl_rvv_avgpool2d_packn_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                                 struct csinn_pool_params *params)
+{
+    __fp16 *input_data = (__fp16 *)input->data;
+    __fp16 *output_data = (__fp16 *)output->data;
+
+    int batch = input->dim[0];
+    int in_c = input->dim[1];
+    int in_h = input->dim[2];
+    int in_w = input->dim[3];
+    int input_size = in_c * in_h * in_w;
+
+    int out_h = output->dim[2];
+    int out_w = output->dim[3];
+    int output_size = in_c * out_h * out_w;
+
+    const int packn = csrr_vlenb() / sizeof(__fp16);
+    const int vl = vsetvl_e16m1(packn);
+
+    float *row_sum = (float *)shl_mem_alloc(in_h * out_w * packn * sizeof(float));
+
+    for (int b = 0; b < batch; b++) {
+        for (int c = 0; c + packn - 1 < in_c; c += packn) {
+            const __fp16 *in0 = input_data + c * in_h * in_w;
+            __fp16 *out0 = output_data + c * out_h * out_w;
+
+            // row pass: [in_h, in_w] -> [in_h, out_w]
+            float *rsum = row_sum;
+            for (int h = 0; h < in_h; h++) {
+                const __fp16 *line = in0 + h * in_w * packn;
+                for (int w = 0; w < out_w; w++) {
+                    int start, end;
+                    avgpool_window(w, params->stride_width, params->pad_left,
+                                   params->filter_width, in_w, &start, &end);
+                    vfloat32m2_t _acc = vfmv_v_f_f32m2(0.0f, vl);
+                    for (int i = start; i < end; i++) {
+                        _acc = vfwadd_wv_f32m2(_acc, vle16_v_f16m1(line + i * packn, vl), vl);
+                    }
+                    vse32_v_f32m2(rsum, _acc, vl);
+                    rsum += packn;
+                }
+            }
+
+            // column pass: [in_h, out_w] -> [out_h, out_w]
+            for (int h = 0; h < out_h; h++) {
+                int h_start, h_end;
+                avgpool_window(h, params->stride_height, params->pad_top, params->filter_height,
+                               in_h, &h_start, &h_end);
+                for (int w = 0; w < out_w; w++) {
+                    int w_start, w_end;
+                    avgpool_window(w, params->stride_width, params->pad_left,
+                                   params->filter_width, in_w, &w_start, &w_end);
+                    const float *col = row_sum + w * packn;
+                    vfloat32m2_t _acc = vfmv_v_f_f32m2(0.0f, vl);
+                    for (int i = h_start; i < h_end; i++) {
+                        _acc = vfadd_vv_f32m2(_acc, vle32_v_f32m2(col + i * out_w * packn, vl), vl);
+                    }
+                    int cnt = avgpool_count(params, h_start, h_end, w_start, w_end);
+                    _acc = vfmul_vf_f32m2(_acc, 1.0f / cnt, vl);
+                    vse16_v_f16m1(out0, vfncvt_f_f_w_f16m1(_acc, vl), vl);
+                    out0 += packn;
+                }
+            }
+        }
+        input_data += input_size;
+        output_data += output_size;
+    }
+    shl_mem_free(row_sum);
+    return CSINN_TRUE;
+}
+
+/* int8 --> int32 acc --> int8 */
+int shl_rvv_avgpool2d_packn_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                 struct csinn_pool_params *params)
+{
+#ifdef RVV_1_0_0
+    int8_t *input_data = (int8_t *)input->data;
+    int8_t *output_data = (int8_t *)output->data;
+
+    int batch = input->dim[0];
+    int in_c = input->dim[1];
+    int in_h = input->dim[2];
+    int in_w = input->dim[3];
+    int input_size = in_c * in_h * in_w;
+
+    int out_h = output->dim[2];
+    int out_w = output->dim[3];
+    int output_size = in_c * out_h * out_w;
+
+    const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
+    const int vl = vsetvl_e8mf2(packn);
+    const int32_t in_zp = input->qinfo->zero_point;
+    const int32_t out_zp = output->qinfo->zero_point;
+    const float real_scale = input->qinfo->scale / output->qinfo->scale;
+
+    int32_t *row_sum = (int32_t *)shl_mem_alloc(in_h * out_w * packn * sizeof(int32_t));
+
+    for (int b = 0; b < batch; b++) {
+        for (int c = 0; c + packn - 1 < in_c; c += packn) {
+            const int8_t *in0 = input_data + c * in_h * in_w;
+            int8_t *out0 = output_data + c * out_h * out_w;
+
+            // row pass: [in_h, in_w] -> [in_h, out_w]
+            int32_t *rsum = row_sum;
+            for (int h = 0; h < in_h; h++) {
+                const int8_t *line = in0 + h * in_w * packn;
+                for (int w = 0; w < out_w; w++) {
+                    int start, end;
+                    avgpool_window(w, params->stride_width, params->pad_left,
+                                   params->filter_width, in_w, &start, &end);
+                    vint32m2_t _acc = vmv_v_x_i32m2(0, vl);
+                    for (int i = start; i < end; i++) {
+                        vint32m2_t _in = vsext_vf4_i32m2(vle8_v_i8mf2(line + i * packn, vl), vl);
+                        _acc = vadd_vv_i32m2(_acc, _in, vl);
+                    }
+                    vse32_v_i32m2(rsum, _acc, vl);
+                    rsum += packn;
+                }
+            }
+
+            // column pass: [in_h, out_w] -> [out_h, out_w]
+            for (int h = 0; h < out_h; h++) {
+                int h_start, h_end;
+                avgpool_window(h, params->stride_height, params->pad_top, params->filter_height,
+                               in_h, &h_start, &h_end);
+                for (int w = 0; w < out_w; w++) {
+                    int w_start, w_end;
+                    avgpool_window(w, params->stride_width, params->pad_left,
+                                   params->filter_width, in_w, &w_start, &w_end);
+                    const int32_t *col = row_sum + w * packn;
+                    vint32m2_t _acc = vmv_v_x_i32m2(0, vl);
+                    for (int i = h_start; i < h_end; i++) {
+                        _acc = vadd_vv_i32m2(_acc, vle32_v_i32m2(col + i * out_w * packn, vl), vl);
+                    }
+                    int cnt = avgpool_count(params, h_start, h_end, w_start, w_end);
+                    // the padding is real 0, only the valid inputs carry the zero_point
+                    int valid = (h_end - h_start) * (w_end - w_start);
+                    _acc = vsub_vx_i32m2(_acc, valid * in_zp, vl);
+                    vfloat32m2_t _avg = vfcvt_f_x_v_f32m2(_acc, vl);
+                    _avg = vfmul_vf_f32m2(_avg, real_scale / cnt, vl);
+                    vint32m2_t _res = vadd_vx_i32m2(vfcvt_x_f_v_i32m2(_avg, vl), out_zp, vl);
+                    vint16m1_t _res16 = vnclip_wx_i16m1(_res, 0, vl);
+                    vse8_v_i8mf2(out0, vnclip_wx_i8mf2(_res16, 0, vl), vl);
+                    out0 += packn;
+                }
+            }
+        }
+        input_data += input_size;
+        output_data += output_size;
+    }
+    shl_mem_free(row_sum);
+    return CSINN_TRUE;
+#elif defined RVV_0_7_1
+    shl_debug_error("unsupport avgpool2d packn for int8 on rvv_spec 0.7.1\n");
+    return CSINN_FALSE;
+#endif
+}
@@ -20,6 +20,97 @@
 
 #include "shl_thead_rvv.h"
 
+static void wg_b6f3s1_packn_fp32(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_WINOGRAD;
+    params->conv_extra.kernel_tm = csinn_alloc_tensor(NULL);
+    shl_rvv_wg_b6f3s1_trans_kernel_packn_fp32(kernel, params->conv_extra.kernel_tm);
+    params->base.cb->exec = shl_rvv_wg_b6f3s1_packn_fp32;
+}
+
+static void wg_b4f3s1_packn_fp32(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_WINOGRAD;
+    params->conv_extra.kernel_tm = csinn_alloc_tensor(NULL);
+    shl_rvv_wg_b4f3s1_trans_kernel_packn_fp32(kernel, params->conv_extra.kernel_tm);
+    params->base.cb->exec = shl_rvv_wg_b4f3s1_packn_fp32;
+}
+
+static void im2col_gemm_packn_fp32(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_GEMM;
+    shl_rvv_conv_im2col_gemm_reorder_kernel_packn_fp32(kernel, params);
+    params->base.cb->exec = shl_rvv_conv_im2col_gemm_packn_fp32;
+}
+
+/* candidates of 3x3s1 packn conv2d, index 1 is the small map heuristic */
+static const struct shl_conv2d_algo conv3x3s1_packn_fp32[] = {
+    {SHL_CONV2D_ALGO_WG_B6F3S1, wg_b6f3s1_packn_fp32},
+    {SHL_CONV2D_ALGO_WG_B4F3S1, wg_b4f3s1_packn_fp32},
+    {SHL_CONV2D_ALGO_IM2COL_GEMM, im2col_gemm_packn_fp32},
+};
+
+static void wg_b6f3s1_packn_fp16(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_WINOGRAD;
+    params->conv_extra.kernel_tm = csinn_alloc_tensor(NULL);
+    shl_rvv_wg_b6f3s1_trans_kernel_packn_fp16(kernel, params->conv_extra.kernel_tm);
+    params->base.cb->exec = shl_rvv_wg_b6f3s1_packn_fp16;
+}
+
+static void wg_b4f3s1_packn_fp16(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_WINOGRAD;
+    params->conv_extra.kernel_tm = csinn_alloc_tensor(NULL);
+    shl_rvv_wg_b4f3s1_trans_kernel_packn_fp16(kernel, params->conv_extra.kernel_tm);
+    params->base.cb->exec = shl_rvv_wg_b4f3s1_packn_fp16;
+}
+
+static void im2col_gemm_packn_fp16(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_GEMM;
+    shl_rvv_conv_im2col_gemm_reorder_kernel_packn_fp16(kernel, params);
+    params->base.cb->exec = shl_rvv_conv_im2col_gemm_packn_fp16;
+}
+
+static const struct shl_conv2d_algo conv3x3s1_packn_fp16[] = {
+    {SHL_CONV2D_ALGO_WG_B6F3S1, wg_b6f3s1_packn_fp16},
+    {SHL_CONV2D_ALGO_WG_B4F3S1, wg_b4f3s1_packn_fp16},
+    {SHL_CONV2D_ALGO_IM2COL_GEMM, im2col_gemm_packn_fp16},
+};
+
+#ifdef XTHEADV
+static void wg_b4f3s1_packn_int8(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_WINOGRAD;
+    params->conv_extra.kernel_tm = csinn_alloc_tensor(NULL);
+    shl_rvv_wg_b4f3s1_trans_kernel_packn_int8(kernel, params->conv_extra.kernel_tm);
+    params->base.cb->exec = shl_rvv_wg_b4f3s1_packn_int8;
+}
+
+static void wg_b2f3s1_packn_int8(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_WINOGRAD;
+    params->conv_extra.kernel_tm = csinn_alloc_tensor(NULL);
+    shl_rvv_wg_b2f3s1_trans_kernel_packn_int8(kernel, params->conv_extra.kernel_tm);
+    params->base.cb->exec = shl_rvv_wg_b2f3s1_packn_int8;
+}
+
+static void im2col_gemm_packn_int8(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_GEMM;
+    params->conv_extra.kernel_tm = csinn_alloc_tensor(NULL);
+    shl_rvv_conv_im2col_gemm_reorder_kernel_packn_int8(kernel, params);
+    params->base.cb->exec = shl_rvv_conv_im2col_gemm_packn_int8;
+}
+
+static const struct shl_conv2d_algo conv3x3s1_packn_int8[] = {
+    {SHL_CONV2D_ALGO_WG_B4F3S1, wg_b4f3s1_packn_int8},
+    {SHL_CONV2D_ALGO_WG_B2F3S1, wg_b2f3s1_packn_int8},
+    {SHL_CONV2D_ALGO_IM2COL_GEMM, im2col_gemm_packn_int8},
+};
+#endif  // XTHEADV
+
 int shl_rvv_conv2d_init_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
                              struct csinn_tensor *kernel, struct csinn_tensor *bias,
                              struct csinn_conv2d_params *params)
@@ -38,6 +129,12 @@ int shl_rvv_conv2d_init_fp32(struct csinn_tensor *input, struct csinn_tensor *ou
 
     const int packn = csrr_vlenb() / sizeof(float);
 
+    if (shl_sparse_keep(kernel->mtype)) {
+        // no fp32 sparse kernel, the reference runs over the kept weights
+        cb->exec = shl_ref_conv2d_f32;
+        return CSINN_TRUE;
+    }
+
     // packn
     if (in_c % packn == 0 && out_c % packn == 0) {
         if (kernel_h == 1 && kernel_w == 1 && stride_h == 1 && stride_w == 1 && dalition_h == 1 &&
@@ -53,16 +150,11 @@ int shl_rvv_conv2d_init_fp32(struct csinn_tensor *input, struct csinn_tensor *ou
                 cb->exec = shl_rvv_conv_im2col_gemm_packn_fp32;
                 return CSINN_TRUE;
             } else {
-                params->conv_extra.conv_mode = CSINN_WINOGRAD;
-                struct csinn_tensor *t_kernel = csinn_alloc_tensor(NULL);
-                if ((in_h < 13) && (in_w < 13)) {
-                    shl_rvv_wg_b4f3s1_trans_kernel_packn_fp32(kernel, t_kernel);
-                    cb->exec = shl_rvv_wg_b4f3s1_packn_fp32;
-                } else {
-                    shl_rvv_wg_b6f3s1_trans_kernel_packn_fp32(kernel, t_kernel);
-                    cb->exec = shl_rvv_wg_b6f3s1_packn_fp32;
-                }
-                params->conv_extra.kernel_tm = t_kernel;
+                /* b4f3 on small maps unless tuning measured otherwise */
+                int algo = shl_conv2d_tune(input, output, kernel, bias, params,
+                                           conv3x3s1_packn_fp32, 3, (in_h < 13) && (in_w < 13),
+                                           shl_rvv_tune_core(&params->base));
+                conv3x3s1_packn_fp32[algo].prepare(kernel, params);
             }
         } else {
             params->conv_extra.conv_mode = CSINN_GEMM;
@@ -130,6 +222,12 @@ int shl_rvv_conv2d_init_fp16(struct csinn_tensor *input, struct csinn_tensor *ou
 
     const int packn = csrr_vlenb() / sizeof(__fp16);
 
+    if (shl_sparse_keep(kernel->mtype)) {
+        params->conv_extra.conv_mode = CSINN_GEMM;
+        cb->exec = shl_rvv_conv2d_sparse_fp16;
+        return CSINN_TRUE;
+    }
+
     // packn
     if (in_c % packn == 0 && out_c % packn == 0) {
         if (kernel_h == 1 && kernel_w == 1 && stride_h == 1 && stride_w == 1 && dalition_h == 1 &&
@@ -145,16 +243,10 @@ int shl_rvv_conv2d_init_fp16(struct csinn_tensor *input, struct csinn_tensor *ou
                 cb->exec = shl_rvv_conv_im2col_gemm_packn_fp16;
                 return CSINN_TRUE;
             } else {
-                params->conv_extra.conv_mode = CSINN_WINOGRAD;
-                struct csinn_tensor *t_kernel = csinn_alloc_tensor(NULL);
-                if ((in_h < 13) && (in_w < 13)) {
-                    shl_rvv_wg_b4f3s1_trans_kernel_packn_fp16(kernel, t_kernel);
-                    cb->exec = shl_rvv_wg_b4f3s1_packn_fp16;
-                } else {
-                    shl_rvv_wg_b6f3s1_trans_kernel_packn_fp16(kernel, t_kernel);
-                    cb->exec = shl_rvv_wg_b6f3s1_packn_fp16;
-                }
-                params->conv_extra.kernel_tm = t_kernel;
+                int algo = shl_conv2d_tune(input, output, kernel, bias, params,
+                                           conv3x3s1_packn_fp16, 3, (in_h < 13) && (in_w < 13),
+                                           shl_rvv_tune_core(&params->base));
+                conv3x3s1_packn_fp16[algo].prepare(kernel, params);
             }
         } else {
             params->conv_extra.conv_mode = CSINN_GEMM;
@@ -222,6 +314,11 @@ int shl_rvv_conv2d_init_int8(struct csinn_tensor *input, struct csinn_tensor *ou
     struct csinn_callback *cb = params->base.cb;
 
     const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
+    float wg_scale = 1.0f;
+
+    if (shl_sparse_keep(kernel->mtype)) {
+        return shl_rvv_conv2d_sparse_init_int8(input, output, kernel, bias, params);
+    }
 
     // packn
     if (in_c % packn == 0 && out_c % packn == 0) {
@@ -240,12 +337,34 @@ int shl_rvv_conv2d_init_int8(struct csinn_tensor *input, struct csinn_tensor *ou
                 cb->exec = shl_rvv_conv_im2col_gemm_packn_int8;
                 return CSINN_TRUE;
             } else {
-                params->conv_extra.conv_mode = CSINN_WINOGRAD;
-                struct csinn_tensor *t_kernel = csinn_alloc_tensor(NULL);
-                shl_rvv_wg_b4f3s1_trans_kernel_packn_int8(kernel, t_kernel);
-                cb->exec = shl_rvv_wg_b4f3s1_packn_int8;
-                params->conv_extra.kernel_tm = t_kernel;
+                /* winograd only where its int32 sums cannot overflow, first one untuned */
+                struct shl_conv2d_algo algo[3];
+                int algo_num = 0;
+                if (shl_rvv_wg_int8_check(input, kernel, bias, 576)) {
+                    algo[algo_num++] = conv3x3s1_packn_int8[0];
+                }
+                if (shl_rvv_wg_int8_check(input, kernel, bias, 4)) {
+                    algo[algo_num++] = conv3x3s1_packn_int8[1];
+                }
+                algo[algo_num++] = conv3x3s1_packn_int8[2];
+                int i = shl_conv2d_tune(input, output, kernel, bias, params, algo, algo_num, 0,
+                                        shl_rvv_tune_core(&params->base));
+                algo[i].prepare(kernel, params);
+                if (algo[i].id == SHL_CONV2D_ALGO_WG_B4F3S1) {
+                    wg_scale = 576.0f;
+                } else if (algo[i].id == SHL_CONV2D_ALGO_WG_B2F3S1) {
+                    wg_scale = 4.0f;
+                }
             }
+        } else if (kernel_h == 3 && kernel_w == 3 && stride_h == 2 && stride_w == 2 &&
+                   dalition_h == 1 && dalition_w == 1 && params->group == 1 &&
+                   shl_rvv_wg_int8_check(input, kernel, bias, 4)) {
+            params->conv_extra.conv_mode = CSINN_WINOGRAD;
+            wg_scale = 4.0f;
+            struct csinn_tensor *t_kernel = csinn_alloc_tensor(NULL);
+            shl_rvv_wg_b3f3s2_trans_kernel_packn_int8(kernel, t_kernel);
+            cb->exec = shl_rvv_wg_b3f3s2_packn_int8;
+            params->conv_extra.kernel_tm = t_kernel;
         } else {
             params->conv_extra.conv_mode = CSINN_GEMM;
             params->conv_extra.kernel_tm = csinn_alloc_tensor(NULL);
@@ -299,10 +418,8 @@ int shl_rvv_conv2d_init_int8(struct csinn_tensor *input, struct csinn_tensor *ou
     // support channel quantization
     for (int i = 0; i < kernel->quant_channel; i++) {
         float real_scale = input->qinfo->scale * kernel->qinfo[i].scale / output->qinfo->scale;
-        // trick for winograd b4f3
-        if (params->conv_extra.conv_mode == CSINN_WINOGRAD) {
-            real_scale = real_scale / 576.0f;
-        }
+        // the winograd kernels leave the sum scaled by wg_scale
+        real_scale = real_scale / wg_scale;
         shl_quantize_multiplier(real_scale, &(kernel->qinfo[i].multiplier),
                                 &(kernel->qinfo[i].shift));
     }
@@ -68,7 +68,8 @@ int shl_rvv_conv1x1s1_gemm_pack1ton_fp16(struct csinn_tensor *input, struct csin
             shl_rvv_reorder_input_z12_pack1ton_fp16(input_ncxhwx, in_ptr, k, 1, n, n);
 
             // gemm
-            shl_rvv_ncxhwx_gemm_12xpack2n_fp16(out_ptr, kernel_ptr, in_ptr, bias_ptr, m, k, n, n);
+            shl_rvv_ncxhwx_gemm_12xpack2n_blocked_fp16(out_ptr, kernel_ptr, in_ptr, bias_ptr, m, k,
+                                                       n, n);
 
             input_data += k * n;
             output_data += m * n;
@@ -59,8 +59,8 @@ int shl_rvv_conv1x1s1_gemm_packnto1_fp16(struct csinn_tensor *input, struct csin
             // pack
             shl_rvv_reorder_input_z12_packn_fp16(input_data, in_ptr, k, n, n);
             // GEMM
-            shl_rvv_ncxhwx_gemm_12xpack2n_fp16(output_ncxhwx, kernel_ptr, in_ptr, bias_ptr, m, k, n,
-                                               n);
+            shl_rvv_ncxhwx_gemm_12xpack2n_blocked_fp16(output_ncxhwx, kernel_ptr, in_ptr, bias_ptr,
+                                                       m, k, n, n);
 
             shl_rvv_reorder_input_packnto1_fp16(output_ncxhwx, output_data, m, out_h, out_w);
 
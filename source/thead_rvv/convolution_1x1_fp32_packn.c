@@ -58,7 +58,8 @@ int shl_rvv_conv1x1s1_gemm_packn_fp32(struct csinn_tensor *input, struct csinn_t
             // pack
             shl_rvv_reorder_input_z12_packn_fp32(input_data, in_ptr, k, n, n);
             // GEMM
-            shl_rvv_ncxhwx_gemm_12xpack2n_fp32(out_ptr, kernel_ptr, in_ptr, bias_ptr, m, k, n, n);
+            shl_rvv_ncxhwx_gemm_12xpack2n_blocked_fp32(out_ptr, kernel_ptr, in_ptr, bias_ptr, m, k,
+                                                       n, n);
 
             input_data += k * n;
             output_data += m * n;
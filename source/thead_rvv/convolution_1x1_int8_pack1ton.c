@@ -109,8 +109,9 @@ int shl_rvv_conv1x1s1_gemm_pack1ton_int8(struct csinn_tensor *input, struct csin
             shl_rvv_reorder_input_z12_pack1ton_int8(input_ncxhwx, in_ptr, k4, 1, n, n);
 
             // gemm
-            shl_rvv_ncxhwx_gemm_12xpackn_int8(out_ptr, kernel_ptr, in_ptr, bias_ptr, m, k4, n, n,
-                                              output->qinfo->zero_point, multiplier, shift);
+            shl_rvv_ncxhwx_gemm_12xpackn_blocked_int8(out_ptr, kernel_ptr, in_ptr, bias_ptr, m, k4,
+                                                      n, n, output->qinfo->zero_point, multiplier,
+                                                      shift);
 
             input_data += k * n;
             output_data += m * n;
@@ -71,8 +71,9 @@ int shl_rvv_conv1x1s1_gemm_packn_int8(struct csinn_tensor *input, struct csinn_t
 
             shl_rvv_reorder_input_z12_packn_int8(input_data, pb_reorder, k, n, n);
 
-            shl_rvv_ncxhwx_gemm_12xpackn_int8(out_ptr, kernel_ptr, in_ptr, bias_ptr, m, k, n, n,
-                                              output->qinfo->zero_point, multiplier, shift);
+            shl_rvv_ncxhwx_gemm_12xpackn_blocked_int8(out_ptr, kernel_ptr, in_ptr, bias_ptr, m, k,
+                                                      n, n, output->qinfo->zero_point, multiplier,
+                                                      shift);
 
             input_data += k * n;
             output_data += m * n;
@@ -73,8 +73,9 @@ int shl_rvv_conv1x1s1_gemm_packnto1_int8(struct csinn_tensor *input, struct csin
 
             shl_rvv_reorder_input_z12_packn_int8(input_data, pb_reorder, k, n, n);
 
-            shl_rvv_ncxhwx_gemm_12xpackn_int8(output_ncxhwx, kernel_ptr, in_ptr, bias_ptr, m, k, n,
-                                              n, output->qinfo->zero_point, multiplier, shift);
+            shl_rvv_ncxhwx_gemm_12xpackn_blocked_int8(output_ncxhwx, kernel_ptr, in_ptr, bias_ptr,
+                                                      m, k, n, n, output->qinfo->zero_point,
+                                                      multiplier, shift);
 
             shl_rvv_reorder_input_packnto1_int8(output_ncxhwx, output_data, m, out_h, out_w);
 
@@ -0,0 +1,591 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_thead_rvv.h"
+#ifdef XTHEADV
+/*************************************************************
+ * int8 winograd with 4x4 transformed tiles, input and output in packn layout
+ *   b2f3s1: F(2x2, 3x3), 3x3 stride 1
+ *   b3f3s2: 3x3 stride 2 split into its four polyphase components
+ *           (input rows/cols even/odd), which turns it into a stride 1
+ *           2x2 conv over 4 * in_c channels, done with F(3x3, 2x2)
+ * Both share the input transform BT and keep (q - z) and the
+ * transformed input/kernel exactly in int16. G is scaled by 2, so the
+ * int32 result is 4 times the conv result, see shl_rvv_wg_int8_check.
+ *************************************************************/
+
+/* G * 2, F(2, 3) */
+static const int16_t ktm_b2f3[4][3] = {{2, 0, 0}, {1, 1, 1}, {1, -1, 1}, {0, 0, 2}};
+/* G * 2, F(3, 2), last row negated to share BT with F(2, 3) */
+static const int16_t ktm_b3f2[4][2] = {{2, 0}, {1, 1}, {1, -1}, {0, -2}};
+
+/*
+ * Winograd keeps exact integers and wraps in int32, so only the final value,
+ * scale * (conv + bias), has to fit: check it with the worst case input.
+ */
+bool shl_rvv_wg_int8_check(struct csinn_tensor *input, struct csinn_tensor *kernel,
+                           struct csinn_tensor *bias, int32_t scale)
+{
+    int32_t out_c = kernel->dim[0];
+    int32_t inner = csinn_tensor_size(kernel) / out_c;
+    int8_t *kernel_data = (int8_t *)kernel->data;
+    int32_t *bias_data = (int32_t *)bias->data;
+    int32_t input_zp = input->qinfo->zero_point;
+    int64_t in_max = input_zp + 128 > 127 - input_zp ? input_zp + 128 : 127 - input_zp;
+
+    for (int oc = 0; oc < out_c; oc++) {
+        int64_t sum = 0;
+        for (int j = 0; j < inner; j++) {
+            sum += abs(kernel_data[oc * inner + j]);
+        }
+        sum = sum * in_max;
+        if (bias_data != NULL && bias->dim_count != 0) {
+            sum += llabs(bias_data[oc]);
+        }
+        if (sum * scale > INT32_MAX) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static vint8mf2_t requantize_m2_s(vint32m2_t _src, int32_t *multiplier, int32_t *shift,
+                                  int32_t out_zp, int vl)
+{
+    vint32m2_t _mult = vle32_v_i32m2(multiplier, vl);
+    vint32m2_t _shift = vle32_v_i32m2(shift, vl);
+    vint32m2_t _mulh = vmulh_vv_i32m2(_src, _mult, vl);
+    _shift = vrsub_vx_i32m2(_shift, -1, vl);
+    _mulh = vssra_vv_i32m2(_mulh, vreinterpret_v_i32m2_u32m2(_shift), vl);
+    _mulh = vadd_vx_i32m2(_mulh, out_zp, vl);
+    vint16m1_t _tmp1 = vnclip_wx_i16m1(_mulh, 0, vl);
+    vint8mf2_t _tmp2 = vnclip_wx_i8mf2(_tmp1, 0, vl);
+    return _tmp2;
+}
+
+/******************************************************************************************
+ * kernel layout before:  [O, I, 4, 4] int16
+ * kernel layout after :  [O/packn, 16, I, packn]
+ ******************************************************************************************/
+static void wg_reorder_kernel_packn_int16(const int16_t *src, int16_t *dst, int out_c, int in_c)
+{
+    const int packn = csrr_vlenb() / sizeof(int16_t);
+    for (int oc = 0; oc + packn - 1 < out_c; oc += packn) {
+        int16_t *g0 = dst + oc * 16 * in_c;
+        for (int k = 0; k < 16; k++) {
+            int16_t *g00 = g0 + k * in_c * packn;
+            for (int ic = 0; ic < in_c; ic++) {
+                for (int j = 0; j < packn; j++) {
+                    *g00++ = src[((oc + j) * in_c + ic) * 16 + k];
+                }
+            }
+        }
+    }
+}
+
+/* U = G * g * GT, g: r x r with row stride ldg, U: 4 x 4 */
+static void wg_trans_kernel_tile_int8(const int8_t *g, int ldg, int r, const int16_t *ktm,
+                                      int16_t *u)
+{
+    int16_t tmp[4][3];
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < r; b++) {
+            tmp[i][b] = 0;
+            for (int a = 0; a < r; a++) {
+                tmp[i][b] += ktm[i * r + a] * g[a * ldg + b];
+            }
+        }
+    }
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            int16_t sum = 0;
+            for (int b = 0; b < r; b++) {
+                sum += tmp[i][b] * ktm[j * r + b];
+            }
+            u[i * 4 + j] = sum;
+        }
+    }
+}
+
+/******************************************************************************************
+ * kernel layout before:  [O, I, 3, 3]
+ * kernel layout after :  [O/packn, 16, I, packn]
+ * constrain: output channel % packn = 0
+ *            input channel % packn = 0
+ ******************************************************************************************/
+void shl_rvv_wg_b2f3s1_trans_kernel_packn_int8(struct csinn_tensor *src_kernel,
+                                               struct csinn_tensor *dst_kernel)
+{
+    int32_t outch = src_kernel->dim[0];
+    int32_t inch = src_kernel->dim[1];
+    int8_t *kernel_data = (int8_t *)src_kernel->data;
+    int16_t *kernel_tm = (int16_t *)shl_mem_alloc(outch * inch * 16 * sizeof(int16_t));
+    csinn_tensor_copy(dst_kernel, src_kernel);
+
+    for (int p = 0; p < outch; p++) {
+        for (int q = 0; q < inch; q++) {
+            wg_trans_kernel_tile_int8(kernel_data + (p * inch + q) * 9, 3, 3, &ktm_b2f3[0][0],
+                                      kernel_tm + (p * inch + q) * 16);
+        }
+    }
+    int16_t *kernel_tm_packn = (int16_t *)shl_mem_alloc(outch * 16 * inch * sizeof(int16_t));
+    wg_reorder_kernel_packn_int16(kernel_tm, kernel_tm_packn, outch, inch);
+    dst_kernel->data = kernel_tm_packn;
+    shl_mem_free(kernel_tm);
+}
+
+/******************************************************************************************
+ * polyphase channel (py * 2 + px) * I + i holds the taps k[i][2a + py][2b + px], a, b < 2,
+ * the missing taps of the odd phases are zero
+ * kernel layout before:  [O, I, 3, 3]
+ * kernel layout after :  [O/packn, 16, 4 * I, packn]
+ ******************************************************************************************/
+void shl_rvv_wg_b3f3s2_trans_kernel_packn_int8(struct csinn_tensor *src_kernel,
+                                               struct csinn_tensor *dst_kernel)
+{
+    int32_t outch = src_kernel->dim[0];
+    int32_t inch = src_kernel->dim[1];
+    int8_t *kernel_data = (int8_t *)src_kernel->data;
+    int16_t *kernel_tm = (int16_t *)shl_mem_alloc(outch * 4 * inch * 16 * sizeof(int16_t));
+    csinn_tensor_copy(dst_kernel, src_kernel);
+
+    for (int p = 0; p < outch; p++) {
+        for (int ph = 0; ph < 4; ph++) {
+            int py = ph / 2;
+            int px = ph % 2;
+            for (int q = 0; q < inch; q++) {
+                const int8_t *k0 = kernel_data + (p * inch + q) * 9;
+                int8_t g[2][2];
+                for (int a = 0; a < 2; a++) {
+                    for (int b = 0; b < 2; b++) {
+                        int y = 2 * a + py;
+                        int x = 2 * b + px;
+                        g[a][b] = y < 3 && x < 3 ? k0[y * 3 + x] : 0;
+                    }
+                }
+                wg_trans_kernel_tile_int8(&g[0][0], 2, 2, &ktm_b3f2[0][0],
+                                          kernel_tm + ((p * 4 + ph) * inch + q) * 16);
+            }
+        }
+    }
+    int16_t *kernel_tm_packn = (int16_t *)shl_mem_alloc(outch * 16 * 4 * inch * sizeof(int16_t));
+    wg_reorder_kernel_packn_int16(kernel_tm, kernel_tm_packn, outch, 4 * inch);
+    dst_kernel->data = kernel_tm_packn;
+    shl_mem_free(kernel_tm);
+}
+
+/******************************************************************************************
+ * input transform of 4x4 tiles, the tile (i, j) starts at pixel (i * tile, j * tile)
+ * and its pixels are step apart.
+ * src: [ch/packn, h, w, packn]  dst: [ch/packn, 16, tiles, packn]
+ * BT = {
+ *     { 1   0  -1   0 };
+ *     { 0   1   1   0 };
+ *     { 0  -1   1   0 };
+ *     { 0   1   0  -1 }
+ * };
+ ******************************************************************************************/
+static void wg_trans_input_4x4_packn_int8(const int8_t *src, int16_t *dst, int ch, int h, int w,
+                                          int blk_h, int blk_w, int tile, int step,
+                                          int8_t input_zp)
+{
+    const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
+    const int vl = vsetvl_e8mf2(packn);
+    int tiles = blk_h * blk_w;
+    for (int q = 0; q + packn - 1 < ch; q += packn) {
+        const int8_t *img0 = src + q * h * w;
+        int16_t *img0_tm = dst + q * 16 * tiles;
+        int16_t tmp[4][4][packn];
+        for (int i = 0; i < blk_h; i++) {
+            for (int j = 0; j < blk_w; j++) {
+                const int8_t *r0 = img0 + (i * w + j) * tile * step * packn;
+                int16_t *r0_tm = img0_tm + (i * blk_w + j) * packn;
+                for (int m = 0; m < 4; m++) {
+                    vint16m1_t _r00 = vwsub_vx_i16m1(vle8_v_i8mf2(r0, vl), input_zp, vl);
+                    vint16m1_t _r01 =
+                        vwsub_vx_i16m1(vle8_v_i8mf2(r0 + step * packn, vl), input_zp, vl);
+                    vint16m1_t _r02 =
+                        vwsub_vx_i16m1(vle8_v_i8mf2(r0 + step * packn * 2, vl), input_zp, vl);
+                    vint16m1_t _r03 =
+                        vwsub_vx_i16m1(vle8_v_i8mf2(r0 + step * packn * 3, vl), input_zp, vl);
+                    vse16_v_i16m1(tmp[0][m], vsub_vv_i16m1(_r00, _r02, vl), vl);
+                    vse16_v_i16m1(tmp[1][m], vadd_vv_i16m1(_r01, _r02, vl), vl);
+                    vse16_v_i16m1(tmp[2][m], vsub_vv_i16m1(_r02, _r01, vl), vl);
+                    vse16_v_i16m1(tmp[3][m], vsub_vv_i16m1(_r01, _r03, vl), vl);
+                    r0 += w * step * packn;
+                }
+                for (int m = 0; m < 4; m++) {
+                    vint16m1_t _tmp00 = vle16_v_i16m1(tmp[m][0], vl);
+                    vint16m1_t _tmp01 = vle16_v_i16m1(tmp[m][1], vl);
+                    vint16m1_t _tmp02 = vle16_v_i16m1(tmp[m][2], vl);
+                    vint16m1_t _tmp03 = vle16_v_i16m1(tmp[m][3], vl);
+                    // row k of the transformed tile, column m
+                    vse16_v_i16m1(r0_tm + (0 * 4 + m) * tiles * packn,
+                                  vsub_vv_i16m1(_tmp00, _tmp02, vl), vl);
+                    vse16_v_i16m1(r0_tm + (1 * 4 + m) * tiles * packn,
+                                  vadd_vv_i16m1(_tmp01, _tmp02, vl), vl);
+                    vse16_v_i16m1(r0_tm + (2 * 4 + m) * tiles * packn,
+                                  vsub_vv_i16m1(_tmp02, _tmp01, vl), vl);
+                    vse16_v_i16m1(r0_tm + (3 * 4 + m) * tiles * packn,
+                                  vsub_vv_i16m1(_tmp01, _tmp03, vl), vl);
+                }
+            }
+        }
+    }
+}
+
+/******************************************************************************************
+ * src: [ch/packn, 16, tiles, packn]
+ * dst: [16, tiles/8, ch, 8] + [16, tiles%8, ch]
+ ******************************************************************************************/
+static void wg_reorder_input_tile8_int16(const int16_t *src, int16_t *dst, int ch, int tiles)
+{
+    const int packn = csrr_vlenb() / sizeof(int16_t);
+    const int vl = vsetvl_e16m1(packn);
+    for (int r = 0; r < 16; r++) {
+        int16_t *img_tm2 = dst + r * tiles * ch;
+        int t = 0;
+        for (; t + 7 < tiles; t += 8) {
+            const int16_t *tm1 = src + (r * tiles + t) * packn;
+            for (int q = 0; q < ch / packn; q++) {
+                for (int i = 0; i < 8; i++) {
+                    vint16m1_t _tmp = vle16_v_i16m1(tm1 + packn * i, vl);
+                    vsse16_v_i16m1(img_tm2 + i, 8 * sizeof(int16_t), _tmp, vl);
+                }
+                tm1 += 16 * tiles * packn;
+                img_tm2 += 8 * packn;
+            }
+        }
+        for (; t < tiles; t++) {
+            const int16_t *tm1 = src + (r * tiles + t) * packn;
+            for (int q = 0; q < ch / packn; q++) {
+                vse16_v_i16m1(img_tm2, vle16_v_i16m1(tm1, vl), vl);
+                tm1 += 16 * tiles * packn;
+                img_tm2 += packn;
+            }
+        }
+    }
+}
+
+/******************************************************************************************
+ * input: [16, tiles/8, in_ch, 8] + [16, tiles%8, in_ch]
+ * kernel: [out_ch/packn, 16, in_ch, packn]
+ * output: [out_ch/packn, 16, tiles, packn] int32
+ ******************************************************************************************/
+static void wg_batch_gemm_packnx8_int16(const int16_t *input, const int16_t *kernel,
+                                        int32_t *output, int in_ch, int out_ch, int tiles)
+{
+    const int packn = csrr_vlenb() / sizeof(int16_t);
+    const int vl = vsetvl_e16m1(packn);
+
+    for (int p = 0; p + packn - 1 < out_ch; p += packn) {
+        int32_t *output0_tm = output + p * 16 * tiles;
+        const int16_t *kernel0_tm = kernel + p * 16 * in_ch;
+        for (int r = 0; r < 16; r++) {
+            const int16_t *img0 = input + r * tiles * in_ch;
+            const int16_t *k0 = kernel0_tm + r * in_ch * packn;
+            int t = 0;
+            for (; t + 7 < tiles; t += 8) {
+                vint32m2_t _acc0 = vmv_v_x_i32m2(0, vl);
+                vint32m2_t _acc1 = vmv_v_x_i32m2(0, vl);
+                vint32m2_t _acc2 = vmv_v_x_i32m2(0, vl);
+                vint32m2_t _acc3 = vmv_v_x_i32m2(0, vl);
+                vint32m2_t _acc4 = vmv_v_x_i32m2(0, vl);
+                vint32m2_t _acc5 = vmv_v_x_i32m2(0, vl);
+                vint32m2_t _acc6 = vmv_v_x_i32m2(0, vl);
+                vint32m2_t _acc7 = vmv_v_x_i32m2(0, vl);
+                for (int c = 0; c < in_ch; c++) {
+                    vint16m1_t _kernel0 = vle16_v_i16m1(k0 + c * packn, vl);
+                    _acc0 = vwmacc_vx_i32m2(_acc0, img0[0], _kernel0, vl);
+                    _acc1 = vwmacc_vx_i32m2(_acc1, img0[1], _kernel0, vl);
+                    _acc2 = vwmacc_vx_i32m2(_acc2, img0[2], _kernel0, vl);
+                    _acc3 = vwmacc_vx_i32m2(_acc3, img0[3], _kernel0, vl);
+                    _acc4 = vwmacc_vx_i32m2(_acc4, img0[4], _kernel0, vl);
+                    _acc5 = vwmacc_vx_i32m2(_acc5, img0[5], _kernel0, vl);
+                    _acc6 = vwmacc_vx_i32m2(_acc6, img0[6], _kernel0, vl);
+                    _acc7 = vwmacc_vx_i32m2(_acc7, img0[7], _kernel0, vl);
+                    img0 += 8;
+                }
+                vse32_v_i32m2(output0_tm, _acc0, vl);
+                vse32_v_i32m2(output0_tm + packn * 1, _acc1, vl);
+                vse32_v_i32m2(output0_tm + packn * 2, _acc2, vl);
+                vse32_v_i32m2(output0_tm + packn * 3, _acc3, vl);
+                vse32_v_i32m2(output0_tm + packn * 4, _acc4, vl);
+                vse32_v_i32m2(output0_tm + packn * 5, _acc5, vl);
+                vse32_v_i32m2(output0_tm + packn * 6, _acc6, vl);
+                vse32_v_i32m2(output0_tm + packn * 7, _acc7, vl);
+                output0_tm += packn * 8;
+            }
+            for (; t < tiles; t++) {
+                vint32m2_t _acc0 = vmv_v_x_i32m2(0, vl);
+                for (int c = 0; c < in_ch; c++) {
+                    vint16m1_t _kernel0 = vle16_v_i16m1(k0 + c * packn, vl);
+                    _acc0 = vwmacc_vx_i32m2(_acc0, img0[0], _kernel0, vl);
+                    img0 += 1;
+                }
+                vse32_v_i32m2(output0_tm, _acc0, vl);
+                output0_tm += packn;
+            }
+        }
+    }
+}
+
+/******************************************************************************************
+ * output transform, requantize and crop, tile (i, j) gives the output pixels from
+ * (i * tile, j * tile), the bias is scaled like the transformed kernel.
+ * AT(F(2, 3)) = {
+ *     { 1  1   1   0 };
+ *     { 0  1  -1  -1 }
+ * };
+ * AT(F(3, 2)) = {
+ *     { 1  1   1   0 };
+ *     { 0  1  -1   0 };
+ *     { 0  1   1   1 }
+ * };
+ * src: [ch/packn, 16, tiles, packn]  dst: [ch/packn, out_h, out_w, packn]
+ ******************************************************************************************/
+static inline void wg_trans_row_int32(vint32m2_t _r0, vint32m2_t _r1, vint32m2_t _r2,
+                                      vint32m2_t _r3, int tile, vint32m2_t *_res, int vl)
+{
+    vint32m2_t _sum12 = vadd_vv_i32m2(_r1, _r2, vl);
+    vint32m2_t _sub12 = vsub_vv_i32m2(_r1, _r2, vl);
+    _res[0] = vadd_vv_i32m2(_r0, _sum12, vl);
+    if (tile == 2) {
+        _res[1] = vsub_vv_i32m2(_sub12, _r3, vl);
+    } else {
+        _res[1] = _sub12;
+        _res[2] = vadd_vv_i32m2(_sum12, _r3, vl);
+    }
+}
+
+static void wg_trans_output_4x4_packn_int8(const int32_t *src, const int32_t *bias, int8_t *dst,
+                                           int ch, int out_h, int out_w, int blk_h, int blk_w,
+                                           int tile, int32_t *multi, int32_t *shift,
+                                           int32_t out_zp)
+{
+    const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
+    const int vl = vsetvl_e8mf2(packn);
+    int tiles = blk_h * blk_w;
+    for (int p = 0; p + packn - 1 < ch; p += packn) {
+        const int32_t *out0_tm = src + p * 16 * tiles;
+        int8_t *out0 = dst + p * out_h * out_w;
+        int32_t tmp[3][4][packn];
+
+        vint32m2_t _bias = bias ? vle32_v_i32m2(bias + p, vl) : vmv_v_x_i32m2(0, vl);
+        _bias = vmul_vx_i32m2(_bias, 4, vl);
+        for (int i = 0; i < blk_h; i++) {
+            for (int j = 0; j < blk_w; j++) {
+                const int32_t *output0_tm = out0_tm + (i * blk_w + j) * packn;
+                vint32m2_t _res[3];
+                for (int m = 0; m < 4; m++) {
+                    vint32m2_t _r0 = vle32_v_i32m2(output0_tm + (0 * 4 + m) * tiles * packn, vl);
+                    vint32m2_t _r1 = vle32_v_i32m2(output0_tm + (1 * 4 + m) * tiles * packn, vl);
+                    vint32m2_t _r2 = vle32_v_i32m2(output0_tm + (2 * 4 + m) * tiles * packn, vl);
+                    vint32m2_t _r3 = vle32_v_i32m2(output0_tm + (3 * 4 + m) * tiles * packn, vl);
+                    wg_trans_row_int32(_r0, _r1, _r2, _r3, tile, _res, vl);
+                    for (int k = 0; k < tile; k++) {
+                        vse32_v_i32m2(tmp[k][m], _res[k], vl);
+                    }
+                }
+                for (int k = 0; k < tile; k++) {
+                    int oy = i * tile + k;
+                    if (oy >= out_h) {
+                        break;
+                    }
+                    vint32m2_t _r0 = vle32_v_i32m2(tmp[k][0], vl);
+                    vint32m2_t _r1 = vle32_v_i32m2(tmp[k][1], vl);
+                    vint32m2_t _r2 = vle32_v_i32m2(tmp[k][2], vl);
+                    vint32m2_t _r3 = vle32_v_i32m2(tmp[k][3], vl);
+                    wg_trans_row_int32(_r0, _r1, _r2, _r3, tile, _res, vl);
+                    for (int m = 0; m < tile; m++) {
+                        int ox = j * tile + m;
+                        if (ox >= out_w) {
+                            break;
+                        }
+                        vint32m2_t _out = vadd_vv_i32m2(_res[m], _bias, vl);
+                        vint8mf2_t _res8 = requantize_m2_s(_out, multi + p, shift + p, out_zp, vl);
+                        vse8_v_i8mf2(out0 + (oy * out_w + ox) * packn, _res8, vl);
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void wg_get_multiplier_int8(struct csinn_tensor *kernel, int32_t *multiplier,
+                                   int32_t *shift)
+{
+    int out_c = kernel->dim[0];
+    for (int c = 0; c < out_c; c++) {
+        int q = kernel->quant_channel > 1 ? c : 0;
+        multiplier[c] = kernel->qinfo[q].multiplier;
+        shift[c] = kernel->qinfo[q].shift;
+    }
+}
+
+/******************************************************************************************
+ * constrain: output channel % packn = 0
+ *            input channel % packn = 0
+ ******************************************************************************************/
+int shl_rvv_wg_b2f3s1_packn_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                 struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                 struct csinn_conv2d_params *params)
+{
+    int8_t *input_data = (int8_t *)input->data;
+    int8_t *output_data = (int8_t *)output->data;
+    int16_t *kernel_data = (int16_t *)params->conv_extra.kernel_tm->data;
+    int32_t *bias_data = (int32_t *)bias->data;
+
+    int batch = input->dim[0];
+    int in_c = input->dim[1];
+    int in_h = input->dim[2];
+    int in_w = input->dim[3];
+    int input_size = in_c * in_h * in_w;
+    int out_c = kernel->dim[0];
+    int out_h = output->dim[2];
+    int out_w = output->dim[3];
+    int output_size = out_c * out_h * out_w;
+
+    int block_h = (out_h + 1) / 2;
+    int block_w = (out_w + 1) / 2;
+    int padded_in_h = block_h * 2 + 2;
+    int padded_in_w = block_w * 2 + 2;
+    int padded_in_hw = padded_in_h * padded_in_w;
+    int tiles = block_h * block_w;
+
+    int32_t *multiplier = (int32_t *)shl_mem_alloc(out_c * sizeof(int32_t));
+    int32_t *shift = (int32_t *)shl_mem_alloc(out_c * sizeof(int32_t));
+    wg_get_multiplier_int8(kernel, multiplier, shift);
+
+    for (int n = 0; n < batch; n++) {
+        // pad buffer: [in_c/packn, h, w, packn]
+        int8_t *input_padd_buf = (int8_t *)shl_mem_alloc(in_c * padded_in_hw * sizeof(int8_t));
+        shl_rvv_pad_input_packn_int8(input_data, input_padd_buf, in_c, in_h, in_w, padded_in_h,
+                                     padded_in_w, params->pad_top, params->pad_left,
+                                     input->qinfo->zero_point);
+        // input_tm1_buf: [in_c/packn, 16, tiles, packn]
+        int16_t *input_tm1_buf = (int16_t *)shl_mem_alloc(in_c * 16 * tiles * sizeof(int16_t));
+        wg_trans_input_4x4_packn_int8(input_padd_buf, input_tm1_buf, in_c, padded_in_h,
+                                      padded_in_w, block_h, block_w, 2, 1,
+                                      input->qinfo->zero_point);
+        shl_mem_free(input_padd_buf);
+
+        int16_t *input_tm2_buf = (int16_t *)shl_mem_alloc(in_c * 16 * tiles * sizeof(int16_t));
+        wg_reorder_input_tile8_int16(input_tm1_buf, input_tm2_buf, in_c, tiles);
+        shl_mem_free(input_tm1_buf);
+
+        // output_dot_buf: [out_c/packn, 16, tiles, packn]
+        int32_t *output_dot_buf = (int32_t *)shl_mem_alloc(out_c * 16 * tiles * sizeof(int32_t));
+        wg_batch_gemm_packnx8_int16(input_tm2_buf, kernel_data, output_dot_buf, in_c, out_c,
+                                    tiles);
+        shl_mem_free(input_tm2_buf);
+
+        wg_trans_output_4x4_packn_int8(output_dot_buf, bias_data, output_data, out_c, out_h, out_w,
+                                       block_h, block_w, 2, multiplier, shift,
+                                       output->qinfo->zero_point);
+        shl_mem_free(output_dot_buf);
+        input_data += input_size;
+        output_data += output_size;
+    }
+    shl_mem_free(multiplier);
+    shl_mem_free(shift);
+    return CSINN_TRUE;
+}
+
+/******************************************************************************************
+ * 3x3 stride 2: out(y, x) = sum over phases (py, px) of the 2x2 stride 1 conv of
+ * pad(input)(2 * i + py, 2 * j + px) with the phase taps, every phase is read with a
+ * pixel step of 2 straight from the padded input.
+ * constrain: output channel % packn = 0
+ *            input channel % packn = 0
+ ******************************************************************************************/
+int shl_rvv_wg_b3f3s2_packn_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                 struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                 struct csinn_conv2d_params *params)
+{
+    int8_t *input_data = (int8_t *)input->data;
+    int8_t *output_data = (int8_t *)output->data;
+    int16_t *kernel_data = (int16_t *)params->conv_extra.kernel_tm->data;
+    int32_t *bias_data = (int32_t *)bias->data;
+
+    int batch = input->dim[0];
+    int in_c = input->dim[1];
+    int in_h = input->dim[2];
+    int in_w = input->dim[3];
+    int input_size = in_c * in_h * in_w;
+    int out_c = kernel->dim[0];
+    int out_h = output->dim[2];
+    int out_w = output->dim[3];
+    int output_size = out_c * out_h * out_w;
+
+    const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
+    int block_h = (out_h + 2) / 3;
+    int block_w = (out_w + 2) / 3;
+    // every phase needs block * 3 + 1 rows/cols
+    int padded_in_h = (block_h * 3 + 1) * 2;
+    int padded_in_w = (block_w * 3 + 1) * 2;
+    int padded_in_hw = padded_in_h * padded_in_w;
+    int tiles = block_h * block_w;
+    int phase_c = 4 * in_c;
+
+    int32_t *multiplier = (int32_t *)shl_mem_alloc(out_c * sizeof(int32_t));
+    int32_t *shift = (int32_t *)shl_mem_alloc(out_c * sizeof(int32_t));
+    wg_get_multiplier_int8(kernel, multiplier, shift);
+
+    for (int n = 0; n < batch; n++) {
+        int8_t *input_padd_buf = (int8_t *)shl_mem_alloc(in_c * padded_in_hw * sizeof(int8_t));
+        shl_rvv_pad_input_packn_int8(input_data, input_padd_buf, in_c, in_h, in_w, padded_in_h,
+                                     padded_in_w, params->pad_top, params->pad_left,
+                                     input->qinfo->zero_point);
+        // input_tm1_buf: [4, in_c/packn, 16, tiles, packn]
+        int16_t *input_tm1_buf =
+            (int16_t *)shl_mem_alloc(phase_c * 16 * tiles * sizeof(int16_t));
+        for (int ph = 0; ph < 4; ph++) {
+            int py = ph / 2;
+            int px = ph % 2;
+            wg_trans_input_4x4_packn_int8(input_padd_buf + (py * padded_in_w + px) * packn,
+                                          input_tm1_buf + ph * in_c * 16 * tiles, in_c,
+                                          padded_in_h, padded_in_w, block_h, block_w, 3, 2,
+                                          input->qinfo->zero_point);
+        }
+        shl_mem_free(input_padd_buf);
+
+        int16_t *input_tm2_buf =
+            (int16_t *)shl_mem_alloc(phase_c * 16 * tiles * sizeof(int16_t));
+        wg_reorder_input_tile8_int16(input_tm1_buf, input_tm2_buf, phase_c, tiles);
+        shl_mem_free(input_tm1_buf);
+
+        int32_t *output_dot_buf = (int32_t *)shl_mem_alloc(out_c * 16 * tiles * sizeof(int32_t));
+        wg_batch_gemm_packnx8_int16(input_tm2_buf, kernel_data, output_dot_buf, phase_c, out_c,
+                                    tiles);
+        shl_mem_free(input_tm2_buf);
+
+        wg_trans_output_4x4_packn_int8(output_dot_buf, bias_data, output_data, out_c, out_h, out_w,
+                                       block_h, block_w, 3, multiplier, shift,
+                                       output->qinfo->zero_point);
+        shl_mem_free(output_dot_buf);
+        input_data += input_size;
+        output_data += output_size;
+    }
+    shl_mem_free(multiplier);
+    shl_mem_free(shift);
+    return CSINN_TRUE;
+}
+#endif
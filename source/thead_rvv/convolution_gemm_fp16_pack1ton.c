@@ -203,8 +203,8 @@ int shl_rvv_conv_im2col_gemm_pack1ton_fp16(struct csinn_tensor *input, struct cs
             // gemm
             __fp16 *ker_ptr = kernel_data + g * m * maxk * in_cp;
             __fp16 *bias_ptr = bias_data ? (bias_data + g * m) : NULL;
-            shl_rvv_ncxhwx_gemm_12xpack2n_fp16(output_data, ker_ptr, reorder_buf, bias_ptr, m,
-                                               in_cp * maxk, n, n);
+            shl_rvv_ncxhwx_gemm_12xpack2n_blocked_fp16(output_data, ker_ptr, reorder_buf, bias_ptr,
+                                                       m, in_cp * maxk, n, n);
             shl_mem_free(reorder_buf);
 
             input_data += in_cp * in_h * in_w;
@@ -95,6 +95,59 @@ void shl_rvv_conv_im2col_gemm_reorder_kernel_packn_fp16(struct csinn_tensor *ker
     shl_mem_free(pa_reorder);
 }
 
+/*************************************************************
+ * implicit im2col: pack the columns [n0, n0 + nb) of the im2col matrix
+ * straight from the unpadded input, out of bounds taps are zero
+ * src: [in_c/packn, in_h, in_w, packn]
+ * dst: [nb/12, in_c/packn * maxk * packn, 12]  Z12 Z8 Z4 Z2 Z1
+ ************************************************************/
+static void im2col_pack_tile_packn_fp16(const __fp16 *src, __fp16 *dst, int in_c, int in_h,
+                                        int in_w, int ksize_h, int ksize_w, int out_w, int n0,
+                                        int nb, struct csinn_conv2d_params *params)
+{
+    const int packn = csrr_vlenb() / sizeof(__fp16);
+    const int vl = vsetvl_e16m1(packn);
+    const int k = in_c * ksize_h * ksize_w;
+    vfloat16m1_t _zero = vfmv_v_f_f16m1(0.0f, vl);
+
+    int t = 0;
+    while (t < nb) {
+        int w = 1;
+        if (t + 11 < nb) {
+            w = 12;
+        } else if (t + 7 < nb) {
+            w = 8;
+        } else if (t + 3 < nb) {
+            w = 4;
+        } else if (t + 1 < nb) {
+            w = 2;
+        }
+        for (int j = 0; j < w; j++) {
+            int oh = (n0 + t + j) / out_w;
+            int ow = (n0 + t + j) % out_w;
+            int ih0 = oh * params->stride_height - params->pad_top;
+            int iw0 = ow * params->stride_width - params->pad_left;
+            __fp16 *out = dst + t * k + j;
+            for (int c = 0; c + packn - 1 < in_c; c += packn) {
+                const __fp16 *img = src + c * in_h * in_w;
+                for (int a = 0; a < ksize_h; a++) {
+                    int ih = ih0 + a * params->dilation_height;
+                    for (int b = 0; b < ksize_w; b++) {
+                        int iw = iw0 + b * params->dilation_width;
+                        vfloat16m1_t _tmp = _zero;
+                        if (ih >= 0 && ih < in_h && iw >= 0 && iw < in_w) {
+                            _tmp = vle16_v_f16m1(img + (ih * in_w + iw) * packn, vl);
+                        }
+                        vsse16_v_f16m1(out, w * sizeof(__fp16), _tmp, vl);
+                        out += packn * w;
+                    }
+                }
+            }
+        }
+        t += w;
+    }
+}
+
 int shl_rvv_conv_im2col_gemm_packn_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
                                         struct csinn_tensor *kernel, struct csinn_tensor *bias,
                                         struct csinn_conv2d_params *params)
@@ -114,74 +167,35 @@ int shl_rvv_conv_im2col_gemm_packn_fp16(struct csinn_tensor *input, struct csinn
     int32_t out_w = output->dim[3];
     int32_t ksize_h = kernel->dim[2];
     int32_t ksize_w = kernel->dim[3];
-    int32_t stride_h = params->stride_height;
-    int32_t stride_w = params->stride_width;
 
     int32_t m = out_c / group;
     int32_t in_cp = in_c / group;
     int32_t maxk = ksize_h * ksize_w;
     int32_t n = out_h * out_w;
 
+    int32_t k = in_cp * maxk;
+    const int packn = csrr_vlenb() / sizeof(__fp16);
+    int32_t tile_n = shl_rvv_gemm_tile_n(sizeof(__fp16), k, n);
+    __fp16 *tile_buf = (__fp16 *)shl_mem_alloc(k * tile_n * sizeof(__fp16));
+
     for (int i = 0; i < batch; i++) {
         for (int g = 0; g < group; g++) {
-            // padding
-            int padded_in_hw = (in_h + params->pad_top + params->pad_down) *
-                               (in_w + params->pad_left + params->pad_right);
-            __fp16 *input_pad_buf = (__fp16 *)shl_mem_alloc(in_cp * padded_in_hw * sizeof(__fp16));
-            shl_rvv_pad_input_packn_fp16(input_data, input_pad_buf, in_cp, in_h, in_w,
-                                         (in_h + params->pad_top + params->pad_down),
-                                         (in_w + params->pad_left + params->pad_right),
-                                         params->pad_top, params->pad_left);
-
-            // im2col
-            const int packn = csrr_vlenb() / sizeof(__fp16);
-            const int vl = vsetvl_e16m1(packn);
-
-            __fp16 *im2col_buf = (__fp16 *)shl_mem_alloc(in_cp / packn * maxk * out_h * out_w *
-                                                         packn * sizeof(__fp16));
-            const int tailstep =
-                ((in_w + params->pad_left + params->pad_right) * stride_h - out_w * stride_w) *
-                packn;
-
-            for (int c = 0; c + packn - 1 < in_cp; c += packn) {
-                const __fp16 *img0 = input_pad_buf + c * padded_in_hw;
-                __fp16 *dst_ptr = im2col_buf + c * maxk * out_h * out_w;
-
-                for (int a = 0; a < ksize_h; a++) {
-                    for (int b = 0; b < ksize_w; b++) {
-                        const __fp16 *img1 =
-                            img0 + a * (in_w + params->pad_left + params->pad_right) * packn +
-                            b * packn;
-
-                        for (int p = 0; p < out_h; p++) {
-                            for (int q = 0; q < out_w; q++) {
-                                vfloat16m1_t _tmp = vle16_v_f16m1(img1, vl);
-                                img1 += stride_w * packn;
-                                vse16_v_f16m1(dst_ptr, _tmp, vl);
-                                dst_ptr += packn;
-                            }
-                            img1 += tailstep;
-                        }
-                    }
-                }
-            }
-            shl_mem_free(input_pad_buf);
-
-            // reorder(pack)
-            __fp16 *reorder_buf = (__fp16 *)shl_mem_alloc(in_cp * maxk * n * sizeof(__fp16));
-            shl_rvv_reorder_input_z12_packn_fp16(im2col_buf, reorder_buf, in_cp * maxk, n, n);
-            shl_mem_free(im2col_buf);
-
-            // gemm
-            __fp16 *ker_ptr = kernel_data + g * m * maxk * in_cp;
+            __fp16 *ker_ptr = kernel_data + g * m * k;
             __fp16 *bias_ptr = bias_data ? (bias_data + g * m) : NULL;
-            shl_rvv_ncxhwx_gemm_12xpack2n_fp16(output_data, ker_ptr, reorder_buf, bias_ptr, m,
-                                               in_cp * maxk, n, n);
-            shl_mem_free(reorder_buf);
+            for (int n0 = 0; n0 < n; n0 += tile_n) {
+                int nb = n - n0 < tile_n ? n - n0 : tile_n;
+                // im2col + reorder(pack) of one column tile
+                im2col_pack_tile_packn_fp16(input_data, tile_buf, in_cp, in_h, in_w, ksize_h,
+                                            ksize_w, out_w, n0, nb, params);
+                // gemm
+                shl_rvv_ncxhwx_gemm_12xpack2n_blocked_fp16(output_data + n0 * packn, ker_ptr,
+                                                           tile_buf, bias_ptr, m, k, nb, n);
+            }
 
             input_data += in_cp * in_h * in_w;
             output_data += m * n;
         }
     }
+    shl_mem_free(tile_buf);
     return CSINN_TRUE;
 }
@@ -206,9 +206,9 @@ int shl_rvv_conv_im2col_gemm_pack1ton_int8(struct csinn_tensor *input, struct cs
             // gemm
             int8_t *ker_ptr = kernel_data + g * m * maxk * in_cp4;
             int32_t *bias_ptr = bias_data + g * m;
-            shl_rvv_ncxhwx_gemm_12xpackn_int8(output_data, ker_ptr, reorder_buf, bias_ptr, m,
-                                              in_cp4 * maxk, n, n, output->qinfo->zero_point,
-                                              multiplier, shift);
+            shl_rvv_ncxhwx_gemm_12xpackn_blocked_int8(output_data, ker_ptr, reorder_buf, bias_ptr,
+                                                      m, in_cp4 * maxk, n, n,
+                                                      output->qinfo->zero_point, multiplier, shift);
             shl_mem_free(reorder_buf);
 
             input_data += in_cp * in_h * in_w;
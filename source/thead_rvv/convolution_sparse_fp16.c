@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_thead_rvv.h"
+
+/*************************************************************
+ * structured sparse gemm, see shl_sparse_compress for the weight format
+ * values: [m, groups, keep]  index: [m, groups]  sb: [k, n] row-major
+ * row o = row0 + i of the output lives at
+ * dst + (o / out_pack) * n * out_pack + o % out_pack, element stride out_pack,
+ * so out_pack = packn writes the packn layout and out_pack = 1 a plain one.
+ * Only the kept weights are multiplied, vectorized along n.
+ *************************************************************/
+void shl_rvv_sparse_gemm_fp16(__fp16 *dst, const __fp16 *values, const uint8_t *index,
+                              const __fp16 *sb, const __fp16 *bias, int m, int k, int n, int keep,
+                              int row0, int out_pack)
+{
+    const int groups = (k + 3) / 4;
+
+    for (int i = 0; i < m; i++) {
+        const __fp16 *w = values + i * groups * keep;
+        const uint8_t *idx = index + i * groups;
+        int o = row0 + i;
+        __fp16 *out_ptr = dst + (o / out_pack) * n * out_pack + o % out_pack;
+        __fp16 b = bias ? bias[i] : 0.0f;
+
+        int t = 0;
+        while (t < n) {
+            int vl = vsetvl_e16m4(n - t);
+            vfloat16m4_t _acc = vfmv_v_f_f16m4(b, vl);
+            for (int g = 0; g < groups; g++) {
+                for (int j = 0; j < keep; j++) {
+                    int d = g * 4 + ((idx[g] >> (2 * j)) & 3);
+                    vfloat16m4_t _in = vle16_v_f16m4(sb + d * n + t, vl);
+                    _acc = vfmacc_vf_f16m4(_acc, w[g * keep + j], _in, vl);
+                }
+            }
+            if (out_pack == 1) {
+                vse16_v_f16m4(out_ptr + t, _acc, vl);
+            } else {
+                vsse16_v_f16m4(out_ptr + t * out_pack, out_pack * sizeof(__fp16), _acc, vl);
+            }
+            t += vl;
+        }
+    }
+}
+
+/*
+ * im2col of one group into [in_cp * maxk, out_h * out_w], channels c0 .. c0 + in_cp - 1.
+ * The input is in the packn layout when in_pack = packn, otherwise in NCHW.
+ */
+static void im2col_sparse_fp16(const __fp16 *src, __fp16 *dst, int c0, int in_cp, int in_pack,
+                               int in_h, int in_w, int out_h, int out_w, int ksize_h,
+                               int ksize_w, struct csinn_conv2d_params *params)
+{
+    const int in_hw = in_h * in_w;
+    for (int c = 0; c < in_cp; c++) {
+        int ch = c0 + c;
+        const __fp16 *plane = src + (ch / in_pack) * in_hw * in_pack + ch % in_pack;
+        for (int a = 0; a < ksize_h; a++) {
+            for (int b = 0; b < ksize_w; b++) {
+                for (int y = 0; y < out_h; y++) {
+                    int iy = y * params->stride_height - params->pad_top +
+                             a * params->dilation_height;
+                    for (int x = 0; x < out_w; x++) {
+                        int ix = x * params->stride_width - params->pad_left +
+                                 b * params->dilation_width;
+                        if (iy < 0 || iy >= in_h || ix < 0 || ix >= in_w) {
+                            *dst++ = 0.0f;
+                        } else {
+                            *dst++ = plane[(iy * in_w + ix) * in_pack];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+int shl_rvv_conv2d_sparse_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                               struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                               struct csinn_conv2d_params *params)
+{
+    __fp16 *input_data = (__fp16 *)input->data;
+    __fp16 *output_data = (__fp16 *)output->data;
+    __fp16 *kernel_data = (__fp16 *)kernel->data;
+    __fp16 *bias_data = bias->dim_count != 0 ? (__fp16 *)bias->data : NULL;
+    uint8_t *index = shl_sparse_index(kernel);
+    const int keep = shl_sparse_keep(kernel->mtype);
+
+    int32_t group = params->group;
+    int32_t batch = input->dim[0];
+    int32_t in_c = input->dim[1];
+    int32_t in_h = input->dim[2];
+    int32_t in_w = input->dim[3];
+    int32_t out_c = output->dim[1];
+    int32_t out_h = output->dim[2];
+    int32_t out_w = output->dim[3];
+    int32_t ksize_h = kernel->dim[2];
+    int32_t ksize_w = kernel->dim[3];
+
+    const int packn = csrr_vlenb() / sizeof(__fp16);
+    const int in_pack = in_c % packn == 0 ? packn : 1;
+    const int out_pack = out_c % packn == 0 ? packn : 1;
+
+    int32_t m = out_c / group;
+    int32_t in_cp = in_c / group;
+    int32_t k = in_cp * ksize_h * ksize_w;
+    int32_t n = out_h * out_w;
+    int32_t groups = shl_sparse_groups(kernel);
+    bool direct = in_pack == 1 && ksize_h == 1 && ksize_w == 1 && params->stride_height == 1 &&
+                  params->stride_width == 1 && params->pad_top == 0 && params->pad_left == 0 &&
+                  params->pad_down == 0 && params->pad_right == 0;
+
+    __fp16 *im2col_buf = direct ? NULL : (__fp16 *)shl_mem_alloc(k * n * sizeof(__fp16));
+
+    for (int i = 0; i < batch; i++) {
+        for (int g = 0; g < group; g++) {
+            __fp16 *sb = input_data + g * in_cp * in_h * in_w;
+            if (!direct) {
+                im2col_sparse_fp16(input_data, im2col_buf, g * in_cp, in_cp, in_pack, in_h, in_w,
+                                   out_h, out_w, ksize_h, ksize_w, params);
+                sb = im2col_buf;
+            }
+            shl_rvv_sparse_gemm_fp16(output_data, kernel_data + g * m * groups * keep,
+                                     index + g * m * groups, sb,
+                                     bias_data ? bias_data + g * m : NULL, m, k, n, keep, g * m,
+                                     out_pack);
+        }
+        input_data += in_c * in_h * in_w;
+        output_data += out_c * out_h * out_w;
+    }
+    shl_mem_free(im2col_buf);
+    return CSINN_TRUE;
+}
+
+/*************************************************************
+ * sparse fc, the batch is the vectorized dimension:
+ * input [batch, in_nodes] is transposed to [in_nodes, batch] and every
+ * output node is written with a stride of out_nodes.
+ *************************************************************/
+int shl_rvv_fullyconnected_sparse_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                                       struct csinn_tensor *weights, struct csinn_tensor *bias,
+                                       struct csinn_fc_params *params)
+{
+    __fp16 *input_data = (__fp16 *)input->data;
+    __fp16 *output_data = (__fp16 *)output->data;
+    __fp16 *weights_data = (__fp16 *)weights->data;
+    __fp16 *bias_data = bias->dim_count != 0 ? (__fp16 *)bias->data : NULL;
+    const int output_dims_count = output->dim_count;
+    const int weights_dims_count = weights->dim_count;
+    int batches = 1;
+    for (int i = 0; i < output_dims_count - 1; i++) {
+        batches *= output->dim[i];
+    }
+    const int output_depth = weights->dim[weights_dims_count - 2];
+    const int accum_depth = weights->dim[weights_dims_count - 1];
+
+    __fp16 *input_trans = (__fp16 *)shl_mem_alloc(batches * accum_depth * sizeof(__fp16));
+    for (int j = 0; j < accum_depth; j++) {
+        int b = 0;
+        while (b < batches) {
+            int vl = vsetvl_e16m4(batches - b);
+            vfloat16m4_t _in =
+                vlse16_v_f16m4(input_data + b * accum_depth + j, accum_depth * sizeof(__fp16), vl);
+            vse16_v_f16m4(input_trans + j * batches + b, _in, vl);
+            b += vl;
+        }
+    }
+    shl_rvv_sparse_gemm_fp16(output_data, weights_data, shl_sparse_index(weights), input_trans,
+                             bias_data, output_depth, accum_depth, batches,
+                             shl_sparse_keep(weights->mtype), 0, output_depth);
+    shl_mem_free(input_trans);
+    return CSINN_TRUE;
+}
@@ -0,0 +1,304 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_thead_rvv.h"
+
+/* widening product of one row rounded once by vnclip, then narrow to int8 */
+static vint8m1_t requantize_m4(vint32m4_t _src, int32_t multiplier, int32_t shift, int32_t out_zp,
+                               int vl)
+{
+    vint64m8_t _mulw = vwmul_vx_i64m8(_src, multiplier, vl);
+    vint32m4_t _res = vnclip_wx_i32m4(_mulw, 31 - shift, vl);
+    _res = vsadd_vx_i32m4(_res, out_zp, vl);
+    vint16m2_t _tmp1 = vnclip_wx_i16m2(_res, 0, vl);
+    return vnclip_wx_i8m1(_tmp1, 0, vl);
+}
+
+/*************************************************************
+ * int8 structured sparse gemm, same addressing as shl_rvv_sparse_gemm_fp16.
+ * The input zero point is fused into bias, every row is accumulated in int32,
+ * requantized with its own multiplier/shift and saturated to int8 in registers
+ * before the (strided when out_pack > 1) store.
+ *************************************************************/
+void shl_rvv_sparse_gemm_int8(int8_t *dst, const int8_t *values, const uint8_t *index,
+                              const int8_t *sb, const int32_t *bias, int m, int k, int n,
+                              int keep, int row0, int out_pack, int32_t out_zp,
+                              int32_t *multiplier, int32_t *shift)
+{
+    const int groups = (k + 3) / 4;
+
+    for (int i = 0; i < m; i++) {
+        const int8_t *w = values + i * groups * keep;
+        const uint8_t *idx = index + i * groups;
+        int o = row0 + i;
+        int8_t *out_ptr = dst + (o / out_pack) * n * out_pack + o % out_pack;
+
+        int t = 0;
+        while (t < n) {
+            int vl = vsetvl_e8m1(n - t);
+            vint32m4_t _acc = vmv_v_x_i32m4(bias[i], vl);
+            for (int g = 0; g < groups; g++) {
+                for (int j = 0; j < keep; j++) {
+                    int d = g * 4 + ((idx[g] >> (2 * j)) & 3);
+                    vint8m1_t _in = vle8_v_i8m1(sb + d * n + t, vl);
+                    vint16m2_t _mul = vwmul_vx_i16m2(_in, w[g * keep + j], vl);
+                    _acc = vwmacc_vx_i32m4(_acc, 1, _mul, vl);
+                }
+            }
+            vint8m1_t _res = requantize_m4(_acc, multiplier[i], shift[i], out_zp, vl);
+            if (out_pack == 1) {
+                vse8_v_i8m1(out_ptr + t, _res, vl);
+            } else {
+                vsse8_v_i8m1(out_ptr + t * out_pack, out_pack * sizeof(int8_t), _res, vl);
+            }
+            t += vl;
+        }
+    }
+}
+
+/* fuse the input zero point into bias_data with the compressed weights */
+static void sparse_fuse_zp2bias_int8(struct csinn_tensor *input, struct csinn_tensor *kernel,
+                                     int32_t *bias_data)
+{
+    int8_t *kernel_data = (int8_t *)kernel->data;
+    int32_t input_zp = input->qinfo->zero_point;
+    int32_t out_c = kernel->dim[0];
+    int32_t row_size = shl_sparse_groups(kernel) * shl_sparse_keep(kernel->mtype);
+
+    for (int oc = 0; oc < out_c; oc++) {
+        int32_t tmp = 0;
+        for (int j = 0; j < row_size; j++) {
+            tmp += kernel_data[oc * row_size + j] * input_zp;
+        }
+        bias_data[oc] -= tmp;
+    }
+}
+
+/*
+ * Bias of the sparse gemm. A layer without bias has no buffer the init could fold the
+ * input zero point into, so it is built here per call and freed by the caller.
+ */
+static int32_t *sparse_get_bias_int8(struct csinn_tensor *input, struct csinn_tensor *kernel,
+                                     struct csinn_tensor *bias, bool fuse_zp2bias)
+{
+    if (bias->data != NULL) {
+        return (int32_t *)bias->data;
+    }
+    int32_t *bias_data = (int32_t *)shl_mem_alloc(kernel->dim[0] * sizeof(int32_t));
+    if (!fuse_zp2bias) {
+        sparse_fuse_zp2bias_int8(input, kernel, bias_data);
+    }
+    return bias_data;
+}
+
+static void sparse_quantize_multiplier_int8(struct csinn_tensor *input,
+                                            struct csinn_tensor *output,
+                                            struct csinn_tensor *kernel)
+{
+    // support channel quantization
+    for (int i = 0; i < kernel->quant_channel; i++) {
+        float real_scale = input->qinfo->scale * kernel->qinfo[i].scale / output->qinfo->scale;
+        shl_quantize_multiplier(real_scale, &(kernel->qinfo[i].multiplier),
+                                &(kernel->qinfo[i].shift));
+    }
+}
+
+/* per output channel multiplier and shift of rows [row0, row0 + m) */
+static void sparse_get_multiplier_int8(struct csinn_tensor *kernel, int row0, int m,
+                                       int32_t *multiplier, int32_t *shift)
+{
+    for (int c = 0; c < m; c++) {
+        int q = kernel->quant_channel > 1 ? row0 + c : 0;
+        multiplier[c] = kernel->qinfo[q].multiplier;
+        shift[c] = kernel->qinfo[q].shift;
+    }
+}
+
+int shl_rvv_conv2d_sparse_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                    struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                    struct csinn_conv2d_params *params)
+{
+    params->conv_extra.conv_mode = CSINN_GEMM;
+    sparse_quantize_multiplier_int8(input, output, kernel);
+    if (!params->conv_extra.fuse_zp2bias && bias->data != NULL) {
+        sparse_fuse_zp2bias_int8(input, kernel, (int32_t *)bias->data);
+    }
+    params->base.cb->exec = shl_rvv_conv2d_sparse_int8;
+    return CSINN_TRUE;
+}
+
+/*
+ * im2col of one group into [in_cp * maxk, out_h * out_w], channels c0 .. c0 + in_cp - 1,
+ * padding takes the input zero point.
+ */
+static void im2col_sparse_int8(const int8_t *src, int8_t *dst, int c0, int in_cp, int in_pack,
+                               int in_h, int in_w, int out_h, int out_w, int ksize_h,
+                               int ksize_w, struct csinn_conv2d_params *params, int8_t pad_value)
+{
+    const int in_hw = in_h * in_w;
+    for (int c = 0; c < in_cp; c++) {
+        int ch = c0 + c;
+        const int8_t *plane = src + (ch / in_pack) * in_hw * in_pack + ch % in_pack;
+        for (int a = 0; a < ksize_h; a++) {
+            for (int b = 0; b < ksize_w; b++) {
+                for (int y = 0; y < out_h; y++) {
+                    int iy = y * params->stride_height - params->pad_top +
+                             a * params->dilation_height;
+                    for (int x = 0; x < out_w; x++) {
+                        int ix = x * params->stride_width - params->pad_left +
+                                 b * params->dilation_width;
+                        if (iy < 0 || iy >= in_h || ix < 0 || ix >= in_w) {
+                            *dst++ = pad_value;
+                        } else {
+                            *dst++ = plane[(iy * in_w + ix) * in_pack];
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+int shl_rvv_conv2d_sparse_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                               struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                               struct csinn_conv2d_params *params)
+{
+    int8_t *input_data = (int8_t *)input->data;
+    int8_t *output_data = (int8_t *)output->data;
+    int8_t *kernel_data = (int8_t *)kernel->data;
+    int32_t *bias_data =
+        sparse_get_bias_int8(input, kernel, bias, params->conv_extra.fuse_zp2bias);
+    uint8_t *index = shl_sparse_index(kernel);
+    const int keep = shl_sparse_keep(kernel->mtype);
+
+    int32_t group = params->group;
+    int32_t batch = input->dim[0];
+    int32_t in_c = input->dim[1];
+    int32_t in_h = input->dim[2];
+    int32_t in_w = input->dim[3];
+    int32_t out_c = output->dim[1];
+    int32_t out_h = output->dim[2];
+    int32_t out_w = output->dim[3];
+    int32_t ksize_h = kernel->dim[2];
+    int32_t ksize_w = kernel->dim[3];
+
+    const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
+    const int in_pack = in_c % packn == 0 ? packn : 1;
+    const int out_pack = out_c % packn == 0 ? packn : 1;
+
+    int32_t m = out_c / group;
+    int32_t in_cp = in_c / group;
+    int32_t k = in_cp * ksize_h * ksize_w;
+    int32_t n = out_h * out_w;
+    int32_t groups = shl_sparse_groups(kernel);
+    bool direct = in_pack == 1 && ksize_h == 1 && ksize_w == 1 && params->stride_height == 1 &&
+                  params->stride_width == 1 && params->pad_top == 0 && params->pad_left == 0 &&
+                  params->pad_down == 0 && params->pad_right == 0;
+
+    int8_t *im2col_buf = direct ? NULL : (int8_t *)shl_mem_alloc(k * n * sizeof(int8_t));
+    int32_t *multiplier = (int32_t *)shl_mem_alloc(m * sizeof(int32_t));
+    int32_t *shift = (int32_t *)shl_mem_alloc(m * sizeof(int32_t));
+
+    for (int i = 0; i < batch; i++) {
+        for (int g = 0; g < group; g++) {
+            int8_t *sb = input_data + g * in_cp * in_h * in_w;
+            if (!direct) {
+                im2col_sparse_int8(input_data, im2col_buf, g * in_cp, in_cp, in_pack, in_h, in_w,
+                                   out_h, out_w, ksize_h, ksize_w, params,
+                                   input->qinfo->zero_point);
+                sb = im2col_buf;
+            }
+            sparse_get_multiplier_int8(kernel, g * m, m, multiplier, shift);
+            shl_rvv_sparse_gemm_int8(output_data, kernel_data + g * m * groups * keep,
+                                     index + g * m * groups, sb, bias_data + g * m, m, k, n, keep,
+                                     g * m, out_pack, output->qinfo->zero_point, multiplier,
+                                     shift);
+        }
+        input_data += in_c * in_h * in_w;
+        output_data += out_c * out_h * out_w;
+    }
+    shl_mem_free(im2col_buf);
+    shl_mem_free(multiplier);
+    shl_mem_free(shift);
+    if (bias_data != bias->data) {
+        shl_mem_free(bias_data);
+    }
+    return CSINN_TRUE;
+}
+
+int shl_rvv_fullyconnected_sparse_init_int8(struct csinn_tensor *input,
+                                            struct csinn_tensor *output,
+                                            struct csinn_tensor *weights,
+                                            struct csinn_tensor *bias,
+                                            struct csinn_fc_params *params)
+{
+    sparse_quantize_multiplier_int8(input, output, weights);
+    if (!params->fc_extra.fuse_zp2bias && bias->data != NULL) {
+        sparse_fuse_zp2bias_int8(input, weights, (int32_t *)bias->data);
+    }
+    params->base.cb->exec = shl_rvv_fullyconnected_sparse_int8;
+    return CSINN_TRUE;
+}
+
+/* see shl_rvv_fullyconnected_sparse_fp16 */
+int shl_rvv_fullyconnected_sparse_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                       struct csinn_tensor *weights, struct csinn_tensor *bias,
+                                       struct csinn_fc_params *params)
+{
+    int8_t *input_data = (int8_t *)input->data;
+    int8_t *output_data = (int8_t *)output->data;
+    int8_t *weights_data = (int8_t *)weights->data;
+    int32_t *bias_data =
+        sparse_get_bias_int8(input, weights, bias, params->fc_extra.fuse_zp2bias);
+    const int output_dims_count = output->dim_count;
+    const int weights_dims_count = weights->dim_count;
+    int batches = 1;
+    for (int i = 0; i < output_dims_count - 1; i++) {
+        batches *= output->dim[i];
+    }
+    const int output_depth = weights->dim[weights_dims_count - 2];
+    const int accum_depth = weights->dim[weights_dims_count - 1];
+
+    int8_t *input_trans = (int8_t *)shl_mem_alloc(batches * accum_depth * sizeof(int8_t));
+    for (int j = 0; j < accum_depth; j++) {
+        int b = 0;
+        while (b < batches) {
+            int vl = vsetvl_e8m1(batches - b);
+            vint8m1_t _in =
+                vlse8_v_i8m1(input_data + b * accum_depth + j, accum_depth * sizeof(int8_t), vl);
+            vse8_v_i8m1(input_trans + j * batches + b, _in, vl);
+            b += vl;
+        }
+    }
+    int32_t *multiplier = (int32_t *)shl_mem_alloc(output_depth * sizeof(int32_t));
+    int32_t *shift = (int32_t *)shl_mem_alloc(output_depth * sizeof(int32_t));
+    sparse_get_multiplier_int8(weights, 0, output_depth, multiplier, shift);
+    shl_rvv_sparse_gemm_int8(output_data, weights_data, shl_sparse_index(weights), input_trans,
+                             bias_data, output_depth, accum_depth, batches,
+                             shl_sparse_keep(weights->mtype), 0, output_depth,
+                             output->qinfo->zero_point, multiplier, shift);
+    shl_mem_free(input_trans);
+    shl_mem_free(multiplier);
+    shl_mem_free(shift);
+    if (bias_data != bias->data) {
+        shl_mem_free(bias_data);
+    }
+    return CSINN_TRUE;
+}
@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_thead_rvv.h"
+
+/*
+ * one axis of phase r of a stride 2 deconv: ntap taps r, r + 2, ... of the kernel,
+ * and the nq outputs 2 * q + r - pad, q = q0 .. q0 + nq - 1, inside [0, out_size)
+ */
+void shl_rvv_deconv2d_s2_phase(int r, int ksize, int pad, int out_size, int *ntap, int *q0,
+                               int *nq)
+{
+    int q1 = out_size - 1 + pad - r;
+    *ntap = (ksize - r + 1) / 2;
+    *q0 = (pad - r + 1) / 2;
+    *nq = q1 < 0 ? 0 : q1 / 2 - *q0 + 1;
+    if (*nq < 0) {
+        *nq = 0;
+    }
+}
+
+static bool deconv2d_s2_check(struct csinn_tensor *kernel, struct csinn_conv2d_params *params)
+{
+    return params->stride_height == 2 && params->stride_width == 2 &&
+           params->dilation_height == 1 && params->dilation_width == 1 && kernel->dim[2] >= 2 &&
+           kernel->dim[3] >= 2;
+}
+
+int shl_rvv_deconv2d_init_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                               struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                               struct csinn_conv2d_params *params)
+{
+    struct csinn_callback *cb = params->base.cb;
+
+    if (params->base.layout != CSINN_LAYOUT_NCHW) {
+        cb->exec = shl_ref_deconv2d_f32;
+    } else if (deconv2d_s2_check(kernel, params)) {
+        shl_rvv_deconv2d_s2_reorder_kernel_fp32(kernel, params);
+        cb->exec = shl_rvv_deconv2d_s2_fp32;
+    } else {
+        shl_rvv_deconv2d_gemm_col2im_reorder_kernel_fp32(kernel, params);
+        cb->exec = shl_rvv_deconv2d_gemm_col2im_fp32;
+    }
+    return CSINN_TRUE;
+}
+
+int shl_rvv_deconv2d_init_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                               struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                               struct csinn_conv2d_params *params)
+{
+    struct csinn_callback *cb = params->base.cb;
+
+    if (params->base.layout != CSINN_LAYOUT_NCHW) {
+        cb->exec = shl_ref_deconv2d_quant;
+    } else if (deconv2d_s2_check(kernel, params)) {
+        shl_rvv_deconv2d_s2_reorder_kernel_fp16(kernel, params);
+        cb->exec = shl_rvv_deconv2d_s2_fp16;
+    } else {
+        shl_rvv_deconv2d_gemm_col2im_reorder_kernel_fp16(kernel, params);
+        cb->exec = shl_rvv_deconv2d_gemm_col2im_fp16;
+    }
+    return CSINN_TRUE;
+}
+
+int shl_rvv_deconv2d_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                               struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                               struct csinn_conv2d_params *params)
+{
+    struct csinn_callback *cb = params->base.cb;
+#ifdef XTHEADV
+    // the kernel is [in_c, out_c, h, w], channel quantization is along in_c
+    if (params->base.layout != CSINN_LAYOUT_NCHW || kernel->quant_channel != 1) {
+        cb->exec = shl_ref_deconv2d_quant;
+        return CSINN_TRUE;
+    }
+
+    params->conv_extra.kernel_tm = csinn_alloc_tensor(NULL);
+    if (deconv2d_s2_check(kernel, params)) {
+        shl_rvv_deconv2d_s2_reorder_kernel_int8(kernel, bias, input->qinfo->zero_point, params);
+        cb->exec = shl_rvv_deconv2d_s2_int8;
+    } else {
+        shl_rvv_deconv2d_gemm_col2im_reorder_kernel_int8(kernel, input->qinfo->zero_point,
+                                                         params);
+        cb->exec = shl_rvv_deconv2d_gemm_col2im_int8;
+    }
+
+    float real_scale = input->qinfo->scale * kernel->qinfo->scale / output->qinfo->scale;
+    shl_quantize_multiplier(real_scale, &(kernel->qinfo->multiplier), &(kernel->qinfo->shift));
+#else
+    cb->exec = shl_ref_deconv2d_quant;
+#endif
+    return CSINN_TRUE;
+}
+
+int shl_rvv_depthwise_deconv2d_init_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                                         struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                         struct csinn_conv2d_params *params)
+{
+    int32_t in_c = input->dim[1];
+    struct csinn_callback *cb = params->base.cb;
+
+    const int packn = csrr_vlenb() / sizeof(float);
+
+    if (params->base.layout == CSINN_LAYOUT_NCHW && in_c % packn == 0) {
+        shl_rvv_dwconv_reorder_kernel_packn_fp32(kernel, params);
+        cb->exec = shl_rvv_depthwise_deconv2d_packn_fp32;
+    } else {
+        cb->exec = shl_ref_depthwise_deconv2d_f32;
+    }
+    return CSINN_TRUE;
+}
+
+int shl_rvv_depthwise_deconv2d_init_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                                         struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                         struct csinn_conv2d_params *params)
+{
+    int32_t in_c = input->dim[1];
+    struct csinn_callback *cb = params->base.cb;
+
+    const int packn = csrr_vlenb() / sizeof(__fp16);
+
+    if (params->base.layout == CSINN_LAYOUT_NCHW && in_c % packn == 0) {
+        shl_rvv_dwconv_reorder_kernel_packn_fp16(kernel, params);
+        cb->exec = shl_rvv_depthwise_deconv2d_packn_fp16;
+    } else {
+        cb->exec = shl_ref_depthwise_deconv2d_quant;
+    }
+    return CSINN_TRUE;
+}
+
+int shl_rvv_depthwise_deconv2d_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                         struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                         struct csinn_conv2d_params *params)
+{
+    int32_t in_c = input->dim[1];
+    struct csinn_callback *cb = params->base.cb;
+
+    const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
+#ifdef XTHEADV
+    if (params->base.layout == CSINN_LAYOUT_NCHW && in_c % packn == 0) {
+        shl_rvv_dwconv_reorder_kernel_packn_int8(kernel, params);
+        cb->exec = shl_rvv_depthwise_deconv2d_packn_int8;
+        // support channel quantization
+        for (int i = 0; i < kernel->quant_channel; i++) {
+            float real_scale = input->qinfo->scale * kernel->qinfo[i].scale / output->qinfo->scale;
+            shl_quantize_multiplier(real_scale, &(kernel->qinfo[i].multiplier),
+                                    &(kernel->qinfo[i].shift));
+        }
+        return CSINN_TRUE;
+    }
+#endif
+    cb->exec = shl_ref_depthwise_deconv2d_quant;
+    return CSINN_TRUE;
+}
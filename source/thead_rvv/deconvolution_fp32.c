@@ -0,0 +1,417 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_thead_rvv.h"
+
+/* unpack [C/packn, H, W, packn] into [C, H * W] */
+static void deconv_unpack_fp32(const float *src, float *dst, int channel, int hw, int pack)
+{
+    for (int c = 0; c < channel; c++) {
+        const float *s_ptr = src + (c / pack) * hw * pack + c % pack;
+        float *d_ptr = dst + c * hw;
+        int i = 0;
+        while (i < hw) {
+            int vl = vsetvl_e32m4(hw - i);
+            vfloat32m4_t _in = vlse32_v_f32m4(s_ptr + i * pack, pack * sizeof(float), vl);
+            vse32_v_f32m4(d_ptr + i, _in, vl);
+            i += vl;
+        }
+    }
+}
+
+/* fill every output channel with its bias, the element stride is pack */
+static void deconv_fill_bias_fp32(float *dst, const float *bias, int channel, int hw, int pack)
+{
+    for (int c = 0; c < channel; c++) {
+        float *d_ptr = dst + (c / pack) * hw * pack + c % pack;
+        float b = bias ? bias[c] : 0.0f;
+        int i = 0;
+        while (i < hw) {
+            int vl = vsetvl_e32m4(hw - i);
+            vfloat32m4_t _b = vfmv_v_f_f32m4(b, vl);
+            vsse32_v_f32m4(d_ptr + i * pack, pack * sizeof(float), _b, vl);
+            i += vl;
+        }
+    }
+}
+
+/*
+ * col: [out_c, kernel_h, kernel_w, in_h, in_w] is accumulated into the output,
+ * in the packn layout when out_pack = packn, vectorized along in_w.
+ */
+static void deconv_col2im_fp32(const float *col, float *dst, int out_c, int out_h, int out_w,
+                               int out_pack, int in_h, int in_w, int kernel_h, int kernel_w,
+                               struct csinn_conv2d_params *params)
+{
+    const int stride_h = params->stride_height;
+    const int stride_w = params->stride_width;
+    const int ostride = stride_w * out_pack;
+
+#pragma omp parallel for num_threads(1)
+    for (int c = 0; c < out_c; c++) {
+        float *plane = dst + (c / out_pack) * out_h * out_w * out_pack + c % out_pack;
+        for (int ky = 0; ky < kernel_h; ky++) {
+            for (int kx = 0; kx < kernel_w; kx++) {
+                const float *col_ptr = col + ((c * kernel_h + ky) * kernel_w + kx) * in_h * in_w;
+                int off_x = kx * params->dilation_width - params->pad_left;
+                int x0 = off_x >= 0 ? 0 : (stride_w - 1 - off_x) / stride_w;
+                int x1 = out_w - off_x <= 0 ? 0 : (out_w - 1 - off_x) / stride_w + 1;
+                x1 = x1 < in_w ? x1 : in_w;
+                for (int y = 0; y < in_h; y++) {
+                    int oy = y * stride_h - params->pad_top + ky * params->dilation_height;
+                    if (oy < 0 || oy >= out_h) {
+                        continue;
+                    }
+                    float *out = plane + (oy * out_w + x0 * stride_w + off_x) * out_pack;
+                    const float *src = col_ptr + y * in_w + x0;
+                    int x = x0;
+                    while (x < x1) {
+                        int vl = vsetvl_e32m4(x1 - x);
+                        vfloat32m4_t _acc = vlse32_v_f32m4(out, ostride * sizeof(float), vl);
+                        _acc = vfadd_vv_f32m4(_acc, vle32_v_f32m4(src, vl), vl);
+                        vsse32_v_f32m4(out, ostride * sizeof(float), _acc, vl);
+                        out += vl * ostride;
+                        src += vl;
+                        x += vl;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*************************************************************
+ * kernel [in_c, out_c, kernel_h, kernel_w] is transposed to
+ * [out_c * kernel_h * kernel_w, in_c] and packed for gemm in place
+ *************************************************************/
+void shl_rvv_deconv2d_gemm_col2im_reorder_kernel_fp32(struct csinn_tensor *kernel,
+                                                      struct csinn_conv2d_params *params)
+{
+    float *kernel_data = (float *)kernel->data;
+    int k = kernel->dim[0];
+    int m = kernel->dim[1] * kernel->dim[2] * kernel->dim[3];
+
+    float *kernel_trans = (float *)shl_mem_alloc(m * k * sizeof(float));
+    for (int i = 0; i < m; i++) {
+        for (int j = 0; j < k; j++) {
+            kernel_trans[i * k + j] = kernel_data[j * m + i];
+        }
+    }
+    shl_rvv_reorder_kernel_n8_fp32(kernel_trans, kernel_data, m, k, k);
+    shl_mem_free(kernel_trans);
+}
+
+/*************************************************************
+ * deconv as gemm + col2im:
+ * col[out_c * kernel_h * kernel_w, in_h * in_w] = kernel^T * input[in_c, in_h * in_w]
+ * then every column is added to the output window it covers
+ *************************************************************/
+int shl_rvv_deconv2d_gemm_col2im_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                                      struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                      struct csinn_conv2d_params *params)
+{
+    float *input_data = (float *)input->data;
+    float *output_data = (float *)output->data;
+    float *kernel_data = (float *)kernel->data;
+    float *bias_data = bias->dim_count != 0 ? (float *)bias->data : NULL;
+
+    int32_t batch = input->dim[0];
+    int32_t in_c = input->dim[1];
+    int32_t in_h = input->dim[2];
+    int32_t in_w = input->dim[3];
+    int32_t out_c = output->dim[1];
+    int32_t out_h = output->dim[2];
+    int32_t out_w = output->dim[3];
+    int32_t kernel_h = kernel->dim[2];
+    int32_t kernel_w = kernel->dim[3];
+
+    const int packn = csrr_vlenb() / sizeof(float);
+    const int in_pack = in_c % packn == 0 ? packn : 1;
+    const int out_pack = out_c % packn == 0 ? packn : 1;
+
+    int32_t m = out_c * kernel_h * kernel_w;
+    int32_t k = in_c;
+    int32_t n = in_h * in_w;
+
+    float *input_buf = in_pack == 1 ? NULL : (float *)shl_mem_alloc(k * n * sizeof(float));
+    float *pb_reorder = (float *)shl_mem_alloc(k * n * sizeof(float));
+    float *col_buf = (float *)shl_mem_alloc(m * n * sizeof(float));
+
+    for (int i = 0; i < batch; i++) {
+        float *in_ptr = input_data;
+        if (in_pack != 1) {
+            deconv_unpack_fp32(input_data, input_buf, in_c, n, in_pack);
+            in_ptr = input_buf;
+        }
+        shl_rvv_reorder_input_z8_fp32(in_ptr, pb_reorder, k, n, n);
+        shl_rvv_gemm_8x8_fp32(col_buf, kernel_data, pb_reorder, NULL, m, k, n, n);
+
+        deconv_fill_bias_fp32(output_data, bias_data, out_c, out_h * out_w, out_pack);
+        deconv_col2im_fp32(col_buf, output_data, out_c, out_h, out_w, out_pack, in_h, in_w,
+                           kernel_h, kernel_w, params);
+
+        input_data += in_c * in_h * in_w;
+        output_data += out_c * out_h * out_w;
+    }
+    shl_mem_free(input_buf);
+    shl_mem_free(pb_reorder);
+    shl_mem_free(col_buf);
+    return CSINN_TRUE;
+}
+
+/*************************************************************
+ * the sub kernel of every phase of a stride 2 deconv, see shl_rvv_deconv2d_s2_fp32,
+ * [out_c, in_c, nty, ntx] per phase, packed for gemm and stored one after another in place
+ *************************************************************/
+void shl_rvv_deconv2d_s2_reorder_kernel_fp32(struct csinn_tensor *kernel,
+                                             struct csinn_conv2d_params *params)
+{
+    float *kernel_data = (float *)kernel->data;
+    int in_c = kernel->dim[0];
+    int out_c = kernel->dim[1];
+    int kernel_h = kernel->dim[2];
+    int kernel_w = kernel->dim[3];
+    int size = in_c * out_c * kernel_h * kernel_w;
+
+    float *sub_kernel = (float *)shl_mem_alloc(size * sizeof(float));
+    float *kernel_trans = (float *)shl_mem_alloc(size * sizeof(float));
+    float *pa = kernel_trans;
+    for (int ry = 0; ry < 2; ry++) {
+        for (int rx = 0; rx < 2; rx++) {
+            int nty = (kernel_h - ry + 1) / 2;
+            int ntx = (kernel_w - rx + 1) / 2;
+            int k = in_c * nty * ntx;
+            for (int oc = 0; oc < out_c; oc++) {
+                for (int ic = 0; ic < in_c; ic++) {
+                    for (int ty = 0; ty < nty; ty++) {
+                        for (int tx = 0; tx < ntx; tx++) {
+                            sub_kernel[oc * k + (ic * nty + ty) * ntx + tx] =
+                                kernel_data[((ic * out_c + oc) * kernel_h + ry + 2 * ty) *
+                                                kernel_w +
+                                            rx + 2 * tx];
+                        }
+                    }
+                }
+            }
+            shl_rvv_reorder_kernel_n8_fp32(sub_kernel, pa, out_c, k, k);
+            pa += out_c * k;
+        }
+    }
+    memcpy(kernel_data, kernel_trans, size * sizeof(float));
+    shl_mem_free(sub_kernel);
+    shl_mem_free(kernel_trans);
+}
+
+/*************************************************************
+ * stride 2 deconv by sub-pixel phases, no zero inserted position is computed:
+ * the outputs of phase (ry, rx), oy = 2 * qy + ry - pad_top, only see the taps
+ * ky = ry + 2 * ty, kx = rx + 2 * tx at input (qy - ty, qx - tx), so every phase
+ * is a stride 1 conv by gemm whose result is scattered with a stride of 2.
+ * constrain: dilation = 1, kernel_h >= 2, kernel_w >= 2
+ *************************************************************/
+int shl_rvv_deconv2d_s2_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                             struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                             struct csinn_conv2d_params *params)
+{
+    float *input_data = (float *)input->data;
+    float *output_data = (float *)output->data;
+    float *kernel_data = (float *)kernel->data;
+    float *bias_data = bias->dim_count != 0 ? (float *)bias->data : NULL;
+
+    int32_t batch = input->dim[0];
+    int32_t in_c = input->dim[1];
+    int32_t in_h = input->dim[2];
+    int32_t in_w = input->dim[3];
+    int32_t out_c = output->dim[1];
+    int32_t out_h = output->dim[2];
+    int32_t out_w = output->dim[3];
+    int32_t kernel_h = kernel->dim[2];
+    int32_t kernel_w = kernel->dim[3];
+
+    const int packn = csrr_vlenb() / sizeof(float);
+    const int in_pack = in_c % packn == 0 ? packn : 1;
+    const int out_pack = out_c % packn == 0 ? packn : 1;
+
+    int32_t max_k = in_c * ((kernel_h + 1) / 2) * ((kernel_w + 1) / 2);
+    int32_t max_n = ((out_h + 1) / 2) * ((out_w + 1) / 2);
+    float *im2col_buf = (float *)shl_mem_alloc(max_k * max_n * sizeof(float));
+    float *pb_reorder = (float *)shl_mem_alloc(max_k * max_n * sizeof(float));
+    float *gemm_buf = (float *)shl_mem_alloc(out_c * max_n * sizeof(float));
+
+    for (int b = 0; b < batch; b++) {
+        float *pa = kernel_data;
+        for (int ry = 0; ry < 2; ry++) {
+            for (int rx = 0; rx < 2; rx++) {
+                int nty, qy0, nqy, ntx, qx0, nqx;
+                shl_rvv_deconv2d_s2_phase(ry, kernel_h, params->pad_top, out_h, &nty, &qy0, &nqy);
+                shl_rvv_deconv2d_s2_phase(rx, kernel_w, params->pad_left, out_w, &ntx, &qx0,
+                                          &nqx);
+                int k = in_c * nty * ntx;
+                int n = nqy * nqx;
+                if (n == 0) {
+                    pa += out_c * k;
+                    continue;
+                }
+
+                // im2col of the phase: [in_c, nty, ntx] x [nqy, nqx]
+                float *col = im2col_buf;
+                for (int ic = 0; ic < in_c; ic++) {
+                    const float *plane =
+                        input_data + (ic / in_pack) * in_h * in_w * in_pack + ic % in_pack;
+                    for (int ty = 0; ty < nty; ty++) {
+                        for (int tx = 0; tx < ntx; tx++) {
+                            int ix_base = qx0 - tx;
+                            int i0 = ix_base >= 0 ? 0 : -ix_base;
+                            i0 = i0 < nqx ? i0 : nqx;
+                            int i1 = in_w - ix_base < nqx ? in_w - ix_base : nqx;
+                            i1 = i1 > i0 ? i1 : i0;
+                            for (int j = 0; j < nqy; j++) {
+                                int iy = qy0 + j - ty;
+                                if (iy < 0 || iy >= in_h) {
+                                    memset(col, 0, nqx * sizeof(float));
+                                    col += nqx;
+                                    continue;
+                                }
+                                const float *src = plane + (iy * in_w + ix_base + i0) * in_pack;
+                                for (int i = 0; i < i0; i++) {
+                                    col[i] = 0.0f;
+                                }
+                                int i = i0;
+                                while (i < i1) {
+                                    int vl = vsetvl_e32m4(i1 - i);
+                                    vfloat32m4_t _in =
+                                        vlse32_v_f32m4(src, in_pack * sizeof(float), vl);
+                                    vse32_v_f32m4(col + i, _in, vl);
+                                    src += vl * in_pack;
+                                    i += vl;
+                                }
+                                for (i = i1; i < nqx; i++) {
+                                    col[i] = 0.0f;
+                                }
+                                col += nqx;
+                            }
+                        }
+                    }
+                }
+
+                shl_rvv_reorder_input_z8_fp32(im2col_buf, pb_reorder, k, n, n);
+                shl_rvv_gemm_8x8_fp32(gemm_buf, pa, pb_reorder, bias_data, out_c, k, n, n);
+
+                // scatter the phase into the output
+                for (int oc = 0; oc < out_c; oc++) {
+                    float *plane = output_data + (oc / out_pack) * out_h * out_w * out_pack +
+                                   oc % out_pack;
+                    const float *src = gemm_buf + oc * n;
+                    for (int j = 0; j < nqy; j++) {
+                        int oy = 2 * (qy0 + j) + ry - params->pad_top;
+                        int ox = 2 * qx0 + rx - params->pad_left;
+                        float *dst = plane + (oy * out_w + ox) * out_pack;
+                        int i = 0;
+                        while (i < nqx) {
+                            int vl = vsetvl_e32m4(nqx - i);
+                            vfloat32m4_t _out = vle32_v_f32m4(src, vl);
+                            vsse32_v_f32m4(dst, 2 * out_pack * sizeof(float), _out, vl);
+                            dst += vl * 2 * out_pack;
+                            src += vl;
+                            i += vl;
+                        }
+                    }
+                }
+                pa += out_c * k;
+            }
+        }
+        input_data += in_c * in_h * in_w;
+        output_data += out_c * out_h * out_w;
+    }
+    shl_mem_free(im2col_buf);
+    shl_mem_free(pb_reorder);
+    shl_mem_free(gemm_buf);
+    return CSINN_TRUE;
+}
+
+/*************************************************************
+ * depthwise deconv, packn channels: every output gathers the taps
+ * whose input position lands on the stride grid
+ * constrain: in_c % packn = 0, kernel reordered by shl_rvv_dwconv_reorder_kernel_packn_fp32
+ *************************************************************/
+int shl_rvv_depthwise_deconv2d_packn_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                                          struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                          struct csinn_conv2d_params *params)
+{
+    float *input_data = (float *)input->data;
+    float *output_data = (float *)output->data;
+    float *kernel_data = (float *)kernel->data;
+    float *bias_data = bias->dim_count != 0 ? (float *)bias->data : NULL;
+
+    int32_t batch = input->dim[0];
+    int32_t in_c = input->dim[1];
+    int32_t in_h = input->dim[2];
+    int32_t in_w = input->dim[3];
+    int32_t out_h = output->dim[2];
+    int32_t out_w = output->dim[3];
+    int32_t kernel_h = kernel->dim[2];
+    int32_t kernel_w = kernel->dim[3];
+    int32_t stride_h = params->stride_height;
+    int32_t stride_w = params->stride_width;
+    int32_t dilation_h = params->dilation_height;
+    int32_t dilation_w = params->dilation_width;
+
+    const int packn = csrr_vlenb() / sizeof(float);
+    const int vl = vsetvl_e32m1(packn);
+
+    for (int b = 0; b < batch; b++) {
+#pragma omp parallel for num_threads(1)
+        for (int c = 0; c + packn - 1 < in_c; c += packn) {
+            const float *img0 = input_data + c * in_h * in_w;
+            const float *kernel0 = kernel_data + c * kernel_h * kernel_w;
+            float *out0 = output_data + c * out_h * out_w;
+            vfloat32m1_t _bias0 =
+                bias_data ? vle32_v_f32m1(bias_data + c, vl) : vfmv_v_f_f32m1(0.0f, vl);
+
+            for (int oy = 0; oy < out_h; oy++) {
+                for (int ox = 0; ox < out_w; ox++) {
+                    vfloat32m1_t _acc = _bias0;
+                    for (int ky = 0; ky < kernel_h; ky++) {
+                        int ty = oy + params->pad_top - ky * dilation_h;
+                        if (ty < 0 || ty % stride_h != 0 || ty / stride_h >= in_h) {
+                            continue;
+                        }
+                        const float *row = img0 + (ty / stride_h) * in_w * packn;
+                        for (int kx = 0; kx < kernel_w; kx++) {
+                            int tx = ox + params->pad_left - kx * dilation_w;
+                            if (tx < 0 || tx % stride_w != 0 || tx / stride_w >= in_w) {
+                                continue;
+                            }
+                            vfloat32m1_t _k =
+                                vle32_v_f32m1(kernel0 + (ky * kernel_w + kx) * packn, vl);
+                            vfloat32m1_t _in = vle32_v_f32m1(row + (tx / stride_w) * packn, vl);
+                            _acc = vfmacc_vv_f32m1(_acc, _k, _in, vl);
+                        }
+                    }
+                    vse32_v_f32m1(out0, _acc, vl);
+                    out0 += packn;
+                }
+            }
+        }
+        input_data += in_c * in_h * in_w;
+        output_data += in_c * out_h * out_w;
+    }
+    return CSINN_TRUE;
+}
@@ -0,0 +1,506 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_thead_rvv.h"
+#ifdef XTHEADV
+
+static vint8mf2_t requantize_m2_s(vint32m2_t _src, vint32m2_t _multiplier, vint32m2_t _shift,
+                                  int32_t out_zp, int vl)
+{
+    vint32m2_t _mulh = vmulh_vv_i32m2(_src, _multiplier, vl);
+    _mulh = vssra_vv_i32m2(_mulh, vreinterpret_v_i32m2_u32m2(_shift), vl);
+    _mulh = vadd_vx_i32m2(_mulh, out_zp, vl);
+    vint16m1_t _tmp1 = vnclip_wx_i16m1(_mulh, 0, vl);
+    vint8mf2_t _tmp2 = vnclip_wx_i8mf2(_tmp1, 0, vl);
+    return _tmp2;
+}
+
+/* requantize one channel of int32 into int8, the element stride of dst is pack */
+static void deconv_requantize_int8(const int32_t *src, int8_t *dst, int size, int pack,
+                                   int32_t mult, int32_t shift, int32_t out_zp)
+{
+    int i = 0;
+    while (i < size) {
+        int vl = vsetvl_e32m4(size - i);
+        vint32m4_t _acc = vle32_v_i32m4(src + i, vl);
+        int32_t shift_tmp = 0;
+        if (shift < 0) {
+            shift_tmp = -shift - 1;
+        } else {
+            _acc = vsll_vx_i32m4(_acc, shift + 2, vl);
+            shift_tmp = 1;
+        }
+        vint32m4_t _mulh = vmulh_vx_i32m4(_acc, mult, vl);
+        _mulh = vssra_vx_i32m4(_mulh, shift_tmp, vl);
+        _mulh = vadd_vx_i32m4(_mulh, out_zp, vl);
+        vint16m2_t _tmp1 = vnclip_wx_i16m2(_mulh, 0, vl);
+        vint8m1_t _tmp2 = vnclip_wx_i8m1(_tmp1, 0, vl);
+        vsse8_v_i8m1(dst + i * pack, pack * sizeof(int8_t), _tmp2, vl);
+        i += vl;
+    }
+}
+
+/* unpack [C/packn, H, W, packn] into [C, H * W] */
+static void deconv_unpack_int8(const int8_t *src, int8_t *dst, int channel, int hw, int pack)
+{
+    for (int c = 0; c < channel; c++) {
+        const int8_t *s_ptr = src + (c / pack) * hw * pack + c % pack;
+        int8_t *d_ptr = dst + c * hw;
+        int i = 0;
+        while (i < hw) {
+            int vl = vsetvl_e8m1(hw - i);
+            vint8m1_t _in = vlse8_v_i8m1(s_ptr + i * pack, pack * sizeof(int8_t), vl);
+            vse8_v_i8m1(d_ptr + i, _in, vl);
+            i += vl;
+        }
+    }
+}
+
+/*
+ * col: [out_c, kernel_h, kernel_w, in_h, in_w] is accumulated into the int32
+ * output [out_c, out_h, out_w], vectorized along in_w.
+ */
+static void deconv_col2im_int32(const int32_t *col, int32_t *dst, int out_c, int out_h,
+                                int out_w, int in_h, int in_w, int kernel_h, int kernel_w,
+                                struct csinn_conv2d_params *params)
+{
+    const int stride_h = params->stride_height;
+    const int stride_w = params->stride_width;
+
+#pragma omp parallel for num_threads(1)
+    for (int c = 0; c < out_c; c++) {
+        int32_t *plane = dst + c * out_h * out_w;
+        for (int ky = 0; ky < kernel_h; ky++) {
+            for (int kx = 0; kx < kernel_w; kx++) {
+                const int32_t *col_ptr =
+                    col + ((c * kernel_h + ky) * kernel_w + kx) * in_h * in_w;
+                int off_x = kx * params->dilation_width - params->pad_left;
+                int x0 = off_x >= 0 ? 0 : (stride_w - 1 - off_x) / stride_w;
+                int x1 = out_w - off_x <= 0 ? 0 : (out_w - 1 - off_x) / stride_w + 1;
+                x1 = x1 < in_w ? x1 : in_w;
+                for (int y = 0; y < in_h; y++) {
+                    int oy = y * stride_h - params->pad_top + ky * params->dilation_height;
+                    if (oy < 0 || oy >= out_h) {
+                        continue;
+                    }
+                    int32_t *out = plane + oy * out_w + x0 * stride_w + off_x;
+                    const int32_t *src = col_ptr + y * in_w + x0;
+                    int x = x0;
+                    while (x < x1) {
+                        int vl = vsetvl_e32m4(x1 - x);
+                        vint32m4_t _acc = vlse32_v_i32m4(out, stride_w * sizeof(int32_t), vl);
+                        _acc = vadd_vv_i32m4(_acc, vle32_v_i32m4(src, vl), vl);
+                        vsse32_v_i32m4(out, stride_w * sizeof(int32_t), _acc, vl);
+                        out += vl * stride_w;
+                        src += vl;
+                        x += vl;
+                    }
+                }
+            }
+        }
+    }
+}
+
+/*************************************************************
+ * kernel [in_c, out_c, kernel_h, kernel_w] is transposed to
+ * [out_c * kernel_h * kernel_w, in_c] and packed for gemm into kernel_tm,
+ * followed by the int32 input zero point correction of every row:
+ * -input_zp * sum(row), which the gemm adds as its bias
+ *************************************************************/
+void shl_rvv_deconv2d_gemm_col2im_reorder_kernel_int8(struct csinn_tensor *kernel,
+                                                      int32_t input_zp,
+                                                      struct csinn_conv2d_params *params)
+{
+    int8_t *kernel_data = (int8_t *)kernel->data;
+    int k = kernel->dim[0];
+    int m = kernel->dim[1] * kernel->dim[2] * kernel->dim[3];
+    int k4 = (k % 4 != 0) ? ((k / 4 + 1) * 4) : k;
+
+    int8_t *kernel_trans = (int8_t *)shl_mem_alloc(m * k * sizeof(int8_t));
+    params->conv_extra.kernel_tm->data =
+        (int8_t *)shl_mem_alloc(m * k4 * sizeof(int8_t) + m * sizeof(int32_t));
+    int8_t *pa_reorder = (int8_t *)params->conv_extra.kernel_tm->data;
+    int32_t *zp_corr = (int32_t *)(pa_reorder + m * k4);
+
+    for (int i = 0; i < m; i++) {
+        int32_t sum = 0;
+        for (int j = 0; j < k; j++) {
+            kernel_trans[i * k + j] = kernel_data[j * m + i];
+            sum += kernel_data[j * m + i];
+        }
+        zp_corr[i] = -input_zp * sum;
+    }
+    shl_rvv_reorder_kernel_n8_int8(kernel_trans, pa_reorder, m, k, k);
+    shl_mem_free(kernel_trans);
+}
+
+int shl_rvv_deconv2d_gemm_col2im_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                      struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                      struct csinn_conv2d_params *params)
+{
+    int8_t *input_data = (int8_t *)input->data;
+    int8_t *output_data = (int8_t *)output->data;
+    int8_t *kernel_data = (int8_t *)params->conv_extra.kernel_tm->data;
+    int32_t *bias_data = bias->dim_count != 0 ? (int32_t *)bias->data : NULL;
+
+    int32_t batch = input->dim[0];
+    int32_t in_c = input->dim[1];
+    int32_t in_h = input->dim[2];
+    int32_t in_w = input->dim[3];
+    int32_t out_c = output->dim[1];
+    int32_t out_h = output->dim[2];
+    int32_t out_w = output->dim[3];
+    int32_t kernel_h = kernel->dim[2];
+    int32_t kernel_w = kernel->dim[3];
+    int32_t out_hw = out_h * out_w;
+
+    const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
+    const int in_pack = in_c % packn == 0 ? packn : 1;
+    const int out_pack = out_c % packn == 0 ? packn : 1;
+
+    int32_t m = out_c * kernel_h * kernel_w;
+    int32_t k = in_c;
+    int32_t n = in_h * in_w;
+    int32_t k4 = (k % 4 != 0) ? ((k / 4 + 1) * 4) : k;
+    int32_t *zp_corr = (int32_t *)(kernel_data + m * k4);
+
+    int8_t *input_buf = in_pack == 1 ? NULL : (int8_t *)shl_mem_alloc(k * n * sizeof(int8_t));
+    int8_t *pb_reorder = (int8_t *)shl_mem_alloc(k4 * n * sizeof(int8_t));
+    int32_t *col_buf = (int32_t *)shl_mem_alloc(m * n * sizeof(int32_t));
+    int32_t *acc_buf = (int32_t *)shl_mem_alloc(out_c * out_hw * sizeof(int32_t));
+
+    for (int i = 0; i < batch; i++) {
+        int8_t *in_ptr = input_data;
+        if (in_pack != 1) {
+            deconv_unpack_int8(input_data, input_buf, in_c, n, in_pack);
+            in_ptr = input_buf;
+        }
+        shl_rvv_reorder_input_z8_int8(in_ptr, pb_reorder, k, n, n);
+        shl_rvv_gemm_8x8_int32(col_buf, kernel_data, pb_reorder, zp_corr, m, k4, n, n);
+
+        for (int c = 0; c < out_c; c++) {
+            int32_t b = bias_data ? bias_data[c] : 0;
+            for (int j = 0; j < out_hw; j++) {
+                acc_buf[c * out_hw + j] = b;
+            }
+        }
+        deconv_col2im_int32(col_buf, acc_buf, out_c, out_h, out_w, in_h, in_w, kernel_h,
+                            kernel_w, params);
+
+        for (int c = 0; c < out_c; c++) {
+            deconv_requantize_int8(acc_buf + c * out_hw,
+                                   output_data + (c / out_pack) * out_hw * out_pack + c % out_pack,
+                                   out_hw, out_pack, kernel->qinfo->multiplier,
+                                   kernel->qinfo->shift, output->qinfo->zero_point);
+        }
+
+        input_data += in_c * in_h * in_w;
+        output_data += out_c * out_hw;
+    }
+    shl_mem_free(input_buf);
+    shl_mem_free(pb_reorder);
+    shl_mem_free(col_buf);
+    shl_mem_free(acc_buf);
+    return CSINN_TRUE;
+}
+
+/*************************************************************
+ * the sub kernel of every phase of a stride 2 deconv, see shl_rvv_deconv2d_s2_fp32,
+ * [out_c, in_c * nty * ntx] per phase packed for gemm one after another in kernel_tm,
+ * followed by the int32 bias of the 4 phases with the input zero point fused:
+ * bias - input_zp * sum(sub kernel row)
+ *************************************************************/
+void shl_rvv_deconv2d_s2_reorder_kernel_int8(struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                             int32_t input_zp, struct csinn_conv2d_params *params)
+{
+    int8_t *kernel_data = (int8_t *)kernel->data;
+    int32_t *bias_data = bias->dim_count != 0 ? (int32_t *)bias->data : NULL;
+    int in_c = kernel->dim[0];
+    int out_c = kernel->dim[1];
+    int kernel_h = kernel->dim[2];
+    int kernel_w = kernel->dim[3];
+
+    int total = 0;
+    for (int ry = 0; ry < 2; ry++) {
+        for (int rx = 0; rx < 2; rx++) {
+            int k = in_c * ((kernel_h - ry + 1) / 2) * ((kernel_w - rx + 1) / 2);
+            total += out_c * ((k % 4 != 0) ? ((k / 4 + 1) * 4) : k);
+        }
+    }
+    params->conv_extra.kernel_tm->data =
+        (int8_t *)shl_mem_alloc(total * sizeof(int8_t) + 4 * out_c * sizeof(int32_t));
+    int8_t *pa = (int8_t *)params->conv_extra.kernel_tm->data;
+    int32_t *phase_bias = (int32_t *)(pa + total);
+
+    int8_t *sub_kernel =
+        (int8_t *)shl_mem_alloc(out_c * in_c * kernel_h * kernel_w * sizeof(int8_t));
+    for (int ry = 0; ry < 2; ry++) {
+        for (int rx = 0; rx < 2; rx++) {
+            int nty = (kernel_h - ry + 1) / 2;
+            int ntx = (kernel_w - rx + 1) / 2;
+            int k = in_c * nty * ntx;
+            int k4 = (k % 4 != 0) ? ((k / 4 + 1) * 4) : k;
+            for (int oc = 0; oc < out_c; oc++) {
+                int32_t sum = 0;
+                for (int ic = 0; ic < in_c; ic++) {
+                    for (int ty = 0; ty < nty; ty++) {
+                        for (int tx = 0; tx < ntx; tx++) {
+                            int8_t val =
+                                kernel_data[((ic * out_c + oc) * kernel_h + ry + 2 * ty) *
+                                                kernel_w +
+                                            rx + 2 * tx];
+                            sub_kernel[oc * k + (ic * nty + ty) * ntx + tx] = val;
+                            sum += val;
+                        }
+                    }
+                }
+                phase_bias[oc] = (bias_data ? bias_data[oc] : 0) - input_zp * sum;
+            }
+            shl_rvv_reorder_kernel_n8_int8(sub_kernel, pa, out_c, k, k);
+            pa += out_c * k4;
+            phase_bias += out_c;
+        }
+    }
+    shl_mem_free(sub_kernel);
+}
+
+int shl_rvv_deconv2d_s2_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                             struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                             struct csinn_conv2d_params *params)
+{
+    int8_t *input_data = (int8_t *)input->data;
+    int8_t *output_data = (int8_t *)output->data;
+    int8_t *kernel_data = (int8_t *)params->conv_extra.kernel_tm->data;
+
+    int32_t batch = input->dim[0];
+    int32_t in_c = input->dim[1];
+    int32_t in_h = input->dim[2];
+    int32_t in_w = input->dim[3];
+    int32_t out_c = output->dim[1];
+    int32_t out_h = output->dim[2];
+    int32_t out_w = output->dim[3];
+    int32_t kernel_h = kernel->dim[2];
+    int32_t kernel_w = kernel->dim[3];
+    int8_t input_zp = input->qinfo->zero_point;
+
+    const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
+    const int in_pack = in_c % packn == 0 ? packn : 1;
+    const int out_pack = out_c % packn == 0 ? packn : 1;
+
+    int total = 0;
+    for (int ry = 0; ry < 2; ry++) {
+        for (int rx = 0; rx < 2; rx++) {
+            int k = in_c * ((kernel_h - ry + 1) / 2) * ((kernel_w - rx + 1) / 2);
+            total += out_c * ((k % 4 != 0) ? ((k / 4 + 1) * 4) : k);
+        }
+    }
+    int32_t *phase_bias = (int32_t *)(kernel_data + total);
+
+    int32_t max_k = in_c * ((kernel_h + 1) / 2) * ((kernel_w + 1) / 2);
+    int32_t max_k4 = (max_k % 4 != 0) ? ((max_k / 4 + 1) * 4) : max_k;
+    int32_t max_n = ((out_h + 1) / 2) * ((out_w + 1) / 2);
+    int8_t *im2col_buf = (int8_t *)shl_mem_alloc(max_k * max_n * sizeof(int8_t));
+    int8_t *pb_reorder = (int8_t *)shl_mem_alloc(max_k4 * max_n * sizeof(int8_t));
+    int8_t *gemm_buf = (int8_t *)shl_mem_alloc(out_c * max_n * sizeof(int8_t));
+    int32_t *multiplier = (int32_t *)shl_mem_alloc(out_c * sizeof(int32_t));
+    int32_t *shift = (int32_t *)shl_mem_alloc(out_c * sizeof(int32_t));
+    for (int c = 0; c < out_c; c++) {
+        multiplier[c] = kernel->qinfo->multiplier;
+        shift[c] = kernel->qinfo->shift;
+    }
+
+    for (int b = 0; b < batch; b++) {
+        int8_t *pa = kernel_data;
+        int32_t *pbias = phase_bias;
+        for (int ry = 0; ry < 2; ry++) {
+            for (int rx = 0; rx < 2; rx++) {
+                int nty, qy0, nqy, ntx, qx0, nqx;
+                shl_rvv_deconv2d_s2_phase(ry, kernel_h, params->pad_top, out_h, &nty, &qy0, &nqy);
+                shl_rvv_deconv2d_s2_phase(rx, kernel_w, params->pad_left, out_w, &ntx, &qx0,
+                                          &nqx);
+                int k = in_c * nty * ntx;
+                int k4 = (k % 4 != 0) ? ((k / 4 + 1) * 4) : k;
+                int n = nqy * nqx;
+                if (n == 0) {
+                    pa += out_c * k4;
+                    pbias += out_c;
+                    continue;
+                }
+
+                // im2col of the phase, out of the input is the zero point
+                int8_t *col = im2col_buf;
+                for (int ic = 0; ic < in_c; ic++) {
+                    const int8_t *plane =
+                        input_data + (ic / in_pack) * in_h * in_w * in_pack + ic % in_pack;
+                    for (int ty = 0; ty < nty; ty++) {
+                        for (int tx = 0; tx < ntx; tx++) {
+                            int ix_base = qx0 - tx;
+                            int i0 = ix_base >= 0 ? 0 : -ix_base;
+                            i0 = i0 < nqx ? i0 : nqx;
+                            int i1 = in_w - ix_base < nqx ? in_w - ix_base : nqx;
+                            i1 = i1 > i0 ? i1 : i0;
+                            for (int j = 0; j < nqy; j++) {
+                                int iy = qy0 + j - ty;
+                                if (iy < 0 || iy >= in_h) {
+                                    memset(col, input_zp, nqx * sizeof(int8_t));
+                                    col += nqx;
+                                    continue;
+                                }
+                                const int8_t *src = plane + (iy * in_w + ix_base + i0) * in_pack;
+                                memset(col, input_zp, i0 * sizeof(int8_t));
+                                int i = i0;
+                                while (i < i1) {
+                                    int vl = vsetvl_e8m1(i1 - i);
+                                    vint8m1_t _in = vlse8_v_i8m1(src, in_pack * sizeof(int8_t), vl);
+                                    vse8_v_i8m1(col + i, _in, vl);
+                                    src += vl * in_pack;
+                                    i += vl;
+                                }
+                                memset(col + i1, input_zp, (nqx - i1) * sizeof(int8_t));
+                                col += nqx;
+                            }
+                        }
+                    }
+                }
+
+                shl_rvv_reorder_input_z8_int8(im2col_buf, pb_reorder, k, n, n);
+                shl_rvv_gemm_8x8_int8(gemm_buf, pa, pb_reorder, pbias, out_c, k4, n, n,
+                                      output->qinfo->zero_point, multiplier, shift);
+
+                // scatter the phase into the output
+                for (int oc = 0; oc < out_c; oc++) {
+                    int8_t *plane = output_data + (oc / out_pack) * out_h * out_w * out_pack +
+                                    oc % out_pack;
+                    const int8_t *src = gemm_buf + oc * n;
+                    for (int j = 0; j < nqy; j++) {
+                        int oy = 2 * (qy0 + j) + ry - params->pad_top;
+                        int ox = 2 * qx0 + rx - params->pad_left;
+                        int8_t *dst = plane + (oy * out_w + ox) * out_pack;
+                        int i = 0;
+                        while (i < nqx) {
+                            int vl = vsetvl_e8m1(nqx - i);
+                            vint8m1_t _out = vle8_v_i8m1(src, vl);
+                            vsse8_v_i8m1(dst, 2 * out_pack * sizeof(int8_t), _out, vl);
+                            dst += vl * 2 * out_pack;
+                            src += vl;
+                            i += vl;
+                        }
+                    }
+                }
+                pa += out_c * k4;
+                pbias += out_c;
+            }
+        }
+        input_data += in_c * in_h * in_w;
+        output_data += out_c * out_h * out_w;
+    }
+    shl_mem_free(im2col_buf);
+    shl_mem_free(pb_reorder);
+    shl_mem_free(gemm_buf);
+    shl_mem_free(multiplier);
+    shl_mem_free(shift);
+    return CSINN_TRUE;
+}
+
+/*************************************************************
+ * depthwise deconv, packn channels, see shl_rvv_depthwise_deconv2d_packn_fp32,
+ * the input zero point is removed before the widening multiply
+ *************************************************************/
+int shl_rvv_depthwise_deconv2d_packn_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                          struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                                          struct csinn_conv2d_params *params)
+{
+    int8_t *input_data = (int8_t *)input->data;
+    int8_t *output_data = (int8_t *)output->data;
+    int8_t *kernel_data = (int8_t *)kernel->data;
+    int32_t *bias_data = bias->dim_count != 0 ? (int32_t *)bias->data : NULL;
+
+    int32_t batch = input->dim[0];
+    int32_t in_c = input->dim[1];
+    int32_t in_h = input->dim[2];
+    int32_t in_w = input->dim[3];
+    int32_t out_h = output->dim[2];
+    int32_t out_w = output->dim[3];
+    int32_t kernel_h = kernel->dim[2];
+    int32_t kernel_w = kernel->dim[3];
+    int32_t stride_h = params->stride_height;
+    int32_t stride_w = params->stride_width;
+    int32_t dilation_h = params->dilation_height;
+    int32_t dilation_w = params->dilation_width;
+    int8_t input_zp = input->qinfo->zero_point;
+    int32_t out_zp = output->qinfo->zero_point;
+
+    int32_t *multiplier = (int32_t *)shl_mem_alloc(in_c * sizeof(int32_t));
+    int32_t *shift = (int32_t *)shl_mem_alloc(in_c * sizeof(int32_t));
+    for (int c = 0; c < in_c; c++) {
+        int q = kernel->quant_channel > 1 ? c : 0;
+        multiplier[c] = kernel->qinfo[q].multiplier;
+        shift[c] = kernel->qinfo[q].shift;
+    }
+
+    const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
+    const int vl = vsetvl_e8mf2(packn);
+
+    for (int b = 0; b < batch; b++) {
+#pragma omp parallel for num_threads(1)
+        for (int c = 0; c + packn - 1 < in_c; c += packn) {
+            const int8_t *img0 = input_data + c * in_h * in_w;
+            const int8_t *kernel0 = kernel_data + c * kernel_h * kernel_w;
+            int8_t *out0 = output_data + c * out_h * out_w;
+            vint32m2_t _bias0 =
+                bias_data ? vle32_v_i32m2(bias_data + c, vl) : vmv_v_x_i32m2(0, vl);
+            vint32m2_t _mult = vle32_v_i32m2(multiplier + c, vl);
+            vint32m2_t _shift = vle32_v_i32m2(shift + c, vl);
+            _shift = vrsub_vx_i32m2(_shift, -1, vl);
+
+            for (int oy = 0; oy < out_h; oy++) {
+                for (int ox = 0; ox < out_w; ox++) {
+                    vint32m2_t _acc = _bias0;
+                    for (int ky = 0; ky < kernel_h; ky++) {
+                        int ty = oy + params->pad_top - ky * dilation_h;
+                        if (ty < 0 || ty % stride_h != 0 || ty / stride_h >= in_h) {
+                            continue;
+                        }
+                        const int8_t *row = img0 + (ty / stride_h) * in_w * packn;
+                        for (int kx = 0; kx < kernel_w; kx++) {
+                            int tx = ox + params->pad_left - kx * dilation_w;
+                            if (tx < 0 || tx % stride_w != 0 || tx / stride_w >= in_w) {
+                                continue;
+                            }
+                            vint16m1_t _k = vwadd_vx_i16m1(
+                                vle8_v_i8mf2(kernel0 + (ky * kernel_w + kx) * packn, vl), 0, vl);
+                            vint16m1_t _in = vwsub_vx_i16m1(
+                                vle8_v_i8mf2(row + (tx / stride_w) * packn, vl), input_zp, vl);
+                            _acc = vwmacc_vv_i32m2(_acc, _k, _in, vl);
+                        }
+                    }
+                    vse8_v_i8mf2(out0, requantize_m2_s(_acc, _mult, _shift, out_zp, vl), vl);
+                    out0 += packn;
+                }
+            }
+        }
+        input_data += in_c * in_h * in_w;
+        output_data += in_c * out_h * out_w;
+    }
+    shl_mem_free(multiplier);
+    shl_mem_free(shift);
+    return CSINN_TRUE;
+}
+#endif
@@ -31,27 +31,40 @@ int shl_rvv_depthwise_conv2d_init_fp32(struct csinn_tensor *input, struct csinn_
     int32_t kernel_w = kernel->dim[3];
     int32_t stride_h = params->stride_height;
     int32_t stride_w = params->stride_width;
+    int32_t dilation_h = params->dilation_height;
+    int32_t dilation_w = params->dilation_width;
     struct csinn_callback *cb = params->base.cb;
 
     const int packn = csrr_vlenb() / sizeof(float);
 
+    if (shl_sparse_keep(kernel->mtype)) {
+        // no fp32 sparse kernel, the reference runs over the kept weights
+        cb->exec = shl_ref_depthwise_conv2d_f32;
+        return CSINN_TRUE;
+    }
+
     if (in_c % packn == 0 && out_c % packn == 0) {
-        if (kernel_h == 3 && kernel_w == 3 && stride_h == 1 && stride_w == 1) {
+        if (kernel_h == 3 && kernel_w == 3 && stride_h == 1 && stride_w == 1 && dilation_h == 1 &&
+            dilation_w == 1) {
             shl_rvv_dwconv_reorder_kernel_packn_fp32(kernel, params);
             cb->exec = shl_rvv_dwconv3x3s1_packn_fp32;
 
-        } else if (kernel_h == 3 && kernel_w == 3 && stride_h == 2 && stride_w == 2) {
+        } else if (kernel_h == 3 && kernel_w == 3 && stride_h == 2 && stride_w == 2 &&
+                   dilation_h == 1 && dilation_w == 1) {
             shl_rvv_dwconv_reorder_kernel_packn_fp32(kernel, params);
             cb->exec = shl_rvv_dwconv3x3s2_packn_fp32;
         } else {
-            cb->exec = shl_ref_depthwise_conv2d_f32;
+            shl_rvv_dwconv_reorder_kernel_packn_fp32(kernel, params);
+            cb->exec = shl_rvv_dwconv_packn_fp32;
         }
     }
 
     if (in_c % packn != 0 && out_c % packn != 0) {
-        if (kernel_h == 3 && kernel_w == 3 && stride_h == 1 && stride_w == 1) {
+        if (kernel_h == 3 && kernel_w == 3 && stride_h == 1 && stride_w == 1 && dilation_h == 1 &&
+            dilation_w == 1) {
             cb->exec = shl_rvv_dwconv3x3s1_fp32;
-        } else if (kernel_h == 3 && kernel_w == 3 && stride_h == 2 && stride_w == 2) {
+        } else if (kernel_h == 3 && kernel_w == 3 && stride_h == 2 && stride_w == 2 &&
+                   dilation_h == 1 && dilation_w == 1) {
             cb->exec = shl_rvv_dwconv3x3s2_fp32;
         } else {
             cb->exec = shl_ref_depthwise_conv2d_f32;
@@ -71,27 +84,40 @@ int shl_rvv_depthwise_conv2d_init_fp16(struct csinn_tensor *input, struct csinn_
     int32_t kernel_w = kernel->dim[3];
     int32_t stride_h = params->stride_height;
     int32_t stride_w = params->stride_width;
+    int32_t dilation_h = params->dilation_height;
+    int32_t dilation_w = params->dilation_width;
     struct csinn_callback *cb = params->base.cb;
 
     const int packn = csrr_vlenb() / sizeof(__fp16);
 
+    if (shl_sparse_keep(kernel->mtype)) {
+        params->conv_extra.conv_mode = CSINN_GEMM;
+        cb->exec = shl_rvv_conv2d_sparse_fp16;
+        return CSINN_TRUE;
+    }
+
     if (in_c % packn == 0 && out_c % packn == 0) {
-        if (kernel_h == 3 && kernel_w == 3 && stride_h == 1 && stride_w == 1) {
+        if (kernel_h == 3 && kernel_w == 3 && stride_h == 1 && stride_w == 1 && dilation_h == 1 &&
+            dilation_w == 1) {
             shl_rvv_dwconv_reorder_kernel_packn_fp16(kernel, params);
             cb->exec = shl_rvv_dwconv3x3s1_packn_fp16;
 
-        } else if (kernel_h == 3 && kernel_w == 3 && stride_h == 2 && stride_w == 2) {
+        } else if (kernel_h == 3 && kernel_w == 3 && stride_h == 2 && stride_w == 2 &&
+                   dilation_h == 1 && dilation_w == 1) {
             shl_rvv_dwconv_reorder_kernel_packn_fp16(kernel, params);
             cb->exec = shl_rvv_dwconv3x3s2_packn_fp16;
         } else {
-            cb->exec = shl_ref_depthwise_conv2d_quant;
+            shl_rvv_dwconv_reorder_kernel_packn_fp16(kernel, params);
+            cb->exec = shl_rvv_dwconv_packn_fp16;
         }
     }
 
     if (in_c % packn != 0 && out_c % packn != 0) {
-        if (kernel_h == 3 && kernel_w == 3 && stride_h == 1 && stride_w == 1) {
+        if (kernel_h == 3 && kernel_w == 3 && stride_h == 1 && stride_w == 1 && dilation_h == 1 &&
+            dilation_w == 1) {
             cb->exec = shl_rvv_dwconv3x3s1_fp16;
-        } else if (kernel_h == 3 && kernel_w == 3 && stride_h == 2 && stride_w == 2) {
+        } else if (kernel_h == 3 && kernel_w == 3 && stride_h == 2 && stride_w == 2 &&
+                   dilation_h == 1 && dilation_w == 1) {
             cb->exec = shl_rvv_dwconv3x3s2_fp16;
         } else {
             cb->exec = shl_ref_depthwise_conv2d_quant;
@@ -111,10 +137,16 @@ int shl_rvv_depthwise_conv2d_init_int8(struct csinn_tensor *input, struct csinn_
     int32_t kernel_w = kernel->dim[3];
     int32_t stride_h = params->stride_height;
     int32_t stride_w = params->stride_width;
+    int32_t dilation_h = params->dilation_height;
+    int32_t dilation_w = params->dilation_width;
     struct csinn_callback *cb = params->base.cb;
 
     const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
 
+    if (shl_sparse_keep(kernel->mtype)) {
+        return shl_rvv_conv2d_sparse_init_int8(input, output, kernel, bias, params);
+    }
+
     // enable fuse zeropoint to bias
     if (!params->conv_extra.fuse_zp2bias) {
         int32_t *bias_data = (int32_t *)bias->data;
@@ -137,21 +169,26 @@ int shl_rvv_depthwise_conv2d_init_int8(struct csinn_tensor *input, struct csinn_
     }
 
     if (in_c % packn == 0 && out_c % packn == 0) {
-        if (kernel_h == 3 && kernel_w == 3 && stride_h == 1 && stride_w == 1) {
+        if (kernel_h == 3 && kernel_w == 3 && stride_h == 1 && stride_w == 1 && dilation_h == 1 &&
+            dilation_w == 1) {
             shl_rvv_dwconv_reorder_kernel_packn_int8(kernel, params);
             cb->exec = shl_rvv_dwconv3x3s1_packn_int8;
-        } else if (kernel_h == 3 && kernel_w == 3 && stride_h == 2 && stride_w == 2) {
+        } else if (kernel_h == 3 && kernel_w == 3 && stride_h == 2 && stride_w == 2 &&
+                   dilation_h == 1 && dilation_w == 1) {
             shl_rvv_dwconv_reorder_kernel_packn_int8(kernel, params);
             cb->exec = shl_rvv_dwconv3x3s2_packn_int8;
         } else {
-            cb->exec = shl_ref_depthwise_conv2d_quant;
+            shl_rvv_dwconv_reorder_kernel_packn_int8(kernel, params);
+            cb->exec = shl_rvv_dwconv_packn_int8;
         }
     }
 
     if (in_c % packn != 0 && out_c % packn != 0) {
-        if (kernel_h == 3 && kernel_w == 3 && stride_h == 1 && stride_w == 1) {
+        if (kernel_h == 3 && kernel_w == 3 && stride_h == 1 && stride_w == 1 && dilation_h == 1 &&
+            dilation_w == 1) {
             cb->exec = shl_rvv_dwconv3x3s1_int8;
-        } else if (kernel_h == 3 && kernel_w == 3 && stride_h == 2 && stride_w == 2) {
+        } else if (kernel_h == 3 && kernel_w == 3 && stride_h == 2 && stride_w == 2 &&
+                   dilation_h == 1 && dilation_w == 1) {
             cb->exec = shl_rvv_dwconv3x3s2_int8;
         } else {
             cb->exec = shl_ref_depthwise_conv2d_quant;
@@ -181,6 +218,8 @@ int shl_rvv_depthwise_conv2d_init_int4(struct csinn_tensor *input, struct csinn_
     int32_t kernel_w = kernel->dim[3];
     int32_t stride_h = params->stride_height;
     int32_t stride_w = params->stride_width;
+    int32_t dilation_h = params->dilation_height;
+    int32_t dilation_w = params->dilation_width;
     struct csinn_callback *cb = params->base.cb;
 
     // xxx: only int4 support nhwc layout now
@@ -191,9 +230,11 @@ int shl_rvv_depthwise_conv2d_init_int4(struct csinn_tensor *input, struct csinn_
         in_w = input->dim[2];
         kernel_h = kernel->dim[1];
         kernel_w = kernel->dim[2];
-        if (kernel_h == 3 && kernel_w == 3 && stride_h == 1 && stride_w == 1) {
+        if (kernel_h == 3 && kernel_w == 3 && stride_h == 1 && stride_w == 1 && dilation_h == 1 &&
+            dilation_w == 1) {
             cb->exec = shl_rvv_dwconv3x3s1_int4;
-        } else if (kernel_h == 3 && kernel_w == 3 && stride_h == 2 && stride_w == 2) {
+        } else if (kernel_h == 3 && kernel_w == 3 && stride_h == 2 && stride_w == 2 &&
+                   dilation_h == 1 && dilation_w == 1) {
             cb->exec = shl_rvv_dwconv3x3s2_int4;
         }
         // support channel quantization
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_thead_rvv.h"
+
+/*************************************************************
+ * one output row of a KxK depthwise conv, packn channels
+ * r0: padded input row of the first kernel row, kernel0: [kernel_h * kernel_w, packn]
+ * called with a constant kernel_w for the common sizes so the tap loop unrolls
+ *************************************************************/
+static inline void dwconv_row_packn_fp32(float *out0, const float *r0, const float *kernel0,
+                                         vfloat32m1_t _bias0, int out_w, int in_w, int kernel_h,
+                                         const int kernel_w, int stride_w, int dilation_h,
+                                         int dilation_w)
+{
+    const int packn = csrr_vlenb() / sizeof(float);
+    const int vl = vsetvl_e32m1(packn);
+    const int step = stride_w * packn;
+
+    int w = 0;
+    for (; w + 3 < out_w; w += 4) {
+        vfloat32m1_t _acc00 = _bias0;
+        vfloat32m1_t _acc01 = _bias0;
+        vfloat32m1_t _acc02 = _bias0;
+        vfloat32m1_t _acc03 = _bias0;
+        for (int kh = 0; kh < kernel_h; kh++) {
+            const float *rk = r0 + (kh * dilation_h * in_w + w * stride_w) * packn;
+            const float *k0 = kernel0 + kh * kernel_w * packn;
+            for (int kw = 0; kw < kernel_w; kw++) {
+                vfloat32m1_t _k = vle32_v_f32m1(k0 + kw * packn, vl);
+                const float *ptr = rk + kw * dilation_w * packn;
+                _acc00 = vfmacc_vv_f32m1(_acc00, _k, vle32_v_f32m1(ptr, vl), vl);
+                _acc01 = vfmacc_vv_f32m1(_acc01, _k, vle32_v_f32m1(ptr + step, vl), vl);
+                _acc02 = vfmacc_vv_f32m1(_acc02, _k, vle32_v_f32m1(ptr + step * 2, vl), vl);
+                _acc03 = vfmacc_vv_f32m1(_acc03, _k, vle32_v_f32m1(ptr + step * 3, vl), vl);
+            }
+        }
+        vse32_v_f32m1(out0, _acc00, vl);
+        vse32_v_f32m1(out0 + packn * 1, _acc01, vl);
+        vse32_v_f32m1(out0 + packn * 2, _acc02, vl);
+        vse32_v_f32m1(out0 + packn * 3, _acc03, vl);
+        out0 += packn * 4;
+    }
+    for (; w < out_w; w++) {
+        vfloat32m1_t _acc00 = _bias0;
+        for (int kh = 0; kh < kernel_h; kh++) {
+            const float *rk = r0 + (kh * dilation_h * in_w + w * stride_w) * packn;
+            const float *k0 = kernel0 + kh * kernel_w * packn;
+            for (int kw = 0; kw < kernel_w; kw++) {
+                vfloat32m1_t _k = vle32_v_f32m1(k0 + kw * packn, vl);
+                vfloat32m1_t _r = vle32_v_f32m1(rk + kw * dilation_w * packn, vl);
+                _acc00 = vfmacc_vv_f32m1(_acc00, _k, _r, vl);
+            }
+        }
+        vse32_v_f32m1(out0, _acc00, vl);
+        out0 += packn;
+    }
+}
+
+/*************************************************************
+ * depthwise conv of any kernel size, stride and dilation
+ * constrain: in_c % packn = 0, kernel reordered by shl_rvv_dwconv_reorder_kernel_packn_fp32
+ *************************************************************/
+int shl_rvv_dwconv_packn_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                              struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                              struct csinn_conv2d_params *params)
+{
+    float *input_data = (float *)input->data;
+    float *output_data = (float *)output->data;
+    float *kernel_data = (float *)kernel->data;
+    float *bias_data = (float *)bias->data;
+
+    int32_t batch = input->dim[0];
+    int32_t in_c = input->dim[1];  // group = in_channel
+    int32_t in_h = input->dim[2];
+    int32_t in_w = input->dim[3];
+
+    int32_t out_c = output->dim[1];
+    int32_t out_h = output->dim[2];
+    int32_t out_w = output->dim[3];
+
+    int32_t kernel_h = kernel->dim[2];
+    int32_t kernel_w = kernel->dim[3];
+    int32_t stride_h = params->stride_height;
+    int32_t stride_w = params->stride_width;
+    int32_t dilation_h = params->dilation_height;
+    int32_t dilation_w = params->dilation_width;
+
+    const int packn = csrr_vlenb() / sizeof(float);
+    const int vl = vsetvl_e32m1(packn);
+
+    int32_t padded_h = in_h + params->pad_top + params->pad_down;
+    int32_t padded_w = in_w + params->pad_left + params->pad_right;
+    float *input_padd_buf = (float *)shl_mem_alloc(in_c * padded_h * padded_w * sizeof(float));
+
+    for (int b = 0; b < batch; b++) {
+        shl_rvv_pad_input_packn_fp32(input_data, input_padd_buf, in_c, in_h, in_w, padded_h,
+                                     padded_w, params->pad_top, params->pad_left);
+
+#pragma omp parallel for num_threads(1)
+        for (int c = 0; c + packn - 1 < in_c; c += packn) {
+            const float *img0 = input_padd_buf + c * padded_h * padded_w;
+            const float *kernel0 = kernel_data + c * kernel_h * kernel_w;
+            vfloat32m1_t _bias0 =
+                bias_data ? vle32_v_f32m1(bias_data + c, vl) : vfmv_v_f_f32m1(0.0f, vl);
+
+            for (int h = 0; h < out_h; h++) {
+                float *out0 = output_data + (c * out_h + h * packn) * out_w;
+                const float *r0 = img0 + h * stride_h * padded_w * packn;
+                if (kernel_w == 3) {
+                    dwconv_row_packn_fp32(out0, r0, kernel0, _bias0, out_w, padded_w, kernel_h, 3,
+                                          stride_w, dilation_h, dilation_w);
+                } else if (kernel_w == 5) {
+                    dwconv_row_packn_fp32(out0, r0, kernel0, _bias0, out_w, padded_w, kernel_h, 5,
+                                          stride_w, dilation_h, dilation_w);
+                } else if (kernel_w == 7) {
+                    dwconv_row_packn_fp32(out0, r0, kernel0, _bias0, out_w, padded_w, kernel_h, 7,
+                                          stride_w, dilation_h, dilation_w);
+                } else {
+                    dwconv_row_packn_fp32(out0, r0, kernel0, _bias0, out_w, padded_w, kernel_h,
+                                          kernel_w, stride_w, dilation_h, dilation_w);
+                }
+            }
+        }
+        input_data += in_c * in_h * in_w;
+        output_data += out_c * out_h * out_w;
+    }
+    shl_mem_free(input_padd_buf);
+    return CSINN_TRUE;
+}
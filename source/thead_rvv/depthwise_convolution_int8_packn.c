@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_thead_rvv.h"
+
+static vint8mf2_t requantize_m2_s(vint32m2_t _src, vint32m2_t _multiplier, vint32m2_t _shift,
+                                  int32_t out_zp, int vl)
+{
+#ifdef RVV_1_0_0
+    vint32m2_t _mulh = vmulh_vv_i32m2(_src, _multiplier, vl);
+    _mulh = vssra_vv_i32m2(_mulh, vreinterpret_v_i32m2_u32m2(_shift), vl);
+    _mulh = vadd_vx_i32m2(_mulh, out_zp, vl);
+    vint16m1_t _tmp1 = vnclip_wx_i16m1(_mulh, 0, vl);
+    vint8mf2_t _tmp2 = vnclip_wx_i8mf2(_tmp1, 0, vl);
+    return _tmp2;
+#endif
+}
+
+/*************************************************************
+ * one output row of a KxK depthwise conv, packn channels
+ * r0: padded input row of the first kernel row, kernel0: [kernel_h * kernel_w, packn]
+ * called with a constant kernel_w for the common sizes so the tap loop unrolls
+ *************************************************************/
+static inline void dwconv_row_packn_int8(int8_t *out0, const int8_t *r0, const int8_t *kernel0,
+                                         vint32m2_t _bias0, vint32m2_t _mult, vint32m2_t _shift,
+                                         int32_t out_zp, int out_w, int in_w, int kernel_h,
+                                         const int kernel_w, int stride_w, int dilation_h,
+                                         int dilation_w)
+{
+#ifdef RVV_1_0_0
+    const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
+    const int vl = vsetvl_e8mf2(packn);
+    const int step = stride_w * packn;
+
+    int w = 0;
+    for (; w + 3 < out_w; w += 4) {
+        vint32m2_t _acc00 = _bias0;
+        vint32m2_t _acc01 = _bias0;
+        vint32m2_t _acc02 = _bias0;
+        vint32m2_t _acc03 = _bias0;
+        for (int kh = 0; kh < kernel_h; kh++) {
+            const int8_t *rk = r0 + (kh * dilation_h * in_w + w * stride_w) * packn;
+            const int8_t *k0 = kernel0 + kh * kernel_w * packn;
+            for (int kw = 0; kw < kernel_w; kw++) {
+                vint16m1_t _k = vwadd_vx_i16m1(vle8_v_i8mf2(k0 + kw * packn, vl), 0, vl);
+                const int8_t *ptr = rk + kw * dilation_w * packn;
+                vint16m1_t _r0 = vwadd_vx_i16m1(vle8_v_i8mf2(ptr, vl), 0, vl);
+                vint16m1_t _r1 = vwadd_vx_i16m1(vle8_v_i8mf2(ptr + step, vl), 0, vl);
+                vint16m1_t _r2 = vwadd_vx_i16m1(vle8_v_i8mf2(ptr + step * 2, vl), 0, vl);
+                vint16m1_t _r3 = vwadd_vx_i16m1(vle8_v_i8mf2(ptr + step * 3, vl), 0, vl);
+                _acc00 = vwmacc_vv_i32m2(_acc00, _k, _r0, vl);
+                _acc01 = vwmacc_vv_i32m2(_acc01, _k, _r1, vl);
+                _acc02 = vwmacc_vv_i32m2(_acc02, _k, _r2, vl);
+                _acc03 = vwmacc_vv_i32m2(_acc03, _k, _r3, vl);
+            }
+        }
+        vse8_v_i8mf2(out0, requantize_m2_s(_acc00, _mult, _shift, out_zp, vl), vl);
+        vse8_v_i8mf2(out0 + packn * 1, requantize_m2_s(_acc01, _mult, _shift, out_zp, vl), vl);
+        vse8_v_i8mf2(out0 + packn * 2, requantize_m2_s(_acc02, _mult, _shift, out_zp, vl), vl);
+        vse8_v_i8mf2(out0 + packn * 3, requantize_m2_s(_acc03, _mult, _shift, out_zp, vl), vl);
+        out0 += packn * 4;
+    }
+    for (; w < out_w; w++) {
+        vint32m2_t _acc00 = _bias0;
+        for (int kh = 0; kh < kernel_h; kh++) {
+            const int8_t *rk = r0 + (kh * dilation_h * in_w + w * stride_w) * packn;
+            const int8_t *k0 = kernel0 + kh * kernel_w * packn;
+            for (int kw = 0; kw < kernel_w; kw++) {
+                vint16m1_t _k = vwadd_vx_i16m1(vle8_v_i8mf2(k0 + kw * packn, vl), 0, vl);
+                vint16m1_t _r =
+                    vwadd_vx_i16m1(vle8_v_i8mf2(rk + kw * dilation_w * packn, vl), 0, vl);
+                _acc00 = vwmacc_vv_i32m2(_acc00, _k, _r, vl);
+            }
+        }
+        vse8_v_i8mf2(out0, requantize_m2_s(_acc00, _mult, _shift, out_zp, vl), vl);
+        out0 += packn;
+    }
+#endif
+}
+
+/*************************************************************
+ * depthwise conv of any kernel size, stride and dilation
+ * constrain: in_c % packn = 0, kernel reordered by shl_rvv_dwconv_reorder_kernel_packn_int8
+ *************************************************************/
+int shl_rvv_dwconv_packn_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                              struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                              struct csinn_conv2d_params *params)
+{
+#ifdef RVV_1_0_0
+    int8_t *input_data = (int8_t *)input->data;
+    int8_t *output_data = (int8_t *)output->data;
+    int8_t *kernel_data = (int8_t *)kernel->data;
+    int32_t *bias_data = (int32_t *)bias->data;
+
+    int32_t batch = input->dim[0];
+    int32_t in_c = input->dim[1];  // group = in_channel
+    int32_t in_h = input->dim[2];
+    int32_t in_w = input->dim[3];
+
+    int32_t out_c = output->dim[1];
+    int32_t out_h = output->dim[2];
+    int32_t out_w = output->dim[3];
+
+    int32_t kernel_h = kernel->dim[2];
+    int32_t kernel_w = kernel->dim[3];
+    int32_t stride_h = params->stride_height;
+    int32_t stride_w = params->stride_width;
+    int32_t dilation_h = params->dilation_height;
+    int32_t dilation_w = params->dilation_width;
+
+    int32_t *multiplier = (int32_t *)shl_mem_alloc(out_c * sizeof(int32_t));
+    int32_t *shift = (int32_t *)shl_mem_alloc(out_c * sizeof(int32_t));
+    if (kernel->quant_channel > 1) {
+        for (int c = 0; c < out_c; c++) {
+            multiplier[c] = kernel->qinfo[c].multiplier;
+            shift[c] = kernel->qinfo[c].shift;
+        }
+    } else if (kernel->quant_channel == 1) {
+        for (int c = 0; c < out_c; c++) {
+            multiplier[c] = kernel->qinfo[0].multiplier;
+            shift[c] = kernel->qinfo[0].shift;
+        }
+    }
+    int32_t out_zp = output->qinfo->zero_point;
+
+    const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
+    const int vl = vsetvl_e8mf2(packn);
+
+    int32_t padded_h = in_h + params->pad_top + params->pad_down;
+    int32_t padded_w = in_w + params->pad_left + params->pad_right;
+    int8_t *input_padd_buf = (int8_t *)shl_mem_alloc(in_c * padded_h * padded_w * sizeof(int8_t));
+
+    for (int b = 0; b < batch; b++) {
+        shl_rvv_pad_input_packn_int8(input_data, input_padd_buf, in_c, in_h, in_w, padded_h,
+                                     padded_w, params->pad_top, params->pad_left,
+                                     input->qinfo->zero_point);
+
+#pragma omp parallel for num_threads(1)
+        for (int c = 0; c + packn - 1 < in_c; c += packn) {
+            const int8_t *img0 = input_padd_buf + c * padded_h * padded_w;
+            const int8_t *kernel0 = kernel_data + c * kernel_h * kernel_w;
+            // please use fuse_zp2bias option in hhb, thus bias_data wont be NULL
+            vint32m2_t _bias0 = vle32_v_i32m2(bias_data + c, vl);
+            vint32m2_t _mult = vle32_v_i32m2(multiplier + c, vl);
+            vint32m2_t _shift = vle32_v_i32m2(shift + c, vl);
+            _shift = vrsub_vx_i32m2(_shift, -1, vl);
+
+            for (int h = 0; h < out_h; h++) {
+                int8_t *out0 = output_data + (c * out_h + h * packn) * out_w;
+                const int8_t *r0 = img0 + h * stride_h * padded_w * packn;
+                if (kernel_w == 3) {
+                    dwconv_row_packn_int8(out0, r0, kernel0, _bias0, _mult, _shift, out_zp, out_w,
+                                          padded_w, kernel_h, 3, stride_w, dilation_h, dilation_w);
+                } else if (kernel_w == 5) {
+                    dwconv_row_packn_int8(out0, r0, kernel0, _bias0, _mult, _shift, out_zp, out_w,
+                                          padded_w, kernel_h, 5, stride_w, dilation_h, dilation_w);
+                } else if (kernel_w == 7) {
+                    dwconv_row_packn_int8(out0, r0, kernel0, _bias0, _mult, _shift, out_zp, out_w,
+                                          padded_w, kernel_h, 7, stride_w, dilation_h, dilation_w);
+                } else {
+                    dwconv_row_packn_int8(out0, r0, kernel0, _bias0, _mult, _shift, out_zp, out_w,
+                                          padded_w, kernel_h, kernel_w, stride_w, dilation_h,
+                                          dilation_w);
+                }
+            }
+        }
+        input_data += in_c * in_h * in_w;
+        output_data += out_c * out_h * out_w;
+    }
+    shl_mem_free(input_padd_buf);
+    shl_mem_free(multiplier);
+    shl_mem_free(shift);
+    return CSINN_TRUE;
+#endif
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "rvv_mathfun.h"
+#include "shl_thead_rvv.h"
+
+static inline vfloat32m4_t erf_ps(vfloat32m4_t _x, int vl)
+{
+    return erf_ps_vfloat32m4(_x, vl);
+}
+
+static float erf_f32(float x) { return erff(x); }
+
+int shl_rvv_erf_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_siso_params *params)
+{
+    float *input_data = (float *)input->data;
+    float *output_data = (float *)output->data;
+
+    int size = csinn_tensor_size(input);
+    while (size > 0) {
+        int vl = vsetvl_e32m4(size);
+        vfloat32m4_t _x = vle32_v_f32m4(input_data, vl);
+        vse32_v_f32m4(output_data, erf_ps(_x, vl), vl);
+        input_data += vl;
+        output_data += vl;
+        size -= vl;
+    }
+    return CSINN_TRUE;
+}
+
+int shl_rvv_erf_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                     struct csinn_siso_params *params)
+{
+    __fp16 *input_data = (__fp16 *)input->data;
+    __fp16 *output_data = (__fp16 *)output->data;
+
+    // computed in fp32, the fp16 exp range is too narrow
+    int size = csinn_tensor_size(input);
+    while (size > 0) {
+        int vl = vsetvl_e16m2(size);
+        vfloat32m4_t _x = vfwcvt_f_f_v_f32m4(vle16_v_f16m2(input_data, vl), vl);
+        vse16_v_f16m2(output_data, vfncvt_f_f_w_f16m2(erf_ps(_x, vl), vl), vl);
+        input_data += vl;
+        output_data += vl;
+        size -= vl;
+    }
+    return CSINN_TRUE;
+}
+
+int shl_rvv_erf_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                          struct csinn_siso_params *params)
+{
+    if (shl_rvv_siso_lut_init_int8(input, output, &params->base, erf_f32) != CSINN_TRUE) {
+        params->base.cb->exec = shl_ref_erf_quant;
+    }
+    return CSINN_TRUE;
+}
@@ -28,6 +28,22 @@ int shl_rvv_fullyconnected_init(struct csinn_tensor *input, struct csinn_tensor
     const int out_nodes = weights->dim[weights_dims_count - 2];
     const int in_nodes = weights->dim[weights_dims_count - 1];
     struct csinn_callback *cb = params->base.cb;
+    if (shl_sparse_keep(weights->mtype)) {
+        int batches = 1;
+        for (int i = 0; i < output->dim_count - 1; i++) {
+            batches *= output->dim[i];
+        }
+        // the sparse gemm kernels vectorize along batch
+        if (input->dtype == CSINN_DTYPE_FLOAT16 && batches >= csrr_vlenb() / sizeof(__fp16)) {
+            cb->exec = shl_rvv_fullyconnected_sparse_fp16;
+            return CSINN_TRUE;
+        } else if (input->dtype == CSINN_DTYPE_INT8 &&
+                   batches >= csrr_vlenb() / sizeof(int8_t) / 2) {
+            return shl_rvv_fullyconnected_sparse_init_int8(input, output, weights, bias, params);
+        }
+        // small batch: gemv over the kept weights along the output nodes
+        return shl_rvv_fullyconnected_sparse_gemv_init(input, output, weights, bias, params);
+    }
     if (input->dtype == CSINN_DTYPE_FLOAT32) {
         shl_rvv_fc_gemv_transform_weight_fp32(weights);
         cb->exec = shl_rvv_fullyconnected_packn_fp32;
@@ -23,6 +23,36 @@
 /*************************************************************
     note: VLEN = 128/256
 *************************************************************/
+/*************************************************************
+ * requantize vl output channels in registers and narrow to int8, the gemv
+ * kernels store int8 directly instead of an int32 temp buffer that was
+ * requantized and saturated in two more passes, the widening product is
+ * rounded once by vnclip with 31 - shift
+ *************************************************************/
+static vint8m1_t requantize_m4_s(vint32m4_t _src, const int32_t *multiplier, const int32_t *shift,
+                                 int32_t out_zp, int vl)
+{
+    vint32m4_t _mult = vle32_v_i32m4(multiplier, vl);
+    vint32m4_t _shift = vle32_v_i32m4(shift, vl);
+    vint64m8_t _mulw = vwmul_vv_i64m8(_src, _mult, vl);
+    _shift = vrsub_vx_i32m4(_shift, 31, vl);
+    vint32m4_t _res = vnclip_wv_i32m4(_mulw, vreinterpret_v_i32m4_u32m4(_shift), vl);
+    _res = vsadd_vx_i32m4(_res, out_zp, vl);
+    vint16m2_t _tmp1 = vnclip_wx_i16m2(_res, 0, vl);
+    return vnclip_wx_i8m1(_tmp1, 0, vl);
+}
+
+/* per output channel multiplier / shift, per tensor quantization is broadcast */
+static void fc_requantize_params_int8(struct csinn_tensor *weights, int output_depth,
+                                      int32_t *multiplier, int32_t *shift)
+{
+    for (int c = 0; c < output_depth; c++) {
+        int q = weights->quant_channel == output_depth ? c : 0;
+        multiplier[c] = weights->qinfo[q].multiplier;
+        shift[c] = weights->qinfo[q].shift;
+    }
+}
+
 static void shl_rvv_reorder_weight_packn_int8(int8_t *src, int8_t *dst, int m, int k, int ldx)
 {
     const int packn = csrr_vlenb() / sizeof(int8_t);  // VLEN128=16  VLEN256=32
@@ -55,8 +85,10 @@ void shl_rvv_fc_gemv_transform_weight_int8(struct csinn_tensor *weights)
     shl_mem_free(pa_reorder);
 }
 
-static void shl_rvv_fullyconnectd_packn_int8_internel(const int8_t *input, int32_t *output,
+static void shl_rvv_fullyconnectd_packn_int8_internel(const int8_t *input, int8_t *output,
                                                       int8_t *weight, const int32_t *bias,
+                                                      const int32_t *multiplier,
+                                                      const int32_t *shift, int32_t out_zp,
                                                       int in_nodes, int out_nodes)
 {
     const int packn = csrr_vlenb() / sizeof(int8_t);
@@ -72,8 +104,11 @@ static void shl_rvv_fullyconnectd_packn_int8_internel(const int8_t *input, int32
             _acc = vwmacc_vx_i32m4(_acc, 1, _mul, vl);
             weight += vl;
         }
-        vse32_v_i32m4(output, _acc, vl);
+        vint8m1_t _res = requantize_m4_s(_acc, multiplier, shift, out_zp, vl);
+        vse8_v_i8m1(output, _res, vl);
         output += vl;
+        multiplier += vl;
+        shift += vl;
         out_nodes -= vl;
     }
 }
@@ -97,35 +132,22 @@ int shl_rvv_fullyconnected_packn_int8(struct csinn_tensor *input, struct csinn_t
     const int output_depth = weights->dim[weights_dims_count - 2];  // output_nodes
     const int accum_depth = weights->dim[weights_dims_count - 1];   // input_nodes
 
-    int32_t *output_tmp = (int32_t *)shl_mem_alloc(output_depth * sizeof(int32_t));
-    int vl;
+    int32_t *multiplier = (int32_t *)shl_mem_alloc(output_depth * sizeof(int32_t));
+    int32_t *shift = (int32_t *)shl_mem_alloc(output_depth * sizeof(int32_t));
+    fc_requantize_params_int8(weights, output_depth, multiplier, shift);
 
     for (int b = 0; b < batches; b++) {
         int8_t *input_ptr = input_data + b * accum_depth;
         int8_t *weight_ptr = weights_data;
         int32_t *bias_ptr = bias_data;
-        int32_t *output_ptr = output_tmp;
+        int8_t *output_ptr = output_data + b * output_depth;
 
         shl_rvv_fullyconnectd_packn_int8_internel(input_ptr, output_ptr, weight_ptr, bias_ptr,
+                                                  multiplier, shift, output->qinfo->zero_point,
                                                   accum_depth, output_depth);
-
-        if (weights->quant_channel == 1) {
-            shl_rvv_requantize(output_ptr, weights->qinfo->multiplier, weights->qinfo->shift,
-                               output_depth);
-        } else if (weights->quant_channel == output_depth) {
-            // support channel quantization
-            for (int c = 0; c < weights->quant_channel; c++) {
-                shl_rvv_requantize(output_ptr + c, weights->qinfo[c].multiplier,
-                                   weights->qinfo[c].shift, 1);
-            }
-        }
-        shl_rvv_saturated_int8(output_ptr, output_data + b * output_depth,
-                               output->qinfo->zero_point, output_depth);
-    }
-    if (output_tmp) {
-        shl_mem_free(output_tmp);
-        output_tmp = NULL;
     }
+    shl_mem_free(multiplier);
+    shl_mem_free(shift);
     return CSINN_TRUE;
 }
 
@@ -175,8 +197,10 @@ void shl_rvv_fc_gemv_transform_weight_int8_dot(struct csinn_tensor *weights)
     shl_mem_free(pa_reorder);
 }
 
-static void shl_rvv_fullyconnectd_packn_int8_internel_dot(const int8_t *input, int32_t *output,
+static void shl_rvv_fullyconnectd_packn_int8_internel_dot(const int8_t *input, int8_t *output,
                                                           int8_t *weight, const int32_t *bias,
+                                                          const int32_t *multiplier,
+                                                          const int32_t *shift, int32_t out_zp,
                                                           int in_nodes, int out_nodes)
 {
     const int packn = csrr_vlenb() / sizeof(int8_t);
@@ -192,8 +216,11 @@ static void shl_rvv_fullyconnectd_packn_int8_internel_dot(const int8_t *input, i
             _acc0 = vmaqa_vx_i32m4(_acc0, input_ptr[c], _weight, vl);
             weight += 4 * vl;
         }
-        vse32_v_i32m4(output, _acc0, vl);
+        vint8m1_t _res = requantize_m4_s(_acc0, multiplier, shift, out_zp, vl);
+        vse8_v_i8m1(output, _res, vl);
         output += vl;
+        multiplier += vl;
+        shift += vl;
         out_nodes -= vl;
     }
 }
@@ -217,35 +244,22 @@ int shl_rvv_fullyconnected_packn_int8_dot(struct csinn_tensor *input, struct csi
     const int output_depth = weights->dim[weights_dims_count - 2];  // output_nodes
     const int accum_depth = weights->dim[weights_dims_count - 1];   // input_nodes
 
-    int32_t *output_tmp = (int32_t *)shl_mem_alloc(output_depth * sizeof(int32_t));
-    int vl;
+    int32_t *multiplier = (int32_t *)shl_mem_alloc(output_depth * sizeof(int32_t));
+    int32_t *shift = (int32_t *)shl_mem_alloc(output_depth * sizeof(int32_t));
+    fc_requantize_params_int8(weights, output_depth, multiplier, shift);
 
     for (int b = 0; b < batches; b++) {
         int8_t *input_ptr = input_data + b * accum_depth;
         int8_t *weight_ptr = weights_data;
         int32_t *bias_ptr = bias_data;
-        int32_t *output_ptr = output_tmp;
+        int8_t *output_ptr = output_data + b * output_depth;
 
         shl_rvv_fullyconnectd_packn_int8_internel_dot(input_ptr, output_ptr, weight_ptr, bias_ptr,
+                                                      multiplier, shift, output->qinfo->zero_point,
                                                       accum_depth, output_depth);
-
-        if (weights->quant_channel == 1) {
-            shl_rvv_requantize(output_ptr, weights->qinfo->multiplier, weights->qinfo->shift,
-                               output_depth);
-        } else if (weights->quant_channel == output_depth) {
-            // support channel quantization
-            for (int c = 0; c < weights->quant_channel; c++) {
-                shl_rvv_requantize(output_ptr + c, weights->qinfo[c].multiplier,
-                                   weights->qinfo[c].shift, 1);
-            }
-        }
-        shl_rvv_saturated_int8(output_ptr, output_data + b * output_depth,
-                               output->qinfo->zero_point, output_depth);
-    }
-    if (output_tmp) {
-        shl_mem_free(output_tmp);
-        output_tmp = NULL;
     }
+    shl_mem_free(multiplier);
+    shl_mem_free(shift);
     return CSINN_TRUE;
 }
 #endif
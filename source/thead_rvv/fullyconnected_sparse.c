@@ -0,0 +1,293 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_thead_rvv.h"
+
+/*************************************************************
+ * structured sparse gemv for small batches, vectorized along the output nodes.
+ * The compressed weights are reordered in place into blocks of `block` rows:
+ * values [m / block, groups, keep, block]  index [m / block, groups, block]
+ * (the last block holds the remaining rows), so every kept weight of a block
+ * is one contiguous load and the input is gathered by the index of each row.
+ *************************************************************/
+static void sparse_reorder_rows(uint8_t *data, int m, int row_size, int elem, int block)
+{
+    uint8_t *tmp = (uint8_t *)shl_mem_alloc((int64_t)m * row_size * elem);
+    for (int o = 0; o < m; o += block) {
+        int rows = m - o < block ? m - o : block;
+        for (int r = 0; r < rows; r++) {
+            for (int i = 0; i < row_size; i++) {
+                memcpy(tmp + ((int64_t)o * row_size + i * rows + r) * elem,
+                       data + ((int64_t)(o + r) * row_size + i) * elem, elem);
+            }
+        }
+    }
+    memcpy(data, tmp, (int64_t)m * row_size * elem);
+    shl_mem_free(tmp);
+}
+
+void shl_rvv_fc_sparse_gemv_transform_weight(struct csinn_tensor *weights, int block)
+{
+    int m = weights->dim[0];
+    int groups = shl_sparse_groups(weights);
+    int keep = shl_sparse_keep(weights->mtype);
+    int elem = weights->dtype == CSINN_DTYPE_FLOAT32   ? sizeof(float)
+               : weights->dtype == CSINN_DTYPE_FLOAT16 ? sizeof(__fp16)
+                                                       : sizeof(int8_t);
+    sparse_reorder_rows((uint8_t *)weights->data, m, groups * keep, elem, block);
+    sparse_reorder_rows(shl_sparse_index(weights), m, groups, 1, block);
+}
+
+/*
+ * the input of kept weight j of every row in a block: the 2-bit position in the index byte
+ * is turned into a byte offset from the start of the group of 4 inputs
+ */
+static inline vfloat32m1_t sparse_gather_f32(const float *base, const uint8_t *pos, int j, int vl)
+{
+#ifdef RVV_1_0_0
+    vuint8mf4_t _off = vand_vx_u8mf4(vsrl_vx_u8mf4(vle8_v_u8mf4(pos, vl), 2 * j, vl), 3, vl);
+    return vluxei8_v_f32m1(base, vsll_vx_u8mf4(_off, 2, vl), vl);
+#else
+    float in[vl];
+    for (int i = 0; i < vl; i++) {
+        in[i] = base[(pos[i] >> (2 * j)) & 3];
+    }
+    return vle32_v_f32m1(in, vl);
+#endif
+}
+
+static inline vfloat16m1_t sparse_gather_f16(const __fp16 *base, const uint8_t *pos, int j, int vl)
+{
+#ifdef RVV_1_0_0
+    vuint8mf2_t _off = vand_vx_u8mf2(vsrl_vx_u8mf2(vle8_v_u8mf2(pos, vl), 2 * j, vl), 3, vl);
+    return vluxei8_v_f16m1(base, vsll_vx_u8mf2(_off, 1, vl), vl);
+#else
+    __fp16 in[vl];
+    for (int i = 0; i < vl; i++) {
+        in[i] = base[(pos[i] >> (2 * j)) & 3];
+    }
+    return vle16_v_f16m1(in, vl);
+#endif
+}
+
+static inline vint8m1_t sparse_gather_i8(const int8_t *base, const uint8_t *pos, int j, int vl)
+{
+#ifdef RVV_1_0_0
+    vuint8m1_t _off = vand_vx_u8m1(vsrl_vx_u8m1(vle8_v_u8m1(pos, vl), 2 * j, vl), 3, vl);
+    return vluxei8_v_i8m1(base, _off, vl);
+#else
+    int8_t in[vl];
+    for (int i = 0; i < vl; i++) {
+        in[i] = base[(pos[i] >> (2 * j)) & 3];
+    }
+    return vle8_v_i8m1(in, vl);
+#endif
+}
+
+static int sparse_gemv_batches(struct csinn_tensor *output)
+{
+    int batches = 1;
+    for (int i = 0; i < output->dim_count - 1; i++) {
+        batches *= output->dim[i];
+    }
+    return batches;
+}
+
+int shl_rvv_fullyconnected_sparse_gemv_fp32(struct csinn_tensor *input,
+                                            struct csinn_tensor *output,
+                                            struct csinn_tensor *weights,
+                                            struct csinn_tensor *bias,
+                                            struct csinn_fc_params *params)
+{
+    float *input_data = (float *)input->data;
+    float *output_data = (float *)output->data;
+    float *weights_data = (float *)weights->data;
+    float *bias_data = bias->dim_count != 0 ? (float *)bias->data : NULL;
+    uint8_t *index = shl_sparse_index(weights);
+    const int keep = shl_sparse_keep(weights->mtype);
+    const int groups = shl_sparse_groups(weights);
+    const int batches = sparse_gemv_batches(output);
+    const int out_nodes = weights->dim[weights->dim_count - 2];
+    const int in_nodes = weights->dim[weights->dim_count - 1];
+    const int packn = csrr_vlenb() / sizeof(float);
+
+    for (int b = 0; b < batches; b++) {
+        const float *in = input_data + b * in_nodes;
+        float *out = output_data + b * out_nodes;
+        int o = 0;
+        while (o < out_nodes) {
+            // a whole block of the reordered weights, or the remaining rows
+            int vl = vsetvl_e32m1(out_nodes - o < packn ? out_nodes - o : packn);
+            const float *w = weights_data + o * groups * keep;
+            const uint8_t *idx = index + o * groups;
+            vfloat32m1_t _acc =
+                bias_data ? vle32_v_f32m1(bias_data + o, vl) : vfmv_v_f_f32m1(0.0f, vl);
+            for (int g = 0; g < groups; g++) {
+                for (int j = 0; j < keep; j++) {
+                    vfloat32m1_t _w = vle32_v_f32m1(w + (g * keep + j) * vl, vl);
+                    vfloat32m1_t _in = sparse_gather_f32(in + g * 4, idx + g * vl, j, vl);
+                    _acc = vfmacc_vv_f32m1(_acc, _w, _in, vl);
+                }
+            }
+            vse32_v_f32m1(out + o, _acc, vl);
+            o += vl;
+        }
+    }
+    return CSINN_TRUE;
+}
+
+int shl_rvv_fullyconnected_sparse_gemv_fp16(struct csinn_tensor *input,
+                                            struct csinn_tensor *output,
+                                            struct csinn_tensor *weights,
+                                            struct csinn_tensor *bias,
+                                            struct csinn_fc_params *params)
+{
+    __fp16 *input_data = (__fp16 *)input->data;
+    __fp16 *output_data = (__fp16 *)output->data;
+    __fp16 *weights_data = (__fp16 *)weights->data;
+    __fp16 *bias_data = bias->dim_count != 0 ? (__fp16 *)bias->data : NULL;
+    uint8_t *index = shl_sparse_index(weights);
+    const int keep = shl_sparse_keep(weights->mtype);
+    const int groups = shl_sparse_groups(weights);
+    const int batches = sparse_gemv_batches(output);
+    const int out_nodes = weights->dim[weights->dim_count - 2];
+    const int in_nodes = weights->dim[weights->dim_count - 1];
+    const int packn = csrr_vlenb() / sizeof(__fp16);
+
+    for (int b = 0; b < batches; b++) {
+        const __fp16 *in = input_data + b * in_nodes;
+        __fp16 *out = output_data + b * out_nodes;
+        int o = 0;
+        while (o < out_nodes) {
+            // a whole block of the reordered weights, or the remaining rows
+            int vl = vsetvl_e16m1(out_nodes - o < packn ? out_nodes - o : packn);
+            const __fp16 *w = weights_data + o * groups * keep;
+            const uint8_t *idx = index + o * groups;
+            vfloat16m1_t _acc =
+                bias_data ? vle16_v_f16m1(bias_data + o, vl) : vfmv_v_f_f16m1(0.0f, vl);
+            for (int g = 0; g < groups; g++) {
+                for (int j = 0; j < keep; j++) {
+                    vfloat16m1_t _w = vle16_v_f16m1(w + (g * keep + j) * vl, vl);
+                    vfloat16m1_t _in = sparse_gather_f16(in + g * 4, idx + g * vl, j, vl);
+                    _acc = vfmacc_vv_f16m1(_acc, _w, _in, vl);
+                }
+            }
+            vse16_v_f16m1(out + o, _acc, vl);
+            o += vl;
+        }
+    }
+    return CSINN_TRUE;
+}
+
+/* requantize vl output nodes with their own multiplier / shift and narrow to int8 */
+static vint8m1_t sparse_requantize_m4(vint32m4_t _src, const int32_t *multiplier,
+                                      const int32_t *shift, int32_t out_zp, int vl)
+{
+    vint32m4_t _mult = vle32_v_i32m4(multiplier, vl);
+    vint32m4_t _shift = vle32_v_i32m4(shift, vl);
+    vint64m8_t _mulw = vwmul_vv_i64m8(_src, _mult, vl);
+    _shift = vrsub_vx_i32m4(_shift, 31, vl);
+    vint32m4_t _res = vnclip_wv_i32m4(_mulw, vreinterpret_v_i32m4_u32m4(_shift), vl);
+    _res = vsadd_vx_i32m4(_res, out_zp, vl);
+    vint16m2_t _tmp1 = vnclip_wx_i16m2(_res, 0, vl);
+    return vnclip_wx_i8m1(_tmp1, 0, vl);
+}
+
+/* the input zero point is fused into bias, see shl_rvv_fullyconnected_sparse_init_int8 */
+int shl_rvv_fullyconnected_sparse_gemv_int8(struct csinn_tensor *input,
+                                            struct csinn_tensor *output,
+                                            struct csinn_tensor *weights,
+                                            struct csinn_tensor *bias,
+                                            struct csinn_fc_params *params)
+{
+    int8_t *input_data = (int8_t *)input->data;
+    int8_t *output_data = (int8_t *)output->data;
+    int8_t *weights_data = (int8_t *)weights->data;
+    int32_t *bias_data = (int32_t *)bias->data;
+    uint8_t *index = shl_sparse_index(weights);
+    const int keep = shl_sparse_keep(weights->mtype);
+    const int groups = shl_sparse_groups(weights);
+    const int batches = sparse_gemv_batches(output);
+    const int out_nodes = weights->dim[weights->dim_count - 2];
+    const int in_nodes = weights->dim[weights->dim_count - 1];
+    const int packn = csrr_vlenb() / sizeof(int8_t);
+
+    int32_t *multiplier = (int32_t *)shl_mem_alloc(out_nodes * sizeof(int32_t));
+    int32_t *shift = (int32_t *)shl_mem_alloc(out_nodes * sizeof(int32_t));
+    for (int c = 0; c < out_nodes; c++) {
+        int q = weights->quant_channel == out_nodes ? c : 0;
+        multiplier[c] = weights->qinfo[q].multiplier;
+        shift[c] = weights->qinfo[q].shift;
+    }
+
+    for (int b = 0; b < batches; b++) {
+        const int8_t *in = input_data + b * in_nodes;
+        int8_t *out = output_data + b * out_nodes;
+        int o = 0;
+        while (o < out_nodes) {
+            // a whole block of the reordered weights, or the remaining rows
+            int vl = vsetvl_e8m1(out_nodes - o < packn ? out_nodes - o : packn);
+            const int8_t *w = weights_data + o * groups * keep;
+            const uint8_t *idx = index + o * groups;
+            vint32m4_t _acc = vle32_v_i32m4(bias_data + o, vl);
+            for (int g = 0; g < groups; g++) {
+                for (int j = 0; j < keep; j++) {
+                    vint8m1_t _w = vle8_v_i8m1(w + (g * keep + j) * vl, vl);
+                    vint8m1_t _in = sparse_gather_i8(in + g * 4, idx + g * vl, j, vl);
+                    vint16m2_t _mul = vwmul_vv_i16m2(_w, _in, vl);
+                    _acc = vwadd_wv_i32m4(_acc, _mul, vl);
+                }
+            }
+            vint8m1_t _res = sparse_requantize_m4(_acc, multiplier + o, shift + o,
+                                                  output->qinfo->zero_point, vl);
+            vse8_v_i8m1(out + o, _res, vl);
+            o += vl;
+        }
+    }
+    shl_mem_free(multiplier);
+    shl_mem_free(shift);
+    return CSINN_TRUE;
+}
+
+/* reorder the compressed weights for the gemv kernels, the block is the vlmax of each */
+int shl_rvv_fullyconnected_sparse_gemv_init(struct csinn_tensor *input,
+                                            struct csinn_tensor *output,
+                                            struct csinn_tensor *weights,
+                                            struct csinn_tensor *bias,
+                                            struct csinn_fc_params *params)
+{
+    struct csinn_callback *cb = params->base.cb;
+    if (input->dtype == CSINN_DTYPE_FLOAT32) {
+        shl_rvv_fc_sparse_gemv_transform_weight(weights, csrr_vlenb() / sizeof(float));
+        cb->exec = shl_rvv_fullyconnected_sparse_gemv_fp32;
+    } else if (input->dtype == CSINN_DTYPE_FLOAT16) {
+        shl_rvv_fc_sparse_gemv_transform_weight(weights, csrr_vlenb() / sizeof(__fp16));
+        cb->exec = shl_rvv_fullyconnected_sparse_gemv_fp16;
+    } else if (input->dtype == CSINN_DTYPE_INT8) {
+        // multipliers, and the zero point fused into bias over the kept weights
+        shl_rvv_fullyconnected_sparse_init_int8(input, output, weights, bias, params);
+        shl_rvv_fc_sparse_gemv_transform_weight(weights, csrr_vlenb() / sizeof(int8_t));
+        cb->exec = shl_rvv_fullyconnected_sparse_gemv_int8;
+    } else {
+        shl_debug_error("%s: unsupported dtype %d\n", __func__, input->dtype);
+        return CSINN_UNSUPPORT_DTYPE;
+    }
+    return CSINN_TRUE;
+}
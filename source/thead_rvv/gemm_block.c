@@ -0,0 +1,403 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_thead_rvv.h"
+
+/*************************************************************
+ * Cache blocked drivers around the ncxhwx gemm micro-kernels.
+ * The packed B matrix is cut into column blocks of nc that stay
+ * in L2, and for float the depth is cut into blocks of kc so that
+ * one kernel panel and one input panel stay in L1 while the
+ * micro-kernel walks a column block.
+ *************************************************************/
+
+#ifdef SHL_BUILD_C906
+#define SHL_RVV_L1_SIZE (32 * 1024)
+#define SHL_RVV_L2_SIZE 0
+#elif defined SHL_BUILD_C908
+#define SHL_RVV_L1_SIZE (32 * 1024)
+#define SHL_RVV_L2_SIZE (256 * 1024)
+#else
+/* C920 */
+#define SHL_RVV_L1_SIZE (64 * 1024)
+#define SHL_RVV_L2_SIZE (1024 * 1024)
+#endif
+
+/* width of the input column groups, see shl_rvv_reorder_input_z12_packn_fp32 */
+#define GEMM_NR 12
+
+static int32_t shl_rvv_l1_size = -1;
+static int32_t shl_rvv_l2_size = -1;
+
+#ifndef SHL_BUILD_RTOS
+static int32_t read_sysfs_int(int index, const char *name, char *type)
+{
+    char path[128];
+    char buf[32] = {0};
+    snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/%s", index, name);
+    FILE *fp = fopen(path, "r");
+    if (fp == NULL) {
+        return -1;
+    }
+    if (fgets(buf, sizeof(buf), fp) == NULL) {
+        fclose(fp);
+        return -1;
+    }
+    fclose(fp);
+    if (type != NULL) {
+        strncpy(type, buf, 16);
+        return 0;
+    }
+    char *end;
+    int32_t value = strtol(buf, &end, 10);
+    if (*end == 'K') {
+        value *= 1024;
+    } else if (*end == 'M') {
+        value *= 1024 * 1024;
+    }
+    return value;
+}
+#endif
+
+static void cache_size_init()
+{
+    shl_rvv_l1_size = SHL_RVV_L1_SIZE;
+    shl_rvv_l2_size = SHL_RVV_L2_SIZE;
+#ifndef SHL_BUILD_RTOS
+    for (int i = 0; i < 4; i++) {
+        char type[17] = {0};
+        int32_t level = read_sysfs_int(i, "level", NULL);
+        int32_t size = read_sysfs_int(i, "size", NULL);
+        if (level < 0 || size <= 0 || read_sysfs_int(i, "type", type) < 0) {
+            break;
+        }
+        if (level == 1 && strncmp(type, "Instruction", 11) != 0) {
+            shl_rvv_l1_size = size;
+        } else if (level == 2) {
+            shl_rvv_l2_size = size;
+        }
+    }
+#endif
+}
+
+/*************************************************************
+ * Override the cache sizes (in bytes) used to block the gemm.
+ * l2_size = 0 disables the column blocking.
+ *************************************************************/
+void shl_rvv_set_cache_size(int32_t l1_size, int32_t l2_size)
+{
+    shl_rvv_l1_size = l1_size;
+    shl_rvv_l2_size = l2_size;
+}
+
+/*************************************************************
+ * kc: a kernel panel [kc, mr] and an input panel [kc, 12] fill half of L1
+ * nc: an input block [kc, nc] fills half of L2, multiple of 12
+ * int8 kernels fuse the requantization, so they always take kc = k
+ *************************************************************/
+static void gemm_block_size(int elem_size, int mr, int k, int n, bool split_k, int *kc, int *nc)
+{
+    if (shl_rvv_l1_size < 0) {
+        cache_size_init();
+    }
+
+    int block_k = k;
+    if (split_k && shl_rvv_l1_size > 0) {
+        block_k = shl_rvv_l1_size / 2 / ((mr + GEMM_NR) * elem_size);
+        block_k = block_k < 16 ? 16 : block_k;
+        if (block_k < k) {
+            /* balance the blocks so that the last one is not a sliver */
+            int num = (k + block_k - 1) / block_k;
+            block_k = (k + num - 1) / num;
+        } else {
+            block_k = k;
+        }
+    }
+
+    int block_n = n;
+    if (shl_rvv_l2_size > 0) {
+        block_n = shl_rvv_l2_size / 2 / (block_k * elem_size);
+        block_n = block_n / GEMM_NR * GEMM_NR;
+        block_n = block_n < GEMM_NR ? GEMM_NR : block_n;
+        block_n = block_n < n ? block_n : n;
+    }
+    *kc = block_k;
+    *nc = block_n;
+}
+
+/*************************************************************
+ * columns of a packed input tile [k, nc] that fits half of L2,
+ * or a few L1 sized panels when there is no L2
+ *************************************************************/
+int shl_rvv_gemm_tile_n(int elem_size, int k, int n)
+{
+    if (shl_rvv_l1_size < 0) {
+        cache_size_init();
+    }
+    int budget = shl_rvv_l2_size > 0 ? shl_rvv_l2_size / 2 : shl_rvv_l1_size * 4;
+    int tile_n = budget / (k * elem_size) / GEMM_NR * GEMM_NR;
+    tile_n = tile_n < GEMM_NR ? GEMM_NR : tile_n;
+    return tile_n < n ? tile_n : n;
+}
+
+/* width of the next output channel panel, as walked by the micro-kernels */
+static inline int panel_width(int oc, int m, int pack)
+{
+    if (m - oc >= pack) {
+        return pack;
+    }
+    return m - oc;
+}
+
+/* width of the next input column group, as walked by the micro-kernels */
+static inline int group_width(int t, int n)
+{
+    if (t + 11 < n) {
+        return 12;
+    } else if (t + 7 < n) {
+        return 8;
+    } else if (t + 3 < n) {
+        return 4;
+    } else if (t + 1 < n) {
+        return 2;
+    }
+    return 1;
+}
+
+/*************************************************************
+ * copy rows [k0, k0 + kb) of every packed panel into a contiguous block
+ * kernel: [m/pack2n, k, pack2n] -> [m/pack2n, kb, pack2n]
+ * input:  [n/12, k, 12] -> [nb/12, kb, 12]
+ *************************************************************/
+static void pack_kernel_block(const void *sa, void *pa, int m, int k, int k0, int kb, int pack2n,
+                              int elem_size)
+{
+    const int8_t *src = (const int8_t *)sa;
+    int8_t *dst = (int8_t *)pa;
+    for (int oc = 0; oc < m;) {
+        int w = panel_width(oc, m, pack2n);
+        if (w < pack2n && w > pack2n / 2) {
+            w = pack2n / 2;
+        }
+        memcpy(dst + (int64_t)oc * kb * elem_size, src + ((int64_t)oc * k + k0 * w) * elem_size,
+               (int64_t)kb * w * elem_size);
+        oc += w;
+    }
+}
+
+static void pack_input_block(const void *sb, void *pb, int k, int n0, int nb, int k0, int kb,
+                             int elem_size)
+{
+    const int8_t *src = (const int8_t *)sb;
+    int8_t *dst = (int8_t *)pb;
+    for (int t = 0; t < nb;) {
+        int w = group_width(t, nb);
+        memcpy(dst + (int64_t)t * kb * elem_size,
+               src + ((int64_t)(n0 + t) * k + k0 * w) * elem_size, (int64_t)kb * w * elem_size);
+        t += w;
+    }
+}
+
+/*************************************************************
+ * dst - output: [m/packn, n, packn]
+ * sa - kernel:  [m/pack2n, k, pack2n]  [m/packn, k, packn]
+ * sb - input:   [n/12, k, 12]
+ * same contract as shl_rvv_ncxhwx_gemm_12xpack2n_fp32
+ *************************************************************/
+void shl_rvv_ncxhwx_gemm_12xpack2n_blocked_fp32(float *dst, const float *sa, const float *sb,
+                                                float *bias, int m, int k, int n, int ldc)
+{
+    const int packn = csrr_vlenb() / sizeof(float);
+    const int pack2n = packn * 2;
+    int kc, nc;
+    gemm_block_size(sizeof(float), pack2n, k, n, true, &kc, &nc);
+    if (kc == k && nc == n) {
+        shl_rvv_ncxhwx_gemm_12xpack2n_fp32(dst, sa, sb, bias, m, k, n, ldc);
+        return;
+    }
+
+    const int m_main = m / packn * packn;
+    const int tail = m - m_main;
+    float *pa = NULL, *pb = NULL, *acc = NULL, *zero_bias = NULL;
+    if (kc < k) {
+        pa = (float *)shl_mem_alloc(m * kc * sizeof(float));
+        pb = (float *)shl_mem_alloc(kc * nc * sizeof(float));
+        acc = (float *)shl_mem_alloc(m * nc * sizeof(float));
+        zero_bias = (float *)shl_mem_alloc(m * sizeof(float));
+    }
+
+    for (int k0 = 0; k0 < k; k0 += kc) {
+        int kb = k - k0 < kc ? k - k0 : kc;
+        const float *a_blk = sa;
+        if (kb < k) {
+            pack_kernel_block(sa, pa, m, k, k0, kb, pack2n, sizeof(float));
+            a_blk = pa;
+        }
+        for (int n0 = 0; n0 < n; n0 += nc) {
+            int nb = n - n0 < nc ? n - n0 : nc;
+            const float *b_blk = sb + n0 * k;
+            if (kb < k) {
+                pack_input_block(sb, pb, k, n0, nb, k0, kb, sizeof(float));
+                b_blk = pb;
+            }
+            if (k0 == 0) {
+                /* the tail channels are stored with their own width, block them apart */
+                if (m_main > 0) {
+                    shl_rvv_ncxhwx_gemm_12xpack2n_fp32(dst + n0 * packn, a_blk, b_blk, bias,
+                                                       m_main, kb, nb, ldc);
+                }
+                if (tail > 0) {
+                    shl_rvv_ncxhwx_gemm_12xpack2n_fp32(
+                        dst + m_main * ldc + n0 * tail, a_blk + m_main * kb, b_blk,
+                        bias ? bias + m_main : NULL, tail, kb, nb, ldc);
+                }
+                continue;
+            }
+            shl_rvv_ncxhwx_gemm_12xpack2n_fp32(acc, a_blk, b_blk, zero_bias, m, kb, nb, nb);
+            for (int oc = 0; oc < m; oc += packn) {
+                int w = panel_width(oc, m, packn);
+                float *out = dst + oc * ldc + n0 * w;
+                float *in = acc + oc * nb;
+                int size = nb * w;
+                while (size > 0) {
+                    int vl = vsetvl_e32m4(size);
+                    vfloat32m4_t _out = vle32_v_f32m4(out, vl);
+                    vfloat32m4_t _in = vle32_v_f32m4(in, vl);
+                    vse32_v_f32m4(out, vfadd_vv_f32m4(_out, _in, vl), vl);
+                    out += vl;
+                    in += vl;
+                    size -= vl;
+                }
+            }
+        }
+    }
+
+    shl_mem_free(pa);
+    shl_mem_free(pb);
+    shl_mem_free(acc);
+    shl_mem_free(zero_bias);
+}
+
+/*************************************************************
+ * same contract as shl_rvv_ncxhwx_gemm_12xpack2n_fp16
+ *************************************************************/
+void shl_rvv_ncxhwx_gemm_12xpack2n_blocked_fp16(__fp16 *dst, const __fp16 *sa, const __fp16 *sb,
+                                                __fp16 *bias, int m, int k, int n, int ldc)
+{
+    const int packn = csrr_vlenb() / sizeof(__fp16);
+    const int pack2n = packn * 2;
+    int kc, nc;
+    gemm_block_size(sizeof(__fp16), pack2n, k, n, true, &kc, &nc);
+    if (kc == k && nc == n) {
+        shl_rvv_ncxhwx_gemm_12xpack2n_fp16(dst, sa, sb, bias, m, k, n, ldc);
+        return;
+    }
+
+    const int m_main = m / packn * packn;
+    const int tail = m - m_main;
+    __fp16 *pa = NULL, *pb = NULL, *acc = NULL, *zero_bias = NULL;
+    if (kc < k) {
+        pa = (__fp16 *)shl_mem_alloc(m * kc * sizeof(__fp16));
+        pb = (__fp16 *)shl_mem_alloc(kc * nc * sizeof(__fp16));
+        acc = (__fp16 *)shl_mem_alloc(m * nc * sizeof(__fp16));
+        zero_bias = (__fp16 *)shl_mem_alloc(m * sizeof(__fp16));
+    }
+
+    for (int k0 = 0; k0 < k; k0 += kc) {
+        int kb = k - k0 < kc ? k - k0 : kc;
+        const __fp16 *a_blk = sa;
+        if (kb < k) {
+            pack_kernel_block(sa, pa, m, k, k0, kb, pack2n, sizeof(__fp16));
+            a_blk = pa;
+        }
+        for (int n0 = 0; n0 < n; n0 += nc) {
+            int nb = n - n0 < nc ? n - n0 : nc;
+            const __fp16 *b_blk = sb + n0 * k;
+            if (kb < k) {
+                pack_input_block(sb, pb, k, n0, nb, k0, kb, sizeof(__fp16));
+                b_blk = pb;
+            }
+            if (k0 == 0) {
+                if (m_main > 0) {
+                    shl_rvv_ncxhwx_gemm_12xpack2n_fp16(dst + n0 * packn, a_blk, b_blk, bias,
+                                                       m_main, kb, nb, ldc);
+                }
+                if (tail > 0) {
+                    shl_rvv_ncxhwx_gemm_12xpack2n_fp16(
+                        dst + m_main * ldc + n0 * tail, a_blk + m_main * kb, b_blk,
+                        bias ? bias + m_main : NULL, tail, kb, nb, ldc);
+                }
+                continue;
+            }
+            shl_rvv_ncxhwx_gemm_12xpack2n_fp16(acc, a_blk, b_blk, zero_bias, m, kb, nb, nb);
+            for (int oc = 0; oc < m; oc += packn) {
+                int w = panel_width(oc, m, packn);
+                __fp16 *out = dst + oc * ldc + n0 * w;
+                __fp16 *in = acc + oc * nb;
+                int size = nb * w;
+                while (size > 0) {
+                    int vl = vsetvl_e16m4(size);
+                    vfloat16m4_t _out = vle16_v_f16m4(out, vl);
+                    vfloat16m4_t _in = vle16_v_f16m4(in, vl);
+                    vse16_v_f16m4(out, vfadd_vv_f16m4(_out, _in, vl), vl);
+                    out += vl;
+                    in += vl;
+                    size -= vl;
+                }
+            }
+        }
+    }
+
+    shl_mem_free(pa);
+    shl_mem_free(pb);
+    shl_mem_free(acc);
+    shl_mem_free(zero_bias);
+}
+
+#ifdef XTHEADV
+/*************************************************************
+ * same contract as shl_rvv_ncxhwx_gemm_12xpackn_int8
+ * the requantization is fused into the micro-kernel, so only the
+ * columns are blocked and every block sees the whole depth
+ *************************************************************/
+void shl_rvv_ncxhwx_gemm_12xpackn_blocked_int8(int8_t *dst, const int8_t *sa, const int8_t *sb,
+                                               int32_t *bias, int m, int k, int n, int ldc,
+                                               int32_t out_zp, int32_t *mult, int32_t *shift)
+{
+    const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
+    int kc, nc;
+    gemm_block_size(sizeof(int8_t), packn, k, n, false, &kc, &nc);
+
+    const int m_main = m / packn * packn;
+    const int tail = m - m_main;
+    for (int n0 = 0; n0 < n; n0 += nc) {
+        int nb = n - n0 < nc ? n - n0 : nc;
+        if (m_main > 0) {
+            shl_rvv_ncxhwx_gemm_12xpackn_int8(dst + n0 * packn, sa, sb + n0 * k, bias, m_main, k,
+                                              nb, ldc, out_zp, mult, shift);
+        }
+        if (tail > 0) {
+            shl_rvv_ncxhwx_gemm_12xpackn_int8(dst + m_main * ldc + n0 * tail, sa + m_main * k,
+                                              sb + n0 * k, bias + m_main, tail, k, nb, ldc,
+                                              out_zp, mult + m_main, shift + m_main);
+        }
+    }
+}
+#endif
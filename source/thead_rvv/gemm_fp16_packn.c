@@ -50,8 +50,8 @@ void shl_rvv_ncxhwx_gemm_8xpack2n_fp16(__fp16 *dst, const __fp16 *sa, const __fp
 
     int oc = 0;
     for (; oc + pack2n - 1 < m; oc += pack2n) {
-        __fp16 *output0 = output_data + oc * n;  // 16 channel dot output
-        __fp16 *output1 = output0 + packn * n;
+        __fp16 *output0 = output_data + oc * ldc;  // 16 channel dot output
+        __fp16 *output1 = output0 + packn * ldc;
         const __fp16 *img0 = input_data;
         const __fp16 *b0 = bias_ptr + oc;
         int t = 0;
@@ -203,7 +203,7 @@ void shl_rvv_ncxhwx_gemm_8xpack2n_fp16(__fp16 *dst, const __fp16 *sa, const __fp
     }
 
     for (; oc + packn - 1 < m; oc += packn) {
-        __fp16 *output0 = output_data + oc * n;  // 8 channel dot output
+        __fp16 *output0 = output_data + oc * ldc;  // 8 channel dot output
         const __fp16 *img0 = input_data;
         const __fp16 *b0 = bias_ptr + oc;
         int t = 0;
@@ -297,7 +297,7 @@ void shl_rvv_ncxhwx_gemm_8xpack2n_fp16(__fp16 *dst, const __fp16 *sa, const __fp
     /* tail output_channel */
     if (oc < m) {
         vl = vsetvl_e16m1(m - oc);
-        __fp16 *output0 = output_data + oc * n;  // 8 channel dot output
+        __fp16 *output0 = output_data + oc * ldc;  // 8 channel dot output
         const __fp16 *img0 = input_data;
         const __fp16 *b0 = bias_ptr + oc;
         int t = 0;
@@ -419,8 +419,8 @@ void shl_rvv_ncxhwx_gemm_12xpack2n_fp16(__fp16 *dst, const __fp16 *sa, const __f
 
     int oc = 0;
     for (; oc + pack2n - 1 < m; oc += pack2n) {
-        __fp16 *output0 = output_data + oc * n;  // 16 channel dot output
-        __fp16 *output1 = output0 + packn * n;
+        __fp16 *output0 = output_data + oc * ldc;  // 16 channel dot output
+        __fp16 *output1 = output0 + packn * ldc;
         const __fp16 *img0 = input_data;
         const __fp16 *b0 = bias_ptr + oc;
         int t = 0;
@@ -658,7 +658,7 @@ void shl_rvv_ncxhwx_gemm_12xpack2n_fp16(__fp16 *dst, const __fp16 *sa, const __f
     }
 
     for (; oc + packn - 1 < m; oc += packn) {
-        __fp16 *output0 = output_data + oc * n;  // 8 channel dot output
+        __fp16 *output0 = output_data + oc * ldc;  // 8 channel dot output
         const __fp16 *img0 = input_data;
         const __fp16 *b0 = bias_ptr + oc;
         int t = 0;
@@ -799,7 +799,7 @@ void shl_rvv_ncxhwx_gemm_12xpack2n_fp16(__fp16 *dst, const __fp16 *sa, const __f
     /* tail output_channel */
     if (oc < m) {
         vl = vsetvl_e16m1(m - oc);
-        __fp16 *output0 = output_data + oc * n;  // 8 channel dot output
+        __fp16 *output0 = output_data + oc * ldc;  // 8 channel dot output
         const __fp16 *img0 = input_data;
         const __fp16 *b0 = bias_ptr + oc;
         int t = 0;
@@ -52,8 +52,8 @@ void shl_rvv_ncxhwx_gemm_8xpack2n_fp32(float *dst, const float *sa, const float
 
     int oc = 0;
     for (; oc + pack2n - 1 < m; oc += pack2n) {
-        float *output0 = output_data + oc * n;  // 8 channel dot output
-        float *output1 = output0 + packn * n;
+        float *output0 = output_data + oc * ldc;  // 8 channel dot output
+        float *output1 = output0 + packn * ldc;
         const float *img0 = input_data;
         const float *b0 = bias_ptr + oc;
         int t = 0;
@@ -205,7 +205,7 @@ void shl_rvv_ncxhwx_gemm_8xpack2n_fp32(float *dst, const float *sa, const float
     }
 
     for (; oc + packn - 1 < m; oc += packn) {
-        float *output0 = output_data + oc * n;  // 4 channel dot output
+        float *output0 = output_data + oc * ldc;  // 4 channel dot output
         const float *img0 = input_data;
         const float *b0 = bias_ptr + oc;
         int t = 0;
@@ -299,7 +299,7 @@ void shl_rvv_ncxhwx_gemm_8xpack2n_fp32(float *dst, const float *sa, const float
     /* tail output_channel */
     if (oc < m) {
         vl = vsetvl_e32m1(m - oc);
-        float *output0 = output_data + oc * n;  // 4 channel dot output
+        float *output0 = output_data + oc * ldc;  // 4 channel dot output
         const float *img0 = input_data;
         const float *b0 = bias_ptr + oc;
         int t = 0;
@@ -421,8 +421,8 @@ void shl_rvv_ncxhwx_gemm_12xpack2n_fp32(float *dst, const float *sa, const float
 
     int oc = 0;
     for (; oc + pack2n - 1 < m; oc += pack2n) {
-        float *output0 = output_data + oc * n;  // 8 channel dot output
-        float *output1 = output0 + packn * n;
+        float *output0 = output_data + oc * ldc;  // 8 channel dot output
+        float *output1 = output0 + packn * ldc;
         const float *img0 = input_data;
         const float *b0 = bias_ptr + oc;
         int t = 0;
@@ -660,7 +660,7 @@ void shl_rvv_ncxhwx_gemm_12xpack2n_fp32(float *dst, const float *sa, const float
     }
 
     for (; oc + packn - 1 < m; oc += packn) {
-        float *output0 = output_data + oc * n;  // 4 channel dot output
+        float *output0 = output_data + oc * ldc;  // 4 channel dot output
         const float *img0 = input_data;
         const float *b0 = bias_ptr + oc;
         int t = 0;
@@ -801,7 +801,7 @@ void shl_rvv_ncxhwx_gemm_12xpack2n_fp32(float *dst, const float *sa, const float
     /* tail output_channel */
     if (oc < m) {
         vl = vsetvl_e32m1(m - oc);
-        float *output0 = output_data + oc * n;  // tial channel dot output
+        float *output0 = output_data + oc * ldc;  // tial channel dot output
         const float *img0 = input_data;
         const float *b0 = bias_ptr + oc;
         int t = 0;
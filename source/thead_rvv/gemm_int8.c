@@ -20,13 +20,18 @@
 
 #include "shl_thead_rvv.h"
 #ifdef XTHEADV
+/*************************************************************
+ * requantize in registers before the store: the widening product is rounded
+ * once by vnclip with 31 - shift, instead of vmulh truncating the low half
+ * before the rounding shift
+ *************************************************************/
 static vint8mf2_t requantize_m2(vint32m2_t _src, int32_t multiplier, int32_t shift, int32_t out_zp,
                                 int vl)
 {
-    vint32m2_t _mulh = vmulh_vx_i32m2(_src, multiplier, vl);
-    _mulh = vssra_vx_i32m2(_mulh, -shift - 1, vl);
-    _mulh = vadd_vx_i32m2(_mulh, out_zp, vl);
-    vint16m1_t _tmp1 = vnclip_wx_i16m1(_mulh, 0, vl);
+    vint64m4_t _mulw = vwmul_vx_i64m4(_src, multiplier, vl);
+    vint32m2_t _res = vnclip_wx_i32m2(_mulw, 31 - shift, vl);
+    _res = vsadd_vx_i32m2(_res, out_zp, vl);
+    vint16m1_t _tmp1 = vnclip_wx_i16m1(_res, 0, vl);
     vint8mf2_t _tmp2 = vnclip_wx_i8mf2(_tmp1, 0, vl);
     return _tmp2;
 }
@@ -34,22 +39,20 @@ static vint8mf2_t requantize_m2(vint32m2_t _src, int32_t multiplier, int32_t shi
 static vint8mf4_t requantize_m1(vint32m1_t _src, int32_t multiplier, int32_t shift, int32_t out_zp,
                                 int vl)
 {
-    vint32m1_t _mulh = vmulh_vx_i32m1(_src, multiplier, vl);
-    _mulh = vssra_vx_i32m1(_mulh, -shift - 1, vl);
-    _mulh = vadd_vx_i32m1(_mulh, out_zp, vl);
-    vint16mf2_t _tmp1 = vnclip_wx_i16mf2(_mulh, 0, vl);
+    vint64m2_t _mulw = vwmul_vx_i64m2(_src, multiplier, vl);
+    vint32m1_t _res = vnclip_wx_i32m1(_mulw, 31 - shift, vl);
+    _res = vsadd_vx_i32m1(_res, out_zp, vl);
+    vint16mf2_t _tmp1 = vnclip_wx_i16mf2(_res, 0, vl);
     vint8mf4_t _tmp2 = vnclip_wx_i8mf4(_tmp1, 0, vl);
     return _tmp2;
 }
 
+/* scalar tail, rounds half up like vnclip with the default vxrm */
 static int8_t requantize_single(int32_t src, int32_t multiplier, int32_t shift, int32_t out_zp)
 {
-    int64_t src_64 = (int64_t)src;
-    int64_t mult_64 = (int64_t)multiplier;
-    int64_t mulw = src * multiplier;
-    int32_t nudge = mulw >= 0 ? (1 << 30) : (1 - (1 << 30));
-    int32_t mulh = (int32_t)((mulw + nudge) / (1ll << 31));
-    int32_t res = mulh >> (-shift);
+    int64_t mulw = (int64_t)src * multiplier;
+    int32_t rshift = 31 - shift;
+    int64_t res = (mulw + (1ll << (rshift - 1))) >> rshift;
     res += out_zp;
     if (res > 127) res = 127;
     if (res < -128) res = -128;
@@ -61,11 +64,11 @@ static vint8mf2_t requantize_m2_s(vint32m2_t _src, int32_t *multiplier, int32_t
 {
     vint32m2_t _mult = vle32_v_i32m2(multiplier, vl);
     vint32m2_t _shift = vle32_v_i32m2(shift, vl);
-    vint32m2_t _mulh = vmulh_vv_i32m2(_src, _mult, vl);
-    _shift = vrsub_vx_i32m2(_shift, -1, vl);
-    _mulh = vssra_vv_i32m2(_mulh, vreinterpret_v_i32m2_u32m2(_shift), vl);
-    _mulh = vadd_vx_i32m2(_mulh, out_zp, vl);
-    vint16m1_t _tmp1 = vnclip_wx_i16m1(_mulh, 0, vl);
+    vint64m4_t _mulw = vwmul_vv_i64m4(_src, _mult, vl);
+    _shift = vrsub_vx_i32m2(_shift, 31, vl);
+    vint32m2_t _res = vnclip_wv_i32m2(_mulw, vreinterpret_v_i32m2_u32m2(_shift), vl);
+    _res = vsadd_vx_i32m2(_res, out_zp, vl);
+    vint16m1_t _tmp1 = vnclip_wx_i16m1(_res, 0, vl);
     vint8mf2_t _tmp2 = vnclip_wx_i8mf2(_tmp1, 0, vl);
     return _tmp2;
 }
@@ -75,11 +78,11 @@ static vint8mf4_t requantize_m1_s(vint32m1_t _src, int32_t *multiplier, int32_t
 {
     vint32m1_t _mult = vle32_v_i32m1(multiplier, vl);
     vint32m1_t _shift = vle32_v_i32m1(shift, vl);
-    vint32m1_t _mulh = vmulh_vv_i32m1(_src, _mult, vl);
-    _shift = vrsub_vx_i32m1(_shift, -1, vl);
-    _mulh = vssra_vv_i32m1(_mulh, vreinterpret_v_i32m1_u32m1(_shift), vl);
-    _mulh = vadd_vx_i32m1(_mulh, out_zp, vl);
-    vint16mf2_t _tmp1 = vnclip_wx_i16mf2(_mulh, 0, vl);
+    vint64m2_t _mulw = vwmul_vv_i64m2(_src, _mult, vl);
+    _shift = vrsub_vx_i32m1(_shift, 31, vl);
+    vint32m1_t _res = vnclip_wv_i32m1(_mulw, vreinterpret_v_i32m1_u32m1(_shift), vl);
+    _res = vsadd_vx_i32m1(_res, out_zp, vl);
+    vint16mf2_t _tmp1 = vnclip_wx_i16mf2(_res, 0, vl);
     vint8mf4_t _tmp2 = vnclip_wx_i8mf4(_tmp1, 0, vl);
     return _tmp2;
 }
@@ -25,14 +25,18 @@
  * input matrix and kernel matrix have been reordered
  *************************************************************/
 
-// shift 已经处理
+/*************************************************************
+ * requantize in registers before the single store, _shift is prepared once
+ * per channel block as 31 - shift: the widening product is rounded once by
+ * vnclip, instead of vmulh truncating the low half before the rounding shift
+ *************************************************************/
 static vint8mf2_t requantize_m2_s(vint32m2_t _src, vint32m2_t _multiplier, vint32m2_t _shift,
                                   int32_t out_zp, int vl)
 {
-    vint32m2_t _mulh = vmulh_vv_i32m2(_src, _multiplier, vl);
-    _mulh = vssra_vv_i32m2(_mulh, vreinterpret_v_i32m2_u32m2(_shift), vl);
-    _mulh = vadd_vx_i32m2(_mulh, out_zp, vl);
-    vint16m1_t _tmp1 = vnclip_wx_i16m1(_mulh, 0, vl);
+    vint64m4_t _mulw = vwmul_vv_i64m4(_src, _multiplier, vl);
+    vint32m2_t _res = vnclip_wv_i32m2(_mulw, vreinterpret_v_i32m2_u32m2(_shift), vl);
+    _res = vsadd_vx_i32m2(_res, out_zp, vl);
+    vint16m1_t _tmp1 = vnclip_wx_i16m1(_res, 0, vl);
     vint8mf2_t _tmp2 = vnclip_wx_i8mf2(_tmp1, 0, vl);
     return _tmp2;
 }
@@ -59,9 +63,9 @@ void shl_rvv_ncxhwx_gemm_12xpackn_int8(int8_t *dst, const int8_t *sa, const int8
     for (; oc + packn - 1 < m; oc += packn) {
         vint32m2_t _mult = vle32_v_i32m2(mult + oc, vl);
         vint32m2_t _shift = vle32_v_i32m2(shift + oc, vl);
-        _shift = vrsub_vx_i32m2(_shift, -1, vl);
+        _shift = vrsub_vx_i32m2(_shift, 31, vl);
 
-        int8_t *output0 = output_data + oc * n;
+        int8_t *output0 = output_data + oc * ldc;
         const int32_t *img0 = (const int32_t *)input_data;
         const int32_t *b0 = bias_data + oc;
 
@@ -241,9 +245,9 @@ void shl_rvv_ncxhwx_gemm_12xpackn_int8(int8_t *dst, const int8_t *sa, const int8
         vl = vsetvl_e32m2(m - oc);
         vint32m2_t _mult = vle32_v_i32m2(mult + oc, vl);
         vint32m2_t _shift = vle32_v_i32m2(shift + oc, vl);
-        _shift = vrsub_vx_i32m2(_shift, -1, vl);
+        _shift = vrsub_vx_i32m2(_shift, 31, vl);
 
-        int8_t *output0 = output_data + oc * n;
+        int8_t *output0 = output_data + oc * ldc;
         const int32_t *img0 = (const int32_t *)input_data;
         const int32_t *b0 = bias_data + oc;
 
@@ -441,9 +445,9 @@ void shl_rvv_ncxhwx_gemm_8xpackn_int8(int8_t *dst, const int8_t *sa, const int8_
     for (; oc + packn - 1 < m; oc += packn) {
         vint32m2_t _mult = vle32_v_i32m2(mult + oc, vl);
         vint32m2_t _shift = vle32_v_i32m2(shift + oc, vl);
-        _shift = vrsub_vx_i32m2(_shift, -1, vl);
+        _shift = vrsub_vx_i32m2(_shift, 31, vl);
 
-        int8_t *output0 = output_data + oc * n;
+        int8_t *output0 = output_data + oc * ldc;
         const int32_t *img0 = (const int32_t *)input_data;
         const int32_t *b0 = bias_data + oc;
 
@@ -562,9 +566,9 @@ void shl_rvv_ncxhwx_gemm_8xpackn_int8(int8_t *dst, const int8_t *sa, const int8_
         vl = vsetvl_e32m2(m - oc);
         vint32m2_t _mult = vle32_v_i32m2(mult + oc, vl);
         vint32m2_t _shift = vle32_v_i32m2(shift + oc, vl);
-        _shift = vrsub_vx_i32m2(_shift, -1, vl);
+        _shift = vrsub_vx_i32m2(_shift, 31, vl);
 
-        int8_t *output0 = output_data + oc * n;
+        int8_t *output0 = output_data + oc * ldc;
         const int32_t *img0 = (const int32_t *)input_data;
         const int32_t *b0 = bias_data + oc;
 
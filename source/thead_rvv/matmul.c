@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_thead_rvv.h"
+
+/*************************************************************************************
+ * int8 matmul, C = (A - za) * (B - zb)
+ * A is [m, k] and B is [k, n] after the transpose flags are resolved. Each step of k
+ * widens one row of B to int16 and multiply-accumulates it into int32 for four rows
+ * of A. The zero points come back in from the row sums of A and the column sums of B:
+ *   C[i][j] = sum(A * B) - zb * rowsum(A)[i] - za * colsum(B)[j] + k * za * zb
+ ************************************************************************************/
+
+/* dst[cols][rows] = src[rows][cols] */
+void shl_rvv_transpose_int8(const int8_t *src, int8_t *dst, int rows, int cols)
+{
+    for (int c = 0; c < cols; c++) {
+        const int8_t *in_ptr = src + c;
+        int r = 0;
+        while (r < rows) {
+            int vl = vsetvl_e8m4(rows - r);
+            vint8m4_t _in = vlse8_v_i8m4(in_ptr + r * cols, cols * sizeof(int8_t), vl);
+            vse8_v_i8m4(dst, _in, vl);
+            dst += vl;
+            r += vl;
+        }
+    }
+}
+
+/* corr[j] = k * za * zb - za * colsum(B)[j] */
+static void matmul_col_corr_int8(const int8_t *b, int32_t *corr, int k, int n, int32_t za,
+                                 int32_t zb)
+{
+    int j = 0;
+    while (j < n) {
+        int vl = vsetvl_e32m4(n - j);
+        vint32m4_t _sum = vmv_v_x_i32m4(0, vl);
+        const int8_t *b_ptr = b + j;
+        for (int c = 0; c < k; c++) {
+            vint16m2_t _b = vsext_vf2_i16m2(vle8_v_i8m1(b_ptr, vl), vl);
+            _sum = vwadd_wv_i32m4(_sum, _b, vl);
+            b_ptr += n;
+        }
+        _sum = vmul_vx_i32m4(_sum, -za, vl);
+        _sum = vadd_vx_i32m4(_sum, k * za * zb, vl);
+        vse32_v_i32m4(corr + j, _sum, vl);
+        j += vl;
+    }
+}
+
+/* corr[i] = zb * rowsum(A)[i] */
+static void matmul_row_corr_int8(const int8_t *a, int32_t *corr, int m, int k, int32_t zb)
+{
+    for (int i = 0; i < m; i++) {
+        int32_t sum = 0;
+        for (int c = 0; c < k; c++) {
+            sum += a[i * k + c];
+        }
+        corr[i] = zb * sum;
+    }
+}
+
+static inline void matmul_store_int8(vint32m4_t _acc, int8_t *dst, int32_t multiplier,
+                                     int32_t shift, int32_t out_zp, int vl)
+{
+    vint64m8_t _mulw = vwmul_vx_i64m8(_acc, multiplier, vl);
+    vint32m4_t _res = vnclip_wx_i32m4(_mulw, 31 - shift, vl);
+    _res = vsadd_vx_i32m4(_res, out_zp, vl);
+    vint16m2_t _res16 = vnclip_wx_i16m2(_res, 0, vl);
+    vse8_v_i8m1(dst, vnclip_wx_i8m1(_res16, 0, vl), vl);
+}
+
+static inline void matmul_store(vint32m4_t _acc, void *dst, int offset, bool out_int32,
+                                int32_t multiplier, int32_t shift, int32_t out_zp, int vl)
+{
+    if (out_int32) {
+        vse32_v_i32m4((int32_t *)dst + offset, _acc, vl);
+    } else {
+        matmul_store_int8(_acc, (int8_t *)dst + offset, multiplier, shift, out_zp, vl);
+    }
+}
+
+static void matmul_kernel_int8(const int8_t *a, const int8_t *b, void *dst, const int32_t *row_corr,
+                               const int32_t *col_corr, int m, int k, int n, bool out_int32,
+                               int32_t multiplier, int32_t shift, int32_t out_zp)
+{
+    int i = 0;
+    for (; i + 3 < m; i += 4) {
+        const int8_t *a0 = a + i * k;
+        const int8_t *a1 = a0 + k;
+        const int8_t *a2 = a1 + k;
+        const int8_t *a3 = a2 + k;
+        int j = 0;
+        while (j < n) {
+            int vl = vsetvl_e32m4(n - j);
+            vint32m4_t _corr = vle32_v_i32m4(col_corr + j, vl);
+            vint32m4_t _acc0 = vsub_vx_i32m4(_corr, row_corr[i], vl);
+            vint32m4_t _acc1 = vsub_vx_i32m4(_corr, row_corr[i + 1], vl);
+            vint32m4_t _acc2 = vsub_vx_i32m4(_corr, row_corr[i + 2], vl);
+            vint32m4_t _acc3 = vsub_vx_i32m4(_corr, row_corr[i + 3], vl);
+            const int8_t *b_ptr = b + j;
+            for (int c = 0; c < k; c++) {
+                vint16m2_t _b = vsext_vf2_i16m2(vle8_v_i8m1(b_ptr, vl), vl);
+                _acc0 = vwmacc_vx_i32m4(_acc0, a0[c], _b, vl);
+                _acc1 = vwmacc_vx_i32m4(_acc1, a1[c], _b, vl);
+                _acc2 = vwmacc_vx_i32m4(_acc2, a2[c], _b, vl);
+                _acc3 = vwmacc_vx_i32m4(_acc3, a3[c], _b, vl);
+                b_ptr += n;
+            }
+            matmul_store(_acc0, dst, i * n + j, out_int32, multiplier, shift, out_zp, vl);
+            matmul_store(_acc1, dst, (i + 1) * n + j, out_int32, multiplier, shift, out_zp, vl);
+            matmul_store(_acc2, dst, (i + 2) * n + j, out_int32, multiplier, shift, out_zp, vl);
+            matmul_store(_acc3, dst, (i + 3) * n + j, out_int32, multiplier, shift, out_zp, vl);
+            j += vl;
+        }
+    }
+    for (; i < m; i++) {
+        const int8_t *a0 = a + i * k;
+        int j = 0;
+        while (j < n) {
+            int vl = vsetvl_e32m4(n - j);
+            vint32m4_t _acc0 = vle32_v_i32m4(col_corr + j, vl);
+            _acc0 = vsub_vx_i32m4(_acc0, row_corr[i], vl);
+            const int8_t *b_ptr = b + j;
+            for (int c = 0; c < k; c++) {
+                vint16m2_t _b = vsext_vf2_i16m2(vle8_v_i8m1(b_ptr, vl), vl);
+                _acc0 = vwmacc_vx_i32m4(_acc0, a0[c], _b, vl);
+                b_ptr += n;
+            }
+            matmul_store(_acc0, dst, i * n + j, out_int32, multiplier, shift, out_zp, vl);
+            j += vl;
+        }
+    }
+}
+
+int shl_rvv_matmul_init(struct csinn_tensor *mat0, struct csinn_tensor *mat1,
+                        struct csinn_tensor *output, struct csinn_matmul_params *params)
+{
+    struct csinn_callback *cb = params->base.cb;
+    bool out_supported = output->dtype == CSINN_DTYPE_INT8 || output->dtype == CSINN_DTYPE_INT32;
+    if (mat0->dtype != CSINN_DTYPE_INT8 || mat1->dtype != CSINN_DTYPE_INT8 || !out_supported ||
+        mat0->dim_count != mat1->dim_count || mat1->quant_channel > 1) {
+        cb->exec = shl_ref_matmul_quant;
+        return CSINN_TRUE;
+    }
+
+    // a constant B is transposed once here instead of on every run
+    const int dims_count = mat1->dim_count;
+    if (params->trans_b && mat1->is_const && dims_count == 2) {
+        int n = mat1->dim[0];
+        int k = mat1->dim[1];
+        int8_t *data = (int8_t *)shl_mem_alloc(n * k * sizeof(int8_t));
+        shl_rvv_transpose_int8(mat1->data, data, n, k);
+        memcpy(mat1->data, data, n * k * sizeof(int8_t));
+        shl_mem_free(data);
+        mat1->dim[0] = k;
+        mat1->dim[1] = n;
+        params->trans_b = false;
+    }
+    cb->exec = shl_rvv_matmul_int8;
+    return CSINN_TRUE;
+}
+
+int shl_rvv_matmul_int8(struct csinn_tensor *mat0, struct csinn_tensor *mat1,
+                        struct csinn_tensor *output, struct csinn_matmul_params *params)
+{
+    int8_t *mat0_data = (int8_t *)mat0->data;
+    int8_t *mat1_data = (int8_t *)mat1->data;
+    int8_t *output_data = (int8_t *)output->data;
+    const int dims_count = mat0->dim_count;
+    int batches = 1;
+
+    /* compute the outer size */
+    for (int i = 0; i < dims_count - 2; i++) {
+        batches *= mat0->dim[i];
+    }
+
+    const int dim_m = mat0->dim[dims_count - (params->trans_a ? 1 : 2)];
+    const int dim_k = mat0->dim[dims_count - (params->trans_a ? 2 : 1)];
+    const int dim_n = mat1->dim[dims_count - (params->trans_b ? 2 : 1)];
+    const int32_t za = mat0->qinfo->zero_point;
+    const int32_t zb = mat1->qinfo->zero_point;
+    const bool out_int32 = output->dtype == CSINN_DTYPE_INT32;
+    const int out_size = out_int32 ? sizeof(int32_t) : sizeof(int8_t);
+
+    int32_t multiplier = 0, shift = 0, out_zp = 0;
+    if (!out_int32) {
+        float real_scale = mat0->qinfo->scale * mat1->qinfo->scale / output->qinfo->scale;
+        shl_quantize_multiplier(real_scale, &multiplier, &shift);
+        out_zp = output->qinfo->zero_point;
+    }
+
+    int8_t *a_buf = params->trans_a ? shl_mem_alloc(dim_m * dim_k * sizeof(int8_t)) : NULL;
+    int8_t *b_buf = params->trans_b ? shl_mem_alloc(dim_k * dim_n * sizeof(int8_t)) : NULL;
+    int32_t *row_corr = (int32_t *)shl_mem_alloc(dim_m * sizeof(int32_t));
+    int32_t *col_corr = (int32_t *)shl_mem_alloc(dim_n * sizeof(int32_t));
+
+    for (int b = 0; b < batches; b++) {
+        const int8_t *a = mat0_data + b * dim_m * dim_k;
+        const int8_t *bm = mat1_data + b * dim_k * dim_n;
+        if (params->trans_a) {
+            shl_rvv_transpose_int8(a, a_buf, dim_k, dim_m);
+            a = a_buf;
+        }
+        if (params->trans_b) {
+            shl_rvv_transpose_int8(bm, b_buf, dim_n, dim_k);
+            bm = b_buf;
+        }
+        matmul_row_corr_int8(a, row_corr, dim_m, dim_k, zb);
+        matmul_col_corr_int8(bm, col_corr, dim_k, dim_n, za, zb);
+        matmul_kernel_int8(a, bm, output_data + b * dim_m * dim_n * out_size, row_corr, col_corr,
+                           dim_m, dim_k, dim_n, out_int32, multiplier, shift, out_zp);
+    }
+
+    shl_mem_free(a_buf);
+    shl_mem_free(b_buf);
+    shl_mem_free(row_corr);
+    shl_mem_free(col_corr);
+    return CSINN_TRUE;
+}
@@ -92,6 +92,12 @@ int shl_rvv_maxpool2d_init_fp32(struct csinn_tensor *input, struct csinn_tensor
             }
         }
     }
+
+    // any other window / stride / padding / ceil_mode
+    if (cb->exec == NULL && in_c % packn == 0) {
+        cb->exec = shl_rvv_maxpool2d_packn_fp32;
+    }
+
     if (cb->exec == NULL) {
         shl_debug_warning(
             "maxpool is not optimized to achieve under this condition on rvv, call reference func "
@@ -173,6 +179,12 @@ int shl_rvv_maxpool2d_init_fp16(struct csinn_tensor *input, struct csinn_tensor
             }
         }
     }
+
+    // any other window / stride / padding / ceil_mode
+    if (cb->exec == NULL && in_c % packn == 0) {
+        cb->exec = shl_rvv_maxpool2d_packn_fp16;
+    }
+
     if (cb->exec == NULL) {
         shl_debug_warning(
             "maxpool is not optimized to achieve under this condition on rvv, call reference func "
@@ -254,6 +266,12 @@ int shl_rvv_maxpool2d_init_int8(struct csinn_tensor *input, struct csinn_tensor
             }
         }
     }
+
+    // any other window / stride / padding / ceil_mode
+    if (cb->exec == NULL && in_c % packn == 0) {
+        cb->exec = shl_rvv_maxpool2d_packn_int8;
+    }
+
     if (cb->exec == NULL) {
         shl_debug_warning(
             "maxpool is not optimized to achieve under this condition on rvv, call reference func "
@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_thead_rvv.h"
+
+/* clip the window of output index o to [0, in), return 1 if any of it falls into the padding */
+static inline int maxpool_window(int o, int stride, int pad, int kernel, int in, int *start,
+                                 int *end)
+{
+    int s = o * stride - pad;
+    int e = s + kernel;
+    *start = s > 0 ? s : 0;
+    *end = e < in ? e : in;
+    return s < 0 || e > in;
+}
+
+/*************************************************************
+ * note: support flexible vlen
+ * generic kernel / stride / padding / ceil_mode in packn layout.
+ * separable max: a row pass takes the max over kernel_w into a [in_h, out_w] buffer, then a
+ * column pass takes the max over kernel_h, so each output costs kernel_h + kernel_w loads
+ * instead of kernel_h * kernel_w. The window is clipped to the input, and a window reaching
+ * into the padding also takes the max with the zero padding, the same as the reference.
+ *************************************************************/
+int shl_rvv_maxpool2d_packn_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                                 struct csinn_pool_params *params)
+{
+    float *input_data = (float *)input->data;
+    float *output_data = (float *)output->data;
+
+    int batch = input->dim[0];
+    int in_c = input->dim[1];
+    int in_h = input->dim[2];
+    int in_w = input->dim[3];
+    int input_size = in_c * in_h * in_w;
+
+    int out_h = output->dim[2];
+    int out_w = output->dim[3];
+    int output_size = in_c * out_h * out_w;
+
+    const int packn = csrr_vlenb() / sizeof(float);
+    const int vl = vsetvl_e32m1(packn);
+
+    float *row_max = (float *)shl_mem_alloc(in_h * out_w * packn * sizeof(float));
+
+    for (int b = 0; b < batch; b++) {
+        for (int c = 0; c + packn - 1 < in_c; c += packn) {
+            const float *in0 = input_data + c * in_h * in_w;
+            float *out0 = output_data + c * out_h * out_w;
+
+            // row pass: [in_h, in_w] -> [in_h, out_w]
+            float *rmax = row_max;
+            for (int h = 0; h < in_h; h++) {
+                const float *line = in0 + h * in_w * packn;
+                for (int w = 0; w < out_w; w++) {
+                    int start, end;
+                    int pad = maxpool_window(w, params->stride_width, params->pad_left,
+                                             params->filter_width, in_w, &start, &end);
+                    vfloat32m1_t _max = vfmv_v_f_f32m1(pad ? 0.0f : -FLT_MAX, vl);
+                    for (int i = start; i < end; i++) {
+                        _max = vfmax_vv_f32m1(_max, vle32_v_f32m1(line + i * packn, vl), vl);
+                    }
+                    vse32_v_f32m1(rmax, _max, vl);
+                    rmax += packn;
+                }
+            }
+
+            // column pass: [in_h, out_w] -> [out_h, out_w]
+            for (int h = 0; h < out_h; h++) {
+                int start, end;
+                int pad = maxpool_window(h, params->stride_height, params->pad_top,
+                                         params->filter_height, in_h, &start, &end);
+                for (int w = 0; w < out_w; w++) {
+                    const float *col = row_max + w * packn;
+                    vfloat32m1_t _max = vfmv_v_f_f32m1(pad ? 0.0f : -FLT_MAX, vl);
+                    for (int i = start; i < end; i++) {
+                        _max = vfmax_vv_f32m1(_max, vle32_v_f32m1(col + i * out_w * packn, vl), vl);
+                    }
+                    vse32_v_f32m1(out0, _max, vl);
+                    out0 += packn;
+                }
+            }
+        }
+        input_data += input_size;
+        output_data += output_size;
+    }
+    shl_mem_free(row_max);
+    return CSINN_TRUE;
+}
+
+int shl_rvv_maxpool2d_packn_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                                 struct csinn_pool_params *params)
+{
+    __fp16 *input_data = (__fp16 *)input->data;
+    __fp16 *output_data = (__fp16 *)output->data;
+
+    int batch = input->dim[0];
+    int in_c = input->dim[1];
+    int in_h = input->dim[2];
+    int in_w = input->dim[3];
+    int input_size = in_c * in_h * in_w;
+
+    int out_h = output->dim[2];
+    int out_w = output->dim[3];
+    int output_size = in_c * out_h * out_w;
+
+    const int packn = csrr_vlenb() / sizeof(__fp16);
+    const int vl = vsetvl_e16m1(packn);
+
+    __fp16 *row_max = (__fp16 *)shl_mem_alloc(in_h * out_w * packn * sizeof(__fp16));
+
+    for (int b = 0; b < batch; b++) {
+        for (int c = 0; c + packn - 1 < in_c; c += packn) {
+            const __fp16 *in0 = input_data + c * in_h * in_w;
+            __fp16 *out0 = output_data + c * out_h * out_w;
+
+            // row pass: [in_h, in_w] -> [in_h, out_w]
+            __fp16 *rmax = row_max;
+            for (int h = 0; h < in_h; h++) {
+                const __fp16 *line = in0 + h * in_w * packn;
+                for (int w = 0; w < out_w; w++) {
+                    int start, end;
+                    int pad = maxpool_window(w, params->stride_width, params->pad_left,
+                                             params->filter_width, in_w, &start, &end);
+                    vfloat16m1_t _max = vfmv_v_f_f16m1(pad ? 0.0f : -65504.0f, vl);
+                    for (int i = start; i < end; i++) {
+                        _max = vfmax_vv_f16m1(_max, vle16_v_f16m1(line + i * packn, vl), vl);
+                    }
+                    vse16_v_f16m1(rmax, _max, vl);
+                    rmax += packn;
+                }
+            }
+
+            // column pass: [in_h, out_w] -> [out_h, out_w]
+            for (int h = 0; h < out_h; h++) {
+                int start, end;
+                int pad = maxpool_window(h, params->stride_height, params->pad_top,
+                                         params->filter_height, in_h, &start, &end);
+                for (int w = 0; w < out_w; w++) {
+                    const __fp16 *col = row_max + w * packn;
+                    vfloat16m1_t _max = vfmv_v_f_f16m1(pad ? 0.0f : -65504.0f, vl);
+                    for (int i = start; i < end; i++) {
+                        _max = vfmax_vv_f16m1(_max, vle16_v_f16m1(col + i * out_w * packn, vl), vl);
+                    }
+                    vse16_v_f16m1(out0, _max, vl);
+                    out0 += packn;
+                }
+            }
+        }
+        input_data += input_size;
+        output_data += output_size;
+    }
+    shl_mem_free(row_max);
+    return CSINN_TRUE;
+}
+
+/* max keeps the order of the raw values, int8 pads with zero_point */
+int shl_rvv_maxpool2d_packn_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                 struct csinn_pool_params *params)
+{
+#ifdef RVV_1_0_0
+    int8_t *input_data = (int8_t *)input->data;
+    int8_t *output_data = (int8_t *)output->data;
+
+    int batch = input->dim[0];
+    int in_c = input->dim[1];
+    int in_h = input->dim[2];
+    int in_w = input->dim[3];
+    int input_size = in_c * in_h * in_w;
+
+    int out_h = output->dim[2];
+    int out_w = output->dim[3];
+    int output_size = in_c * out_h * out_w;
+
+    const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
+    const int vl = vsetvl_e8mf2(packn);
+    const int8_t pad_value = (int8_t)input->qinfo->zero_point;
+
+    int8_t *row_max = (int8_t *)shl_mem_alloc(in_h * out_w * packn * sizeof(int8_t));
+
+    for (int b = 0; b < batch; b++) {
+        for (int c = 0; c + packn - 1 < in_c; c += packn) {
+            const int8_t *in0 = input_data + c * in_h * in_w;
+            int8_t *out0 = output_data + c * out_h * out_w;
+
+            // row pass: [in_h, in_w] -> [in_h, out_w]
+            int8_t *rmax = row_max;
+            for (int h = 0; h < in_h; h++) {
+                const int8_t *line = in0 + h * in_w * packn;
+                for (int w = 0; w < out_w; w++) {
+                    int start, end;
+                    int pad = maxpool_window(w, params->stride_width, params->pad_left,
+                                             params->filter_width, in_w, &start, &end);
+                    vint8mf2_t _max = vmv_v_x_i8mf2(pad ? pad_value : INT8_MIN, vl);
+                    for (int i = start; i < end; i++) {
+                        _max = vmax_vv_i8mf2(_max, vle8_v_i8mf2(line + i * packn, vl), vl);
+                    }
+                    vse8_v_i8mf2(rmax, _max, vl);
+                    rmax += packn;
+                }
+            }
+
+            // column pass: [in_h, out_w] -> [out_h, out_w]
+            for (int h = 0; h < out_h; h++) {
+                int start, end;
+                int pad = maxpool_window(h, params->stride_height, params->pad_top,
+                                         params->filter_height, in_h, &start, &end);
+                for (int w = 0; w < out_w; w++) {
+                    const int8_t *col = row_max + w * packn;
+                    vint8mf2_t _max = vmv_v_x_i8mf2(pad ? pad_value : INT8_MIN, vl);
+                    for (int i = start; i < end; i++) {
+                        _max = vmax_vv_i8mf2(_max, vle8_v_i8mf2(col + i * out_w * packn, vl), vl);
+                    }
+                    vse8_v_i8mf2(out0, _max, vl);
+                    out0 += packn;
+                }
+            }
+        }
+        input_data += input_size;
+        output_data += output_size;
+    }
+    shl_mem_free(row_max);
+    return CSINN_TRUE;
+#elif defined RVV_0_7_1
+    shl_debug_error("unsupport maxpool2d packn for int8 on rvv_spec 0.7.1\n");
+    return CSINN_FALSE;
+#endif
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_thead_rvv.h"
+
+/*************************************************************
+ * whether box overlaps any kept box by more than iou_threshold
+ * selected: y1 | x1 | y2 | x2 | area planes of stride cap, see shl_ref_nms_overlap_f32
+ *************************************************************/
+static int nms_overlap_fp32(const float *box, const float *selected, int cap, int selected_num,
+                            float iou_threshold)
+{
+    const float *sy1 = selected;
+    const float *sx1 = selected + cap;
+    const float *sy2 = selected + cap * 2;
+    const float *sx2 = selected + cap * 3;
+    const float *sarea = selected + cap * 4;
+    float area = (box[2] - box[0]) * (box[3] - box[1]);
+
+    int i = 0;
+    while (i < selected_num) {
+        int vl = vsetvl_e32m4(selected_num - i);
+        vfloat32m4_t _y1 = vfmax_vf_f32m4(vle32_v_f32m4(sy1 + i, vl), box[0], vl);
+        vfloat32m4_t _x1 = vfmax_vf_f32m4(vle32_v_f32m4(sx1 + i, vl), box[1], vl);
+        vfloat32m4_t _y2 = vfmin_vf_f32m4(vle32_v_f32m4(sy2 + i, vl), box[2], vl);
+        vfloat32m4_t _x2 = vfmin_vf_f32m4(vle32_v_f32m4(sx2 + i, vl), box[3], vl);
+        vfloat32m4_t _h = vfmax_vf_f32m4(vfsub_vv_f32m4(_y2, _y1, vl), 0.0f, vl);
+        vfloat32m4_t _w = vfmax_vf_f32m4(vfsub_vv_f32m4(_x2, _x1, vl), 0.0f, vl);
+        vfloat32m4_t _inter = vfmul_vv_f32m4(_h, _w, vl);
+        vfloat32m4_t _union =
+            vfsub_vv_f32m4(vfadd_vf_f32m4(vle32_v_f32m4(sarea + i, vl), area, vl), _inter, vl);
+        vbool8_t _hit =
+            vmfgt_vv_f32m4_b8(_inter, vfmul_vf_f32m4(_union, iou_threshold, vl), vl);
+        if (vfirst_m_b8(_hit, vl) >= 0) {
+            return 1;
+        }
+        i += vl;
+    }
+    return 0;
+}
+
+/*************************************************************
+ * note: VLEN = 128/256 ... flexible vlen
+ * sort based greedy NMS of the reference with the IoU test vectorised
+ *************************************************************/
+int shl_rvv_non_max_suppression_fp32(struct csinn_tensor *input0, struct csinn_tensor *input1,
+                                     struct csinn_tensor *output,
+                                     struct csinn_non_max_suppression_params *params)
+{
+    return shl_ref_non_max_suppression_base(input0, input1, output, params, nms_overlap_fp32);
+}
@@ -594,7 +594,7 @@ void shl_rvv_reorder_input_z8_int8(int8_t *b, int8_t *sb, int k, int n, int ldx)
             vl = vsetvl_e8m1(k & 15);
             vint8m1_t _tmp = vlse8_v_i8m1(b0, ldx * sizeof(int8_t), vl);
             vse8_v_i8m1(sb, _tmp, vl);
-            sb += ((k & 15) / 4 + 1) * 4;
+            sb += ((k & 15) + 3) / 4 * 4;
         }
     }
 }
@@ -769,7 +769,7 @@ void shl_rvv256_reorder_input_z16_int8(int8_t *b, int8_t *sb, int k, int n, int
             vl = vsetvl_e8m1(k & 15);
             vint8m1_t _tmp = vlse8_v_i8m1(b0, ldx * sizeof(int8_t), vl);
             vse8_v_i8m1(sb, _tmp, vl);
-            sb += ((k & 15) / 4 + 1) * 4;
+            sb += ((k & 15) + 3) / 4 * 4;
         }
     }
 }
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_thead_rvv.h"
+
+/* bicubic and NHWC stay on the reference */
+static bool resize_rvv_check(struct csinn_resize_params *params)
+{
+    return params->base.layout == CSINN_LAYOUT_NCHW &&
+           (params->resize_mode == CSINN_RESIZE_BILINEAR ||
+            params->resize_mode == CSINN_RESIZE_NEAREST_NEIGHBOR);
+}
+
+int shl_rvv_resize_init_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                             struct csinn_resize_params *params)
+{
+    int32_t in_c = input->dim[1];
+    struct csinn_callback *cb = params->base.cb;
+
+    const int packn = csrr_vlenb() / sizeof(float);
+
+    if (!resize_rvv_check(params)) {
+        cb->exec = shl_ref_resize_f32;
+    } else if (in_c % packn == 0) {
+        cb->exec = shl_rvv_resize_packn_fp32;
+    } else {
+        cb->exec = shl_rvv_resize_fp32;
+    }
+    return CSINN_TRUE;
+}
+
+int shl_rvv_resize_init_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                             struct csinn_resize_params *params)
+{
+    int32_t in_c = input->dim[1];
+    struct csinn_callback *cb = params->base.cb;
+
+    const int packn = csrr_vlenb() / sizeof(__fp16);
+
+    if (!resize_rvv_check(params)) {
+        cb->exec = shl_ref_resize_quant;
+    } else if (in_c % packn == 0) {
+        cb->exec = shl_rvv_resize_packn_fp16;
+    } else {
+        cb->exec = shl_rvv_resize_fp16;
+    }
+    return CSINN_TRUE;
+}
+
+int shl_rvv_resize_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                             struct csinn_resize_params *params)
+{
+    int32_t in_c = input->dim[1];
+    struct csinn_callback *cb = params->base.cb;
+
+    const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
+    bool nearest = params->resize_mode == CSINN_RESIZE_NEAREST_NEIGHBOR;
+    bool same_quant = input->qinfo->scale == output->qinfo->scale &&
+                      input->qinfo->zero_point == output->qinfo->zero_point;
+
+    cb->exec = shl_ref_resize_quant;
+    if (!resize_rvv_check(params) || (nearest && !same_quant)) {
+        return CSINN_TRUE;
+    }
+    if (in_c % packn == 0) {
+#ifdef RVV_1_0_0
+        cb->exec = shl_rvv_resize_packn_int8;
+#else
+        cb->exec = nearest ? shl_rvv_resize_packn_int8 : shl_ref_resize_quant;
+#endif
+    } else if (nearest) {
+        cb->exec = shl_rvv_resize_int8;
+    }
+    return CSINN_TRUE;
+}
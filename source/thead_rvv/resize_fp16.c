@@ -0,0 +1,213 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_thead_rvv.h"
+
+/* out = r0 * b0 + r1 * b1, size contiguous elements */
+static void resize_vertical_fp16(const __fp16 *r0, const __fp16 *r1, float b0, float b1,
+                                 __fp16 *out, int size)
+{
+    while (size > 0) {
+        int vl = vsetvl_e16m4(size);
+        vfloat16m4_t _acc = vfmul_vf_f16m4(vle16_v_f16m4(r0, vl), b0, vl);
+        _acc = vfmacc_vf_f16m4(_acc, b1, vle16_v_f16m4(r1, vl), vl);
+        vse16_v_f16m4(out, _acc, vl);
+        r0 += vl;
+        r1 += vl;
+        out += vl;
+        size -= vl;
+    }
+}
+
+/* horizontal pass of one source row, pixel = packn channels, packn = 1 for plain NCHW */
+static void resize_hrow_fp16(const __fp16 *src, __fp16 *dst, int out_w, const int32_t *xofs,
+                             const float *alpha, int packn)
+{
+    if (packn == 1) {
+        for (int x = 0; x < out_w; x++) {
+            dst[x] = src[xofs[2 * x]] * alpha[2 * x] + src[xofs[2 * x + 1]] * alpha[2 * x + 1];
+        }
+        return;
+    }
+    const int vl = vsetvl_e16m1(packn);
+    for (int x = 0; x < out_w; x++) {
+        vfloat16m1_t _p0 = vle16_v_f16m1(src + xofs[2 * x] * packn, vl);
+        vfloat16m1_t _p1 = vle16_v_f16m1(src + xofs[2 * x + 1] * packn, vl);
+        vfloat16m1_t _acc = vfmul_vf_f16m1(_p0, alpha[2 * x], vl);
+        _acc = vfmacc_vf_f16m1(_acc, alpha[2 * x + 1], _p1, vl);
+        vse16_v_f16m1(dst + x * packn, _acc, vl);
+    }
+}
+
+/*************************************************************
+ * bilinear on one plane, pixel = packn channels
+ * source rows only move down, so the two horizontally resampled rows
+ * are kept and shifted instead of being recomputed per output row
+ *************************************************************/
+static void resize_bilinear_plane_fp16(const __fp16 *in, __fp16 *out, int in_w, int out_h,
+                                       int out_w, const int32_t *yofs, const float *beta,
+                                       const int32_t *xofs, const float *alpha, __fp16 *rows0,
+                                       __fp16 *rows1, int packn)
+{
+    int row_size = out_w * packn;
+    int prev_sy = -2;
+    for (int y = 0; y < out_h; y++) {
+        int sy = yofs[2 * y];
+        if (sy == prev_sy + 1) {
+            __fp16 *tmp = rows0;
+            rows0 = rows1;
+            rows1 = tmp;
+            resize_hrow_fp16(in + yofs[2 * y + 1] * in_w * packn, rows1, out_w, xofs, alpha,
+                             packn);
+        } else if (sy != prev_sy) {
+            resize_hrow_fp16(in + sy * in_w * packn, rows0, out_w, xofs, alpha, packn);
+            resize_hrow_fp16(in + yofs[2 * y + 1] * in_w * packn, rows1, out_w, xofs, alpha,
+                             packn);
+        }
+        prev_sy = sy;
+        resize_vertical_fp16(rows0, rows1, beta[2 * y], beta[2 * y + 1], out + y * row_size,
+                             row_size);
+    }
+}
+
+/*************************************************************
+ * nearest on one plane, pixel = packn channels
+ * output rows reading the same source row are copied from the previous one
+ *************************************************************/
+static void resize_nearest_plane_fp16(const __fp16 *in, __fp16 *out, int in_w, int out_h,
+                                      int out_w, const int32_t *yofs, const int32_t *xofs,
+                                      bool up2x, int packn)
+{
+    int row_size = out_w * packn;
+    for (int y = 0; y < out_h; y++) {
+        __fp16 *out_ptr = out + y * row_size;
+        if (y > 0 && yofs[y] == yofs[y - 1]) {
+            memcpy(out_ptr, out_ptr - row_size, row_size * sizeof(__fp16));
+            continue;
+        }
+        const __fp16 *in_ptr = in + yofs[y] * in_w * packn;
+        if (packn == 1 && up2x) {
+            int w = in_w;
+            while (w > 0) {
+                int vl = vsetvl_e16m4(w);
+                vfloat16m4_t _p = vle16_v_f16m4(in_ptr, vl);
+                vsse16_v_f16m4(out_ptr, 2 * sizeof(__fp16), _p, vl);
+                vsse16_v_f16m4(out_ptr + 1, 2 * sizeof(__fp16), _p, vl);
+                in_ptr += vl;
+                out_ptr += 2 * vl;
+                w -= vl;
+            }
+        } else if (packn == 1) {
+            for (int x = 0; x < out_w; x++) {
+                out_ptr[x] = in_ptr[xofs[x]];
+            }
+        } else if (up2x) {
+            const int vl = vsetvl_e16m1(packn);
+            for (int x = 0; x < in_w; x++) {
+                vfloat16m1_t _p = vle16_v_f16m1(in_ptr + x * packn, vl);
+                vse16_v_f16m1(out_ptr, _p, vl);
+                vse16_v_f16m1(out_ptr + packn, _p, vl);
+                out_ptr += 2 * packn;
+            }
+        } else {
+            const int vl = vsetvl_e16m1(packn);
+            for (int x = 0; x < out_w; x++) {
+                vse16_v_f16m1(out_ptr, vle16_v_f16m1(in_ptr + xofs[x] * packn, vl), vl);
+                out_ptr += packn;
+            }
+        }
+    }
+}
+
+static int resize_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                       struct csinn_resize_params *params, int packn)
+{
+    __fp16 *input_data = (__fp16 *)input->data;
+    __fp16 *output_data = (__fp16 *)output->data;
+
+    int32_t planes = input->dim[0] * input->dim[1] / packn;
+    int32_t in_h = input->dim[2];
+    int32_t in_w = input->dim[3];
+    int32_t out_h = output->dim[2];
+    int32_t out_w = output->dim[3];
+    bool align_corners = params->align_corners;
+
+    int64_t in_plane = (int64_t)in_h * in_w * packn;
+    int64_t out_plane = (int64_t)out_h * out_w * packn;
+
+    if (params->resize_mode == CSINN_RESIZE_NEAREST_NEIGHBOR) {
+        int32_t *yofs = (int32_t *)shl_mem_alloc(out_h * sizeof(int32_t));
+        int32_t *xofs = (int32_t *)shl_mem_alloc(out_w * sizeof(int32_t));
+        shl_ref_resize_nearest_table(in_h, out_h, align_corners, yofs);
+        shl_ref_resize_nearest_table(in_w, out_w, align_corners, xofs);
+        bool up2x = !align_corners && out_h == 2 * in_h && out_w == 2 * in_w;
+
+#pragma omp parallel for num_threads(1)
+        for (int p = 0; p < planes; p++) {
+            resize_nearest_plane_fp16(input_data + p * in_plane, output_data + p * out_plane,
+                                      in_w, out_h, out_w, yofs, xofs, up2x, packn);
+        }
+        shl_mem_free(yofs);
+        shl_mem_free(xofs);
+    } else if (params->resize_mode == CSINN_RESIZE_BILINEAR) {
+        int32_t *yofs = (int32_t *)shl_mem_alloc(out_h * 2 * sizeof(int32_t));
+        int32_t *xofs = (int32_t *)shl_mem_alloc(out_w * 2 * sizeof(int32_t));
+        float *beta = (float *)shl_mem_alloc(out_h * 2 * sizeof(float));
+        float *alpha = (float *)shl_mem_alloc(out_w * 2 * sizeof(float));
+        shl_ref_resize_linear_table(in_h, out_h, align_corners, yofs, beta);
+        shl_ref_resize_linear_table(in_w, out_w, align_corners, xofs, alpha);
+        __fp16 *rows = (__fp16 *)shl_mem_alloc(out_w * packn * 2 * sizeof(__fp16));
+
+#pragma omp parallel for num_threads(1)
+        for (int p = 0; p < planes; p++) {
+            resize_bilinear_plane_fp16(input_data + p * in_plane, output_data + p * out_plane,
+                                       in_w, out_h, out_w, yofs, beta, xofs, alpha, rows,
+                                       rows + out_w * packn, packn);
+        }
+        shl_mem_free(yofs);
+        shl_mem_free(xofs);
+        shl_mem_free(beta);
+        shl_mem_free(alpha);
+        shl_mem_free(rows);
+    } else {
+        return CSINN_FALSE;
+    }
+    return CSINN_TRUE;
+}
+
+/*************************************************************
+ * note: VLEN = 128/256 ... flexible vlen
+ * the coordinate tables are built per call, the output shape may change between runs
+ *************************************************************/
+int shl_rvv_resize_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                        struct csinn_resize_params *params)
+{
+    return resize_fp16(input, output, params, 1);
+}
+
+/*************************************************************
+ * constrain: in_c % packn = 0
+ *************************************************************/
+int shl_rvv_resize_packn_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                              struct csinn_resize_params *params)
+{
+    const int packn = csrr_vlenb() / sizeof(__fp16);
+    return resize_fp16(input, output, params, packn);
+}
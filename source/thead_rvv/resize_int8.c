@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_thead_rvv.h"
+
+/*************************************************************
+ * nearest on one plane, pixel = packn channels
+ * output rows reading the same source row are copied from the previous one
+ *************************************************************/
+static void resize_nearest_plane_int8(const int8_t *in, int8_t *out, int in_w, int out_h,
+                                      int out_w, const int32_t *yofs, const int32_t *xofs,
+                                      bool up2x, int packn)
+{
+    int row_size = out_w * packn;
+    for (int y = 0; y < out_h; y++) {
+        int8_t *out_ptr = out + y * row_size;
+        if (y > 0 && yofs[y] == yofs[y - 1]) {
+            memcpy(out_ptr, out_ptr - row_size, row_size * sizeof(int8_t));
+            continue;
+        }
+        const int8_t *in_ptr = in + yofs[y] * in_w * packn;
+        if (packn == 1 && up2x) {
+            int w = in_w;
+            while (w > 0) {
+                int vl = vsetvl_e8m4(w);
+                vint8m4_t _p = vle8_v_i8m4(in_ptr, vl);
+                vsse8_v_i8m4(out_ptr, 2 * sizeof(int8_t), _p, vl);
+                vsse8_v_i8m4(out_ptr + 1, 2 * sizeof(int8_t), _p, vl);
+                in_ptr += vl;
+                out_ptr += 2 * vl;
+                w -= vl;
+            }
+        } else if (packn == 1) {
+            for (int x = 0; x < out_w; x++) {
+                out_ptr[x] = in_ptr[xofs[x]];
+            }
+        } else if (up2x) {
+            const int vl = vsetvl_e8m1(packn);
+            for (int x = 0; x < in_w; x++) {
+                vint8m1_t _p = vle8_v_i8m1(in_ptr + x * packn, vl);
+                vse8_v_i8m1(out_ptr, _p, vl);
+                vse8_v_i8m1(out_ptr + packn, _p, vl);
+                out_ptr += 2 * packn;
+            }
+        } else {
+            const int vl = vsetvl_e8m1(packn);
+            for (int x = 0; x < out_w; x++) {
+                vse8_v_i8m1(out_ptr, vle8_v_i8m1(in_ptr + xofs[x] * packn, vl), vl);
+                out_ptr += packn;
+            }
+        }
+    }
+}
+
+/* nearest only moves elements, input and output share the quantization (checked in init) */
+static int resize_nearest_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                               struct csinn_resize_params *params, int packn)
+{
+    int8_t *input_data = (int8_t *)input->data;
+    int8_t *output_data = (int8_t *)output->data;
+
+    int32_t planes = input->dim[0] * input->dim[1] / packn;
+    int32_t in_h = input->dim[2];
+    int32_t in_w = input->dim[3];
+    int32_t out_h = output->dim[2];
+    int32_t out_w = output->dim[3];
+    bool align_corners = params->align_corners;
+
+    int64_t in_plane = (int64_t)in_h * in_w * packn;
+    int64_t out_plane = (int64_t)out_h * out_w * packn;
+
+    int32_t *yofs = (int32_t *)shl_mem_alloc(out_h * sizeof(int32_t));
+    int32_t *xofs = (int32_t *)shl_mem_alloc(out_w * sizeof(int32_t));
+    shl_ref_resize_nearest_table(in_h, out_h, align_corners, yofs);
+    shl_ref_resize_nearest_table(in_w, out_w, align_corners, xofs);
+    bool up2x = !align_corners && out_h == 2 * in_h && out_w == 2 * in_w;
+
+#pragma omp parallel for num_threads(1)
+    for (int p = 0; p < planes; p++) {
+        resize_nearest_plane_int8(input_data + p * in_plane, output_data + p * out_plane, in_w,
+                                  out_h, out_w, yofs, xofs, up2x, packn);
+    }
+    shl_mem_free(yofs);
+    shl_mem_free(xofs);
+    return CSINN_TRUE;
+}
+
+#ifdef RVV_1_0_0
+/* horizontal pass of one source row, (q - z1) of packn channels widened to fp32 */
+static void resize_hrow_packn_int8(const int8_t *src, float *dst, int out_w, const int32_t *xofs,
+                                   const float *alpha, int8_t in_zp, int packn)
+{
+    const int vl = vsetvl_e8mf2(packn);
+    for (int x = 0; x < out_w; x++) {
+        vint16m1_t _p0 = vwsub_vx_i16m1(vle8_v_i8mf2(src + xofs[2 * x] * packn, vl), in_zp, vl);
+        vint16m1_t _p1 =
+            vwsub_vx_i16m1(vle8_v_i8mf2(src + xofs[2 * x + 1] * packn, vl), in_zp, vl);
+        vfloat32m2_t _acc = vfmul_vf_f32m2(vfwcvt_f_x_v_f32m2(_p0, vl), alpha[2 * x], vl);
+        _acc = vfmacc_vf_f32m2(_acc, alpha[2 * x + 1], vfwcvt_f_x_v_f32m2(_p1, vl), vl);
+        vse32_v_f32m2(dst + x * packn, _acc, vl);
+    }
+}
+
+/* q2 = (r0 * b0 + r1 * b1) * s1 / s2 + z2, the scale ratio folded into b0 and b1 */
+static void resize_vertical_int8(const float *r0, const float *r1, float b0, float b1,
+                                 int32_t out_zp, int8_t *out, int size)
+{
+    while (size > 0) {
+        int vl = vsetvl_e32m4(size);
+        vfloat32m4_t _acc = vfmul_vf_f32m4(vle32_v_f32m4(r0, vl), b0, vl);
+        _acc = vfmacc_vf_f32m4(_acc, b1, vle32_v_f32m4(r1, vl), vl);
+        _acc = vfadd_vf_f32m4(_acc, (float)out_zp, vl);
+        vint16m2_t _out = vfncvt_x_f_w_i16m2(_acc, vl);
+        vse8_v_i8m1(out, vnclip_wx_i8m1(_out, 0, vl), vl);
+        r0 += vl;
+        r1 += vl;
+        out += vl;
+        size -= vl;
+    }
+}
+#endif
+
+/*************************************************************
+ * note: VLEN = 128/256 ... flexible vlen
+ * plain NCHW, nearest only
+ *************************************************************/
+int shl_rvv_resize_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                        struct csinn_resize_params *params)
+{
+    return resize_nearest_int8(input, output, params, 1);
+}
+
+/*************************************************************
+ * constrain: in_c % packn = 0
+ * bilinear interpolates (q - z1) in fp32 and requantizes once per output
+ *************************************************************/
+int shl_rvv_resize_packn_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                              struct csinn_resize_params *params)
+{
+    const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
+    if (params->resize_mode == CSINN_RESIZE_NEAREST_NEIGHBOR) {
+        return resize_nearest_int8(input, output, params, packn);
+    }
+#ifdef RVV_1_0_0
+    int8_t *input_data = (int8_t *)input->data;
+    int8_t *output_data = (int8_t *)output->data;
+
+    int32_t planes = input->dim[0] * input->dim[1] / packn;
+    int32_t in_h = input->dim[2];
+    int32_t in_w = input->dim[3];
+    int32_t out_h = output->dim[2];
+    int32_t out_w = output->dim[3];
+    bool align_corners = params->align_corners;
+
+    int64_t in_plane = (int64_t)in_h * in_w * packn;
+    int64_t out_plane = (int64_t)out_h * out_w * packn;
+    int row_size = out_w * packn;
+
+    int8_t in_zp = (int8_t)input->qinfo->zero_point;
+    int32_t out_zp = output->qinfo->zero_point;
+    float real_scale = input->qinfo->scale / output->qinfo->scale;
+
+    int32_t *yofs = (int32_t *)shl_mem_alloc(out_h * 2 * sizeof(int32_t));
+    int32_t *xofs = (int32_t *)shl_mem_alloc(out_w * 2 * sizeof(int32_t));
+    float *beta = (float *)shl_mem_alloc(out_h * 2 * sizeof(float));
+    float *alpha = (float *)shl_mem_alloc(out_w * 2 * sizeof(float));
+    shl_ref_resize_linear_table(in_h, out_h, align_corners, yofs, beta);
+    shl_ref_resize_linear_table(in_w, out_w, align_corners, xofs, alpha);
+    float *rows = (float *)shl_mem_alloc(row_size * 2 * sizeof(float));
+
+#pragma omp parallel for num_threads(1)
+    for (int p = 0; p < planes; p++) {
+        const int8_t *in = input_data + p * in_plane;
+        int8_t *out = output_data + p * out_plane;
+        float *rows0 = rows;
+        float *rows1 = rows + row_size;
+        int prev_sy = -2;
+        for (int y = 0; y < out_h; y++) {
+            int sy = yofs[2 * y];
+            if (sy == prev_sy + 1) {
+                float *tmp = rows0;
+                rows0 = rows1;
+                rows1 = tmp;
+                resize_hrow_packn_int8(in + yofs[2 * y + 1] * in_w * packn, rows1, out_w, xofs,
+                                       alpha, in_zp, packn);
+            } else if (sy != prev_sy) {
+                resize_hrow_packn_int8(in + sy * in_w * packn, rows0, out_w, xofs, alpha, in_zp,
+                                       packn);
+                resize_hrow_packn_int8(in + yofs[2 * y + 1] * in_w * packn, rows1, out_w, xofs,
+                                       alpha, in_zp, packn);
+            }
+            prev_sy = sy;
+            resize_vertical_int8(rows0, rows1, beta[2 * y] * real_scale,
+                                 beta[2 * y + 1] * real_scale, out_zp, out + y * row_size,
+                                 row_size);
+        }
+    }
+    shl_mem_free(yofs);
+    shl_mem_free(xofs);
+    shl_mem_free(beta);
+    shl_mem_free(alpha);
+    shl_mem_free(rows);
+    return CSINN_TRUE;
+#else
+    shl_debug_error("unsupport resize bilinear packn for int8 on rvv_spec 0.7.1\n");
+    return CSINN_FALSE;
+#endif
+}
@@ -6,6 +6,9 @@
 #define c_exp_hi_f16 10.7421875f
 #define c_exp_lo_f16 -10.7421875f
 
+#define c_exp_hi_f32 88.3762626647949f
+#define c_exp_lo_f32 -88.3762626647949f
+
 #define c_cephes_LOG2EF 1.44269504088896341
 #define c_cephes_exp_C1 0.693359375
 #define c_cephes_exp_C2 -2.12194440e-4
@@ -72,4 +75,250 @@ _RVV_FLOAT16_EXP_OP(2, 8)
 _RVV_FLOAT16_EXP_OP(4, 4)
 _RVV_FLOAT16_EXP_OP(8, 2)
 
+#define _RVV_FLOAT32_EXP_OP(LMUL, MLEN)                                                   \
+    static inline vfloat32m##LMUL##_t exp_ps_vfloat32m##LMUL(vfloat32m##LMUL##_t x, word_type vl) \
+    {                                                                                     \
+        vfloat32m##LMUL##_t tmp, fx;                                                      \
+                                                                                          \
+        x = vfmin_vf_f32m##LMUL(x, c_exp_hi_f32, vl);                                     \
+        x = vfmax_vf_f32m##LMUL(x, c_exp_lo_f32, vl);                                     \
+                                                                                          \
+        /* express exp(x) as exp(g + n*log(2)) */                                         \
+        fx = vfmacc_vf_f32m##LMUL(vfmv_v_f_f32m##LMUL(0.5f, vl), c_cephes_LOG2EF, x, vl); \
+                                                                                          \
+        /* perform a floorf */                                                            \
+        tmp = vfcvt_f_x_v_f32m##LMUL(vfcvt_x_f_v_i32m##LMUL(fx, vl), vl);                 \
+                                                                                          \
+        /* if greater, substract 1 */                                                     \
+        vbool##MLEN##_t mask = vmfgt_vv_f32m##LMUL##_b##MLEN(tmp, fx, vl);                \
+        fx = vfsub_vf_f32m##LMUL##_m(mask, tmp, tmp, 1.f, vl);                            \
+                                                                                          \
+        tmp = vfmul_vf_f32m##LMUL(fx, c_cephes_exp_C1, vl);                               \
+        vfloat32m##LMUL##_t z = vfmul_vf_f32m##LMUL(fx, c_cephes_exp_C2, vl);             \
+        x = vfsub_vv_f32m##LMUL(x, tmp, vl);                                              \
+        x = vfsub_vv_f32m##LMUL(x, z, vl);                                                \
+                                                                                          \
+        vfloat32m##LMUL##_t y = vfmul_vf_f32m##LMUL(x, c_cephes_exp_p0, vl);              \
+        z = vfmul_vv_f32m##LMUL(x, x, vl);                                                \
+                                                                                          \
+        y = vfadd_vf_f32m##LMUL(y, c_cephes_exp_p1, vl);                                  \
+        y = vfmul_vv_f32m##LMUL(y, x, vl);                                                \
+        y = vfadd_vf_f32m##LMUL(y, c_cephes_exp_p2, vl);                                  \
+        y = vfmul_vv_f32m##LMUL(y, x, vl);                                                \
+        y = vfadd_vf_f32m##LMUL(y, c_cephes_exp_p3, vl);                                  \
+        y = vfmul_vv_f32m##LMUL(y, x, vl);                                                \
+        y = vfadd_vf_f32m##LMUL(y, c_cephes_exp_p4, vl);                                  \
+        y = vfmul_vv_f32m##LMUL(y, x, vl);                                                \
+        y = vfadd_vf_f32m##LMUL(y, c_cephes_exp_p5, vl);                                  \
+                                                                                          \
+        y = vfmul_vv_f32m##LMUL(y, z, vl);                                                \
+        y = vfadd_vv_f32m##LMUL(y, x, vl);                                                \
+        y = vfadd_vf_f32m##LMUL(y, 1.f, vl);                                              \
+                                                                                          \
+        /* build 2^n */                                                                   \
+        vint32m##LMUL##_t mm = vfcvt_x_f_v_i32m##LMUL(fx, vl);                            \
+        mm = vadd_vx_i32m##LMUL(mm, 0x7f, vl);                                            \
+        mm = vsll_vx_i32m##LMUL(mm, 23, vl);                                              \
+        vfloat32m##LMUL##_t pow2n = vreinterpret_v_i32m##LMUL##_f32m##LMUL(mm);           \
+                                                                                          \
+        y = vfmul_vv_f32m##LMUL(y, pow2n, vl);                                            \
+        return y;                                                                         \
+    }
+
+_RVV_FLOAT32_EXP_OP(1, 32)
+_RVV_FLOAT32_EXP_OP(2, 16)
+_RVV_FLOAT32_EXP_OP(4, 8)
+_RVV_FLOAT32_EXP_OP(8, 4)
+
+#define c_min_norm_pos_f32 1.17549435e-38f
+#define c_cephes_SQRTHF 0.707106781186547524f
+#define c_cephes_log_p0 7.0376836292E-2f
+#define c_cephes_log_p1 -1.1514610310E-1f
+#define c_cephes_log_p2 1.1676998740E-1f
+#define c_cephes_log_p3 -1.2420140846E-1f
+#define c_cephes_log_p4 1.4249322787E-1f
+#define c_cephes_log_p5 -1.6668057665E-1f
+#define c_cephes_log_p6 2.0000714765E-1f
+#define c_cephes_log_p7 -2.4999993993E-1f
+#define c_cephes_log_p8 3.3333331174E-1f
+#define c_cephes_log_q1 -2.12194440e-4f
+#define c_cephes_log_q2 0.693359375f
+
+#define c_cephes_tanh_p0 -5.70498872745E-3f
+#define c_cephes_tanh_p1 2.06390887954E-2f
+#define c_cephes_tanh_p2 -5.37397155531E-2f
+#define c_cephes_tanh_p3 1.33314422036E-1f
+#define c_cephes_tanh_p4 -3.33332819422E-1f
+
+/* erf(x) = x * P(x^2) on [0, 1), 1 - exp(-x^2) * R(1 / x) on [1, 4], least squares fits */
+#define c_erf_p0 7.8845382978E-5f
+#define c_erf_p1 -8.0194812035E-4f
+#define c_erf_p2 5.1893843581E-3f
+#define c_erf_p3 -2.6854367672E-2f
+#define c_erf_p4 1.1283598417E-1f
+#define c_erf_p5 -3.7612626990E-1f
+#define c_erf_p6 1.1283791659E0f
+#define c_erf_r0 -1.8628525988E-2f
+#define c_erf_r1 1.2416455309E-1f
+#define c_erf_r2 -3.6063112051E-1f
+#define c_erf_r3 5.8205887133E-1f
+#define c_erf_r4 -5.0941512901E-1f
+#define c_erf_r5 5.2119048717E-2f
+#define c_erf_r6 5.5755318188E-1f
+#define c_erf_r7 3.6270740810E-4f
+
+#define _RVV_FLOAT32_LOG_OP(LMUL, MLEN)                                                   \
+    static inline vfloat32m##LMUL##_t log_ps_vfloat32m##LMUL(vfloat32m##LMUL##_t x, word_type vl) \
+    {                                                                                     \
+        x = vfmax_vf_f32m##LMUL(x, c_min_norm_pos_f32, vl);                               \
+        vint32m##LMUL##_t ux = vreinterpret_v_f32m##LMUL##_i32m##LMUL(x);                 \
+        vint32m##LMUL##_t emm0 = vsub_vx_i32m##LMUL(vsra_vx_i32m##LMUL(ux, 23, vl), 0x7f, vl); \
+        vfloat32m##LMUL##_t e = vfadd_vf_f32m##LMUL(vfcvt_f_x_v_f32m##LMUL(emm0, vl), 1.0f, vl); \
+                                                                                          \
+        /* keep the mantissa in [0.5, 1) */                                               \
+        ux = vand_vx_i32m##LMUL(ux, ~0x7f800000, vl);                                     \
+        ux = vor_vx_i32m##LMUL(ux, 0x3f000000, vl);                                       \
+        x = vreinterpret_v_i32m##LMUL##_f32m##LMUL(ux);                                   \
+                                                                                          \
+        /* below sqrt(1/2) use 2x - 1 with the exponent one less, otherwise x - 1 */      \
+        vbool##MLEN##_t mask = vmflt_vf_f32m##LMUL##_b##MLEN(x, c_cephes_SQRTHF, vl);     \
+        vfloat32m##LMUL##_t tmp = vfsub_vf_f32m##LMUL(x, 1.0f, vl);                       \
+        x = vfadd_vv_f32m##LMUL##_m(mask, tmp, tmp, x, vl);                               \
+        e = vfsub_vf_f32m##LMUL##_m(mask, e, e, 1.0f, vl);                                \
+                                                                                          \
+        vfloat32m##LMUL##_t z = vfmul_vv_f32m##LMUL(x, x, vl);                            \
+        vfloat32m##LMUL##_t y = vfmv_v_f_f32m##LMUL(c_cephes_log_p0, vl);                 \
+        y = vfmul_vv_f32m##LMUL(y, x, vl);                                                \
+        y = vfadd_vf_f32m##LMUL(y, c_cephes_log_p1, vl);                                  \
+        y = vfmul_vv_f32m##LMUL(y, x, vl);                                                \
+        y = vfadd_vf_f32m##LMUL(y, c_cephes_log_p2, vl);                                  \
+        y = vfmul_vv_f32m##LMUL(y, x, vl);                                                \
+        y = vfadd_vf_f32m##LMUL(y, c_cephes_log_p3, vl);                                  \
+        y = vfmul_vv_f32m##LMUL(y, x, vl);                                                \
+        y = vfadd_vf_f32m##LMUL(y, c_cephes_log_p4, vl);                                  \
+        y = vfmul_vv_f32m##LMUL(y, x, vl);                                                \
+        y = vfadd_vf_f32m##LMUL(y, c_cephes_log_p5, vl);                                  \
+        y = vfmul_vv_f32m##LMUL(y, x, vl);                                                \
+        y = vfadd_vf_f32m##LMUL(y, c_cephes_log_p6, vl);                                  \
+        y = vfmul_vv_f32m##LMUL(y, x, vl);                                                \
+        y = vfadd_vf_f32m##LMUL(y, c_cephes_log_p7, vl);                                  \
+        y = vfmul_vv_f32m##LMUL(y, x, vl);                                                \
+        y = vfadd_vf_f32m##LMUL(y, c_cephes_log_p8, vl);                                  \
+        y = vfmul_vv_f32m##LMUL(vfmul_vv_f32m##LMUL(y, x, vl), z, vl);                    \
+                                                                                          \
+        y = vfmacc_vf_f32m##LMUL(y, c_cephes_log_q1, e, vl);                              \
+        y = vfnmsac_vf_f32m##LMUL(y, 0.5f, z, vl);                                        \
+        x = vfadd_vv_f32m##LMUL(x, y, vl);                                                \
+        x = vfmacc_vf_f32m##LMUL(x, c_cephes_log_q2, e, vl);                              \
+        return x;                                                                         \
+    }
+
+_RVV_FLOAT32_LOG_OP(1, 32)
+_RVV_FLOAT32_LOG_OP(2, 16)
+_RVV_FLOAT32_LOG_OP(4, 8)
+_RVV_FLOAT32_LOG_OP(8, 4)
+
+#define _RVV_FLOAT32_LOG1P_OP(LMUL, MLEN)                                                 \
+    static inline vfloat32m##LMUL##_t log1p_ps_vfloat32m##LMUL(vfloat32m##LMUL##_t x, word_type vl) \
+    {                                                                                     \
+        /* log(w) * x / (w - 1) with w = 1 + x keeps small x exact, x >= 0 */             \
+        vfloat32m##LMUL##_t w = vfadd_vf_f32m##LMUL(x, 1.0f, vl);                         \
+        vfloat32m##LMUL##_t d = vfsub_vf_f32m##LMUL(w, 1.0f, vl);                         \
+        vbool##MLEN##_t tiny = vmfeq_vf_f32m##LMUL##_b##MLEN(d, 0.0f, vl);                \
+        vfloat32m##LMUL##_t y = vfmul_vv_f32m##LMUL(log_ps_vfloat32m##LMUL(w, vl), x, vl); \
+        y = vfdiv_vv_f32m##LMUL(y, d, vl);                                                \
+        return vmerge_vvm_f32m##LMUL(tiny, y, x, vl);                                     \
+    }
+
+_RVV_FLOAT32_LOG1P_OP(1, 32)
+_RVV_FLOAT32_LOG1P_OP(2, 16)
+_RVV_FLOAT32_LOG1P_OP(4, 8)
+_RVV_FLOAT32_LOG1P_OP(8, 4)
+
+#define _RVV_FLOAT32_TANH_OP(LMUL, MLEN)                                                  \
+    static inline vfloat32m##LMUL##_t tanh_ps_vfloat32m##LMUL(vfloat32m##LMUL##_t x, word_type vl) \
+    {                                                                                     \
+        vfloat32m##LMUL##_t ax = vfsgnjx_vv_f32m##LMUL(x, x, vl);                         \
+                                                                                          \
+        /* |x| >= 0.625: 1 - 2 / (exp(2|x|) + 1) */                                       \
+        vfloat32m##LMUL##_t e = exp_ps_vfloat32m##LMUL(vfadd_vv_f32m##LMUL(ax, ax, vl), vl); \
+        e = vfadd_vf_f32m##LMUL(e, 1.0f, vl);                                             \
+        vfloat32m##LMUL##_t big = vfrdiv_vf_f32m##LMUL(e, 2.0f, vl);                      \
+        big = vfrsub_vf_f32m##LMUL(big, 1.0f, vl);                                        \
+        big = vfsgnj_vv_f32m##LMUL(big, x, vl);                                           \
+                                                                                          \
+        /* |x| < 0.625: x + x^3 * P(x^2) */                                               \
+        vfloat32m##LMUL##_t z = vfmul_vv_f32m##LMUL(x, x, vl);                            \
+        vfloat32m##LMUL##_t p = vfmv_v_f_f32m##LMUL(c_cephes_tanh_p0, vl);                \
+        p = vfmul_vv_f32m##LMUL(p, z, vl);                                                \
+        p = vfadd_vf_f32m##LMUL(p, c_cephes_tanh_p1, vl);                                 \
+        p = vfmul_vv_f32m##LMUL(p, z, vl);                                                \
+        p = vfadd_vf_f32m##LMUL(p, c_cephes_tanh_p2, vl);                                 \
+        p = vfmul_vv_f32m##LMUL(p, z, vl);                                                \
+        p = vfadd_vf_f32m##LMUL(p, c_cephes_tanh_p3, vl);                                 \
+        p = vfmul_vv_f32m##LMUL(p, z, vl);                                                \
+        p = vfadd_vf_f32m##LMUL(p, c_cephes_tanh_p4, vl);                                 \
+        vfloat32m##LMUL##_t small = vfmacc_vv_f32m##LMUL(x, vfmul_vv_f32m##LMUL(p, z, vl), x, vl); \
+                                                                                          \
+        vbool##MLEN##_t mask = vmfge_vf_f32m##LMUL##_b##MLEN(ax, 0.625f, vl);             \
+        return vmerge_vvm_f32m##LMUL(mask, small, big, vl);                               \
+    }
+
+_RVV_FLOAT32_TANH_OP(1, 32)
+_RVV_FLOAT32_TANH_OP(2, 16)
+_RVV_FLOAT32_TANH_OP(4, 8)
+_RVV_FLOAT32_TANH_OP(8, 4)
+
+#define _RVV_FLOAT32_ERF_OP(LMUL, MLEN)                                                   \
+    static inline vfloat32m##LMUL##_t erf_ps_vfloat32m##LMUL(vfloat32m##LMUL##_t x, word_type vl) \
+    {                                                                                     \
+        vfloat32m##LMUL##_t ax = vfmin_vf_f32m##LMUL(vfsgnjx_vv_f32m##LMUL(x, x, vl), 4.0f, vl); \
+        vfloat32m##LMUL##_t z = vfmul_vv_f32m##LMUL(ax, ax, vl);                          \
+                                                                                          \
+        /* |x| < 1: x * P(x^2) */                                                         \
+        vfloat32m##LMUL##_t p = vfmv_v_f_f32m##LMUL(c_erf_p0, vl);                        \
+        p = vfmul_vv_f32m##LMUL(p, z, vl);                                                \
+        p = vfadd_vf_f32m##LMUL(p, c_erf_p1, vl);                                         \
+        p = vfmul_vv_f32m##LMUL(p, z, vl);                                                \
+        p = vfadd_vf_f32m##LMUL(p, c_erf_p2, vl);                                         \
+        p = vfmul_vv_f32m##LMUL(p, z, vl);                                                \
+        p = vfadd_vf_f32m##LMUL(p, c_erf_p3, vl);                                         \
+        p = vfmul_vv_f32m##LMUL(p, z, vl);                                                \
+        p = vfadd_vf_f32m##LMUL(p, c_erf_p4, vl);                                         \
+        p = vfmul_vv_f32m##LMUL(p, z, vl);                                                \
+        p = vfadd_vf_f32m##LMUL(p, c_erf_p5, vl);                                         \
+        p = vfmul_vv_f32m##LMUL(p, z, vl);                                                \
+        p = vfadd_vf_f32m##LMUL(p, c_erf_p6, vl);                                         \
+        vfloat32m##LMUL##_t small = vfmul_vv_f32m##LMUL(p, ax, vl);                       \
+                                                                                          \
+        /* |x| >= 1: 1 - exp(-x^2) * R(1 / x) */                                          \
+        vfloat32m##LMUL##_t t = vfrdiv_vf_f32m##LMUL(ax, 1.0f, vl);                       \
+        vfloat32m##LMUL##_t r = vfmv_v_f_f32m##LMUL(c_erf_r0, vl);                        \
+        r = vfmul_vv_f32m##LMUL(r, t, vl);                                                \
+        r = vfadd_vf_f32m##LMUL(r, c_erf_r1, vl);                                         \
+        r = vfmul_vv_f32m##LMUL(r, t, vl);                                                \
+        r = vfadd_vf_f32m##LMUL(r, c_erf_r2, vl);                                         \
+        r = vfmul_vv_f32m##LMUL(r, t, vl);                                                \
+        r = vfadd_vf_f32m##LMUL(r, c_erf_r3, vl);                                         \
+        r = vfmul_vv_f32m##LMUL(r, t, vl);                                                \
+        r = vfadd_vf_f32m##LMUL(r, c_erf_r4, vl);                                         \
+        r = vfmul_vv_f32m##LMUL(r, t, vl);                                                \
+        r = vfadd_vf_f32m##LMUL(r, c_erf_r5, vl);                                         \
+        r = vfmul_vv_f32m##LMUL(r, t, vl);                                                \
+        r = vfadd_vf_f32m##LMUL(r, c_erf_r6, vl);                                         \
+        r = vfmul_vv_f32m##LMUL(r, t, vl);                                                \
+        r = vfadd_vf_f32m##LMUL(r, c_erf_r7, vl);                                         \
+        vfloat32m##LMUL##_t e = exp_ps_vfloat32m##LMUL(vfneg_v_f32m##LMUL(z, vl), vl);    \
+        vfloat32m##LMUL##_t big = vfnmsac_vv_f32m##LMUL(vfmv_v_f_f32m##LMUL(1.0f, vl), e, r, vl); \
+                                                                                          \
+        vbool##MLEN##_t mask = vmfge_vf_f32m##LMUL##_b##MLEN(ax, 1.0f, vl);               \
+        vfloat32m##LMUL##_t y = vmerge_vvm_f32m##LMUL(mask, small, big, vl);              \
+        return vfsgnj_vv_f32m##LMUL(y, x, vl);                                            \
+    }
+
+_RVV_FLOAT32_ERF_OP(1, 32)
+_RVV_FLOAT32_ERF_OP(2, 16)
+_RVV_FLOAT32_ERF_OP(4, 8)
+_RVV_FLOAT32_ERF_OP(8, 4)
+
 #endif // RVV_MATHFUN_H
\ No newline at end of file
@@ -0,0 +1,268 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "rvv_mathfun.h"
+#include "shl_thead_rvv.h"
+
+/*************************************************************************************
+ * int8 scaled dot product attention, one pass over the keys with an online softmax.
+ * Four query rows share each tile of K^T, their scores stay in registers and only the
+ * exp of one tile goes through a small buffer on its way into the [4, head_dim_v]
+ * float accumulators. The [seq_q, seq_k] score matrix is never stored.
+ ************************************************************************************/
+
+#define ATTN_ROWS 4
+
+struct attention_row {
+    const int8_t *q;
+    const float *mask;
+    int32_t q_corr;  // zk * sum(q)
+    int valid_k;
+    float max;
+    float sum;
+    float *out;
+};
+
+/* fold one tile of scores into the running max, sum and output of a row */
+static void attention_row_update(vfloat32m4_t _score, int vl, struct attention_row *row,
+                                 const float *v_tile, int head_dim_v, float *p_buf)
+{
+    vfloat32m1_t _init = vfmv_v_f_f32m1(-INFINITY, 1);
+    vfloat32m1_t _tmax = vfredmax_vs_f32m4_f32m1(vundefined_f32m1(), _score, _init, vl);
+    float tile_max = vfmv_f_s_f32m1_f32(_tmax);
+    if (tile_max == -INFINITY) {
+        return;  // masked out
+    }
+    float new_max = fmaxf(row->max, tile_max);
+    float alpha = expf(row->max - new_max);
+
+    vfloat32m4_t _p = exp_ps_vfloat32m4(vfsub_vf_f32m4(_score, new_max, vl), vl);
+    vfloat32m1_t _zero = vfmv_v_f_f32m1(0.0f, 1);
+    vfloat32m1_t _tsum = vfredusum_vs_f32m4_f32m1(vundefined_f32m1(), _p, _zero, vl);
+    row->sum = row->sum * alpha + vfmv_f_s_f32m1_f32(_tsum);
+    row->max = new_max;
+    vse32_v_f32m4(p_buf, _p, vl);
+
+    int d = 0;
+    while (d < head_dim_v) {
+        int vl_d = vsetvl_e32m4(head_dim_v - d);
+        vfloat32m4_t _out = vle32_v_f32m4(row->out + d, vl_d);
+        _out = vfmul_vf_f32m4(_out, alpha, vl_d);
+        const float *v_ptr = v_tile + d;
+        for (int j = 0; j < vl; j++) {
+            _out = vfmacc_vf_f32m4(_out, p_buf[j], vle32_v_f32m4(v_ptr, vl_d), vl_d);
+            v_ptr += head_dim_v;
+        }
+        vse32_v_f32m4(row->out + d, _out, vl_d);
+        d += vl_d;
+    }
+}
+
+static inline void attention_row_score(vint32m4_t _acc, int j, int vl, struct attention_row *row,
+                                       float score_scale, const float *v_data, int head_dim_v,
+                                       float *p_buf)
+{
+    int n = row->valid_k - j < vl ? row->valid_k - j : vl;
+    if (n <= 0) {
+        return;
+    }
+    _acc = vsub_vx_i32m4(_acc, row->q_corr, n);
+    vfloat32m4_t _score = vfmul_vf_f32m4(vfcvt_f_x_v_f32m4(_acc, n), score_scale, n);
+    if (row->mask != NULL) {
+        _score = vfadd_vv_f32m4(_score, vle32_v_f32m4(row->mask + j, n), n);
+    }
+    attention_row_update(_score, n, row, v_data + j * head_dim_v, head_dim_v, p_buf);
+}
+
+static void attention_row_store(struct attention_row *row, int8_t *dst, int head_dim_v,
+                                float ratio, int32_t out_zp)
+{
+    /* a row masked out completely gives zeros */
+    ratio = row->sum > 0.0f ? ratio / row->sum : 0.0f;
+    int d = 0;
+    while (d < head_dim_v) {
+        int vl = vsetvl_e32m4(head_dim_v - d);
+        vfloat32m4_t _out = vfmul_vf_f32m4(vle32_v_f32m4(row->out + d, vl), ratio, vl);
+        vint32m4_t _res = vadd_vx_i32m4(vfcvt_x_f_v_i32m4(_out, vl), out_zp, vl);
+        vint16m2_t _res16 = vnclip_wx_i16m2(_res, 0, vl);
+        vse8_v_i8m1(dst + d, vnclip_wx_i8m1(_res16, 0, vl), vl);
+        d += vl;
+    }
+}
+
+int shl_rvv_scaled_dot_product_attention_init(
+    struct csinn_tensor *query, struct csinn_tensor *key, struct csinn_tensor *value,
+    struct csinn_tensor *mask, struct csinn_tensor *output,
+    struct csinn_scaled_dot_product_attention_params *params)
+{
+    struct csinn_callback *cb = params->base.cb;
+    if (query->dtype != CSINN_DTYPE_INT8 || key->dtype != CSINN_DTYPE_INT8 ||
+        value->dtype != CSINN_DTYPE_INT8 || output->dtype != CSINN_DTYPE_INT8 ||
+        query->dim_count != key->dim_count || query->dim_count != value->dim_count) {
+        cb->exec = shl_ref_scaled_dot_product_attention_quant;
+        return CSINN_TRUE;
+    }
+    cb->exec = shl_rvv_scaled_dot_product_attention_int8;
+    return CSINN_TRUE;
+}
+
+int shl_rvv_scaled_dot_product_attention_int8(
+    struct csinn_tensor *query, struct csinn_tensor *key, struct csinn_tensor *value,
+    struct csinn_tensor *mask, struct csinn_tensor *output,
+    struct csinn_scaled_dot_product_attention_params *params)
+{
+    int8_t *q_data = (int8_t *)query->data;
+    int8_t *k_data = (int8_t *)key->data;
+    int8_t *v_data = (int8_t *)value->data;
+    int8_t *output_data = (int8_t *)output->data;
+
+    const int dims_count = query->dim_count;
+    const int seq_q = query->dim[dims_count - 2];
+    const int head_dim = query->dim[dims_count - 1];
+    const int seq_k = key->dim[dims_count - 2];
+    const int head_dim_v = value->dim[dims_count - 1];
+    int64_t outer_size = 1;
+    for (int i = 0; i < dims_count - 2; i++) {
+        outer_size *= query->dim[i];
+    }
+
+    const int32_t zq = query->qinfo->zero_point;
+    const int32_t zk = key->qinfo->zero_point;
+    const int32_t zv = value->qinfo->zero_point;
+    const int32_t out_zp = output->qinfo->zero_point;
+    const float score_scale = query->qinfo->scale * key->qinfo->scale * params->norm_factor;
+    const float out_ratio = value->qinfo->scale / output->qinfo->scale;
+
+    /* a quantized mask is converted once for all heads */
+    struct csinn_tensor *float_mask = NULL;
+    float *mask_data = NULL;
+    if (mask != NULL && mask->data != NULL && mask->dim_count > 0) {
+        if (mask->dtype == CSINN_DTYPE_FLOAT32) {
+            mask_data = (float *)mask->data;
+        } else {
+            float_mask = shl_ref_tensor_transform_f32(mask);
+            mask_data = (float *)float_mask->data;
+        }
+    }
+
+    int8_t *kt = (int8_t *)shl_mem_alloc(head_dim * seq_k * sizeof(int8_t));
+    int32_t *k_corr = (int32_t *)shl_mem_alloc(seq_k * sizeof(int32_t));
+    float *v_buf = (float *)shl_mem_alloc(seq_k * head_dim_v * sizeof(float));
+    float *out_buf = (float *)shl_mem_alloc(ATTN_ROWS * head_dim_v * sizeof(float));
+    float *p_buf = (float *)shl_mem_alloc(csrr_vlenb() * sizeof(float));
+
+    for (int64_t o = 0; o < outer_size; o++) {
+        const int8_t *q_ptr = q_data + o * seq_q * head_dim;
+        const int8_t *k_ptr = k_data + o * seq_k * head_dim;
+        const int8_t *v_ptr = v_data + o * seq_k * head_dim_v;
+        int8_t *out_ptr = output_data + o * seq_q * head_dim_v;
+        int32_t mask_q_stride = 0;
+        const float *mask_ptr = NULL;
+        if (mask_data != NULL) {
+            mask_ptr = mask_data + shl_ref_attention_mask_offset(mask, query, o, &mask_q_stride);
+        }
+
+        /* K^T with k_corr[j] = head_dim * zq * zk - zq * sum(k[j]), V minus its zero point */
+        shl_rvv_transpose_int8(k_ptr, kt, seq_k, head_dim);
+        for (int j = 0; j < seq_k; j++) {
+            int32_t sum = 0;
+            for (int d = 0; d < head_dim; d++) {
+                sum += k_ptr[j * head_dim + d];
+            }
+            k_corr[j] = head_dim * zq * zk - zq * sum;
+        }
+        for (int64_t idx = 0; idx < (int64_t)seq_k * head_dim_v;) {
+            int vl = vsetvl_e8m1(seq_k * head_dim_v - idx);
+            vint16m2_t _v = vwsub_vx_i16m2(vle8_v_i8m1(v_ptr + idx, vl), zv, vl);
+            vse32_v_f32m4(v_buf + idx, vfwcvt_f_x_v_f32m4(_v, vl), vl);
+            idx += vl;
+        }
+
+        for (int i = 0; i < seq_q; i += ATTN_ROWS) {
+            struct attention_row rows[ATTN_ROWS];
+            int row_num = seq_q - i < ATTN_ROWS ? seq_q - i : ATTN_ROWS;
+            int max_k = 0;
+            for (int r = 0; r < ATTN_ROWS; r++) {
+                // missing rows of the last block repeat the first one and are not stored
+                int qi = r < row_num ? i + r : i;
+                struct attention_row *row = &rows[r];
+                row->q = q_ptr + qi * head_dim;
+                row->mask = mask_ptr != NULL ? mask_ptr + qi * mask_q_stride : NULL;
+                int32_t sum = 0;
+                for (int d = 0; d < head_dim; d++) {
+                    sum += row->q[d];
+                }
+                row->q_corr = zk * sum;
+                row->valid_k = params->causal ? (qi + 1 < seq_k ? qi + 1 : seq_k) : seq_k;
+                if (r >= row_num) {
+                    row->valid_k = 0;
+                }
+                row->max = -INFINITY;
+                row->sum = 0.0f;
+                row->out = out_buf + r * head_dim_v;
+                memset(row->out, 0, head_dim_v * sizeof(float));
+                max_k = row->valid_k > max_k ? row->valid_k : max_k;
+            }
+
+            const int8_t *q0 = rows[0].q;
+            const int8_t *q1 = rows[1].q;
+            const int8_t *q2 = rows[2].q;
+            const int8_t *q3 = rows[3].q;
+            int j = 0;
+            while (j < max_k) {
+                int vl = vsetvl_e32m4(max_k - j);
+                vint32m4_t _corr = vle32_v_i32m4(k_corr + j, vl);
+                vint32m4_t _acc0 = _corr;
+                vint32m4_t _acc1 = _corr;
+                vint32m4_t _acc2 = _corr;
+                vint32m4_t _acc3 = _corr;
+                const int8_t *kt_ptr = kt + j;
+                for (int d = 0; d < head_dim; d++) {
+                    vint16m2_t _k = vsext_vf2_i16m2(vle8_v_i8m1(kt_ptr, vl), vl);
+                    _acc0 = vwmacc_vx_i32m4(_acc0, q0[d], _k, vl);
+                    _acc1 = vwmacc_vx_i32m4(_acc1, q1[d], _k, vl);
+                    _acc2 = vwmacc_vx_i32m4(_acc2, q2[d], _k, vl);
+                    _acc3 = vwmacc_vx_i32m4(_acc3, q3[d], _k, vl);
+                    kt_ptr += seq_k;
+                }
+                attention_row_score(_acc0, j, vl, &rows[0], score_scale, v_buf, head_dim_v, p_buf);
+                attention_row_score(_acc1, j, vl, &rows[1], score_scale, v_buf, head_dim_v, p_buf);
+                attention_row_score(_acc2, j, vl, &rows[2], score_scale, v_buf, head_dim_v, p_buf);
+                attention_row_score(_acc3, j, vl, &rows[3], score_scale, v_buf, head_dim_v, p_buf);
+                j += vl;
+            }
+
+            for (int r = 0; r < row_num; r++) {
+                attention_row_store(&rows[r], out_ptr + (i + r) * head_dim_v, head_dim_v,
+                                    out_ratio, out_zp);
+            }
+        }
+    }
+
+    shl_mem_free(kt);
+    shl_mem_free(k_corr);
+    shl_mem_free(v_buf);
+    shl_mem_free(out_buf);
+    shl_mem_free(p_buf);
+    if (float_mask != NULL) {
+        shl_ref_tensor_transform_free_f32(float_mask);
+    }
+    return CSINN_TRUE;
+}
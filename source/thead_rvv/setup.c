@@ -20,7 +20,7 @@
 
 #include "shl_thead_rvv.h"
 
-#define RVV_OP_PATTERN_MAX 80
+#define RVV_OP_PATTERN_MAX 120
 static struct csinn_callback __rvv_cb_table[RVV_OP_PATTERN_MAX];
 static int __rvv_cb_key[RVV_OP_PATTERN_MAX];
 
@@ -77,6 +77,18 @@ void shl_target_init_rvv()
                    NULL, shl_gref_depthwise_conv2d);
     shl_rvv_reg_op(CSINN_DTYPE_INT4, CSINN_OP_DEPTHWISE_CONV2D, shl_rvv_depthwise_conv2d_init_int4,
                    NULL, shl_gref_depthwise_conv2d);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT32, CSINN_OP_DECONV2D, shl_rvv_deconv2d_init_fp32, NULL,
+                   shl_gref_deconv2d);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT16, CSINN_OP_DECONV2D, shl_rvv_deconv2d_init_fp16, NULL,
+                   shl_gref_deconv2d);
+    shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_DECONV2D, shl_rvv_deconv2d_init_int8, NULL,
+                   shl_gref_deconv2d);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT32, CSINN_OP_DEPTHWISE_DECONV2D,
+                   shl_rvv_depthwise_deconv2d_init_fp32, NULL, shl_gref_depthwise_deconv2d);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT16, CSINN_OP_DEPTHWISE_DECONV2D,
+                   shl_rvv_depthwise_deconv2d_init_fp16, NULL, shl_gref_depthwise_deconv2d);
+    shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_DEPTHWISE_DECONV2D,
+                   shl_rvv_depthwise_deconv2d_init_int8, NULL, shl_gref_depthwise_deconv2d);
     shl_rvv_reg_op(CSINN_DTYPE_FLOAT32, CSINN_OP_MAXPOOL2D, shl_rvv_maxpool2d_init_fp32, NULL,
                    shl_gref_maxpool2d);
     shl_rvv_reg_op(CSINN_DTYPE_FLOAT16, CSINN_OP_MAXPOOL2D, shl_rvv_maxpool2d_init_fp16, NULL,
@@ -122,6 +134,21 @@ void shl_target_init_rvv()
     shl_rvv_reg_op(CSINN_DTYPE_FLOAT16, CSINN_OP_CONCAT, NULL, shl_rvv_concat_fp16,
                    shl_gref_concat);
     shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_CONCAT, NULL, shl_rvv_concat_int8, shl_gref_concat);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT32, CSINN_OP_RESIZE, shl_rvv_resize_init_fp32, NULL,
+                   shl_gref_resize);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT16, CSINN_OP_RESIZE, shl_rvv_resize_init_fp16, NULL,
+                   shl_gref_resize);
+    shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_RESIZE, shl_rvv_resize_init_int8, NULL,
+                   shl_gref_resize);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT32, CSINN_OP_NON_MAX_SUPPRESSION, NULL,
+                   shl_rvv_non_max_suppression_fp32, shl_gref_non_max_suppression);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT32, CSINN_OP_TOPK, NULL, shl_rvv_topk_fp32, shl_gref_topk);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT32, CSINN_OP_TRANSPOSE, NULL, shl_rvv_transpose,
+                   shl_gref_transpose);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT16, CSINN_OP_TRANSPOSE, NULL, shl_rvv_transpose,
+                   shl_gref_transpose);
+    shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_TRANSPOSE, NULL, shl_rvv_transpose,
+                   shl_gref_transpose);
     shl_rvv_reg_op(CSINN_DTYPE_FLOAT32, CSINN_OP_LEAKY_RELU, NULL, shl_rvv_leaky_relu_fp32,
                    shl_gref_leaky_relu);
     shl_rvv_reg_op(CSINN_DTYPE_FLOAT16, CSINN_OP_LEAKY_RELU, NULL, shl_rvv_leaky_relu_fp16,
@@ -140,11 +167,56 @@ void shl_target_init_rvv()
                    NULL, shl_gref_global_avgpool2d);
     shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_GLOBAL_AVGPOOL2D, shl_rvv_global_avgpool2d_init, NULL,
                    shl_gref_global_avgpool2d);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT32, CSINN_OP_SIGMOID, NULL, shl_rvv_sigmoid_fp32,
+                   shl_gref_sigmoid);
     shl_rvv_reg_op(CSINN_DTYPE_FLOAT16, CSINN_OP_SIGMOID, NULL, shl_rvv_sigmoid_fp16,
                    shl_gref_sigmoid);
+    shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_SIGMOID, shl_rvv_sigmoid_init_int8, NULL,
+                   shl_gref_sigmoid);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT32, CSINN_OP_TANH, NULL, shl_rvv_tanh_fp32, shl_gref_tanh);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT16, CSINN_OP_TANH, NULL, shl_rvv_tanh_fp16, shl_gref_tanh);
+    shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_TANH, shl_rvv_tanh_init_int8, NULL, shl_gref_tanh);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT32, CSINN_OP_ERF, NULL, shl_rvv_erf_fp32, shl_gref_erf);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT16, CSINN_OP_ERF, NULL, shl_rvv_erf_fp16, shl_gref_erf);
+    shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_ERF, shl_rvv_erf_init_int8, NULL, shl_gref_erf);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT32, CSINN_OP_EXP, NULL, shl_rvv_exp_fp32, shl_gref_exp);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT16, CSINN_OP_EXP, NULL, shl_rvv_exp_fp16, shl_gref_exp);
+    shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_EXP, shl_rvv_exp_init_int8, NULL, shl_gref_exp);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT32, CSINN_OP_ELU, NULL, shl_rvv_elu_fp32, shl_gref_elu);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT16, CSINN_OP_ELU, NULL, shl_rvv_elu_fp16, shl_gref_elu);
+    shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_ELU, shl_rvv_elu_init_int8, NULL, shl_gref_elu);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT32, CSINN_OP_SOFTPLUS, NULL, shl_rvv_softplus_fp32,
+                   shl_gref_softplus);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT16, CSINN_OP_SOFTPLUS, NULL, shl_rvv_softplus_fp16,
+                   shl_gref_softplus);
+    shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_SOFTPLUS, shl_rvv_softplus_init_int8, NULL,
+                   shl_gref_softplus);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT32, CSINN_OP_GELU, NULL, shl_rvv_gelu_fp32, shl_gref_gelu);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT16, CSINN_OP_GELU, NULL, shl_rvv_gelu_fp16, shl_gref_gelu);
+    shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_GELU, shl_rvv_gelu_init_int8, NULL, shl_gref_gelu);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT32, CSINN_OP_SILU, NULL, shl_rvv_silu_fp32, shl_gref_silu);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT16, CSINN_OP_SILU, NULL, shl_rvv_silu_fp16, shl_gref_silu);
+    shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_SILU, shl_rvv_silu_init_int8, NULL, shl_gref_silu);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT32, CSINN_OP_MISH, NULL, shl_rvv_mish_fp32, shl_gref_mish);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT16, CSINN_OP_MISH, NULL, shl_rvv_mish_fp16, shl_gref_mish);
+    shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_MISH, shl_rvv_mish_init_int8, NULL, shl_gref_mish);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT32, CSINN_OP_SOFTMAX, NULL, shl_rvv_softmax_fp32,
+                   shl_gref_softmax);
     shl_rvv_reg_op(CSINN_DTYPE_FLOAT16, CSINN_OP_SOFTMAX, NULL, shl_rvv_softmax_fp16,
                    shl_gref_softmax);
+    shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_SOFTMAX, shl_rvv_softmax_init_int8, NULL,
+                   shl_gref_softmax);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT32, CSINN_OP_LOG_SOFTMAX, NULL, shl_rvv_log_softmax_fp32,
+                   shl_gref_log_softmax);
+    shl_rvv_reg_op(CSINN_DTYPE_FLOAT16, CSINN_OP_LOG_SOFTMAX, NULL, shl_rvv_log_softmax_fp16,
+                   shl_gref_log_softmax);
+    shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_LOG_SOFTMAX, shl_rvv_log_softmax_init_int8, NULL,
+                   shl_gref_log_softmax);
     shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_SUM, NULL, shl_rvv_sum_stride_int8, shl_gref_sum);
+    shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_MATMUL, shl_rvv_matmul_init, NULL, shl_gref_matmul);
+    shl_rvv_reg_op(CSINN_DTYPE_INT8, CSINN_OP_SCALED_DOT_PRODUCT_ATTENTION,
+                   shl_rvv_scaled_dot_product_attention_init, NULL,
+                   shl_gref_scaled_dot_product_attention);
 
     shl_register_runtime_callback(CSINN_RVV, NULL);
     shl_register_op_callback(CSINN_RVV, shl_cb_map_rvv);
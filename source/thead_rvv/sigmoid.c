@@ -21,6 +21,14 @@
 #include "rvv_mathfun.h"
 #include "shl_thead_rvv.h"
 
+static inline vfloat32m4_t sigmoid_ps(vfloat32m4_t _x, int vl)
+{
+    vfloat32m4_t _e = exp_ps_vfloat32m4(vfneg_v_f32m4(_x, vl), vl);
+    return vfrdiv_vf_f32m4(vfadd_vf_f32m4(_e, 1.0f, vl), 1.0f, vl);
+}
+
+static float sigmoid_f32(float x) { return 1.0f / (1.0f + expf(-x)); }
+
 int shl_rvv_sigmoid_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
                          struct csinn_sigmoid_params *params)
 {
@@ -44,3 +52,30 @@ int shl_rvv_sigmoid_fp16(struct csinn_tensor *input, struct csinn_tensor *output
     }
     return CSINN_TRUE;
 }
+
+int shl_rvv_sigmoid_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                         struct csinn_sigmoid_params *params)
+{
+    float *input_data = (float *)input->data;
+    float *output_data = (float *)output->data;
+
+    int size = csinn_tensor_size(input);
+    while (size > 0) {
+        int vl = vsetvl_e32m4(size);
+        vfloat32m4_t _x = vle32_v_f32m4(input_data, vl);
+        vse32_v_f32m4(output_data, sigmoid_ps(_x, vl), vl);
+        input_data += vl;
+        output_data += vl;
+        size -= vl;
+    }
+    return CSINN_TRUE;
+}
+
+int shl_rvv_sigmoid_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                              struct csinn_sigmoid_params *params)
+{
+    if (shl_rvv_siso_lut_init_int8(input, output, &params->base, sigmoid_f32) != CSINN_TRUE) {
+        params->base.cb->exec = shl_ref_sigmoid_quant;
+    }
+    return CSINN_TRUE;
+}
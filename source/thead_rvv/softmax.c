@@ -21,89 +21,411 @@
 #include "rvv_mathfun.h"
 #include "shl_thead_rvv.h"
 
+/*************************************************************
+ * softmax and log_softmax share one pass structure:
+ *   max over the axis, sum of exp(x - max) over the axis, then
+ *   softmax:     out = exp(x - max) / sum
+ *   log_softmax: out = x - max - log(sum)
+ * The last axis is reduced along contiguous rows. Other axes are
+ * processed in blocks of vl inner positions, one vector lane per
+ * position, so every load stays contiguous.
+ * fp16 is widened and computed in fp32.
+ *************************************************************/
+static inline vfloat32m4_t softmax_load(const void *ptr, int fp16, int vl)
+{
+    if (fp16) {
+        return vfwcvt_f_f_v_f32m4(vle16_v_f16m2((const __fp16 *)ptr, vl), vl);
+    }
+    return vle32_v_f32m4((const float *)ptr, vl);
+}
+
+static inline void softmax_store(void *ptr, vfloat32m4_t _x, int fp16, int vl)
+{
+    if (fp16) {
+        vse16_v_f16m2((__fp16 *)ptr, vfncvt_f_f_w_f16m2(_x, vl), vl);
+    } else {
+        vse32_v_f32m4((float *)ptr, _x, vl);
+    }
+}
+
+static void softmax_row_fp(const char *in, char *out, int cnt, int fp16, bool log_softmax)
+{
+    const int esize = fp16 ? sizeof(__fp16) : sizeof(float);
+
+    vfloat32m1_t _max = vfmv_v_f_f32m1(-FLT_MAX, 1);
+    for (int j = 0; j < cnt;) {
+        int vl = vsetvl_e32m4(cnt - j);
+        vfloat32m4_t _x = softmax_load(in + j * esize, fp16, vl);
+        _max = vfredmax_vs_f32m4_f32m1(vundefined_f32m1(), _x, _max, vl);
+        j += vl;
+    }
+    float max = vfmv_f_s_f32m1_f32(_max);
+
+    /* softmax keeps exp(x - max) in the output for the last pass */
+    vfloat32m1_t _sum = vfmv_v_f_f32m1(0.0f, 1);
+    for (int j = 0; j < cnt;) {
+        int vl = vsetvl_e32m4(cnt - j);
+        vfloat32m4_t _x = softmax_load(in + j * esize, fp16, vl);
+        vfloat32m4_t _e = exp_ps_vfloat32m4(vfsub_vf_f32m4(_x, max, vl), vl);
+        if (!log_softmax) {
+            softmax_store(out + j * esize, _e, fp16, vl);
+        }
+        _sum = vfredusum_vs_f32m4_f32m1(vundefined_f32m1(), _e, _sum, vl);
+        j += vl;
+    }
+    float sum = vfmv_f_s_f32m1_f32(_sum);
+
+    if (log_softmax) {
+        float bias = max + logf(sum);
+        for (int j = 0; j < cnt;) {
+            int vl = vsetvl_e32m4(cnt - j);
+            vfloat32m4_t _x = softmax_load(in + j * esize, fp16, vl);
+            softmax_store(out + j * esize, vfsub_vf_f32m4(_x, bias, vl), fp16, vl);
+            j += vl;
+        }
+    } else {
+        float scale = 1.0f / sum;
+        for (int j = 0; j < cnt;) {
+            int vl = vsetvl_e32m4(cnt - j);
+            vfloat32m4_t _e = softmax_load(out + j * esize, fp16, vl);
+            softmax_store(out + j * esize, vfmul_vf_f32m4(_e, scale, vl), fp16, vl);
+            j += vl;
+        }
+    }
+}
+
+/* vl inner positions, the axis stride is inner_size elements */
+static void softmax_block_fp(const char *in, char *out, int cnt, int64_t inner_size, int vl,
+                             int fp16, bool log_softmax)
+{
+    const int64_t stride = inner_size * (fp16 ? sizeof(__fp16) : sizeof(float));
+
+    vfloat32m4_t _max = softmax_load(in, fp16, vl);
+    for (int j = 1; j < cnt; j++) {
+        _max = vfmax_vv_f32m4(_max, softmax_load(in + j * stride, fp16, vl), vl);
+    }
+
+    vfloat32m4_t _sum = vfmv_v_f_f32m4(0.0f, vl);
+    for (int j = 0; j < cnt; j++) {
+        vfloat32m4_t _x = softmax_load(in + j * stride, fp16, vl);
+        vfloat32m4_t _e = exp_ps_vfloat32m4(vfsub_vv_f32m4(_x, _max, vl), vl);
+        if (!log_softmax) {
+            softmax_store(out + j * stride, _e, fp16, vl);
+        }
+        _sum = vfadd_vv_f32m4(_sum, _e, vl);
+    }
+
+    if (log_softmax) {
+        vfloat32m4_t _bias = vfadd_vv_f32m4(_max, log_ps_vfloat32m4(_sum, vl), vl);
+        for (int j = 0; j < cnt; j++) {
+            vfloat32m4_t _x = softmax_load(in + j * stride, fp16, vl);
+            softmax_store(out + j * stride, vfsub_vv_f32m4(_x, _bias, vl), fp16, vl);
+        }
+    } else {
+        vfloat32m4_t _scale = vfrdiv_vf_f32m4(_sum, 1.0f, vl);
+        for (int j = 0; j < cnt; j++) {
+            vfloat32m4_t _e = softmax_load(out + j * stride, fp16, vl);
+            softmax_store(out + j * stride, vfmul_vv_f32m4(_e, _scale, vl), fp16, vl);
+        }
+    }
+}
+
+static int softmax_fp(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_softmax_params *params, int fp16, bool log_softmax)
+{
+    const char *input_data = (const char *)input->data;
+    char *output_data = (char *)output->data;
+    const int esize = fp16 ? sizeof(__fp16) : sizeof(float);
+
+    int axis = params->axis;
+    int64_t outer_size = 1;
+    for (int i = 0; i < axis; i++) {
+        outer_size *= input->dim[i];
+    }
+    int64_t inner_size = 1;
+    for (int i = axis + 1; i < input->dim_count; i++) {
+        inner_size *= input->dim[i];
+    }
+    int cnt = input->dim[axis];
+
+    for (int64_t i = 0; i < outer_size; i++) {
+        const char *in_ptr = input_data + i * cnt * inner_size * esize;
+        char *out_ptr = output_data + i * cnt * inner_size * esize;
+        if (inner_size == 1) {
+            softmax_row_fp(in_ptr, out_ptr, cnt, fp16, log_softmax);
+            continue;
+        }
+        for (int64_t k = 0; k < inner_size;) {
+            int vl = vsetvl_e32m4(inner_size - k);
+            softmax_block_fp(in_ptr + k * esize, out_ptr + k * esize, cnt, inner_size, vl, fp16,
+                             log_softmax);
+            k += vl;
+        }
+    }
+    return CSINN_TRUE;
+}
+
+int shl_rvv_softmax_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                         struct csinn_softmax_params *params)
+{
+    return softmax_fp(input, output, params, 0, false);
+}
+
 int shl_rvv_softmax_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
                          struct csinn_softmax_params *params)
 {
-    __fp16 *input_data = (__fp16 *)input->data;
-    __fp16 *output_data = (__fp16 *)output->data;
+    return softmax_fp(input, output, params, 1, false);
+}
+
+int shl_rvv_log_softmax_fp32(struct csinn_tensor *input, struct csinn_tensor *output,
+                             struct csinn_softmax_params *params)
+{
+    return softmax_fp(input, output, params, 0, true);
+}
+
+int shl_rvv_log_softmax_fp16(struct csinn_tensor *input, struct csinn_tensor *output,
+                             struct csinn_softmax_params *params)
+{
+    return softmax_fp(input, output, params, 1, true);
+}
+
+/*************************************************************
+ * int8 stays integer per element. x - max is in [-255, 0], so
+ * exp((x - max) * input_scale) comes from a 256-entry Q15 table
+ * built at init. The sum is exact in u32 up to 2^17 elements.
+ *   softmax:     out = e * r >> shift + zp, r = (2^shift / output_scale) / sum
+ *                e * r <= 2^31 since sum >= e, one division per row
+ *   log_softmax: out = ((x - max) * A - C) >> 16 + zp, A = input_scale / output_scale
+ *                in Q16, C = log(sum / 2^15) / output_scale in Q16, one log per row
+ *************************************************************/
+struct softmax_int8_table {
+    uint16_t exp[256];
+    uint32_t multiplier;
+    int32_t shift;
+    int32_t log_multiplier;
+    float log_scale;
+};
+
+static inline vuint16m2_t softmax_exp_int8(const uint16_t *table, vint16m2_t _d, int vl)
+{
+    /* _d = x - max, the table is indexed by max - x */
+#ifdef RVV_1_0_0
+    vuint16m2_t _offset = vreinterpret_v_i16m2_u16m2(vmul_vx_i16m2(_d, -2, vl));
+    return vluxei16_v_u16m2(table, _offset, vl);
+#else
+    int16_t d[vl];
+    uint16_t e[vl];
+    vse16_v_i16m2(d, _d, vl);
+    for (int i = 0; i < vl; i++) {
+        e[i] = table[-d[i]];
+    }
+    return vle16_v_u16m2(e, vl);
+#endif
+}
+
+/* narrow to int8 with saturation */
+static inline void softmax_store_int8(int8_t *out, vint32m4_t _q, int32_t zp, int vl)
+{
+    _q = vadd_vx_i32m4(_q, zp, vl);
+    vse8_v_i8m1(out, vnclip_wx_i8m1(vnclip_wx_i16m2(_q, 0, vl), 0, vl), vl);
+}
+
+static inline vint32m4_t softmax_scale_int8(vuint16m2_t _e, vuint32m4_t _r, int shift, int vl)
+{
+    vuint32m4_t _p = vmul_vv_u32m4(vwaddu_vx_u32m4(_e, 0, vl), _r, vl);
+    if (shift > 0) {
+        _p = vsrl_vx_u32m4(vadd_vx_u32m4(_p, 1u << (shift - 1), vl), shift, vl);
+    }
+    return vreinterpret_v_u32m4_i32m4(_p);
+}
+
+static inline vint32m4_t softmax_log_int8(vint16m2_t _d, int32_t multiplier, vint64m8_t _bias,
+                                          int vl)
+{
+    vint32m4_t _d32 = vwadd_vx_i32m4(_d, 0, vl);
+    vint64m8_t _acc = vwmul_vx_i64m8(_d32, multiplier, vl);
+    return vnclip_wx_i32m4(vsub_vv_i64m8(_acc, _bias, vl), 16, vl);
+}
+
+static void softmax_row_int8(const int8_t *in, int8_t *out, int cnt,
+                             const struct softmax_int8_table *t, int32_t zp, bool log_softmax)
+{
+    vint8m1_t _max = vmv_v_x_i8m1(-128, 1);
+    for (int j = 0; j < cnt;) {
+        int vl = vsetvl_e8m4(cnt - j);
+        _max = vredmax_vs_i8m4_i8m1(vundefined_i8m1(), vle8_v_i8m4(in + j, vl), _max, vl);
+        j += vl;
+    }
+    int8_t max = vmv_x_s_i8m1_i8(_max);
+
+    vuint32m1_t _sum = vmv_v_x_u32m1(0, 1);
+    for (int j = 0; j < cnt;) {
+        int vl = vsetvl_e8m1(cnt - j);
+        vint16m2_t _d = vwsub_vx_i16m2(vle8_v_i8m1(in + j, vl), max, vl);
+        vuint16m2_t _e = softmax_exp_int8(t->exp, _d, vl);
+        _sum = vwredsumu_vs_u16m2_u32m1(vundefined_u32m1(), _e, _sum, vl);
+        j += vl;
+    }
+    uint32_t sum = vmv_x_s_u32m1_u32(_sum);
+
+    if (log_softmax) {
+        float log_sum = logf(sum * (1.0f / 32768)) * t->log_scale;
+        int64_t bias = log_sum < (float)INT32_MAX ? (int64_t)roundf(log_sum) : INT32_MAX;
+        for (int j = 0; j < cnt;) {
+            int vl = vsetvl_e8m1(cnt - j);
+            vint16m2_t _d = vwsub_vx_i16m2(vle8_v_i8m1(in + j, vl), max, vl);
+            vint64m8_t _bias = vmv_v_x_i64m8(bias, vl);
+            softmax_store_int8(out + j, softmax_log_int8(_d, t->log_multiplier, _bias, vl), zp,
+                               vl);
+            j += vl;
+        }
+    } else {
+        uint32_t r = (t->multiplier + sum / 2) / sum;
+        for (int j = 0; j < cnt;) {
+            int vl = vsetvl_e8m1(cnt - j);
+            vint16m2_t _d = vwsub_vx_i16m2(vle8_v_i8m1(in + j, vl), max, vl);
+            vuint16m2_t _e = softmax_exp_int8(t->exp, _d, vl);
+            vuint32m4_t _r = vmv_v_x_u32m4(r, vl);
+            softmax_store_int8(out + j, softmax_scale_int8(_e, _r, t->shift, vl), zp, vl);
+            j += vl;
+        }
+    }
+}
+
+static void softmax_block_int8(const int8_t *in, int8_t *out, int cnt, int64_t inner_size,
+                               int vl, const struct softmax_int8_table *t, int32_t zp,
+                               bool log_softmax)
+{
+    vint8m1_t _max = vle8_v_i8m1(in, vl);
+    for (int j = 1; j < cnt; j++) {
+        _max = vmax_vv_i8m1(_max, vle8_v_i8m1(in + j * inner_size, vl), vl);
+    }
+
+    vuint32m4_t _sum = vmv_v_x_u32m4(0, vl);
+    for (int j = 0; j < cnt; j++) {
+        vint16m2_t _d = vwsub_vv_i16m2(vle8_v_i8m1(in + j * inner_size, vl), _max, vl);
+        _sum = vwaddu_wv_u32m4(_sum, softmax_exp_int8(t->exp, _d, vl), vl);
+    }
+
+    if (log_softmax) {
+        vfloat32m4_t _log = vfcvt_f_xu_v_f32m4(_sum, vl);
+        _log = log_ps_vfloat32m4(vfmul_vf_f32m4(_log, 1.0f / 32768, vl), vl);
+        _log = vfmin_vf_f32m4(vfmul_vf_f32m4(_log, t->log_scale, vl), 2147483520.0f, vl);
+        vint64m8_t _bias = vwadd_vx_i64m8(vfcvt_x_f_v_i32m4(_log, vl), 0, vl);
+        for (int j = 0; j < cnt; j++) {
+            vint16m2_t _d = vwsub_vv_i16m2(vle8_v_i8m1(in + j * inner_size, vl), _max, vl);
+            softmax_store_int8(out + j * inner_size,
+                               softmax_log_int8(_d, t->log_multiplier, _bias, vl), zp, vl);
+        }
+    } else {
+        vuint32m4_t _r = vadd_vv_u32m4(vmv_v_x_u32m4(t->multiplier, vl),
+                                       vsrl_vx_u32m4(_sum, 1, vl), vl);
+        _r = vdivu_vv_u32m4(_r, _sum, vl);
+        for (int j = 0; j < cnt; j++) {
+            vint16m2_t _d = vwsub_vv_i16m2(vle8_v_i8m1(in + j * inner_size, vl), _max, vl);
+            vuint16m2_t _e = softmax_exp_int8(t->exp, _d, vl);
+            softmax_store_int8(out + j * inner_size, softmax_scale_int8(_e, _r, t->shift, vl), zp,
+                               vl);
+        }
+    }
+}
+
+static int softmax_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                        struct csinn_softmax_params *params, bool log_softmax)
+{
+    const int8_t *input_data = (const int8_t *)input->data;
+    int8_t *output_data = (int8_t *)output->data;
+    const struct softmax_int8_table *t = params->base.lut;
+    const int32_t zp = output->qinfo->zero_point;
 
     int axis = params->axis;
-    // FlatSize() = outer_size * inner_size * cnt;
     int64_t outer_size = 1;
     for (int i = 0; i < axis; i++) {
         outer_size *= input->dim[i];
     }
-
     int64_t inner_size = 1;
     for (int i = axis + 1; i < input->dim_count; i++) {
         inner_size *= input->dim[i];
     }
-
     int cnt = input->dim[axis];
 
-    for (int i = 0; i < outer_size; i++) {
-        for (int k = 0; k < inner_size; k++) {
-            __fp16 acc_exp = 0.0f;
-            __fp16 max = -FLT_MAX;
-            // Find max element value which we'll use to ensure numerical stability
-            // taking advantage of the following equality:
-            // exp(x[i])/sum(exp(x[i])) == exp(x[i]+C)/sum(exp(x[i]+C))
-
-            int n = cnt;
-            __fp16 *ptr = input_data + k;
-            vfloat16m2_t _output_data = vfmv_v_f_f16m2(max, 16);
-            int j = 0;
-            for (; j + 15 < cnt; j += 16) {
-                vfloat16m2_t _input_data = vlse16_v_f16m2(ptr, 2 * inner_size, 16);
-                _output_data = vfmax_vv_f16m2(_input_data, _output_data, 16);
-                ptr += 16;
-            }
-            vfloat16m1_t _min_f = vfmv_v_f_f16m1(-FLT_MAX, 8);
-            vfloat16m1_t _max = vfredmax_vs_f16m2_f16m1(_min_f, _output_data, _min_f, 16);
-            max = vfmv_f_s_f16m1_f16(_max);
-
-            for (; j < cnt; j++) {
-                max = fmax(max, *(input_data + j * inner_size + k));
-            }
-
-            n = cnt;
-            ptr = input_data + k;
-            vfloat16m2_t _sum = vfmv_v_f_f16m2(0.0f, 16);
-
-            j = 0;
-            for (; j + 15 < cnt; j += 16) {
-                vfloat16m2_t _input_data = vlse16_v_f16m2(ptr, 2 * inner_size, 16);
-                _input_data = vfsub_vf_f16m2(_input_data, max, 16);
-                vfloat16m2_t _output_data = exp_ps_vfloat16m2(_input_data, 16);
-                _sum = vfadd_vv_f16m2(_sum, _output_data, 16);
-                ptr += 16;
-            }
-            vfloat16m1_t _0_f = vfmv_v_f_f16m1(0.0f, 8);
-            vfloat16m1_t _sum2 = vfredosum_vs_f16m2_f16m1(_0_f, _sum, _0_f, 16);
-            acc_exp = vfmv_f_s_f16m1_f16(_sum2);
-
-            for (; j < cnt; j++) {
-                acc_exp += exp(*(input_data + j * inner_size + k) - max);
-            }
-            n = cnt;
-            ptr = input_data + k;
-            __fp16 *ptr2 = output_data + k;
-            while (n > 0) {
-                size_t vl = vsetvl_e16m2(n);
-
-                vfloat16m2_t _input_data = vlse16_v_f16m2(ptr, 2 * inner_size, vl);
-                _input_data = vfsub_vf_f16m2(_input_data, max, vl);
-                vfloat16m2_t _output_data = exp_ps_vfloat16m2(_input_data, vl);
-                _output_data = vfdiv_vf_f16m2(_output_data, acc_exp, vl);
-                vsse16_v_f16m2(ptr2, 2 * inner_size, _output_data, vl);
-
-                ptr += vl;
-                ptr2 += vl;
-                n -= vl;
-            }
+    for (int64_t i = 0; i < outer_size; i++) {
+        const int8_t *in_ptr = input_data + i * cnt * inner_size;
+        int8_t *out_ptr = output_data + i * cnt * inner_size;
+        if (inner_size == 1) {
+            softmax_row_int8(in_ptr, out_ptr, cnt, t, zp, log_softmax);
+            continue;
+        }
+        for (int64_t k = 0; k < inner_size;) {
+            int vl = vsetvl_e8m1(inner_size - k);
+            softmax_block_int8(in_ptr + k, out_ptr + k, cnt, inner_size, vl, t, zp, log_softmax);
+            k += vl;
         }
-        input_data += inner_size * cnt;
-        output_data += inner_size * cnt;
+    }
+    return CSINN_TRUE;
+}
+
+int shl_rvv_softmax_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                         struct csinn_softmax_params *params)
+{
+    return softmax_int8(input, output, params, false);
+}
+
+int shl_rvv_log_softmax_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                             struct csinn_softmax_params *params)
+{
+    return softmax_int8(input, output, params, true);
+}
+
+static int softmax_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                             struct csinn_softmax_params *params)
+{
+    const float in_scale = input->qinfo->scale;
+    const float out_scale = output->qinfo->scale;
+    const double ratio = (double)in_scale / out_scale;
+    if (input->quant_channel > 1 || output->quant_channel > 1 ||
+        input->dim[params->axis] > (1 << 17) || ratio * 65536 >= INT32_MAX) {
+        return CSINN_FALSE;
+    }
+
+    struct softmax_int8_table *t = params->base.lut;
+    if (t == NULL) {
+        t = shl_mem_alloc(sizeof(struct softmax_int8_table));
+        params->base.lut = t;
+    }
+    for (int d = 0; d < 256; d++) {
+        t->exp[d] = (uint16_t)lroundf(expf(-d * in_scale) * 32768);
+    }
+    /* the largest shift with 2^shift / output_scale <= 2^31 */
+    int shift = 30;
+    while (shift > 0 && ldexp(1.0 / out_scale, shift) > 2147483648.0) {
+        shift--;
+    }
+    t->shift = shift;
+    t->multiplier = (uint32_t)fmin(llround(ldexp(1.0 / out_scale, shift)), 2147483648.0);
+    t->log_multiplier = (int32_t)llround(ratio * 65536);
+    t->log_scale = 65536 / out_scale;
+    return CSINN_TRUE;
+}
+
+int shl_rvv_softmax_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                              struct csinn_softmax_params *params)
+{
+    if (softmax_init_int8(input, output, params) == CSINN_TRUE) {
+        params->base.cb->exec = shl_rvv_softmax_int8;
+    } else {
+        params->base.cb->exec = shl_ref_softmax_quant;
+    }
+    return CSINN_TRUE;
+}
+
+int shl_rvv_log_softmax_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                                  struct csinn_softmax_params *params)
+{
+    if (softmax_init_int8(input, output, params) == CSINN_TRUE) {
+        params->base.cb->exec = shl_rvv_log_softmax_int8;
+    } else {
+        params->base.cb->exec = shl_ref_log_softmax_quant;
     }
     return CSINN_TRUE;
 }
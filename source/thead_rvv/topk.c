@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_thead_rvv.h"
+
+/*************************************************************
+ * note: VLEN = 128/256 ... flexible vlen
+ * heap of the k best per row, see shl_ref_topk_f32
+ * once the heap is full only values above its root can enter,
+ * so a block is first compared with the root and skipped when none is above it
+ *************************************************************/
+int shl_rvv_topk_fp32(struct csinn_tensor *input, struct csinn_tensor *output1,
+                      struct csinn_tensor *output2, struct csinn_topk_params *params)
+{
+    float *input_data = (float *)input->data;
+    float *values_data = (float *)output1->data;
+    int32_t *indices_data = (int32_t *)output2->data;
+
+    int k = params->k;
+    int last_dim = input->dim[input->dim_count - 1];
+    int inner_size = 1;
+    for (int i = 0; i < input->dim_count - 1; i++) {
+        inner_size *= input->dim[i];
+    }
+
+#pragma omp parallel for num_threads(1)
+    for (int n = 0; n < inner_size; n++) {
+        const float *row = input_data + n * last_dim;
+        float *values = values_data + n * k;
+        int32_t *indices = indices_data + n * k;
+        int size = 0;
+        int j = 0;
+        for (; j < last_dim && size < k; j++) {
+            shl_ref_topk_heap_push(values, indices, &size, k, row[j], j);
+        }
+        while (j < last_dim) {
+            int vl = vsetvl_e32m4(last_dim - j);
+            vbool8_t _gt = vmfgt_vf_f32m4_b8(vle32_v_f32m4(row + j, vl), values[0], vl);
+            if (vfirst_m_b8(_gt, vl) >= 0) {
+                for (int t = j; t < j + vl; t++) {
+                    shl_ref_topk_heap_push(values, indices, &size, k, row[t], t);
+                }
+            }
+            j += vl;
+        }
+        shl_ref_topk_heap_sort(values, indices, size);
+    }
+    return CSINN_TRUE;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "shl_thead_rvv.h"
+
+/*************************************************************
+ * dst[i][j] = src[j][i], i < rows, j < cols, leading dims in elements
+ * a strip of vl elements along the contiguous source row is loaded once
+ * and stored down one destination column, the strip walks all columns
+ * before moving on so the touched destination lines stay in cache
+ *************************************************************/
+static void transpose_2d_e32(const int32_t *src, int64_t src_ld, int32_t *dst, int64_t dst_ld,
+                             int rows, int cols)
+{
+    int i = 0;
+    while (i < rows) {
+        int vl = vsetvl_e32m2(rows - i);
+        for (int j = 0; j < cols; j++) {
+            vint32m2_t _p = vle32_v_i32m2(src + j * src_ld + i, vl);
+            vsse32_v_i32m2(dst + i * dst_ld + j, dst_ld * sizeof(int32_t), _p, vl);
+        }
+        i += vl;
+    }
+}
+
+static void transpose_2d_e16(const int16_t *src, int64_t src_ld, int16_t *dst, int64_t dst_ld,
+                             int rows, int cols)
+{
+    int i = 0;
+    while (i < rows) {
+        int vl = vsetvl_e16m2(rows - i);
+        for (int j = 0; j < cols; j++) {
+            vint16m2_t _p = vle16_v_i16m2(src + j * src_ld + i, vl);
+            vsse16_v_i16m2(dst + i * dst_ld + j, dst_ld * sizeof(int16_t), _p, vl);
+        }
+        i += vl;
+    }
+}
+
+static void transpose_2d_e8(const int8_t *src, int64_t src_ld, int8_t *dst, int64_t dst_ld,
+                            int rows, int cols)
+{
+    int i = 0;
+    while (i < rows) {
+        int vl = vsetvl_e8m2(rows - i);
+        for (int j = 0; j < cols; j++) {
+            vint8m2_t _p = vle8_v_i8m2(src + j * src_ld + i, vl);
+            vsse8_v_i8m2(dst + i * dst_ld + j, dst_ld * sizeof(int8_t), _p, vl);
+        }
+        i += vl;
+    }
+}
+
+/*************************************************************
+ * note: VLEN = 128/256 ... flexible vlen
+ * the permute is collapsed first (see shl_ref_transpose_collapse), a contiguous innermost
+ * axis is a row copy, everything else is a batch of 2-D transposes between the
+ * input-contiguous axis and the last output axis
+ * int8 with differing quantization requantizes on the reference
+ *************************************************************/
+int shl_rvv_transpose(struct csinn_tensor *input, struct csinn_tensor *output,
+                      struct csinn_transpose_params *params)
+{
+    int elem_size = 0;
+    if (input->dtype == CSINN_DTYPE_FLOAT32) {
+        elem_size = sizeof(float);
+    } else if (input->dtype == CSINN_DTYPE_FLOAT16) {
+        elem_size = sizeof(__fp16);
+    } else if (input->dtype == CSINN_DTYPE_INT8 &&
+               input->qinfo->scale == output->qinfo->scale &&
+               input->qinfo->zero_point == output->qinfo->zero_point) {
+        elem_size = sizeof(int8_t);
+    }
+    if (elem_size == 0 || input->dtype != output->dtype) {
+        return shl_ref_transpose(input, output, params);
+    }
+
+    int64_t shape[MAX_DIM];
+    int64_t in_stride[MAX_DIM];
+    int rank =
+        shl_ref_transpose_collapse(input, params->permute, params->permute_num, shape, in_stride);
+    if (rank == 0 || in_stride[rank - 1] == 1) {
+        shl_ref_transpose_run(input->data, output->data, elem_size, rank, shape, in_stride, NULL,
+                              1);
+        return CSINN_TRUE;
+    }
+
+    int64_t out_stride[MAX_DIM];
+    out_stride[rank - 1] = 1;
+    for (int d = rank - 2; d >= 0; d--) {
+        out_stride[d] = out_stride[d + 1] * shape[d + 1];
+    }
+    int p = 0;
+    while (in_stride[p] != 1) {
+        p++;
+    }
+    int rows = shape[p];
+    int cols = shape[rank - 1];
+    int64_t src_ld = in_stride[rank - 1];
+    int64_t dst_ld = out_stride[p];
+    int64_t outer = out_stride[0] * shape[0] / ((int64_t)rows * cols);
+    int8_t *input_data = (int8_t *)input->data;
+    int8_t *output_data = (int8_t *)output->data;
+
+#pragma omp parallel for num_threads(1)
+    for (int64_t o = 0; o < outer; o++) {
+        int64_t rem = o;
+        int64_t in_ofs = 0;
+        int64_t out_ofs = 0;
+        for (int d = rank - 2; d >= 0; d--) {
+            if (d == p) {
+                continue;
+            }
+            int64_t idx = rem % shape[d];
+            rem /= shape[d];
+            in_ofs += idx * in_stride[d];
+            out_ofs += idx * out_stride[d];
+        }
+        int8_t *src = input_data + in_ofs * elem_size;
+        int8_t *dst = output_data + out_ofs * elem_size;
+        if (elem_size == 4) {
+            transpose_2d_e32((int32_t *)src, src_ld, (int32_t *)dst, dst_ld, rows, cols);
+        } else if (elem_size == 2) {
+            transpose_2d_e16((int16_t *)src, src_ld, (int16_t *)dst, dst_ld, rows, cols);
+        } else {
+            transpose_2d_e8(src, src_ld, dst, dst_ld, rows, cols);
+        }
+    }
+    return CSINN_TRUE;
+}
@@ -34,6 +34,9 @@ int csrr_vlenb()
     return a;
 }
 
+/* core of tuning cache keys, the api whose kernels run and the vector length */
+int32_t shl_rvv_tune_core(struct csinn_params_base *base) { return base->api << 16 | csrr_vlenb(); }
+
 /********************* for int8 quantization *********************/
 // add output_zeropint
 void shl_rvv_saturated_int8(int32_t *src, int8_t *dst, int32_t out_zp, int size)
@@ -60,14 +63,9 @@ void shl_rvv_requantize(int32_t *src, int32_t multiplier, int32_t shift, int cha
     while (channel_size > 0) {
         int vl = vsetvl_e32m4(channel_size);
         vint32m4_t _val = vle32_v_i32m4(src, vl);
-        vint32m4_t _mulh = vmulh_vx_i32m4(_val, multiplier, vl);
-        vint32m4_t _res;
-        // FIXME: precision error
-        if (shift < 0) {
-            _res = vssra_vx_i32m4(_mulh, -shift - 1, vl);
-        } else {
-            _res = vsll_vx_i32m4(_mulh, shift + 1, vl);
-        }
+        // widening product rounded once, vmulh + vssra rounded the truncated high half
+        vint64m8_t _mulw = vwmul_vx_i64m8(_val, multiplier, vl);
+        vint32m4_t _res = vnclip_wx_i32m4(_mulw, 31 - shift, vl);
         vse32_v_i32m4(src, _res, vl);
         src += vl;
         channel_size -= vl;
@@ -77,6 +75,72 @@ void shl_rvv_requantize(int32_t *src, int32_t multiplier, int32_t shift, int cha
 // 反量化 int32 -> float32  int8 -> float32
 void shl_rvv_dequantize() { ; }
 
+/********************* 8-bit lookup tables *********************/
+/*
+ * An int8 unary op is a function of 256 input values. The table is indexed by the input bit
+ * pattern and holds func((q - zp) * scale) quantized to the output.
+ */
+int shl_rvv_siso_lut_init_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                               struct csinn_params_base *base, float (*func)(float))
+{
+    if (input->quant_channel > 1 || output->quant_channel > 1) {
+        return CSINN_FALSE;
+    }
+    const float in_scale = input->qinfo->scale;
+    const int32_t in_zp = input->qinfo->zero_point;
+    const float out_scale = output->qinfo->scale;
+    const int32_t out_zp = output->qinfo->zero_point;
+
+    int8_t *lut = base->lut;
+    if (lut == NULL) {
+        lut = (int8_t *)shl_mem_alloc(256 * sizeof(int8_t));
+        base->lut = lut;
+    }
+    for (int i = 0; i < 256; i++) {
+        int8_t q = (int8_t)i;
+        float y = func((q - in_zp) * in_scale);
+        float r = roundf(y / out_scale) + out_zp;
+        lut[i] = (int8_t)(r > 127.0f ? 127 : (r < -128.0f ? -128 : r));
+    }
+    base->cb->exec = shl_rvv_siso_lut_int8;
+    return CSINN_TRUE;
+}
+
+int shl_rvv_siso_lut_int8(struct csinn_tensor *input, struct csinn_tensor *output,
+                          struct csinn_params_base *base)
+{
+    const uint8_t *input_data = (uint8_t *)input->data;
+    int8_t *output_data = (int8_t *)output->data;
+    const int8_t *lut = base->lut;
+    int size = csinn_tensor_size(input);
+    /*
+     * vrgather indexes at most one register group, 128 bytes at e8m8 with VLEN 128. The table
+     * is gathered as two halves by the low 7 bits and merged on bit 7 of the index.
+     */
+    int half = vsetvl_e8m8(128);
+    if (half < 128) {
+        for (int i = 0; i < size; i++) {
+            output_data[i] = lut[input_data[i]];
+        }
+        return CSINN_TRUE;
+    }
+    vint8m8_t _lut_lo = vle8_v_i8m8(lut, half);
+    vint8m8_t _lut_hi = vle8_v_i8m8(lut + 128, half);
+    while (size > 0) {
+        int vl = vsetvl_e8m8(size);
+        vuint8m8_t _idx = vle8_v_u8m8(input_data, vl);
+        vbool1_t _upper = vmsgeu_vx_u8m8_b1(_idx, 128, vl);
+        _idx = vand_vx_u8m8(_idx, 127, vl);
+        vint8m8_t _lo = vrgather_vv_i8m8(_lut_lo, _idx, vl);
+        vint8m8_t _hi = vrgather_vv_i8m8(_lut_hi, _idx, vl);
+        vse8_v_i8m8(output_data, vmerge_vvm_i8m8(_upper, _lo, _hi, vl), vl);
+        input_data += vl;
+        output_data += vl;
+        size -= vl;
+    }
+    return CSINN_TRUE;
+}
+
 /********************* int4 easter eggs *********************/
 void shl_rvv_pad_input_int4_trans_int8(const int8_t *input, int8_t *input_padded, int inc, int inh,
                                        int inw, int padded_h, int padded_w, int pad_top,
@@ -0,0 +1,572 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "csi_nn.h"
+#include "shl_utils.h"
+
+#ifdef SHL_AVX_OPT
+#include <immintrin.h>
+#elif __riscv_vector
+#include <riscv_vector.h>
+#endif
+
+/*
+ * Row kernels behind csinn_tensor_data_convert. They give bit-identical results to the
+ * scalar formulas in nn2/utils.c: x / scale is rounded half away from zero, zero point is
+ * added and the result saturates; dequantization is (q - zp) * scale.
+ *
+ * scale and zp either hold a single value for the whole row, or, with channel_last set,
+ * one value per element (used for per-channel NHWC data where the channel is innermost).
+ */
+
+/* elements handled by one OpenMP task */
+#define SHL_CONVERT_BLOCK 16384
+
+static inline float quantize_round(float x, float scale, float zp, float min, float max)
+{
+    float ret = round(x / scale) + zp;
+    if (ret > max) {
+        return max;
+    } else if (ret < min) {
+        return min;
+    } else {
+        return ret;
+    }
+}
+
+#ifdef SHL_AVX_OPT
+/* round(x / scale) + zp, saturated to [min, max], 8 lanes */
+static inline __m256i quantize_avx(__m256 _x, __m256 _scale, __m256 _zp, __m256 _min, __m256 _max)
+{
+    const __m256 _half = _mm256_set1_ps(0.5f);
+    const __m256 _one = _mm256_set1_ps(1.0f);
+    __m256 _y = _mm256_div_ps(_x, _scale);
+    __m256 _t = _mm256_round_ps(_y, _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC);
+    __m256 _d = _mm256_sub_ps(_y, _t);
+    __m256 _up = _mm256_and_ps(_mm256_cmp_ps(_d, _half, _CMP_GE_OQ), _one);
+    __m256 _down = _mm256_and_ps(_mm256_cmp_ps(_d, _mm256_sub_ps(_mm256_setzero_ps(), _half),
+                                               _CMP_LE_OQ),
+                                 _one);
+    _t = _mm256_add_ps(_mm256_sub_ps(_t, _down), _up);
+    _t = _mm256_add_ps(_t, _zp);
+    _t = _mm256_min_ps(_mm256_max_ps(_t, _min), _max);
+    return _mm256_cvttps_epi32(_t);
+}
+
+static inline __m256 load_param_avx(const float *param, int64_t i, bool channel_last)
+{
+    return channel_last ? _mm256_loadu_ps(param + i) : _mm256_set1_ps(param[0]);
+}
+#elif __riscv_vector
+/* round(x / scale) + zp, saturated to [min, max] */
+static inline vint32m4_t quantize_rvv(vfloat32m4_t _x, vfloat32m4_t _scale, vfloat32m4_t _zp,
+                                      float min, float max, int vl)
+{
+    vfloat32m4_t _y = vfdiv_vv_f32m4(_x, _scale, vl);
+    /* keep the truncation inside int32, the result saturates far below that anyway */
+    _y = vfmin_vf_f32m4(vfmax_vf_f32m4(_y, -1073741824.0f, vl), 1073741824.0f, vl);
+    vint32m4_t _t = vfcvt_rtz_x_f_v_i32m4(_y, vl);
+    vfloat32m4_t _d = vfsub_vv_f32m4(_y, vfcvt_f_x_v_f32m4(_t, vl), vl);
+    vbool8_t _up = vmfge_vf_f32m4_b8(_d, 0.5f, vl);
+    vbool8_t _down = vmfle_vf_f32m4_b8(_d, -0.5f, vl);
+    _t = vadd_vx_i32m4_m(_up, _t, _t, 1, vl);
+    _t = vsub_vx_i32m4_m(_down, _t, _t, 1, vl);
+    vfloat32m4_t _q = vfadd_vv_f32m4(vfcvt_f_x_v_f32m4(_t, vl), _zp, vl);
+    _q = vfmin_vf_f32m4(vfmax_vf_f32m4(_q, min, vl), max, vl);
+    return vfcvt_rtz_x_f_v_i32m4(_q, vl);
+}
+
+static inline vfloat32m4_t load_param_rvv(const float *param, int64_t i, bool channel_last, int vl)
+{
+    return channel_last ? vle32_v_f32m4(param + i, vl) : vfmv_v_f_f32m4(param[0], vl);
+}
+#endif
+
+static void quantize_f32_to_u8_block(float *src, uint8_t *dst, int64_t size, float *scale,
+                                     float *zp, bool channel_last)
+{
+    int64_t i = 0;
+#ifdef SHL_AVX_OPT
+    const __m256 _min = _mm256_set1_ps(0.0f);
+    const __m256 _max = _mm256_set1_ps(255.0f);
+    for (; i + 8 <= size; i += 8) {
+        __m256i _q = quantize_avx(_mm256_loadu_ps(src + i), load_param_avx(scale, i, channel_last),
+                                  load_param_avx(zp, i, channel_last), _min, _max);
+        __m128i _w = _mm_packs_epi32(_mm256_castsi256_si128(_q), _mm256_extractf128_si256(_q, 1));
+        _mm_storel_epi64((__m128i *)(dst + i), _mm_packus_epi16(_w, _w));
+    }
+#elif __riscv_vector
+    while (i < size) {
+        int vl = vsetvl_e32m4(size - i);
+        vint32m4_t _q = quantize_rvv(vle32_v_f32m4(src + i, vl),
+                                     load_param_rvv(scale, i, channel_last, vl),
+                                     load_param_rvv(zp, i, channel_last, vl), 0.0f, 255.0f, vl);
+        vuint16m2_t _w = vnsrl_wx_u16m2(vreinterpret_v_i32m4_u32m4(_q), 0, vl);
+        vse8_v_u8m1(dst + i, vnsrl_wx_u8m1(_w, 0, vl), vl);
+        i += vl;
+    }
+#endif
+    for (; i < size; i++) {
+        int64_t p = channel_last ? i : 0;
+        dst[i] = quantize_round(src[i], scale[p], zp[p], 0, 255);
+    }
+}
+
+static void quantize_f32_to_i8_block(float *src, int8_t *dst, int64_t size, float *scale,
+                                     float *zp, bool channel_last)
+{
+    int64_t i = 0;
+#ifdef SHL_AVX_OPT
+    const __m256 _min = _mm256_set1_ps(-128.0f);
+    const __m256 _max = _mm256_set1_ps(127.0f);
+    for (; i + 8 <= size; i += 8) {
+        __m256i _q = quantize_avx(_mm256_loadu_ps(src + i), load_param_avx(scale, i, channel_last),
+                                  load_param_avx(zp, i, channel_last), _min, _max);
+        __m128i _w = _mm_packs_epi32(_mm256_castsi256_si128(_q), _mm256_extractf128_si256(_q, 1));
+        _mm_storel_epi64((__m128i *)(dst + i), _mm_packs_epi16(_w, _w));
+    }
+#elif __riscv_vector
+    while (i < size) {
+        int vl = vsetvl_e32m4(size - i);
+        vint32m4_t _q = quantize_rvv(vle32_v_f32m4(src + i, vl),
+                                     load_param_rvv(scale, i, channel_last, vl),
+                                     load_param_rvv(zp, i, channel_last, vl), -128.0f, 127.0f, vl);
+        vint16m2_t _w = vnsra_wx_i16m2(_q, 0, vl);
+        vse8_v_i8m1(dst + i, vnsra_wx_i8m1(_w, 0, vl), vl);
+        i += vl;
+    }
+#endif
+    for (; i < size; i++) {
+        int64_t p = channel_last ? i : 0;
+        dst[i] = quantize_round(src[i], scale[p], zp[p], -128, 127);
+    }
+}
+
+static void quantize_f32_to_i16_block(float *src, int16_t *dst, int64_t size, float *scale,
+                                      float *zp, bool channel_last)
+{
+    int64_t i = 0;
+#ifdef SHL_AVX_OPT
+    const __m256 _min = _mm256_set1_ps(-32768.0f);
+    const __m256 _max = _mm256_set1_ps(32767.0f);
+    for (; i + 8 <= size; i += 8) {
+        __m256i _q = quantize_avx(_mm256_loadu_ps(src + i), load_param_avx(scale, i, channel_last),
+                                  load_param_avx(zp, i, channel_last), _min, _max);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packs_epi32(_mm256_castsi256_si128(_q),
+                                                               _mm256_extractf128_si256(_q, 1)));
+    }
+#elif __riscv_vector
+    while (i < size) {
+        int vl = vsetvl_e32m4(size - i);
+        vint32m4_t _q =
+            quantize_rvv(vle32_v_f32m4(src + i, vl), load_param_rvv(scale, i, channel_last, vl),
+                         load_param_rvv(zp, i, channel_last, vl), -32768.0f, 32767.0f, vl);
+        vse16_v_i16m2(dst + i, vnsra_wx_i16m2(_q, 0, vl), vl);
+        i += vl;
+    }
+#endif
+    for (; i < size; i++) {
+        int64_t p = channel_last ? i : 0;
+        dst[i] = quantize_round(src[i], scale[p], zp[p], -32768, 32767);
+    }
+}
+
+static void dequantize_u8_to_f32_block(uint8_t *src, float *dst, int64_t size, float *scale,
+                                       float *zp, bool channel_last)
+{
+    int64_t i = 0;
+#ifdef SHL_AVX_OPT
+    for (; i + 8 <= size; i += 8) {
+        __m128i _in = _mm_loadl_epi64((__m128i *)(src + i));
+        __m256i _w = _mm256_insertf128_si256(_mm256_castsi128_si256(_mm_cvtepu8_epi32(_in)),
+                                             _mm_cvtepu8_epi32(_mm_srli_si128(_in, 4)), 1);
+        __m256 _f = _mm256_sub_ps(_mm256_cvtepi32_ps(_w), load_param_avx(zp, i, channel_last));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_f, load_param_avx(scale, i, channel_last)));
+    }
+#elif __riscv_vector
+    while (i < size) {
+        int vl = vsetvl_e32m4(size - i);
+        vuint16m2_t _w = vwaddu_vx_u16m2(vle8_v_u8m1(src + i, vl), 0, vl);
+        vfloat32m4_t _f = vfcvt_f_xu_v_f32m4(vwaddu_vx_u32m4(_w, 0, vl), vl);
+        _f = vfsub_vv_f32m4(_f, load_param_rvv(zp, i, channel_last, vl), vl);
+        vse32_v_f32m4(dst + i, vfmul_vv_f32m4(_f, load_param_rvv(scale, i, channel_last, vl), vl),
+                      vl);
+        i += vl;
+    }
+#endif
+    for (; i < size; i++) {
+        int64_t p = channel_last ? i : 0;
+        dst[i] = ((float)src[i] - zp[p]) * scale[p];
+    }
+}
+
+static void dequantize_i8_to_f32_block(int8_t *src, float *dst, int64_t size, float *scale,
+                                       float *zp, bool channel_last)
+{
+    int64_t i = 0;
+#ifdef SHL_AVX_OPT
+    for (; i + 8 <= size; i += 8) {
+        __m128i _in = _mm_loadl_epi64((__m128i *)(src + i));
+        __m256i _w = _mm256_insertf128_si256(_mm256_castsi128_si256(_mm_cvtepi8_epi32(_in)),
+                                             _mm_cvtepi8_epi32(_mm_srli_si128(_in, 4)), 1);
+        __m256 _f = _mm256_sub_ps(_mm256_cvtepi32_ps(_w), load_param_avx(zp, i, channel_last));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_f, load_param_avx(scale, i, channel_last)));
+    }
+#elif __riscv_vector
+    while (i < size) {
+        int vl = vsetvl_e32m4(size - i);
+        vint16m2_t _w = vwadd_vx_i16m2(vle8_v_i8m1(src + i, vl), 0, vl);
+        vfloat32m4_t _f = vfcvt_f_x_v_f32m4(vwadd_vx_i32m4(_w, 0, vl), vl);
+        _f = vfsub_vv_f32m4(_f, load_param_rvv(zp, i, channel_last, vl), vl);
+        vse32_v_f32m4(dst + i, vfmul_vv_f32m4(_f, load_param_rvv(scale, i, channel_last, vl), vl),
+                      vl);
+        i += vl;
+    }
+#endif
+    for (; i < size; i++) {
+        int64_t p = channel_last ? i : 0;
+        dst[i] = ((float)src[i] - zp[p]) * scale[p];
+    }
+}
+
+static void dequantize_i16_to_f32_block(int16_t *src, float *dst, int64_t size, float *scale,
+                                        float *zp, bool channel_last)
+{
+    int64_t i = 0;
+#ifdef SHL_AVX_OPT
+    for (; i + 8 <= size; i += 8) {
+        __m128i _in = _mm_loadu_si128((__m128i *)(src + i));
+        __m256i _w = _mm256_insertf128_si256(_mm256_castsi128_si256(_mm_cvtepi16_epi32(_in)),
+                                             _mm_cvtepi16_epi32(_mm_srli_si128(_in, 8)), 1);
+        __m256 _f = _mm256_sub_ps(_mm256_cvtepi32_ps(_w), load_param_avx(zp, i, channel_last));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_f, load_param_avx(scale, i, channel_last)));
+    }
+#elif __riscv_vector
+    while (i < size) {
+        int vl = vsetvl_e32m4(size - i);
+        vfloat32m4_t _f = vfcvt_f_x_v_f32m4(vwadd_vx_i32m4(vle16_v_i16m2(src + i, vl), 0, vl), vl);
+        _f = vfsub_vv_f32m4(_f, load_param_rvv(zp, i, channel_last, vl), vl);
+        vse32_v_f32m4(dst + i, vfmul_vv_f32m4(_f, load_param_rvv(scale, i, channel_last, vl), vl),
+                      vl);
+        i += vl;
+    }
+#endif
+    for (; i < size; i++) {
+        int64_t p = channel_last ? i : 0;
+        dst[i] = ((float)src[i] - zp[p]) * scale[p];
+    }
+}
+
+/* int32 data has no zero point */
+static void dequantize_i32_to_f32_block(int32_t *src, float *dst, int64_t size, float *scale,
+                                        float *zp, bool channel_last)
+{
+    int64_t i = 0;
+#ifdef SHL_AVX_OPT
+    for (; i + 8 <= size; i += 8) {
+        __m256 _f = _mm256_cvtepi32_ps(_mm256_loadu_si256((__m256i *)(src + i)));
+        _mm256_storeu_ps(dst + i, _mm256_mul_ps(_f, load_param_avx(scale, i, channel_last)));
+    }
+#elif __riscv_vector
+    while (i < size) {
+        int vl = vsetvl_e32m4(size - i);
+        vfloat32m4_t _f = vfcvt_f_x_v_f32m4(vle32_v_i32m4(src + i, vl), vl);
+        vse32_v_f32m4(dst + i, vfmul_vv_f32m4(_f, load_param_rvv(scale, i, channel_last, vl), vl),
+                      vl);
+        i += vl;
+    }
+#endif
+    for (; i < size; i++) {
+        int64_t p = channel_last ? i : 0;
+        dst[i] = (float)src[i] * scale[p];
+    }
+}
+
+void shl_quantize_f32_to_u8(float *src, uint8_t *dst, int64_t size, float *scale, float *zp,
+                            bool channel_last, int thread_num)
+{
+#pragma omp parallel for num_threads(thread_num) if (size >= 2 * SHL_CONVERT_BLOCK)
+    for (int64_t b = 0; b < size; b += SHL_CONVERT_BLOCK) {
+        int64_t len = size - b < SHL_CONVERT_BLOCK ? size - b : SHL_CONVERT_BLOCK;
+        int64_t p = channel_last ? b : 0;
+        quantize_f32_to_u8_block(src + b, dst + b, len, scale + p, zp + p, channel_last);
+    }
+}
+
+void shl_quantize_f32_to_i8(float *src, int8_t *dst, int64_t size, float *scale, float *zp,
+                            bool channel_last, int thread_num)
+{
+#pragma omp parallel for num_threads(thread_num) if (size >= 2 * SHL_CONVERT_BLOCK)
+    for (int64_t b = 0; b < size; b += SHL_CONVERT_BLOCK) {
+        int64_t len = size - b < SHL_CONVERT_BLOCK ? size - b : SHL_CONVERT_BLOCK;
+        int64_t p = channel_last ? b : 0;
+        quantize_f32_to_i8_block(src + b, dst + b, len, scale + p, zp + p, channel_last);
+    }
+}
+
+void shl_quantize_f32_to_i16(float *src, int16_t *dst, int64_t size, float *scale, float *zp,
+                             bool channel_last, int thread_num)
+{
+#pragma omp parallel for num_threads(thread_num) if (size >= 2 * SHL_CONVERT_BLOCK)
+    for (int64_t b = 0; b < size; b += SHL_CONVERT_BLOCK) {
+        int64_t len = size - b < SHL_CONVERT_BLOCK ? size - b : SHL_CONVERT_BLOCK;
+        int64_t p = channel_last ? b : 0;
+        quantize_f32_to_i16_block(src + b, dst + b, len, scale + p, zp + p, channel_last);
+    }
+}
+
+void shl_dequantize_u8_to_f32(uint8_t *src, float *dst, int64_t size, float *scale, float *zp,
+                              bool channel_last, int thread_num)
+{
+#pragma omp parallel for num_threads(thread_num) if (size >= 2 * SHL_CONVERT_BLOCK)
+    for (int64_t b = 0; b < size; b += SHL_CONVERT_BLOCK) {
+        int64_t len = size - b < SHL_CONVERT_BLOCK ? size - b : SHL_CONVERT_BLOCK;
+        int64_t p = channel_last ? b : 0;
+        dequantize_u8_to_f32_block(src + b, dst + b, len, scale + p, zp + p, channel_last);
+    }
+}
+
+void shl_dequantize_i8_to_f32(int8_t *src, float *dst, int64_t size, float *scale, float *zp,
+                              bool channel_last, int thread_num)
+{
+#pragma omp parallel for num_threads(thread_num) if (size >= 2 * SHL_CONVERT_BLOCK)
+    for (int64_t b = 0; b < size; b += SHL_CONVERT_BLOCK) {
+        int64_t len = size - b < SHL_CONVERT_BLOCK ? size - b : SHL_CONVERT_BLOCK;
+        int64_t p = channel_last ? b : 0;
+        dequantize_i8_to_f32_block(src + b, dst + b, len, scale + p, zp + p, channel_last);
+    }
+}
+
+void shl_dequantize_i16_to_f32(int16_t *src, float *dst, int64_t size, float *scale, float *zp,
+                               bool channel_last, int thread_num)
+{
+#pragma omp parallel for num_threads(thread_num) if (size >= 2 * SHL_CONVERT_BLOCK)
+    for (int64_t b = 0; b < size; b += SHL_CONVERT_BLOCK) {
+        int64_t len = size - b < SHL_CONVERT_BLOCK ? size - b : SHL_CONVERT_BLOCK;
+        int64_t p = channel_last ? b : 0;
+        dequantize_i16_to_f32_block(src + b, dst + b, len, scale + p, zp + p, channel_last);
+    }
+}
+
+void shl_dequantize_i32_to_f32(int32_t *src, float *dst, int64_t size, float *scale, float *zp,
+                               bool channel_last, int thread_num)
+{
+#pragma omp parallel for num_threads(thread_num) if (size >= 2 * SHL_CONVERT_BLOCK)
+    for (int64_t b = 0; b < size; b += SHL_CONVERT_BLOCK) {
+        int64_t len = size - b < SHL_CONVERT_BLOCK ? size - b : SHL_CONVERT_BLOCK;
+        int64_t p = channel_last ? b : 0;
+        dequantize_i32_to_f32_block(src + b, dst + b, len, scale + p, zp + p, channel_last);
+    }
+}
+
+/*
+ * fp16 here is the truncating format of nn2/utils.c: values closer to zero than 6.1e-5
+ * flush to zero, larger than 65504 saturate, and the mantissa is cut instead of rounded.
+ */
+static inline int16_t f32_to_f16_scalar(float value, float tiny)
+{
+    if (value >= -tiny && value <= tiny) {
+        return 0;
+    }
+    if (value > 65504) {
+        value = 65504;
+    }
+    int32_t org_format = *(int32_t *)&value;
+    int16_t sign = (org_format & 0x80000000) >> 16;
+    int16_t frac = (org_format & 0x7fffff) >> 13;
+    int16_t exp = (((((org_format >> 23) & 0xff) - 128) + 16) & 0x1f) << 10;
+    return sign | frac | exp;
+}
+
+static inline float f16_to_f32_scalar(int16_t value)
+{
+    if (value == 0) {
+        return 0;
+    }
+    int32_t sign = (value & 0x8000) << 16;
+    int32_t frac = (value & 0x3ff) << 13;
+    int32_t exp = (((((value >> 10) & 0x1f) - 16) + 128) & 0xff) << 23;
+    int32_t ret_format = sign | frac | exp;
+    return *(float *)&ret_format;
+}
+
+/* largest float that still compares below 6.1e-5 in double precision */
+static float f16_tiny_threshold()
+{
+    float tiny = 6.1e-5f;
+    while ((double)tiny >= 6.1e-5) {
+        tiny = nextafterf(tiny, 0.0f);
+    }
+    return tiny;
+}
+
+static int f32_to_f16_block(float *src, int16_t *dst, int64_t size, float tiny)
+{
+    int overflow = 0;
+    int64_t i = 0;
+#ifdef SHL_AVX_OPT
+    const __m128 _tiny = _mm_set1_ps(tiny);
+    const __m128 _ntiny = _mm_set1_ps(-tiny);
+    const __m128 _big = _mm_set1_ps(65504.0f);
+    for (; i + 4 <= size; i += 4) {
+        __m128 _x = _mm_loadu_ps(src + i);
+        __m128 _zero = _mm_and_ps(_mm_cmpge_ps(_x, _ntiny), _mm_cmple_ps(_x, _tiny));
+        __m128 _over = _mm_cmpgt_ps(_x, _big);
+        overflow |= _mm_movemask_ps(_over);
+        _x = _mm_blendv_ps(_x, _big, _over);
+        __m128i _bits = _mm_castps_si128(_x);
+        __m128i _sign = _mm_srli_epi32(_mm_and_si128(_bits, _mm_set1_epi32(0x80000000)), 16);
+        __m128i _frac = _mm_srli_epi32(_mm_and_si128(_bits, _mm_set1_epi32(0x7fffff)), 13);
+        __m128i _exp = _mm_and_si128(_mm_srli_epi32(_bits, 23), _mm_set1_epi32(0xff));
+        _exp = _mm_and_si128(_mm_sub_epi32(_exp, _mm_set1_epi32(112)), _mm_set1_epi32(0x1f));
+        __m128i _h = _mm_or_si128(_mm_or_si128(_sign, _frac), _mm_slli_epi32(_exp, 10));
+        _h = _mm_andnot_si128(_mm_castps_si128(_zero), _h);
+        _mm_storel_epi64((__m128i *)(dst + i), _mm_packus_epi32(_h, _h));
+    }
+#elif __riscv_vector
+    while (i < size) {
+        int vl = vsetvl_e32m4(size - i);
+        vfloat32m4_t _x = vle32_v_f32m4(src + i, vl);
+        vbool8_t _zero = vmand_mm_b8(vmfge_vf_f32m4_b8(_x, -tiny, vl),
+                                     vmfle_vf_f32m4_b8(_x, tiny, vl), vl);
+        vbool8_t _over = vmfgt_vf_f32m4_b8(_x, 65504.0f, vl);
+        overflow |= vfirst_m_b8(_over, vl) >= 0;
+        _x = vfmerge_vfm_f32m4(_over, _x, 65504.0f, vl);
+        vuint32m4_t _bits = vreinterpret_v_f32m4_u32m4(_x);
+        vuint32m4_t _sign = vsrl_vx_u32m4(vand_vx_u32m4(_bits, 0x80000000, vl), 16, vl);
+        vuint32m4_t _frac = vsrl_vx_u32m4(vand_vx_u32m4(_bits, 0x7fffff, vl), 13, vl);
+        vuint32m4_t _exp = vand_vx_u32m4(vsrl_vx_u32m4(_bits, 23, vl), 0xff, vl);
+        _exp = vand_vx_u32m4(vsub_vx_u32m4(_exp, 112, vl), 0x1f, vl);
+        vuint32m4_t _h = vor_vv_u32m4(vor_vv_u32m4(_sign, _frac, vl), vsll_vx_u32m4(_exp, 10, vl),
+                                      vl);
+        _h = vmerge_vxm_u32m4(_zero, _h, 0, vl);
+        vse16_v_u16m2((uint16_t *)(dst + i), vnsrl_wx_u16m2(_h, 0, vl), vl);
+        i += vl;
+    }
+#endif
+    for (; i < size; i++) {
+        overflow |= src[i] > 65504;
+        dst[i] = f32_to_f16_scalar(src[i], tiny);
+    }
+    return overflow;
+}
+
+static void f16_to_f32_block(int16_t *src, float *dst, int64_t size)
+{
+    int64_t i = 0;
+#ifdef SHL_AVX_OPT
+    for (; i + 4 <= size; i += 4) {
+        __m128i _v = _mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i *)(src + i)));
+        __m128i _sign = _mm_slli_epi32(_mm_and_si128(_v, _mm_set1_epi32(0x8000)), 16);
+        __m128i _frac = _mm_slli_epi32(_mm_and_si128(_v, _mm_set1_epi32(0x3ff)), 13);
+        __m128i _exp = _mm_and_si128(_mm_srai_epi32(_v, 10), _mm_set1_epi32(0x1f));
+        _exp = _mm_and_si128(_mm_add_epi32(_exp, _mm_set1_epi32(112)), _mm_set1_epi32(0xff));
+        __m128i _f = _mm_or_si128(_mm_or_si128(_sign, _frac), _mm_slli_epi32(_exp, 23));
+        _f = _mm_andnot_si128(_mm_cmpeq_epi32(_v, _mm_setzero_si128()), _f);
+        _mm_storeu_ps(dst + i, _mm_castsi128_ps(_f));
+    }
+#elif __riscv_vector
+    while (i < size) {
+        int vl = vsetvl_e32m4(size - i);
+        vuint32m4_t _v = vwaddu_vx_u32m4(vle16_v_u16m2((uint16_t *)(src + i), vl), 0, vl);
+        vuint32m4_t _sign = vsll_vx_u32m4(vand_vx_u32m4(_v, 0x8000, vl), 16, vl);
+        vuint32m4_t _frac = vsll_vx_u32m4(vand_vx_u32m4(_v, 0x3ff, vl), 13, vl);
+        vuint32m4_t _exp = vand_vx_u32m4(vsrl_vx_u32m4(_v, 10, vl), 0x1f, vl);
+        _exp = vand_vx_u32m4(vadd_vx_u32m4(_exp, 112, vl), 0xff, vl);
+        vuint32m4_t _f = vor_vv_u32m4(vor_vv_u32m4(_sign, _frac, vl), vsll_vx_u32m4(_exp, 23, vl),
+                                      vl);
+        _f = vmerge_vxm_u32m4(vmseq_vx_u32m4_b8(_v, 0, vl), _f, 0, vl);
+        vse32_v_f32m4(dst + i, vreinterpret_v_u32m4_f32m4(_f), vl);
+        i += vl;
+    }
+#endif
+    for (; i < size; i++) {
+        dst[i] = f16_to_f32_scalar(src[i]);
+    }
+}
+
+void shl_f32_to_f16(float *src, int16_t *dst, int64_t size, int thread_num)
+{
+    float tiny = f16_tiny_threshold();
+    int overflow = 0;
+#pragma omp parallel for num_threads(thread_num) \
+    if (size >= 2 * SHL_CONVERT_BLOCK) reduction(| : overflow)
+    for (int64_t b = 0; b < size; b += SHL_CONVERT_BLOCK) {
+        int64_t len = size - b < SHL_CONVERT_BLOCK ? size - b : SHL_CONVERT_BLOCK;
+        overflow |= f32_to_f16_block(src + b, dst + b, len, tiny);
+    }
+    if (overflow) {
+        shl_debug_error("too large f32 to f16\n");
+    }
+}
+
+void shl_f16_to_f32(int16_t *src, float *dst, int64_t size, int thread_num)
+{
+#pragma omp parallel for num_threads(thread_num) if (size >= 2 * SHL_CONVERT_BLOCK)
+    for (int64_t b = 0; b < size; b += SHL_CONVERT_BLOCK) {
+        int64_t len = size - b < SHL_CONVERT_BLOCK ? size - b : SHL_CONVERT_BLOCK;
+        f16_to_f32_block(src + b, dst + b, len);
+    }
+}
+
+/* bf16 keeps the upper half of the f32 bits */
+void shl_f32_to_bf16(float *src, int16_t *dst, int64_t size)
+{
+    int32_t *bits = (int32_t *)src;
+    int64_t i = 0;
+#ifdef SHL_AVX_OPT
+    for (; i + 8 <= size; i += 8) {
+        __m128i _lo = _mm_srai_epi32(_mm_loadu_si128((__m128i *)(bits + i)), 16);
+        __m128i _hi = _mm_srai_epi32(_mm_loadu_si128((__m128i *)(bits + i + 4)), 16);
+        _mm_storeu_si128((__m128i *)(dst + i), _mm_packs_epi32(_lo, _hi));
+    }
+#elif __riscv_vector
+    while (i < size) {
+        int vl = vsetvl_e32m4(size - i);
+        vse16_v_i16m2(dst + i, vnsra_wx_i16m2(vle32_v_i32m4(bits + i, vl), 16, vl), vl);
+        i += vl;
+    }
+#endif
+    for (; i < size; i++) {
+        dst[i] = (bits[i] & 0xffff0000) >> 16;
+    }
+}
+
+void shl_bf16_to_f32(int16_t *src, float *dst, int64_t size)
+{
+    int32_t *bits = (int32_t *)dst;
+    int64_t i = 0;
+#ifdef SHL_AVX_OPT
+    for (; i + 4 <= size; i += 4) {
+        __m128i _v = _mm_cvtepi16_epi32(_mm_loadl_epi64((__m128i *)(src + i)));
+        _mm_storeu_si128((__m128i *)(bits + i), _mm_slli_epi32(_v, 16));
+    }
+#elif __riscv_vector
+    while (i < size) {
+        int vl = vsetvl_e32m4(size - i);
+        vint32m4_t _v = vwadd_vx_i32m4(vle16_v_i16m2(src + i, vl), 0, vl);
+        vse32_v_i32m4(bits + i, vsll_vx_i32m4(_v, 16, vl), vl);
+        i += vl;
+    }
+#endif
+    for (; i < size; i++) {
+        bits[i] = src[i] << 16;
+    }
+}
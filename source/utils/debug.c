@@ -595,6 +595,24 @@ int shl_matmul_debug_info(struct csinn_tensor *mat0, struct csinn_tensor *mat1,
     return CSINN_TRUE;
 }
 
+int shl_scaled_dot_product_attention_debug_info(
+    struct csinn_tensor *query, struct csinn_tensor *key, struct csinn_tensor *value,
+    struct csinn_tensor *mask, struct csinn_tensor *output,
+    struct csinn_scaled_dot_product_attention_params *params, const char *name)
+{
+    shl_debug_info("%s = %s(", output->name, name);
+    shl_debug_print_tensor(query);
+    shl_debug_print_tensor(key);
+    shl_debug_print_tensor(value);
+    if (mask != NULL && mask->dim_count > 0) {
+        shl_debug_print_tensor(mask);
+    }
+    shl_debug_print_params_base(&(params->base));
+    shl_debug_info("norm_factor=%f, causal=%d", params->norm_factor, params->causal);
+    shl_debug_info(")\n");
+    return CSINN_TRUE;
+}
+
 int shl_ndarray_size_debug_info(struct csinn_tensor *input, struct csinn_tensor *output,
                                 struct csinn_ndarray_size_params *params, const char *name)
 {
@@ -608,8 +626,8 @@ int shl_nms_debug_info(struct csinn_tensor *input0, struct csinn_tensor *input1,
                        const char *name)
 {
     shl_debug_print_diso_base(input0, input1, output, &(params->base), name);
-    shl_debug_info("max_output_size=%d, iou_threshold=%f", params->max_output_size,
-                   params->iou_threshold);
+    shl_debug_info("max_output_size=%d, iou_threshold=%f, score_threshold=%f",
+                   params->max_output_size, params->iou_threshold, params->score_threshold);
     shl_debug_info(")\n");
     return CSINN_TRUE;
 }
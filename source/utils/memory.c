@@ -39,6 +39,18 @@ struct shl_mem_alloc_debug_map_ {
 
 static struct shl_mem_alloc_debug_map_ shl_mem_alloc_debug_map;
 
+static struct shl_mem_stats shl_mem_stats_counter;
+
+/* RTOS targets are single core and may lack 64-bit atomics */
+#ifdef SHL_BUILD_RTOS
+#define SHL_MEM_STATS_ADD(field, value) (shl_mem_stats_counter.field += (value))
+#else
+#define SHL_MEM_STATS_ADD(field, value) \
+    __atomic_fetch_add(&shl_mem_stats_counter.field, (value), __ATOMIC_RELAXED)
+#endif
+
+void shl_mem_get_stats(struct shl_mem_stats *stats) { *stats = shl_mem_stats_counter; }
+
 void shl_mem_print_map()
 {
     printf("total size = %ld\n", shl_mem_alloc_debug_map.total_size);
@@ -90,6 +102,8 @@ void *shl_mem_alloc(int64_t size)
     if (ret == NULL) {
         shl_debug_error("cannot alloc memory\n");
     }
+    SHL_MEM_STATS_ADD(alloc_count, 1);
+    SHL_MEM_STATS_ADD(alloc_bytes, size);
 #ifdef SHL_MEM_DEBUG
     shl_mem_map_insert(ret, size);
     shl_mem_alloc_debug_map.total_size += size;
@@ -126,12 +140,17 @@ void *shl_mem_alloc_aligned(int64_t size, int aligned_bytes)
     }
     int ret = posix_memalign(&ptr, aligned_bytes, size);
     if (ret || ptr == NULL) shl_debug_error("cannot alloc aligned memory\n");
+    SHL_MEM_STATS_ADD(alloc_count, 1);
+    SHL_MEM_STATS_ADD(alloc_bytes, size);
 #endif
     return ptr;
 }
 
 void shl_mem_free(void *ptr)
 {
+    if (ptr != NULL) {
+        SHL_MEM_STATS_ADD(free_count, 1);
+    }
 #ifdef SHL_MEM_DEBUG
     for (int i = 0; i < shl_mem_alloc_debug_map.index; i++) {
         struct shl_mem_alloc_debug_element_ *e = shl_mem_alloc_debug_map.element + i;
@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "csi_nn.h"
+#include "shl_utils.h"
+
+/*************************************************************
+ * Structured sparse weights, CSINN_MEM_TYPE_ASP42 / ASP41.
+ * A weight tensor is seen as rows = dim[0] by K = the product of
+ * the other dims, in the tensor's own layout. Every group of 4
+ * consecutive weights in a row keeps at most 2 (ASP42) or 1 (ASP41).
+ *
+ * data: values [rows, groups, keep] in the tensor dtype,
+ *       then index [rows, groups] of uint8
+ * groups = ceil(K / 4), keep = 2 or 1
+ * index byte: position of kept value j in bits [2j, 2j + 1]
+ * unused slots hold the zero value (the zero point when quantized)
+ * at position 0, so kernels never need to test them.
+ *************************************************************/
+
+int shl_sparse_keep(enum csinn_mem_type_enum mtype)
+{
+    if (mtype == CSINN_MEM_TYPE_ASP42) {
+        return 2;
+    } else if (mtype == CSINN_MEM_TYPE_ASP41) {
+        return 1;
+    }
+    return 0;
+}
+
+static int sparse_elem_size(enum csinn_dtype_enum dtype)
+{
+    switch (dtype) {
+        case CSINN_DTYPE_FLOAT32:
+            return 4;
+        case CSINN_DTYPE_FLOAT16:
+        case CSINN_DTYPE_BFLOAT16:
+        case CSINN_DTYPE_INT16:
+            return 2;
+        case CSINN_DTYPE_UINT8:
+        case CSINN_DTYPE_INT8:
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+int32_t shl_sparse_groups(struct csinn_tensor *t)
+{
+    int64_t inner = csinn_tensor_size(t) / t->dim[0];
+    return (inner + 3) / 4;
+}
+
+int64_t shl_sparse_byte_size(struct csinn_tensor *t)
+{
+    int64_t groups = (int64_t)t->dim[0] * shl_sparse_groups(t);
+    return groups * shl_sparse_keep(t->mtype) * sparse_elem_size(t->dtype) + groups;
+}
+
+uint8_t *shl_sparse_index(struct csinn_tensor *t)
+{
+    int64_t groups = (int64_t)t->dim[0] * shl_sparse_groups(t);
+    return (uint8_t *)t->data + groups * shl_sparse_keep(t->mtype) * sparse_elem_size(t->dtype);
+}
+
+/* byte pattern of the value 0.0 in the given row */
+static void zero_value(struct csinn_tensor *t, int32_t row, uint8_t *zero)
+{
+    memset(zero, 0, 4);
+    if (t->qinfo == NULL || t->quant_channel == 0) {
+        return;
+    }
+    int32_t zp = t->qinfo[t->quant_channel > 1 ? row : 0].zero_point;
+    if (t->dtype == CSINN_DTYPE_UINT8) {
+        zero[0] = (uint8_t)zp;
+    } else if (t->dtype == CSINN_DTYPE_INT8) {
+        *(int8_t *)zero = (int8_t)zp;
+    } else if (t->dtype == CSINN_DTYPE_INT16) {
+        int16_t v = (int16_t)zp;
+        memcpy(zero, &v, 2);
+    }
+}
+
+/*************************************************************
+ * Compress a pruned dense weight tensor in place and tag it with mtype.
+ * Fails, leaving the tensor untouched, when a group holds more non-zero
+ * values than the pattern allows or the compressed form would not fit.
+ *************************************************************/
+int shl_sparse_compress(struct csinn_tensor *t, enum csinn_mem_type_enum mtype)
+{
+    int keep = shl_sparse_keep(mtype);
+    int elem = sparse_elem_size(t->dtype);
+    if (keep == 0 || elem == 0 || t->dim_count < 2 || shl_sparse_keep(t->mtype)) {
+        shl_debug_error("%s: unsupported tensor %s\n", __func__, t->name);
+        return CSINN_FALSE;
+    }
+    int32_t rows = t->dim[0];
+    int64_t inner = csinn_tensor_size(t) / rows;
+    int32_t groups = (inner + 3) / 4;
+    int64_t dense_size = rows * inner * elem;
+    int64_t sparse_size = (int64_t)rows * groups * (keep * elem + 1);
+    if (sparse_size > dense_size) {
+        shl_debug_error("%s: %s is too small to compress\n", __func__, t->name);
+        return CSINN_FALSE;
+    }
+
+    uint8_t *dense = (uint8_t *)t->data;
+    uint8_t *values = shl_mem_alloc(sparse_size);
+    uint8_t *index = values + (int64_t)rows * groups * keep * elem;
+    for (int32_t r = 0; r < rows; r++) {
+        uint8_t zero[4];
+        zero_value(t, r, zero);
+        for (int32_t g = 0; g < groups; g++) {
+            uint8_t *dst = values + ((int64_t)r * groups + g) * keep * elem;
+            uint8_t pos = 0;
+            int cnt = 0;
+            for (int p = 0; p < 4 && g * 4 + p < inner; p++) {
+                uint8_t *src = dense + (r * inner + g * 4 + p) * elem;
+                if (memcmp(src, zero, elem) == 0) {
+                    continue;
+                }
+                if (cnt == keep) {
+                    shl_debug_error("%s: %s does not match the sparse pattern\n", __func__,
+                                    t->name);
+                    shl_mem_free(values);
+                    return CSINN_FALSE;
+                }
+                memcpy(dst + cnt * elem, src, elem);
+                pos |= p << (2 * cnt);
+                cnt++;
+            }
+            for (; cnt < keep; cnt++) {
+                memcpy(dst + cnt * elem, zero, elem);
+            }
+            index[(int64_t)r * groups + g] = pos;
+        }
+    }
+    memcpy(dense, values, sparse_size);
+    shl_mem_free(values);
+    t->mtype = mtype;
+    return CSINN_TRUE;
+}
+
+/* expand a sparse weight tensor into dense, which holds csinn_tensor_size(t) elements */
+void shl_sparse_decompress(struct csinn_tensor *t, void *dense)
+{
+    int keep = shl_sparse_keep(t->mtype);
+    int elem = sparse_elem_size(t->dtype);
+    int32_t rows = t->dim[0];
+    int64_t inner = csinn_tensor_size(t) / rows;
+    int32_t groups = shl_sparse_groups(t);
+    uint8_t *values = (uint8_t *)t->data;
+    uint8_t *index = shl_sparse_index(t);
+    uint8_t *out = (uint8_t *)dense;
+
+    for (int32_t r = 0; r < rows; r++) {
+        uint8_t zero[4];
+        zero_value(t, r, zero);
+        uint8_t *dst = out + r * inner * elem;
+        for (int64_t i = 0; i < inner; i++) {
+            memcpy(dst + i * elem, zero, elem);
+        }
+        for (int32_t g = 0; g < groups; g++) {
+            uint8_t *src = values + ((int64_t)r * groups + g) * keep * elem;
+            uint8_t pos = index[(int64_t)r * groups + g];
+            for (int j = 0; j < keep; j++) {
+                int64_t d = g * 4 + ((pos >> (2 * j)) & 3);
+                if (memcmp(src + j * elem, zero, elem) != 0) {
+                    memcpy(dst + d * elem, src + j * elem, elem);
+                }
+            }
+        }
+    }
+}
+
+/*************************************************************
+ * Dequantize the values of a sparse weight tensor to float32 and keep the
+ * index behind them, the result has the same layout with a float32 dtype.
+ *************************************************************/
+void *shl_sparse_to_f32(struct csinn_tensor *t)
+{
+    int keep = shl_sparse_keep(t->mtype);
+    int32_t rows = t->dim[0];
+    int32_t groups = shl_sparse_groups(t);
+    int64_t row_size = (int64_t)groups * keep;
+    float *ret = shl_mem_alloc((int64_t)rows * groups * (keep * sizeof(float) + 1));
+    memcpy(ret + rows * row_size, shl_sparse_index(t), (int64_t)rows * groups);
+    int thread_num = shl_get_thread_num(t->sess);
+
+    for (int32_t r = 0; r < rows; r++) {
+        float *dst = ret + r * row_size;
+        float scale = 1.0f;
+        float zp = 0.0f;
+        if (t->qinfo != NULL && t->quant_channel > 0) {
+            int q = t->quant_channel > 1 ? r : 0;
+            scale = t->qinfo[q].scale;
+            zp = t->qinfo[q].zero_point;
+        }
+        switch (t->dtype) {
+            case CSINN_DTYPE_FLOAT32:
+                memcpy(dst, (float *)t->data + r * row_size, row_size * sizeof(float));
+                break;
+            case CSINN_DTYPE_FLOAT16:
+                shl_f16_to_f32((int16_t *)t->data + r * row_size, dst, row_size, thread_num);
+                break;
+            case CSINN_DTYPE_BFLOAT16:
+                shl_bf16_to_f32((int16_t *)t->data + r * row_size, dst, row_size);
+                break;
+            case CSINN_DTYPE_UINT8:
+                shl_dequantize_u8_to_f32((uint8_t *)t->data + r * row_size, dst, row_size, &scale,
+                                         &zp, false, thread_num);
+                break;
+            case CSINN_DTYPE_INT8:
+                shl_dequantize_i8_to_f32((int8_t *)t->data + r * row_size, dst, row_size, &scale,
+                                         &zp, false, thread_num);
+                break;
+            case CSINN_DTYPE_INT16:
+                shl_dequantize_i16_to_f32((int16_t *)t->data + r * row_size, dst, row_size,
+                                          &scale, &zp, false, thread_num);
+                break;
+            default:
+                shl_debug_error("%s: unsupported dtype %d\n", __func__, t->dtype);
+                break;
+        }
+    }
+    return ret;
+}
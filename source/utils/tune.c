@@ -0,0 +1,267 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "csi_nn.h"
+#include "shl_utils.h"
+
+/*************************************************************
+ * Tuning cache, the kernel selections of one session.
+ * A record maps a key of SHL_TUNE_KEY_SIZE int32 (op, core, dtype
+ * and shape, unused tail zero) to an algorithm id.
+ *
+ * dump image, all int32:
+ *   magic, version, record number, key size,
+ *   then per record: key[key size], algo
+ *************************************************************/
+
+#define SHL_TUNE_MAGIC 0x544c4853  // "SHLT"
+#define SHL_TUNE_VERSION 1
+#define SHL_TUNE_RUNS 3
+
+struct shl_tune_record {
+    int32_t key[SHL_TUNE_KEY_SIZE];
+    int32_t algo;
+};
+
+struct shl_tune_cache {
+    int32_t num;
+    int32_t size;
+    struct shl_tune_record *record;
+};
+
+int shl_tune_cache_lookup(struct csinn_session *sess, const int32_t *key)
+{
+    struct shl_tune_cache *cache = sess->tune_cache;
+    for (int i = 0; cache != NULL && i < cache->num; i++) {
+        if (memcmp(cache->record[i].key, key, SHL_TUNE_KEY_SIZE * sizeof(int32_t)) == 0) {
+            return cache->record[i].algo;
+        }
+    }
+    return -1;
+}
+
+void shl_tune_cache_insert(struct csinn_session *sess, const int32_t *key, int32_t algo)
+{
+    struct shl_tune_cache *cache = sess->tune_cache;
+    if (cache == NULL) {
+        cache = shl_mem_alloc(sizeof(struct shl_tune_cache));
+        sess->tune_cache = cache;
+    }
+    for (int i = 0; i < cache->num; i++) {
+        if (memcmp(cache->record[i].key, key, SHL_TUNE_KEY_SIZE * sizeof(int32_t)) == 0) {
+            cache->record[i].algo = algo;
+            return;
+        }
+    }
+    if (cache->num == cache->size) {
+        cache->size = cache->size ? cache->size * 2 : 16;
+        struct shl_tune_record *record =
+            shl_mem_alloc(cache->size * sizeof(struct shl_tune_record));
+        if (cache->num) {
+            memcpy(record, cache->record, cache->num * sizeof(struct shl_tune_record));
+        }
+        shl_mem_free(cache->record);
+        cache->record = record;
+    }
+    struct shl_tune_record *record = &cache->record[cache->num++];
+    memcpy(record->key, key, SHL_TUNE_KEY_SIZE * sizeof(int32_t));
+    record->algo = algo;
+}
+
+char *shl_tune_cache_dump(struct csinn_session *sess, int *size)
+{
+    struct shl_tune_cache *cache = sess->tune_cache;
+    int num = cache ? cache->num : 0;
+    *size = 4 * sizeof(int32_t) + num * sizeof(struct shl_tune_record);
+    int32_t *buf = shl_mem_alloc(*size);
+    buf[0] = SHL_TUNE_MAGIC;
+    buf[1] = SHL_TUNE_VERSION;
+    buf[2] = num;
+    buf[3] = SHL_TUNE_KEY_SIZE;
+    if (num) {
+        memcpy(buf + 4, cache->record, num * sizeof(struct shl_tune_record));
+    }
+    return (char *)buf;
+}
+
+int shl_tune_cache_load(struct csinn_session *sess, const char *buf, int size)
+{
+    const int32_t *head = (const int32_t *)buf;
+    if (size < 4 * sizeof(int32_t) || head[0] != SHL_TUNE_MAGIC ||
+        head[1] != SHL_TUNE_VERSION || head[3] != SHL_TUNE_KEY_SIZE ||
+        size < 4 * sizeof(int32_t) + head[2] * sizeof(struct shl_tune_record)) {
+        shl_debug_warning("%s: unknown tuning cache, ignored\n", __func__);
+        return CSINN_FALSE;
+    }
+    const struct shl_tune_record *record = (const struct shl_tune_record *)(head + 4);
+    for (int i = 0; i < head[2]; i++) {
+        shl_tune_cache_insert(sess, record[i].key, record[i].algo);
+    }
+    return CSINN_TRUE;
+}
+
+void shl_tune_cache_free(struct csinn_session *sess)
+{
+    struct shl_tune_cache *cache = sess->tune_cache;
+    if (cache != NULL) {
+        shl_mem_free(cache->record);
+        shl_mem_free(cache);
+        sess->tune_cache = NULL;
+    }
+}
+
+static void conv2d_key(int32_t *key, struct csinn_tensor *input, struct csinn_tensor *kernel,
+                       struct csinn_conv2d_params *params, int32_t core)
+{
+    int i = 0;
+    memset(key, 0, SHL_TUNE_KEY_SIZE * sizeof(int32_t));
+    key[i++] = CSINN_OP_CONV2D;
+    key[i++] = core;
+    key[i++] = input->dtype;
+    key[i++] = input->layout;
+    for (int k = 0; k < 4; k++) {
+        key[i++] = input->dim[k];
+    }
+    for (int k = 0; k < 4; k++) {
+        key[i++] = kernel->dim[k];
+    }
+    key[i++] = params->stride_height;
+    key[i++] = params->stride_width;
+    key[i++] = params->pad_top;
+    key[i++] = params->pad_down;
+    key[i++] = params->pad_left;
+    key[i++] = params->pad_right;
+    key[i++] = params->dilation_height;
+    key[i++] = params->dilation_width;
+    key[i++] = params->group;
+}
+
+/* tensor with the meta of src and a zeroed buffer of at least min_size bytes */
+static struct csinn_tensor *scratch_tensor(struct csinn_tensor *src, int min_size)
+{
+    struct csinn_tensor *t = csinn_alloc_tensor(NULL);
+    csinn_tensor_copy(t, src);
+    int size = csinn_tensor_byte_size(src);
+    t->data = shl_mem_alloc(size > min_size ? size : min_size);
+    return t;
+}
+
+static void free_scratch_tensor(struct csinn_tensor *t)
+{
+    shl_mem_free(t->data);
+    csinn_free_tensor(t);
+}
+
+/*
+ * best of SHL_TUNE_RUNS after a warm run, on a private copy of kernel and params.
+ * prepare sets exec in cb, the candidate's own callback, not the one of params.
+ */
+static uint64_t conv2d_time(const struct shl_conv2d_algo *algo, struct csinn_tensor *input,
+                            struct csinn_tensor *output, struct csinn_tensor *kernel,
+                            struct csinn_tensor *bias, struct csinn_conv2d_params *params,
+                            struct csinn_callback *cb)
+{
+    struct csinn_tensor *t_kernel = scratch_tensor(kernel, 0);
+    memcpy(t_kernel->data, kernel->data, csinn_tensor_byte_size(kernel));
+    struct csinn_conv2d_params t_params = *params;
+    t_params.conv_extra.kernel_tm = NULL;
+    *cb = *params->base.cb;
+    t_params.base.cb = cb;
+
+    algo->prepare(t_kernel, &t_params);
+    int (*exec)() = t_params.base.cb->exec;
+    exec(input, output, t_kernel, bias, &t_params);
+    uint64_t best = UINT64_MAX;
+    for (int i = 0; i < SHL_TUNE_RUNS; i++) {
+        uint64_t start = shl_get_timespec();
+        exec(input, output, t_kernel, bias, &t_params);
+        uint64_t time = shl_get_timespec() - start;
+        best = time < best ? time : best;
+    }
+
+    struct csinn_tensor *kernel_tm = t_params.conv_extra.kernel_tm;
+    if (kernel_tm != NULL) {
+        shl_mem_free(kernel_tm->data);
+        csinn_free_tensor(kernel_tm);
+    }
+    free_scratch_tensor(t_kernel);
+    return best;
+}
+
+/*************************************************************
+ * Pick one of algo[] for a conv2d init, returns its index.
+ * heuristic: index the init would pick untuned
+ * core:      identifies the kernels and hardware, e.g. api and vlenb
+ * Under CSINN_TUNE_ON a cache miss times every candidate on scratch
+ * input and output with a private kernel copy, and caches the fastest.
+ * The caller then runs algo[index].prepare on the real kernel.
+ *************************************************************/
+int shl_conv2d_tune(struct csinn_tensor *input, struct csinn_tensor *output,
+                    struct csinn_tensor *kernel, struct csinn_tensor *bias,
+                    struct csinn_conv2d_params *params, const struct shl_conv2d_algo *algo,
+                    int algo_num, int heuristic, int32_t core)
+{
+    struct csinn_session *sess = params->base.sess;
+    if (sess == NULL || sess->tune_mode == CSINN_TUNE_OFF || algo_num < 2) {
+        return heuristic;
+    }
+
+    int32_t key[SHL_TUNE_KEY_SIZE];
+    conv2d_key(key, input, kernel, params, core);
+    int id = shl_tune_cache_lookup(sess, key);
+    for (int i = 0; i < algo_num; i++) {
+        if (algo[i].id == id) {
+            return i;
+        }
+    }
+    if (sess->tune_mode != CSINN_TUNE_ON) {
+        return heuristic;
+    }
+
+    struct csinn_tensor *t_input = scratch_tensor(input, 0);
+    struct csinn_tensor *t_output = scratch_tensor(output, 0);
+    /* int32 or float per output channel covers every bias */
+    struct csinn_tensor *t_bias = scratch_tensor(bias, kernel->dim[0] * sizeof(int32_t));
+    if (bias->data != NULL) {
+        memcpy(t_bias->data, bias->data, csinn_tensor_byte_size(bias));
+    }
+
+    struct csinn_callback *cb = shl_mem_alloc(algo_num * sizeof(struct csinn_callback));
+    int best = heuristic;
+    uint64_t best_time = UINT64_MAX;
+    for (int i = 0; i < algo_num; i++) {
+        uint64_t time = conv2d_time(&algo[i], t_input, t_output, kernel, t_bias, params, &cb[i]);
+        shl_debug_info("%s: %s algo %d %.3fms\n", __func__, params->base.name, algo[i].id,
+                       time / 1000000.0f);
+        if (time < best_time) {
+            best = i;
+            best_time = time;
+        }
+    }
+    shl_tune_cache_insert(sess, key, algo[best].id);
+    /* the callback of params as the winner left it, prepare then redoes it on the real kernel */
+    *params->base.cb = cb[best];
+    shl_mem_free(cb);
+
+    free_scratch_tensor(t_input);
+    free_scratch_tensor(t_output);
+    free_scratch_tensor(t_bias);
+    return best;
+}
@@ -0,0 +1,390 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "benchmark.h"
+
+#include <math.h>
+#include <unistd.h>
+
+struct bench_options bench_opt = {
+    .warmup = 3,
+    .repeat = 20,
+    .max_seconds = 2.0,
+    .thread_num = 0,
+    .dtype_mask = 1u << CSINN_DTYPE_FLOAT32,
+    .filter = NULL,
+    .format = BENCH_FORMAT_TEXT,
+};
+
+const enum csinn_dtype_enum bench_dtypes[BENCH_DTYPE_NUM] = {
+    CSINN_DTYPE_FLOAT32, CSINN_DTYPE_FLOAT16, CSINN_DTYPE_INT8, CSINN_DTYPE_UINT8};
+
+static int bench_case_num;
+static int bench_skip_num;
+
+static const char *bench_api_name(void)
+{
+    switch (CSINN_API) {
+        case CSINN_REF:
+            return "ref";
+        case CSINN_C906:
+            return "c906";
+        case CSINN_C908:
+            return "c908";
+        case CSINN_RVV:
+            return "rvv";
+        default:
+            return "unknown";
+    }
+}
+
+const char *bench_dtype_name(enum csinn_dtype_enum dtype)
+{
+    switch (dtype) {
+        case CSINN_DTYPE_UINT8:
+            return "uint8";
+        case CSINN_DTYPE_INT8:
+            return "int8";
+        case CSINN_DTYPE_INT16:
+            return "int16";
+        case CSINN_DTYPE_INT32:
+            return "int32";
+        case CSINN_DTYPE_FLOAT16:
+            return "fp16";
+        case CSINN_DTYPE_FLOAT32:
+            return "fp32";
+        default:
+            return "unknown";
+    }
+}
+
+static void bench_usage(const char *name)
+{
+    printf("Usage: %s [options]\n", name);
+    printf("  -w N        warm-up runs per case (default %d)\n", bench_opt.warmup);
+    printf("  -r N        timed runs per case (default %d)\n", bench_opt.repeat);
+    printf("  -T SEC      time budget per case, at least 3 runs (default %.1f)\n",
+           bench_opt.max_seconds);
+    printf("  -j N        threads of the reference kernels (default OpenMP)\n");
+    printf("  -d LIST     dtypes, comma separated: fp32,fp16,int8,uint8 (default fp32)\n");
+    printf("  -f STR      only cases whose op/algo/shape contains STR\n");
+    printf("  -o FMT      output format: text, csv or json (one object per line)\n");
+}
+
+static uint32_t bench_parse_dtypes(char *list)
+{
+    uint32_t mask = 0;
+    for (char *tok = strtok(list, ","); tok != NULL; tok = strtok(NULL, ",")) {
+        if (strcmp(tok, "fp32") == 0) {
+            mask |= 1u << CSINN_DTYPE_FLOAT32;
+        } else if (strcmp(tok, "fp16") == 0) {
+            mask |= 1u << CSINN_DTYPE_FLOAT16;
+        } else if (strcmp(tok, "int8") == 0) {
+            mask |= 1u << CSINN_DTYPE_INT8;
+        } else if (strcmp(tok, "uint8") == 0) {
+            mask |= 1u << CSINN_DTYPE_UINT8;
+        } else {
+            fprintf(stderr, "unknown dtype %s\n", tok);
+        }
+    }
+    return mask;
+}
+
+int bench_parse_options(int argc, char **argv)
+{
+    int opt;
+    while ((opt = getopt(argc, argv, "w:r:T:j:d:f:o:h")) != -1) {
+        switch (opt) {
+            case 'w':
+                bench_opt.warmup = atoi(optarg);
+                break;
+            case 'r':
+                bench_opt.repeat = atoi(optarg) > 0 ? atoi(optarg) : 1;
+                break;
+            case 'T':
+                bench_opt.max_seconds = atof(optarg);
+                break;
+            case 'j':
+                bench_opt.thread_num = atoi(optarg);
+                break;
+            case 'd':
+                bench_opt.dtype_mask = bench_parse_dtypes(optarg);
+                break;
+            case 'f':
+                bench_opt.filter = optarg;
+                break;
+            case 'o':
+                if (strcmp(optarg, "csv") == 0) {
+                    bench_opt.format = BENCH_FORMAT_CSV;
+                } else if (strcmp(optarg, "json") == 0) {
+                    bench_opt.format = BENCH_FORMAT_JSON;
+                } else {
+                    bench_opt.format = BENCH_FORMAT_TEXT;
+                }
+                break;
+            default:
+                bench_usage(argv[0]);
+                return CSINN_FALSE;
+        }
+    }
+    return CSINN_TRUE;
+}
+
+bool bench_dtype_enabled(enum csinn_dtype_enum dtype)
+{
+    return (bench_opt.dtype_mask >> dtype) & 1;
+}
+
+static bool bench_selected(const char *op, const char *algo, const char *shape)
+{
+    if (bench_opt.filter == NULL) {
+        return true;
+    }
+    char key[160];
+    snprintf(key, sizeof(key), "%s/%s/%s", op, algo, shape);
+    return strstr(key, bench_opt.filter) != NULL;
+}
+
+void bench_print_header(void)
+{
+    if (bench_opt.format == BENCH_FORMAT_TEXT) {
+        printf("%-6s %-14s %-14s %-6s %-34s %6s %11s %11s %11s %9s %9s\n", "api", "op", "algo",
+               "dtype", "shape", "runs", "median(us)", "p99(us)", "min(us)", "GFLOP/s", "GB/s");
+    } else if (bench_opt.format == BENCH_FORMAT_CSV) {
+        printf("api,op,algo,dtype,shape,status,runs,median_us,p99_us,min_us,mean_us,gflops,"
+               "gbps\n");
+    }
+}
+
+static int bench_cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return x < y ? -1 : (x > y ? 1 : 0);
+}
+
+static void bench_report(struct bench_case *bc, const char *status, int runs, double median,
+                         double p99, double min, double mean)
+{
+    /* times in ns, so flops / ns = GFLOP/s and bytes / ns = GB/s */
+    double gflops = median > 0 ? bc->flops / median : 0;
+    double gbps = median > 0 ? bc->bytes / median : 0;
+    const char *dtype = bench_dtype_name(bc->dtype);
+
+    if (bench_opt.format == BENCH_FORMAT_TEXT) {
+        if (runs == 0) {
+            printf("%-6s %-14s %-14s %-6s %-34s %s\n", bench_api_name(), bc->op, bc->algo, dtype,
+                   bc->shape, status);
+        } else {
+            printf("%-6s %-14s %-14s %-6s %-34s %6d %11.2f %11.2f %11.2f %9.3f %9.3f\n",
+                   bench_api_name(), bc->op, bc->algo, dtype, bc->shape, runs, median / 1e3,
+                   p99 / 1e3, min / 1e3, gflops, gbps);
+        }
+    } else if (bench_opt.format == BENCH_FORMAT_CSV) {
+        printf("%s,%s,%s,%s,\"%s\",%s,%d,%.3f,%.3f,%.3f,%.3f,%.4f,%.4f\n", bench_api_name(),
+               bc->op, bc->algo, dtype, bc->shape, status, runs, median / 1e3, p99 / 1e3,
+               min / 1e3, mean / 1e3, gflops, gbps);
+    } else {
+        printf("{\"api\": \"%s\", \"op\": \"%s\", \"algo\": \"%s\", \"dtype\": \"%s\", "
+               "\"shape\": \"%s\", \"status\": \"%s\", \"runs\": %d, \"median_us\": %.3f, "
+               "\"p99_us\": %.3f, \"min_us\": %.3f, \"mean_us\": %.3f, \"gflops\": %.4f, "
+               "\"gbps\": %.4f}\n",
+               bench_api_name(), bc->op, bc->algo, dtype, bc->shape, status, runs, median / 1e3,
+               p99 / 1e3, min / 1e3, mean / 1e3, gflops, gbps);
+    }
+    fflush(stdout);
+}
+
+/*************************************************************
+ * warm-up, then up to repeat timed runs, stopped early by the time budget
+ * once 3 samples are taken, so slow cases stay usable under qemu
+ *************************************************************/
+int bench_run(struct bench_case *bc)
+{
+    if (!bench_selected(bc->op, bc->algo, bc->shape)) {
+        return CSINN_TRUE;
+    }
+
+    /* like the csinn_* entries, the exec return value is not checked */
+    for (int i = 0; i < bench_opt.warmup; i++) {
+        bc->run(bc->ctx);
+    }
+
+    uint64_t *samples = shl_mem_alloc(bench_opt.repeat * sizeof(uint64_t));
+    uint64_t budget = (uint64_t)(bench_opt.max_seconds * 1e9);
+    uint64_t total = 0;
+    int runs = 0;
+    while (runs < bench_opt.repeat) {
+        uint64_t start = shl_get_timespec();
+        bc->run(bc->ctx);
+        uint64_t end = shl_get_timespec();
+        samples[runs++] = end - start;
+        total += end - start;
+        if (runs >= 3 && total > budget) {
+            break;
+        }
+    }
+
+    qsort(samples, runs, sizeof(uint64_t), bench_cmp_u64);
+    double median = runs % 2 ? samples[runs / 2]
+                             : 0.5 * ((double)samples[runs / 2 - 1] + samples[runs / 2]);
+    int p99_index = (int)ceil(0.99 * runs) - 1;
+    double p99 = samples[p99_index < 0 ? 0 : p99_index];
+    double mean = (double)total / runs;
+
+    bench_case_num++;
+    bench_report(bc, "ok", runs, median, p99, samples[0], mean);
+    shl_mem_free(samples);
+    return CSINN_TRUE;
+}
+
+void bench_skip(const char *op, const char *algo, const char *shape, enum csinn_dtype_enum dtype,
+                const char *reason)
+{
+    if (!bench_selected(op, algo, shape)) {
+        return;
+    }
+    struct bench_case bc = {.op = op, .algo = algo, .dtype = dtype};
+    snprintf(bc.shape, sizeof(bc.shape), "%s", shape);
+    bench_skip_num++;
+    bench_report(&bc, reason, 0, 0, 0, 0, 0);
+}
+
+int bench_done(void)
+{
+    fprintf(stderr, "%s: %d cases timed, %d skipped\n", bench_api_name(), bench_case_num,
+            bench_skip_num);
+    return 0;
+}
+
+struct csinn_session *bench_session(enum csinn_dtype_enum dtype)
+{
+    struct csinn_session *sess = csinn_alloc_session();
+    sess->base_api = CSINN_API;
+    sess->base_run_mode = CSINN_RM_LAYER;
+    sess->base_layout = CSINN_LAYOUT_NCHW;
+    sess->base_dtype = dtype;
+    sess->thread_num = bench_opt.thread_num;
+    if (dtype == CSINN_DTYPE_INT8) {
+        sess->base_quant_type = CSINN_QUANT_INT8_ASYM;
+    } else if (dtype == CSINN_DTYPE_UINT8) {
+        sess->base_quant_type = CSINN_QUANT_UINT8_ASYM;
+    } else if (dtype == CSINN_DTYPE_FLOAT16) {
+        sess->base_quant_type = CSINN_QUANT_FLOAT16;
+    } else {
+        sess->base_quant_type = CSINN_QUANT_FLOAT32;
+    }
+    return sess;
+}
+
+/* fixed seed, every backend sees the same data */
+static uint32_t bench_seed = 0x12345678;
+
+static uint32_t bench_rand(void)
+{
+    bench_seed = bench_seed * 1664525u + 1013904223u;
+    return bench_seed >> 8;
+}
+
+static void bench_fill(struct csinn_tensor *t)
+{
+    int64_t size = csinn_tensor_size(t);
+    for (int64_t i = 0; i < size; i++) {
+        uint32_t r = bench_rand();
+        float f = (float)(r & 0xffff) / 32768.0f - 1.0f;
+        switch (t->dtype) {
+            case CSINN_DTYPE_FLOAT32:
+                ((float *)t->data)[i] = f;
+                break;
+            case CSINN_DTYPE_FLOAT16:
+                ((int16_t *)t->data)[i] = shl_ref_float32_to_float16(f);
+                break;
+            case CSINN_DTYPE_INT8:
+                ((int8_t *)t->data)[i] = (int8_t)(f * 100);
+                break;
+            case CSINN_DTYPE_UINT8:
+                ((uint8_t *)t->data)[i] = (uint8_t)(128 + f * 100);
+                break;
+            case CSINN_DTYPE_INT32:
+                ((int32_t *)t->data)[i] = (int32_t)(f * 1000);
+                break;
+            default:
+                ((int8_t *)t->data)[i] = 0;
+                break;
+        }
+    }
+}
+
+static struct csinn_tensor *bench_alloc(struct csinn_session *sess, enum csinn_dtype_enum dtype,
+                                        enum csinn_layout_enum layout, int dim_count,
+                                        const int32_t *dim)
+{
+    struct csinn_tensor *t = csinn_alloc_tensor(sess);
+    t->dtype = dtype;
+    t->layout = layout;
+    t->dim_count = dim_count;
+    for (int i = 0; i < dim_count; i++) {
+        t->dim[i] = dim[i];
+    }
+    t->data = shl_mem_alloc(csinn_tensor_byte_size(t));
+    if (dtype == CSINN_DTYPE_UINT8) {
+        bench_set_quant(t, 1.0f / 32, 128, 1);
+    } else if (dtype == CSINN_DTYPE_INT8) {
+        bench_set_quant(t, 1.0f / 32, 0, 1);
+    }
+    return t;
+}
+
+/* random data in [-1, 1) or the matching quantized range */
+struct csinn_tensor *bench_tensor(struct csinn_session *sess, enum csinn_dtype_enum dtype,
+                                  enum csinn_layout_enum layout, int dim_count,
+                                  const int32_t *dim)
+{
+    struct csinn_tensor *t = bench_alloc(sess, dtype, layout, dim_count, dim);
+    bench_fill(t);
+    return t;
+}
+
+struct csinn_tensor *bench_output(struct csinn_session *sess, enum csinn_dtype_enum dtype,
+                                  enum csinn_layout_enum layout, int dim_count,
+                                  const int32_t *dim)
+{
+    return bench_alloc(sess, dtype, layout, dim_count, dim);
+}
+
+void bench_set_quant(struct csinn_tensor *t, float scale, int32_t zero_point, int channel)
+{
+    if (t->quant_channel != channel) {
+        csinn_realloc_quant_info(t, channel);
+    }
+    for (int i = 0; i < channel; i++) {
+        t->qinfo[i].scale = scale;
+        t->qinfo[i].zero_point = zero_point;
+        shl_quantize_multiplier(scale, &t->qinfo[i].multiplier, &t->qinfo[i].shift);
+        t->qinfo[i].min = (-128 - zero_point) * scale;
+        t->qinfo[i].max = (127 - zero_point) * scale;
+    }
+}
+
+void bench_free_tensor(struct csinn_tensor *t)
+{
+    shl_mem_free(t->data);
+    csinn_free_tensor(t);
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "csi_nn.h"
+#include "shl_ref.h"
+#include "shl_utils.h"
+
+#ifndef CSINN_API
+#define CSINN_API CSINN_REF
+#endif
+
+enum bench_format {
+    BENCH_FORMAT_TEXT = 0,
+    BENCH_FORMAT_CSV,
+    BENCH_FORMAT_JSON,
+};
+
+struct bench_options {
+    int warmup;
+    int repeat;
+    double max_seconds;  // per case budget, at least 3 samples are taken whatever it is
+    int thread_num;
+    uint32_t dtype_mask;  // bit per enum csinn_dtype_enum
+    const char *filter;   // substring of "op/algo/shape"
+    enum bench_format format;
+};
+
+/*************************************************************
+ * one timed case
+ * flops: arithmetic work of one run, 0 when not meaningful
+ * bytes: compulsory memory traffic of one run (inputs, weights, outputs once)
+ * run:   one execution of the kernel, all init work done before
+ *************************************************************/
+struct bench_case {
+    const char *op;
+    const char *algo;
+    char shape[96];
+    enum csinn_dtype_enum dtype;
+    double flops;
+    double bytes;
+    int (*run)(void *ctx);
+    void *ctx;
+};
+
+extern struct bench_options bench_opt;
+
+/* dtypes swept by every op, -d selects among them */
+#define BENCH_DTYPE_NUM 4
+extern const enum csinn_dtype_enum bench_dtypes[BENCH_DTYPE_NUM];
+
+int bench_parse_options(int argc, char **argv);
+void bench_print_header(void);
+int bench_run(struct bench_case *bc);
+void bench_skip(const char *op, const char *algo, const char *shape, enum csinn_dtype_enum dtype,
+                const char *reason);
+int bench_done(void);
+
+bool bench_dtype_enabled(enum csinn_dtype_enum dtype);
+const char *bench_dtype_name(enum csinn_dtype_enum dtype);
+
+struct csinn_session *bench_session(enum csinn_dtype_enum dtype);
+struct csinn_tensor *bench_tensor(struct csinn_session *sess, enum csinn_dtype_enum dtype,
+                                  enum csinn_layout_enum layout, int dim_count,
+                                  const int32_t *dim);
+struct csinn_tensor *bench_output(struct csinn_session *sess, enum csinn_dtype_enum dtype,
+                                  enum csinn_layout_enum layout, int dim_count,
+                                  const int32_t *dim);
+void bench_set_quant(struct csinn_tensor *t, float scale, int32_t zero_point, int channel);
+void bench_free_tensor(struct csinn_tensor *t);
+
+void bench_conv2d(void);
+void bench_gemm(void);
+void bench_fullyconnected(void);
+void bench_pool(void);
+void bench_eltwise(void);
+void bench_softmax(void);
+void bench_layer_norm(void);
+void bench_data_convert(void);
+
+#endif  // BENCHMARK_H
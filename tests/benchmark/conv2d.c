@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "benchmark.h"
+#if defined(BENCH_RVV)
+#include "shl_thead_rvv.h"
+#endif
+
+/* resnet50 / yolov5s / mobilenetv2 layers: stem, 1x1, 3x3, strided 3x3 and depthwise */
+struct conv2d_shape {
+    const char *model;
+    int in_c, in_h, in_w;
+    int out_c, kernel, stride, pad, group;
+};
+
+static const struct conv2d_shape conv2d_shapes[] = {
+    {"resnet50", 3, 224, 224, 64, 7, 2, 3, 1},
+    {"resnet50", 64, 56, 56, 256, 1, 1, 0, 1},
+    {"resnet50", 256, 56, 56, 64, 1, 1, 0, 1},
+    {"resnet50", 1024, 14, 14, 256, 1, 1, 0, 1},
+    {"resnet50", 64, 56, 56, 64, 3, 1, 1, 1},
+    {"resnet50", 256, 14, 14, 256, 3, 1, 1, 1},
+    {"resnet50", 128, 56, 56, 128, 3, 2, 1, 1},
+    {"yolov5s", 32, 160, 160, 64, 3, 2, 1, 1},
+    {"mobilenetv2", 32, 112, 112, 16, 1, 1, 0, 1},
+    {"mobilenetv2", 144, 56, 56, 24, 1, 1, 0, 1},
+    {"mobilenetv2", 96, 112, 112, 96, 3, 2, 1, 96},
+    {"mobilenetv2", 144, 56, 56, 144, 3, 1, 1, 144},
+    {"mobilenetv2", 960, 7, 7, 960, 3, 1, 1, 960},
+};
+
+/*************************************************************
+ * rows are labelled by the kernel the backend init dispatched,
+ * not by the path a shape is expected to take
+ *************************************************************/
+struct conv2d_kernel {
+    int (*exec)();
+    const char *algo;
+};
+
+static const struct conv2d_kernel conv2d_kernels[] = {
+    {shl_ref_conv2d_f32, "ref"},
+    {shl_ref_conv2d_quant, "ref"},
+    {shl_ref_depthwise_conv2d_f32, "ref"},
+    {shl_ref_depthwise_conv2d_quant, "ref"},
+    {shl_ref_group_conv2d_f32, "ref"},
+    {shl_ref_group_conv2d_quant, "ref"},
+#if defined(BENCH_RVV)
+#define CONV2D_RVV_KERNEL(name, algo) \
+    {shl_rvv_##name##_fp32, algo}, {shl_rvv_##name##_fp16, algo}, {shl_rvv_##name##_int8, algo}
+    CONV2D_RVV_KERNEL(conv1x1s1_gemm, "gemm_1x1"),
+    CONV2D_RVV_KERNEL(conv1x1s1_gemm_packn, "gemm_1x1"),
+    CONV2D_RVV_KERNEL(conv1x1s1_gemm_pack1ton, "gemm_1x1"),
+    CONV2D_RVV_KERNEL(conv1x1s1_gemm_packnto1, "gemm_1x1"),
+    CONV2D_RVV_KERNEL(conv_im2col_gemm, "im2col_gemm"),
+    CONV2D_RVV_KERNEL(conv_im2col_gemm_packn, "im2col_gemm"),
+    CONV2D_RVV_KERNEL(conv_im2col_gemm_pack1ton, "im2col_gemm"),
+    CONV2D_RVV_KERNEL(conv_im2col_gemm_packnto1, "im2col_gemm"),
+    CONV2D_RVV_KERNEL(wg_b4f3s1_packn, "winograd"),
+    {shl_rvv_wg_b6f3s1_packn_fp32, "winograd"},
+    {shl_rvv_wg_b6f3s1_packn_fp16, "winograd"},
+    {shl_rvv_wg_b2f3s1_packn_int8, "winograd"},
+    {shl_rvv_wg_b3f3s2_packn_int8, "winograd"},
+    CONV2D_RVV_KERNEL(dwconv3x3s1, "depthwise"),
+    CONV2D_RVV_KERNEL(dwconv3x3s2, "depthwise"),
+    CONV2D_RVV_KERNEL(dwconv3x3s1_packn, "depthwise"),
+    CONV2D_RVV_KERNEL(dwconv3x3s2_packn, "depthwise"),
+    CONV2D_RVV_KERNEL(dwconv_packn, "depthwise"),
+    {shl_rvv_conv2d_sparse_fp16, "sparse"},
+#undef CONV2D_RVV_KERNEL
+#endif
+};
+
+static const char *conv2d_algo(struct csinn_conv2d_params *params)
+{
+    for (int i = 0; i < sizeof(conv2d_kernels) / sizeof(conv2d_kernels[0]); i++) {
+        if (params->base.cb->exec == conv2d_kernels[i].exec) {
+            return conv2d_kernels[i].algo;
+        }
+    }
+    /* kernels not in the table, by the mode the init recorded */
+    switch (params->conv_extra.conv_mode) {
+        case CSINN_WINOGRAD:
+            return "winograd";
+        case CSINN_GEMM:
+            return "gemm";
+        default:
+            return "direct";
+    }
+}
+
+struct conv2d_ctx {
+    struct csinn_tensor *input;
+    struct csinn_tensor *output;
+    struct csinn_tensor *kernel;
+    struct csinn_tensor *bias;
+    struct csinn_conv2d_params *params;
+};
+
+/* exec directly, csinn_conv2d frees the winograd kernel after its first call */
+static int conv2d_run(void *ctx)
+{
+    struct conv2d_ctx *c = ctx;
+    struct csinn_conv2d_params *params = c->params;
+    struct csinn_tensor *kernel = c->kernel;
+    if (params->conv_extra.conv_mode == CSINN_WINOGRAD && params->conv_extra.kernel_tm != NULL) {
+        kernel = params->conv_extra.kernel_tm;
+    }
+    return params->base.cb->exec(c->input, c->output, kernel, c->bias, params);
+}
+
+static void conv2d_case(const struct conv2d_shape *s, enum csinn_dtype_enum dtype)
+{
+    int out_h = (s->in_h + 2 * s->pad - s->kernel) / s->stride + 1;
+    int out_w = (s->in_w + 2 * s->pad - s->kernel) / s->stride + 1;
+    int32_t in_dim[4] = {1, s->in_c, s->in_h, s->in_w};
+    int32_t out_dim[4] = {1, s->out_c, out_h, out_w};
+    int32_t kernel_dim[4] = {s->out_c, s->in_c / s->group, s->kernel, s->kernel};
+    int32_t bias_dim[1] = {s->out_c};
+    bool quant = dtype == CSINN_DTYPE_INT8 || dtype == CSINN_DTYPE_UINT8;
+
+    struct bench_case bc = {.op = "conv2d", .algo = "-", .dtype = dtype};
+    snprintf(bc.shape, sizeof(bc.shape), "%s %dx%dx%d k%ds%d o%d", s->model, s->in_c, s->in_h,
+             s->in_w, s->kernel, s->stride, s->out_c);
+
+    struct csinn_session *sess = bench_session(dtype);
+    struct conv2d_ctx ctx;
+    ctx.input = bench_tensor(sess, dtype, CSINN_LAYOUT_NCHW, 4, in_dim);
+    ctx.output = bench_output(sess, dtype, CSINN_LAYOUT_NCHW, 4, out_dim);
+    ctx.kernel = bench_tensor(sess, dtype, CSINN_LAYOUT_OIHW, 4, kernel_dim);
+    ctx.bias = bench_tensor(sess, quant ? CSINN_DTYPE_INT32 : dtype, CSINN_LAYOUT_O, 1, bias_dim);
+    ctx.kernel->is_const = 1;
+    ctx.bias->is_const = 1;
+    if (quant) {
+        bench_set_quant(ctx.kernel, 1.0f / 128, 0, s->out_c);
+        bench_set_quant(ctx.bias, 1.0f / 32 / 128, 0, s->out_c);
+        bench_set_quant(ctx.output, 1.0f / 4, ctx.output->qinfo->zero_point, 1);
+    }
+
+    struct csinn_conv2d_params *params = csinn_alloc_params(sizeof(*params), sess);
+    params->base.name = "conv2d";
+    params->stride_height = s->stride;
+    params->stride_width = s->stride;
+    params->pad_top = s->pad;
+    params->pad_down = s->pad;
+    params->pad_left = s->pad;
+    params->pad_right = s->pad;
+    params->dilation_height = 1;
+    params->dilation_width = 1;
+    params->group = s->group;
+    params->conv_extra.fuse_zp2bias = false;
+    ctx.params = params;
+
+    bc.flops = 2.0 * s->out_c * out_h * out_w * (s->in_c / s->group) * s->kernel * s->kernel;
+    bc.bytes = csinn_tensor_byte_size(ctx.input) + csinn_tensor_byte_size(ctx.kernel) +
+               csinn_tensor_byte_size(ctx.bias) + csinn_tensor_byte_size(ctx.output);
+    bc.run = conv2d_run;
+    bc.ctx = &ctx;
+
+    if (csinn_conv2d_init(ctx.input, ctx.output, ctx.kernel, ctx.bias, params) != CSINN_TRUE ||
+        params->base.cb->exec == NULL) {
+        bench_skip(bc.op, bc.algo, bc.shape, dtype, "unsupported");
+    } else {
+        bc.algo = conv2d_algo(params);
+        bench_run(&bc);
+    }
+
+    if (params->conv_extra.kernel_tm != NULL) {
+        bench_free_tensor(params->conv_extra.kernel_tm);
+    }
+    bench_free_tensor(ctx.input);
+    bench_free_tensor(ctx.output);
+    bench_free_tensor(ctx.kernel);
+    bench_free_tensor(ctx.bias);
+    csinn_free_params(params);
+    csinn_free_session(sess);
+}
+
+void bench_conv2d(void)
+{
+    for (int d = 0; d < BENCH_DTYPE_NUM; d++) {
+        if (!bench_dtype_enabled(bench_dtypes[d])) {
+            continue;
+        }
+        for (int i = 0; i < sizeof(conv2d_shapes) / sizeof(conv2d_shapes[0]); i++) {
+            conv2d_case(&conv2d_shapes[i], bench_dtypes[d]);
+        }
+    }
+}
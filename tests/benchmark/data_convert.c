@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "benchmark.h"
+
+/* model input quantize and output dequantize sizes */
+struct data_convert_shape {
+    const char *model;
+    int c, h, w;
+};
+
+static const struct data_convert_shape data_convert_shapes[] = {
+    {"resnet50_in", 3, 224, 224},
+    {"yolov5s_out", 255, 80, 80},
+    {"resnet50_out", 1, 1, 1000},
+};
+
+struct data_convert_ctx {
+    struct csinn_tensor *input;
+    struct csinn_tensor *output;
+    struct csinn_siso_params *params;
+};
+
+static int data_convert_run(void *ctx)
+{
+    struct data_convert_ctx *c = ctx;
+    return c->params->base.cb->exec(c->input, c->output, c->params);
+}
+
+/* the dtype of the case is the one that is not fp32 */
+static void data_convert_case(const struct data_convert_shape *s, enum csinn_dtype_enum in_dtype,
+                              enum csinn_dtype_enum out_dtype)
+{
+    int32_t dim[4] = {1, s->c, s->h, s->w};
+    enum csinn_dtype_enum dtype = in_dtype == CSINN_DTYPE_FLOAT32 ? out_dtype : in_dtype;
+
+    struct bench_case bc = {.op = "data_convert", .dtype = dtype};
+    bc.algo = in_dtype == CSINN_DTYPE_FLOAT32 ? "from_fp32" : "to_fp32";
+    snprintf(bc.shape, sizeof(bc.shape), "%s 1x%dx%dx%d", s->model, s->c, s->h, s->w);
+
+    struct csinn_session *sess = bench_session(dtype);
+    struct data_convert_ctx ctx;
+    ctx.input = bench_tensor(sess, in_dtype, CSINN_LAYOUT_NCHW, 4, dim);
+    ctx.output = bench_output(sess, out_dtype, CSINN_LAYOUT_NCHW, 4, dim);
+
+    struct csinn_siso_params *params = csinn_alloc_params(sizeof(*params), sess);
+    params->base.name = "data_convert";
+    ctx.params = params;
+
+    bc.flops = csinn_tensor_size(ctx.input);
+    bc.bytes = csinn_tensor_byte_size(ctx.input) + csinn_tensor_byte_size(ctx.output);
+    bc.run = data_convert_run;
+    bc.ctx = &ctx;
+
+    if (csinn_data_convert_init(ctx.input, ctx.output, params) != CSINN_TRUE ||
+        params->base.cb->exec == NULL) {
+        bench_skip(bc.op, bc.algo, bc.shape, dtype, "unsupported");
+    } else {
+        bench_run(&bc);
+    }
+
+    bench_free_tensor(ctx.input);
+    bench_free_tensor(ctx.output);
+    csinn_free_params(params);
+    csinn_free_session(sess);
+}
+
+void bench_data_convert(void)
+{
+    /* bench_dtypes[0] is fp32 itself */
+    for (int d = 1; d < BENCH_DTYPE_NUM; d++) {
+        if (!bench_dtype_enabled(bench_dtypes[d])) {
+            continue;
+        }
+        for (int i = 0; i < sizeof(data_convert_shapes) / sizeof(data_convert_shapes[0]); i++) {
+            data_convert_case(&data_convert_shapes[i], CSINN_DTYPE_FLOAT32, bench_dtypes[d]);
+            data_convert_case(&data_convert_shapes[i], bench_dtypes[d], CSINN_DTYPE_FLOAT32);
+        }
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "benchmark.h"
+
+/* c1 = 1 broadcasts input1 per channel, the scale / bias pattern */
+struct eltwise_shape {
+    const char *model;
+    int c, h, w;
+    int c1;
+};
+
+static const struct eltwise_shape eltwise_shapes[] = {
+    {"resnet50", 256, 56, 56, 256},
+    {"resnet50", 2048, 7, 7, 2048},
+    {"mobilenetv2", 24, 56, 56, 24},
+    {"senet", 256, 56, 56, 1},
+};
+
+struct eltwise_ctx {
+    struct csinn_tensor *input0;
+    struct csinn_tensor *input1;
+    struct csinn_tensor *output;
+    void *params;
+};
+
+static int binary_run(void *ctx)
+{
+    struct eltwise_ctx *c = ctx;
+    struct csinn_diso_params *params = c->params;
+    return params->base.cb->exec(c->input0, c->input1, c->output, params);
+}
+
+static int unary_run(void *ctx)
+{
+    struct eltwise_ctx *c = ctx;
+    struct csinn_siso_params *params = c->params;
+    return params->base.cb->exec(c->input0, c->output, params);
+}
+
+static void eltwise_op(struct eltwise_ctx *ctx, struct bench_case *bc, int ret)
+{
+    struct csinn_params_base *base = ctx->params;
+    if (ret != CSINN_TRUE || base->cb->exec == NULL) {
+        bench_skip(bc->op, bc->algo, bc->shape, bc->dtype, "unsupported");
+    } else {
+        bench_run(bc);
+    }
+    csinn_free_params(ctx->params);
+}
+
+static void eltwise_case(const struct eltwise_shape *s, enum csinn_dtype_enum dtype)
+{
+    int32_t dim[4] = {1, s->c, s->h, s->w};
+    int32_t dim1[4] = {1, s->c, s->c1 == 1 ? 1 : s->h, s->c1 == 1 ? 1 : s->w};
+
+    struct csinn_session *sess = bench_session(dtype);
+    struct eltwise_ctx ctx;
+    ctx.input0 = bench_tensor(sess, dtype, CSINN_LAYOUT_NCHW, 4, dim);
+    ctx.input1 = bench_tensor(sess, dtype, CSINN_LAYOUT_NCHW, 4, dim1);
+    ctx.output = bench_output(sess, dtype, CSINN_LAYOUT_NCHW, 4, dim);
+    double size = csinn_tensor_size(ctx.output);
+    double in_bytes = csinn_tensor_byte_size(ctx.input0);
+    double out_bytes = csinn_tensor_byte_size(ctx.output);
+
+    struct bench_case bc = {.algo = s->c1 == 1 ? "broadcast" : "-", .dtype = dtype};
+    snprintf(bc.shape, sizeof(bc.shape), "%s %dx%dx%d", s->model, s->c, s->h, s->w);
+    bc.ctx = &ctx;
+
+    bc.flops = size;
+    bc.bytes = in_bytes + csinn_tensor_byte_size(ctx.input1) + out_bytes;
+    bc.run = binary_run;
+    bc.op = "add";
+    ctx.params = csinn_alloc_params(sizeof(struct csinn_diso_params), sess);
+    eltwise_op(&ctx, &bc, csinn_add_init(ctx.input0, ctx.input1, ctx.output, ctx.params));
+    bc.op = "mul";
+    ctx.params = csinn_alloc_params(sizeof(struct csinn_diso_params), sess);
+    eltwise_op(&ctx, &bc, csinn_mul_init(ctx.input0, ctx.input1, ctx.output, ctx.params));
+
+    /* unary ops only on the same shape cases */
+    if (s->c1 != 1) {
+        bc.algo = "-";
+        bc.bytes = in_bytes + out_bytes;
+        bc.run = unary_run;
+        bc.op = "relu";
+        ctx.params = csinn_alloc_params(sizeof(struct csinn_relu_params), sess);
+        eltwise_op(&ctx, &bc, csinn_relu_init(ctx.input0, ctx.output, ctx.params));
+        bc.op = "sigmoid";
+        ctx.params = csinn_alloc_params(sizeof(struct csinn_sigmoid_params), sess);
+        eltwise_op(&ctx, &bc, csinn_sigmoid_init(ctx.input0, ctx.output, ctx.params));
+        bc.op = "gelu";
+        ctx.params = csinn_alloc_params(sizeof(struct csinn_siso_params), sess);
+        eltwise_op(&ctx, &bc, csinn_gelu_init(ctx.input0, ctx.output, ctx.params));
+        bc.op = "silu";
+        ctx.params = csinn_alloc_params(sizeof(struct csinn_siso_params), sess);
+        eltwise_op(&ctx, &bc, csinn_silu_init(ctx.input0, ctx.output, ctx.params));
+    }
+
+    bench_free_tensor(ctx.input0);
+    bench_free_tensor(ctx.input1);
+    bench_free_tensor(ctx.output);
+    csinn_free_session(sess);
+}
+
+void bench_eltwise(void)
+{
+    for (int d = 0; d < BENCH_DTYPE_NUM; d++) {
+        if (!bench_dtype_enabled(bench_dtypes[d])) {
+            continue;
+        }
+        for (int i = 0; i < sizeof(eltwise_shapes) / sizeof(eltwise_shapes[0]); i++) {
+            eltwise_case(&eltwise_shapes[i], bench_dtypes[d]);
+        }
+    }
+}
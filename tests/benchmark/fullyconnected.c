@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "benchmark.h"
+
+/* batch rows of in_size features to out_size units */
+struct fc_shape {
+    const char *model;
+    int batch, in_size, out_size;
+};
+
+static const struct fc_shape fc_shapes[] = {
+    {"resnet50", 1, 2048, 1000}, {"mobilenetv2", 1, 1280, 1000}, {"bert", 128, 768, 768},
+    {"bert", 128, 768, 3072},    {"bert", 128, 3072, 768},
+};
+
+struct fc_ctx {
+    struct csinn_tensor *input;
+    struct csinn_tensor *output;
+    struct csinn_tensor *weight;
+    struct csinn_tensor *bias;
+    struct csinn_fc_params *params;
+};
+
+static int fc_run(void *ctx)
+{
+    struct fc_ctx *c = ctx;
+    return c->params->base.cb->exec(c->input, c->output, c->weight, c->bias, c->params);
+}
+
+static void fc_case(const struct fc_shape *s, enum csinn_dtype_enum dtype)
+{
+    int32_t in_dim[2] = {s->batch, s->in_size};
+    int32_t out_dim[2] = {s->batch, s->out_size};
+    int32_t weight_dim[2] = {s->out_size, s->in_size};
+    int32_t bias_dim[1] = {s->out_size};
+    bool quant = dtype == CSINN_DTYPE_INT8 || dtype == CSINN_DTYPE_UINT8;
+
+    struct bench_case bc = {.op = "fullyconnected", .algo = "-", .dtype = dtype};
+    snprintf(bc.shape, sizeof(bc.shape), "%s %dx%d o%d", s->model, s->batch, s->in_size,
+             s->out_size);
+
+    struct csinn_session *sess = bench_session(dtype);
+    struct fc_ctx ctx;
+    ctx.input = bench_tensor(sess, dtype, CSINN_LAYOUT_NC, 2, in_dim);
+    ctx.output = bench_output(sess, dtype, CSINN_LAYOUT_NC, 2, out_dim);
+    ctx.weight = bench_tensor(sess, dtype, CSINN_LAYOUT_OI, 2, weight_dim);
+    ctx.bias = bench_tensor(sess, quant ? CSINN_DTYPE_INT32 : dtype, CSINN_LAYOUT_O, 1, bias_dim);
+    ctx.weight->is_const = 1;
+    ctx.bias->is_const = 1;
+    if (quant) {
+        bench_set_quant(ctx.weight, 1.0f / 128, 0, 1);
+        bench_set_quant(ctx.bias, 1.0f / 32 / 128, 0, 1);
+        bench_set_quant(ctx.output, 1.0f / 4, ctx.output->qinfo->zero_point, 1);
+    }
+
+    struct csinn_fc_params *params = csinn_alloc_params(sizeof(*params), sess);
+    params->base.name = "fullyconnected";
+    params->units = s->out_size;
+    ctx.params = params;
+
+    bc.flops = 2.0 * s->batch * s->in_size * s->out_size;
+    bc.bytes = csinn_tensor_byte_size(ctx.input) + csinn_tensor_byte_size(ctx.weight) +
+               csinn_tensor_byte_size(ctx.bias) + csinn_tensor_byte_size(ctx.output);
+    bc.run = fc_run;
+    bc.ctx = &ctx;
+
+    if (csinn_fullyconnected_init(ctx.input, ctx.output, ctx.weight, ctx.bias, params) !=
+            CSINN_TRUE ||
+        params->base.cb->exec == NULL) {
+        bench_skip(bc.op, bc.algo, bc.shape, dtype, "unsupported");
+    } else {
+        bench_run(&bc);
+    }
+
+    bench_free_tensor(ctx.input);
+    bench_free_tensor(ctx.output);
+    bench_free_tensor(ctx.weight);
+    bench_free_tensor(ctx.bias);
+    csinn_free_params(params);
+    csinn_free_session(sess);
+}
+
+void bench_fullyconnected(void)
+{
+    for (int d = 0; d < BENCH_DTYPE_NUM; d++) {
+        if (!bench_dtype_enabled(bench_dtypes[d])) {
+            continue;
+        }
+        for (int i = 0; i < sizeof(fc_shapes) / sizeof(fc_shapes[0]); i++) {
+            fc_case(&fc_shapes[i], bench_dtypes[d]);
+        }
+    }
+}
@@ -0,0 +1,235 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "benchmark.h"
+#if defined(BENCH_RVV)
+#include "shl_thead_rvv.h"
+#elif defined(BENCH_C906)
+#include "shl_c906.h"
+#elif defined(BENCH_C908)
+#include "shl_c908.h"
+#endif
+
+/* m x k weights times k x n activations: conv 1x1, im2col, fc and attention shapes */
+struct gemm_shape {
+    const char *model;
+    int m, k, n;
+};
+
+static const struct gemm_shape gemm_shapes[] = {
+    {"resnet50", 64, 64, 3136},   {"resnet50", 256, 64, 3136},   {"resnet50", 64, 576, 3136},
+    {"resnet50", 256, 2304, 196}, {"resnet50", 512, 1024, 196},  {"mobilenetv2", 96, 16, 12544},
+    {"bert", 768, 768, 128},      {"bert", 3072, 768, 128},      {"fc", 1000, 2048, 1},
+};
+
+struct gemm_ctx {
+    int m, k, n;
+    struct csinn_tensor *a;
+    struct csinn_tensor *b;
+    struct csinn_tensor *c;
+    struct csinn_tensor *bias;
+    void *sa;  // a and b packed by the backend reorder, outside the timed loop
+    void *sb;
+    int32_t *mult;
+    int32_t *shift;
+    struct csinn_matmul_params *params;
+};
+
+/* csinn_matmul through the backend callback, backends without a micro-kernel entry */
+static int gemm_matmul_run(void *ctx)
+{
+    struct gemm_ctx *g = ctx;
+    return g->params->base.cb->exec(g->a, g->b, g->c, g->params);
+}
+
+#if defined(BENCH_RVV)
+static const char *gemm_algo = "rvv_gemm";
+
+static int gemm_kernel_run(void *ctx)
+{
+    struct gemm_ctx *g = ctx;
+    if (g->a->dtype == CSINN_DTYPE_FLOAT32) {
+        shl_rvv_gemm_8x8_fp32(g->c->data, g->sa, g->sb, g->bias->data, g->m, g->k, g->n, g->n);
+    } else if (g->a->dtype == CSINN_DTYPE_FLOAT16) {
+        shl_rvv_gemm_8x16_fp16(g->c->data, g->sa, g->sb, g->bias->data, g->m, g->k, g->n, g->n);
+    } else {
+        shl_rvv_gemm_8x8_int8(g->c->data, g->sa, g->sb, g->bias->data, g->m, g->k, g->n, g->n, 0,
+                              g->mult, g->shift);
+    }
+    return CSINN_TRUE;
+}
+
+static void gemm_kernel_pack(struct gemm_ctx *g)
+{
+    if (g->a->dtype == CSINN_DTYPE_FLOAT32) {
+        shl_rvv_reorder_kernel_n8_fp32(g->a->data, g->sa, g->m, g->k, g->k);
+        shl_rvv_reorder_input_z8_fp32(g->b->data, g->sb, g->k, g->n, g->n);
+    } else if (g->a->dtype == CSINN_DTYPE_FLOAT16) {
+        shl_rvv_reorder_kernel_n8_fp16(g->a->data, g->sa, g->m, g->k, g->k);
+        shl_rvv_reorder_input_z16_fp16(g->b->data, g->sb, g->k, g->n, g->n);
+    } else {
+        shl_rvv_reorder_kernel_n8_int8(g->a->data, g->sa, g->m, g->k, g->k);
+        shl_rvv_reorder_input_z8_int8(g->b->data, g->sb, g->k, g->n, g->n);
+    }
+}
+#elif defined(BENCH_C908)
+static const char *gemm_algo = "c908_gemm";
+
+static int gemm_kernel_run(void *ctx)
+{
+    struct gemm_ctx *g = ctx;
+    if (g->a->dtype == CSINN_DTYPE_FLOAT32) {
+        shl_c908_gemm_8x12_fp32(g->c->data, g->sa, g->sb, g->bias->data, g->m, g->k, g->n, g->n);
+    } else if (g->a->dtype == CSINN_DTYPE_FLOAT16) {
+        shl_c908_gemm_8x24_fp16(g->c->data, g->sa, g->sb, g->bias->data, g->m, g->k, g->n, g->n);
+    } else {
+        shl_c908_gemm_8x8_int8(g->c->data, g->sa, g->sb, g->bias->data, g->m, g->k, g->n, g->n,
+                               0, g->mult, g->shift);
+    }
+    return CSINN_TRUE;
+}
+
+static void gemm_kernel_pack(struct gemm_ctx *g)
+{
+    if (g->a->dtype == CSINN_DTYPE_FLOAT32) {
+        shl_c908_reorder_kernel_n8_fp32(g->a->data, g->sa, g->m, g->k, g->k);
+        shl_c908_reorder_input_z12_fp32(g->b->data, g->sb, g->k, g->n, g->n);
+    } else if (g->a->dtype == CSINN_DTYPE_FLOAT16) {
+        shl_c908_reorder_kernel_n8_fp16(g->a->data, g->sa, g->m, g->k, g->k);
+        shl_c908_reorder_input_z24_fp16(g->b->data, g->sb, g->k, g->n, g->n);
+    } else {
+        shl_c908_reorder_kernel_n8_int8(g->a->data, g->sa, g->m, g->k, g->k);
+        shl_c908_reorder_input_z8_int8(g->b->data, g->sb, g->k, g->n, g->n);
+    }
+}
+#elif defined(BENCH_C906)
+static const char *gemm_algo = "c906_sgemm";
+
+static int gemm_kernel_run(void *ctx)
+{
+    struct gemm_ctx *g = ctx;
+    if (g->a->dtype == CSINN_DTYPE_FLOAT32) {
+        shl_c906_sgemm_kernel_f32(g->c->data, g->sa, g->sb, g->m, g->k, g->n, g->n, g->bias->data,
+                                  false);
+    } else {
+        shl_c906_sgemm_kernel_fp16(g->c->data, g->sa, g->sb, g->m, g->k, g->n, g->n,
+                                   g->bias->data);
+    }
+    return CSINN_TRUE;
+}
+
+static void gemm_kernel_pack(struct gemm_ctx *g)
+{
+    if (g->a->dtype == CSINN_DTYPE_FLOAT32) {
+        shl_c906_reorder_kernel(g->a->data, g->sa, g->m, g->k, g->k);
+        shl_c906_reorder_input(g->b->data, g->sb, g->k, g->n, g->n);
+    } else {
+        shl_c906_reorder_kernel_fp16(g->a->data, g->sa, g->m, g->k, g->k);
+        shl_c906_reorder_input_fp16(g->b->data, g->sb, g->k, g->n, g->n);
+    }
+}
+#endif
+
+#if defined(BENCH_RVV) || defined(BENCH_C906) || defined(BENCH_C908)
+static bool gemm_kernel_support(enum csinn_dtype_enum dtype)
+{
+#ifdef BENCH_C906
+    return dtype == CSINN_DTYPE_FLOAT32 || dtype == CSINN_DTYPE_FLOAT16;
+#else
+    return dtype == CSINN_DTYPE_FLOAT32 || dtype == CSINN_DTYPE_FLOAT16 ||
+           dtype == CSINN_DTYPE_INT8;
+#endif
+}
+#endif
+
+static void gemm_case(const struct gemm_shape *s, enum csinn_dtype_enum dtype)
+{
+    int32_t a_dim[2] = {s->m, s->k};
+    int32_t b_dim[2] = {s->k, s->n};
+    int32_t c_dim[2] = {s->m, s->n};
+    int32_t bias_dim[1] = {s->m};
+    bool quant = dtype == CSINN_DTYPE_INT8 || dtype == CSINN_DTYPE_UINT8;
+
+    struct csinn_session *sess = bench_session(dtype);
+    struct gemm_ctx ctx = {.m = s->m, .k = s->k, .n = s->n};
+    ctx.a = bench_tensor(sess, dtype, CSINN_LAYOUT_NC, 2, a_dim);
+    ctx.b = bench_tensor(sess, dtype, CSINN_LAYOUT_NC, 2, b_dim);
+    ctx.c = bench_output(sess, dtype, CSINN_LAYOUT_NC, 2, c_dim);
+    ctx.bias = bench_tensor(sess, quant ? CSINN_DTYPE_INT32 : dtype, CSINN_LAYOUT_O, 1, bias_dim);
+
+    struct bench_case bc = {.op = "gemm", .dtype = dtype};
+    snprintf(bc.shape, sizeof(bc.shape), "%s m%d k%d n%d", s->model, s->m, s->k, s->n);
+    bc.flops = 2.0 * s->m * s->k * s->n;
+    bc.bytes = csinn_tensor_byte_size(ctx.a) + csinn_tensor_byte_size(ctx.b) +
+               csinn_tensor_byte_size(ctx.c);
+    bc.ctx = &ctx;
+
+    /* the micro-kernel alone, then the full matmul op with its packing */
+#if defined(BENCH_RVV) || defined(BENCH_C906) || defined(BENCH_C908)
+    if (gemm_kernel_support(dtype)) {
+        int elem = csinn_tensor_byte_size(ctx.a) / (s->m * s->k);
+        ctx.sa = shl_mem_alloc((int64_t)(s->m + 16) * (s->k + 4) * elem);
+        ctx.sb = shl_mem_alloc((int64_t)(s->k + 4) * (s->n + 24) * elem);
+        ctx.mult = shl_mem_alloc(s->m * sizeof(int32_t));
+        ctx.shift = shl_mem_alloc(s->m * sizeof(int32_t));
+        for (int i = 0; i < s->m; i++) {
+            shl_quantize_multiplier(1.0 / 256, &ctx.mult[i], &ctx.shift[i]);
+        }
+        gemm_kernel_pack(&ctx);
+        bc.algo = gemm_algo;
+        bc.run = gemm_kernel_run;
+        bench_run(&bc);
+        shl_mem_free(ctx.sa);
+        shl_mem_free(ctx.sb);
+        shl_mem_free(ctx.mult);
+        shl_mem_free(ctx.shift);
+    }
+#endif
+
+    ctx.params = csinn_alloc_params(sizeof(struct csinn_matmul_params), sess);
+    ctx.params->base.name = "matmul";
+    bc.algo = "matmul";
+    bc.run = gemm_matmul_run;
+    if (csinn_matmul_init(ctx.a, ctx.b, ctx.c, ctx.params) != CSINN_TRUE ||
+        ctx.params->base.cb->exec == NULL) {
+        bench_skip(bc.op, bc.algo, bc.shape, dtype, "unsupported");
+    } else {
+        bench_run(&bc);
+    }
+
+    csinn_free_params(ctx.params);
+    bench_free_tensor(ctx.a);
+    bench_free_tensor(ctx.b);
+    bench_free_tensor(ctx.c);
+    bench_free_tensor(ctx.bias);
+    csinn_free_session(sess);
+}
+
+void bench_gemm(void)
+{
+    for (int d = 0; d < BENCH_DTYPE_NUM; d++) {
+        if (!bench_dtype_enabled(bench_dtypes[d])) {
+            continue;
+        }
+        for (int i = 0; i < sizeof(gemm_shapes) / sizeof(gemm_shapes[0]); i++) {
+            gemm_case(&gemm_shapes[i], bench_dtypes[d]);
+        }
+    }
+}
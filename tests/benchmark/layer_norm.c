@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "benchmark.h"
+
+/* [1, tokens, hidden], normalized over hidden */
+struct layer_norm_shape {
+    const char *model;
+    int tokens, hidden;
+};
+
+static const struct layer_norm_shape layer_norm_shapes[] = {
+    {"bert", 128, 768},
+    {"vit", 197, 768},
+    {"whisper", 1500, 384},
+};
+
+struct layer_norm_ctx {
+    struct csinn_tensor *input;
+    struct csinn_tensor *output;
+    struct csinn_tensor *gamma;
+    struct csinn_tensor *beta;
+    struct csinn_layer_norm_params *params;
+};
+
+static int layer_norm_run(void *ctx)
+{
+    struct layer_norm_ctx *c = ctx;
+    return c->params->base.cb->exec(c->input, c->output, c->gamma, c->beta, c->params);
+}
+
+static void layer_norm_case(const struct layer_norm_shape *s, enum csinn_dtype_enum dtype)
+{
+    int32_t dim[3] = {1, s->tokens, s->hidden};
+    int32_t gamma_dim[1] = {s->hidden};
+
+    struct bench_case bc = {.op = "layer_norm", .algo = "-", .dtype = dtype};
+    snprintf(bc.shape, sizeof(bc.shape), "%s 1x%dx%d", s->model, s->tokens, s->hidden);
+
+    struct csinn_session *sess = bench_session(dtype);
+    struct layer_norm_ctx ctx;
+    ctx.input = bench_tensor(sess, dtype, CSINN_LAYOUT_NCW, 3, dim);
+    ctx.output = bench_output(sess, dtype, CSINN_LAYOUT_NCW, 3, dim);
+    ctx.gamma = bench_tensor(sess, dtype, CSINN_LAYOUT_O, 1, gamma_dim);
+    ctx.beta = bench_tensor(sess, dtype, CSINN_LAYOUT_O, 1, gamma_dim);
+    ctx.gamma->is_const = 1;
+    ctx.beta->is_const = 1;
+
+    struct csinn_layer_norm_params *params = csinn_alloc_params(sizeof(*params), sess);
+    params->base.name = "layer_norm";
+    params->epsilon = 1e-5f;
+    params->center = true;
+    params->scale = true;
+    params->axis = -1;
+    ctx.params = params;
+
+    /* mean, centre, square-sum and affine per element */
+    bc.flops = 8.0 * csinn_tensor_size(ctx.input);
+    bc.bytes = csinn_tensor_byte_size(ctx.input) + csinn_tensor_byte_size(ctx.output) +
+               2 * csinn_tensor_byte_size(ctx.gamma);
+    bc.run = layer_norm_run;
+    bc.ctx = &ctx;
+
+    if (csinn_layer_norm_init(ctx.input, ctx.output, ctx.gamma, ctx.beta, params) != CSINN_TRUE ||
+        params->base.cb->exec == NULL) {
+        bench_skip(bc.op, bc.algo, bc.shape, dtype, "unsupported");
+    } else {
+        bench_run(&bc);
+    }
+
+    bench_free_tensor(ctx.input);
+    bench_free_tensor(ctx.output);
+    bench_free_tensor(ctx.gamma);
+    bench_free_tensor(ctx.beta);
+    csinn_free_params(params);
+    csinn_free_session(sess);
+}
+
+void bench_layer_norm(void)
+{
+    for (int d = 0; d < BENCH_DTYPE_NUM; d++) {
+        if (!bench_dtype_enabled(bench_dtypes[d])) {
+            continue;
+        }
+        for (int i = 0; i < sizeof(layer_norm_shapes) / sizeof(layer_norm_shapes[0]); i++) {
+            layer_norm_case(&layer_norm_shapes[i], bench_dtypes[d]);
+        }
+    }
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "benchmark.h"
+
+/*************************************************************
+ * operator micro-benchmarks of one backend, chosen by CSINN_API at build
+ * e.g. ./benchmark.elf -d fp32,int8 -f conv2d -o csv > conv2d.csv
+ *************************************************************/
+int main(int argc, char **argv)
+{
+    if (bench_parse_options(argc, argv) != CSINN_TRUE) {
+        return 1;
+    }
+
+    bench_print_header();
+    bench_conv2d();
+    bench_gemm();
+    bench_fullyconnected();
+    bench_pool();
+    bench_eltwise();
+    bench_softmax();
+    bench_layer_norm();
+    bench_data_convert();
+
+    return bench_done();
+}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "benchmark.h"
+
+enum pool_kind {
+    POOL_MAX = 0,
+    POOL_AVG,
+    POOL_GLOBAL_AVG,
+};
+
+struct pool_shape {
+    enum pool_kind kind;
+    const char *model;
+    int c, h, w;
+    int kernel, stride, pad;
+};
+
+static const struct pool_shape pool_shapes[] = {
+    {POOL_MAX, "resnet50", 64, 112, 112, 3, 2, 1},
+    {POOL_MAX, "yolov5s_sppf", 256, 20, 20, 5, 1, 2},
+    {POOL_MAX, "vgg16", 128, 112, 112, 2, 2, 0},
+    {POOL_AVG, "densenet121", 128, 56, 56, 2, 2, 0},
+    {POOL_AVG, "inceptionv3", 192, 35, 35, 3, 1, 1},
+    {POOL_GLOBAL_AVG, "resnet50", 2048, 7, 7, 7, 1, 0},
+    {POOL_GLOBAL_AVG, "mobilenetv2", 1280, 7, 7, 7, 1, 0},
+};
+
+static const char *pool_names[] = {"maxpool2d", "avgpool2d", "global_avgpool2d"};
+
+struct pool_ctx {
+    struct csinn_tensor *input;
+    struct csinn_tensor *output;
+    struct csinn_pool_params *params;
+};
+
+static int pool_run(void *ctx)
+{
+    struct pool_ctx *c = ctx;
+    return c->params->base.cb->exec(c->input, c->output, c->params);
+}
+
+static void pool_case(const struct pool_shape *s, enum csinn_dtype_enum dtype)
+{
+    int out_h = (s->h + 2 * s->pad - s->kernel) / s->stride + 1;
+    int out_w = (s->w + 2 * s->pad - s->kernel) / s->stride + 1;
+    int32_t in_dim[4] = {1, s->c, s->h, s->w};
+    int32_t out_dim[4] = {1, s->c, out_h, out_w};
+
+    struct bench_case bc = {.op = pool_names[s->kind], .algo = "-", .dtype = dtype};
+    snprintf(bc.shape, sizeof(bc.shape), "%s %dx%dx%d k%ds%d", s->model, s->c, s->h, s->w,
+             s->kernel, s->stride);
+
+    struct csinn_session *sess = bench_session(dtype);
+    struct pool_ctx ctx;
+    ctx.input = bench_tensor(sess, dtype, CSINN_LAYOUT_NCHW, 4, in_dim);
+    ctx.output = bench_output(sess, dtype, CSINN_LAYOUT_NCHW, 4, out_dim);
+
+    struct csinn_pool_params *params = csinn_alloc_params(sizeof(*params), sess);
+    params->base.name = "pool";
+    params->filter_height = s->kernel;
+    params->filter_width = s->kernel;
+    params->stride_height = s->stride;
+    params->stride_width = s->stride;
+    params->pad_top = s->pad;
+    params->pad_down = s->pad;
+    params->pad_left = s->pad;
+    params->pad_right = s->pad;
+    params->count_include_pad = false;
+    ctx.params = params;
+
+    bc.flops = (double)s->c * out_h * out_w * s->kernel * s->kernel;
+    bc.bytes = csinn_tensor_byte_size(ctx.input) + csinn_tensor_byte_size(ctx.output);
+    bc.run = pool_run;
+    bc.ctx = &ctx;
+
+    int ret;
+    if (s->kind == POOL_MAX) {
+        ret = csinn_maxpool2d_init(ctx.input, ctx.output, params);
+    } else if (s->kind == POOL_AVG) {
+        ret = csinn_avgpool2d_init(ctx.input, ctx.output, params);
+    } else {
+        ret = csinn_global_avgpool2d_init(ctx.input, ctx.output, params);
+    }
+    if (ret != CSINN_TRUE || params->base.cb->exec == NULL) {
+        bench_skip(bc.op, bc.algo, bc.shape, dtype, "unsupported");
+    } else {
+        bench_run(&bc);
+    }
+
+    bench_free_tensor(ctx.input);
+    bench_free_tensor(ctx.output);
+    csinn_free_params(params);
+    csinn_free_session(sess);
+}
+
+void bench_pool(void)
+{
+    for (int d = 0; d < BENCH_DTYPE_NUM; d++) {
+        if (!bench_dtype_enabled(bench_dtypes[d])) {
+            continue;
+        }
+        for (int i = 0; i < sizeof(pool_shapes) / sizeof(pool_shapes[0]); i++) {
+            pool_case(&pool_shapes[i], bench_dtypes[d]);
+        }
+    }
+}
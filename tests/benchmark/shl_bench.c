@@ -0,0 +1,496 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include "csi_nn.h"
+#include "shl_gref.h"
+#include "shl_utils.h"
+
+/*************************************************************
+ * shl_bench: end-to-end latency and throughput of one model
+ *
+ * the model is either
+ *   .bm      binary model, its graph section is loaded by csinn_import_binary_model,
+ *            a params only binary model goes to the HHB generated csinn_()
+ *   .params  HHB params, goes to the HHB generated csinn_()
+ * csinn_() comes from linking the HHB generated model.c, without it only the graph
+ * section of a binary model can be loaded, and only by backends with CSINN_LOAD_BG
+ *************************************************************/
+void *csinn_(char *params) __attribute__((weak));
+
+struct shl_bench_options {
+    int warmup;
+    int repeat;
+    int thread_num;  // intra-op threads, 0 means library default
+    int sessions;    // throughput mode when not 0
+    int layer;
+    uint32_t seed;
+    const char *model;
+    const char **inputs;
+    int input_num;
+};
+
+static struct shl_bench_options opt = {
+    .warmup = 5,
+    .repeat = 50,
+    .seed = 1,
+};
+
+/* one session with its own copy of the model, init may repack weights in place */
+struct shl_bench_runner {
+    char *buf;
+    struct csinn_session *sess;
+    struct csinn_tensor **inputs;
+    uint64_t *latency;
+    int failed;
+    pthread_barrier_t *barrier;
+};
+
+static void usage(const char *prog)
+{
+    printf("usage: %s [options] model [input ...]\n", prog);
+    printf("  model  .bm binary model, or .params with the HHB generated model.c linked in\n");
+    printf("  input  raw float32 data per model input, random when missing\n");
+    printf("  -w N   warm-up runs per session, default 5\n");
+    printf("  -n N   timed runs per session, default 50\n");
+    printf("  -j N   intra-op threads of reference kernels, default OpenMP, 1 with -t\n");
+    printf("  -t N   throughput mode, N sessions each run by its own thread\n");
+    printf("  -l     per layer breakdown, graph runtime only\n");
+    printf("  -s N   seed of random inputs, default 1\n");
+}
+
+static int parse_options(int argc, char **argv)
+{
+    int c;
+    while ((c = getopt(argc, argv, "w:n:j:t:ls:h")) != -1) {
+        switch (c) {
+            case 'w':
+                opt.warmup = atoi(optarg);
+                break;
+            case 'n':
+                opt.repeat = atoi(optarg);
+                break;
+            case 'j':
+                opt.thread_num = atoi(optarg);
+                break;
+            case 't':
+                opt.sessions = atoi(optarg);
+                break;
+            case 'l':
+                opt.layer = 1;
+                break;
+            case 's':
+                opt.seed = strtoul(optarg, NULL, 0);
+                break;
+            default:
+                usage(argv[0]);
+                return CSINN_FALSE;
+        }
+    }
+    if (optind >= argc || opt.warmup < 0 || opt.repeat < 1 || opt.sessions < 0) {
+        usage(argv[0]);
+        return CSINN_FALSE;
+    }
+    opt.model = argv[optind];
+    opt.inputs = (const char **)argv + optind + 1;
+    opt.input_num = argc - optind - 1;
+    return CSINN_TRUE;
+}
+
+static double ms(uint64_t ns) { return ns / 1000000.0; }
+
+/* KiB on Linux */
+static long peak_rss(void)
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+static char *read_file(const char *path, size_t *size)
+{
+    FILE *fp = fopen(path, "rb");
+    if (fp == NULL) {
+        fprintf(stderr, "cannot open %s\n", path);
+        return NULL;
+    }
+    fseek(fp, 0, SEEK_END);
+    *size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+    /* sections of a binary model are page aligned */
+    char *buf = shl_mem_alloc_aligned(*size, 0);
+    if (fread(buf, 1, *size, fp) != *size) {
+        fprintf(stderr, "cannot read %s\n", path);
+        shl_mem_free(buf);
+        buf = NULL;
+    }
+    fclose(fp);
+    return buf;
+}
+
+static int has_suffix(const char *str, const char *suffix)
+{
+    size_t len = strlen(str);
+    size_t suffix_len = strlen(suffix);
+    return len >= suffix_len && strcmp(str + len - suffix_len, suffix) == 0;
+}
+
+static struct csinn_session *create_session(char *buf)
+{
+    struct csinn_session *sess = NULL;
+    char *params = buf;
+    if (has_suffix(opt.model, ".bm")) {
+        struct shl_binary_model_section_info *sinfo =
+            (struct shl_binary_model_section_info *)(buf + 4096);
+        if (sinfo->sections[0].graph_offset) {
+            sess = csinn_import_binary_model(buf);
+            if (shl_get_runtime_callback(sess, CSINN_LOAD_BG) == NULL) {
+                fprintf(stderr, "api %d cannot load the graph section of a binary model\n",
+                        sess->base_api);
+                return NULL;
+            }
+            return sess;
+        }
+        params = buf + sinfo->sections[0].params_offset * 4096;
+    }
+    if (csinn_ == NULL) {
+        fprintf(stderr, "%s needs the HHB generated model.c linked in\n", opt.model);
+        return NULL;
+    }
+    return csinn_(params);
+}
+
+static uint32_t lcg_next(uint32_t *state)
+{
+    *state = *state * 1664525u + 1013904223u;
+    return *state;
+}
+
+/* model inputs in the dtype of the session, from file or uniform random in [-1, 1) */
+static struct csinn_tensor **create_inputs(struct csinn_session *sess)
+{
+    int input_num = csinn_get_input_number(sess);
+    struct csinn_tensor **inputs = shl_mem_alloc(input_num * sizeof(struct csinn_tensor *));
+    uint32_t state = opt.seed;
+
+    for (int i = 0; i < input_num; i++) {
+        struct csinn_tensor *input = csinn_alloc_tensor(NULL);
+        csinn_get_input(i, input, sess);
+        int size = csinn_tensor_size(input);
+
+        struct csinn_tensor *finput = csinn_alloc_tensor(NULL);
+        csinn_tensor_copy(finput, input);
+        finput->dtype = CSINN_DTYPE_FLOAT32;
+        finput->data = shl_mem_alloc(size * sizeof(float));
+        float *fdata = finput->data;
+        if (i < opt.input_num) {
+            size_t file_size = 0;
+            char *file = read_file(opt.inputs[i], &file_size);
+            size_t bytes = size * sizeof(float);
+            if (file != NULL) {
+                memcpy(fdata, file, file_size < bytes ? file_size : bytes);
+                shl_mem_free(file);
+            }
+            if (file_size != bytes) {
+                fprintf(stderr, "%s has %ld bytes, input %d wants %ld\n", opt.inputs[i],
+                        (long)file_size, i, (long)bytes);
+            }
+        } else {
+            for (int j = 0; j < size; j++) {
+                fdata[j] = (int32_t)lcg_next(&state) / 2147483648.0f;
+            }
+        }
+
+        if (input->dtype == CSINN_DTYPE_FLOAT32) {
+            input->data = fdata;
+        } else {
+            /* data convert skips tensors without layout */
+            int32_t layout = input->layout;
+            if (layout == CSINN_LAYOUT_NULL) {
+                input->layout = finput->layout = CSINN_LAYOUT_N;
+            }
+            input->data = shl_mem_alloc(csinn_tensor_byte_size(input));
+            csinn_tensor_data_convert(input, finput);
+            input->layout = layout;
+            shl_mem_free(fdata);
+        }
+        csinn_free_tensor(finput);
+        inputs[i] = input;
+    }
+    return inputs;
+}
+
+static int run_once(struct shl_bench_runner *r)
+{
+    int input_num = csinn_get_input_number(r->sess);
+    for (int i = 0; i < input_num; i++) {
+        csinn_update_input(i, r->inputs[i], r->sess);
+    }
+    return csinn_session_run(r->sess);
+}
+
+static int runner_init(struct shl_bench_runner *r, const char *image, size_t size)
+{
+    memset(r, 0, sizeof(*r));
+    r->buf = shl_mem_alloc_aligned(size, 0);
+    memcpy(r->buf, image, size);
+    r->sess = create_session(r->buf);
+    if (r->sess == NULL) {
+        return CSINN_FALSE;
+    }
+    if (opt.thread_num > 0) {
+        r->sess->thread_num = opt.thread_num;
+    } else if (opt.sessions > 0) {
+        r->sess->thread_num = 1;
+    }
+    r->inputs = create_inputs(r->sess);
+    r->latency = shl_mem_alloc(opt.repeat * sizeof(uint64_t));
+    return CSINN_TRUE;
+}
+
+static void runner_warmup(struct shl_bench_runner *r)
+{
+    for (int i = 0; i < opt.warmup; i++) {
+        run_once(r);
+    }
+}
+
+static void runner_timed(struct shl_bench_runner *r)
+{
+    for (int i = 0; i < opt.repeat; i++) {
+        uint64_t start = shl_get_timespec();
+        if (run_once(r) != CSINN_TRUE) {
+            r->failed++;
+        }
+        r->latency[i] = shl_get_timespec() - start;
+    }
+}
+
+static void *runner_thread(void *arg)
+{
+    struct shl_bench_runner *r = arg;
+    pthread_barrier_wait(r->barrier);
+    runner_warmup(r);
+    runner_timed(r);
+    return NULL;
+}
+
+static int cmp_u64(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a;
+    uint64_t y = *(const uint64_t *)b;
+    return x < y ? -1 : x > y;
+}
+
+/* nearest rank percentile of sorted samples */
+static uint64_t percentile(const uint64_t *sorted, int num, int p)
+{
+    int rank = (p * num + 99) / 100;
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+static void print_latency(uint64_t *latency, int num)
+{
+    qsort(latency, num, sizeof(uint64_t), cmp_u64);
+    uint64_t sum = 0;
+    for (int i = 0; i < num; i++) {
+        sum += latency[i];
+    }
+    printf("latency ms     : min %.3f  p50 %.3f  p90 %.3f  p99 %.3f  max %.3f  mean %.3f\n",
+           ms(latency[0]), ms(percentile(latency, num, 50)), ms(percentile(latency, num, 90)),
+           ms(percentile(latency, num, 99)), ms(latency[num - 1]), ms(sum / num));
+}
+
+static void print_allocs(const char *phase, struct shl_mem_stats *begin, struct shl_mem_stats *end,
+                         int runs)
+{
+    printf("%-15s: %.1f allocs  %.1f frees  %.1f KiB\n", phase,
+           (double)(end->alloc_count - begin->alloc_count) / runs,
+           (double)(end->free_count - begin->free_count) / runs,
+           (end->alloc_bytes - begin->alloc_bytes) / 1024.0 / runs);
+}
+
+static void reset_layers(struct csinn_session *sess)
+{
+    struct shl_ref_graph *g = shl_gref_get_graph(sess);
+    for (int i = 0; i < g->layer_index; i++) {
+        g->layer[i]->run_time = 0;
+        g->layer[i]->run_count = 0;
+    }
+}
+
+static void print_layers(struct csinn_session *sess)
+{
+    struct shl_ref_graph *g = shl_gref_get_graph(sess);
+    uint64_t total = 0;
+    for (int i = 0; i < g->layer_index; i++) {
+        total += g->layer[i]->run_time;
+    }
+    printf("\n%5s  %-40s %10s %7s  %s\n", "layer", "name", "avg ms", "%", "output");
+    for (int i = 0; i < g->layer_index; i++) {
+        struct shl_node *n = g->layer[i];
+        if (n->run_count == 0) {
+            continue;
+        }
+        printf("%5d  %-40.40s %10.3f %6.2f%%  ", i, n->name ? n->name : "-",
+               ms(n->run_time) / n->run_count, total ? 100.0 * n->run_time / total : 0.0);
+        if (n->type == CSINN_SUBGRAPH) {
+            printf("subgraph\n");
+            continue;
+        }
+        struct csinn_tensor *out = n->out[0]->data;
+        for (int k = 0; k < out->dim_count; k++) {
+            printf(k ? "x%d" : "%d", out->dim[k]);
+        }
+        printf("\n");
+    }
+}
+
+static int bench_latency(const char *image, size_t size, uint64_t read_time)
+{
+    struct shl_bench_runner r;
+    struct shl_mem_stats create_begin, create_end, run_begin, run_end;
+
+    shl_mem_get_stats(&create_begin);
+    uint64_t start = shl_get_timespec();
+    if (runner_init(&r, image, size) != CSINN_TRUE) {
+        return CSINN_FALSE;
+    }
+    uint64_t created = shl_get_timespec();
+    int ret = run_once(&r);
+    uint64_t first = shl_get_timespec();
+    shl_mem_get_stats(&create_end);
+    long setup_rss = peak_rss();
+    if (ret != CSINN_TRUE) {
+        fprintf(stderr, "first run failed\n");
+        return CSINN_FALSE;
+    }
+
+    int graph = r.sess->base_run_mode == CSINN_RM_CPU_GRAPH;
+    if (opt.layer && !graph) {
+        fprintf(stderr, "per layer breakdown needs the graph runtime\n");
+    }
+    int layer = opt.layer && graph;
+    if (layer) {
+        r.sess->profiler_level = CSI_PROFILER_LEVEL_LAYER;
+    }
+
+    runner_warmup(&r);
+    /* layer times come from the timed runs only */
+    if (layer) {
+        reset_layers(r.sess);
+    }
+    shl_mem_get_stats(&run_begin);
+    runner_timed(&r);
+    shl_mem_get_stats(&run_end);
+
+    printf("model          : %s\n", opt.model);
+    printf("cold start ms  : read %.3f  load+setup %.3f  first run %.3f\n", ms(read_time),
+           ms(created - start), ms(first - created));
+    printf("runs           : %d warm-up, %d timed, %d failed\n", opt.warmup, opt.repeat,
+           r.failed);
+    print_latency(r.latency, opt.repeat);
+    printf("peak RSS KiB   : %ld after first run, %ld at end\n", setup_rss, peak_rss());
+    print_allocs("cold start", &create_begin, &create_end, 1);
+    print_allocs("per run", &run_begin, &run_end, opt.repeat);
+    if (layer) {
+        print_layers(r.sess);
+    }
+    return r.failed ? CSINN_FALSE : CSINN_TRUE;
+}
+
+static int bench_throughput(const char *image, size_t size)
+{
+    int num = opt.sessions;
+    struct shl_bench_runner *r = shl_mem_alloc(num * sizeof(struct shl_bench_runner));
+    pthread_t *threads = shl_mem_alloc(num * sizeof(pthread_t));
+    pthread_barrier_t barrier;
+
+    uint64_t start = shl_get_timespec();
+    for (int i = 0; i < num; i++) {
+        if (runner_init(&r[i], image, size) != CSINN_TRUE) {
+            return CSINN_FALSE;
+        }
+    }
+    uint64_t created = shl_get_timespec();
+
+    /* main thread joins the barrier to take the start time once all workers are ready */
+    pthread_barrier_init(&barrier, NULL, num + 1);
+    for (int i = 0; i < num; i++) {
+        r[i].barrier = &barrier;
+        pthread_create(&threads[i], NULL, runner_thread, &r[i]);
+    }
+    pthread_barrier_wait(&barrier);
+    uint64_t run_start = shl_get_timespec();
+    for (int i = 0; i < num; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    uint64_t run_end = shl_get_timespec();
+    pthread_barrier_destroy(&barrier);
+
+    uint64_t *latency = shl_mem_alloc(num * opt.repeat * sizeof(uint64_t));
+    int failed = 0;
+    for (int i = 0; i < num; i++) {
+        memcpy(latency + i * opt.repeat, r[i].latency, opt.repeat * sizeof(uint64_t));
+        failed += r[i].failed;
+    }
+    double runs = (double)num * (opt.warmup + opt.repeat);
+
+    printf("model          : %s\n", opt.model);
+    printf("sessions       : %d, %d intra-op threads each\n", num, r[0].sess->thread_num);
+    printf("load+setup ms  : %.3f all sessions\n", ms(created - start));
+    printf("runs           : %d warm-up, %d timed per session, %d failed\n", opt.warmup,
+           opt.repeat, failed);
+    printf("throughput     : %.2f inferences/s\n", runs / ((run_end - run_start) / 1e9));
+    print_latency(latency, num * opt.repeat);
+    printf("peak RSS KiB   : %ld\n", peak_rss());
+    return failed ? CSINN_FALSE : CSINN_TRUE;
+}
+
+int main(int argc, char **argv)
+{
+    if (parse_options(argc, argv) != CSINN_TRUE) {
+        return 1;
+    }
+
+    size_t size = 0;
+    uint64_t start = shl_get_timespec();
+    char *image = read_file(opt.model, &size);
+    uint64_t read_time = shl_get_timespec() - start;
+    if (image == NULL) {
+        return 1;
+    }
+
+    int ret;
+    if (opt.sessions > 0) {
+        ret = bench_throughput(image, size);
+    } else {
+        ret = bench_latency(image, size, read_time);
+    }
+    /* sessions are left to process exit, teardown is not part of any figure */
+    shl_mem_free(image);
+    return ret == CSINN_TRUE ? 0 : 1;
+}
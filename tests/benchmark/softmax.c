@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "benchmark.h"
+
+struct softmax_shape {
+    const char *model;
+    int dim_count;
+    int32_t dim[4];
+    int axis;
+};
+
+static const struct softmax_shape softmax_shapes[] = {
+    {"resnet50", 2, {1, 1000}, 1},
+    {"bert", 4, {1, 12, 128, 128}, 3},
+    {"vit", 4, {1, 12, 197, 197}, 3},
+    {"segment", 4, {1, 21, 128, 128}, 1},
+};
+
+struct softmax_ctx {
+    struct csinn_tensor *input;
+    struct csinn_tensor *output;
+    struct csinn_softmax_params *params;
+};
+
+static int softmax_run(void *ctx)
+{
+    struct softmax_ctx *c = ctx;
+    return c->params->base.cb->exec(c->input, c->output, c->params);
+}
+
+static void softmax_case(const struct softmax_shape *s, enum csinn_dtype_enum dtype)
+{
+    enum csinn_layout_enum layout = s->dim_count == 2 ? CSINN_LAYOUT_NC : CSINN_LAYOUT_NCHW;
+
+    struct bench_case bc = {.op = "softmax", .dtype = dtype};
+    bc.algo = s->axis == s->dim_count - 1 ? "inner_axis" : "outer_axis";
+    int len = snprintf(bc.shape, sizeof(bc.shape), "%s ", s->model);
+    for (int i = 0; i < s->dim_count; i++) {
+        len += snprintf(bc.shape + len, sizeof(bc.shape) - len, i ? "x%d" : "%d", s->dim[i]);
+    }
+    snprintf(bc.shape + len, sizeof(bc.shape) - len, " axis%d", s->axis);
+
+    struct csinn_session *sess = bench_session(dtype);
+    struct softmax_ctx ctx;
+    ctx.input = bench_tensor(sess, dtype, layout, s->dim_count, s->dim);
+    ctx.output = bench_output(sess, dtype, layout, s->dim_count, s->dim);
+    if (dtype == CSINN_DTYPE_INT8 || dtype == CSINN_DTYPE_UINT8) {
+        bench_set_quant(ctx.output, 1.0f / 256, ctx.output->qinfo->zero_point, 1);
+    }
+
+    struct csinn_softmax_params *params = csinn_alloc_params(sizeof(*params), sess);
+    params->base.name = "softmax";
+    params->axis = s->axis;
+    ctx.params = params;
+
+    /* max, sub, exp, sum and scale per element */
+    bc.flops = 5.0 * csinn_tensor_size(ctx.input);
+    bc.bytes = csinn_tensor_byte_size(ctx.input) + csinn_tensor_byte_size(ctx.output);
+    bc.run = softmax_run;
+    bc.ctx = &ctx;
+
+    if (csinn_softmax_init(ctx.input, ctx.output, params) != CSINN_TRUE ||
+        params->base.cb->exec == NULL) {
+        bench_skip(bc.op, bc.algo, bc.shape, dtype, "unsupported");
+    } else {
+        bench_run(&bc);
+    }
+
+    bench_free_tensor(ctx.input);
+    bench_free_tensor(ctx.output);
+    csinn_free_params(params);
+    csinn_free_session(sess);
+}
+
+void bench_softmax(void)
+{
+    for (int d = 0; d < BENCH_DTYPE_NUM; d++) {
+        if (!bench_dtype_enabled(bench_dtypes[d])) {
+            continue;
+        }
+        for (int i = 0; i < sizeof(softmax_shapes) / sizeof(softmax_shapes[0]); i++) {
+            softmax_case(&softmax_shapes[i], bench_dtypes[d]);
+        }
+    }
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "csi_nn.h"
+#include "math_snr.h"
+#include "shl_thead_rvv.h"
+#include "test_utils.h"
+
+extern int failures;
+
+struct act_case {
+    const char *name;
+    int (*rvv_fp32)();
+    int (*rvv_fp16)();
+    int (*rvv_init_int8)();
+    int (*ref_f32)();
+    int (*ref_quant)();
+    /* input range, wide enough to reach the saturated tails */
+    float lo;
+    float hi;
+};
+
+static struct act_case act_cases[] = {
+    {"tanh", shl_rvv_tanh_fp32, shl_rvv_tanh_fp16, shl_rvv_tanh_init_int8, shl_ref_tanh_f32,
+     shl_ref_tanh_quant, -10.0f, 10.0f},
+    {"erf", shl_rvv_erf_fp32, shl_rvv_erf_fp16, shl_rvv_erf_init_int8, shl_ref_erf_f32,
+     shl_ref_erf_quant, -6.0f, 6.0f},
+    {"exp", shl_rvv_exp_fp32, shl_rvv_exp_fp16, shl_rvv_exp_init_int8, shl_ref_exp_f32,
+     shl_ref_exp_quant, -10.0f, 10.0f},
+    {"elu", shl_rvv_elu_fp32, shl_rvv_elu_fp16, shl_rvv_elu_init_int8, shl_ref_elu_f32,
+     shl_ref_elu_quant, -20.0f, 10.0f},
+    {"softplus", shl_rvv_softplus_fp32, shl_rvv_softplus_fp16, shl_rvv_softplus_init_int8,
+     shl_ref_softplus_f32, shl_ref_softplus_quant, -30.0f, 30.0f},
+    {"gelu", shl_rvv_gelu_fp32, shl_rvv_gelu_fp16, shl_rvv_gelu_init_int8, shl_ref_gelu_f32,
+     shl_ref_gelu_quant, -12.0f, 12.0f},
+    {"silu", shl_rvv_silu_fp32, shl_rvv_silu_fp16, shl_rvv_silu_init_int8, shl_ref_silu_f32,
+     shl_ref_silu_quant, -30.0f, 30.0f},
+    {"mish", shl_rvv_mish_fp32, shl_rvv_mish_fp16, shl_rvv_mish_init_int8, shl_ref_mish_f32,
+     shl_ref_mish_quant, -30.0f, 30.0f},
+    {"sigmoid", shl_rvv_sigmoid_fp32, shl_rvv_sigmoid_fp16, shl_rvv_sigmoid_init_int8,
+     shl_ref_sigmoid_f32, shl_ref_sigmoid_quant, -30.0f, 30.0f},
+};
+
+/*
+ * The rvv activation of one dtype against the reference. fp32 and fp16 call the vector
+ * kernel directly, int8 goes through the init, which builds the 256-entry lookup table.
+ */
+void verify_activation(struct act_case *act, int in_c, int in_h, int in_w,
+                       enum csinn_dtype_enum dtype)
+{
+    int elem = dtype == CSINN_DTYPE_FLOAT32 ? 4 : dtype == CSINN_DTYPE_FLOAT16 ? 2 : 1;
+    printf("%s: in %dx%dx%d dtype %d\n", act->name, in_c, in_h, in_w, dtype);
+
+    struct csinn_tensor *input =
+        rand_tensor_f32("input", 1, in_c, in_h, in_w, 4, CSINN_LAYOUT_NCHW);
+    struct csinn_tensor *output =
+        rand_tensor_f32("output", 1, in_c, in_h, in_w, 4, CSINN_LAYOUT_NCHW);
+    int size = csinn_tensor_size(input);
+    fill_rand_f32(input->data, size, act->lo, act->hi);
+
+    /* csinn_relu_params of elu is the largest of the activation params */
+    struct csinn_relu_params *params = csinn_alloc_params(sizeof(struct csinn_relu_params), NULL);
+    params->base.name = "params";
+    act->ref_f32(input, output, params);
+
+    struct csinn_tensor *qinput, *qoutput;
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        qinput = input;
+        qoutput = output;
+    } else if (dtype == CSINN_DTYPE_FLOAT16) {
+        qinput = convert_f32_layer(input, CSINN_QUANT_FLOAT16, CSINN_RVV);
+        qoutput = convert_f32_layer(output, CSINN_QUANT_FLOAT16, CSINN_RVV);
+    } else {
+        qinput = convert_f32_layer(input, CSINN_QUANT_INT8_ASYM, CSINN_RVV);
+        qoutput = convert_f32_layer(output, CSINN_QUANT_INT8_ASYM, CSINN_RVV);
+    }
+
+    char *ref = (char *)shl_mem_alloc(size * elem);
+    char *out = (char *)shl_mem_alloc(size * elem);
+    void *qoutput_data = qoutput->data;
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        memcpy(ref, output->data, size * elem);
+    } else {
+        qoutput->data = ref;
+        act->ref_quant(qinput, qoutput, params);
+    }
+
+    qoutput->data = out;
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        act->rvv_fp32(qinput, qoutput, params);
+    } else if (dtype == CSINN_DTYPE_FLOAT16) {
+        act->rvv_fp16(qinput, qoutput, params);
+    } else {
+        act->rvv_init_int8(qinput, qoutput, params);
+        if (params->base.cb->exec != shl_rvv_siso_lut_int8) {
+            printf("%s: the init did not pick the lookup table kernel\n", act->name);
+            failures++;
+        }
+        params->base.cb->exec(qinput, qoutput, params);
+    }
+    evaluate_error(out, ref, size, dtype);
+
+    qoutput->data = qoutput_data;
+    shl_mem_free(ref);
+    shl_mem_free(out);
+    shl_mem_free(params->base.cb);
+    csinn_free_params(params);
+    struct csinn_tensor *tensors[] = {input, output, qinput, qoutput};
+    for (int i = 0; i < (dtype == CSINN_DTYPE_FLOAT32 ? 2 : 4); i++) {
+        shl_mem_free(tensors[i]->data);
+        csinn_free_tensor(tensors[i]);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    init_testsuite("Test function of activations for RVV.\n");
+    srand(0);
+
+    enum csinn_dtype_enum dtypes[] = {CSINN_DTYPE_FLOAT32, CSINN_DTYPE_FLOAT16, CSINN_DTYPE_INT8};
+    for (int i = 0; i < sizeof(act_cases) / sizeof(act_cases[0]); i++) {
+        for (int j = 0; j < 3; j++) {
+            // a size that is not a multiple of any vector length leaves a tail
+            verify_activation(&act_cases[i], 3, 17, 19, dtypes[j]);
+        }
+    }
+
+    return done_testing();
+}
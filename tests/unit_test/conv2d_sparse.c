@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "csi_nn.h"
+#include "math_snr.h"
+#include "shl_thead_rvv.h"
+#include "test_utils.h"
+
+extern int failures;
+
+static struct csinn_tensor *sparse_convert(struct csinn_tensor *t, enum csinn_dtype_enum dtype,
+                                           enum csinn_quant_enum qtype)
+{
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        struct csinn_tensor *ret = csinn_alloc_tensor(NULL);
+        csinn_tensor_copy(ret, t);
+        ret->data = shl_mem_alloc(csinn_tensor_byte_size(t));
+        memcpy(ret->data, t->data, csinn_tensor_byte_size(t));
+        return ret;
+    }
+    return convert_f32_layer(t, dtype == CSINN_DTYPE_FLOAT16 ? CSINN_QUANT_FLOAT16 : qtype,
+                             CSINN_RVV);
+}
+
+/*
+ * The dense reference, the reference over the compressed kernel and the kernel picked by
+ * shl_rvv_conv2d_init must all agree. fp16 and int8 read and write the packn layout when
+ * the channels allow it, fp32 runs the reference over NCHW. Without bias the int8 kernel
+ * builds the zero point bias itself.
+ */
+void verify_conv2d_sparse(int in_c, int in_h, int in_w, int out_c, int ksize, int stride,
+                          int pad, int group, bool with_bias, enum csinn_mem_type_enum mtype,
+                          enum csinn_dtype_enum dtype)
+{
+    int out_h = (in_h + 2 * pad - ksize) / stride + 1;
+    int out_w = (in_w + 2 * pad - ksize) / stride + 1;
+    int packn = dtype == CSINN_DTYPE_FLOAT32 ? 1 : csrr_vlenb() / 2;
+    int in_pack = in_c % packn == 0 ? packn : 1;
+    int out_pack = out_c % packn == 0 ? packn : 1;
+    printf("conv2d sparse: c %d in %dx%d out_c %d kernel %d stride %d pad %d group %d bias %d "
+           "keep %d dtype %d\n",
+           in_c, in_h, in_w, out_c, ksize, stride, pad, group, with_bias, shl_sparse_keep(mtype),
+           dtype);
+
+    struct csinn_tensor *input =
+        rand_tensor_f32("input", 1, in_c, in_h, in_w, 4, CSINN_LAYOUT_NCHW);
+    struct csinn_tensor *kernel =
+        rand_tensor_f32("kernel", out_c, in_c / group, ksize, ksize, 4, CSINN_LAYOUT_OIHW);
+    struct csinn_tensor *bias = with_bias
+                                    ? rand_tensor_f32("bias", out_c, 0, 0, 0, 1, CSINN_LAYOUT_O)
+                                    : csinn_alloc_tensor(NULL);
+    struct csinn_tensor *output =
+        rand_tensor_f32("output", 1, out_c, out_h, out_w, 4, CSINN_LAYOUT_NCHW);
+    int in_size = csinn_tensor_size(input);
+    int out_size = csinn_tensor_size(output);
+    // a non-negative input puts the int8 zero point at -128, folded into the bias and padded
+    fill_rand_f32(input->data, in_size, 0.0f, 2.0f);
+    prune_sparse_f32(kernel->data, out_c, in_c / group * ksize * ksize, shl_sparse_keep(mtype));
+
+    struct csinn_conv2d_params *params =
+        csinn_alloc_params(sizeof(struct csinn_conv2d_params), NULL);
+    params->base.name = "params";
+    params->base.layout = CSINN_LAYOUT_NCHW;
+    params->base.api = CSINN_RVV;
+    params->stride_height = stride;
+    params->stride_width = stride;
+    params->pad_top = pad;
+    params->pad_left = pad;
+    params->pad_down = pad;
+    params->pad_right = pad;
+    params->dilation_height = 1;
+    params->dilation_width = 1;
+    params->group = group;
+    if (group == 1) {
+        shl_ref_conv2d_f32(input, output, kernel, bias, params);
+    } else {
+        shl_ref_group_conv2d_f32(input, output, kernel, bias, params);
+    }
+
+    struct csinn_tensor *qinput = sparse_convert(input, dtype, CSINN_QUANT_INT8_ASYM);
+    struct csinn_tensor *qoutput = sparse_convert(output, dtype, CSINN_QUANT_INT8_ASYM);
+    struct csinn_tensor *dense_kernel = sparse_convert(kernel, dtype, CSINN_QUANT_INT8_SYM);
+    struct csinn_tensor *sparse_kernel = sparse_convert(kernel, dtype, CSINN_QUANT_INT8_SYM);
+    struct csinn_tensor *qbias;
+    if (!with_bias) {
+        qbias = csinn_alloc_tensor(NULL);
+    } else if (dtype == CSINN_DTYPE_INT8) {
+        // int32 bias with the scale of input * kernel
+        qbias = rand_tensor_f32("bias", out_c, 0, 0, 0, 1, CSINN_LAYOUT_O);
+        qbias->dtype = CSINN_DTYPE_INT32;
+        qbias->qinfo->scale = qinput->qinfo->scale * dense_kernel->qinfo->scale;
+        for (int i = 0; i < out_c; i++) {
+            ((int32_t *)qbias->data)[i] =
+                (int32_t)roundf(((float *)bias->data)[i] / qbias->qinfo->scale);
+        }
+    } else {
+        qbias = sparse_convert(bias, dtype, CSINN_QUANT_FLOAT32);
+    }
+    if (shl_sparse_compress(sparse_kernel, mtype) != CSINN_TRUE) {
+        failures++;
+    }
+
+    int elem = csinn_tensor_byte_size(qoutput) / out_size;
+    void *dense_ref = shl_mem_alloc(out_size * elem);
+    void *sparse_ref = shl_mem_alloc(out_size * elem);
+    void *input_packn = shl_mem_alloc(in_size * elem);
+    void *output_packn = shl_mem_alloc(out_size * elem);
+    void *rvv_out = shl_mem_alloc(out_size * elem);
+    void *qinput_data = qinput->data;
+    void *qoutput_data = qoutput->data;
+
+    qoutput->data = dense_ref;
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        memcpy(dense_ref, output->data, out_size * elem);
+    } else if (group == 1) {
+        shl_ref_conv2d_quant(qinput, qoutput, dense_kernel, qbias, params);
+    } else {
+        shl_ref_group_conv2d_quant(qinput, qoutput, dense_kernel, qbias, params);
+    }
+
+    // the sparse reference takes the groups of the compressed kernel itself
+    qoutput->data = sparse_ref;
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        shl_ref_conv2d_f32(qinput, qoutput, sparse_kernel, qbias, params);
+    } else {
+        shl_ref_conv2d_quant(qinput, qoutput, sparse_kernel, qbias, params);
+    }
+    evaluate_error(sparse_ref, dense_ref, out_size, dtype);
+
+    nchw_to_packn(qinput_data, input_packn, in_c, in_h * in_w, in_pack, elem);
+    qinput->data = input_packn;
+    qoutput->data = output_packn;
+    int (*expect)();
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        shl_rvv_conv2d_init_fp32(qinput, qoutput, sparse_kernel, qbias, params);
+        expect = shl_ref_conv2d_f32;
+    } else if (dtype == CSINN_DTYPE_FLOAT16) {
+        shl_rvv_conv2d_init_fp16(qinput, qoutput, sparse_kernel, qbias, params);
+        expect = shl_rvv_conv2d_sparse_fp16;
+    } else {
+        shl_rvv_conv2d_init_int8(qinput, qoutput, sparse_kernel, qbias, params);
+        expect = shl_rvv_conv2d_sparse_int8;
+    }
+    if (params->base.cb->exec != expect) {
+        printf("conv2d sparse: the init did not pick the sparse kernel\n");
+        failures++;
+    }
+    params->base.cb->exec(qinput, qoutput, sparse_kernel, qbias, params);
+    packn_to_nchw(output_packn, rvv_out, out_c, out_h * out_w, out_pack, elem);
+    evaluate_error(rvv_out, dense_ref, out_size, dtype);
+
+    qinput->data = qinput_data;
+    qoutput->data = qoutput_data;
+    shl_mem_free(dense_ref);
+    shl_mem_free(sparse_ref);
+    shl_mem_free(input_packn);
+    shl_mem_free(output_packn);
+    shl_mem_free(rvv_out);
+    shl_mem_free(params->base.cb);
+    shl_mem_free(params);
+    struct csinn_tensor *tensors[] = {input,  kernel, bias,         output,       qinput,
+                                      qoutput, qbias, dense_kernel, sparse_kernel};
+    for (int i = 0; i < 9; i++) {
+        shl_mem_free(tensors[i]->data);
+        csinn_free_tensor(tensors[i]);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    init_testsuite("Test function of sparse convolution for RVV.\n");
+    srand(0);
+
+    enum csinn_dtype_enum dtypes[] = {CSINN_DTYPE_FLOAT32, CSINN_DTYPE_FLOAT16, CSINN_DTYPE_INT8};
+    for (int i = 0; i < 3; i++) {
+        int packn = csrr_vlenb() / 2;
+        // im2col over the packn layout, 3x3 rows of 9 * c leave a partial group of 4
+        verify_conv2d_sparse(packn, 9, 8, packn, 3, 1, 1, 1, true, CSINN_MEM_TYPE_ASP42,
+                             dtypes[i]);
+        verify_conv2d_sparse(2 * packn, 11, 10, packn, 3, 2, 1, 1, true, CSINN_MEM_TYPE_ASP41,
+                             dtypes[i]);
+        // plain NCHW, the 1x1 s1 reads the input directly
+        verify_conv2d_sparse(7, 6, 5, 9, 1, 1, 0, 1, true, CSINN_MEM_TYPE_ASP42, dtypes[i]);
+        verify_conv2d_sparse(5, 7, 7, 3, 3, 1, 1, 1, true, CSINN_MEM_TYPE_ASP41, dtypes[i]);
+        // two groups, and no bias
+        verify_conv2d_sparse(2 * packn, 8, 6, 2 * packn, 3, 1, 1, 2, true, CSINN_MEM_TYPE_ASP42,
+                             dtypes[i]);
+        verify_conv2d_sparse(packn, 7, 6, 9, 3, 1, 0, 1, false, CSINN_MEM_TYPE_ASP42, dtypes[i]);
+        verify_conv2d_sparse(6, 6, 5, 4, 1, 1, 0, 1, false, CSINN_MEM_TYPE_ASP41, dtypes[i]);
+    }
+
+    return done_testing();
+}
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "csi_nn.h"
+#include "math_snr.h"
+#include "shl_thead_rvv.h"
+#include "test_utils.h"
+
+/*
+ * The winograd kernel against the int8 reference conv on NCHW data, wg_scale is the factor
+ * the transformed kernel leaves in the int32 sums. packn_io: the kernel reads and writes
+ * [c / packn, h, w, packn], b4f3s1 reads and writes NCHW.
+ */
+void verify_conv2d_winograd_int8(void (*trans)(), int (*compute)(), int in_c, int in_h, int in_w,
+                                 int out_c, int stride, float wg_scale, bool packn_io)
+{
+    const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
+    int out_h = (in_h + 2 - 3) / stride + 1;
+    int out_w = (in_w + 2 - 3) / stride + 1;
+    printf("conv2d winograd int8: in %dx%dx%d out %dx%dx%d stride %d\n", in_c, in_h, in_w, out_c,
+           out_h, out_w, stride);
+
+    struct csinn_tensor *input =
+        rand_tensor_f32("input", 1, in_c, in_h, in_w, 4, CSINN_LAYOUT_NCHW);
+    struct csinn_tensor *kernel =
+        rand_tensor_f32("kernel", out_c, in_c, 3, 3, 4, CSINN_LAYOUT_OIHW);
+    struct csinn_tensor *bias = rand_tensor_f32("bias", out_c, 0, 0, 0, 1, CSINN_LAYOUT_O);
+    struct csinn_tensor *output =
+        rand_tensor_f32("output", 1, out_c, out_h, out_w, 4, CSINN_LAYOUT_NCHW);
+    int in_size = csinn_tensor_size(input);
+    int out_size = csinn_tensor_size(output);
+
+    struct csinn_conv2d_params *params =
+        csinn_alloc_params(sizeof(struct csinn_conv2d_params), NULL);
+    params->base.name = "params";
+    params->base.layout = CSINN_LAYOUT_NCHW;
+    params->stride_height = stride;
+    params->stride_width = stride;
+    params->pad_left = 1;
+    params->pad_right = 1;
+    params->pad_top = 1;
+    params->pad_down = 1;
+    params->dilation_height = 1;
+    params->dilation_width = 1;
+    params->group = 1;
+    shl_ref_conv2d_f32(input, output, kernel, bias, params);
+
+    struct csinn_tensor *qinput = convert_f32_layer(input, CSINN_QUANT_INT8_ASYM, CSINN_RVV);
+    struct csinn_tensor *qkernel = convert_f32_layer(kernel, CSINN_QUANT_INT8_SYM, CSINN_RVV);
+    struct csinn_tensor *qoutput = convert_f32_layer(output, CSINN_QUANT_INT8_ASYM, CSINN_RVV);
+    struct csinn_tensor *qbias = rand_tensor_f32("bias", out_c, 0, 0, 0, 1, CSINN_LAYOUT_O);
+    qbias->dtype = CSINN_DTYPE_INT32;
+    qbias->qinfo->scale = qinput->qinfo->scale * qkernel->qinfo->scale;
+    for (int i = 0; i < out_c; i++) {
+        ((int32_t *)qbias->data)[i] =
+            (int32_t)roundf(((float *)bias->data)[i] / qbias->qinfo->scale);
+    }
+
+    int8_t *ref = (int8_t *)shl_mem_alloc(out_size);
+    void *qoutput_data = qoutput->data;
+    qoutput->data = ref;
+    shl_ref_conv2d_quant(qinput, qoutput, qkernel, qbias, params);
+
+    int8_t *input_packn = (int8_t *)shl_mem_alloc(in_size);
+    int8_t *output_packn = (int8_t *)shl_mem_alloc(out_size);
+    int8_t *out = (int8_t *)shl_mem_alloc(out_size);
+    void *qinput_data = qinput->data;
+    if (packn_io) {
+        nchw_to_packn(qinput->data, input_packn, in_c, in_h * in_w, packn, 1);
+        qinput->data = input_packn;
+        qoutput->data = output_packn;
+    } else {
+        qoutput->data = out;
+    }
+
+    float real_scale = qinput->qinfo->scale * qkernel->qinfo->scale / qoutput->qinfo->scale;
+    shl_quantize_multiplier(real_scale / wg_scale, &qkernel->qinfo->multiplier,
+                            &qkernel->qinfo->shift);
+    params->conv_extra.kernel_tm = csinn_alloc_tensor(NULL);
+    trans(qkernel, params->conv_extra.kernel_tm);
+    compute(qinput, qoutput, qkernel, qbias, params);
+    if (packn_io) {
+        packn_to_nchw(output_packn, out, out_c, out_h * out_w, packn, 1);
+    }
+    evaluate_error(out, ref, out_size, CSINN_DTYPE_INT8);
+
+    qinput->data = qinput_data;
+    qoutput->data = qoutput_data;
+    shl_mem_free(params->conv_extra.kernel_tm->data);
+    csinn_free_tensor(params->conv_extra.kernel_tm);
+    shl_mem_free(params->base.cb);
+    shl_mem_free(params);
+    shl_mem_free(ref);
+    shl_mem_free(input_packn);
+    shl_mem_free(output_packn);
+    shl_mem_free(out);
+    struct csinn_tensor *tensors[] = {input, kernel, bias, output, qinput, qkernel, qoutput, qbias};
+    for (int i = 0; i < 8; i++) {
+        shl_mem_free(tensors[i]->data);
+        csinn_free_tensor(tensors[i]);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    init_testsuite("Test function of int8 convolution winograd for RVV.\n");
+    srand(0);
+    const int packn = csrr_vlenb() / sizeof(int8_t) / 2;
+
+    // F(4x4, 3x3), the output scaled by 576
+    verify_conv2d_winograd_int8(shl_rvv_wg_b4f3s1_trans_kernel_packn_int8,
+                                shl_rvv_wg_b4f3s1_packn_int8, packn, 14, 14, packn, 1, 576.0f,
+                                false);
+    verify_conv2d_winograd_int8(shl_rvv_wg_b4f3s1_trans_kernel_packn_int8,
+                                shl_rvv_wg_b4f3s1_packn_int8, 2 * packn, 13, 11, packn, 1, 576.0f,
+                                false);
+    // F(2x2, 3x3), odd sizes leave partial tiles
+    verify_conv2d_winograd_int8(shl_rvv_wg_b2f3s1_trans_kernel_packn_int8,
+                                shl_rvv_wg_b2f3s1_packn_int8, packn, 14, 14, 2 * packn, 1, 4.0f,
+                                true);
+    verify_conv2d_winograd_int8(shl_rvv_wg_b2f3s1_trans_kernel_packn_int8,
+                                shl_rvv_wg_b2f3s1_packn_int8, 2 * packn, 13, 11, packn, 1, 4.0f,
+                                true);
+    // stride 2 through the four polyphase components and F(3x3, 2x2)
+    verify_conv2d_winograd_int8(shl_rvv_wg_b3f3s2_trans_kernel_packn_int8,
+                                shl_rvv_wg_b3f3s2_packn_int8, packn, 16, 16, packn, 2, 4.0f, true);
+    verify_conv2d_winograd_int8(shl_rvv_wg_b3f3s2_trans_kernel_packn_int8,
+                                shl_rvv_wg_b3f3s2_packn_int8, 2 * packn, 17, 13, 2 * packn, 2,
+                                4.0f, true);
+
+    return done_testing();
+}
@@ -0,0 +1,204 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "csi_nn.h"
+#include "math_snr.h"
+#include "shl_thead_rvv.h"
+#include "test_utils.h"
+
+extern int failures;
+
+enum deconv_kernel { DECONV_GEMM_COL2IM, DECONV_S2, DECONV_DEPTHWISE };
+
+static int (*deconv_exec[3][3])() = {
+    {shl_rvv_deconv2d_gemm_col2im_fp32, shl_rvv_deconv2d_s2_fp32,
+     shl_rvv_depthwise_deconv2d_packn_fp32},
+    {shl_rvv_deconv2d_gemm_col2im_fp16, shl_rvv_deconv2d_s2_fp16,
+     shl_rvv_depthwise_deconv2d_packn_fp16},
+    {shl_rvv_deconv2d_gemm_col2im_int8, shl_rvv_deconv2d_s2_int8,
+     shl_rvv_depthwise_deconv2d_packn_int8},
+};
+
+/*
+ * The kernel picked by the rvv init against the reference deconv on NCHW data. The rvv
+ * kernels keep the channels of a tensor packed by packn when the channel count allows it.
+ */
+void verify_deconv2d(int in_c, int out_c, int in_h, int in_w, int ksize, int stride,
+                     int dilation, int pad, bool depthwise, enum csinn_dtype_enum dtype)
+{
+    int elem = dtype == CSINN_DTYPE_FLOAT32 ? 4 : dtype == CSINN_DTYPE_FLOAT16 ? 2 : 1;
+    int packn = dtype == CSINN_DTYPE_FLOAT32 ? csrr_vlenb() / 4 : csrr_vlenb() / 2;
+    int dtype_idx = dtype == CSINN_DTYPE_FLOAT32 ? 0 : dtype == CSINN_DTYPE_FLOAT16 ? 1 : 2;
+    int out_h = (in_h - 1) * stride - 2 * pad + dilation * (ksize - 1) + 1;
+    int out_w = (in_w - 1) * stride - 2 * pad + dilation * (ksize - 1) + 1;
+    printf("deconv2d%s: in %dx%dx%d out %dx%dx%d kernel %d stride %d dilation %d dtype %d\n",
+           depthwise ? " depthwise" : "", in_c, in_h, in_w, out_c, out_h, out_w, ksize, stride,
+           dilation, dtype);
+
+    struct csinn_tensor *input =
+        rand_tensor_f32("input", 1, in_c, in_h, in_w, 4, CSINN_LAYOUT_NCHW);
+    // [in_c, out_c, h, w], depthwise [c, 1, h, w]
+    struct csinn_tensor *kernel =
+        depthwise ? rand_tensor_f32("kernel", in_c, 1, ksize, ksize, 4, CSINN_LAYOUT_O1HW)
+                  : rand_tensor_f32("kernel", in_c, out_c, ksize, ksize, 4, CSINN_LAYOUT_OIHW);
+    struct csinn_tensor *bias = rand_tensor_f32("bias", out_c, 0, 0, 0, 1, CSINN_LAYOUT_O);
+    struct csinn_tensor *output =
+        rand_tensor_f32("output", 1, out_c, out_h, out_w, 4, CSINN_LAYOUT_NCHW);
+    int in_size = csinn_tensor_size(input);
+    int out_size = csinn_tensor_size(output);
+
+    struct csinn_conv2d_params *params =
+        csinn_alloc_params(sizeof(struct csinn_conv2d_params), NULL);
+    params->base.name = "params";
+    params->base.layout = CSINN_LAYOUT_NCHW;
+    params->stride_height = stride;
+    params->stride_width = stride;
+    params->dilation_height = dilation;
+    params->dilation_width = dilation;
+    params->pad_top = pad;
+    params->pad_left = pad;
+    params->pad_down = pad;
+    params->pad_right = pad;
+    params->group = depthwise ? in_c : 1;
+    if (depthwise) {
+        shl_ref_depthwise_deconv2d_f32(input, output, kernel, bias, params);
+    } else {
+        shl_ref_deconv2d_f32(input, output, kernel, bias, params);
+    }
+
+    struct csinn_tensor *qinput, *qkernel, *qbias, *qoutput;
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        qinput = input;
+        qkernel = kernel;
+        qbias = bias;
+        qoutput = output;
+    } else if (dtype == CSINN_DTYPE_FLOAT16) {
+        qinput = convert_f32_layer(input, CSINN_QUANT_FLOAT16, CSINN_RVV);
+        qkernel = convert_f32_layer(kernel, CSINN_QUANT_FLOAT16, CSINN_RVV);
+        qbias = convert_f32_layer(bias, CSINN_QUANT_FLOAT16, CSINN_RVV);
+        qoutput = convert_f32_layer(output, CSINN_QUANT_FLOAT16, CSINN_RVV);
+    } else {
+        qinput = convert_f32_layer(input, CSINN_QUANT_INT8_ASYM, CSINN_RVV);
+        qkernel = convert_f32_layer(kernel, CSINN_QUANT_INT8_SYM, CSINN_RVV);
+        qoutput = convert_f32_layer(output, CSINN_QUANT_INT8_ASYM, CSINN_RVV);
+        // int32 bias with the scale of input * kernel
+        qbias = rand_tensor_f32("bias", out_c, 0, 0, 0, 1, CSINN_LAYOUT_O);
+        qbias->dtype = CSINN_DTYPE_INT32;
+        qbias->qinfo->scale = qinput->qinfo->scale * qkernel->qinfo->scale;
+        for (int i = 0; i < out_c; i++) {
+            ((int32_t *)qbias->data)[i] =
+                (int32_t)roundf(((float *)bias->data)[i] / qbias->qinfo->scale);
+        }
+    }
+
+    // reference on NCHW before the init reorders the kernel
+    char *ref = (char *)shl_mem_alloc(out_size * elem);
+    void *qoutput_data = qoutput->data;
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        memcpy(ref, output->data, out_size * elem);
+    } else {
+        qoutput->data = ref;
+        if (depthwise) {
+            shl_ref_depthwise_deconv2d_quant(qinput, qoutput, qkernel, qbias, params);
+        } else {
+            shl_ref_deconv2d_quant(qinput, qoutput, qkernel, qbias, params);
+        }
+    }
+
+    int in_pack = in_c % packn == 0 ? packn : 1;
+    int out_pack = out_c % packn == 0 ? packn : 1;
+    char *input_packn = (char *)shl_mem_alloc(in_size * elem);
+    char *output_packn = (char *)shl_mem_alloc(out_size * elem);
+    char *out = (char *)shl_mem_alloc(out_size * elem);
+    nchw_to_packn(qinput->data, input_packn, in_c, in_h * in_w, in_pack, elem);
+    void *qinput_data = qinput->data;
+    qinput->data = input_packn;
+    qoutput->data = output_packn;
+
+    enum deconv_kernel expect = DECONV_GEMM_COL2IM;
+    if (depthwise) {
+        expect = DECONV_DEPTHWISE;
+    } else if (stride == 2 && dilation == 1) {
+        expect = DECONV_S2;
+    }
+    if (depthwise && dtype == CSINN_DTYPE_FLOAT32) {
+        shl_rvv_depthwise_deconv2d_init_fp32(qinput, qoutput, qkernel, qbias, params);
+    } else if (depthwise && dtype == CSINN_DTYPE_FLOAT16) {
+        shl_rvv_depthwise_deconv2d_init_fp16(qinput, qoutput, qkernel, qbias, params);
+    } else if (depthwise) {
+        shl_rvv_depthwise_deconv2d_init_int8(qinput, qoutput, qkernel, qbias, params);
+    } else if (dtype == CSINN_DTYPE_FLOAT32) {
+        shl_rvv_deconv2d_init_fp32(qinput, qoutput, qkernel, qbias, params);
+    } else if (dtype == CSINN_DTYPE_FLOAT16) {
+        shl_rvv_deconv2d_init_fp16(qinput, qoutput, qkernel, qbias, params);
+    } else {
+        shl_rvv_deconv2d_init_int8(qinput, qoutput, qkernel, qbias, params);
+    }
+    if (params->base.cb->exec != deconv_exec[dtype_idx][expect]) {
+        printf("deconv2d: the init did not pick the expected rvv kernel\n");
+        failures++;
+    }
+    params->base.cb->exec(qinput, qoutput, qkernel, qbias, params);
+    packn_to_nchw(output_packn, out, out_c, out_h * out_w, out_pack, elem);
+    evaluate_error(out, ref, out_size, dtype);
+
+    qinput->data = qinput_data;
+    qoutput->data = qoutput_data;
+    if (params->conv_extra.kernel_tm) {
+        shl_mem_free(params->conv_extra.kernel_tm->data);
+        csinn_free_tensor(params->conv_extra.kernel_tm);
+    }
+    shl_mem_free(ref);
+    shl_mem_free(input_packn);
+    shl_mem_free(output_packn);
+    shl_mem_free(out);
+    shl_mem_free(params->base.cb);
+    shl_mem_free(params);
+    struct csinn_tensor *tensors[] = {input, kernel, bias, output, qinput, qkernel, qbias, qoutput};
+    for (int i = 0; i < (dtype == CSINN_DTYPE_FLOAT32 ? 4 : 8); i++) {
+        shl_mem_free(tensors[i]->data);
+        csinn_free_tensor(tensors[i]);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    init_testsuite("Test function of deconvolution for RVV.\n");
+    srand(0);
+
+    enum csinn_dtype_enum dtypes[] = {CSINN_DTYPE_FLOAT32, CSINN_DTYPE_FLOAT16, CSINN_DTYPE_INT8};
+    for (int i = 0; i < 3; i++) {
+        int packn = dtypes[i] == CSINN_DTYPE_FLOAT32 ? csrr_vlenb() / 4 : csrr_vlenb() / 2;
+        // gemm + col2im, packed and plain channels, stride 3 and dilation 2
+        verify_deconv2d(packn, 2 * packn, 7, 6, 3, 1, 1, 1, false, dtypes[i]);
+        verify_deconv2d(5, 3, 6, 7, 3, 3, 1, 0, false, dtypes[i]);
+        verify_deconv2d(2 * packn, 7, 5, 5, 3, 1, 2, 2, false, dtypes[i]);
+        // stride 2 phases, even and odd kernels
+        verify_deconv2d(packn, packn, 8, 7, 4, 2, 1, 1, false, dtypes[i]);
+        verify_deconv2d(3, 2 * packn, 6, 9, 3, 2, 1, 1, false, dtypes[i]);
+        verify_deconv2d(2 * packn, 5, 5, 6, 5, 2, 1, 2, false, dtypes[i]);
+        // depthwise on packn channels
+        verify_deconv2d(packn, packn, 8, 7, 4, 2, 1, 1, true, dtypes[i]);
+        verify_deconv2d(2 * packn, 2 * packn, 6, 5, 3, 1, 2, 1, true, dtypes[i]);
+        verify_deconv2d(packn, packn, 5, 6, 3, 3, 1, 0, true, dtypes[i]);
+    }
+
+    return done_testing();
+}
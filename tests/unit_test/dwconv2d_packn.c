@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "csi_nn.h"
+#include "math_snr.h"
+#include "shl_thead_rvv.h"
+#include "test_utils.h"
+
+extern int failures;
+
+/*
+ * A packn layer that is not a plain 3x3 s1/s2 must be sent by the init to the general
+ * KxK kernel, which is checked against the reference on NCHW data.
+ */
+void verify_dwconv2d_packn(int in_c, int in_h, int in_w, int kernel_h, int kernel_w, int stride,
+                           int dilation, int pad_top, int pad_left, enum csinn_dtype_enum dtype)
+{
+    int elem = dtype == CSINN_DTYPE_FLOAT32 ? 4 : dtype == CSINN_DTYPE_FLOAT16 ? 2 : 1;
+    int packn = dtype == CSINN_DTYPE_INT8 ? csrr_vlenb() / 2 : csrr_vlenb() / elem;
+    int pad_down = kernel_h / 2;
+    int pad_right = kernel_w / 2;
+    int out_h = (in_h + pad_top + pad_down - dilation * (kernel_h - 1) - 1) / stride + 1;
+    int out_w = (in_w + pad_left + pad_right - dilation * (kernel_w - 1) - 1) / stride + 1;
+    printf("dwconv2d packn: c %d in %dx%d kernel %dx%d stride %d dilation %d dtype %d\n", in_c,
+           in_h, in_w, kernel_h, kernel_w, stride, dilation, dtype);
+
+    struct csinn_tensor *input =
+        rand_tensor_f32("input", 1, in_c, in_h, in_w, 4, CSINN_LAYOUT_NCHW);
+    struct csinn_tensor *kernel =
+        rand_tensor_f32("kernel", in_c, 1, kernel_h, kernel_w, 4, CSINN_LAYOUT_O1HW);
+    struct csinn_tensor *bias = rand_tensor_f32("bias", in_c, 0, 0, 0, 1, CSINN_LAYOUT_O);
+    struct csinn_tensor *output =
+        rand_tensor_f32("output", 1, in_c, out_h, out_w, 4, CSINN_LAYOUT_NCHW);
+    int in_size = csinn_tensor_size(input);
+    int out_size = csinn_tensor_size(output);
+
+    struct csinn_conv2d_params *params =
+        csinn_alloc_params(sizeof(struct csinn_conv2d_params), NULL);
+    params->base.name = "params";
+    params->base.layout = CSINN_LAYOUT_NCHW;
+    params->stride_height = stride;
+    params->stride_width = stride;
+    params->dilation_height = dilation;
+    params->dilation_width = dilation;
+    params->pad_top = pad_top;
+    params->pad_left = pad_left;
+    params->pad_down = pad_down;
+    params->pad_right = pad_right;
+    params->group = in_c;
+    shl_ref_depthwise_conv2d_f32(input, output, kernel, bias, params);
+
+    struct csinn_tensor *qinput, *qkernel, *qbias, *qoutput;
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        qinput = input;
+        qkernel = kernel;
+        qbias = bias;
+        qoutput = output;
+    } else if (dtype == CSINN_DTYPE_FLOAT16) {
+        qinput = convert_f32_layer(input, CSINN_QUANT_FLOAT16, CSINN_RVV);
+        qkernel = convert_f32_layer(kernel, CSINN_QUANT_FLOAT16, CSINN_RVV);
+        qbias = convert_f32_layer(bias, CSINN_QUANT_FLOAT16, CSINN_RVV);
+        qoutput = convert_f32_layer(output, CSINN_QUANT_FLOAT16, CSINN_RVV);
+    } else {
+        qinput = convert_f32_layer(input, CSINN_QUANT_INT8_ASYM, CSINN_RVV);
+        qkernel = convert_f32_layer(kernel, CSINN_QUANT_INT8_SYM, CSINN_RVV);
+        qoutput = convert_f32_layer(output, CSINN_QUANT_INT8_ASYM, CSINN_RVV);
+        // int32 bias with the scale of input * kernel
+        qbias = rand_tensor_f32("bias", in_c, 0, 0, 0, 1, CSINN_LAYOUT_O);
+        qbias->dtype = CSINN_DTYPE_INT32;
+        qbias->qinfo->scale = qinput->qinfo->scale * qkernel->qinfo->scale;
+        for (int i = 0; i < in_c; i++) {
+            ((int32_t *)qbias->data)[i] =
+                (int32_t)roundf(((float *)bias->data)[i] / qbias->qinfo->scale);
+        }
+    }
+
+    // reference on NCHW before the init reorders the kernel and fuses the zero point
+    char *ref = (char *)shl_mem_alloc(out_size * elem);
+    void *qoutput_data = qoutput->data;
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        memcpy(ref, output->data, out_size * elem);
+    } else {
+        qoutput->data = ref;
+        shl_ref_depthwise_conv2d_quant(qinput, qoutput, qkernel, qbias, params);
+    }
+
+    char *input_packn = (char *)shl_mem_alloc(in_size * elem);
+    char *output_packn = (char *)shl_mem_alloc(out_size * elem);
+    char *out = (char *)shl_mem_alloc(out_size * elem);
+    nchw_to_packn(qinput->data, input_packn, in_c, in_h * in_w, packn, elem);
+    void *qinput_data = qinput->data;
+    qinput->data = input_packn;
+    qoutput->data = output_packn;
+
+    int (*expect)();
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        shl_rvv_depthwise_conv2d_init_fp32(qinput, qoutput, qkernel, qbias, params);
+        expect = shl_rvv_dwconv_packn_fp32;
+    } else if (dtype == CSINN_DTYPE_FLOAT16) {
+        shl_rvv_depthwise_conv2d_init_fp16(qinput, qoutput, qkernel, qbias, params);
+        expect = shl_rvv_dwconv_packn_fp16;
+    } else {
+        shl_rvv_depthwise_conv2d_init_int8(qinput, qoutput, qkernel, qbias, params);
+        expect = shl_rvv_dwconv_packn_int8;
+    }
+    if (params->base.cb->exec != expect) {
+        printf("dwconv2d packn: the init did not pick the KxK packn kernel\n");
+        failures++;
+    }
+    params->base.cb->exec(qinput, qoutput, qkernel, qbias, params);
+    packn_to_nchw(output_packn, out, in_c, out_h * out_w, packn, elem);
+    evaluate_error(out, ref, out_size, dtype);
+
+    qinput->data = qinput_data;
+    qoutput->data = qoutput_data;
+    shl_mem_free(ref);
+    shl_mem_free(input_packn);
+    shl_mem_free(output_packn);
+    shl_mem_free(out);
+    shl_mem_free(params->base.cb);
+    shl_mem_free(params);
+    struct csinn_tensor *tensors[] = {input, kernel, bias, output, qinput, qkernel, qbias, qoutput};
+    for (int i = 0; i < (dtype == CSINN_DTYPE_FLOAT32 ? 4 : 8); i++) {
+        shl_mem_free(tensors[i]->data);
+        csinn_free_tensor(tensors[i]);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    init_testsuite("Test function of KxK depthwise convolution packn for RVV.\n");
+    srand(0);
+
+    enum csinn_dtype_enum dtypes[] = {CSINN_DTYPE_FLOAT32, CSINN_DTYPE_FLOAT16, CSINN_DTYPE_INT8};
+    for (int i = 0; i < 3; i++) {
+        int packn = dtypes[i] == CSINN_DTYPE_FLOAT32 ? csrr_vlenb() / 4 : csrr_vlenb() / 2;
+        // the unrolled widths 5 and 7, then dilation and a generic width
+        verify_dwconv2d_packn(packn, 15, 13, 5, 5, 1, 1, 2, 2, dtypes[i]);
+        verify_dwconv2d_packn(2 * packn, 17, 16, 7, 7, 2, 1, 3, 3, dtypes[i]);
+        verify_dwconv2d_packn(packn, 12, 11, 3, 3, 1, 2, 2, 2, dtypes[i]);
+        verify_dwconv2d_packn(2 * packn, 10, 9, 4, 2, 2, 1, 0, 1, dtypes[i]);
+    }
+
+    return done_testing();
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "csi_nn.h"
+#include "math_snr.h"
+#include "shl_thead_rvv.h"
+#include "test_utils.h"
+
+extern int failures;
+
+static struct csinn_tensor *fc_convert(struct csinn_tensor *t, enum csinn_dtype_enum dtype,
+                                       enum csinn_quant_enum qtype)
+{
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        struct csinn_tensor *ret = csinn_alloc_tensor(NULL);
+        csinn_tensor_copy(ret, t);
+        ret->data = shl_mem_alloc(csinn_tensor_byte_size(t));
+        memcpy(ret->data, t->data, csinn_tensor_byte_size(t));
+        return ret;
+    }
+    return convert_f32_layer(t, dtype == CSINN_DTYPE_FLOAT16 ? CSINN_QUANT_FLOAT16 : qtype,
+                             CSINN_RVV);
+}
+
+/*
+ * The dense reference, the reference over the compressed weights and the rvv kernel picked
+ * by shl_rvv_fullyconnected_init (gemv for small batches, gemm otherwise) must all agree.
+ */
+void verify_fc_sparse(int batch, int in_nodes, int out_nodes, enum csinn_mem_type_enum mtype,
+                      enum csinn_dtype_enum dtype)
+{
+    printf("fc sparse: batch %d in %d out %d keep %d dtype %d\n", batch, in_nodes, out_nodes,
+           shl_sparse_keep(mtype), dtype);
+    struct csinn_tensor *input =
+        rand_tensor_f32("input", batch, in_nodes, 0, 0, 2, CSINN_LAYOUT_NC);
+    struct csinn_tensor *weight =
+        rand_tensor_f32("weight", out_nodes, in_nodes, 0, 0, 2, CSINN_LAYOUT_OI);
+    struct csinn_tensor *bias = rand_tensor_f32("bias", out_nodes, 0, 0, 0, 1, CSINN_LAYOUT_O);
+    struct csinn_tensor *output =
+        rand_tensor_f32("output", batch, out_nodes, 0, 0, 2, CSINN_LAYOUT_NC);
+    int out_size = csinn_tensor_size(output);
+    prune_sparse_f32(weight->data, out_nodes, in_nodes, shl_sparse_keep(mtype));
+
+    struct csinn_fc_params *params = csinn_alloc_params(sizeof(struct csinn_fc_params), NULL);
+    params->base.name = "params";
+    params->base.api = CSINN_RVV;
+    shl_ref_fullyconnected_f32(input, output, weight, bias, params);
+
+    struct csinn_tensor *qinput = fc_convert(input, dtype, CSINN_QUANT_INT8_ASYM);
+    struct csinn_tensor *qoutput = fc_convert(output, dtype, CSINN_QUANT_INT8_ASYM);
+    struct csinn_tensor *dense_weight = fc_convert(weight, dtype, CSINN_QUANT_INT8_SYM);
+    struct csinn_tensor *sparse_weight = fc_convert(weight, dtype, CSINN_QUANT_INT8_SYM);
+    struct csinn_tensor *qbias;
+    if (dtype == CSINN_DTYPE_INT8) {
+        // int32 bias with the scale of input * weight
+        qbias = rand_tensor_f32("bias", out_nodes, 0, 0, 0, 1, CSINN_LAYOUT_O);
+        qbias->dtype = CSINN_DTYPE_INT32;
+        qbias->qinfo->scale = qinput->qinfo->scale * dense_weight->qinfo->scale;
+        for (int i = 0; i < out_nodes; i++) {
+            ((int32_t *)qbias->data)[i] =
+                (int32_t)roundf(((float *)bias->data)[i] / qbias->qinfo->scale);
+        }
+    } else {
+        qbias = fc_convert(bias, dtype, CSINN_QUANT_FLOAT32);
+    }
+    if (shl_sparse_compress(sparse_weight, mtype) != CSINN_TRUE) {
+        failures++;
+    }
+
+    int elem = csinn_tensor_byte_size(qoutput) / out_size;
+    void *dense_ref = shl_mem_alloc(out_size * elem);
+    void *sparse_ref = shl_mem_alloc(out_size * elem);
+    void *rvv_out = shl_mem_alloc(out_size * elem);
+    void *qoutput_data = qoutput->data;
+
+    qoutput->data = dense_ref;
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        memcpy(dense_ref, output->data, out_size * elem);
+    } else {
+        shl_ref_fullyconnected_quant(qinput, qoutput, dense_weight, qbias, params);
+    }
+
+    qoutput->data = sparse_ref;
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        shl_ref_fullyconnected_f32(qinput, qoutput, sparse_weight, qbias, params);
+    } else {
+        shl_ref_fullyconnected_quant(qinput, qoutput, sparse_weight, qbias, params);
+    }
+    evaluate_error(sparse_ref, dense_ref, out_size, dtype);
+
+    qoutput->data = rvv_out;
+    shl_rvv_fullyconnected_init(qinput, qoutput, sparse_weight, qbias, params);
+    params->base.cb->exec(qinput, qoutput, sparse_weight, qbias, params);
+    evaluate_error(rvv_out, dense_ref, out_size, dtype);
+
+    qoutput->data = qoutput_data;
+    shl_mem_free(dense_ref);
+    shl_mem_free(sparse_ref);
+    shl_mem_free(rvv_out);
+    shl_mem_free(params->base.cb);
+    shl_mem_free(params);
+    struct csinn_tensor *tensors[] = {input,  weight, bias,         output,       qinput,
+                                      qoutput, qbias, dense_weight, sparse_weight};
+    for (int i = 0; i < 9; i++) {
+        shl_mem_free(tensors[i]->data);
+        csinn_free_tensor(tensors[i]);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    init_testsuite("Test function of sparse fullyconnected for RVV.\n");
+    srand(0);
+
+    enum csinn_dtype_enum dtypes[] = {CSINN_DTYPE_FLOAT32, CSINN_DTYPE_FLOAT16, CSINN_DTYPE_INT8};
+    for (int i = 0; i < 3; i++) {
+        // gemv: odd output nodes leave a partial block, 37 inputs a partial group
+        verify_fc_sparse(1, 37, 19, CSINN_MEM_TYPE_ASP42, dtypes[i]);
+        verify_fc_sparse(3, 64, 33, CSINN_MEM_TYPE_ASP41, dtypes[i]);
+        // gemm along the batch
+        verify_fc_sparse(32, 37, 19, CSINN_MEM_TYPE_ASP42, dtypes[i]);
+    }
+
+    return done_testing();
+}
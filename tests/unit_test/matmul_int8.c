@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "csi_nn.h"
+#include "math_snr.h"
+#include "shl_thead_rvv.h"
+#include "test_utils.h"
+
+extern int failures;
+
+/*
+ * shl_rvv_matmul_int8 against the int8 reference, A is [batch, m, k] and B [batch, k, n]
+ * before the transpose flags. const_b: a 2-D constant B that the init transposes once.
+ */
+void verify_matmul_int8(int batch, int m, int k, int n, bool trans_a, bool trans_b, bool const_b)
+{
+    printf("matmul int8: batch %d m %d k %d n %d trans_a %d trans_b %d const_b %d\n", batch, m, k,
+           n, trans_a, trans_b, const_b);
+
+    struct csinn_tensor *mat0, *mat1, *output;
+    if (const_b) {
+        // a constant B is 2-D, and so are A and the output of its single batch
+        mat0 = rand_tensor_f32("mat0", trans_a ? k : m, trans_a ? m : k, 0, 0, 2, CSINN_LAYOUT_NC);
+        mat1 = rand_tensor_f32("mat1", trans_b ? n : k, trans_b ? k : n, 0, 0, 2, CSINN_LAYOUT_NC);
+        output = rand_tensor_f32("output", m, n, 0, 0, 2, CSINN_LAYOUT_NC);
+    } else {
+        mat0 = rand_tensor_f32("mat0", batch, trans_a ? k : m, trans_a ? m : k, 0, 3,
+                               CSINN_LAYOUT_NCW);
+        mat1 = rand_tensor_f32("mat1", batch, trans_b ? n : k, trans_b ? k : n, 0, 3,
+                               CSINN_LAYOUT_NCW);
+        output = rand_tensor_f32("output", batch, m, n, 0, 3, CSINN_LAYOUT_NCW);
+    }
+    int out_size = csinn_tensor_size(output);
+
+    struct csinn_matmul_params *params =
+        csinn_alloc_params(sizeof(struct csinn_matmul_params), NULL);
+    params->base.name = "params";
+    params->trans_a = trans_a;
+    params->trans_b = trans_b;
+    shl_ref_matmul_f32(mat0, mat1, output, params);
+
+    struct csinn_tensor *qmat0 = convert_f32_layer(mat0, CSINN_QUANT_INT8_ASYM, CSINN_RVV);
+    struct csinn_tensor *qmat1 = convert_f32_layer(mat1, CSINN_QUANT_INT8_ASYM, CSINN_RVV);
+    struct csinn_tensor *qoutput = convert_f32_layer(output, CSINN_QUANT_INT8_ASYM, CSINN_RVV);
+    qmat1->is_const = const_b;
+
+    // reference before the init transposes a constant B
+    int8_t *ref = (int8_t *)shl_mem_alloc(out_size);
+    int8_t *out = (int8_t *)shl_mem_alloc(out_size);
+    void *qoutput_data = qoutput->data;
+    qoutput->data = ref;
+    shl_ref_matmul_quant(qmat0, qmat1, qoutput, params);
+
+    qoutput->data = out;
+    shl_rvv_matmul_init(qmat0, qmat1, qoutput, params);
+    if (params->base.cb->exec != shl_rvv_matmul_int8) {
+        printf("matmul int8: the init did not pick the rvv kernel\n");
+        failures++;
+    }
+    params->base.cb->exec(qmat0, qmat1, qoutput, params);
+    evaluate_error(out, ref, out_size, CSINN_DTYPE_INT8);
+
+    qoutput->data = qoutput_data;
+    shl_mem_free(ref);
+    shl_mem_free(out);
+    shl_mem_free(params->base.cb);
+    shl_mem_free(params);
+    struct csinn_tensor *tensors[] = {mat0, mat1, output, qmat0, qmat1, qoutput};
+    for (int i = 0; i < 6; i++) {
+        shl_mem_free(tensors[i]->data);
+        csinn_free_tensor(tensors[i]);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    init_testsuite("Test function of int8 matmul for RVV.\n");
+    srand(0);
+
+    // every transpose combination, m leaves a row tail and n a partial vector
+    for (int trans_a = 0; trans_a < 2; trans_a++) {
+        for (int trans_b = 0; trans_b < 2; trans_b++) {
+            verify_matmul_int8(3, 7, 37, 21, trans_a, trans_b, false);
+        }
+    }
+    verify_matmul_int8(2, 16, 64, 48, false, false, false);
+    // a constant 2-D B is transposed once by the init
+    verify_matmul_int8(1, 9, 40, 35, false, true, true);
+
+    return done_testing();
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "csi_nn.h"
+#include "math_snr.h"
+#include "shl_thead_rvv.h"
+#include "test_utils.h"
+
+extern int failures;
+
+/*
+ * A pooling shape without a specialised kernel must be sent by the init to the generic
+ * packn kernel, which is checked against the reference on NCHW data.
+ */
+void verify_pool2d_packn(bool avg, int in_c, int in_h, int in_w, int kernel_h, int kernel_w,
+                         int stride_h, int stride_w, int pad_top, int pad_left, int pad_down,
+                         int pad_right, int ceil_mode, bool count_include_pad,
+                         enum csinn_dtype_enum dtype)
+{
+    int elem = dtype == CSINN_DTYPE_FLOAT32 ? 4 : dtype == CSINN_DTYPE_FLOAT16 ? 2 : 1;
+    int packn = dtype == CSINN_DTYPE_INT8 ? csrr_vlenb() / 2 : csrr_vlenb() / elem;
+    int out_h =
+        (in_h + pad_top + pad_down - kernel_h + (ceil_mode ? stride_h - 1 : 0)) / stride_h + 1;
+    int out_w =
+        (in_w + pad_left + pad_right - kernel_w + (ceil_mode ? stride_w - 1 : 0)) / stride_w + 1;
+    printf("%s packn: c %d in %dx%d kernel %dx%d stride %dx%d pad %d %d %d %d ceil %d dtype %d\n",
+           avg ? "avgpool" : "maxpool", in_c, in_h, in_w, kernel_h, kernel_w, stride_h, stride_w,
+           pad_top, pad_left, pad_down, pad_right, ceil_mode, dtype);
+
+    struct csinn_tensor *input =
+        rand_tensor_f32("input", 1, in_c, in_h, in_w, 4, CSINN_LAYOUT_NCHW);
+    struct csinn_tensor *output =
+        rand_tensor_f32("output", 1, in_c, out_h, out_w, 4, CSINN_LAYOUT_NCHW);
+    int in_size = csinn_tensor_size(input);
+    int out_size = csinn_tensor_size(output);
+
+    struct csinn_pool_params *params = csinn_alloc_params(sizeof(struct csinn_pool_params), NULL);
+    params->base.name = "params";
+    params->base.layout = CSINN_LAYOUT_NCHW;
+    params->filter_height = kernel_h;
+    params->filter_width = kernel_w;
+    params->stride_height = stride_h;
+    params->stride_width = stride_w;
+    params->pad_top = pad_top;
+    params->pad_left = pad_left;
+    params->pad_down = pad_down;
+    params->pad_right = pad_right;
+    params->ceil_mode = ceil_mode;
+    params->count_include_pad = count_include_pad;
+    if (avg) {
+        shl_ref_avgpool2d_f32(input, output, params);
+    } else {
+        shl_ref_maxpool2d_f32(input, output, params);
+    }
+
+    struct csinn_tensor *qinput, *qoutput;
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        qinput = input;
+        qoutput = output;
+    } else if (dtype == CSINN_DTYPE_FLOAT16) {
+        qinput = convert_f32_layer(input, CSINN_QUANT_FLOAT16, CSINN_RVV);
+        qoutput = convert_f32_layer(output, CSINN_QUANT_FLOAT16, CSINN_RVV);
+    } else {
+        qinput = convert_f32_layer(input, CSINN_QUANT_INT8_ASYM, CSINN_RVV);
+        qoutput = convert_f32_layer(output, CSINN_QUANT_INT8_ASYM, CSINN_RVV);
+        if (!avg) {
+            // like the other int8 max kernels, the output keeps the input quantization
+            qoutput->qinfo->scale = qinput->qinfo->scale;
+            qoutput->qinfo->zero_point = qinput->qinfo->zero_point;
+        }
+    }
+
+    char *ref = (char *)shl_mem_alloc(out_size * elem);
+    void *qoutput_data = qoutput->data;
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        memcpy(ref, output->data, out_size * elem);
+    } else {
+        qoutput->data = ref;
+        if (avg) {
+            shl_ref_avgpool2d_quant(qinput, qoutput, params);
+        } else {
+            shl_ref_maxpool2d_quant(qinput, qoutput, params);
+        }
+    }
+
+    char *input_packn = (char *)shl_mem_alloc(in_size * elem);
+    char *output_packn = (char *)shl_mem_alloc(out_size * elem);
+    char *out = (char *)shl_mem_alloc(out_size * elem);
+    nchw_to_packn(qinput->data, input_packn, in_c, in_h * in_w, packn, elem);
+    void *qinput_data = qinput->data;
+    qinput->data = input_packn;
+    qoutput->data = output_packn;
+
+    int (*expect)();
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        if (avg) {
+            shl_rvv_avgpool2d_init_fp32(qinput, qoutput, params);
+            expect = shl_rvv_avgpool2d_packn_fp32;
+        } else {
+            shl_rvv_maxpool2d_init_fp32(qinput, qoutput, params);
+            expect = shl_rvv_maxpool2d_packn_fp32;
+        }
+    } else if (dtype == CSINN_DTYPE_FLOAT16) {
+        if (avg) {
+            shl_rvv_avgpool2d_init_fp16(qinput, qoutput, params);
+            expect = shl_rvv_avgpool2d_packn_fp16;
+        } else {
+            shl_rvv_maxpool2d_init_fp16(qinput, qoutput, params);
+            expect = shl_rvv_maxpool2d_packn_fp16;
+        }
+    } else {
+        if (avg) {
+            shl_rvv_avgpool2d_init_int8(qinput, qoutput, params);
+            expect = shl_rvv_avgpool2d_packn_int8;
+        } else {
+            shl_rvv_maxpool2d_init_int8(qinput, qoutput, params);
+            expect = shl_rvv_maxpool2d_packn_int8;
+        }
+    }
+    if (params->base.cb->exec != expect) {
+        printf("pool2d packn: the init did not pick the generic packn kernel\n");
+        failures++;
+    }
+    params->base.cb->exec(qinput, qoutput, params);
+    packn_to_nchw(output_packn, out, in_c, out_h * out_w, packn, elem);
+    evaluate_error(out, ref, out_size, dtype);
+
+    qinput->data = qinput_data;
+    qoutput->data = qoutput_data;
+    shl_mem_free(ref);
+    shl_mem_free(input_packn);
+    shl_mem_free(output_packn);
+    shl_mem_free(out);
+    shl_mem_free(params->base.cb);
+    shl_mem_free(params);
+    struct csinn_tensor *tensors[] = {input, output, qinput, qoutput};
+    for (int i = 0; i < (dtype == CSINN_DTYPE_FLOAT32 ? 2 : 4); i++) {
+        shl_mem_free(tensors[i]->data);
+        csinn_free_tensor(tensors[i]);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    init_testsuite("Test function of generic pooling packn for RVV.\n");
+    srand(0);
+
+    enum csinn_dtype_enum dtypes[] = {CSINN_DTYPE_FLOAT32, CSINN_DTYPE_FLOAT16, CSINN_DTYPE_INT8};
+    for (int i = 0; i < 3; i++) {
+        int packn = dtypes[i] == CSINN_DTYPE_FLOAT32 ? csrr_vlenb() / 4 : csrr_vlenb() / 2;
+        for (int avg = 0; avg < 2; avg++) {
+            // the SPP / SPPF windows
+            verify_pool2d_packn(avg, packn, 13, 13, 5, 5, 1, 1, 2, 2, 2, 2, 0, false, dtypes[i]);
+            verify_pool2d_packn(avg, 2 * packn, 13, 11, 9, 9, 1, 1, 4, 4, 4, 4, 0, false,
+                                dtypes[i]);
+            // asymmetric pads, ceil_mode leaves a clipped last window
+            verify_pool2d_packn(avg, packn, 12, 11, 3, 3, 2, 2, 1, 0, 1, 0, 0, false, dtypes[i]);
+            verify_pool2d_packn(avg, packn, 13, 11, 3, 3, 3, 3, 0, 0, 0, 0, 1, false, dtypes[i]);
+            verify_pool2d_packn(avg, 2 * packn, 14, 10, 4, 2, 3, 2, 1, 1, 2, 0, 0, true,
+                                dtypes[i]);
+            verify_pool2d_packn(avg, packn, 16, 15, 7, 7, 2, 2, 3, 3, 3, 3, 0, false, dtypes[i]);
+        }
+    }
+
+    return done_testing();
+}
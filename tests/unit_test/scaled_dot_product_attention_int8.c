@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "csi_nn.h"
+#include "math_snr.h"
+#include "shl_thead_rvv.h"
+#include "test_utils.h"
+
+extern int failures;
+
+/*
+ * The fused int8 attention against the int8 reference, q [batch, heads, seq_q, head_dim],
+ * k / v [batch, heads, seq_k, head_dim(_v)]. The float mask is [batch, 1, seq_q, seq_k],
+ * broadcast over the heads, with some scores masked out and one query row masked completely.
+ */
+void verify_attention_int8(int batch, int heads, int seq_q, int seq_k, int head_dim,
+                           int head_dim_v, bool has_mask, bool causal)
+{
+    printf("attention int8: batch %d heads %d seq_q %d seq_k %d dim %d dim_v %d mask %d "
+           "causal %d\n",
+           batch, heads, seq_q, seq_k, head_dim, head_dim_v, has_mask, causal);
+
+    struct csinn_tensor *query =
+        rand_tensor_f32("query", batch, heads, seq_q, head_dim, 4, CSINN_LAYOUT_NCHW);
+    struct csinn_tensor *key =
+        rand_tensor_f32("key", batch, heads, seq_k, head_dim, 4, CSINN_LAYOUT_NCHW);
+    struct csinn_tensor *value =
+        rand_tensor_f32("value", batch, heads, seq_k, head_dim_v, 4, CSINN_LAYOUT_NCHW);
+    struct csinn_tensor *output =
+        rand_tensor_f32("output", batch, heads, seq_q, head_dim_v, 4, CSINN_LAYOUT_NCHW);
+    struct csinn_tensor *mask = NULL;
+    if (has_mask) {
+        mask = rand_tensor_f32("mask", batch, 1, seq_q, seq_k, 4, CSINN_LAYOUT_NCHW);
+        float *mask_data = (float *)mask->data;
+        for (int i = 0; i < batch * seq_q * seq_k; i++) {
+            mask_data[i] = rand() % 4 == 0 ? -INFINITY : mask_data[i];
+        }
+        for (int j = 0; j < seq_k; j++) {
+            mask_data[seq_q / 2 * seq_k + j] = -INFINITY;
+        }
+    }
+    int out_size = csinn_tensor_size(output);
+
+    struct csinn_scaled_dot_product_attention_params *params =
+        csinn_alloc_params(sizeof(struct csinn_scaled_dot_product_attention_params), NULL);
+    params->base.name = "params";
+    params->norm_factor = 1.0f / sqrtf(head_dim);
+    params->causal = causal;
+    shl_ref_scaled_dot_product_attention_f32(query, key, value, mask, output, params);
+
+    struct csinn_tensor *qquery = convert_f32_layer(query, CSINN_QUANT_INT8_ASYM, CSINN_RVV);
+    struct csinn_tensor *qkey = convert_f32_layer(key, CSINN_QUANT_INT8_ASYM, CSINN_RVV);
+    struct csinn_tensor *qvalue = convert_f32_layer(value, CSINN_QUANT_INT8_ASYM, CSINN_RVV);
+    struct csinn_tensor *qoutput = convert_f32_layer(output, CSINN_QUANT_INT8_ASYM, CSINN_RVV);
+
+    int8_t *ref = (int8_t *)shl_mem_alloc(out_size);
+    int8_t *out = (int8_t *)shl_mem_alloc(out_size);
+    void *qoutput_data = qoutput->data;
+    qoutput->data = ref;
+    shl_ref_scaled_dot_product_attention_quant(qquery, qkey, qvalue, mask, qoutput, params);
+
+    qoutput->data = out;
+    shl_rvv_scaled_dot_product_attention_init(qquery, qkey, qvalue, mask, qoutput, params);
+    if (params->base.cb->exec != shl_rvv_scaled_dot_product_attention_int8) {
+        printf("attention int8: the init did not pick the rvv kernel\n");
+        failures++;
+    }
+    params->base.cb->exec(qquery, qkey, qvalue, mask, qoutput, params);
+    evaluate_error(out, ref, out_size, CSINN_DTYPE_INT8);
+
+    qoutput->data = qoutput_data;
+    shl_mem_free(ref);
+    shl_mem_free(out);
+    shl_mem_free(params->base.cb);
+    shl_mem_free(params);
+    struct csinn_tensor *tensors[] = {query, key, value, output, qquery, qkey, qvalue, qoutput};
+    for (int i = 0; i < 8; i++) {
+        shl_mem_free(tensors[i]->data);
+        csinn_free_tensor(tensors[i]);
+    }
+    if (mask != NULL) {
+        shl_mem_free(mask->data);
+        csinn_free_tensor(mask);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    init_testsuite("Test function of int8 scaled dot product attention for RVV.\n");
+    srand(0);
+
+    // seq_q leaves a tail of the four query rows, seq_k a partial key tile
+    verify_attention_int8(2, 3, 10, 23, 19, 13, false, false);
+    verify_attention_int8(2, 3, 10, 23, 19, 13, true, false);
+    verify_attention_int8(2, 3, 10, 23, 19, 13, false, true);
+    verify_attention_int8(2, 3, 10, 23, 19, 13, true, true);
+    verify_attention_int8(1, 4, 33, 64, 32, 32, false, true);
+
+    return done_testing();
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "csi_nn.h"
+#include "math_snr.h"
+#include "shl_thead_rvv.h"
+#include "test_utils.h"
+
+extern int failures;
+
+/*
+ * softmax or log_softmax over axis against the reference. The innermost axis reduces
+ * contiguous rows, any other axis runs one lane per inner position.
+ */
+void verify_softmax(int n, int c, int h, int w, int axis, bool log_softmax,
+                    enum csinn_dtype_enum dtype)
+{
+    int elem = dtype == CSINN_DTYPE_FLOAT32 ? 4 : dtype == CSINN_DTYPE_FLOAT16 ? 2 : 1;
+    printf("%s: in %dx%dx%dx%d axis %d dtype %d\n", log_softmax ? "log_softmax" : "softmax", n, c,
+           h, w, axis, dtype);
+
+    struct csinn_tensor *input = rand_tensor_f32("input", n, c, h, w, 4, CSINN_LAYOUT_NCHW);
+    struct csinn_tensor *output = rand_tensor_f32("output", n, c, h, w, 4, CSINN_LAYOUT_NCHW);
+    int size = csinn_tensor_size(input);
+    fill_rand_f32(input->data, size, -5.0f, 5.0f);
+
+    struct csinn_softmax_params *params =
+        csinn_alloc_params(sizeof(struct csinn_softmax_params), NULL);
+    params->base.name = "params";
+    params->axis = axis;
+    if (log_softmax) {
+        shl_ref_log_softmax_f32(input, output, params);
+    } else {
+        shl_ref_softmax_f32(input, output, params);
+    }
+
+    struct csinn_tensor *qinput, *qoutput;
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        qinput = input;
+        qoutput = output;
+    } else if (dtype == CSINN_DTYPE_FLOAT16) {
+        qinput = convert_f32_layer(input, CSINN_QUANT_FLOAT16, CSINN_RVV);
+        qoutput = convert_f32_layer(output, CSINN_QUANT_FLOAT16, CSINN_RVV);
+    } else {
+        qinput = convert_f32_layer(input, CSINN_QUANT_INT8_ASYM, CSINN_RVV);
+        qoutput = convert_f32_layer(output, CSINN_QUANT_INT8_ASYM, CSINN_RVV);
+    }
+
+    char *ref = (char *)shl_mem_alloc(size * elem);
+    char *out = (char *)shl_mem_alloc(size * elem);
+    void *qoutput_data = qoutput->data;
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        memcpy(ref, output->data, size * elem);
+    } else if (dtype == CSINN_DTYPE_FLOAT16) {
+        // the f32 result rounded to fp16, the fp16 reference sums in fp16 and is looser
+        for (int i = 0; i < size; i++) {
+            ((__fp16 *)ref)[i] = ((float *)output->data)[i];
+        }
+    } else {
+        qoutput->data = ref;
+        if (log_softmax) {
+            shl_ref_log_softmax_quant(qinput, qoutput, params);
+        } else {
+            shl_ref_softmax_quant(qinput, qoutput, params);
+        }
+    }
+
+    qoutput->data = out;
+    if (dtype == CSINN_DTYPE_FLOAT32) {
+        params->base.cb->exec = log_softmax ? shl_rvv_log_softmax_fp32 : shl_rvv_softmax_fp32;
+    } else if (dtype == CSINN_DTYPE_FLOAT16) {
+        params->base.cb->exec = log_softmax ? shl_rvv_log_softmax_fp16 : shl_rvv_softmax_fp16;
+    } else {
+        int (*expect)();
+        if (log_softmax) {
+            shl_rvv_log_softmax_init_int8(qinput, qoutput, params);
+            expect = shl_rvv_log_softmax_int8;
+        } else {
+            shl_rvv_softmax_init_int8(qinput, qoutput, params);
+            expect = shl_rvv_softmax_int8;
+        }
+        if (params->base.cb->exec != expect) {
+            printf("softmax: the init did not pick the rvv kernel\n");
+            failures++;
+        }
+    }
+    params->base.cb->exec(qinput, qoutput, params);
+    evaluate_error(out, ref, size, dtype);
+
+    qoutput->data = qoutput_data;
+    shl_mem_free(ref);
+    shl_mem_free(out);
+    shl_mem_free(params->base.cb);
+    csinn_free_params(params);
+    struct csinn_tensor *tensors[] = {input, output, qinput, qoutput};
+    for (int i = 0; i < (dtype == CSINN_DTYPE_FLOAT32 ? 2 : 4); i++) {
+        shl_mem_free(tensors[i]->data);
+        csinn_free_tensor(tensors[i]);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    init_testsuite("Test function of softmax for RVV.\n");
+    srand(0);
+
+    enum csinn_dtype_enum dtypes[] = {CSINN_DTYPE_FLOAT32, CSINN_DTYPE_FLOAT16, CSINN_DTYPE_INT8};
+    for (int i = 0; i < 3; i++) {
+        for (int log_softmax = 0; log_softmax < 2; log_softmax++) {
+            // rows of the innermost axis with a tail, then a long row
+            verify_softmax(2, 3, 5, 37, 3, log_softmax, dtypes[i]);
+            verify_softmax(1, 1, 2, 1000, 3, log_softmax, dtypes[i]);
+            // the channel axis, inner positions leave a partial block
+            verify_softmax(2, 19, 5, 7, 1, log_softmax, dtypes[i]);
+            verify_softmax(1, 10, 1, 70, 1, log_softmax, dtypes[i]);
+        }
+    }
+
+    return done_testing();
+}
@@ -709,3 +709,68 @@ void evaluate_error(void *out, void *ref, int size, enum csinn_dtype_enum dtype)
     shl_mem_free(output);
     shl_mem_free(reference);
 }
+
+/* uniform in [lo, hi] in steps of (hi - lo) / 2000 */
+void fill_rand_f32(float *data, int size, float lo, float hi)
+{
+    for (int i = 0; i < size; i++) {
+        data[i] = lo + (hi - lo) * (rand() % 2001) / 2000.0f;
+    }
+}
+
+/* fp32 tensor of dim_count dims, the unused dims 0, filled in [-1, 1] */
+struct csinn_tensor *rand_tensor_f32(const char *name, int d0, int d1, int d2, int d3,
+                                     int dim_count, enum csinn_layout_enum layout)
+{
+    struct csinn_tensor *t = csinn_alloc_tensor(NULL);
+    t->dim[0] = d0;
+    t->dim[1] = d1;
+    t->dim[2] = d2;
+    t->dim[3] = d3;
+    t->dim_count = dim_count;
+    t->name = (char *)name;
+    t->layout = layout;
+    t->dtype = CSINN_DTYPE_FLOAT32;
+    t->data = shl_mem_alloc(csinn_tensor_byte_size(t));
+    fill_rand_f32(t->data, csinn_tensor_size(t), -1.0f, 1.0f);
+    return t;
+}
+
+/*
+ * every group of 4 along a row of inner values keeps only `keep` of them, the zeroed
+ * positions shift with the row and the group
+ */
+void prune_sparse_f32(float *data, int rows, int inner, int keep)
+{
+    for (int r = 0; r < rows; r++) {
+        for (int g = 0; g < inner; g += 4) {
+            for (int p = keep; p < 4; p++) {
+                int d = g + (r + g / 4 + p) % 4;
+                if (d < inner) {
+                    data[r * inner + d] = 0.0f;
+                }
+            }
+        }
+    }
+}
+
+/* [c, h, w] <-> [c / packn, h, w, packn] of elem bytes */
+void nchw_to_packn(const void *src, void *dst, int c, int hw, int packn, int elem)
+{
+    for (int i = 0; i < c; i++) {
+        for (int j = 0; j < hw; j++) {
+            memcpy((char *)dst + (((i / packn) * hw + j) * packn + i % packn) * elem,
+                   (const char *)src + (i * hw + j) * elem, elem);
+        }
+    }
+}
+
+void packn_to_nchw(const void *src, void *dst, int c, int hw, int packn, int elem)
+{
+    for (int i = 0; i < c; i++) {
+        for (int j = 0; j < hw; j++) {
+            memcpy((char *)dst + (i * hw + j) * elem,
+                   (const char *)src + (((i / packn) * hw + j) * packn + i % packn) * elem, elem);
+        }
+    }
+}
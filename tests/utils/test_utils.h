@@ -73,6 +73,12 @@ void result_verify_fp16(__fp16 *reference, __fp16 *output, __fp16 *input, float
 #endif
 
 void evaluate_error(void *out, void *ref, int size, enum csinn_dtype_enum dtype);
+void fill_rand_f32(float *data, int size, float lo, float hi);
+struct csinn_tensor *rand_tensor_f32(const char *name, int d0, int d1, int d2, int d3,
+                                     int dim_count, enum csinn_layout_enum layout);
+void prune_sparse_f32(float *data, int rows, int inner, int keep);
+void nchw_to_packn(const void *src, void *dst, int c, int hw, int packn, int elem);
+void packn_to_nchw(const void *src, void *dst, int c, int hw, int packn, int elem);
 
 #ifdef __cplusplus
 }
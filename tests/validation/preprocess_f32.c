@@ -0,0 +1,297 @@
+/*
+ * Copyright (C) 2016-2022 T-Head Semiconductor Co., Ltd. All rights reserved.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ *
+ * Licensed under the Apache License, Version 2.0 (the License); you may
+ * not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an AS IS BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/* CSI-NN2 version 2.0.x */
+
+#include "csi_nn.h"
+#include "math_snr.h"
+#include "test_utils.h"
+
+extern int failures;
+
+/* source coordinate pair and weight of the second one, same rules as csinn_tensor_preprocess */
+static void ref_coord(int i, int out_size, int in_size, bool nearest, int *s0, int *s1, double *w)
+{
+    double ratio = (double)in_size / out_size;
+    if (nearest) {
+        int s = (int)floor(i * ratio);
+        *s0 = *s1 = s < in_size - 1 ? s : in_size - 1;
+        *w = 0.0;
+        return;
+    }
+    double s = (i + 0.5) * ratio - 0.5;
+    s = s > 0.0 ? s : 0.0;
+    *s0 = (int)s;
+    if (*s0 >= in_size - 1) {
+        *s0 = *s1 = in_size - 1;
+        *w = 0.0;
+    } else {
+        *s1 = *s0 + 1;
+        *w = s - *s0;
+    }
+}
+
+/* bilinear or nearest sample of a plane with the given pixel step and row stride */
+static double ref_sample(uint8_t *plane, int step, int stride, int in_w, int in_h, int out_w,
+                         int out_h, int x, int y, bool nearest)
+{
+    int x0, x1, y0, y1;
+    double wx, wy;
+    ref_coord(x, out_w, in_w, nearest, &x0, &x1, &wx);
+    ref_coord(y, out_h, in_h, nearest, &y0, &y1, &wy);
+    double top = plane[y0 * stride + x0 * step] * (1 - wx) + plane[y0 * stride + x1 * step] * wx;
+    double bottom =
+        plane[y1 * stride + x0 * step] * (1 - wx) + plane[y1 * stride + x1 * step] * wx;
+    return top * (1 - wy) + bottom * wy;
+}
+
+static double clamp255(double x) { return x < 0 ? 0 : (x > 255 ? 255 : x); }
+
+/* expected R, G, B of output pixel (x, y) */
+static void ref_pixel(uint8_t *image, struct csinn_preprocess_params *p, int out_w, int out_h,
+                      int x, int y, double *rgb)
+{
+    bool nearest = p->resize_mode == CSINN_RESIZE_NEAREST_NEIGHBOR;
+    int w = p->width;
+    int h = p->height;
+    if (p->format == CSINN_IMAGE_RGB888 || p->format == CSINN_IMAGE_BGR888) {
+        for (int c = 0; c < 3; c++) {
+            int offset = p->format == CSINN_IMAGE_BGR888 ? 2 - c : c;
+            rgb[c] = ref_sample(image + offset, 3, w * 3, w, h, out_w, out_h, x, y, nearest);
+        }
+        return;
+    }
+    int cw = (w + 1) / 2;
+    int ch = (h + 1) / 2;
+    uint8_t *uv = image + w * h;
+    double yy = ref_sample(image, 1, w, w, h, out_w, out_h, x, y, nearest);
+    double u, v;
+    if (p->format == CSINN_IMAGE_I420) {
+        u = ref_sample(uv, 1, cw, cw, ch, out_w, out_h, x, y, nearest);
+        v = ref_sample(uv + cw * ch, 1, cw, cw, ch, out_w, out_h, x, y, nearest);
+    } else {
+        /* a row of cw interleaved pairs, one byte longer than the Y row for an odd width */
+        int u_off = p->format == CSINN_IMAGE_NV12 ? 0 : 1;
+        u = ref_sample(uv + u_off, 2, 2 * cw, cw, ch, out_w, out_h, x, y, nearest);
+        v = ref_sample(uv + 1 - u_off, 2, 2 * cw, cw, ch, out_w, out_h, x, y, nearest);
+    }
+    yy = 1.164 * (yy - 16.0);
+    rgb[0] = clamp255(yy + 1.596 * (v - 128.0));
+    rgb[1] = clamp255(yy - 0.813 * (v - 128.0) - 0.391 * (u - 128.0));
+    rgb[2] = clamp255(yy + 2.018 * (u - 128.0));
+}
+
+/* expected dest of csinn_tensor_preprocess as float, in the layout of dest */
+static float *ref_preprocess(struct csinn_tensor *dest, uint8_t *image,
+                             struct csinn_preprocess_params *p)
+{
+    int channel, out_h, out_w, c0 = 1;
+    if (dest->layout == CSINN_LAYOUT_NCHW) {
+        channel = dest->dim[1];
+        out_h = dest->dim[2];
+        out_w = dest->dim[3];
+    } else if (dest->layout == CSINN_LAYOUT_NHWC) {
+        out_h = dest->dim[1];
+        out_w = dest->dim[2];
+        channel = c0 = dest->dim[3];
+    } else {
+        out_h = dest->dim[2];
+        out_w = dest->dim[3];
+        c0 = dest->dim[4];
+        channel = dest->dim[1] * c0;
+    }
+    float *ref = shl_mem_alloc(channel * out_h * out_w * sizeof(float));
+    for (int y = 0; y < out_h; y++) {
+        for (int x = 0; x < out_w; x++) {
+            double rgb[3];
+            ref_pixel(image, p, out_w, out_h, x, y, rgb);
+            for (int c = 0; c < channel; c++) {
+                int64_t index = ((c / c0) * out_h + y) * out_w * c0 + x * c0 + c % c0;
+                if (c < 3) {
+                    ref[index] = (rgb[p->bgr ? 2 - c : c] - p->mean[c]) * p->scale[c];
+                } else {
+                    ref[index] = 0.0f;
+                }
+            }
+        }
+    }
+    return ref;
+}
+
+static void fill_image(uint8_t *image, int size)
+{
+    uint32_t seed = 12345;
+    for (int i = 0; i < size; i++) {
+        seed = seed * 1103515245 + 12345;
+        image[i] = (seed >> 16) & 0xff;
+    }
+}
+
+/* run csinn_tensor_preprocess into dest and compare with the double precision reference */
+static void verify(const char *name, struct csinn_tensor *dest, struct csinn_preprocess_params *p,
+                   float gap)
+{
+    int image_size = p->format >= CSINN_IMAGE_NV12
+                         ? p->width * p->height + 2 * ((p->width + 1) / 2) * ((p->height + 1) / 2)
+                         : p->width * p->height * 3;
+    uint8_t *image = shl_mem_alloc(image_size);
+    fill_image(image, image_size);
+
+    int size = csinn_tensor_size(dest);
+    dest->data = shl_mem_alloc(csinn_tensor_byte_size(dest));
+    float *ref = ref_preprocess(dest, image, p);
+    float *out = shl_mem_alloc(size * sizeof(float));
+
+    if (csinn_tensor_preprocess(dest, image, p) != CSINN_TRUE) {
+        failures++;
+    }
+    for (int i = 0; i < size; i++) {
+        if (dest->dtype == CSINN_DTYPE_UINT8) {
+            out[i] = (((uint8_t *)dest->data)[i] - dest->qinfo->zero_point) * dest->qinfo->scale;
+        } else {
+            out[i] = ((float *)dest->data)[i];
+        }
+    }
+    float max_error = 0.0f;
+    for (int i = 0; i < size; i++) {
+        float error = fabs(out[i] - ref[i]);
+        max_error = error > max_error ? error : max_error;
+    }
+    printf("%s: the max error is %f\n", name, max_error);
+    if (max_error > gap) {
+        failures++;
+    }
+
+    shl_mem_free(image);
+    shl_mem_free(dest->data);
+    shl_mem_free(ref);
+    shl_mem_free(out);
+}
+
+/* csinn_update_input_image binds the same data as preprocessing into a tensor of the input */
+static void verify_session(struct csinn_tensor *input, struct csinn_preprocess_params *p)
+{
+    int image_size = p->width * p->height * 3;
+    uint8_t *image = shl_mem_alloc(image_size);
+    fill_image(image, image_size);
+
+    struct csinn_session *sess = csinn_alloc_session();
+    sess->base_api = CSINN_REF;
+    csinn_set_input_number(1, sess);
+    csinn_set_input(0, input, sess);
+    int byte_size = csinn_tensor_byte_size(input);
+    input->data = shl_mem_alloc(byte_size);
+    csinn_tensor_preprocess(input, image, p);
+    void *expect = input->data;
+
+    /* the second call reuses the session buffer */
+    for (int i = 0; i < 2; i++) {
+        if (csinn_update_input_image(0, image, p, sess) != CSINN_TRUE ||
+            sess->input[0]->data == expect || memcmp(sess->input[0]->data, expect, byte_size)) {
+            failures++;
+        }
+    }
+    printf("session input: %s\n", failures ? "mismatch" : "match");
+
+    csinn_session_deinit(sess);
+    csinn_free_session(sess);
+    shl_mem_free(expect);
+    shl_mem_free(image);
+}
+
+static struct csinn_tensor *alloc_dest(enum csinn_layout_enum layout, int dim_count, int32_t *dim,
+                                       enum csinn_dtype_enum dtype)
+{
+    struct csinn_tensor *t = csinn_alloc_tensor(NULL);
+    t->layout = layout;
+    t->dim_count = dim_count;
+    memcpy(t->dim, dim, dim_count * sizeof(int32_t));
+    t->dtype = dtype;
+    return t;
+}
+
+int main(int argc, char **argv)
+{
+    init_testsuite("Testing function of preprocess f32.\n");
+
+    struct csinn_preprocess_params p = {0};
+    p.mean[0] = 123.7f;
+    p.mean[1] = 116.3f;
+    p.mean[2] = 103.5f;
+    p.scale[0] = 0.0171f;
+    p.scale[1] = 0.0175f;
+    p.scale[2] = 0.0174f;
+
+    /* odd sizes so that vector tails are taken */
+    int32_t nchw[4] = {1, 3, 16, 21};
+    struct csinn_tensor *dest = alloc_dest(CSINN_LAYOUT_NCHW, 4, nchw, CSINN_DTYPE_FLOAT32);
+    p.format = CSINN_IMAGE_RGB888;
+    p.width = 37;
+    p.height = 29;
+    p.resize_mode = CSINN_RESIZE_BILINEAR;
+    verify("rgb888 bilinear nchw", dest, &p, 1e-3f);
+    csinn_free_tensor(dest);
+
+    int32_t nhwc[4] = {1, 19, 24, 3};
+    dest = alloc_dest(CSINN_LAYOUT_NHWC, 4, nhwc, CSINN_DTYPE_FLOAT32);
+    p.format = CSINN_IMAGE_BGR888;
+    p.width = 13;
+    p.height = 11;
+    p.resize_mode = CSINN_RESIZE_NEAREST_NEIGHBOR;
+    p.bgr = true;
+    verify("bgr888 nearest nhwc", dest, &p, 1e-3f);
+    csinn_free_tensor(dest);
+
+    int32_t nc1hwc0[5] = {1, 1, 12, 17, 4};
+    dest = alloc_dest(CSINN_LAYOUT_NC1HWC0, 5, nc1hwc0, CSINN_DTYPE_FLOAT32);
+    p.format = CSINN_IMAGE_NV12;
+    p.width = 30;
+    p.height = 22;
+    p.resize_mode = CSINN_RESIZE_BILINEAR;
+    p.bgr = false;
+    verify("nv12 bilinear nc1hwc0", dest, &p, 1e-3f);
+    csinn_free_tensor(dest);
+
+    int32_t nv21[4] = {1, 3, 40, 45};
+    dest = alloc_dest(CSINN_LAYOUT_NCHW, 4, nv21, CSINN_DTYPE_FLOAT32);
+    p.format = CSINN_IMAGE_NV21;
+    p.width = 31;
+    p.height = 23;
+    verify("nv21 bilinear upscale nchw", dest, &p, 1e-3f);
+    csinn_free_tensor(dest);
+
+    /* quantized output is within one step of the float result */
+    int32_t i420[4] = {1, 3, 9, 14};
+    dest = alloc_dest(CSINN_LAYOUT_NCHW, 4, i420, CSINN_DTYPE_UINT8);
+    dest->qinfo->scale = 5.0f / 255;
+    dest->qinfo->zero_point = 110;
+    p.format = CSINN_IMAGE_I420;
+    p.width = 27;
+    p.height = 19;
+    verify("i420 bilinear nchw uint8", dest, &p, 5.0f / 255 * 0.5f + 1e-3f);
+    csinn_free_tensor(dest);
+
+    dest = alloc_dest(CSINN_LAYOUT_NCHW, 4, nchw, CSINN_DTYPE_FLOAT32);
+    p.format = CSINN_IMAGE_RGB888;
+    p.width = 37;
+    p.height = 29;
+    verify_session(dest, &p);
+    csinn_free_tensor(dest);
+
+    return done_testing();
+}